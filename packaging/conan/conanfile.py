@@ -53,3 +53,5 @@ class HeliosNetworkConan(ConanFile):
 
     def package_info(self):
         self.cpp_info.libs = ["helios"]
+        if self.settings.os in ("Linux", "FreeBSD"):
+            self.cpp_info.system_libs = ["pthread"]
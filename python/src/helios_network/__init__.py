@@ -1,10 +1,10 @@
 from __future__ import annotations
 
 import enum
+from collections.abc import Sequence
 
 from . import _core
 from ._conversions import from_igraph, from_networkx, to_igraph, to_networkx
-from ._node_link_json import read_node_link_json as _read_node_link_json
 from ._wrapper import NETWORK_EVENTS, Network, encode_binary_batch, mutation_events_to_text_batch
 
 
@@ -91,16 +91,64 @@ class ConnectedComponentsMode(enum.IntEnum):
     Strong = _core.CONNECTED_COMPONENTS_STRONG
 
 
-def read_bxnet(path: str) -> Network:
-    """Read a binary `.bxnet` file into a `Network`."""
-
-    return Network(_core_network=_core.read_bxnet(path))
+def read_bxnet(
+    path: str,
+    *,
+    memory_map: bool = False,
+    node_attributes: Sequence[str] | None = None,
+    edge_attributes: Sequence[str] | None = None,
+    network_attributes: Sequence[str] | None = None,
+) -> Network:
+    """Read a binary `.bxnet` file into a `Network`.
+
+    With ``memory_map=True`` the file is decoded from a read-only memory
+    mapping instead of buffered reads, which is faster for large files.
+
+    ``node_attributes``, ``edge_attributes`` and ``network_attributes`` restrict
+    loading to the listed attributes of each scope; the values of the others
+    are skipped. ``None`` or an empty list loads every attribute of the scope.
+    Filtered reads cannot be memory mapped and skip the file checksum.
+    """
+
+    return Network(
+        _core_network=_core.read_bxnet(
+            path,
+            memory_map=memory_map,
+            node_attributes=node_attributes,
+            edge_attributes=edge_attributes,
+            network_attributes=network_attributes,
+        )
+    )
+
+
+def read_zxnet(
+    path: str,
+    *,
+    threads: int | None = None,
+    node_attributes: Sequence[str] | None = None,
+    edge_attributes: Sequence[str] | None = None,
+    network_attributes: Sequence[str] | None = None,
+) -> Network:
+    """Read a compressed `.zxnet` file into a `Network`.
 
+    ``threads`` sets how many threads decompress BGZF blocks (``0`` follows
+    the native worker count); by default a single thread is used.
 
-def read_zxnet(path: str) -> Network:
-    """Read a compressed `.zxnet` file into a `Network`."""
+    The attribute lists work as in :func:`read_bxnet`. Compressed blocks that
+    only hold skipped values are not decompressed, so loading a few columns of
+    a wide file is much cheaper than a full read; filtered reads always
+    decompress on the calling thread.
+    """
 
-    return Network(_core_network=_core.read_zxnet(path))
+    return Network(
+        _core_network=_core.read_zxnet(
+            path,
+            threads=-1 if threads is None else int(threads),
+            node_attributes=node_attributes,
+            edge_attributes=edge_attributes,
+            network_attributes=network_attributes,
+        )
+    )
 
 
 def read_xnet(path: str) -> Network:
@@ -121,9 +169,29 @@ def read_gt(path: str) -> Network:
 
 
 def read_node_link_json(path: str) -> Network:
-    """Read a D3/NetworkX-style node-link JSON file into a `Network`."""
+    """Read a D3/NetworkX-style node-link JSON file into a `Network`.
+
+    Load issues are reported as ``UserWarning``; a malformed document raises
+    ``ValueError``.
+    """
+
+    return Network(_core_network=_core.read_node_link_json(path))
+
+def set_worker_count(count: int) -> None:
+    """Set how many native threads parallel measurements may use.
+
+    Pass ``0`` to restore the default (``HELIOS_NUM_THREADS`` or the number of
+    logical processors).
+    """
+
+    _core.set_worker_count(int(count))
+
+
+def get_worker_count() -> int:
+    """Return the number of native threads parallel measurements will use."""
+
+    return _core.get_worker_count()
 
-    return _read_node_link_json(path)
 
 def _flatten_probability_matrix(probabilities, block_count: int) -> list[float]:
     if len(probabilities) == block_count and probabilities and hasattr(probabilities[0], "__iter__"):
@@ -272,6 +340,8 @@ __all__ = [
     "read_gml",
     "read_gt",
     "read_node_link_json",
+    "set_worker_count",
+    "get_worker_count",
     "generate_stochastic_block_model",
     "generate_barabasi_albert",
     "generate_watts_strogatz",
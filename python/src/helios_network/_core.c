@@ -414,6 +414,85 @@ static int parse_source_nodes(PyObject *obj, CXIndex **outNodes, CXSize *outCoun
     return 0;
 }
 
+typedef struct {
+    PyObject *fast;
+    const char **names;
+    size_t count;
+} AttributeNameList;
+
+static int parse_attribute_names(PyObject *obj, const char *argument, AttributeNameList *out) {
+    out->fast = NULL;
+    out->names = NULL;
+    out->count = 0;
+    if (!obj || obj == Py_None) {
+        return 0;
+    }
+    if (PyUnicode_Check(obj)) {
+        PyErr_Format(PyExc_TypeError, "%s must be a sequence of attribute names", argument);
+        return -1;
+    }
+    PyObject *fast = PySequence_Fast(obj, "attribute filters must be sequences of attribute names");
+    if (!fast) {
+        return -1;
+    }
+    Py_ssize_t pyCount = PySequence_Fast_GET_SIZE(fast);
+    if (pyCount <= 0) {
+        Py_DECREF(fast);
+        return 0;
+    }
+    const char **names = (const char **)calloc((size_t)pyCount, sizeof(const char *));
+    if (!names) {
+        Py_DECREF(fast);
+        PyErr_NoMemory();
+        return -1;
+    }
+    for (Py_ssize_t i = 0; i < pyCount; i++) {
+        PyObject *item = PySequence_Fast_GET_ITEM(fast, i);
+        if (!PyUnicode_Check(item)) {
+            PyErr_Format(PyExc_TypeError, "%s must contain only strings", argument);
+            free(names);
+            Py_DECREF(fast);
+            return -1;
+        }
+        /* The UTF-8 buffers stay owned by the items kept alive through `fast`. */
+        names[i] = PyUnicode_AsUTF8(item);
+        if (!names[i]) {
+            free(names);
+            Py_DECREF(fast);
+            return -1;
+        }
+    }
+    out->fast = fast;
+    out->names = names;
+    out->count = (size_t)pyCount;
+    return 0;
+}
+
+static void release_attribute_names(AttributeNameList *list) {
+    free(list->names);
+    Py_XDECREF(list->fast);
+    list->fast = NULL;
+    list->names = NULL;
+    list->count = 0;
+}
+
+static int parse_attribute_filters(PyObject *nodeObj, PyObject *edgeObj, PyObject *networkObj, AttributeNameList lists[3], int *outFiltered) {
+    if (parse_attribute_names(nodeObj, "node_attributes", &lists[0]) < 0) {
+        return -1;
+    }
+    if (parse_attribute_names(edgeObj, "edge_attributes", &lists[1]) < 0) {
+        release_attribute_names(&lists[0]);
+        return -1;
+    }
+    if (parse_attribute_names(networkObj, "network_attributes", &lists[2]) < 0) {
+        release_attribute_names(&lists[0]);
+        release_attribute_names(&lists[1]);
+        return -1;
+    }
+    *outFiltered = lists[0].count > 0 || lists[1].count > 0 || lists[2].count > 0;
+    return 0;
+}
+
 static PyObject *index_buffer_to_list(const CXIndex *values, CXSize count) {
     PyObject *list = PyList_New((Py_ssize_t)count);
     if (!list) {
@@ -438,6 +517,22 @@ static CXAttributeRef get_attribute_for_scope(CXNetworkRef network, CXAttributeS
     }
 }
 
+static void bump_attribute_version(CXNetworkRef network, CXAttributeScope scope, const char *name) {
+    switch (scope) {
+        case CXAttributeScopeNode:
+            CXNetworkBumpNodeAttributeVersion(network, name);
+            break;
+        case CXAttributeScopeEdge:
+            CXNetworkBumpEdgeAttributeVersion(network, name);
+            break;
+        case CXAttributeScopeNetwork:
+            CXNetworkBumpNetworkAttributeVersion(network, name);
+            break;
+        default:
+            break;
+    }
+}
+
 static PyObject *Network_new(PyTypeObject *type, PyObject *args, PyObject *kwargs) {
     PyHeliosNetwork *self = (PyHeliosNetwork *)type->tp_alloc(type, 0);
     if (!self) {
@@ -523,6 +618,63 @@ static PyObject *Network_edge_capacity(PyHeliosNetwork *self, PyObject *args) {
     return PyLong_FromSize_t((size_t)CXNetworkEdgeCapacity(self->network));
 }
 
+static PyObject *Network_freeze(PyHeliosNetwork *self, PyObject *args) {
+    (void)args;
+    if (!self->network) {
+        PyErr_SetString(PyExc_RuntimeError, "Network is not initialized");
+        return NULL;
+    }
+    if (!CXNetworkFreeze(self->network)) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *Network_thaw(PyHeliosNetwork *self, PyObject *args) {
+    (void)args;
+    if (!self->network) {
+        PyErr_SetString(PyExc_RuntimeError, "Network is not initialized");
+        return NULL;
+    }
+    if (!CXNetworkThaw(self->network)) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *Network_is_frozen(PyHeliosNetwork *self, PyObject *args) {
+    (void)args;
+    if (!self->network) {
+        PyErr_SetString(PyExc_RuntimeError, "Network is not initialized");
+        return NULL;
+    }
+    return PyBool_FromLong(CXNetworkIsFrozen(self->network) ? 1 : 0);
+}
+
+static PyObject *Network_set_fast_edge_removal(PyHeliosNetwork *self, PyObject *args) {
+    int enabled = 1;
+    if (!PyArg_ParseTuple(args, "|p", &enabled)) {
+        return NULL;
+    }
+    if (!self->network) {
+        PyErr_SetString(PyExc_RuntimeError, "Network is not initialized");
+        return NULL;
+    }
+    CXNetworkSetFastEdgeRemoval(self->network, enabled ? CXTrue : CXFalse);
+    Py_RETURN_NONE;
+}
+
+static PyObject *Network_has_fast_edge_removal(PyHeliosNetwork *self, PyObject *args) {
+    (void)args;
+    if (!self->network) {
+        PyErr_SetString(PyExc_RuntimeError, "Network is not initialized");
+        return NULL;
+    }
+    return PyBool_FromLong(CXNetworkHasFastEdgeRemoval(self->network) ? 1 : 0);
+}
+
 static PyObject *Network_add_nodes(PyHeliosNetwork *self, PyObject *args) {
     Py_ssize_t count = 0;
     if (!PyArg_ParseTuple(args, "n", &count)) {
@@ -1577,6 +1729,7 @@ static PyObject *Network_set_attribute_value(PyHeliosNetwork *self, PyObject *ar
         if (dimension > 1) {
             Py_DECREF(sequence);
         }
+        bump_attribute_version(self->network, scope, name);
         Py_RETURN_TRUE;
     }
 
@@ -1589,6 +1742,7 @@ static PyObject *Network_set_attribute_value(PyHeliosNetwork *self, PyObject *ar
     if (dimension > 1) {
         Py_DECREF(sequence);
     }
+    bump_attribute_version(self->network, scope, name);
     Py_RETURN_TRUE;
 }
 
@@ -1801,6 +1955,117 @@ static PyObject *Network_select_edges(PyHeliosNetwork *self, PyObject *args) {
     return list;
 }
 
+static void raise_query_error(void) {
+    const char *message = CXNetworkQueryLastErrorMessage();
+    CXSize offset = CXNetworkQueryLastErrorOffset();
+    if (!message || message[0] == '\0') {
+        PyErr_Format(PyExc_ValueError, "Query failed at %zu", (size_t)offset);
+    } else {
+        PyErr_Format(PyExc_ValueError, "Query failed at %zu: %s", (size_t)offset, message);
+    }
+}
+
+#define PREPARED_QUERY_CAPSULE "helios_network.PreparedQuery"
+
+static void prepared_query_capsule_destructor(PyObject *capsule) {
+    CXQueryFree((CXPreparedQueryRef)PyCapsule_GetPointer(capsule, PREPARED_QUERY_CAPSULE));
+}
+
+static PyObject *Network_prepare_query(PyHeliosNetwork *self, PyObject *args) {
+    const char *query = NULL;
+    PyObject *scope_obj = NULL;
+    if (!PyArg_ParseTuple(args, "sO", &query, &scope_obj)) {
+        return NULL;
+    }
+    if (!self->network) {
+        PyErr_SetString(PyExc_RuntimeError, "Network is not initialized");
+        return NULL;
+    }
+    CXAttributeScope scope;
+    if (parse_scope(scope_obj, &scope) < 0) {
+        return NULL;
+    }
+    CXPreparedQueryRef prepared = CXQueryPrepare(self->network, scope, query);
+    if (!prepared) {
+        raise_query_error();
+        return NULL;
+    }
+    PyObject *capsule = PyCapsule_New(prepared, PREPARED_QUERY_CAPSULE, prepared_query_capsule_destructor);
+    if (!capsule) {
+        CXQueryFree(prepared);
+    }
+    return capsule;
+}
+
+static PyObject *Network_execute_query(PyHeliosNetwork *self, PyObject *args) {
+    PyObject *capsule = NULL;
+    if (!PyArg_ParseTuple(args, "O", &capsule)) {
+        return NULL;
+    }
+    if (!self->network) {
+        PyErr_SetString(PyExc_RuntimeError, "Network is not initialized");
+        return NULL;
+    }
+    CXPreparedQueryRef prepared = (CXPreparedQueryRef)PyCapsule_GetPointer(capsule, PREPARED_QUERY_CAPSULE);
+    if (!prepared) {
+        return NULL;
+    }
+    CXSelector *selector = CXNodeSelectorCreate(0);
+    if (!selector) {
+        PyErr_SetString(PyExc_RuntimeError, "Failed to allocate selector");
+        return NULL;
+    }
+    if (!CXQueryExecute(prepared, selector)) {
+        CXNodeSelectorDestroy(selector);
+        raise_query_error();
+        return NULL;
+    }
+    PyObject *list = index_buffer_to_list(CXNodeSelectorData(selector), CXNodeSelectorCount(selector));
+    CXNodeSelectorDestroy(selector);
+    return list;
+}
+
+static PyObject *Network_attribute_index(PyHeliosNetwork *self, PyObject *args) {
+    PyObject *scope_obj = NULL;
+    const char *name = NULL;
+    const char *action = NULL;
+    if (!PyArg_ParseTuple(args, "Oss", &scope_obj, &name, &action)) {
+        return NULL;
+    }
+    if (!self->network) {
+        PyErr_SetString(PyExc_RuntimeError, "Network is not initialized");
+        return NULL;
+    }
+    CXAttributeScope scope = CXAttributeScopeNode;
+    if (parse_scope(scope_obj, &scope) != 0) {
+        return NULL;
+    }
+    if (strcmp(action, "has") == 0) {
+        return PyBool_FromLong(CXNetworkHasAttributeIndex(self->network, scope, name));
+    }
+    if (strcmp(action, "drop") == 0) {
+        return PyBool_FromLong(CXNetworkDropAttributeIndex(self->network, scope, name));
+    }
+    if (strcmp(action, "create") != 0) {
+        PyErr_SetString(PyExc_ValueError, "Unknown attribute index action");
+        return NULL;
+    }
+    if (scope != CXAttributeScopeNode && scope != CXAttributeScopeEdge) {
+        PyErr_SetString(PyExc_ValueError, "Attribute indexes cover node or edge attributes");
+        return NULL;
+    }
+    CXAttributeRef attr = get_attribute_for_scope(self->network, scope, name);
+    if (!attr) {
+        PyErr_SetString(PyExc_KeyError, "Attribute not found");
+        return NULL;
+    }
+    if (!CXNetworkCreateAttributeIndex(self->network, scope, name)) {
+        PyErr_SetString(PyExc_ValueError, "Only scalar numeric, categorical, and multi-category attributes can be indexed");
+        return NULL;
+    }
+    Py_RETURN_TRUE;
+}
+
 static PyObject *Network_save_xnet(PyHeliosNetwork *self, PyObject *args) {
     const char *path = NULL;
     if (!PyArg_ParseTuple(args, "s", &path)) {
@@ -1818,16 +2083,20 @@ static PyObject *Network_save_xnet(PyHeliosNetwork *self, PyObject *args) {
     Py_RETURN_TRUE;
 }
 
-static PyObject *Network_save_bxnet(PyHeliosNetwork *self, PyObject *args) {
+static PyObject *Network_save_bxnet(PyHeliosNetwork *self, PyObject *args, PyObject *kwargs) {
     const char *path = NULL;
-    if (!PyArg_ParseTuple(args, "s", &path)) {
+    int includeAdjacency = 0;
+    static char *kwlist[] = {"path", "include_adjacency", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s|$p", kwlist, &path, &includeAdjacency)) {
         return NULL;
     }
     if (!self->network) {
         PyErr_SetString(PyExc_RuntimeError, "Network is not initialized");
         return NULL;
     }
-    CXBool ok = CXNetworkWriteBXNet(self->network, path);
+    CXBool ok = includeAdjacency
+        ? CXNetworkWriteBXNetWithAdjacency(self->network, path)
+        : CXNetworkWriteBXNet(self->network, path);
     if (!ok) {
         PyErr_SetString(PyExc_IOError, "Failed to write BXNet file");
         return NULL;
@@ -1835,17 +2104,27 @@ static PyObject *Network_save_bxnet(PyHeliosNetwork *self, PyObject *args) {
     Py_RETURN_TRUE;
 }
 
-static PyObject *Network_save_zxnet(PyHeliosNetwork *self, PyObject *args) {
+static PyObject *Network_save_zxnet(PyHeliosNetwork *self, PyObject *args, PyObject *kwargs) {
     const char *path = NULL;
     int compression = 6;
-    if (!PyArg_ParseTuple(args, "s|i", &path, &compression)) {
+    int includeAdjacency = 0;
+    Py_ssize_t threads = -1;
+    static char *kwlist[] = {"path", "compression", "include_adjacency", "threads", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s|i$pn", kwlist, &path, &compression, &includeAdjacency, &threads)) {
         return NULL;
     }
     if (!self->network) {
         PyErr_SetString(PyExc_RuntimeError, "Network is not initialized");
         return NULL;
     }
-    CXBool ok = CXNetworkWriteZXNet(self->network, path, compression);
+    CXSize previousThreads = CXNetworkGetZXNetThreadCount();
+    if (threads >= 0) {
+        CXNetworkSetZXNetThreadCount((CXSize)threads);
+    }
+    CXBool ok = includeAdjacency
+        ? CXNetworkWriteZXNetWithAdjacency(self->network, path, compression)
+        : CXNetworkWriteZXNet(self->network, path, compression);
+    CXNetworkSetZXNetThreadCount(previousThreads);
     if (!ok) {
         PyErr_SetString(PyExc_IOError, "Failed to write ZXNet file");
         return NULL;
@@ -2643,6 +2922,64 @@ static PyObject *Network_measure_local_clustering_coefficient(PyHeliosNetwork *s
     return result;
 }
 
+static PyObject *Network_measure_triangles(PyHeliosNetwork *self, PyObject *args, PyObject *kwargs) {
+    static const char *kwlist[] = {"execution_mode", NULL};
+    PyObject *execution_mode_obj = NULL;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|O", (char **)kwlist, &execution_mode_obj)) {
+        return NULL;
+    }
+    if (!self->network) {
+        PyErr_SetString(PyExc_RuntimeError, "Network is not initialized");
+        return NULL;
+    }
+
+    CXMeasurementExecutionMode execution_mode = CXMeasurementExecutionParallel;
+    if (parse_execution_mode(execution_mode_obj, &execution_mode) != 0) {
+        return NULL;
+    }
+
+    float *values = (float *)calloc(self->network->nodeCapacity, sizeof(float));
+    if (!values) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+    uint64_t triangle_count = 0;
+    double transitivity = 0.0;
+    CXBool ok = CXNetworkMeasureTriangles(self->network, execution_mode, values, &triangle_count, &transitivity);
+    if (!ok) {
+        free(values);
+        PyErr_SetString(PyExc_RuntimeError, "Failed to measure triangles");
+        return NULL;
+    }
+
+    PyObject *values_list = float_buffer_to_list(values, self->network->nodeCapacity);
+    free(values);
+    if (!values_list) {
+        return NULL;
+    }
+    PyObject *result = PyDict_New();
+    if (!result) {
+        Py_DECREF(values_list);
+        return NULL;
+    }
+    PyObject *count_out = PyLong_FromUnsignedLongLong((unsigned long long)triangle_count);
+    PyObject *transitivity_out = PyFloat_FromDouble(transitivity);
+    if (!count_out || !transitivity_out) {
+        Py_XDECREF(count_out);
+        Py_XDECREF(transitivity_out);
+        Py_DECREF(values_list);
+        Py_DECREF(result);
+        return NULL;
+    }
+    PyDict_SetItemString(result, "values_by_node", values_list);
+    PyDict_SetItemString(result, "triangle_count", count_out);
+    PyDict_SetItemString(result, "transitivity", transitivity_out);
+    Py_DECREF(values_list);
+    Py_DECREF(count_out);
+    Py_DECREF(transitivity_out);
+    return result;
+}
+
 static PyObject *Network_measure_eigenvector_centrality(PyHeliosNetwork *self, PyObject *args, PyObject *kwargs) {
     static const char *kwlist[] = {"edge_weight_attribute", "direction", "max_iterations", "tolerance", "initial", "execution_mode", NULL};
     const char *edge_weight_attribute = NULL;
@@ -2996,6 +3333,7 @@ static PyObject *Network_measure_leiden_modularity(PyHeliosNetwork *self, PyObje
         "max_levels",
         "max_passes",
         "out_node_community_attribute",
+        "execution_mode",
         NULL
     };
     const char *edge_weight_attribute = NULL;
@@ -3004,20 +3342,26 @@ static PyObject *Network_measure_leiden_modularity(PyHeliosNetwork *self, PyObje
     unsigned long max_levels = 32;
     unsigned long max_passes = 8;
     const char *out_node_community_attribute = "community";
+    PyObject *execution_mode_obj = NULL;
     if (!PyArg_ParseTupleAndKeywords(
         args,
         kwargs,
-        "|zdkkks",
+        "|zdkkksO",
         (char **)kwlist,
         &edge_weight_attribute,
         &resolution,
         &seed,
         &max_levels,
         &max_passes,
-        &out_node_community_attribute
+        &out_node_community_attribute,
+        &execution_mode_obj
     )) {
         return NULL;
     }
+    CXMeasurementExecutionMode execution_mode = CXMeasurementExecutionSingleThread;
+    if (execution_mode_obj && execution_mode_obj != Py_None && parse_execution_mode(execution_mode_obj, &execution_mode) != 0) {
+        return NULL;
+    }
     if (!self->network) {
         PyErr_SetString(PyExc_RuntimeError, "Network is not initialized");
         return NULL;
@@ -3039,6 +3383,7 @@ static PyObject *Network_measure_leiden_modularity(PyHeliosNetwork *self, PyObje
         (uint32_t)seed,
         (CXSize)max_levels,
         (CXSize)max_passes,
+        execution_mode,
         out_node_community_attribute,
         &modularity
     );
@@ -3078,6 +3423,7 @@ static PyObject *Network_measure_leiden_modularity(PyHeliosNetwork *self, PyObje
     PyObject *max_levels_out = PyLong_FromUnsignedLong(max_levels);
     PyObject *max_passes_out = PyLong_FromUnsignedLong(max_passes);
     PyObject *out_name_out = PyUnicode_FromString(out_node_community_attribute);
+    PyObject *execution_out = PyLong_FromLong((long)execution_mode);
     PyObject *weight_name_out = NULL;
     if (edge_weight_attribute) {
         weight_name_out = PyUnicode_FromString(edge_weight_attribute);
@@ -3094,6 +3440,7 @@ static PyObject *Network_measure_leiden_modularity(PyHeliosNetwork *self, PyObje
         !max_levels_out ||
         !max_passes_out ||
         !out_name_out ||
+        !execution_out ||
         !weight_name_out
     ) {
         Py_XDECREF(community_count_out);
@@ -3103,6 +3450,7 @@ static PyObject *Network_measure_leiden_modularity(PyHeliosNetwork *self, PyObje
         Py_XDECREF(max_levels_out);
         Py_XDECREF(max_passes_out);
         Py_XDECREF(out_name_out);
+        Py_XDECREF(execution_out);
         Py_XDECREF(weight_name_out);
         Py_DECREF(values_list);
         Py_DECREF(result);
@@ -3117,6 +3465,7 @@ static PyObject *Network_measure_leiden_modularity(PyHeliosNetwork *self, PyObje
     PyDict_SetItemString(result, "max_levels", max_levels_out);
     PyDict_SetItemString(result, "max_passes", max_passes_out);
     PyDict_SetItemString(result, "out_node_community_attribute", out_name_out);
+    PyDict_SetItemString(result, "execution_mode", execution_out);
     PyDict_SetItemString(result, "edge_weight_attribute", weight_name_out);
 
     Py_DECREF(values_list);
@@ -3127,6 +3476,7 @@ static PyObject *Network_measure_leiden_modularity(PyHeliosNetwork *self, PyObje
     Py_DECREF(max_levels_out);
     Py_DECREF(max_passes_out);
     Py_DECREF(out_name_out);
+    Py_DECREF(execution_out);
     Py_DECREF(weight_name_out);
     return result;
 }
@@ -3210,6 +3560,11 @@ static PyMethodDef Network_methods[] = {
     {"edge_count", (PyCFunction)Network_edge_count, METH_NOARGS, "Return number of active edges."},
     {"node_capacity", (PyCFunction)Network_node_capacity, METH_NOARGS, "Return node capacity."},
     {"edge_capacity", (PyCFunction)Network_edge_capacity, METH_NOARGS, "Return edge capacity."},
+    {"freeze", (PyCFunction)Network_freeze, METH_NOARGS, "Pack adjacency into one contiguous block until the next topology change."},
+    {"thaw", (PyCFunction)Network_thaw, METH_NOARGS, "Restore growable per-node adjacency lists."},
+    {"is_frozen", (PyCFunction)Network_is_frozen, METH_NOARGS, "Return whether adjacency is currently frozen."},
+    {"set_fast_edge_removal", (PyCFunction)Network_set_fast_edge_removal, METH_VARARGS, "Enable constant-time edge removal that does not preserve neighbour order."},
+    {"has_fast_edge_removal", (PyCFunction)Network_has_fast_edge_removal, METH_NOARGS, "Return whether constant-time edge removal is enabled."},
     {"add_nodes", (PyCFunction)Network_add_nodes, METH_VARARGS, "Add nodes and return indices."},
     {"remove_nodes", (PyCFunction)Network_remove_nodes, METH_VARARGS, "Remove nodes by indices."},
     {"add_edges", (PyCFunction)Network_add_edges, METH_VARARGS, "Add edges and return indices."},
@@ -3234,9 +3589,12 @@ static PyMethodDef Network_methods[] = {
     {"get_attribute_value", (PyCFunction)Network_get_attribute_value, METH_VARARGS, "Get attribute value."},
     {"select_nodes", (PyCFunction)Network_select_nodes, METH_VARARGS, "Select nodes by query expression."},
     {"select_edges", (PyCFunction)Network_select_edges, METH_VARARGS, "Select edges by query expression."},
+    {"prepare_query", (PyCFunction)Network_prepare_query, METH_VARARGS, "Prepare a node or edge query for repeated execution."},
+    {"attribute_index", (PyCFunction)Network_attribute_index, METH_VARARGS, "Create, drop, or test a secondary attribute index."},
+    {"execute_query", (PyCFunction)Network_execute_query, METH_VARARGS, "Execute a prepared query and return the matching ids."},
     {"save_xnet", (PyCFunction)Network_save_xnet, METH_VARARGS, "Save network as .xnet."},
-    {"save_bxnet", (PyCFunction)Network_save_bxnet, METH_VARARGS, "Save network as .bxnet."},
-    {"save_zxnet", (PyCFunction)Network_save_zxnet, METH_VARARGS, "Save network as .zxnet."},
+    {"save_bxnet", (PyCFunction)Network_save_bxnet, METH_VARARGS | METH_KEYWORDS, "Save network as .bxnet (include_adjacency=True also stores the adjacency lists)."},
+    {"save_zxnet", (PyCFunction)Network_save_zxnet, METH_VARARGS | METH_KEYWORDS, "Save network as .zxnet (include_adjacency=True also stores the adjacency lists; threads sets the BGZF compression threads)."},
     {"save_gml", (PyCFunction)Network_save_gml, METH_VARARGS, "Save network as .gml."},
     {"save_gt", (PyCFunction)Network_save_gt, METH_VARARGS, "Save network as graph-tool .gt."},
     {"save_node_link_json", (PyCFunction)Network_save_node_link_json, METH_VARARGS, "Save network as node-link JSON."},
@@ -3247,6 +3605,7 @@ static PyMethodDef Network_methods[] = {
     {"measure_degree", (PyCFunction)Network_measure_degree, METH_VARARGS | METH_KEYWORDS, "Measure node degree values."},
     {"measure_strength", (PyCFunction)Network_measure_strength, METH_VARARGS | METH_KEYWORDS, "Measure node strength values."},
     {"measure_local_clustering_coefficient", (PyCFunction)Network_measure_local_clustering_coefficient, METH_VARARGS | METH_KEYWORDS, "Measure local clustering coefficient values."},
+    {"measure_triangles", (PyCFunction)Network_measure_triangles, METH_VARARGS | METH_KEYWORDS, "Count triangles per node and compute global transitivity."},
     {"measure_coreness", (PyCFunction)Network_measure_coreness, METH_VARARGS | METH_KEYWORDS, "Measure node coreness (k-core index) values."},
     {"measure_eigenvector_centrality", (PyCFunction)Network_measure_eigenvector_centrality, METH_VARARGS | METH_KEYWORDS, "Measure eigenvector centrality values."},
     {"measure_betweenness_centrality", (PyCFunction)Network_measure_betweenness_centrality, METH_VARARGS | METH_KEYWORDS, "Measure betweenness centrality values."},
@@ -3521,27 +3880,75 @@ static PyObject *module_read_xnet(PyObject *self, PyObject *args) {
     return Network_FromCXNetwork(network);
 }
 
-static PyObject *module_read_bxnet(PyObject *self, PyObject *args) {
+static PyObject *module_read_bxnet(PyObject *self, PyObject *args, PyObject *kwargs) {
     (void)self;
     const char *path = NULL;
-    if (!PyArg_ParseTuple(args, "s", &path)) {
-        return NULL;
+    int memoryMap = 0;
+    PyObject *nodeObj = Py_None;
+    PyObject *edgeObj = Py_None;
+    PyObject *networkObj = Py_None;
+    static char *kwlist[] = {"path", "memory_map", "node_attributes", "edge_attributes", "network_attributes", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s|p$OOO", kwlist, &path, &memoryMap, &nodeObj, &edgeObj, &networkObj)) {
+        return NULL;
+    }
+    AttributeNameList lists[3];
+    int filtered = 0;
+    if (parse_attribute_filters(nodeObj, edgeObj, networkObj, lists, &filtered) < 0) {
+        return NULL;
+    }
+    CXNetworkRef network = NULL;
+    if (filtered && memoryMap) {
+        PyErr_SetString(PyExc_ValueError, "attribute filters cannot be combined with memory_map");
+    } else if (filtered) {
+        network = CXNetworkReadBXNetFiltered(path,
+            lists[0].names, lists[0].count, NULL, 0,
+            lists[1].names, lists[1].count, NULL, 0,
+            lists[2].names, lists[2].count, NULL, 0);
+    } else {
+        network = memoryMap ? CXNetworkMapBXNet(path) : CXNetworkReadBXNet(path);
+    }
+    for (int i = 0; i < 3; i++) {
+        release_attribute_names(&lists[i]);
     }
-    CXNetworkRef network = CXNetworkReadBXNet(path);
     if (!network) {
-        PyErr_SetString(PyExc_IOError, "Failed to read BXNet file");
+        if (!PyErr_Occurred()) {
+            PyErr_SetString(PyExc_IOError, "Failed to read BXNet file");
+        }
         return NULL;
     }
     return Network_FromCXNetwork(network);
 }
 
-static PyObject *module_read_zxnet(PyObject *self, PyObject *args) {
+static PyObject *module_read_zxnet(PyObject *self, PyObject *args, PyObject *kwargs) {
     (void)self;
     const char *path = NULL;
-    if (!PyArg_ParseTuple(args, "s", &path)) {
+    Py_ssize_t threads = -1;
+    PyObject *nodeObj = Py_None;
+    PyObject *edgeObj = Py_None;
+    PyObject *networkObj = Py_None;
+    static char *kwlist[] = {"path", "threads", "node_attributes", "edge_attributes", "network_attributes", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s|$nOOO", kwlist, &path, &threads, &nodeObj, &edgeObj, &networkObj)) {
+        return NULL;
+    }
+    AttributeNameList lists[3];
+    int filtered = 0;
+    if (parse_attribute_filters(nodeObj, edgeObj, networkObj, lists, &filtered) < 0) {
         return NULL;
     }
-    CXNetworkRef network = CXNetworkReadZXNet(path);
+    CXSize previousThreads = CXNetworkGetZXNetThreadCount();
+    if (threads >= 0) {
+        CXNetworkSetZXNetThreadCount((CXSize)threads);
+    }
+    CXNetworkRef network = filtered
+        ? CXNetworkReadZXNetFiltered(path,
+            lists[0].names, lists[0].count, NULL, 0,
+            lists[1].names, lists[1].count, NULL, 0,
+            lists[2].names, lists[2].count, NULL, 0)
+        : CXNetworkReadZXNet(path);
+    CXNetworkSetZXNetThreadCount(previousThreads);
+    for (int i = 0; i < 3; i++) {
+        release_attribute_names(&lists[i]);
+    }
     if (!network) {
         PyErr_SetString(PyExc_IOError, "Failed to read ZXNet file");
         return NULL;
@@ -3568,6 +3975,30 @@ static PyObject *module_read_gml(PyObject *self, PyObject *args) {
     return Network_FromCXNetwork(network);
 }
 
+static PyObject *module_read_node_link_json(PyObject *self, PyObject *args) {
+    (void)self;
+    const char *path = NULL;
+    if (!PyArg_ParseTuple(args, "s", &path)) {
+        return NULL;
+    }
+    CXNetworkRef network = CXNetworkReadNodeLinkJSON(path);
+    if (!network) {
+        const char *message = CXNetworkSerializationLastWarningMessage();
+        if (message && message[0] != '\0') {
+            PyErr_SetString(PyExc_ValueError, message);
+        } else {
+            PyErr_SetString(PyExc_IOError, "Failed to read node-link JSON file");
+        }
+        return NULL;
+    }
+    emit_serialization_warning();
+    if (PyErr_Occurred()) {
+        CXFreeNetwork(network);
+        return NULL;
+    }
+    return Network_FromCXNetwork(network);
+}
+
 static PyObject *module_read_gt(PyObject *self, PyObject *args) {
     (void)self;
     const char *path = NULL;
@@ -3587,6 +4018,25 @@ static PyObject *module_read_gt(PyObject *self, PyObject *args) {
     return Network_FromCXNetwork(network);
 }
 
+static PyObject *module_set_worker_count(PyObject *self, PyObject *args) {
+    (void)self;
+    Py_ssize_t count = 0;
+    if (!PyArg_ParseTuple(args, "n", &count)) {
+        return NULL;
+    }
+    if (count < 0) {
+        PyErr_SetString(PyExc_ValueError, "worker count must be non-negative");
+        return NULL;
+    }
+    CXThreadPoolSetWorkerCount((CXSize)count);
+    Py_RETURN_NONE;
+}
+
+static PyObject *module_get_worker_count(PyObject *self, PyObject *Py_UNUSED(ignored)) {
+    (void)self;
+    return PyLong_FromSize_t((size_t)CXThreadPoolGetWorkerCount());
+}
+
 static PyMethodDef module_methods[] = {
     {"generate_stochastic_block_model", (PyCFunction)module_generate_stochastic_block_model, METH_VARARGS | METH_KEYWORDS, "Generate a stochastic block model network."},
     {"generate_barabasi_albert", (PyCFunction)module_generate_barabasi_albert, METH_VARARGS | METH_KEYWORDS, "Generate a Barabasi-Albert preferential attachment network."},
@@ -3596,10 +4046,13 @@ static PyMethodDef module_methods[] = {
     {"generate_configuration_model", (PyCFunction)module_generate_configuration_model, METH_VARARGS | METH_KEYWORDS, "Generate a configuration model network."},
     {"generate_lattice_2d", (PyCFunction)module_generate_lattice_2d, METH_VARARGS | METH_KEYWORDS, "Generate a 2D lattice network."},
     {"read_xnet", (PyCFunction)module_read_xnet, METH_VARARGS, "Read .xnet file into a Network."},
-    {"read_bxnet", (PyCFunction)module_read_bxnet, METH_VARARGS, "Read .bxnet file into a Network."},
-    {"read_zxnet", (PyCFunction)module_read_zxnet, METH_VARARGS, "Read .zxnet file into a Network."},
+    {"read_bxnet", (PyCFunction)module_read_bxnet, METH_VARARGS | METH_KEYWORDS, "Read .bxnet file into a Network (optionally through a memory map)."},
+    {"read_zxnet", (PyCFunction)module_read_zxnet, METH_VARARGS | METH_KEYWORDS, "Read .zxnet file into a Network (threads sets the BGZF decompression threads)."},
     {"read_gml", (PyCFunction)module_read_gml, METH_VARARGS, "Read .gml file into a Network."},
+    {"read_node_link_json", (PyCFunction)module_read_node_link_json, METH_VARARGS, "Read node-link JSON file into a Network."},
     {"read_gt", (PyCFunction)module_read_gt, METH_VARARGS, "Read graph-tool .gt file into a Network."},
+    {"set_worker_count", (PyCFunction)module_set_worker_count, METH_VARARGS, "Set the native worker count (0 restores the automatic default)."},
+    {"get_worker_count", (PyCFunction)module_get_worker_count, METH_NOARGS, "Return the effective native worker count."},
     {NULL, NULL, 0, NULL}
 };
 
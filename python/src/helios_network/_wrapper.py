@@ -395,6 +395,24 @@ class Network:
         self._emit_category_changed(_coerce_scope(scope), name, "categorize")
         return result
 
+    def create_attribute_index(self, scope, name: str):
+        """
+        Index a node or edge attribute so selective queries skip the scan.
+
+        Scalar numeric attributes are kept sorted by value; categorical and
+        multi-category attributes keep one row list per category. The index
+        is rebuilt lazily after values or the topology change.
+        """
+        return self._core.attribute_index(_coerce_scope(scope), name, "create")
+
+    def drop_attribute_index(self, scope, name: str) -> bool:
+        """Remove an attribute index; returns False when there was none."""
+        return self._core.attribute_index(_coerce_scope(scope), name, "drop")
+
+    def has_attribute_index(self, scope, name: str) -> bool:
+        """Return True when the attribute has an index."""
+        return self._core.attribute_index(_coerce_scope(scope), name, "has")
+
     def decategorize_attribute(self, scope, name: str, **kwargs):
         result = self._core.decategorize_attribute(_coerce_scope(scope), name, **kwargs)
         self._emit_category_changed(_coerce_scope(scope), name, "decategorize")
@@ -643,6 +661,7 @@ class Network:
         max_levels: int = 32,
         max_passes: int = 8,
         out_node_community_attribute: str = "community",
+        execution_mode="single-thread",
     ):
         """
         Run Leiden community detection optimizing modularity.
@@ -661,6 +680,11 @@ class Network:
             Maximum local-moving passes per phase.
         out_node_community_attribute: str
             Node attribute name to store detected community ids.
+        execution_mode: str | int
+            ``"parallel"`` decides local moves in batches on the thread pool;
+            the result is reproducible for a seed regardless of the worker
+            count but differs from the ``"single-thread"`` (and ``"auto"``)
+            scheme.
 
         Returns:
         --------
@@ -675,6 +699,7 @@ class Network:
             max_levels=int(max_levels),
             max_passes=int(max_passes),
             out_node_community_attribute=out_node_community_attribute,
+            execution_mode=execution_mode,
         )
         if not existed:
             self._emit_attribute_defined(
@@ -899,6 +924,30 @@ class Network:
         ids = self._core.select_edges(where_expr)
         return EdgeSelector(self, ids)
 
+    def prepare_query(self, where_expr: str, scope="node") -> "PreparedQuery":
+        """
+        Parse and bind a query once for repeated selection.
+
+        Parameters:
+        -----------
+        where_expr: str
+            Query expression string.
+        scope: str | AttributeScope
+            ``"node"`` or ``"edge"``.
+
+        Returns:
+        --------
+        PreparedQuery
+            Handle whose ``execute()`` re-runs the bound plan; it is rebound
+            automatically when a referenced attribute is redefined.
+        """
+        if not isinstance(where_expr, str):
+            raise TypeError("Query expression must be a string")
+        scope_id = _coerce_scope(scope)
+        if scope_id not in (_core.SCOPE_NODE, _core.SCOPE_EDGE):
+            raise ValueError("Prepared queries select nodes or edges")
+        return PreparedQuery(self, scope_id, self._core.prepare_query(where_expr, scope_id))
+
     def apply_text_batch(self, text: str, stop_on_error: bool = True):
         """
         Apply a text batch of stream commands to this network.
@@ -1522,6 +1571,35 @@ class EdgeSelector:
         return list(self._ids)
 
 
+class PreparedQuery:
+    """
+    Node or edge query bound to a network (see ``Network.prepare_query``).
+    """
+
+    def __init__(self, network: Network, scope: int, handle):
+        self._network = network
+        self._scope = scope
+        self._handle = handle
+
+    @property
+    def scope(self) -> int:
+        return self._scope
+
+    def execute(self):
+        """
+        Evaluate the query against the current network state.
+
+        Returns:
+        --------
+        NodeSelector | EdgeSelector
+            Selector with the matching ids.
+        """
+        ids = self._network._core.execute_query(self._handle)
+        if self._scope == _core.SCOPE_NODE:
+            return NodeSelector(self._network, ids)
+        return EdgeSelector(self._network, ids)
+
+
 class NodeCollection:
     """
     Active node collection with selector helpers.
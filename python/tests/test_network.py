@@ -28,6 +28,8 @@ from helios_network import (
     generate_random_geometric,
     generate_stochastic_block_model,
     generate_watts_strogatz,
+    get_worker_count,
+    set_worker_count,
 )
 
 
@@ -333,6 +335,26 @@ def test_measure_leiden_modularity_recovers_two_cliques():
     assert network.get_attribute_value(AttributeScope.Node, "leiden", nodes[0]) == values[nodes[0]]
 
 
+
+def test_measure_leiden_modularity_parallel_is_reproducible():
+    network = Network(directed=False)
+    nodes = network.add_nodes(10)
+    edges = []
+    for start in (0, 5):
+        for i in range(start, start + 5):
+            for j in range(i + 1, start + 5):
+                edges.append((nodes[i], nodes[j]))
+    edges.append((nodes[4], nodes[5]))
+    network.add_edges(edges)
+
+    first = network.measure_leiden_modularity(seed=11, execution_mode="parallel", out_node_community_attribute="leiden")
+    second = network.measure_leiden_modularity(seed=11, execution_mode="parallel", out_node_community_attribute="leiden")
+
+    assert first["execution_mode"] == 2
+    assert first["community_count"] == 2
+    assert first["values_by_node"] == second["values_by_node"]
+    assert first["modularity"] == second["modularity"]
+
 def test_measure_coreness():
     network = Network(directed=False)
     nodes = network.add_nodes(6)
@@ -387,6 +409,13 @@ def test_query_select_nodes_and_edges():
 
     regex_selector = network.select_nodes('label =~ "^g"')
     assert regex_selector.ids == [nodes[2]]
+    assert network.select_nodes('label =~ "et"').ids == [nodes[1]]
+
+    network.define_attribute(AttributeScope.Node, "kind", AttributeType.String, 1)
+    network.nodes["kind"] = ["red", "dark_red", "blue"]
+    network.categorize_attribute(AttributeScope.Node, "kind")
+    assert network.select_nodes('kind =~ "red$"').ids == [nodes[0], nodes[1]]
+    assert network.select_nodes('kind =~ "^b|^d"').ids == [nodes[1], nodes[2]]
 
     network.define_attribute(AttributeScope.Node, "vec2", AttributeType.Float, 2)
     network.set_attribute_value(AttributeScope.Node, "vec2", nodes[0], (0.2, 0.4))
@@ -418,6 +447,59 @@ def test_query_select_nodes_and_edges():
     assert vec_dot_const.ids == [nodes[2]]
 
 
+def test_prepared_query_reuse():
+    import pytest
+
+    network = Network(directed=False)
+    nodes = network.add_nodes(3)
+    edges = network.add_edges([(nodes[0], nodes[1]), (nodes[1], nodes[2])])
+    network.define_attribute(AttributeScope.Node, "score", AttributeType.Float, 1)
+    network.nodes["score"] = [0.5, 2.0, 3.5]
+
+    query = network.prepare_query("score > 1.0")
+    assert query.execute().ids == [nodes[1], nodes[2]]
+    network.nodes["score"] = [4.0, 0.0, 3.5]
+    assert query.execute().ids == [nodes[0], nodes[2]]
+
+    edge_query = network.prepare_query("$both.score > 1.0", scope="edge")
+    assert edge_query.execute().ids == []
+    network.nodes["score"] = [4.0, 2.0, 0.0]
+    assert edge_query.execute().ids == [edges[0]]
+
+    with pytest.raises(ValueError):
+        network.prepare_query("score >")
+    with pytest.raises(ValueError):
+        network.prepare_query("score > 1", scope="network")
+
+
+def test_attribute_index_queries():
+    import pytest
+
+    network = Network(directed=False)
+    nodes = network.add_nodes(5)
+    network.define_attribute(AttributeScope.Node, "score", AttributeType.Float, 1)
+    network.nodes["score"] = [0.5, 2.0, 3.5, 2.0, 9.0]
+    network.define_attribute(AttributeScope.Node, "vec", AttributeType.Float, 2)
+
+    assert not network.has_attribute_index(AttributeScope.Node, "score")
+    network.create_attribute_index(AttributeScope.Node, "score")
+    assert network.has_attribute_index(AttributeScope.Node, "score")
+    assert network.select_nodes("score == 2.0").ids == [nodes[1], nodes[3]]
+    assert network.select_nodes("score >= 3.5 AND score < 9").ids == [nodes[2]]
+
+    network.nodes["score"] = [5.0, 0.0, 0.0, 0.0, 0.0]
+    assert network.select_nodes("score > 1").ids == [nodes[0]]
+    network.remove_nodes([nodes[0]])
+    assert network.select_nodes("score > 1").ids == []
+
+    with pytest.raises(ValueError):
+        network.create_attribute_index(AttributeScope.Node, "vec")
+    with pytest.raises(KeyError):
+        network.create_attribute_index(AttributeScope.Node, "missing")
+    assert network.drop_attribute_index(AttributeScope.Node, "score")
+    assert not network.drop_attribute_index(AttributeScope.Node, "score")
+
+
 def test_apply_text_batch_relative_ids():
     network = Network(directed=False)
     network.define_attribute(AttributeScope.Node, "weight", AttributeType.Float, 1)
@@ -471,6 +553,12 @@ def test_save_load_bxnet_roundtrip():
         loaded = read_bxnet(path)
         assert loaded.node_count() == network.node_count()
         assert loaded.edge_count() == network.edge_count()
+        mapped = read_bxnet(path, memory_map=True)
+        assert mapped.node_count() == network.node_count()
+        assert mapped.edge_count() == network.edge_count()
+        expected = sorted(network.out_neighbors(nodes[1])["nodes"])
+        assert sorted(loaded.out_neighbors(nodes[1])["nodes"]) == expected
+        assert sorted(mapped.out_neighbors(nodes[1])["nodes"]) == expected
 
 
 def test_save_load_zxnet_roundtrip():
@@ -486,6 +574,36 @@ def test_save_load_zxnet_roundtrip():
         assert loaded.edge_count() == network.edge_count()
 
 
+def test_zxnet_threaded_roundtrip():
+    network = Network(directed=False)
+    nodes = network.add_nodes(2000)
+    network.add_edges([(nodes[i], nodes[(i * 7 + 1) % 2000]) for i in range(2000)])
+
+    with tempfile.TemporaryDirectory() as tmpdir:
+        path = os.path.join(tmpdir, "threaded.zxnet")
+        network.save_zxnet(path, 6, threads=4)
+        loaded = read_zxnet(path, threads=4)
+        assert loaded.edge_count() == network.edge_count()
+        assert sorted(loaded.out_neighbors(nodes[1])["nodes"]) == sorted(network.out_neighbors(nodes[1])["nodes"])
+        assert read_zxnet(path).edge_count() == network.edge_count()
+
+
+def test_save_with_adjacency_roundtrip():
+    network = Network(directed=True)
+    nodes = network.add_nodes(4)
+    network.add_edges([(nodes[0], nodes[1]), (nodes[2], nodes[1]), (nodes[1], nodes[3])])
+
+    with tempfile.TemporaryDirectory() as tmpdir:
+        bx_path = os.path.join(tmpdir, "sample.bxnet")
+        zx_path = os.path.join(tmpdir, "sample.zxnet")
+        network.save_bxnet(bx_path, include_adjacency=True)
+        network.save_zxnet(zx_path, 4, include_adjacency=True)
+        for loaded in (read_bxnet(bx_path), read_bxnet(bx_path, memory_map=True), read_zxnet(zx_path)):
+            assert loaded.edge_count() == network.edge_count()
+            assert loaded.out_neighbors(nodes[1])["nodes"] == network.out_neighbors(nodes[1])["nodes"]
+            assert loaded.in_neighbors(nodes[1])["nodes"] == network.in_neighbors(nodes[1])["nodes"]
+
+
 def test_save_load_gml_roundtrip_with_warning():
     network = Network(directed=True)
     nodes = network.add_nodes(3)
@@ -810,6 +928,25 @@ def test_measure_degree_strength_and_clustering_known_values():
     assert abs(newman["values_by_node"][2] - 1.0) < 1e-6
 
 
+def test_measure_triangles_counts_and_transitivity():
+    network = Network(directed=True)
+    nodes = network.add_nodes(5)
+    network.add_edges([
+        (nodes[0], nodes[1]),
+        (nodes[0], nodes[2]),
+        (nodes[1], nodes[2]),
+        (nodes[2], nodes[1]),
+        (nodes[1], nodes[3]),
+        (nodes[2], nodes[3]),
+        (nodes[3], nodes[4]),
+    ])
+
+    result = network.measure_triangles(execution_mode=MeasurementExecutionMode.Parallel)
+    assert result["triangle_count"] == 2
+    assert abs(result["transitivity"] - 0.6) < 1e-12
+    assert [result["values_by_node"][node] for node in nodes] == [1.0, 2.0, 2.0, 1.0, 0.0]
+
+
 def test_measure_eigenvector_and_betweenness_known_values():
     star = Network(directed=False)
     nodes = star.add_nodes(5)
@@ -839,6 +976,47 @@ def test_measure_eigenvector_and_betweenness_known_values():
     assert abs(b_values[3]) < 1e-6
 
 
+def test_worker_count_controls_parallel_measurements():
+    network = generate_watts_strogatz(200, neighbor_level=2, rewiring_probability=0.0, seed=3)
+    single = network.measure_betweenness_centrality(execution_mode=MeasurementExecutionMode.SingleThread)
+    set_worker_count(3)
+    try:
+        assert 1 <= get_worker_count() <= 3
+        parallel = network.measure_betweenness_centrality(execution_mode=MeasurementExecutionMode.Parallel)
+    finally:
+        set_worker_count(0)
+    assert get_worker_count() >= 1
+    for idx in range(network.node_capacity()):
+        assert abs(parallel["values_by_node"][idx] - single["values_by_node"][idx]) < 1e-6
+
+
+def test_freeze_packs_adjacency_and_thaws_on_mutation():
+    network = Network(directed=False)
+    nodes = network.add_nodes(3)
+    network.add_edges([(nodes[0], nodes[1]), (nodes[1], nodes[2])])
+    network.freeze()
+    assert network.is_frozen()
+    assert sorted(network.out_neighbors(nodes[1])["nodes"]) == [nodes[0], nodes[2]]
+    network.add_edges([(nodes[0], nodes[2])])
+    assert not network.is_frozen()
+    assert sorted(network.out_neighbors(nodes[0])["nodes"]) == [nodes[1], nodes[2]]
+
+
+def test_fast_edge_removal_keeps_adjacency_consistent():
+    network = Network(directed=False)
+    network.set_fast_edge_removal(True)
+    assert network.has_fast_edge_removal()
+    nodes = network.add_nodes(4)
+    edges = network.add_edges([(nodes[0], nodes[1]), (nodes[0], nodes[2]), (nodes[0], nodes[3]), (nodes[2], nodes[3])])
+    network.remove_edges([edges[0]])
+    assert sorted(network.out_neighbors(nodes[0])["nodes"]) == [nodes[2], nodes[3]]
+    network.remove_nodes([nodes[3]])
+    assert list(network.out_neighbors(nodes[0])["nodes"]) == [nodes[2]]
+    assert list(network.out_neighbors(nodes[2])["nodes"]) == [nodes[0]]
+    network.set_fast_edge_removal(False)
+    assert not network.has_fast_edge_removal()
+
+
 def test_measure_betweenness_chunk_accumulation_matches_full_run():
     network = Network(directed=False)
     nodes = network.add_nodes(4)
@@ -867,3 +1045,33 @@ def test_measure_betweenness_chunk_accumulation_matches_full_run():
     )
     for idx in range(network.node_capacity()):
         assert abs(chunk_b["values_by_node"][idx] - full["values_by_node"][idx]) < 1e-6
+
+
+def test_read_with_attribute_filters():
+    import pytest
+
+    network = Network(directed=False)
+    nodes = network.add_nodes(3)
+    network.add_edges([(nodes[0], nodes[1]), (nodes[1], nodes[2])])
+    network.define_attribute(AttributeScope.Node, "keep", AttributeType.Double, 1)
+    network.define_attribute(AttributeScope.Node, "drop", AttributeType.Double, 4)
+    network.define_attribute(AttributeScope.Edge, "weight", AttributeType.Float, 1)
+    network.set_attribute_value(AttributeScope.Node, "keep", nodes[2], 2.5)
+
+    with tempfile.TemporaryDirectory() as tmpdir:
+        bx_path = os.path.join(tmpdir, "sample.bxnet")
+        zx_path = os.path.join(tmpdir, "sample.zxnet")
+        network.save_bxnet(bx_path)
+        network.save_zxnet(zx_path)
+        for loaded in (
+            read_bxnet(bx_path, node_attributes=["keep"], edge_attributes=["missing"]),
+            read_zxnet(zx_path, node_attributes=["keep"], edge_attributes=["missing"]),
+        ):
+            assert loaded.edge_count() == network.edge_count()
+            assert loaded.get_attribute_value(AttributeScope.Node, "keep", nodes[2]) == 2.5
+            with pytest.raises(KeyError):
+                loaded.get_attribute_value(AttributeScope.Node, "drop", nodes[2])
+            with pytest.raises(KeyError):
+                loaded.get_attribute_value(AttributeScope.Edge, "weight", 0)
+        with pytest.raises(ValueError):
+            read_bxnet(bx_path, memory_map=True, node_attributes=["keep"])
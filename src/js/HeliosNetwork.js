@@ -241,6 +241,7 @@ const DIMENSION_FORWARD_COEFFICIENTS = Object.freeze([
  * @typedef {object} SaveZXNetOptions
  * @property {string=} path
  * @property {number=} compressionLevel
+ * @property {number=} threads - BGZF compression threads (0 follows the native worker count). Ignored by WASM builds without BGZF threads.
  * @property {('uint8array'|'arraybuffer'|'base64'|'blob'|'string'|'text')=} format
  * @property {AttributeFilterMap=} allowAttributes
  * @property {AttributeFilterMap=} ignoreAttributes
@@ -684,6 +685,25 @@ function createVirtualPath(fs, extension) {
 	return `${VIRTUAL_TEMP_DIR}/${timestamp}-${random}.${extension}`;
 }
 
+/**
+ * Runs `callback` with the native ZXNet thread count set to `threads`, then
+ * restores the previous setting. A no-op when `threads` is omitted or the WASM
+ * build does not export the setter.
+ */
+function withZXNetThreads(module, threads, callback) {
+	if (threads === undefined || threads === null || typeof module._CXNetworkSetZXNetThreadCount !== 'function') {
+		return callback();
+	}
+	const value = Number.isFinite(threads) ? Math.max(0, Math.trunc(threads)) : 1;
+	const previous = module._CXNetworkGetZXNetThreadCount();
+	module._CXNetworkSetZXNetThreadCount(value);
+	try {
+		return callback();
+	} finally {
+		module._CXNetworkSetZXNetThreadCount(previous);
+	}
+}
+
 function clampCompressionLevel(level) {
 	if (!Number.isFinite(level)) {
 		return 6;
@@ -821,6 +841,17 @@ function decodeUTF8(bytes) {
 	throw new Error('UTF-8 decoding is not supported in this environment');
 }
 
+function encodeUTF8(text) {
+	if (typeof TextEncoder !== 'undefined') {
+		return new TextEncoder().encode(text);
+	}
+	if (isNodeRuntime()) {
+		const buffer = Buffer.from(text, 'utf8');
+		return new Uint8Array(buffer.buffer, buffer.byteOffset, buffer.byteLength);
+	}
+	throw new Error('UTF-8 encoding is not supported in this environment');
+}
+
 function isPlainObject(value) {
 	return value !== null && typeof value === 'object' && !Array.isArray(value);
 }
@@ -2652,6 +2683,7 @@ class LeidenSession {
 							seed: sessionOptions.seed ?? 0,
 							maxLevels: sessionOptions.maxLevels ?? 32,
 							maxPasses: sessionOptions.passes ?? sessionOptions.maxPasses ?? 8,
+							executionMode: sessionOptions.executionMode ?? MeasurementExecutionMode.SingleThread,
 							outNodeCommunityAttribute: sessionOptions.outNodeCommunityAttribute ?? 'community',
 							categoricalCommunities: sessionOptions.categoricalCommunities !== false,
 						};
@@ -2668,6 +2700,7 @@ class LeidenSession {
 						seed: snapshot.seed,
 						maxLevels: snapshot.maxLevels,
 						maxPasses: snapshot.maxPasses,
+						executionMode: snapshot.executionMode,
 						outNodeCommunityAttribute: snapshot.outNodeCommunityAttribute,
 					};
 					const transfer = [snapshot.edgePairs.buffer];
@@ -3193,6 +3226,59 @@ class CorenessSession {
 	}
 }
 
+/**
+ * Node or edge query parsed and bound once by `HeliosNetwork.prepareQuery()`.
+ * The native plan is rebound automatically when an attribute it references is
+ * removed, redefined, or re-categorized.
+ */
+class PreparedQuery {
+	constructor(module, network, ptr, scope, text) {
+		this.module = module;
+		this.network = network;
+		this.ptr = ptr;
+		this.scope = scope;
+		this.text = text;
+	}
+
+	/**
+	 * Evaluates the query against the current network state.
+	 *
+	 * @param {object} [options] - Selector return control.
+	 * @param {boolean} [options.asSelector]
+	 * @returns {Uint32Array|NodeSelector|EdgeSelector} Matching indices or selector proxy.
+	 */
+	execute(options = {}) {
+		if (!this.ptr) {
+			throw new Error('Prepared query has been disposed');
+		}
+		this.network._ensureActive();
+		const { asSelector = false } = options;
+		const selector = this.scope === 'edge'
+			? EdgeSelector.create(this.module, this.network)
+			: NodeSelector.create(this.module, this.network);
+		const ok = this.module._CXQueryExecute(this.ptr, selector.ptr);
+		if (!ok) {
+			const { message, offset } = this.network._getQueryError();
+			selector.dispose();
+			throw new Error(`Query failed at ${offset}: ${message}`);
+		}
+		if (asSelector) {
+			return selector._asProxy();
+		}
+		const array = selector.toTypedArray();
+		selector.dispose();
+		return array;
+	}
+
+	/** Releases the native plan. */
+	dispose() {
+		if (this.ptr) {
+			this.module._CXQueryFree(this.ptr);
+			this.ptr = 0;
+		}
+	}
+}
+
 /**
  * High-level JavaScript wrapper around the Helios WASM network implementation.
  * Manages lifetime, attribute registration, and buffer views.
@@ -3412,6 +3498,9 @@ export class HeliosNetwork extends BaseEventTarget {
 	 * @param {Uint8Array|ArrayBuffer|string|Blob|Response} source - Serialized payload or Node file path.
 	 * @param {object} [options]
 	 * @param {object} [options.module] - Optional WASM module to reuse.
+	 * @param {AttributeFilterMap} [options.allowAttributes] - Only load these attributes (per scope).
+	 * @param {AttributeFilterMap} [options.ignoreAttributes] - Skip these attributes (per scope).
+	 * Filtered reads skip the values of excluded attributes and do not verify the file checksum.
 	 * @returns {Promise<HeliosNetwork>} Newly constructed network.
 	 */
 	static async fromBXNet(source, options = {}) {
@@ -3424,6 +3513,10 @@ export class HeliosNetwork extends BaseEventTarget {
 	 * @param {Uint8Array|ArrayBuffer|string|Blob|Response} source - Serialized payload or Node file path.
 	 * @param {object} [options]
 	 * @param {object} [options.module] - Optional WASM module to reuse.
+	 * @param {number} [options.threads] - BGZF decompression threads (0 follows the native worker count).
+	 * @param {AttributeFilterMap} [options.allowAttributes] - Only load these attributes (per scope).
+	 * @param {AttributeFilterMap} [options.ignoreAttributes] - Skip these attributes (per scope).
+	 * Filtered reads do not inflate blocks holding only skipped values, run single-threaded, and do not verify the file checksum.
 	 * @returns {Promise<HeliosNetwork>} Newly constructed network.
 	 */
 	static async fromZXNet(source, options = {}) {
@@ -3471,7 +3564,10 @@ export class HeliosNetwork extends BaseEventTarget {
 	 * Hydrates a network instance from a node-link JSON document.
 	 *
 	 * Accepts a JSON string, Node.js filesystem path, `Blob`/`Response`, bytes,
-	 * or a plain JavaScript object already parsed from JSON.
+	 * or a plain JavaScript object already parsed from JSON. Serialized input is
+	 * handed to the native streaming reader when the WASM build exports it, so
+	 * the document is never materialized as JavaScript objects; plain objects
+	 * (and older builds) go through the JavaScript loader below.
 	 *
 	 * @param {Uint8Array|ArrayBuffer|string|Blob|Response|object} source - Node-link JSON payload, object, or Node file path.
 	 * @param {object} [options]
@@ -3483,6 +3579,17 @@ export class HeliosNetwork extends BaseEventTarget {
 		const module = providedModule || await getModule();
 		moduleInstance = module;
 
+		if (!isPlainObject(source) && typeof module._CXNetworkReadNodeLinkJSON === 'function') {
+			let payload = source;
+			if (typeof source === 'string') {
+				const trimmed = source.trimStart();
+				if (!isNodeRuntime() || trimmed.startsWith('{') || trimmed.startsWith('[')) {
+					payload = encodeUTF8(source);
+				}
+			}
+			return HeliosNetwork._fromSerialized(payload, 'node-link-json', { ...options, module });
+		}
+
 		let document = source;
 		if (!isPlainObject(source)) {
 			const text = await resolveInputText(source);
@@ -9220,6 +9327,101 @@ export class HeliosNetwork extends BaseEventTarget {
 		return array;
 	}
 
+	/**
+	 * Parses and binds a query once so it can be re-run cheaply, e.g. on every
+	 * UI update. Call `dispose()` on the returned handle when done.
+	 *
+	 * @param {string} whereExpr - Query expression.
+	 * @param {object} [options]
+	 * @param {'node'|'edge'} [options.scope='node'] - Elements the query selects.
+	 * @returns {PreparedQuery} Prepared query handle.
+	 */
+	prepareQuery(whereExpr, options = {}) {
+		this._ensureActive();
+		if (typeof whereExpr !== 'string') {
+			throw new Error('Query expression must be a string');
+		}
+		if (typeof this.module._CXQueryPrepare !== 'function') {
+			throw new Error('Prepared queries are unavailable in this WASM build');
+		}
+		const { scope = 'node' } = options;
+		if (scope !== 'node' && scope !== 'edge') {
+			throw new Error('Prepared queries select nodes or edges');
+		}
+		const cstr = new CString(this.module, whereExpr);
+		let ptr = 0;
+		try {
+			ptr = this.module._CXQueryPrepare(this.ptr, scope === 'edge' ? 1 : 0, cstr.ptr);
+		} finally {
+			cstr.dispose();
+		}
+		if (!ptr) {
+			const { message, offset } = this._getQueryError();
+			throw new Error(`Query failed at ${offset}: ${message}`);
+		}
+		return new PreparedQuery(this.module, this, ptr, scope, whereExpr);
+	}
+
+	/**
+	 * Adds a secondary index to a node or edge attribute so selective queries
+	 * (`score > 0.99`, `label IN ("a", "b")`) skip non-matching rows. Scalar
+	 * numeric attributes are kept sorted; categorical and multi-category
+	 * attributes keep one row list per category. The index is rebuilt lazily
+	 * after the attribute version or the topology changes.
+	 *
+	 * @param {'node'|'edge'} scope - Attribute scope.
+	 * @param {string} name - Attribute identifier.
+	 */
+	createAttributeIndex(scope, name) {
+		this._ensureActive();
+		if (scope !== 'node' && scope !== 'edge') {
+			throw new Error('Attribute indexes cover node or edge attributes');
+		}
+		if (typeof this.module._CXNetworkCreateAttributeIndex !== 'function') {
+			throw new Error('Attribute indexes are unavailable in this WASM build');
+		}
+		if (!this._ensureAttributeMetadata(scope, name)) {
+			throw new Error(`Unknown ${scope} attribute "${name}"`);
+		}
+		if (!this._callAttributeIndexFn(this.module._CXNetworkCreateAttributeIndex, scope, name)) {
+			throw new Error(`Attribute "${name}" on ${scope} cannot be indexed`);
+		}
+	}
+
+	/**
+	 * Removes an attribute index.
+	 *
+	 * @param {'node'|'edge'} scope - Attribute scope.
+	 * @param {string} name - Attribute identifier.
+	 * @returns {boolean} False when the attribute had no index.
+	 */
+	dropAttributeIndex(scope, name) {
+		this._ensureActive();
+		return this._callAttributeIndexFn(this.module._CXNetworkDropAttributeIndex, scope, name);
+	}
+
+	/**
+	 * @param {'node'|'edge'} scope - Attribute scope.
+	 * @param {string} name - Attribute identifier.
+	 * @returns {boolean} True when the attribute has an index.
+	 */
+	hasAttributeIndex(scope, name) {
+		this._ensureActive();
+		return this._callAttributeIndexFn(this.module._CXNetworkHasAttributeIndex, scope, name);
+	}
+
+	_callAttributeIndexFn(fn, scope, name) {
+		if (typeof fn !== 'function') {
+			return false;
+		}
+		const cstr = new CString(this.module, name);
+		try {
+			return !!fn.call(this.module, this.ptr, this._scopeId(scope), cstr.ptr);
+		} finally {
+			cstr.dispose();
+		}
+	}
+
 	_normalizeFilterOrder(scope, orderBy) {
 		if (orderBy == null || orderBy === false) {
 			return null;
@@ -9815,6 +10017,81 @@ export class HeliosNetwork extends BaseEventTarget {
 		return this;
 	}
 
+	/**
+	 * Packs the adjacency into one contiguous native block for read-heavy
+	 * workloads. The next topology mutation thaws it automatically.
+	 *
+	 * @returns {HeliosNetwork} This network instance.
+	 */
+	freeze() {
+		this._ensureActive();
+		if (typeof this.module._CXNetworkFreeze !== 'function') {
+			throw new Error('CXNetworkFreeze is not available in this WASM build. Rebuild the module to enable freeze().');
+		}
+		if (!this.module._CXNetworkFreeze(this.ptr)) {
+			throw new Error('Failed to freeze network adjacency');
+		}
+		return this;
+	}
+
+	/**
+	 * Restores growable per-node adjacency lists after {@link HeliosNetwork#freeze}.
+	 *
+	 * @returns {HeliosNetwork} This network instance.
+	 */
+	thaw() {
+		this._ensureActive();
+		if (typeof this.module._CXNetworkThaw !== 'function') {
+			throw new Error('CXNetworkThaw is not available in this WASM build. Rebuild the module to enable thaw().');
+		}
+		if (!this.module._CXNetworkThaw(this.ptr)) {
+			throw new Error('Failed to thaw network adjacency');
+		}
+		return this;
+	}
+
+	/**
+	 * Whether the adjacency is currently frozen.
+	 * @type {boolean}
+	 */
+	get isFrozen() {
+		this._ensureActive();
+		if (typeof this.module._CXNetworkIsFrozen !== 'function') {
+			return false;
+		}
+		return Boolean(this.module._CXNetworkIsFrozen(this.ptr));
+	}
+
+	/**
+	 * Enables or disables constant-time edge removal. While enabled, each edge
+	 * remembers its position in the neighbour lists of its endpoints, so
+	 * removing edges or high-degree nodes costs time proportional to the number
+	 * of removed edges. Neighbour order is not preserved across removals.
+	 *
+	 * @param {boolean} [enabled=true] - Whether to enable the mode.
+	 * @returns {HeliosNetwork} This network instance.
+	 */
+	setFastEdgeRemoval(enabled = true) {
+		this._ensureActive();
+		if (typeof this.module._CXNetworkSetFastEdgeRemoval !== 'function') {
+			throw new Error('CXNetworkSetFastEdgeRemoval is not available in this WASM build. Rebuild the module to enable setFastEdgeRemoval().');
+		}
+		this.module._CXNetworkSetFastEdgeRemoval(this.ptr, enabled ? 1 : 0);
+		return this;
+	}
+
+	/**
+	 * Whether constant-time edge removal is enabled.
+	 * @type {boolean}
+	 */
+	get hasFastEdgeRemoval() {
+		this._ensureActive();
+		if (typeof this.module._CXNetworkHasFastEdgeRemoval !== 'function') {
+			return false;
+		}
+		return Boolean(this.module._CXNetworkHasFastEdgeRemoval(this.ptr));
+	}
+
 	/**
 	 * Measures degree for selected nodes.
 	 *
@@ -9965,6 +10242,71 @@ export class HeliosNetwork extends BaseEventTarget {
 			}
 		}
 
+		/**
+		 * Counts triangles on the undirected projection of the network.
+		 *
+		 * @param {object} [options]
+		 * @param {(number|string)} [options.executionMode='parallel'] - auto/single-thread/parallel
+		 * @param {Array<number>|TypedArray|null} [options.nodes=null] - Optional node subset.
+		 * @param {string|null} [options.outNodeAttribute=null] - Optional node attribute name to store per-node triangle counts.
+		 * @returns {{nodeIndices:Uint32Array, values:Float32Array, valuesByNode:Float32Array, executionMode:number, triangleCount:number, transitivity:number}}
+		 */
+		measureTriangles(options = {}) {
+			this._ensureActive();
+			this._assertCanAllocate('triangle measurement');
+			if (typeof this.module._CXNetworkMeasureTriangles !== 'function') {
+				throw new Error('CXNetworkMeasureTriangles is not available in this WASM build. Rebuild the module to enable measureTriangles().');
+			}
+
+			const executionMode = this._normalizeMeasurementExecutionMode(
+				options.executionMode ?? 'parallel',
+				MeasurementExecutionMode.Parallel
+			);
+			const output = this._resolveNodeMetricOutputAttribute(options.outNodeAttribute ?? null, AttributeType.Float, 'Float');
+			const outPtr = output?.pointer ?? this.module._malloc(this.nodeCapacity * Float32Array.BYTES_PER_ELEMENT);
+			const countPtr = this.module._malloc(BigUint64Array.BYTES_PER_ELEMENT);
+			const transitivityPtr = this.module._malloc(Float64Array.BYTES_PER_ELEMENT);
+			if (!outPtr || !countPtr || !transitivityPtr) {
+				if (!output && outPtr) this.module._free(outPtr);
+				if (countPtr) this.module._free(countPtr);
+				if (transitivityPtr) this.module._free(transitivityPtr);
+				throw new Error('Failed to allocate WASM buffers for triangle measurement');
+			}
+
+			let triangleCount = 0;
+			let transitivity = 0;
+			let valuesByNode;
+			try {
+				const ok = this.module._CXNetworkMeasureTriangles(
+					this.ptr,
+					executionMode >>> 0,
+					outPtr,
+					countPtr,
+					transitivityPtr
+				);
+				if (!ok) {
+					throw new Error('Triangle measurement failed');
+				}
+				const countWord = countPtr / Uint32Array.BYTES_PER_ELEMENT;
+				triangleCount = this.module.HEAPU32[countWord] + this.module.HEAPU32[countWord + 1] * 2 ** 32;
+				transitivity = this.module.HEAPF64[transitivityPtr / Float64Array.BYTES_PER_ELEMENT] ?? 0;
+				valuesByNode = this._copyFloat32NodeValuesFromPointer(outPtr);
+			} finally {
+				if (!output) {
+					this.module._free(outPtr);
+				}
+				this.module._free(countPtr);
+				this.module._free(transitivityPtr);
+			}
+
+			if (output) {
+				this._bumpAttributeVersion('node', output.name, { op: 'set' });
+			}
+
+			const result = this._collectNodeMetricResult(valuesByNode, options.nodes ?? null);
+			return { ...result, executionMode, triangleCount, transitivity };
+		}
+
 		/**
 		 * Measures node coreness (k-core index).
 		 *
@@ -10659,7 +11001,8 @@ export class HeliosNetwork extends BaseEventTarget {
 	 * @param {number} [options.maxLevels=32] - Maximum aggregation levels.
 	 * @param {number} [options.maxPasses=8] - Max local-moving passes per phase.
 	 * @param {number} [options.passes] - Alias for `maxPasses` (`passes` takes precedence when both are set).
-	 * @returns {{communityCount:number, modularity:number}} Result summary.
+	 * @param {(number|string)} [options.executionMode='single-thread'] - auto/single-thread/parallel. Parallel mode is reproducible for a seed but yields a different partition than the sequential scheme.
+	 * @returns {{communityCount:number, modularity:number, executionMode:number}} Result summary.
 	 */
 	leidenModularity(options = {}) {
 		this._ensureActive();
@@ -10675,6 +11018,10 @@ export class HeliosNetwork extends BaseEventTarget {
 			passes,
 		} = options;
 		const resolvedPasses = passes ?? maxPasses ?? 8;
+		const executionMode = this._normalizeMeasurementExecutionMode(
+			options.executionMode ?? 'single-thread',
+			MeasurementExecutionMode.SingleThread
+		);
 
 		if (typeof this.module._CXNetworkLeidenModularity !== 'function') {
 			throw new Error('CXNetworkLeidenModularity is not available in this WASM build. Rebuild the module to enable leidenModularity().');
@@ -10708,6 +11055,7 @@ export class HeliosNetwork extends BaseEventTarget {
 				seed >>> 0,
 				maxLevels >>> 0,
 				resolvedPasses >>> 0,
+				executionMode >>> 0,
 				outName.ptr,
 				modularityPtr
 			);
@@ -10745,7 +11093,7 @@ export class HeliosNetwork extends BaseEventTarget {
 			}
 		}
 
-		return { communityCount, modularity };
+		return { communityCount, modularity, executionMode };
 	}
 
 		/**
@@ -10761,6 +11109,7 @@ export class HeliosNetwork extends BaseEventTarget {
 		 * @param {number} [options.maxLevels=32] - Maximum aggregation levels.
 		 * @param {number} [options.maxPasses=8] - Max local-moving passes per phase.
 		 * @param {number} [options.passes] - Alias for `maxPasses` (`passes` takes precedence when both are set).
+		 * @param {(number|string)} [options.executionMode='single-thread'] - auto/single-thread/parallel (see `leidenModularity`).
 		 * @param {string} [options.outNodeCommunityAttribute='community'] - Default output name for finalize().
 		 * @param {boolean} [options.categoricalCommunities=true] - Store communities as categorical codes instead of integers.
 		 * @returns {LeidenSession} Session handle.
@@ -10779,6 +11128,10 @@ export class HeliosNetwork extends BaseEventTarget {
 				categoricalCommunities = true,
 			} = options;
 		const resolvedPasses = passes ?? maxPasses ?? 8;
+		const executionMode = this._normalizeMeasurementExecutionMode(
+			options.executionMode ?? 'single-thread',
+			MeasurementExecutionMode.SingleThread
+		);
 
 		if (typeof this.module._CXLeidenSessionCreate !== 'function') {
 			throw new Error('CXLeidenSessionCreate is not available in this WASM build. Rebuild the module to enable createLeidenSession().');
@@ -10796,7 +11149,8 @@ export class HeliosNetwork extends BaseEventTarget {
 				resolution,
 				seed >>> 0,
 				maxLevels >>> 0,
-				resolvedPasses >>> 0
+				resolvedPasses >>> 0,
+				executionMode >>> 0
 			);
 		} finally {
 			if (weightName) {
@@ -10816,6 +11170,7 @@ export class HeliosNetwork extends BaseEventTarget {
 				maxLevels,
 				maxPasses: resolvedPasses,
 				passes: resolvedPasses,
+				executionMode,
 			});
 		}
 
@@ -10861,20 +11216,26 @@ export class HeliosNetwork extends BaseEventTarget {
 		const module = providedModule || await getModule();
 		moduleInstance = module;
 
+		const allowFilters = normalizeAttributeFilter(options?.allowAttributes, 'allowAttributes');
+		const ignoreFilters = normalizeAttributeFilter(options?.ignoreAttributes, 'ignoreAttributes');
+		const useFilters = Boolean(allowFilters || ignoreFilters);
 		let extension;
 		let readFn;
+		let filteredReadFn = null;
 		let funcLabel;
 		let humanLabel;
 		switch (kind) {
 			case 'bxnet':
 				extension = 'bxnet';
 				readFn = module._CXNetworkReadBXNet;
+				filteredReadFn = module._CXNetworkReadBXNetFiltered;
 				funcLabel = 'ReadBXNet';
 				humanLabel = '.bxnet';
 				break;
 			case 'zxnet':
 				extension = 'zxnet';
 				readFn = module._CXNetworkReadZXNet;
+				filteredReadFn = module._CXNetworkReadZXNetFiltered;
 				funcLabel = 'ReadZXNet';
 				humanLabel = '.zxnet';
 				break;
@@ -10896,9 +11257,22 @@ export class HeliosNetwork extends BaseEventTarget {
 				funcLabel = 'ReadGT';
 				humanLabel = '.gt';
 				break;
+			case 'node-link-json':
+				extension = 'json';
+				readFn = module._CXNetworkReadNodeLinkJSON;
+				funcLabel = 'ReadNodeLinkJSON';
+				humanLabel = 'node-link JSON';
+				break;
 			default:
 				throw new Error(`Unsupported serialization kind: ${kind}`);
 		}
+		if (useFilters) {
+			if (filteredReadFn === null) {
+				throw new Error(`${humanLabel} deserialization does not support allowAttributes/ignoreAttributes filters`);
+			}
+			readFn = filteredReadFn;
+			funcLabel = `${funcLabel}Filtered`;
+		}
 		if (typeof readFn !== 'function') {
 			throw new Error(`CXNetwork${funcLabel} is not available in this WASM build. Rebuild the artefacts to enable deserialization helpers.`);
 		}
@@ -10935,11 +11309,49 @@ export class HeliosNetwork extends BaseEventTarget {
 		}
 
 		let networkPtr = 0;
+		let filterArrays = null;
 		const cPath = new CString(module, pathForNative);
 		try {
-			networkPtr = readFn.call(module, cPath.ptr);
+			let read = () => readFn.call(module, cPath.ptr);
+			if (useFilters) {
+				filterArrays = {
+					nodeAllow: new CStringArray(module, allowFilters?.node ?? []),
+					nodeIgnore: new CStringArray(module, ignoreFilters?.node ?? []),
+					edgeAllow: new CStringArray(module, allowFilters?.edge ?? []),
+					edgeIgnore: new CStringArray(module, ignoreFilters?.edge ?? []),
+					networkAllow: new CStringArray(module, allowFilters?.network ?? []),
+					networkIgnore: new CStringArray(module, ignoreFilters?.network ?? []),
+				};
+				read = () => readFn.call(
+					module,
+					cPath.ptr,
+					filterArrays.nodeAllow.ptr,
+					filterArrays.nodeAllow.count,
+					filterArrays.nodeIgnore.ptr,
+					filterArrays.nodeIgnore.count,
+					filterArrays.edgeAllow.ptr,
+					filterArrays.edgeAllow.count,
+					filterArrays.edgeIgnore.ptr,
+					filterArrays.edgeIgnore.count,
+					filterArrays.networkAllow.ptr,
+					filterArrays.networkAllow.count,
+					filterArrays.networkIgnore.ptr,
+					filterArrays.networkIgnore.count
+				);
+			}
+			networkPtr = kind === 'zxnet'
+				? withZXNetThreads(module, options?.threads, read)
+				: read();
 		} finally {
 			cPath.dispose();
+			if (filterArrays) {
+				filterArrays.nodeAllow.dispose();
+				filterArrays.nodeIgnore.dispose();
+				filterArrays.edgeAllow.dispose();
+				filterArrays.edgeIgnore.dispose();
+				filterArrays.networkAllow.dispose();
+				filterArrays.networkIgnore.dispose();
+			}
 			if (canUseVirtualFS) {
 				try {
 					fsApi.unlink(pathForNative);
@@ -10952,9 +11364,10 @@ export class HeliosNetwork extends BaseEventTarget {
 		}
 
 		if (!networkPtr) {
-			throw new Error(`Failed to read ${humanLabel} data`);
+			const detail = kind === 'node-link-json' ? HeliosNetwork._lastSerializationWarning(module) : null;
+			throw new Error(detail ? `Failed to read ${humanLabel} data: ${detail}` : `Failed to read ${humanLabel} data`);
 		}
-		if (kind === 'gml' || kind === 'gt') {
+		if (kind === 'gml' || kind === 'gt' || kind === 'node-link-json') {
 			HeliosNetwork._emitSerializationWarning(module);
 		}
 		return HeliosNetwork._wrapNative(module, networkPtr);
@@ -11140,28 +11553,29 @@ export class HeliosNetwork extends BaseEventTarget {
 			}
 			if (kind === 'zxnet') {
 				const level = clampCompressionLevel(options?.compressionLevel ?? 6);
-				if (useFilters) {
-					success = selectedWriteFn.call(
-						module,
-						this.ptr,
-						cPath.ptr,
-						level,
-						filterArrays.nodeAllow.ptr,
-						filterArrays.nodeAllow.count,
-						filterArrays.nodeIgnore.ptr,
-						filterArrays.nodeIgnore.count,
-						filterArrays.edgeAllow.ptr,
-						filterArrays.edgeAllow.count,
-						filterArrays.edgeIgnore.ptr,
-						filterArrays.edgeIgnore.count,
-						filterArrays.networkAllow.ptr,
-						filterArrays.networkAllow.count,
-						filterArrays.networkIgnore.ptr,
-						filterArrays.networkIgnore.count
-					);
-				} else {
-					success = selectedWriteFn.call(module, this.ptr, cPath.ptr, level);
-				}
+				success = withZXNetThreads(module, options?.threads, () => {
+					if (useFilters) {
+						return selectedWriteFn.call(
+							module,
+							this.ptr,
+							cPath.ptr,
+							level,
+							filterArrays.nodeAllow.ptr,
+							filterArrays.nodeAllow.count,
+							filterArrays.nodeIgnore.ptr,
+							filterArrays.nodeIgnore.count,
+							filterArrays.edgeAllow.ptr,
+							filterArrays.edgeAllow.count,
+							filterArrays.edgeIgnore.ptr,
+							filterArrays.edgeIgnore.count,
+							filterArrays.networkAllow.ptr,
+							filterArrays.networkAllow.count,
+							filterArrays.networkIgnore.ptr,
+							filterArrays.networkIgnore.count
+						);
+					}
+					return selectedWriteFn.call(module, this.ptr, cPath.ptr, level);
+				});
 			} else {
 				if (useFilters) {
 					success = selectedWriteFn.call(
@@ -11269,17 +11683,18 @@ export class HeliosNetwork extends BaseEventTarget {
 		return bytesToFormat(bytes, format);
 	}
 
-	static _emitSerializationWarning(module) {
+	static _lastSerializationWarning(module) {
 		const warningFn = module?._CXNetworkSerializationLastWarningMessage;
 		const decode = module?.UTF8ToString;
 		if (typeof warningFn !== 'function' || typeof decode !== 'function') {
-			return;
+			return null;
 		}
 		const ptr = warningFn.call(module);
-		if (!ptr) {
-			return;
-		}
-		const message = decode(ptr);
+		return ptr ? decode(ptr) || null : null;
+	}
+
+	static _emitSerializationWarning(module) {
+		const message = HeliosNetwork._lastSerializationWarning(module);
 		if (message) {
 			console.warn(`[Helios serialization] ${message}`);
 		}
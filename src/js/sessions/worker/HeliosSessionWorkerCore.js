@@ -71,6 +71,7 @@ async function handleCreateLeiden(module, payload) {
 		maxLevels = 32,
 		maxPasses = 8,
 		passes,
+		executionMode = 1, // MeasurementExecutionMode.SingleThread
 		outNodeCommunityAttribute = 'community',
 	} = payload;
 	const resolvedPasses = passes ?? maxPasses;
@@ -134,7 +135,8 @@ async function handleCreateLeiden(module, payload) {
 			Number(resolution),
 			seed >>> 0,
 			maxLevels >>> 0,
-			resolvedPasses >>> 0
+			resolvedPasses >>> 0,
+			executionMode >>> 0
 		);
 		if (weightNamePtr) {
 			weightNamePtr.free();
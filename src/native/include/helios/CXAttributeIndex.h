@@ -0,0 +1,125 @@
+//
+//  CXAttributeIndex.h
+//  Helios Network Core
+//
+//  Optional secondary indexes over node and edge attribute columns, used by
+//  the query planner to answer selective comparisons without scanning every
+//  row. Scalar numeric columns keep their active rows sorted by value;
+//  categorical and multi-category columns keep one posting list per category
+//  id. An index is keyed by the attribute version and the topology version of
+//  its scope and is rebuilt on the next lookup after either changes.
+//
+
+#ifndef CXNetwork_CXAttributeIndex_h
+#define CXNetwork_CXAttributeIndex_h
+
+#include "CXCommons.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct CXNetwork;
+struct CXAttribute;
+
+typedef enum {
+	CXAttributeIndexKindSorted = 0,
+	CXAttributeIndexKindPostings = 1
+} CXAttributeIndexKind;
+
+/**
+ * Index data for one attribute. Only active rows with a defined value are
+ * indexed.
+ *
+ * - Sorted: `values[i]` is the value of row `rows[i]` as a double, ascending;
+ *   equal values keep ascending row order. NaN values are left out.
+ * - Postings: rows holding category id `firstId + k` are
+ *   `rows[offsets[k], offsets[k + 1])`, ascending. A multi-category row is
+ *   listed once per distinct id.
+ */
+typedef struct CXAttributeIndex {
+	CXAttributeIndexKind kind;
+	CXAttributeScope scope;
+	CXBool built;
+	CXAttributeType attributeType;
+	uint64_t attributeVersion;
+	uint64_t topologyVersion;
+	CXSize rowCapacity;
+	CXSize entryCount;
+	CXIndex *rows;     /* entryCount */
+	double *values;    /* entryCount, sorted indexes only */
+	int64_t firstId;
+	CXSize idCount;
+	CXIndex *offsets;  /* idCount + 1, posting indexes only */
+} CXAttributeIndex;
+
+typedef CXAttributeIndex* CXAttributeIndexRef;
+
+/**
+ * Attaches an index to a node or edge attribute and builds it. Supported
+ * attributes are scalar numeric columns (sorted index), scalar categorical
+ * columns, and multi-category columns (posting lists). Returns CXTrue if the
+ * attribute already has one.
+ *
+ * Writes made through raw attribute buffers must be followed by a version bump
+ * (`CXNetworkBumpNodeAttributeVersion` and friends) for the index to see them.
+ */
+CX_EXTERN CXBool CXNetworkCreateAttributeIndex(struct CXNetwork *network, CXAttributeScope scope, const CXString name);
+
+/** Removes the attribute's index. Returns CXFalse when it had none. */
+CX_EXTERN CXBool CXNetworkDropAttributeIndex(struct CXNetwork *network, CXAttributeScope scope, const CXString name);
+
+/** Returns CXTrue when the attribute has an index attached. */
+CX_EXTERN CXBool CXNetworkHasAttributeIndex(struct CXNetwork *network, CXAttributeScope scope, const CXString name);
+
+/**
+ * Returns the index attached to `attribute`, rebuilding it first when the
+ * attribute or the topology of its scope changed since the last build. The
+ * index stays owned by the attribute. Returns NULL when the attribute has no
+ * index, its type is no longer indexable, or the rebuild fails.
+ */
+CX_EXTERN CXAttributeIndexRef CXAttributeIndexAcquire(struct CXNetwork *network, struct CXAttribute *attribute);
+
+/**
+ * Allocates an empty index for an attribute of `scope` (node or edge). It is
+ * built by the first `CXAttributeIndexAcquire`. Used when copying indexed
+ * attributes.
+ */
+CX_EXTERN CXAttributeIndexRef CXAttributeIndexCreate(CXAttributeScope scope);
+
+/** Releases an index and its buffers. */
+CX_EXTERN void CXAttributeIndexDestroy(CXAttributeIndexRef index);
+
+typedef enum {
+	CXAttributeIndexCompareEq = 0,
+	CXAttributeIndexCompareLt,
+	CXAttributeIndexCompareLte,
+	CXAttributeIndexCompareGt,
+	CXAttributeIndexCompareGte
+} CXAttributeIndexCompare;
+
+/**
+ * Returns the positions `[*outStart, *outEnd)` of a sorted index whose values
+ * satisfy `value op target`. NaN targets give an empty range.
+ */
+CX_EXTERN void CXAttributeIndexRange(
+	CXAttributeIndexRef index,
+	CXAttributeIndexCompare op,
+	double target,
+	CXSize *outStart,
+	CXSize *outEnd
+);
+
+/** Returns the posting list of category `id` (empty when the id is unknown). */
+CX_EXTERN void CXAttributeIndexPostings(
+	CXAttributeIndexRef index,
+	int64_t id,
+	CXSize *outStart,
+	CXSize *outEnd
+);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* CXNetwork_CXAttributeIndex_h */
@@ -38,6 +38,12 @@ void CXIndexManagerReset(CXIndexManagerRef manager);
 void CXIndexManagerAddIndex(CXIndexManagerRef manager, CXIndex index);
 /** Retrieves the next available index, growing the pool on demand. */
 CXIndex CXIndexManagerGetIndex(CXIndexManagerRef manager);
+/**
+ * Reserves `count` consecutive indices that were never issued, bypassing the
+ * recycled pool. Returns the first one, or CXIndexMAX if the range does not
+ * fit below the maximum capacity.
+ */
+CXIndex CXIndexManagerTakeRange(CXIndexManagerRef manager, CXSize count);
 /** Adjusts the hard maximum capacity for the manager. */
 CXBool CXResizeIndexManager(CXIndexManagerRef manager, CXSize newMaxCapacity);
 /** Releases any heap allocations associated with the manager. */
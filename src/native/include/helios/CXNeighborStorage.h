@@ -112,6 +112,8 @@ CXBool CXNeighborContainerInit(CXNeighborContainer *container, CXNeighborStorage
 void CXNeighborContainerFree(CXNeighborContainer *container);
 /** Adds a neighbour to the container, dispatching to the proper backend. */
 CXBool CXNeighborContainerAdd(CXNeighborContainer *container, CXIndex node, CXIndex edge);
+/** Makes room for `additional` more entries; list storage grows to the exact size. */
+CXBool CXNeighborContainerReserve(CXNeighborContainer *container, CXSize additional);
 /** Removes edges present in `edgeSet` from the container. */
 CXBool CXNeighborContainerRemoveEdgesFromSet(CXNeighborContainer *container, CXUIntegerSetRef edgeSet);
 /** Removes a batch of edges supplied as an array. */
@@ -134,9 +136,8 @@ CXBool CXNeighborIteratorNext(CXNeighborIterator *iterator);
 
 // Convenience macro for iteration
 #define CXNeighborFOR(nodeVar, edgeVar, containerPtr) \
-	for (CXNeighborIterator __it; \
-		 CXNeighborIteratorInit(&__it, (containerPtr)), \
-		 CXNeighborIteratorNext(&__it); ) \
+	for (CXNeighborIterator __it, *__itStarted = (CXNeighborIteratorInit(&__it, (containerPtr)), &__it); \
+		 __itStarted && CXNeighborIteratorNext(&__it); ) \
 		for (CXBool __once = CXTrue; __once; __once = CXFalse) \
 			for (CXIndex nodeVar = __it.node, edgeVar = __it.edge; __once; __once = CXFalse)
 
@@ -15,6 +15,7 @@
 #include "CXIndexManager.h"
 #include "CXNeighborStorage.h"
 #include "CXSet.h"
+#include "CXThreadPool.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -141,6 +142,7 @@ typedef struct CXAttribute {
 	CXMultiCategoryBuffer *multiCategory;
 	CXBool usesJavascriptShadow;
 	uint64_t version;
+	struct CXAttributeIndex *index; /* optional, see CXAttributeIndex.h */
 } CXAttribute;
 
 typedef CXAttribute* CXAttributeRef;
@@ -201,6 +203,10 @@ typedef struct CXNetwork {
 	CXBool edgeValidRangeDirty;
 	uint64_t nodeTopologyVersion;
 	uint64_t edgeTopologyVersion;
+	struct CXNetworkSnapshot *snapshot; /* cached CSR view, see CXNetworkSnapshot.h */
+	CXIndex *frozenAdjacency; /* contiguous neighbour block while frozen, NULL otherwise */
+	CXBool fastEdgeRemoval; /* see CXNetworkSetFastEdgeRemoval */
+	CXIndex *edgeSlots; /* per-edge positions in the endpoint neighbour lists, NULL until built */
 } CXNetwork;
 
 typedef CXNetwork* CXNetworkRef;
@@ -231,6 +237,30 @@ CX_EXTERN const CXString CXNetworkQueryLastErrorMessage(void);
 /** Returns the byte offset for the most recent query parser/evaluator error. */
 CX_EXTERN CXSize CXNetworkQueryLastErrorOffset(void);
 
+/**
+ * Query parsed, validated and bound once for repeated execution. The handle
+ * keeps a pointer to its network and must not be executed after the network
+ * is freed.
+ */
+typedef struct CXPreparedQuery* CXPreparedQueryRef;
+
+/**
+ * Prepares a node (`CXAttributeScopeNode`) or edge (`CXAttributeScopeEdge`)
+ * query. Returns NULL on errors, reported through CXNetworkQueryLastError*.
+ */
+CX_EXTERN CXPreparedQueryRef CXQueryPrepare(CXNetworkRef network, CXAttributeScope scope, const CXString query);
+/**
+ * Evaluates a prepared query against the current network state, filling the
+ * selector with matching node or edge indices. The bound plan is reused until
+ * an attribute it references is removed, redefined, re-categorized, or has its
+ * category dictionary replaced; it is then rebound from the original text.
+ */
+CX_EXTERN CXBool CXQueryExecute(CXPreparedQueryRef query, CXSelector *selector);
+/** Returns the scope a query was prepared for. */
+CX_EXTERN CXAttributeScope CXQueryScope(CXPreparedQueryRef query);
+/** Releases a prepared query. Safe to call after the network was freed. */
+CX_EXTERN void CXQueryFree(CXPreparedQueryRef query);
+
 // Metadata
 /** Returns the semantic version string for the compiled library (e.g. "1.2.3"). */
 CX_EXTERN const char* CXNetworkVersionString(void);
@@ -365,7 +395,12 @@ CX_EXTERN CXSize CXNetworkCopyNodeAttributesToEdgeAttributes(
  * receives the indices assigned to the created nodes.
  */
 CX_EXTERN CXBool CXNetworkAddNodes(CXNetworkRef network, CXSize count, CXIndex *outIndices);
-/** Removes the supplied nodes, reclaiming their indices for future use. */
+/**
+ * Removes the supplied nodes and their incident edges, reclaiming their
+ * indices for future use. Inactive and repeated ids are ignored. Large
+ * batches are removed in one pass with a single version bump, so pruning
+ * jobs should pass all nodes in a single call.
+ */
 CX_EXTERN CXBool CXNetworkRemoveNodes(CXNetworkRef network, const CXIndex *indices, CXSize count);
 /** Returns CXTrue if the given node index is currently active. */
 CX_EXTERN CXBool CXNetworkIsNodeActive(CXNetworkRef network, CXIndex node);
@@ -375,10 +410,13 @@ CX_EXTERN const CXBool* CXNetworkNodeActivityBuffer(CXNetworkRef network);
 // Edge management
 /**
  * Inserts the provided edges, writing the new indices to `outIndices` when
- * supplied. Edges are expressed as contiguous (from,to) pairs.
+ * supplied. Edges are expressed as contiguous (from,to) pairs. The batch is
+ * validated up front: if any endpoint is out of range or inactive, nothing is
+ * inserted and CXFalse is returned. Large batches size each touched adjacency
+ * list once, so bulk loads should pass all edges in a single call.
  */
 CX_EXTERN CXBool CXNetworkAddEdges(CXNetworkRef network, const CXEdge *edges, CXSize count, CXIndex *outIndices);
-/** Removes the supplied edges from the network. */
+/** Removes the supplied edges from the network, in one pass for large batches. */
 CX_EXTERN CXBool CXNetworkRemoveEdges(CXNetworkRef network, const CXIndex *indices, CXSize count);
 /** Returns CXTrue if the edge index is active. */
 CX_EXTERN CXBool CXNetworkIsEdgeActive(CXNetworkRef network, CXIndex edge);
@@ -635,6 +673,57 @@ CX_EXTERN CXBool CXNetworkCompact(
 	const CXString edgeOriginalIndexAttr
 );
 
+/**
+ * Freezes the adjacency: every list-backed neighbour container is moved into a
+ * single contiguous block (neighbour ids followed by edge ids, laid out node by
+ * node) so traversal through `CXNetworkOutNeighbors`, `CXNeighborIterator` and
+ * `CXNetworkCollectNeighbors` reads sequential memory. The first topology
+ * mutation (add/remove nodes or edges, compaction) thaws the network
+ * automatically. Returns CXFalse on allocation failure, leaving the network
+ * unchanged.
+ */
+CX_EXTERN CXBool CXNetworkFreeze(CXNetworkRef network);
+/**
+ * Restores per-node growable neighbour lists. A no-op for networks that are
+ * not frozen. Returns CXFalse on allocation failure, leaving the network
+ * frozen.
+ */
+CX_EXTERN CXBool CXNetworkThaw(CXNetworkRef network);
+/** Returns CXTrue while the adjacency is stored in the frozen block. */
+CX_EXTERN CXBool CXNetworkIsFrozen(CXNetworkRef network);
+/**
+ * Enables constant-time edge removal. Each edge then records its position in
+ * the neighbour lists of its endpoints (two slots for directed networks, four
+ * for undirected ones), and removing it moves the last entry of each list into
+ * the freed slot instead of shifting the tail. Removing edges, or nodes with
+ * many incident edges, becomes linear in the number of removed edges, but
+ * neighbour order is no longer preserved across removals. The positions are
+ * built on the first removal after enabling and kept up to date by later
+ * insertions. Disabling releases them.
+ */
+CX_EXTERN CXBool CXNetworkSetFastEdgeRemoval(CXNetworkRef network, CXBool enabled);
+/** Returns CXTrue when constant-time edge removal is enabled. */
+CX_EXTERN CXBool CXNetworkHasFastEdgeRemoval(CXNetworkRef network);
+/**
+ * Builds the adjacency of every active edge with a counting sort straight into
+ * the frozen layout, for loaders that fill `edges` and `edgeActive` directly.
+ * All neighbour containers must be empty. Neighbours end up in edge index
+ * order, as if the edges had been added one by one. Returns CXFalse (errno
+ * EINVAL) when an edge endpoint lies outside the node capacity or on
+ * allocation failure; callers discard the network in that case.
+ */
+CX_EXTERN CXBool CXNetworkBuildFrozenAdjacency(CXNetworkRef network);
+/**
+ * Installs a prebuilt frozen adjacency block, e.g. one read from a file. List
+ * `k` (out list of node k/2 when even, in list when odd) spans
+ * `[listOffsets[k], listOffsets[k + 1])` of the neighbour half of `block`,
+ * with the edge ids `listOffsets[2 * nodeCapacity]` entries further on. The
+ * caller has already validated the entries. All neighbour containers must be
+ * empty and list-backed. On success the network takes ownership of `block`;
+ * returns CXFalse (errno EINVAL) otherwise.
+ */
+CX_EXTERN CXBool CXNetworkAdoptFrozenAdjacency(CXNetworkRef network, CXIndex *block, const CXIndex *listOffsets);
+
 // Multiscale dimension measurements -----------------------------------------
 /**
  * Measures node degree for every node index (inactive nodes receive 0).
@@ -677,6 +766,24 @@ CX_EXTERN CXBool CXNetworkMeasureLocalClusteringCoefficient(
 	float *outNodeCoefficient
 );
 
+/**
+ * Counts triangles on the undirected projection of the network (edge
+ * directions, parallel edges, and self-loops are ignored).
+ *
+ * - `outNodeTriangles` (optional) receives the number of triangles through
+ *   each node index and must hold `CXNetworkNodeCapacity(network)` entries.
+ * - `outTriangleCount` (optional) receives the total number of triangles.
+ * - `outTransitivity` (optional) receives the global clustering coefficient,
+ *   3 * triangles / connected triples.
+ */
+CX_EXTERN CXBool CXNetworkMeasureTriangles(
+	CXNetworkRef network,
+	CXMeasurementExecutionMode executionMode,
+	float *outNodeTriangles,
+	uint64_t *outTriangleCount,
+	double *outTransitivity
+);
+
 /**
  * Runs power-iteration eigenvector centrality.
  *
@@ -915,6 +1022,11 @@ CX_EXTERN CXSize CXNetworkMeasureDimension(
  * - For directed graphs, uses the directed modularity formulation.
  * - `resolution` corresponds to the modularity resolution parameter (gamma).
  * - When `edgeWeightAttribute` is NULL/empty, every edge has weight 1.
+ * - `executionMode` selects the local-moving scheme. `Parallel` decides moves
+ *   for batches of nodes on the thread pool and applies them in order, and
+ *   aggregates community rows in parallel; a seed gives the same partition for
+ *   any worker count, though not the one of the sequential scheme. `Auto` and
+ *   `SingleThread` run the sequential scheme.
  *
  * Writes the resulting community id into a node attribute (created when missing)
  * of type `CXUnsignedIntegerAttributeType` and dimension 1.
@@ -928,6 +1040,7 @@ CX_EXTERN CXSize CXNetworkLeidenModularity(
 	uint32_t seed,
 	CXSize maxLevels,
 	CXSize maxPasses,
+	CXMeasurementExecutionMode executionMode,
 	const CXString outNodeCommunityAttribute,
 	double *outModularity
 );
@@ -949,6 +1062,8 @@ typedef enum {
 /**
  * Creates a steppable Leiden session. The network topology and relevant
  * edge weight attribute must not change while the session is active.
+ * `executionMode` behaves as in `CXNetworkLeidenModularity`; in parallel mode
+ * a step processes whole batches, so it may exceed `budget`.
  *
  * Returns NULL on failure.
  */
@@ -958,7 +1073,8 @@ CX_EXTERN CXLeidenSessionRef CXLeidenSessionCreate(
 	double resolution,
 	uint32_t seed,
 	CXSize maxLevels,
-	CXSize maxPasses
+	CXSize maxPasses,
+	CXMeasurementExecutionMode executionMode
 );
 
 /** Releases all resources held by a Leiden session. */
@@ -1085,6 +1201,9 @@ CX_EXTERN CXIndex* CXEdgeSelectorData(CXEdgeSelectorRef selector);
 CX_EXTERN CXSize CXEdgeSelectorCount(CXEdgeSelectorRef selector);
 
 #include "CXNetworkBXNet.h"
+#include "CXNetworkSnapshot.h"
+#include "CXAttributeIndex.h"
+#include "CXNetworkTraversal.h"
 #include "CXNetworkGT.h"
 
 #ifdef __cplusplus
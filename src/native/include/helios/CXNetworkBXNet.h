@@ -23,6 +23,7 @@ struct CXNetwork;
 #define CX_NETWORK_CHUNK_META CX_NETWORK_FOURCC('M', 'E', 'T', 'A')
 #define CX_NETWORK_CHUNK_NODE CX_NETWORK_FOURCC('N', 'O', 'D', 'E')
 #define CX_NETWORK_CHUNK_EDGE CX_NETWORK_FOURCC('E', 'D', 'G', 'E')
+#define CX_NETWORK_CHUNK_ADJACENCY CX_NETWORK_FOURCC('A', 'D', 'J', 'C')
 #define CX_NETWORK_CHUNK_NODE_ATTR CX_NETWORK_FOURCC('N', 'A', 'T', 'T')
 #define CX_NETWORK_CHUNK_EDGE_ATTR CX_NETWORK_FOURCC('E', 'A', 'T', 'T')
 #define CX_NETWORK_CHUNK_NET_ATTR CX_NETWORK_FOURCC('G', 'A', 'T', 'T')
@@ -72,6 +73,17 @@ typedef struct {
 	uint8_t reservedTail[64];
 } CXNetworkFileFooter;
 
+/**
+ * Sets how many worker threads compress and decompress BGZF blocks in the
+ * ZXNet readers and writers. The default is 1 (no workers); 0
+ * follows `CXThreadPoolGetWorkerCount()`. The value is process-wide and is
+ * read when a file is opened. Builds compiled with `HTS_DISABLE_BGZF_THREADS`
+ * (the WebAssembly targets) always use one thread.
+ */
+CX_EXTERN void CXNetworkSetZXNetThreadCount(CXSize threadCount);
+/** Returns the configured ZXNet thread count (0 when automatic). */
+CX_EXTERN CXSize CXNetworkGetZXNetThreadCount(void);
+
 /** Writes an uncompressed binary BXNet file to disk. */
 CX_EXTERN CXBool CXNetworkWriteBXNet(struct CXNetwork *network, const char *path);
 /** Writes a BGZF-compressed ZXNet file to disk. */
@@ -107,10 +119,65 @@ CX_EXTERN CXBool CXNetworkWriteZXNetFiltered(struct CXNetwork *network,
 	size_t networkAllowCount,
 	const char **networkIgnore,
 	size_t networkIgnoreCount);
+/**
+ * Writes a BXNet file that also stores the adjacency lists in an ADJC chunk
+ * (format minor version 1). Readers adopt the stored lists after validating
+ * them instead of rebuilding the adjacency from the edge list.
+ */
+CX_EXTERN CXBool CXNetworkWriteBXNetWithAdjacency(struct CXNetwork *network, const char *path);
+/** ZXNet counterpart of `CXNetworkWriteBXNetWithAdjacency`. */
+CX_EXTERN CXBool CXNetworkWriteZXNetWithAdjacency(struct CXNetwork *network, const char *path, int compressionLevel);
 /** Reads an uncompressed BXNet file from disk. */
 CX_EXTERN struct CXNetwork* CXNetworkReadBXNet(const char *path);
+/**
+ * Reads an uncompressed BXNet file through a read-only memory mapping instead
+ * of buffered reads. Columns whose layout matches the host are copied straight
+ * out of the mapped pages, and the adjacency is built with one counting sort
+ * into the frozen layout (see `CXNetworkFreeze`). The mapping is released
+ * before returning; the result is an ordinary, independently owned network.
+ */
+CX_EXTERN struct CXNetwork* CXNetworkMapBXNet(const char *path);
 /** Reads a BGZF-compressed ZXNet file from disk. */
 CX_EXTERN struct CXNetwork* CXNetworkReadZXNet(const char *path);
+/**
+ * Reads a BXNet file but only loads the attributes accepted by the allow and
+ * ignore lists (same semantics as `CXNetworkWriteBXNetFiltered`); the values
+ * of the other attributes are skipped without being decoded. Topology is
+ * always loaded. The file checksum covers every byte and is therefore not
+ * verified by filtered reads.
+ */
+CX_EXTERN struct CXNetwork* CXNetworkReadBXNetFiltered(const char *path,
+	const char **nodeAllow,
+	size_t nodeAllowCount,
+	const char **nodeIgnore,
+	size_t nodeIgnoreCount,
+	const char **edgeAllow,
+	size_t edgeAllowCount,
+	const char **edgeIgnore,
+	size_t edgeIgnoreCount,
+	const char **networkAllow,
+	size_t networkAllowCount,
+	const char **networkIgnore,
+	size_t networkIgnoreCount);
+/**
+ * ZXNet counterpart of `CXNetworkReadBXNetFiltered`. Skipped values are passed
+ * over block by block using the BGZF block sizes, so compressed blocks that
+ * hold only unwanted values are never inflated. Filtered reads run on the
+ * calling thread regardless of `CXNetworkSetZXNetThreadCount`.
+ */
+CX_EXTERN struct CXNetwork* CXNetworkReadZXNetFiltered(const char *path,
+	const char **nodeAllow,
+	size_t nodeAllowCount,
+	const char **nodeIgnore,
+	size_t nodeIgnoreCount,
+	const char **edgeAllow,
+	size_t edgeAllowCount,
+	const char **edgeIgnore,
+	size_t edgeIgnoreCount,
+	const char **networkAllow,
+	size_t networkAllowCount,
+	const char **networkIgnore,
+	size_t networkIgnoreCount);
 
 #ifdef __cplusplus
 } // extern "C"
@@ -9,6 +9,26 @@ extern "C" {
 
 struct CXNetwork;
 
+/**
+ * Reads a node-link JSON document (`{directed, graph, nodes, links}`, with
+ * `edges` accepted for `links`).
+ *
+ * The file is scanned in place and values are written straight into network
+ * columns; no intermediate value tree is built. Attribute types are inferred
+ * like the JavaScript loader: strings, booleans, unsigned/signed 32-bit
+ * integers, doubles, numeric vectors, and string or `{label, weight}` arrays
+ * as multi-category attributes. Anything else is stored as a JSON string.
+ * Node ids are kept in the `_original_ids_` string attribute. Endpoints
+ * without a node record get one.
+ *
+ * Recoverable issues are reported via `CXNetworkSerializationLastWarningMessage()`.
+ * When the document cannot be loaded, that message holds the reason instead.
+ *
+ * @param path Path to the `.json` file on disk.
+ * @return Newly allocated network when successful, otherwise NULL.
+ */
+CX_EXTERN struct CXNetwork* CXNetworkReadNodeLinkJSON(const char *path);
+
 /**
  * Serializes a network as node-link JSON compatible with common D3/NetworkX
  * style payloads.
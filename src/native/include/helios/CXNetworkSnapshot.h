@@ -0,0 +1,101 @@
+//
+//  CXNetworkSnapshot.h
+//  Helios Network Core
+//
+//  Read-only compressed sparse row (CSR) view of the active topology, cached on
+//  the network and shared by measurements, community detection, and steppable
+//  sessions. The cache is keyed by the node/edge topology versions; edge weight
+//  columns are keyed by the source attribute and its version.
+//
+
+#ifndef CXNetwork_CXNetworkSnapshot_h
+#define CXNetwork_CXNetworkSnapshot_h
+
+#include "CXCommons.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct CXNetwork;
+struct CXAttribute;
+
+/**
+ * Edge weights aligned with a snapshot's `outNeighbors` / `inNeighbors`
+ * arrays. A column belongs to one attribute version; writing the attribute
+ * and bumping its version makes the next lookup build a fresh column while
+ * holders of the previous one keep using it until they release it.
+ */
+typedef struct CXNetworkSnapshotWeights {
+	CXSize referenceCount;
+	const struct CXAttribute *attribute; /* NULL for unit weights */
+	const uint8_t *data;
+	uint64_t version;
+	double *outWeights; /* outEdgeCount */
+	double *inWeights;  /* inEdgeCount */
+	struct CXNetworkSnapshotWeights *next;
+} CXNetworkSnapshotWeights;
+
+typedef CXNetworkSnapshotWeights* CXNetworkSnapshotWeightsRef;
+
+/**
+ * Compact CSR adjacency over the active nodes. Compact node ids follow the
+ * ascending order of the original node indices and neighbor order matches the
+ * network's neighbor containers.
+ */
+typedef struct CXNetworkSnapshot {
+	CXSize referenceCount;
+	uint64_t nodeTopologyVersion;
+	uint64_t edgeTopologyVersion;
+	CXBool directed;
+	CXSize nodeCount;
+	CXSize nodeCapacity;
+	CXIndex *compactToNode; /* nodeCount */
+	CXIndex *nodeToCompact; /* nodeCapacity, CXIndexMAX for inactive nodes */
+	CXIndex *outOffsets;    /* nodeCount + 1 */
+	CXIndex *outNeighbors;  /* outEdgeCount, compact ids */
+	CXIndex *outEdges;      /* outEdgeCount, original edge indices */
+	CXSize outEdgeCount;
+	CXIndex *inOffsets;     /* nodeCount + 1 */
+	CXIndex *inNeighbors;   /* inEdgeCount, compact ids */
+	CXIndex *inEdges;       /* inEdgeCount, original edge indices */
+	CXSize inEdgeCount;
+	CXNetworkSnapshotWeights *weights;
+} CXNetworkSnapshot;
+
+typedef CXNetworkSnapshot* CXNetworkSnapshotRef;
+
+/**
+ * Returns the CSR snapshot for the current topology, building it when the
+ * cached one is missing or stale. The caller owns one reference and must
+ * release it with `CXNetworkSnapshotRelease`. Returns NULL on allocation
+ * failure.
+ */
+CX_EXTERN CXNetworkSnapshotRef CXNetworkSnapshotAcquire(struct CXNetwork *network);
+
+/** Drops one reference; the snapshot is freed when the last holder releases it. */
+CX_EXTERN void CXNetworkSnapshotRelease(CXNetworkSnapshotRef snapshot);
+
+/**
+ * Returns the weight column of `edgeWeightAttribute` for `snapshot`, which
+ * must be the network's current snapshot. NULL/empty names yield unit weights.
+ * Returns NULL when the attribute is missing, not scalar, not numeric, or on
+ * allocation failure. Release the column with `CXNetworkSnapshotWeightsRelease`.
+ */
+CX_EXTERN CXNetworkSnapshotWeightsRef CXNetworkSnapshotAcquireWeights(
+	CXNetworkSnapshotRef snapshot,
+	struct CXNetwork *network,
+	const CXString edgeWeightAttribute
+);
+
+/** Drops one reference to a weight column. */
+CX_EXTERN void CXNetworkSnapshotWeightsRelease(CXNetworkSnapshotWeightsRef weights);
+
+/** Detaches the cached snapshot from the network (holders keep their references). */
+CX_EXTERN void CXNetworkSnapshotInvalidate(struct CXNetwork *network);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* CXNetwork_CXNetworkSnapshot_h */
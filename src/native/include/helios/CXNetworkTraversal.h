@@ -0,0 +1,161 @@
+//
+//  CXNetworkTraversal.h
+//  Helios Network Core
+//
+//  Breadth-first traversal engine over a CSR snapshot. Each level either
+//  expands the frontier list (top-down) or, once the frontier reaches a large
+//  share of the unexplored edges, lets every unvisited node look for a parent
+//  in a frontier bitmap (bottom-up). The multi-source variant advances up to
+//  64 sources through one shared traversal using one bit per source.
+//
+
+#ifndef CXNetwork_CXNetworkTraversal_h
+#define CXNetwork_CXNetworkTraversal_h
+
+#include "CXCommons.h"
+#include "CXNetworkSnapshot.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Distance reported for nodes not reached by the last traversal. */
+#define CX_TRAVERSAL_UNVISITED UINT32_MAX
+/** Maximum number of sources advanced together by `CXTraversalMultiBFSRun`. */
+#define CX_TRAVERSAL_BATCH_SIZE 64u
+
+/** Index of the lowest set bit of a non-zero word. */
+static inline CXSize CXTraversalLowestBit(uint64_t bits) {
+#if defined(__GNUC__)
+	return (CXSize)__builtin_ctzll(bits);
+#else
+	CXSize index = 0;
+	while (!(bits & 1u)) {
+		bits >>= 1;
+		index++;
+	}
+	return index;
+#endif
+}
+
+/**
+ * Adjacency lists followed by a traversal. `forward` lists are expanded from
+ * the frontier; `backward` lists hold the same edges seen from the other
+ * endpoint and are scanned by bottom-up steps.
+ */
+typedef struct CXTraversalAdjacency {
+	CXSize nodeCount;
+	CXSize listCount; /* 0, 1, or 2 */
+	const CXIndex *forwardOffsets[2];
+	const CXIndex *forwardNeighbors[2];
+	const CXIndex *backwardOffsets[2];
+	const CXIndex *backwardNeighbors[2];
+	CXSize edgeCount; /* forward entries over all lists */
+} CXTraversalAdjacency;
+
+/**
+ * Reusable single- or multi-source BFS state. Node ids are compact snapshot
+ * ids. After `CXTraversalBFSRun`:
+ *
+ * - `order[0, visitedCount)` lists the reached nodes level by level, and level
+ *   `r` spans `order[levelOffsets[r], levelOffsets[r + 1])`.
+ * - `distances[u]` is the level of `u`, or `CX_TRAVERSAL_UNVISITED`.
+ *
+ * Top-down levels keep discovery order; bottom-up levels are in ascending id
+ * order.
+ */
+typedef struct CXTraversalBFS {
+	CXNetworkSnapshotRef snapshot; /* borrowed */
+	CXTraversalAdjacency adjacency;
+	CXSize workerCount;
+	uint32_t *distances;    /* nodeCount */
+	CXIndex *order;         /* nodeCount */
+	CXSize visitedCount;
+	CXIndex *levelOffsets;  /* nodeCount + 2 */
+	CXSize levelCount;
+	uint64_t *frontierBits; /* one bit per node */
+	uint64_t *nextBits;     /* one bit per node */
+	CXSize topDownSteps;
+	CXSize bottomUpSteps;
+} CXTraversalBFS;
+
+/**
+ * Called once per node and level at which a multi-source traversal first
+ * reaches the node from some sources; bit `i` of `sourceMask` stands for
+ * `sources[i]`. Level 0 reports the sources themselves.
+ */
+typedef void (*CXTraversalVisitFunction)(void *context, CXIndex node, CXSize level, uint64_t sourceMask);
+
+/** Bit-parallel multi-source BFS state (see `CXTraversalMultiBFSRun`). */
+typedef struct CXTraversalMultiBFS {
+	CXNetworkSnapshotRef snapshot; /* borrowed */
+	CXTraversalAdjacency adjacency;
+	uint64_t *seen;      /* nodeCount */
+	uint64_t *visit;     /* nodeCount */
+	uint64_t *visitNext; /* nodeCount */
+	CXIndex *frontier;   /* nodeCount */
+	CXIndex *next;       /* nodeCount */
+	CXIndex *touched;    /* nodeCount */
+	CXSize touchedCount;
+} CXTraversalMultiBFS;
+
+/**
+ * Prepares a traversal over `snapshot` following out-edges, in-edges, or both
+ * (the flags are ignored for undirected snapshots). Bottom-up steps use up to
+ * `workerCount` pool workers; pass 1 when the caller already runs in parallel.
+ * The snapshot must outlive the traversal.
+ */
+CX_EXTERN CXBool CXTraversalBFSInit(
+	CXTraversalBFS *bfs,
+	CXNetworkSnapshotRef snapshot,
+	CXBool followOut,
+	CXBool followIn,
+	CXSize workerCount
+);
+
+/** Releases the traversal buffers. */
+CX_EXTERN void CXTraversalBFSDestroy(CXTraversalBFS *bfs);
+
+/**
+ * Runs a BFS from the compact ids in `sources` (duplicates and out-of-range
+ * ids are skipped) and stops after `maxLevel` levels. Returns the number of
+ * reached nodes, sources included.
+ */
+CX_EXTERN CXSize CXTraversalBFSRun(
+	CXTraversalBFS *bfs,
+	const CXIndex *sources,
+	CXSize sourceCount,
+	CXSize maxLevel
+);
+
+/** Prepares a multi-source traversal; flags as in `CXTraversalBFSInit`. */
+CX_EXTERN CXBool CXTraversalMultiBFSInit(
+	CXTraversalMultiBFS *bfs,
+	CXNetworkSnapshotRef snapshot,
+	CXBool followOut,
+	CXBool followIn
+);
+
+/** Releases the multi-source traversal buffers. */
+CX_EXTERN void CXTraversalMultiBFSDestroy(CXTraversalMultiBFS *bfs);
+
+/**
+ * Runs one independent BFS per entry of `sources` (at most
+ * `CX_TRAVERSAL_BATCH_SIZE`, compact ids) up to `maxLevel`, sharing the edge
+ * scans between sources whose frontiers overlap. `visit` receives every
+ * (node, level, sources) discovery. Returns CXFalse on invalid arguments.
+ */
+CX_EXTERN CXBool CXTraversalMultiBFSRun(
+	CXTraversalMultiBFS *bfs,
+	const CXIndex *sources,
+	CXSize sourceCount,
+	CXSize maxLevel,
+	CXTraversalVisitFunction visit,
+	void *context
+);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* CXNetwork_CXNetworkTraversal_h */
@@ -12,6 +12,9 @@ struct CXNetwork;
 /**
  * Reads a graph from an `.xnet` (XNET 1.0.0 or legacy) container.
  *
+ * The file is memory-mapped where available (read into memory otherwise) and
+ * parsed in place, without per-line allocations.
+ *
  * @param path Path to the XNET file on disk.
  * @return Newly allocated network when successful, otherwise NULL.
  */
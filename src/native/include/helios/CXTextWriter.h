@@ -0,0 +1,136 @@
+//
+//  CXTextWriter.h
+//  Helios Network Core
+//
+//  Buffered text emitter shared by the XNet, GML and node-link JSON exporters.
+//  Output is collected in a large private buffer and handed to the file in
+//  big blocks; integers and floating-point values are formatted without going
+//  through stdio, and strings are escaped by copying unescaped runs in bulk.
+//
+
+#ifndef CXNetwork_CXTextWriter_h
+#define CXNetwork_CXTextWriter_h
+
+#include "CXCommons.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Size of the writer's private buffer. */
+#ifndef CX_TEXT_WRITER_BUFFER_SIZE
+#define CX_TEXT_WRITER_BUFFER_SIZE (1u << 20)
+#endif
+
+/** Room needed by the `CXTextFormat*` helpers, terminator included. */
+#define CX_TEXT_NUMBER_MAX 32u
+
+typedef struct CXTextWriter {
+	FILE *file;
+	char *buffer;
+	size_t length;
+	size_t capacity;
+	CXBool failed;
+} CXTextWriter;
+
+/** Escaping rules understood by `CXTextWriterWriteEscaped`. */
+typedef enum {
+	/** `\\ \" \n \r \t`; other bytes are copied as-is. */
+	CXTextEscapeGML = 0,
+	/** JSON string rules; remaining control bytes become `\u00XX`. */
+	CXTextEscapeJSON = 1,
+	/** `\\ \" \n \r \t`; other control bytes and DEL become `\xXX`. */
+	CXTextEscapeXNet = 2
+} CXTextEscapeStyle;
+
+/**
+ * Creates (or truncates) `path` and prepares `writer` for it. Returns CXFalse
+ * with errno set when the file cannot be opened or the buffer allocated.
+ */
+CX_EXTERN CXBool CXTextWriterOpen(CXTextWriter *writer, const char *path);
+
+/**
+ * Flushes pending output and closes the file. Returns CXTrue when every byte
+ * reached the file; a writer that failed earlier reports CXFalse here.
+ */
+CX_EXTERN CXBool CXTextWriterClose(CXTextWriter *writer);
+
+/** Hands buffered output to the file. Returns CXFalse once a write failed. */
+CX_EXTERN CXBool CXTextWriterFlush(CXTextWriter *writer);
+
+/** Slow path of `CXTextWriterWrite`: flushes, then copies or writes through. */
+CX_EXTERN void CXTextWriterWriteSlow(CXTextWriter *writer, const void *data, size_t length);
+
+/**
+ * Returns room for at least `length` bytes (at most the buffer size), flushing
+ * first when needed, or NULL after a write error. Commit what was used with
+ * `writer->length += used`.
+ */
+CX_INLINE char* CXTextWriterReserve(CXTextWriter *writer, size_t length) {
+	if (writer->capacity - writer->length < length && !CXTextWriterFlush(writer)) {
+		return NULL;
+	}
+	return writer->buffer + writer->length;
+}
+
+CX_INLINE void CXTextWriterWrite(CXTextWriter *writer, const void *data, size_t length) {
+	if (writer->capacity - writer->length >= length) {
+		memcpy(writer->buffer + writer->length, data, length);
+		writer->length += length;
+		return;
+	}
+	CXTextWriterWriteSlow(writer, data, length);
+}
+
+CX_INLINE void CXTextWriterPutChar(CXTextWriter *writer, char ch) {
+	if (writer->length == writer->capacity && !CXTextWriterFlush(writer)) {
+		return;
+	}
+	writer->buffer[writer->length++] = ch;
+}
+
+CX_INLINE void CXTextWriterPuts(CXTextWriter *writer, const char *text) {
+	CXTextWriterWrite(writer, text, strlen(text));
+}
+
+/** printf-style output for headers and other rare lines. */
+CX_EXTERN void CXTextWriterPrintf(CXTextWriter *writer, const char *format, ...);
+
+CX_EXTERN void CXTextWriterWriteInt64(CXTextWriter *writer, int64_t value);
+CX_EXTERN void CXTextWriterWriteUInt64(CXTextWriter *writer, uint64_t value);
+
+/**
+ * Writes the shortest decimal that reads back (strtof) as exactly `value`,
+ * laid out like `%.9g`. Non-finite values print as `nan`, `inf` and `-inf`.
+ */
+CX_EXTERN void CXTextWriterWriteFloat(CXTextWriter *writer, float value);
+
+/**
+ * Double counterpart of `CXTextWriterWriteFloat`, laid out like `%.17g`.
+ * Values that need more than 15 significant digits are written with 17.
+ */
+CX_EXTERN void CXTextWriterWriteDouble(CXTextWriter *writer, double value);
+
+/**
+ * Writes `text` escaped with `style`, without surrounding quotes. Runs that
+ * need no escaping are copied in one piece. NULL writes nothing.
+ */
+CX_EXTERN void CXTextWriterWriteEscaped(CXTextWriter *writer, const char *text, CXTextEscapeStyle style);
+
+/**
+ * Formatting helpers behind the writer. `out` needs `CX_TEXT_NUMBER_MAX`
+ * bytes; the text is NUL-terminated and its length returned.
+ */
+CX_EXTERN size_t CXTextFormatInt64(char *out, int64_t value);
+CX_EXTERN size_t CXTextFormatUInt64(char *out, uint64_t value);
+CX_EXTERN size_t CXTextFormatFloat(char *out, float value);
+CX_EXTERN size_t CXTextFormatDouble(char *out, double value);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* CXNetwork_CXTextWriter_h */
@@ -0,0 +1,100 @@
+//
+//  CXThreadPool.h
+//  Helios Network Core
+//
+//  Portable work-stealing thread pool backing the parallel measurement and
+//  community-detection kernels. Uses pthreads on native targets and on
+//  WebAssembly builds compiled with pthread support; every other target runs
+//  the same entry points serially on the calling thread.
+//
+
+#ifndef CXNetwork_CXThreadPool_h
+#define CXNetwork_CXThreadPool_h
+
+#include "CXCommons.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if !defined(CX_THREAD_POOL_THREADED)
+#if defined(HELIOS_DISABLE_THREADS)
+#define CX_THREAD_POOL_THREADED 0
+#elif defined(__EMSCRIPTEN__)
+#if defined(__EMSCRIPTEN_PTHREADS__)
+#define CX_THREAD_POOL_THREADED 1
+#else
+#define CX_THREAD_POOL_THREADED 0
+#endif
+#elif defined(_WIN32) && !defined(__MINGW32__)
+#define CX_THREAD_POOL_THREADED 0
+#else
+#define CX_THREAD_POOL_THREADED 1
+#endif
+#endif
+
+/** Upper bound on the number of workers (including the calling thread). */
+#ifndef CX_THREAD_POOL_MAX_WORKERS
+#define CX_THREAD_POOL_MAX_WORKERS 64u
+#endif
+
+/**
+ * Callback invoked for every claimed block of a parallel loop.
+ *
+ * - `[start, end)` is always aligned to the requested grain size, so
+ *   `start / grainSize` identifies the block and can index per-block partial
+ *   results for deterministic reductions.
+ * - `workerIndex` is in `[0, workerCount)` and is stable for the duration of
+ *   the callback; use it to select per-worker scratch buffers.
+ */
+typedef void (*CXParallelRangeFunction)(void *context, CXIndex start, CXIndex end, CXSize workerIndex);
+
+/**
+ * Sets the number of workers used by parallel kernels, including the calling
+ * thread. Passing 0 restores the automatic default (the `HELIOS_NUM_THREADS`
+ * environment variable when set, the hardware concurrency otherwise).
+ * Values are clamped to `CX_THREAD_POOL_MAX_WORKERS`.
+ */
+CX_EXTERN void CXThreadPoolSetWorkerCount(CXSize workerCount);
+
+/** Returns the effective worker count (always 1 on builds without threads). */
+CX_EXTERN CXSize CXThreadPoolGetWorkerCount(void);
+
+/** Returns the number of logical processors reported by the platform. */
+CX_EXTERN CXSize CXThreadPoolHardwareConcurrency(void);
+
+/**
+ * Joins and releases every pool thread. The pool is recreated lazily by the
+ * next parallel loop, so this is only needed for orderly process teardown.
+ */
+CX_EXTERN void CXThreadPoolShutdown(void);
+
+/**
+ * Returns how many workers a loop over `taskCount` independent tasks should
+ * use: min(taskCount, CXThreadPoolGetWorkerCount()), or 0 when there is no
+ * work. Callers size their per-worker buffers with this value.
+ */
+CX_EXTERN CXSize CXParallelWorkerCount(CXSize taskCount);
+
+/**
+ * Runs `function` over `[0, count)` split into blocks of `grainSize`
+ * indices, using at most `workerCount` workers. Blocks are initially
+ * distributed in contiguous runs per worker; idle workers steal remaining
+ * blocks from the others. Returns once every block has been processed.
+ *
+ * Calls made from inside a pool worker, or while another loop occupies the
+ * pool, execute serially on the calling thread with `workerIndex` 0.
+ */
+CX_EXTERN void CXParallelForRange(
+	CXSize count,
+	CXSize grainSize,
+	CXSize workerCount,
+	CXParallelRangeFunction function,
+	void *context
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CXNetwork_CXThreadPool_h */
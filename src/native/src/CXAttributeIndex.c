@@ -0,0 +1,441 @@
+//
+//  CXAttributeIndex.c
+//  Helios Network Core
+//
+
+#include "CXNetwork.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CX_INDEX_RADIX_BITS 8u
+#define CX_INDEX_RADIX_BUCKETS (1u << CX_INDEX_RADIX_BITS)
+#define CX_INDEX_RADIX_PASSES (64u / CX_INDEX_RADIX_BITS)
+
+static CXBool CXAttributeIndexIsNumericType(CXAttributeType type) {
+	switch (type) {
+		case CXBooleanAttributeType:
+		case CXFloatAttributeType:
+		case CXDoubleAttributeType:
+		case CXIntegerAttributeType:
+		case CXUnsignedIntegerAttributeType:
+		case CXBigIntegerAttributeType:
+		case CXUnsignedBigIntegerAttributeType:
+			return CXTrue;
+		default:
+			return CXFalse;
+	}
+}
+
+static CXBool CXAttributeIndexSupports(const CXAttribute *attribute) {
+	if (!attribute) {
+		return CXFalse;
+	}
+	if (attribute->type == CXDataAttributeMultiCategoryType) {
+		return attribute->multiCategory != NULL;
+	}
+	if (attribute->dimension != 1) {
+		return CXFalse;
+	}
+	return attribute->type == CXDataAttributeCategoryType || CXAttributeIndexIsNumericType(attribute->type);
+}
+
+static double CXAttributeIndexValueAt(const CXAttribute *attribute, CXIndex row) {
+	const uint8_t *base = attribute->data + (size_t)row * attribute->stride;
+	switch (attribute->type) {
+		case CXBooleanAttributeType: return *(const uint8_t *)base ? 1.0 : 0.0;
+		case CXFloatAttributeType: return (double)*(const float *)base;
+		case CXDoubleAttributeType: return *(const double *)base;
+		case CXIntegerAttributeType: return (double)*(const int32_t *)base;
+		case CXUnsignedIntegerAttributeType: return (double)*(const uint32_t *)base;
+		case CXBigIntegerAttributeType: return (double)*(const int64_t *)base;
+		case CXUnsignedBigIntegerAttributeType: return (double)*(const uint64_t *)base;
+		default: return NAN;
+	}
+}
+
+/* Maps doubles to unsigned keys with the same order, so the sort can be a
+ * stable radix sort and equal values keep ascending row order. */
+static inline uint64_t CXAttributeIndexKeyFromDouble(double value) {
+	uint64_t bits = 0;
+	memcpy(&bits, &value, sizeof(bits));
+	return (bits & ((uint64_t)1 << 63)) ? ~bits : (bits | ((uint64_t)1 << 63));
+}
+
+static inline double CXAttributeIndexDoubleFromKey(uint64_t key) {
+	uint64_t bits = (key & ((uint64_t)1 << 63)) ? (key & ~((uint64_t)1 << 63)) : ~key;
+	double value = 0.0;
+	memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+static void CXAttributeIndexClear(CXAttributeIndexRef index) {
+	free(index->rows);
+	free(index->values);
+	free(index->offsets);
+	index->rows = NULL;
+	index->values = NULL;
+	index->offsets = NULL;
+	index->entryCount = 0;
+	index->firstId = 0;
+	index->idCount = 0;
+	index->built = CXFalse;
+}
+
+static CXBool CXAttributeIndexBuildSorted(CXAttributeIndexRef index, const CXAttribute *attribute, const CXBool *active, CXSize rowCount) {
+	CXSize count = 0;
+	for (CXIndex row = 0; row < rowCount; row++) {
+		if (active[row] && !isnan(CXAttributeIndexValueAt(attribute, row))) {
+			count++;
+		}
+	}
+	CXSize allocation = CXMAX(count, (CXSize)1);
+	uint64_t *keys = malloc(sizeof(uint64_t) * allocation);
+	uint64_t *keysTemp = malloc(sizeof(uint64_t) * allocation);
+	CXIndex *rows = malloc(sizeof(CXIndex) * allocation);
+	CXIndex *rowsTemp = malloc(sizeof(CXIndex) * allocation);
+	double *values = malloc(sizeof(double) * allocation);
+	CXSize *histogram = calloc(CX_INDEX_RADIX_PASSES * CX_INDEX_RADIX_BUCKETS, sizeof(CXSize));
+	if (!keys || !keysTemp || !rows || !rowsTemp || !values || !histogram) {
+		free(keys);
+		free(keysTemp);
+		free(rows);
+		free(rowsTemp);
+		free(values);
+		free(histogram);
+		return CXFalse;
+	}
+	CXSize position = 0;
+	for (CXIndex row = 0; row < rowCount; row++) {
+		if (!active[row]) {
+			continue;
+		}
+		double value = CXAttributeIndexValueAt(attribute, row);
+		if (isnan(value)) {
+			continue;
+		}
+		if (value == 0.0) {
+			value = 0.0; /* -0.0 sorts with +0.0 */
+		}
+		uint64_t key = CXAttributeIndexKeyFromDouble(value);
+		keys[position] = key;
+		rows[position] = row;
+		position++;
+		for (CXSize pass = 0; pass < CX_INDEX_RADIX_PASSES; pass++) {
+			histogram[pass * CX_INDEX_RADIX_BUCKETS + ((key >> (pass * CX_INDEX_RADIX_BITS)) & (CX_INDEX_RADIX_BUCKETS - 1u))]++;
+		}
+	}
+	for (CXSize pass = 0; pass < CX_INDEX_RADIX_PASSES; pass++) {
+		CXSize *buckets = histogram + pass * CX_INDEX_RADIX_BUCKETS;
+		CXSize shift = pass * CX_INDEX_RADIX_BITS;
+		/* Digits shared by every key do not reorder anything. */
+		if (count == 0 || buckets[(keys[0] >> shift) & (CX_INDEX_RADIX_BUCKETS - 1u)] == count) {
+			continue;
+		}
+		CXSize sum = 0;
+		for (CXSize bucket = 0; bucket < CX_INDEX_RADIX_BUCKETS; bucket++) {
+			CXSize bucketCount = buckets[bucket];
+			buckets[bucket] = sum;
+			sum += bucketCount;
+		}
+		for (CXSize i = 0; i < count; i++) {
+			CXSize target = buckets[(keys[i] >> shift) & (CX_INDEX_RADIX_BUCKETS - 1u)]++;
+			keysTemp[target] = keys[i];
+			rowsTemp[target] = rows[i];
+		}
+		uint64_t *swapKeys = keys;
+		keys = keysTemp;
+		keysTemp = swapKeys;
+		CXIndex *swapRows = rows;
+		rows = rowsTemp;
+		rowsTemp = swapRows;
+	}
+	for (CXSize i = 0; i < count; i++) {
+		values[i] = CXAttributeIndexDoubleFromKey(keys[i]);
+	}
+	free(keys);
+	free(keysTemp);
+	free(rowsTemp);
+	free(histogram);
+	index->kind = CXAttributeIndexKindSorted;
+	index->rows = rows;
+	index->values = values;
+	index->entryCount = count;
+	return CXTrue;
+}
+
+/* Where the category ids of a row come from: the multi-category CSR buffers,
+ * or the single id stored in a categorical column. */
+typedef struct {
+	const CXAttribute *attribute;
+	const uint32_t *offsets;
+	const uint32_t *ids;
+} CXAttributeIndexIdSource;
+
+static CXSize CXAttributeIndexRowIds(const CXAttributeIndexIdSource *source, CXIndex row, const uint32_t **outIds, int32_t *scratch) {
+	if (source->ids) {
+		*outIds = source->ids + source->offsets[row];
+		return source->offsets[row + 1] - source->offsets[row];
+	}
+	memcpy(scratch, source->attribute->data + (size_t)row * source->attribute->stride, sizeof(int32_t));
+	*outIds = (const uint32_t *)scratch;
+	return 1;
+}
+
+/* Counting sort of (id, row) pairs. Rows are visited in ascending order, so
+ * every posting list comes out ascending. */
+static CXBool CXAttributeIndexBuildPostings(CXAttributeIndexRef index, const CXAttribute *attribute, const CXBool *active, CXSize rowCount) {
+	CXAttributeIndexIdSource source = { attribute, NULL, NULL };
+	CXBool isMulti = attribute->type == CXDataAttributeMultiCategoryType;
+	if (isMulti) {
+		source.offsets = attribute->multiCategory->offsets;
+		source.ids = attribute->multiCategory->ids;
+		if (!source.offsets) {
+			rowCount = 0;
+		}
+	}
+	/* Categorical ids are signed (-1 marks a missing label); multi-category
+	 * ids are unsigned. */
+	int64_t minId = INT64_MAX;
+	int64_t maxId = INT64_MIN;
+	int32_t scratch = 0;
+	for (CXIndex row = 0; row < rowCount; row++) {
+		if (!active[row]) {
+			continue;
+		}
+		const uint32_t *ids = NULL;
+		CXSize idCount = CXAttributeIndexRowIds(&source, row, &ids, &scratch);
+		for (CXSize i = 0; i < idCount; i++) {
+			int64_t id = isMulti ? (int64_t)ids[i] : (int64_t)(int32_t)ids[i];
+			minId = id < minId ? id : minId;
+			maxId = id > maxId ? id : maxId;
+		}
+	}
+	CXSize idRange = minId <= maxId ? (CXSize)(maxId - minId) + 1u : 0u;
+	CXIndex *offsets = calloc(idRange + 1u, sizeof(CXIndex));
+	CXIndex *lastRow = malloc(sizeof(CXIndex) * CXMAX(idRange, (CXSize)1));
+	if (!offsets || !lastRow) {
+		free(offsets);
+		free(lastRow);
+		return CXFalse;
+	}
+	/* Two passes over the rows: count, then place. `lastRow` drops repeated
+	 * ids inside one multi-category row. */
+	for (int placing = 0; placing < 2; placing++) {
+		for (CXSize k = 0; k < idRange; k++) {
+			lastRow[k] = CXIndexMAX;
+		}
+		CXIndex *rows = placing ? index->rows : NULL;
+		for (CXIndex row = 0; row < rowCount; row++) {
+			if (!active[row]) {
+				continue;
+			}
+			const uint32_t *ids = NULL;
+			CXSize idCount = CXAttributeIndexRowIds(&source, row, &ids, &scratch);
+			for (CXSize i = 0; i < idCount; i++) {
+				int64_t id = isMulti ? (int64_t)ids[i] : (int64_t)(int32_t)ids[i];
+				CXSize slot = (CXSize)(id - minId);
+				if (lastRow[slot] == row) {
+					continue;
+				}
+				lastRow[slot] = row;
+				if (placing) {
+					rows[offsets[slot]++] = row;
+				} else {
+					offsets[slot + 1]++;
+				}
+			}
+		}
+		if (!placing) {
+			for (CXSize k = 0; k < idRange; k++) {
+				offsets[k + 1] += offsets[k];
+			}
+			index->rows = malloc(sizeof(CXIndex) * CXMAX(offsets[idRange], (CXSize)1));
+			if (!index->rows) {
+				free(offsets);
+				free(lastRow);
+				return CXFalse;
+			}
+		}
+	}
+	/* Placing advanced every start to the next list's start; shift back. */
+	for (CXSize k = idRange; k > 0; k--) {
+		offsets[k] = offsets[k - 1];
+	}
+	offsets[0] = 0;
+	free(lastRow);
+	index->kind = CXAttributeIndexKindPostings;
+	index->offsets = offsets;
+	index->entryCount = offsets[idRange];
+	index->firstId = idRange > 0 ? minId : 0;
+	index->idCount = idRange;
+	return CXTrue;
+}
+
+CXAttributeIndexRef CXAttributeIndexCreate(CXAttributeScope scope) {
+	if (scope != CXAttributeScopeNode && scope != CXAttributeScopeEdge) {
+		return NULL;
+	}
+	CXAttributeIndexRef index = calloc(1, sizeof(CXAttributeIndex));
+	if (!index) {
+		return NULL;
+	}
+	index->scope = scope;
+	return index;
+}
+
+void CXAttributeIndexDestroy(CXAttributeIndexRef index) {
+	if (!index) {
+		return;
+	}
+	CXAttributeIndexClear(index);
+	free(index);
+}
+
+CXAttributeIndexRef CXAttributeIndexAcquire(CXNetworkRef network, CXAttributeRef attribute) {
+	if (!network || !attribute || !attribute->index) {
+		return NULL;
+	}
+	CXAttributeIndexRef index = attribute->index;
+	CXBool isNode = index->scope == CXAttributeScopeNode;
+	uint64_t topologyVersion = isNode ? network->nodeTopologyVersion : network->edgeTopologyVersion;
+	if (index->built &&
+		index->attributeType == attribute->type &&
+		index->attributeVersion == attribute->version &&
+		index->topologyVersion == topologyVersion &&
+		index->rowCapacity == attribute->capacity) {
+		return index;
+	}
+	CXAttributeIndexClear(index);
+	if (!CXAttributeIndexSupports(attribute)) {
+		return NULL;
+	}
+	const CXBool *active = isNode ? network->nodeActive : network->edgeActive;
+	CXSize rowCount = CXMIN(attribute->capacity, isNode ? network->nodeCapacity : network->edgeCapacity);
+	if (attribute->type != CXDataAttributeMultiCategoryType && !attribute->data) {
+		rowCount = 0;
+	}
+	CXBool ok = attribute->type == CXDataAttributeCategoryType || attribute->type == CXDataAttributeMultiCategoryType
+		? CXAttributeIndexBuildPostings(index, attribute, active, rowCount)
+		: CXAttributeIndexBuildSorted(index, attribute, active, rowCount);
+	if (!ok) {
+		CXAttributeIndexClear(index);
+		return NULL;
+	}
+	index->built = CXTrue;
+	index->attributeType = attribute->type;
+	index->attributeVersion = attribute->version;
+	index->topologyVersion = topologyVersion;
+	index->rowCapacity = attribute->capacity;
+	return index;
+}
+
+static CXAttributeRef CXAttributeIndexLookup(CXNetworkRef network, CXAttributeScope scope, const CXString name) {
+	if (!network || !name) {
+		return NULL;
+	}
+	if (scope == CXAttributeScopeNode) {
+		return CXNetworkGetNodeAttribute(network, name);
+	}
+	if (scope == CXAttributeScopeEdge) {
+		return CXNetworkGetEdgeAttribute(network, name);
+	}
+	return NULL;
+}
+
+CXBool CXNetworkCreateAttributeIndex(CXNetworkRef network, CXAttributeScope scope, const CXString name) {
+	CXAttributeRef attribute = CXAttributeIndexLookup(network, scope, name);
+	if (!attribute || !CXAttributeIndexSupports(attribute)) {
+		return CXFalse;
+	}
+	if (attribute->index) {
+		return CXTrue;
+	}
+	attribute->index = CXAttributeIndexCreate(scope);
+	if (!attribute->index) {
+		return CXFalse;
+	}
+	if (!CXAttributeIndexAcquire(network, attribute)) {
+		CXAttributeIndexDestroy(attribute->index);
+		attribute->index = NULL;
+		return CXFalse;
+	}
+	return CXTrue;
+}
+
+CXBool CXNetworkDropAttributeIndex(CXNetworkRef network, CXAttributeScope scope, const CXString name) {
+	CXAttributeRef attribute = CXAttributeIndexLookup(network, scope, name);
+	if (!attribute || !attribute->index) {
+		return CXFalse;
+	}
+	CXAttributeIndexDestroy(attribute->index);
+	attribute->index = NULL;
+	return CXTrue;
+}
+
+CXBool CXNetworkHasAttributeIndex(CXNetworkRef network, CXAttributeScope scope, const CXString name) {
+	CXAttributeRef attribute = CXAttributeIndexLookup(network, scope, name);
+	return attribute && attribute->index ? CXTrue : CXFalse;
+}
+
+/* First position whose value is >= target (or > target when `strict`). */
+static CXSize CXAttributeIndexBound(const double *values, CXSize count, double target, CXBool strict) {
+	CXSize low = 0;
+	CXSize high = count;
+	while (low < high) {
+		CXSize middle = low + (high - low) / 2u;
+		CXBool before = strict ? values[middle] <= target : values[middle] < target;
+		if (before) {
+			low = middle + 1u;
+		} else {
+			high = middle;
+		}
+	}
+	return low;
+}
+
+void CXAttributeIndexRange(CXAttributeIndexRef index, CXAttributeIndexCompare op, double target, CXSize *outStart, CXSize *outEnd) {
+	*outStart = 0;
+	*outEnd = 0;
+	if (!index || index->kind != CXAttributeIndexKindSorted || isnan(target)) {
+		return;
+	}
+	CXSize count = index->entryCount;
+	switch (op) {
+		case CXAttributeIndexCompareEq:
+			*outStart = CXAttributeIndexBound(index->values, count, target, CXFalse);
+			*outEnd = CXAttributeIndexBound(index->values, count, target, CXTrue);
+			break;
+		case CXAttributeIndexCompareLt:
+			*outEnd = CXAttributeIndexBound(index->values, count, target, CXFalse);
+			break;
+		case CXAttributeIndexCompareLte:
+			*outEnd = CXAttributeIndexBound(index->values, count, target, CXTrue);
+			break;
+		case CXAttributeIndexCompareGt:
+			*outStart = CXAttributeIndexBound(index->values, count, target, CXTrue);
+			*outEnd = count;
+			break;
+		case CXAttributeIndexCompareGte:
+			*outStart = CXAttributeIndexBound(index->values, count, target, CXFalse);
+			*outEnd = count;
+			break;
+		default:
+			break;
+	}
+}
+
+void CXAttributeIndexPostings(CXAttributeIndexRef index, int64_t id, CXSize *outStart, CXSize *outEnd) {
+	*outStart = 0;
+	*outEnd = 0;
+	if (!index || index->kind != CXAttributeIndexKindPostings || id < index->firstId) {
+		return;
+	}
+	CXSize slot = (CXSize)(id - index->firstId);
+	if (slot >= index->idCount) {
+		return;
+	}
+	*outStart = index->offsets[slot];
+	*outEnd = index->offsets[slot + 1];
+}
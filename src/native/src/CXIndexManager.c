@@ -89,6 +89,19 @@ CXIndex CXIndexManagerGetIndex(CXIndexManagerRef manager) {
 	return CXIndexMAX;
 }
 
+/** Issues a block of fresh indices starting at `nextIndex`. */
+CXIndex CXIndexManagerTakeRange(CXIndexManagerRef manager, CXSize count) {
+	if (!manager) {
+		return CXIndexMAX;
+	}
+	CXSize first = (CXSize)manager->nextIndex;
+	if (count > manager->maxCapacity || first > manager->maxCapacity - count) {
+		return CXIndexMAX;
+	}
+	manager->nextIndex = (CXIndex)(first + count);
+	return (CXIndex)first;
+}
+
 /** Adjusts the manager to reflect a new maximum index capacity. */
 CXBool CXResizeIndexManager(CXIndexManagerRef manager, CXSize newMaxCapacity) {
 	if (!manager) {
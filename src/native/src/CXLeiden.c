@@ -1,5 +1,15 @@
 #include "CXNetwork.h"
 
+/* Parallel mode: nodes per pool block, and the bounds of the batches whose
+ * moves are decided against one frozen community state. The batch size only
+ * depends on the node count, which keeps results independent of the worker
+ * count. */
+#define CX_LEIDEN_PARALLEL_GRAIN 64
+#define CX_LEIDEN_PARALLEL_MIN_BATCH 512
+#define CX_LEIDEN_PARALLEL_MAX_BATCH 32768
+/* Decision value asking to move a node into an empty community. */
+#define CX_LEIDEN_NEW_COMMUNITY UINT32_MAX
+
 typedef struct {
 	uint32_t state;
 } CXLeidenRng;
@@ -36,106 +46,16 @@ static void CXLeidenShuffle(CXLeidenRng *rng, CXIndex *values, CXSize count) {
 	}
 }
 
-typedef double (*CXLeidenEdgeWeightReader)(const void *base, CXSize stride, CXIndex edge);
-
-static double CXLeidenWeightConstantOne(const void *base, CXSize stride, CXIndex edge) {
-	(void)base;
-	(void)stride;
-	(void)edge;
-	return 1.0;
-}
-
-static double CXLeidenWeightFloat(const void *base, CXSize stride, CXIndex edge) {
-	const uint8_t *ptr = (const uint8_t *)base + (size_t)edge * stride;
-	float value = 0.0f;
-	memcpy(&value, ptr, sizeof(float));
-	return (double)value;
-}
-
-static double CXLeidenWeightDouble(const void *base, CXSize stride, CXIndex edge) {
-	const uint8_t *ptr = (const uint8_t *)base + (size_t)edge * stride;
-	double value = 0.0;
-	memcpy(&value, ptr, sizeof(double));
-	return value;
-}
-
-static double CXLeidenWeightI32(const void *base, CXSize stride, CXIndex edge) {
-	const uint8_t *ptr = (const uint8_t *)base + (size_t)edge * stride;
-	int32_t value = 0;
-	memcpy(&value, ptr, sizeof(int32_t));
-	return (double)value;
-}
-
-static double CXLeidenWeightU32(const void *base, CXSize stride, CXIndex edge) {
-	const uint8_t *ptr = (const uint8_t *)base + (size_t)edge * stride;
-	uint32_t value = 0;
-	memcpy(&value, ptr, sizeof(uint32_t));
-	return (double)value;
-}
-
-static double CXLeidenWeightI64(const void *base, CXSize stride, CXIndex edge) {
-	const uint8_t *ptr = (const uint8_t *)base + (size_t)edge * stride;
-	int64_t value = 0;
-	memcpy(&value, ptr, sizeof(int64_t));
-	return (double)value;
-}
-
-static double CXLeidenWeightU64(const void *base, CXSize stride, CXIndex edge) {
-	const uint8_t *ptr = (const uint8_t *)base + (size_t)edge * stride;
-	uint64_t value = 0;
-	memcpy(&value, ptr, sizeof(uint64_t));
-	return (double)value;
-}
-
-typedef struct {
-	const void *base;
-	CXSize stride;
-	CXLeidenEdgeWeightReader read;
-} CXLeidenEdgeWeights;
-
-static CXBool CXLeidenResolveEdgeWeights(CXNetworkRef network, const CXString name, CXLeidenEdgeWeights *outWeights) {
-	if (!outWeights) {
-		return CXFalse;
-	}
-	outWeights->base = NULL;
-	outWeights->stride = 0;
-	outWeights->read = CXLeidenWeightConstantOne;
-
-	if (!network || !name || !name[0]) {
-		return CXTrue;
-	}
-
-	CXAttributeRef attribute = CXNetworkGetEdgeAttribute(network, name);
-	if (!attribute || !attribute->data || attribute->dimension != 1) {
-		return CXFalse;
-	}
-
-	outWeights->base = attribute->data;
-	outWeights->stride = attribute->stride;
-
-	switch (attribute->type) {
-		case CXFloatAttributeType:
-			outWeights->read = CXLeidenWeightFloat;
-			return CXTrue;
-		case CXDoubleAttributeType:
-			outWeights->read = CXLeidenWeightDouble;
-			return CXTrue;
-		case CXIntegerAttributeType:
-			outWeights->read = CXLeidenWeightI32;
-			return CXTrue;
-		case CXUnsignedIntegerAttributeType:
-		case CXDataAttributeCategoryType:
-			outWeights->read = CXLeidenWeightU32;
-			return CXTrue;
-		case CXBigIntegerAttributeType:
-			outWeights->read = CXLeidenWeightI64;
-			return CXTrue;
-		case CXUnsignedBigIntegerAttributeType:
-			outWeights->read = CXLeidenWeightU64;
-			return CXTrue;
-		default:
-			return CXFalse;
-	}
+/* Counter-based draw for the parallel kernels: the value depends only on the
+ * stream salt, the node, and the draw number, never on the worker. */
+static double CXLeidenHashUnit(uint64_t salt, uint64_t node, uint64_t draw) {
+	uint64_t x = salt ^ (node * 0x9E3779B97F4A7C15ull) ^ (draw * 0xD1B54A32D192ED03ull);
+	x ^= x >> 30;
+	x *= 0xBF58476D1CE4E5B9ull;
+	x ^= x >> 27;
+	x *= 0x94D049BB133111EBull;
+	x ^= x >> 31;
+	return (double)(x >> 11) * (1.0 / 9007199254740992.0);
 }
 
 typedef struct {
@@ -153,18 +73,21 @@ typedef struct {
 	double *selfWeight;   /* nodeCount */
 	double totalOutWeight;
 	CXBool isDirected;
+	CXBool borrowsAdjacency; /* offsets/neighbors/weights belong to a network snapshot */
 } CXLeidenGraph;
 
 static void CXLeidenGraphDestroy(CXLeidenGraph *graph) {
 	if (!graph) {
 		return;
 	}
-	free(graph->outOffsets);
-	free(graph->outNeighbors);
-	free(graph->outWeights);
-	free(graph->inOffsets);
-	free(graph->inNeighbors);
-	free(graph->inWeights);
+	if (!graph->borrowsAdjacency) {
+		free(graph->outOffsets);
+		free(graph->outNeighbors);
+		free(graph->outWeights);
+		free(graph->inOffsets);
+		free(graph->inNeighbors);
+		free(graph->inWeights);
+	}
 	free(graph->outDegree);
 	free(graph->inDegree);
 	free(graph->selfWeight);
@@ -196,145 +119,81 @@ static CXLeidenGraph* CXLeidenGraphCreate(CXSize nodeCount, CXBool directed) {
 	return graph;
 }
 
-static CXLeidenGraph* CXLeidenGraphFromNetwork(
-	CXNetworkRef network,
-	const CXLeidenEdgeWeights *weights,
-	CXIndex **outCompactToNode,
-	CXIndex **outNodeToCompact
-) {
-	if (!network || !weights) {
-		return NULL;
-	}
-
-	CXSize activeCount = 0;
-	for (CXIndex i = 0; i < network->nodeCapacity; i++) {
-		if (network->nodeActive[i]) {
-			activeCount++;
-		}
-	}
-
-	CXIndex *compactToNode = NULL;
-	CXIndex *nodeToCompact = NULL;
-	if (activeCount > 0) {
-		compactToNode = malloc(sizeof(CXIndex) * activeCount);
-		nodeToCompact = malloc(sizeof(CXIndex) * network->nodeCapacity);
-		if (!compactToNode || !nodeToCompact) {
-			free(compactToNode);
-			free(nodeToCompact);
-			return NULL;
-		}
-		for (CXIndex i = 0; i < network->nodeCapacity; i++) {
-			nodeToCompact[i] = CXIndexMAX;
+static void CXLeidenGraphDegreeRange(void *context, CXIndex start, CXIndex end, CXSize workerIndex) {
+	(void)workerIndex;
+	CXLeidenGraph *graph = (CXLeidenGraph *)context;
+	for (CXIndex u = start; u < end; u++) {
+		double outDegree = 0.0;
+		double selfWeight = 0.0;
+		for (CXIndex idx = graph->outOffsets[u]; idx < graph->outOffsets[u + 1]; idx++) {
+			double w = graph->outWeights[idx];
+			outDegree += w;
+			if (graph->outNeighbors[idx] == u) {
+				selfWeight += w;
+			}
 		}
-		CXIndex cursor = 0;
-		for (CXIndex i = 0; i < network->nodeCapacity; i++) {
-			if (!network->nodeActive[i]) {
-				continue;
+		graph->outDegree[u] = outDegree;
+		graph->selfWeight[u] = selfWeight;
+		if (graph->isDirected) {
+			double inDegree = 0.0;
+			for (CXIndex idx = graph->inOffsets[u]; idx < graph->inOffsets[u + 1]; idx++) {
+				inDegree += graph->inWeights[idx];
 			}
-			nodeToCompact[i] = cursor;
-			compactToNode[cursor] = i;
-			cursor++;
+			graph->inDegree[u] = inDegree;
 		}
 	}
+}
 
-	CXLeidenGraph *graph = CXLeidenGraphCreate(activeCount, network->isDirected);
-	if (!graph) {
-		free(compactToNode);
-		free(nodeToCompact);
+/* Wraps the network's CSR snapshot as the level-0 graph. Adjacency arrays are
+ * borrowed; only the degree and self-loop totals are computed here, spread
+ * over `workerCount` workers. */
+static CXLeidenGraph* CXLeidenGraphFromSnapshot(
+	CXNetworkSnapshotRef snapshot,
+	CXNetworkSnapshotWeightsRef weights,
+	CXSize workerCount
+) {
+	if (!snapshot || !weights) {
 		return NULL;
 	}
 
-	CXSize outEdgeCount = 0;
-	CXSize inEdgeCount = 0;
-	for (CXSize u = 0; u < activeCount; u++) {
-		CXIndex node = compactToNode[u];
-		outEdgeCount += CXNeighborContainerCount(&network->nodes[node].outNeighbors);
-		if (network->isDirected) {
-			inEdgeCount += CXNeighborContainerCount(&network->nodes[node].inNeighbors);
-		}
+	CXSize n = snapshot->nodeCount;
+	CXLeidenGraph *graph = calloc(1, sizeof(CXLeidenGraph));
+	if (!graph) {
+		return NULL;
 	}
-	graph->outEdgeCount = outEdgeCount;
-	graph->inEdgeCount = network->isDirected ? inEdgeCount : 0;
-	graph->outNeighbors = outEdgeCount ? malloc(sizeof(CXIndex) * outEdgeCount) : NULL;
-	graph->outWeights = outEdgeCount ? malloc(sizeof(double) * outEdgeCount) : NULL;
-	if ((outEdgeCount && (!graph->outNeighbors || !graph->outWeights))) {
+	graph->nodeCount = n;
+	graph->isDirected = snapshot->directed;
+	graph->borrowsAdjacency = CXTrue;
+	graph->outOffsets = snapshot->outOffsets;
+	graph->outNeighbors = snapshot->outNeighbors;
+	graph->outWeights = weights->outWeights;
+	graph->outEdgeCount = snapshot->outEdgeCount;
+	graph->outDegree = calloc(CXMAX(n, (CXSize)1), sizeof(double));
+	graph->selfWeight = calloc(CXMAX(n, (CXSize)1), sizeof(double));
+	if (!graph->outDegree || !graph->selfWeight) {
 		CXLeidenGraphDestroy(graph);
-		free(compactToNode);
-		free(nodeToCompact);
 		return NULL;
 	}
-	if (network->isDirected) {
-		graph->inNeighbors = inEdgeCount ? malloc(sizeof(CXIndex) * inEdgeCount) : NULL;
-		graph->inWeights = inEdgeCount ? malloc(sizeof(double) * inEdgeCount) : NULL;
-		if ((inEdgeCount && (!graph->inNeighbors || !graph->inWeights))) {
+	if (graph->isDirected) {
+		graph->inOffsets = snapshot->inOffsets;
+		graph->inNeighbors = snapshot->inNeighbors;
+		graph->inWeights = weights->inWeights;
+		graph->inEdgeCount = snapshot->inEdgeCount;
+		graph->inDegree = calloc(CXMAX(n, (CXSize)1), sizeof(double));
+		if (!graph->inDegree) {
 			CXLeidenGraphDestroy(graph);
-			free(compactToNode);
-			free(nodeToCompact);
 			return NULL;
 		}
 	}
 
-	CXIndex outCursor = 0;
-	for (CXSize u = 0; u < activeCount; u++) {
-		CXIndex node = compactToNode[u];
-		graph->outOffsets[u] = outCursor;
-		CXNeighborIterator iterator;
-		CXNeighborIteratorInit(&iterator, &network->nodes[node].outNeighbors);
-		while (CXNeighborIteratorNext(&iterator)) {
-			CXIndex neighNode = iterator.node;
-			CXIndex neighEdge = iterator.edge;
-			CXIndex v = nodeToCompact[neighNode];
-			if (v == CXIndexMAX) {
-				continue;
-			}
-			double w = weights->read(weights->base, weights->stride, neighEdge);
-			graph->outNeighbors[outCursor] = v;
-			graph->outWeights[outCursor] = w;
-			graph->outDegree[u] += w;
-			if (v == u) {
-				graph->selfWeight[u] += w;
-			}
-			outCursor++;
-		}
-		graph->totalOutWeight += graph->outDegree[u];
-	}
-	graph->outOffsets[activeCount] = outCursor;
-	graph->outEdgeCount = outCursor;
-
-	if (network->isDirected) {
-		CXIndex inCursor = 0;
-		for (CXSize u = 0; u < activeCount; u++) {
-			CXIndex node = compactToNode[u];
-			graph->inOffsets[u] = inCursor;
-			CXNeighborIterator iterator;
-			CXNeighborIteratorInit(&iterator, &network->nodes[node].inNeighbors);
-			while (CXNeighborIteratorNext(&iterator)) {
-				CXIndex neighNode = iterator.node;
-				CXIndex neighEdge = iterator.edge;
-				CXIndex v = nodeToCompact[neighNode];
-				if (v == CXIndexMAX) {
-					continue;
-				}
-				double w = weights->read(weights->base, weights->stride, neighEdge);
-				graph->inNeighbors[inCursor] = v;
-				graph->inWeights[inCursor] = w;
-				graph->inDegree[u] += w;
-				inCursor++;
-			}
-		}
-		graph->inOffsets[activeCount] = inCursor;
-		graph->inEdgeCount = inCursor;
-	}
-
-	if (outCompactToNode) {
-		*outCompactToNode = compactToNode;
+	CXSize workers = CXMIN(workerCount, (n + CX_LEIDEN_PARALLEL_GRAIN - 1) / CX_LEIDEN_PARALLEL_GRAIN);
+	if (workers > 1) {
+		CXParallelForRange(n, CX_LEIDEN_PARALLEL_GRAIN, workers, CXLeidenGraphDegreeRange, graph);
 	} else {
-		free(compactToNode);
+		CXLeidenGraphDegreeRange(graph, 0, n, 0);
 	}
-	if (outNodeToCompact) {
-		*outNodeToCompact = nodeToCompact;
-	} else {
-		free(nodeToCompact);
+	for (CXSize u = 0; u < n; u++) {
+		graph->totalOutWeight += graph->outDegree[u];
 	}
 	return graph;
 }
@@ -881,6 +740,276 @@ static CXSize CXLeidenMergeSingletons(
 	return moved;
 }
 
+/* One (community, weight) link of an aggregated row. */
+typedef struct {
+	uint32_t neighbor;
+	double weight;
+} CXLeidenRowEntry;
+
+/* Per-worker open-addressing map from community id to accumulated link
+ * weights. `used` lists occupied slots in insertion order, so scans follow
+ * the adjacency order and stay deterministic. */
+typedef struct {
+	CXSize capacity;    /* power of two, 0 before the first reserve */
+	uint32_t *keys;     /* capacity, UINT32_MAX when free */
+	double *outWeights; /* capacity */
+	double *inWeights;  /* capacity */
+	CXSize *used;       /* capacity */
+	CXSize usedCount;
+	CXLeidenRowEntry *row; /* aggregation row buffer */
+	CXSize rowCapacity;
+	CXBool failed;
+} CXLeidenScratch;
+
+typedef struct {
+	CXLeidenScratch *scratch; /* workerCount */
+	CXSize workerCount;
+} CXLeidenParallel;
+
+static void CXLeidenScratchDestroy(CXLeidenScratch *scratch) {
+	if (!scratch) {
+		return;
+	}
+	free(scratch->keys);
+	free(scratch->outWeights);
+	free(scratch->inWeights);
+	free(scratch->used);
+	free(scratch->row);
+	memset(scratch, 0, sizeof(*scratch));
+}
+
+static void CXLeidenScratchClear(CXLeidenScratch *scratch) {
+	for (CXSize i = 0; i < scratch->usedCount; i++) {
+		scratch->keys[scratch->used[i]] = UINT32_MAX;
+	}
+	scratch->usedCount = 0;
+}
+
+/* Makes room for `count` distinct keys; must be called on a cleared map. */
+static CXBool CXLeidenScratchReserve(CXLeidenScratch *scratch, CXSize count) {
+	CXSize capacity = 16;
+	while (capacity < count * 2) {
+		capacity <<= 1;
+	}
+	if (capacity <= scratch->capacity) {
+		return CXTrue;
+	}
+	free(scratch->keys);
+	free(scratch->outWeights);
+	free(scratch->inWeights);
+	free(scratch->used);
+	scratch->keys = malloc(sizeof(uint32_t) * capacity);
+	scratch->outWeights = malloc(sizeof(double) * capacity);
+	scratch->inWeights = malloc(sizeof(double) * capacity);
+	scratch->used = malloc(sizeof(CXSize) * capacity);
+	if (!scratch->keys || !scratch->outWeights || !scratch->inWeights || !scratch->used) {
+		free(scratch->keys);
+		free(scratch->outWeights);
+		free(scratch->inWeights);
+		free(scratch->used);
+		scratch->keys = NULL;
+		scratch->outWeights = NULL;
+		scratch->inWeights = NULL;
+		scratch->used = NULL;
+		scratch->capacity = 0;
+		scratch->failed = CXTrue;
+		return CXFalse;
+	}
+	for (CXSize i = 0; i < capacity; i++) {
+		scratch->keys[i] = UINT32_MAX;
+	}
+	scratch->capacity = capacity;
+	scratch->usedCount = 0;
+	return CXTrue;
+}
+
+static CXSize CXLeidenScratchSlot(const CXLeidenScratch *scratch, uint32_t key) {
+	const CXSize mask = scratch->capacity - 1;
+	CXSize slot = (CXSize)(((uint64_t)key * 11400714819323198485ull) >> 32) & mask;
+	while (scratch->keys[slot] != UINT32_MAX && scratch->keys[slot] != key) {
+		slot = (slot + 1) & mask;
+	}
+	return slot;
+}
+
+static void CXLeidenScratchAdd(CXLeidenScratch *scratch, uint32_t key, double outWeight, double inWeight) {
+	CXSize slot = CXLeidenScratchSlot(scratch, key);
+	if (scratch->keys[slot] == UINT32_MAX) {
+		scratch->keys[slot] = key;
+		scratch->outWeights[slot] = outWeight;
+		scratch->inWeights[slot] = inWeight;
+		scratch->used[scratch->usedCount++] = slot;
+		return;
+	}
+	scratch->outWeights[slot] += outWeight;
+	scratch->inWeights[slot] += inWeight;
+}
+
+static CXSize CXLeidenParallelBatchSize(CXSize nodeCount) {
+	CXSize batch = nodeCount / 128;
+	return CXMIN(CXMAX(batch, (CXSize)CX_LEIDEN_PARALLEL_MIN_BATCH), (CXSize)CX_LEIDEN_PARALLEL_MAX_BATCH);
+}
+
+static CXBool CXLeidenParallelHasFailed(const CXLeidenParallel *parallel) {
+	for (CXSize w = 0; w < parallel->workerCount; w++) {
+		if (parallel->scratch[w].failed) {
+			return CXTrue;
+		}
+	}
+	return CXFalse;
+}
+
+/* Read-only view shared by the workers deciding one batch of moves. */
+typedef struct {
+	const CXLeidenGraph *graph;
+	const uint32_t *community;
+	const uint32_t *restriction;
+	const double *totOut;
+	const double *totIn;
+	const uint32_t *sizes;
+	const CXIndex *batch;
+	uint32_t *decision;     /* one entry per batch position */
+	CXLeidenScratch *scratch;
+	double resolution;
+	double invTotal;
+	uint64_t salt;
+	CXBool mergeSingletons; /* refinement: only singletons join other communities */
+} CXLeidenDecideContext;
+
+static CXBool CXLeidenPreferGain(double gain, double bestGain, uint64_t salt, CXSize node, CXSize *draw) {
+	if (gain > bestGain + 1e-12) {
+		return CXTrue;
+	}
+	return fabs(gain - bestGain) <= 1e-12 && CXLeidenHashUnit(salt, node, (*draw)++) < 0.5;
+}
+
+/* Same gains as the sequential kernels, evaluated against the frozen state.
+ * Returns the node's current community when it should stay, or
+ * CX_LEIDEN_NEW_COMMUNITY to isolate it. A singleton only moves into another
+ * singleton with a lower label, so two singletons never swap places. */
+static uint32_t CXLeidenDecideNode(const CXLeidenDecideContext *ctx, CXSize u, CXLeidenScratch *scratch) {
+	const CXLeidenGraph *graph = ctx->graph;
+	const uint32_t current = ctx->community[u];
+	if (ctx->mergeSingletons && ctx->sizes[current] != 1) {
+		return current;
+	}
+	CXSize degreeCount = graph->outOffsets[u + 1] - graph->outOffsets[u];
+	if (graph->isDirected) {
+		degreeCount += graph->inOffsets[u + 1] - graph->inOffsets[u];
+	}
+	if (degreeCount == 0) {
+		return current;
+	}
+	CXLeidenScratchClear(scratch);
+	if (!CXLeidenScratchReserve(scratch, degreeCount)) {
+		return current;
+	}
+
+	const uint32_t restrictLabel = ctx->restriction ? ctx->restriction[u] : UINT32_MAX;
+	for (CXIndex idx = graph->outOffsets[u]; idx < graph->outOffsets[u + 1]; idx++) {
+		CXIndex v = graph->outNeighbors[idx];
+		if (ctx->restriction && ctx->restriction[v] != restrictLabel) {
+			continue;
+		}
+		uint32_t c = ctx->community[v];
+		if (ctx->mergeSingletons && c == current) {
+			continue;
+		}
+		CXLeidenScratchAdd(scratch, c, graph->outWeights[idx], 0.0);
+	}
+	if (graph->isDirected) {
+		for (CXIndex idx = graph->inOffsets[u]; idx < graph->inOffsets[u + 1]; idx++) {
+			CXIndex v = graph->inNeighbors[idx];
+			if (ctx->restriction && ctx->restriction[v] != restrictLabel) {
+				continue;
+			}
+			uint32_t c = ctx->community[v];
+			if (ctx->mergeSingletons && c == current) {
+				continue;
+			}
+			CXLeidenScratchAdd(scratch, c, 0.0, graph->inWeights[idx]);
+		}
+	}
+
+	const double degOut = graph->outDegree[u];
+	const double degIn = graph->isDirected ? graph->inDegree[u] : 0.0;
+	const double selfWeight = graph->selfWeight[u];
+	const CXBool currentAlone = ctx->sizes[current] == 1;
+	uint32_t bestCommunity = current;
+	double bestGain = 0.0;
+	CXSize draw = 0;
+
+	if (!ctx->mergeSingletons) {
+		const double remainingOut = ctx->totOut[current] - degOut;
+		const double remainingIn = graph->isDirected ? ctx->totIn[current] - degIn : 0.0;
+		CXSize slot = CXLeidenScratchSlot(scratch, current);
+		double currentOutW = 0.0;
+		double currentInW = 0.0;
+		if (scratch->keys[slot] == current) {
+			currentOutW = scratch->outWeights[slot];
+			currentInW = scratch->inWeights[slot];
+		}
+		if (graph->isDirected) {
+			bestGain = (currentOutW + currentInW) - ctx->resolution * ((degOut * remainingIn + degIn * remainingOut) * ctx->invTotal);
+		} else {
+			bestGain = currentOutW - ctx->resolution * (degOut * remainingOut * ctx->invTotal);
+		}
+		if (!currentAlone) {
+			double emptyGain = graph->isDirected ? 2.0 * selfWeight : selfWeight;
+			if (CXLeidenPreferGain(emptyGain, bestGain, ctx->salt, u, &draw)) {
+				bestGain = emptyGain;
+				bestCommunity = CX_LEIDEN_NEW_COMMUNITY;
+			}
+		}
+	}
+
+	for (CXSize i = 0; i < scratch->usedCount; i++) {
+		CXSize slot = scratch->used[i];
+		uint32_t c = scratch->keys[slot];
+		if (c == current) {
+			continue;
+		}
+		if (!ctx->mergeSingletons && currentAlone && ctx->sizes[c] == 1 && c > current) {
+			continue;
+		}
+		double gain = 0.0;
+		if (graph->isDirected) {
+			double wOut = scratch->outWeights[slot] + selfWeight;
+			double wIn = scratch->inWeights[slot] + selfWeight;
+			gain = (wOut + wIn) - ctx->resolution * ((degOut * ctx->totIn[c] + degIn * ctx->totOut[c]) * ctx->invTotal);
+		} else {
+			double w = scratch->outWeights[slot] + selfWeight;
+			gain = w - ctx->resolution * (degOut * ctx->totOut[c] * ctx->invTotal);
+		}
+		if (CXLeidenPreferGain(gain, bestGain, ctx->salt, u, &draw)) {
+			bestGain = gain;
+			bestCommunity = c;
+		}
+	}
+	return bestCommunity;
+}
+
+static void CXLeidenDecideRange(void *context, CXIndex start, CXIndex end, CXSize workerIndex) {
+	const CXLeidenDecideContext *ctx = (const CXLeidenDecideContext *)context;
+	CXLeidenScratch *scratch = &ctx->scratch[workerIndex];
+	for (CXIndex i = start; i < end; i++) {
+		ctx->decision[i] = CXLeidenDecideNode(ctx, (CXSize)ctx->batch[i], scratch);
+	}
+}
+
+/* Fills `ctx->decision[0, count)` in parallel. Returns CXFalse when a worker
+ * could not grow its scratch map. */
+static CXBool CXLeidenDecideBatch(CXLeidenDecideContext *ctx, const CXLeidenParallel *parallel, CXSize count) {
+	ctx->scratch = parallel->scratch;
+	CXSize workers = CXMIN(parallel->workerCount, (count + CX_LEIDEN_PARALLEL_GRAIN - 1) / CX_LEIDEN_PARALLEL_GRAIN);
+	if (workers > 1) {
+		CXParallelForRange(count, CX_LEIDEN_PARALLEL_GRAIN, workers, CXLeidenDecideRange, ctx);
+	} else {
+		CXLeidenDecideRange(ctx, 0, count, 0);
+	}
+	return !CXLeidenParallelHasFailed(parallel);
+}
+
 typedef struct {
 	const CXLeidenGraph *graph;
 	uint32_t *community;
@@ -913,6 +1042,15 @@ typedef struct {
 	double *candOutW;
 	double *candInW;
 	CXSize candidateCap;
+
+	/* Parallel mode: queue entries are popped in batches whose moves are
+	 * decided together and then applied in queue order. */
+	const CXLeidenParallel *parallel; /* NULL for the sequential step */
+	CXIndex *batch;                   /* batchSize */
+	uint32_t *decision;               /* batchSize */
+	CXSize batchSize;
+	uint64_t salt;
+	CXBool failed;
 } CXLeidenMoveState;
 
 static CXSize CXLeidenGraphMaxCandidateCount(const CXLeidenGraph *graph) {
@@ -956,6 +1094,8 @@ static void CXLeidenMoveStateDestroy(CXLeidenMoveState *state) {
 	free(state->candidate);
 	free(state->candOutW);
 	free(state->candInW);
+	free(state->batch);
+	free(state->decision);
 	CXLeidenMoveStateClear(state);
 }
 
@@ -966,7 +1106,8 @@ static CXBool CXLeidenMoveStateInit(
 	const uint32_t *restriction,
 	double resolution,
 	CXLeidenRng *rng,
-	CXSize maxPasses
+	CXSize maxPasses,
+	const CXLeidenParallel *parallel
 ) {
 	if (!state || !graph || !community || !rng || maxPasses == 0) {
 		return CXFalse;
@@ -980,25 +1121,36 @@ static CXBool CXLeidenMoveStateInit(
 	state->maxPasses = maxPasses;
 	state->active = CXTrue;
 	state->epoch = 1;
+	state->parallel = parallel;
 
 	const CXSize n = graph->nodeCount;
 	state->order = malloc(sizeof(CXIndex) * n);
 	state->stable = calloc(n, sizeof(uint8_t));
 	state->inQueue = calloc(n, sizeof(uint8_t));
-	state->stamp = malloc(sizeof(uint32_t) * n);
-	state->position = malloc(sizeof(uint32_t) * n);
+	if (parallel) {
+		state->batchSize = CXLeidenParallelBatchSize(n);
+		state->batch = malloc(sizeof(CXIndex) * state->batchSize);
+		state->decision = malloc(sizeof(uint32_t) * state->batchSize);
+	} else {
+		state->stamp = malloc(sizeof(uint32_t) * n);
+		state->position = malloc(sizeof(uint32_t) * n);
+	}
 	state->totOut = malloc(sizeof(double) * n);
 	state->totIn = graph->isDirected ? malloc(sizeof(double) * n) : NULL;
 	state->sizes = malloc(sizeof(uint32_t) * n);
 	state->empty = malloc(sizeof(uint32_t) * n);
-	if (!state->order || !state->stable || !state->inQueue || !state->stamp || !state->position || !state->totOut || (graph->isDirected && !state->totIn) || !state->sizes || !state->empty) {
+	if (!state->order || !state->stable || !state->inQueue || (parallel ? (!state->batch || !state->decision) : (!state->stamp || !state->position)) || !state->totOut || (graph->isDirected && !state->totIn) || !state->sizes || !state->empty) {
 		return CXFalse;
 	}
 	for (CXSize i = 0; i < n; i++) {
 		state->order[i] = (CXIndex)i;
 		state->inQueue[i] = 1;
-		state->stamp[i] = 0;
-		state->position[i] = 0;
+	}
+	if (!parallel) {
+		for (CXSize i = 0; i < n; i++) {
+			state->stamp[i] = 0;
+			state->position[i] = 0;
+		}
 	}
 	if (!CXLeidenInitCommunityTotals(graph, community, state->totOut, state->totIn, state->sizes)) {
 		return CXFalse;
@@ -1009,6 +1161,13 @@ static CXBool CXLeidenMoveStateInit(
 			state->empty[state->emptyCount++] = (uint32_t)i;
 		}
 	}
+	if (parallel) {
+		state->salt = ((uint64_t)CXLeidenRngNext(rng) << 32) | (uint64_t)CXLeidenRngNext(rng);
+		CXLeidenShuffle(rng, state->order, n);
+		state->queueHead = 0;
+		state->queueCount = n;
+		return CXTrue;
+	}
 	state->candidateCap = CXLeidenGraphMaxCandidateCount(graph);
 	if (state->candidateCap > 0) {
 		state->candidate = malloc(sizeof(uint32_t) * state->candidateCap);
@@ -1024,10 +1183,133 @@ static CXBool CXLeidenMoveStateInit(
 	return CXTrue;
 }
 
+/* Applies one decided batch in queue order, re-queueing the neighbors of
+ * moved nodes exactly like the sequential step. A move is dropped when an
+ * earlier move of the batch emptied its target or already isolated the node. */
+static void CXLeidenMoveStateApplyBatch(CXLeidenMoveState *state, CXSize count) {
+	const CXLeidenGraph *graph = state->graph;
+	const CXSize n = graph->nodeCount;
+	for (CXSize i = 0; i < count; i++) {
+		CXSize u = (CXSize)state->batch[i];
+		const uint32_t current = state->community[u];
+		uint32_t target = state->decision[i];
+		state->stable[u] = 1;
+		if (target == current) {
+			continue;
+		}
+		if (target == CX_LEIDEN_NEW_COMMUNITY) {
+			if (state->sizes[current] <= 1 || state->emptyCount == 0) {
+				continue;
+			}
+			target = state->empty[--state->emptyCount];
+		} else if (state->sizes[target] == 0) {
+			continue;
+		}
+
+		const double degOut = graph->outDegree[u];
+		state->totOut[current] -= degOut;
+		state->totOut[target] += degOut;
+		if (graph->isDirected) {
+			const double degIn = graph->inDegree[u];
+			state->totIn[current] -= degIn;
+			state->totIn[target] += degIn;
+		}
+		state->sizes[current] -= 1;
+		state->sizes[target] += 1;
+		state->community[u] = target;
+		if (state->sizes[current] == 0) {
+			state->empty[state->emptyCount++] = current;
+		}
+		state->movedInPass += 1;
+		state->movedTotal += 1;
+
+		const uint32_t restrictLabel = state->restriction ? state->restriction[u] : UINT32_MAX;
+		for (int list = 0; list < (graph->isDirected ? 2 : 1); list++) {
+			const CXIndex *offsets = list == 0 ? graph->outOffsets : graph->inOffsets;
+			const CXIndex *neighbors = list == 0 ? graph->outNeighbors : graph->inNeighbors;
+			for (CXIndex idx = offsets[u]; idx < offsets[u + 1]; idx++) {
+				CXSize v = (CXSize)neighbors[idx];
+				if (state->restriction && state->restriction[v] != restrictLabel) {
+					continue;
+				}
+				if (state->stable[v] && state->community[v] != target && !state->inQueue[v] && state->queueCount < n) {
+					CXSize tail = (state->queueHead + state->queueCount) % n;
+					state->order[tail] = (CXIndex)v;
+					state->queueCount += 1;
+					state->inQueue[v] = 1;
+					state->stable[v] = 0;
+				}
+			}
+		}
+	}
+}
+
+/* Parallel counterpart of the sequential step: pops up to `batchSize` nodes
+ * from the queue, decides their moves together, then applies them in order. */
+static CXBool CXLeidenMoveStateStepParallel(CXLeidenMoveState *state, CXSize budget) {
+	const CXLeidenGraph *graph = state->graph;
+	const CXSize n = graph->nodeCount;
+	if (n == 0 || graph->totalOutWeight <= 0.0) {
+		state->active = CXFalse;
+		return CXTrue;
+	}
+	if (budget == 0) {
+		budget = 1;
+	}
+
+	CXLeidenDecideContext ctx = {
+		.graph = graph,
+		.community = state->community,
+		.restriction = state->restriction,
+		.totOut = state->totOut,
+		.totIn = state->totIn,
+		.sizes = state->sizes,
+		.batch = state->batch,
+		.decision = state->decision,
+		.resolution = state->resolution,
+		.invTotal = 1.0 / graph->totalOutWeight,
+	};
+	CXSize steps = 0;
+	while (steps < budget && state->queueCount > 0 && state->pass < state->maxPasses) {
+		const CXSize count = CXMIN(state->batchSize, state->queueCount);
+		for (CXSize i = 0; i < count; i++) {
+			CXIndex u = state->order[state->queueHead];
+			state->batch[i] = u;
+			state->inQueue[u] = 0;
+			state->queueHead = (state->queueHead + 1) % n;
+		}
+		state->queueCount -= count;
+		ctx.salt = state->salt ^ ((uint64_t)(state->pass * n + state->orderPos) * 0x2545F4914F6CDD1Dull);
+		if (!CXLeidenDecideBatch(&ctx, state->parallel, count)) {
+			state->failed = CXTrue;
+			state->active = CXFalse;
+			return CXTrue;
+		}
+		CXLeidenMoveStateApplyBatch(state, count);
+		steps += count;
+		state->orderPos += count;
+
+		if (state->orderPos >= n) {
+			state->pass += 1;
+			state->orderPos = 0;
+			state->movedInPass = 0;
+		}
+	}
+
+	if (state->queueCount == 0 || state->pass >= state->maxPasses) {
+		state->active = CXFalse;
+		return CXTrue;
+	}
+	return CXFalse;
+}
+
 static CXBool CXLeidenMoveStateStep(CXLeidenMoveState *state, CXSize budget) {
 	if (!state || !state->active || !state->graph || !state->community || !state->rng) {
 		return CXTrue;
 	}
+	if (state->parallel) {
+		return CXLeidenMoveStateStepParallel(state, budget);
+	}
 	const CXLeidenGraph *graph = state->graph;
 	const CXSize n = graph->nodeCount;
 	if (n == 0 || graph->totalOutWeight <= 0.0) {
@@ -1410,6 +1692,288 @@ static CXLeidenGraph* CXLeidenGraphAggregate(const CXLeidenGraph *graph, const u
 	return agg;
 }
 
+/* Parallel counterpart of CXLeidenMergeSingletons: batches of the shuffled
+ * order are decided against frozen totals and merged in order, skipping nodes
+ * that stopped being singletons and targets that emptied in the meantime. */
+static CXBool CXLeidenMergeSingletonsParallel(
+	const CXLeidenGraph *graph,
+	uint32_t *community,
+	const uint32_t *restriction,
+	double resolution,
+	CXLeidenRng *rng,
+	const CXLeidenParallel *parallel
+) {
+	if (!graph || !community || !rng || !parallel) {
+		return CXFalse;
+	}
+	const CXSize n = graph->nodeCount;
+	if (n == 0 || graph->totalOutWeight <= 0.0) {
+		return CXTrue;
+	}
+
+	const CXSize batchSize = CXLeidenParallelBatchSize(n);
+	CXIndex *order = malloc(sizeof(CXIndex) * n);
+	double *totOut = malloc(sizeof(double) * n);
+	double *totIn = graph->isDirected ? malloc(sizeof(double) * n) : NULL;
+	uint32_t *sizes = malloc(sizeof(uint32_t) * n);
+	uint32_t *decision = malloc(sizeof(uint32_t) * batchSize);
+	CXBool ok = order && totOut && (!graph->isDirected || totIn) && sizes && decision;
+	if (ok) {
+		ok = CXLeidenInitCommunityTotals(graph, community, totOut, totIn, sizes);
+	}
+
+	if (ok) {
+		for (CXSize i = 0; i < n; i++) {
+			order[i] = (CXIndex)i;
+		}
+		CXLeidenShuffle(rng, order, n);
+		CXLeidenDecideContext ctx = {
+			.graph = graph,
+			.community = community,
+			.restriction = restriction,
+			.totOut = totOut,
+			.totIn = totIn,
+			.sizes = sizes,
+			.decision = decision,
+			.resolution = resolution,
+			.invTotal = 1.0 / graph->totalOutWeight,
+			.salt = ((uint64_t)CXLeidenRngNext(rng) << 32) | (uint64_t)CXLeidenRngNext(rng),
+			.mergeSingletons = CXTrue,
+		};
+		for (CXSize start = 0; ok && start < n; start += batchSize) {
+			const CXSize count = CXMIN(batchSize, n - start);
+			ctx.batch = order + start;
+			if (!CXLeidenDecideBatch(&ctx, parallel, count)) {
+				ok = CXFalse;
+				break;
+			}
+			for (CXSize i = 0; i < count; i++) {
+				CXSize u = (CXSize)order[start + i];
+				const uint32_t current = community[u];
+				const uint32_t target = decision[i];
+				if (target == current || sizes[current] != 1 || sizes[target] == 0) {
+					continue;
+				}
+				community[u] = target;
+				totOut[target] += graph->outDegree[u];
+				totOut[current] = 0.0;
+				if (graph->isDirected) {
+					totIn[target] += graph->inDegree[u];
+					totIn[current] = 0.0;
+				}
+				sizes[target] += 1;
+				sizes[current] = 0;
+			}
+		}
+	}
+
+	free(order);
+	free(totOut);
+	free(totIn);
+	free(sizes);
+	free(decision);
+	return ok;
+}
+
+typedef struct {
+	const CXLeidenGraph *graph;
+	const uint32_t *community;
+	uint32_t communityCount;
+	const CXIndex *memberOffsets; /* communityCount + 1 */
+	const CXIndex *members;       /* nodeCount, grouped by community */
+	CXLeidenScratch *scratch;
+	CXIndex *rowCounts;           /* first pass: distinct neighbor communities */
+	CXLeidenGraph *aggregate;     /* second pass: rows to fill */
+} CXLeidenAggregateContext;
+
+/* Sums the out-links of community `c` per neighbor community into `scratch`. */
+static CXBool CXLeidenAggregateGatherRow(const CXLeidenAggregateContext *ctx, CXSize c, CXLeidenScratch *scratch) {
+	const CXLeidenGraph *graph = ctx->graph;
+	CXSize linkCount = 0;
+	for (CXIndex m = ctx->memberOffsets[c]; m < ctx->memberOffsets[c + 1]; m++) {
+		CXIndex u = ctx->members[m];
+		linkCount += graph->outOffsets[u + 1] - graph->outOffsets[u];
+	}
+	CXLeidenScratchClear(scratch);
+	if (!CXLeidenScratchReserve(scratch, CXMIN(linkCount, (CXSize)ctx->communityCount))) {
+		return CXFalse;
+	}
+	for (CXIndex m = ctx->memberOffsets[c]; m < ctx->memberOffsets[c + 1]; m++) {
+		CXIndex u = ctx->members[m];
+		for (CXIndex idx = graph->outOffsets[u]; idx < graph->outOffsets[u + 1]; idx++) {
+			CXLeidenScratchAdd(scratch, ctx->community[graph->outNeighbors[idx]], graph->outWeights[idx], 0.0);
+		}
+	}
+	return CXTrue;
+}
+
+static void CXLeidenAggregateCountRange(void *context, CXIndex start, CXIndex end, CXSize workerIndex) {
+	const CXLeidenAggregateContext *ctx = (const CXLeidenAggregateContext *)context;
+	CXLeidenScratch *scratch = &ctx->scratch[workerIndex];
+	for (CXIndex c = start; c < end; c++) {
+		ctx->rowCounts[c] = CXLeidenAggregateGatherRow(ctx, c, scratch) ? scratch->usedCount : 0;
+	}
+}
+
+static int CXLeidenRowEntryCompare(const void *a, const void *b) {
+	uint32_t left = ((const CXLeidenRowEntry *)a)->neighbor;
+	uint32_t right = ((const CXLeidenRowEntry *)b)->neighbor;
+	return (left > right) - (left < right);
+}
+
+static void CXLeidenAggregateFillRange(void *context, CXIndex start, CXIndex end, CXSize workerIndex) {
+	const CXLeidenAggregateContext *ctx = (const CXLeidenAggregateContext *)context;
+	CXLeidenScratch *scratch = &ctx->scratch[workerIndex];
+	CXLeidenGraph *agg = ctx->aggregate;
+	for (CXIndex c = start; c < end; c++) {
+		if (!CXLeidenAggregateGatherRow(ctx, c, scratch)) {
+			return;
+		}
+		const CXSize count = scratch->usedCount;
+		if (count > scratch->rowCapacity) {
+			CXLeidenRowEntry *row = realloc(scratch->row, sizeof(CXLeidenRowEntry) * count);
+			if (!row) {
+				scratch->failed = CXTrue;
+				return;
+			}
+			scratch->row = row;
+			scratch->rowCapacity = count;
+		}
+		for (CXSize i = 0; i < count; i++) {
+			CXSize slot = scratch->used[i];
+			scratch->row[i].neighbor = scratch->keys[slot];
+			scratch->row[i].weight = scratch->outWeights[slot];
+		}
+		qsort(scratch->row, count, sizeof(CXLeidenRowEntry), CXLeidenRowEntryCompare);
+		CXIndex base = agg->outOffsets[c];
+		double degree = 0.0;
+		for (CXSize i = 0; i < count; i++) {
+			agg->outNeighbors[base + i] = scratch->row[i].neighbor;
+			agg->outWeights[base + i] = scratch->row[i].weight;
+			degree += scratch->row[i].weight;
+			if (scratch->row[i].neighbor == c) {
+				agg->selfWeight[c] += scratch->row[i].weight;
+			}
+		}
+		agg->outDegree[c] = degree;
+	}
+}
+
+/* Parallel counterpart of CXLeidenGraphAggregate. Every community row is
+ * gathered by one worker, sorted by neighbor id, and written at an offset
+ * fixed by a first counting pass, so the result does not depend on the
+ * worker count. Directed in-lists are the transpose of the out-rows. */
+static CXLeidenGraph* CXLeidenGraphAggregateParallel(
+	const CXLeidenGraph *graph,
+	const uint32_t *community,
+	uint32_t communityCount,
+	const CXLeidenParallel *parallel
+) {
+	if (!graph || !community || communityCount == 0 || !parallel) {
+		return NULL;
+	}
+	const CXSize n = graph->nodeCount;
+	CXIndex *memberOffsets = calloc((CXSize)communityCount + 1, sizeof(CXIndex));
+	CXIndex *members = malloc(sizeof(CXIndex) * CXMAX(n, (CXSize)1));
+	CXIndex *rowCounts = malloc(sizeof(CXIndex) * communityCount);
+	CXLeidenGraph *agg = CXLeidenGraphCreate(communityCount, graph->isDirected);
+	if (!memberOffsets || !members || !rowCounts || !agg) {
+		free(memberOffsets);
+		free(members);
+		free(rowCounts);
+		CXLeidenGraphDestroy(agg);
+		return NULL;
+	}
+
+	for (CXSize u = 0; u < n; u++) {
+		memberOffsets[community[u] + 1] += 1;
+	}
+	for (uint32_t c = 0; c < communityCount; c++) {
+		memberOffsets[c + 1] += memberOffsets[c];
+	}
+	memset(rowCounts, 0, sizeof(CXIndex) * communityCount);
+	for (CXSize u = 0; u < n; u++) {
+		uint32_t c = community[u];
+		members[memberOffsets[c] + rowCounts[c]++] = (CXIndex)u;
+	}
+
+	CXLeidenAggregateContext ctx = {
+		.graph = graph,
+		.community = community,
+		.communityCount = communityCount,
+		.memberOffsets = memberOffsets,
+		.members = members,
+		.scratch = parallel->scratch,
+		.rowCounts = rowCounts,
+		.aggregate = agg,
+	};
+	const CXSize workers = CXMIN(parallel->workerCount, ((CXSize)communityCount + CX_LEIDEN_PARALLEL_GRAIN - 1) / CX_LEIDEN_PARALLEL_GRAIN);
+	if (workers > 1) {
+		CXParallelForRange(communityCount, CX_LEIDEN_PARALLEL_GRAIN, workers, CXLeidenAggregateCountRange, &ctx);
+	} else {
+		CXLeidenAggregateCountRange(&ctx, 0, communityCount, 0);
+	}
+	CXBool ok = !CXLeidenParallelHasFailed(parallel);
+
+	CXSize pairCount = 0;
+	if (ok) {
+		agg->outOffsets[0] = 0;
+		for (uint32_t c = 0; c < communityCount; c++) {
+			pairCount += rowCounts[c];
+			agg->outOffsets[c + 1] = (CXIndex)pairCount;
+		}
+		agg->outEdgeCount = pairCount;
+		agg->outNeighbors = malloc(sizeof(CXIndex) * CXMAX(pairCount, (CXSize)1));
+		agg->outWeights = malloc(sizeof(double) * CXMAX(pairCount, (CXSize)1));
+		ok = agg->outNeighbors && agg->outWeights;
+	}
+	if (ok) {
+		if (workers > 1) {
+			CXParallelForRange(communityCount, CX_LEIDEN_PARALLEL_GRAIN, workers, CXLeidenAggregateFillRange, &ctx);
+		} else {
+			CXLeidenAggregateFillRange(&ctx, 0, communityCount, 0);
+		}
+		ok = !CXLeidenParallelHasFailed(parallel);
+	}
+	if (ok && graph->isDirected) {
+		agg->inEdgeCount = pairCount;
+		agg->inNeighbors = malloc(sizeof(CXIndex) * CXMAX(pairCount, (CXSize)1));
+		agg->inWeights = malloc(sizeof(double) * CXMAX(pairCount, (CXSize)1));
+		ok = agg->inNeighbors && agg->inWeights;
+		if (ok) {
+			for (CXSize i = 0; i < pairCount; i++) {
+				agg->inOffsets[agg->outNeighbors[i] + 1] += 1;
+			}
+			for (uint32_t c = 0; c < communityCount; c++) {
+				agg->inOffsets[c + 1] += agg->inOffsets[c];
+			}
+			memset(rowCounts, 0, sizeof(CXIndex) * communityCount);
+			for (uint32_t cu = 0; cu < communityCount; cu++) {
+				for (CXIndex idx = agg->outOffsets[cu]; idx < agg->outOffsets[cu + 1]; idx++) {
+					CXIndex cv = agg->outNeighbors[idx];
+					CXIndex inPos = agg->inOffsets[cv] + rowCounts[cv]++;
+					agg->inNeighbors[inPos] = cu;
+					agg->inWeights[inPos] = agg->outWeights[idx];
+					agg->inDegree[cv] += agg->outWeights[idx];
+				}
+			}
+		}
+	}
+
+	free(memberOffsets);
+	free(members);
+	free(rowCounts);
+	if (!ok) {
+		CXLeidenGraphDestroy(agg);
+		return NULL;
+	}
+	agg->totalOutWeight = 0.0;
+	for (uint32_t c = 0; c < communityCount; c++) {
+		agg->totalOutWeight += agg->outDegree[c];
+	}
+	return agg;
+}
+
 static double CXLeidenModularity(const CXLeidenGraph *graph, const uint32_t *community, uint32_t communityCount, double resolution) {
 	if (!graph || !community || communityCount == 0 || graph->totalOutWeight <= 0.0) {
 		return 0.0;
@@ -1461,7 +2025,8 @@ static double CXLeidenModularity(const CXLeidenGraph *graph, const uint32_t *com
 
 struct CXLeidenSession {
 	CXNetworkRef network;
-	CXLeidenEdgeWeights weights;
+	CXNetworkSnapshotRef snapshot;
+	CXNetworkSnapshotWeightsRef weights;
 	double resolution;
 	CXSize maxLevels;
 	CXSize maxPasses;
@@ -1471,7 +2036,7 @@ struct CXLeidenSession {
 
 	CXLeidenGraph *baseGraph;
 	CXLeidenGraph *graph;
-	CXIndex *compactToNode;
+	const CXIndex *compactToNode; /* borrowed from snapshot */
 	uint32_t *origToNode;
 	CXSize originalCount;
 
@@ -1485,8 +2050,13 @@ struct CXLeidenSession {
 	CXSize aggregateInitialCount;
 
 	CXLeidenMoveState moveState;
+	CXLeidenParallel parallel; /* scratch is NULL unless running in parallel mode */
 };
 
+static const CXLeidenParallel* CXLeidenSessionParallel(const CXLeidenSession *session) {
+	return session->parallel.scratch ? &session->parallel : NULL;
+}
+
 static void CXLeidenSessionReleaseLevelState(CXLeidenSession *session) {
 	if (!session) {
 		return;
@@ -1517,7 +2087,8 @@ CXLeidenSessionRef CXLeidenSessionCreate(
 	double resolution,
 	uint32_t seed,
 	CXSize maxLevels,
-	CXSize maxPasses
+	CXSize maxPasses,
+	CXMeasurementExecutionMode executionMode
 ) {
 	if (!network || resolution <= 0.0 || maxLevels == 0 || maxPasses == 0) {
 		return NULL;
@@ -1536,18 +2107,36 @@ CXLeidenSessionRef CXLeidenSessionCreate(
 	CXLeidenRngSeed(&session->rng, seed);
 	CXLeidenMoveStateClear(&session->moveState);
 
-	if (!CXLeidenResolveEdgeWeights(network, edgeWeightAttribute, &session->weights)) {
+	if (executionMode == CXMeasurementExecutionParallel) {
+		session->parallel.workerCount = CXMAX(CXThreadPoolGetWorkerCount(), (CXSize)1);
+		session->parallel.scratch = calloc(session->parallel.workerCount, sizeof(CXLeidenScratch));
+		if (!session->parallel.scratch) {
+			session->phase = CXLeidenPhaseFailed;
+			return session;
+		}
+	}
+
+	session->snapshot = CXNetworkSnapshotAcquire(network);
+	if (!session->snapshot) {
+		session->phase = CXLeidenPhaseFailed;
+		return session;
+	}
+	session->weights = CXNetworkSnapshotAcquireWeights(session->snapshot, network, edgeWeightAttribute);
+	if (!session->weights) {
 		session->phase = CXLeidenPhaseFailed;
 		return session;
 	}
 
-	CXIndex *nodeToCompact = NULL;
-	session->baseGraph = CXLeidenGraphFromNetwork(network, &session->weights, &session->compactToNode, &nodeToCompact);
-	free(nodeToCompact);
+	session->baseGraph = CXLeidenGraphFromSnapshot(
+		session->snapshot,
+		session->weights,
+		session->parallel.scratch ? session->parallel.workerCount : 1
+	);
 	if (!session->baseGraph) {
 		session->phase = CXLeidenPhaseFailed;
 		return session;
 	}
+	session->compactToNode = session->snapshot->compactToNode;
 	session->graph = session->baseGraph;
 	session->originalCount = session->baseGraph->nodeCount;
 	if (session->originalCount == 0) {
@@ -1578,8 +2167,15 @@ void CXLeidenSessionDestroy(CXLeidenSessionRef sessionRef) {
 		CXLeidenGraphDestroy(session->graph);
 	}
 	CXLeidenGraphDestroy(session->baseGraph);
-	free(session->compactToNode);
+	CXNetworkSnapshotWeightsRelease(session->weights);
+	CXNetworkSnapshotRelease(session->snapshot);
 	free(session->origToNode);
+	if (session->parallel.scratch) {
+		for (CXSize w = 0; w < session->parallel.workerCount; w++) {
+			CXLeidenScratchDestroy(&session->parallel.scratch[w]);
+		}
+		free(session->parallel.scratch);
+	}
 	free(session);
 }
 
@@ -1603,7 +2199,7 @@ static CXBool CXLeidenSessionStartCoarse(CXLeidenSession *session) {
 			session->coarse[i] = (uint32_t)i;
 		}
 	}
-	if (!CXLeidenMoveStateInit(&session->moveState, session->graph, session->coarse, NULL, session->resolution, &session->rng, session->maxPasses)) {
+	if (!CXLeidenMoveStateInit(&session->moveState, session->graph, session->coarse, NULL, session->resolution, &session->rng, session->maxPasses, CXLeidenSessionParallel(session))) {
 		return CXFalse;
 	}
 	session->phase = CXLeidenPhaseCoarseMove;
@@ -1634,7 +2230,14 @@ static CXBool CXLeidenSessionStartRefine(CXLeidenSession *session) {
 	for (CXSize i = 0; i < n; i++) {
 		session->refined[i] = (uint32_t)i;
 	}
-	CXLeidenMergeSingletons(session->graph, session->refined, session->coarse, session->resolution, &session->rng);
+	const CXLeidenParallel *parallel = CXLeidenSessionParallel(session);
+	if (parallel) {
+		if (!CXLeidenMergeSingletonsParallel(session->graph, session->refined, session->coarse, session->resolution, &session->rng, parallel)) {
+			return CXFalse;
+		}
+	} else {
+		CXLeidenMergeSingletons(session->graph, session->refined, session->coarse, session->resolution, &session->rng);
+	}
 	if (!CXLeidenSessionFinishRefine(session)) {
 		return CXFalse;
 	}
@@ -1712,7 +2315,10 @@ static CXBool CXLeidenSessionAggregate(CXLeidenSession *session) {
 	if (!nextInitial) {
 		return CXFalse;
 	}
-	CXLeidenGraph *next = CXLeidenGraphAggregate(session->graph, session->refined, session->refinedCount);
+	const CXLeidenParallel *parallel = CXLeidenSessionParallel(session);
+	CXLeidenGraph *next = parallel
+		? CXLeidenGraphAggregateParallel(session->graph, session->refined, session->refinedCount, parallel)
+		: CXLeidenGraphAggregate(session->graph, session->refined, session->refinedCount);
 	if (!next) {
 		free(nextInitial);
 		return CXFalse;
@@ -1760,8 +2366,9 @@ CXLeidenPhase CXLeidenSessionStep(CXLeidenSessionRef sessionRef, CXSize budget)
 		if (!CXLeidenMoveStateStep(&session->moveState, budget)) {
 			return session->phase;
 		}
+		CXBool moveFailed = session->moveState.failed;
 		CXLeidenMoveStateDestroy(&session->moveState);
-		if (!CXLeidenSessionFinishCoarse(session) || !CXLeidenSessionStartRefine(session)) {
+		if (moveFailed || !CXLeidenSessionFinishCoarse(session) || !CXLeidenSessionStartRefine(session)) {
 			session->phase = CXLeidenPhaseFailed;
 			return session->phase;
 		}
@@ -1962,6 +2569,7 @@ CXSize CXNetworkLeidenModularity(
 	uint32_t seed,
 	CXSize maxLevels,
 	CXSize maxPasses,
+	CXMeasurementExecutionMode executionMode,
 	const CXString outNodeCommunityAttribute,
 	double *outModularity
 ) {
@@ -1969,7 +2577,7 @@ CXSize CXNetworkLeidenModularity(
 		return 0;
 	}
 
-	CXLeidenSessionRef session = CXLeidenSessionCreate(network, edgeWeightAttribute, resolution, seed, maxLevels, maxPasses);
+	CXLeidenSessionRef session = CXLeidenSessionCreate(network, edgeWeightAttribute, resolution, seed, maxLevels, maxPasses, executionMode);
 	if (!session) {
 		return 0;
 	}
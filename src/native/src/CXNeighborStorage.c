@@ -382,6 +382,33 @@ CXBool CXNeighborContainerAdd(CXNeighborContainer *container, CXIndex node, CXIn
 	return CXNeighborMapAdd(&container->storage.map, node, edge);
 }
 
+/** Reserves room for a known number of additions ahead of a bulk insert. */
+CXBool CXNeighborContainerReserve(CXNeighborContainer *container, CXSize additional) {
+	if (!container) {
+		return CXFalse;
+	}
+	if (container->storageType != CXNeighborListType) {
+		return CXTrue;
+	}
+	CXNeighborList *list = &container->storage.list;
+	CXSize required = list->count + additional;
+	if (required <= list->capacity) {
+		return CXTrue;
+	}
+	CXIndex *newNodes = realloc(list->nodes, sizeof(CXIndex) * required);
+	if (!newNodes) {
+		return CXFalse;
+	}
+	list->nodes = newNodes;
+	CXIndex *newEdges = realloc(list->edges, sizeof(CXIndex) * required);
+	if (!newEdges) {
+		return CXFalse;
+	}
+	list->edges = newEdges;
+	list->capacity = required;
+	return CXTrue;
+}
+
 /** Removes edges referenced by the supplied set. */
 CXBool CXNeighborContainerRemoveEdgesFromSet(CXNeighborContainer *container, CXUIntegerSetRef edgeSet) {
 	if (!container) {
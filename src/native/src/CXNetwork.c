@@ -1,5 +1,6 @@
 #include "CXNetwork.h"
 #include <math.h>
+#include <errno.h>
 
 // Internal helpers -----------------------------------------------------------
 
@@ -31,6 +32,8 @@ static CXAttributeRef CXAttributeCreate(CXAttributeType type, CXSize dimension,
 static void CXAttributeDestroy(CXAttributeRef attribute);
 static CXBool CXAttributeEnsureCapacity(CXAttributeRef attribute, CXSize requiredCapacity);
 static void CXAttributeClearSlot(CXAttributeRef attribute, CXIndex index);
+static void CXAttributeClearRange(CXAttributeRef attribute, CXIndex start, CXIndex end);
+static void CXAttributeClearSlots(CXAttributeRef attribute, const CXIndex *indices, CXSize count, const CXBitArray mask, CXSize maskCount);
 
 static void CXDestroyAttributeDictionary(CXStringDictionaryRef dictionary);
 
@@ -38,7 +41,22 @@ static CXBool CXNetworkEnsureNodeCapacity(CXNetworkRef network, CXSize required)
 static CXBool CXNetworkEnsureEdgeCapacity(CXNetworkRef network, CXSize required);
 static void CXNetworkResetNodeRecord(CXNetworkRef network, CXIndex node);
 static void CXNetworkResetEdgeRecord(CXNetworkRef network, CXIndex edge);
-static CXBool CXNetworkDetachEdge(CXNetworkRef network, CXIndex edge, CXBool recycleIndex);
+static CXBool CXNetworkDetachEdge(CXNetworkRef network, CXIndex edge, CXBool recycleIndex, CXIndex releasedNode);
+static void CXNetworkDropFrozenAdjacency(CXNetworkRef network);
+static void CXNetworkDropEdgeSlots(CXNetworkRef network);
+static inline CXSize CXNetworkEdgeSlotStride(CXNetworkRef network);
+static CXBool CXNetworkEnsureEdgeSlots(CXNetworkRef network);
+/** Node or edge batches at least this large go through `CXNetworkRemoveBatch`. */
+#define CX_NETWORK_REMOVAL_BATCH_MIN 64
+static CXBool CXNetworkRemoveBatch(
+	CXNetworkRef network,
+	const CXIndex *nodeIndices,
+	CXSize nodeCount,
+	const CXIndex *edgeIndices,
+	CXSize edgeCount,
+	CXSize *outRemovedNodes,
+	CXSize *outRemovedEdges
+);
 
 static void CXNetworkMarkNodesDirty(CXNetworkRef network);
 static void CXNetworkMarkEdgesDirty(CXNetworkRef network);
@@ -328,6 +346,7 @@ static void CXAttributeDestroy(CXAttributeRef attribute) {
 	if (attribute->categoricalDictionary) {
 		CXStringDictionaryDestroy(attribute->categoricalDictionary);
 	}
+	CXAttributeIndexDestroy(attribute->index);
 	free(attribute);
 }
 
@@ -379,6 +398,103 @@ static void CXAttributeClearSlot(CXAttributeRef attribute, CXIndex index) {
 	memset(attribute->data + ((size_t)index * attribute->stride), 0, attribute->stride);
 }
 
+/** Zeroes the attribute payload for the logical indices `[start, end)`. */
+static void CXAttributeClearRange(CXAttributeRef attribute, CXIndex start, CXIndex end) {
+	if (!attribute || start >= end) {
+		return;
+	}
+	if (end > attribute->capacity) {
+		end = attribute->capacity;
+		if (start >= end) {
+			return;
+		}
+	}
+	if (attribute->type == CXDataAttributeMultiCategoryType) {
+		CXMultiCategoryBuffer *buffer = attribute->multiCategory;
+		if (!buffer || !buffer->offsets) {
+			return;
+		}
+		uint32_t *offsets = buffer->offsets;
+		size_t first = offsets[start];
+		size_t last = offsets[end];
+		size_t removed = last - first;
+		if (removed == 0) {
+			return;
+		}
+		size_t tailCount = buffer->entryCount - last;
+		if (tailCount > 0) {
+			memmove(buffer->ids + first, buffer->ids + last, tailCount * sizeof(uint32_t));
+			if (buffer->hasWeights) {
+				memmove(buffer->weights + first, buffer->weights + last, tailCount * sizeof(float));
+			}
+		}
+		for (CXSize i = start + 1; i <= end; i++) {
+			offsets[i] = (uint32_t)first;
+		}
+		for (CXSize i = end + 1; i < attribute->capacity + 1; i++) {
+			offsets[i] = (uint32_t)(offsets[i] - removed);
+		}
+		buffer->entryCount -= removed;
+		return;
+	}
+	if (!attribute->data) {
+		return;
+	}
+	memset(attribute->data + ((size_t)start * attribute->stride), 0, (size_t)(end - start) * attribute->stride);
+}
+
+/**
+ * Zeroes the attribute payload of the listed indices. `mask` flags the same
+ * indices over `[0, maskCount)`; multi-category columns use it to drop every
+ * listed row in one pass over the packed entries.
+ */
+static void CXAttributeClearSlots(CXAttributeRef attribute, const CXIndex *indices, CXSize count, const CXBitArray mask, CXSize maskCount) {
+	if (!attribute || count == 0) {
+		return;
+	}
+	if (attribute->type != CXDataAttributeMultiCategoryType) {
+		if (!attribute->data) {
+			return;
+		}
+		for (CXSize i = 0; i < count; i++) {
+			if (indices[i] < attribute->capacity) {
+				memset(attribute->data + ((size_t)indices[i] * attribute->stride), 0, attribute->stride);
+			}
+		}
+		return;
+	}
+	CXMultiCategoryBuffer *buffer = attribute->multiCategory;
+	if (!buffer || !buffer->offsets) {
+		return;
+	}
+	uint32_t *offsets = buffer->offsets;
+	CXBool anyEntries = CXFalse;
+	for (CXSize i = 0; i < count && !anyEntries; i++) {
+		anyEntries = indices[i] < attribute->capacity && offsets[indices[i]] != offsets[indices[i] + 1];
+	}
+	if (!anyEntries) {
+		return;
+	}
+	size_t readStart = offsets[0];
+	size_t write = readStart;
+	for (CXSize row = 0; row < attribute->capacity; row++) {
+		size_t readEnd = offsets[row + 1];
+		if (row >= maskCount || !CXBitArrayTest(mask, row)) {
+			size_t length = readEnd - readStart;
+			if (length > 0 && write != readStart) {
+				memmove(buffer->ids + write, buffer->ids + readStart, length * sizeof(uint32_t));
+				if (buffer->hasWeights) {
+					memmove(buffer->weights + write, buffer->weights + readStart, length * sizeof(float));
+				}
+			}
+			write += length;
+		}
+		offsets[row + 1] = (uint32_t)write;
+		readStart = readEnd;
+	}
+	buffer->entryCount = write;
+}
+
 static void CXNetworkBumpAttributeDictionaryVersions(CXStringDictionaryRef dictionary) {
 	if (!dictionary) {
 		return;
@@ -973,6 +1089,15 @@ static CXBool CXNetworkEnsureEdgeCapacity(CXNetworkRef network, CXSize required)
 		}
 	}
 
+	if (network->edgeSlots) {
+		CXIndex *newSlots = realloc(network->edgeSlots, sizeof(CXIndex) * newCapacity * CXNetworkEdgeSlotStride(network));
+		if (newSlots) {
+			network->edgeSlots = newSlots;
+		} else {
+			CXNetworkDropEdgeSlots(network);
+		}
+	}
+
 	free(network->edges);
 	free(network->edgeActive);
 	network->edges = newEdges;
@@ -1023,6 +1148,9 @@ void CXFreeNetwork(CXNetworkRef network) {
 	if (!network) {
 		return;
 	}
+	CXNetworkSnapshotInvalidate(network);
+	CXNetworkDropFrozenAdjacency(network);
+	CXNetworkDropEdgeSlots(network);
 
 	if (network->nodes) {
 		for (CXSize i = 0; i < network->nodeCapacity; i++) {
@@ -1496,6 +1624,431 @@ CXSize CXNetworkCopyNodeAttributesToEdgeAttributes(
 	return written;
 }
 
+// -----------------------------------------------------------------------------
+// Frozen adjacency
+// -----------------------------------------------------------------------------
+
+/*
+ * While frozen, every list-backed container borrows its `nodes`/`edges` arrays
+ * from `network->frozenAdjacency`: all neighbour ids first, then all edge ids,
+ * both laid out node by node (out list before in list), so the per-node
+ * ranges form an implicit CSR. Map-backed containers are left untouched.
+ */
+static CXNeighborList *CXNetworkFrozenList(CXNetworkRef network, CXIndex node, CXBool inbound) {
+	CXNeighborContainer *container = inbound ? &network->nodes[node].inNeighbors : &network->nodes[node].outNeighbors;
+	return container->storageType == CXNeighborListType ? &container->storage.list : NULL;
+}
+
+/** Forgets the borrowed ranges without copying them back (teardown only). */
+static void CXNetworkDropFrozenAdjacency(CXNetworkRef network) {
+	if (!network || !network->frozenAdjacency) {
+		return;
+	}
+	for (CXIndex node = 0; node < network->nodeCapacity; node++) {
+		for (int direction = 0; direction < 2; direction++) {
+			CXNeighborList *list = CXNetworkFrozenList(network, node, direction == 1);
+			if (list) {
+				list->nodes = NULL;
+				list->edges = NULL;
+				list->count = 0;
+				list->capacity = 0;
+			}
+		}
+	}
+	free(network->frozenAdjacency);
+	network->frozenAdjacency = NULL;
+}
+
+CXBool CXNetworkFreeze(CXNetworkRef network) {
+	if (!network) {
+		return CXFalse;
+	}
+	if (network->frozenAdjacency) {
+		return CXTrue;
+	}
+	CXSize total = 0;
+	for (CXIndex node = 0; node < network->nodeCapacity; node++) {
+		for (int direction = 0; direction < 2; direction++) {
+			CXNeighborList *list = CXNetworkFrozenList(network, node, direction == 1);
+			if (list) {
+				total += list->count;
+			}
+		}
+	}
+	CXIndex *block = (CXIndex *)malloc(CXMAX(total * 2, (CXSize)1) * sizeof(CXIndex));
+	if (!block) {
+		return CXFalse;
+	}
+	CXIndex *nodes = block;
+	CXIndex *edges = block + total;
+	CXSize cursor = 0;
+	for (CXIndex node = 0; node < network->nodeCapacity; node++) {
+		for (int direction = 0; direction < 2; direction++) {
+			CXNeighborList *list = CXNetworkFrozenList(network, node, direction == 1);
+			if (!list) {
+				continue;
+			}
+			CXSize count = list->count;
+			if (count > 0) {
+				memcpy(nodes + cursor, list->nodes, count * sizeof(CXIndex));
+				memcpy(edges + cursor, list->edges, count * sizeof(CXIndex));
+			}
+			free(list->nodes);
+			free(list->edges);
+			list->nodes = nodes + cursor;
+			list->edges = edges + cursor;
+			list->capacity = count;
+			cursor += count;
+		}
+	}
+	network->frozenAdjacency = block;
+	return CXTrue;
+}
+
+CXBool CXNetworkThaw(CXNetworkRef network) {
+	if (!network) {
+		return CXFalse;
+	}
+	if (!network->frozenAdjacency) {
+		return CXTrue;
+	}
+	CXIndex *block = network->frozenAdjacency;
+	CXSize total = 0;
+	CXBool failed = CXFalse;
+	for (CXIndex node = 0; node < network->nodeCapacity; node++) {
+		for (int direction = 0; direction < 2; direction++) {
+			CXNeighborList *list = CXNetworkFrozenList(network, node, direction == 1);
+			if (!list) {
+				continue;
+			}
+			total += list->count;
+			if (failed || list->count == 0) {
+				continue;
+			}
+			CXIndex *ownNodes = (CXIndex *)malloc(list->count * sizeof(CXIndex));
+			CXIndex *ownEdges = (CXIndex *)malloc(list->count * sizeof(CXIndex));
+			if (!ownNodes || !ownEdges) {
+				free(ownNodes);
+				free(ownEdges);
+				failed = CXTrue;
+				continue;
+			}
+			memcpy(ownNodes, list->nodes, list->count * sizeof(CXIndex));
+			memcpy(ownEdges, list->edges, list->count * sizeof(CXIndex));
+			list->nodes = ownNodes;
+			list->edges = ownEdges;
+		}
+	}
+
+	CXSize cursor = 0;
+	for (CXIndex node = 0; node < network->nodeCapacity; node++) {
+		for (int direction = 0; direction < 2; direction++) {
+			CXNeighborList *list = CXNetworkFrozenList(network, node, direction == 1);
+			if (!list) {
+				continue;
+			}
+			CXIndex *borrowedNodes = block + cursor;
+			CXIndex *borrowedEdges = block + total + cursor;
+			cursor += list->count;
+			if (!failed) {
+				if (list->count == 0) {
+					list->nodes = NULL;
+					list->edges = NULL;
+					list->capacity = 0;
+				}
+				continue;
+			}
+			/* Roll back to the borrowed ranges so the network stays frozen. */
+			if (list->nodes != borrowedNodes) {
+				free(list->nodes);
+				free(list->edges);
+			}
+			list->nodes = borrowedNodes;
+			list->edges = borrowedEdges;
+		}
+	}
+	if (failed) {
+		return CXFalse;
+	}
+	free(block);
+	network->frozenAdjacency = NULL;
+	return CXTrue;
+}
+
+CXBool CXNetworkIsFrozen(CXNetworkRef network) {
+	return (network && network->frozenAdjacency) ? CXTrue : CXFalse;
+}
+
+/* Appends one adjacency entry into a list whose range was reserved up front. */
+static CXBool CXNetworkFrozenAppend(CXNetworkRef network, CXIndex node, CXBool inbound, CXIndex neighbor, CXIndex edge) {
+	CXNeighborList *list = CXNetworkFrozenList(network, node, inbound);
+	if (!list) {
+		CXNeighborContainer *container = inbound ? &network->nodes[node].inNeighbors : &network->nodes[node].outNeighbors;
+		return CXNeighborContainerAdd(container, neighbor, edge);
+	}
+	list->nodes[list->count] = neighbor;
+	list->edges[list->count] = edge;
+	list->count++;
+	return CXTrue;
+}
+
+static void CXNetworkFrozenResetCounts(CXNetworkRef network) {
+	for (CXIndex node = 0; node < network->nodeCapacity; node++) {
+		for (int direction = 0; direction < 2; direction++) {
+			CXNeighborList *list = CXNetworkFrozenList(network, node, direction == 1);
+			if (list) {
+				list->count = 0;
+			}
+		}
+	}
+}
+
+CXBool CXNetworkBuildFrozenAdjacency(CXNetworkRef network) {
+	if (!network || network->frozenAdjacency) {
+		errno = EINVAL;
+		return CXFalse;
+	}
+	for (CXIndex node = 0; node < network->nodeCapacity; node++) {
+		if (CXNeighborContainerCount(&network->nodes[node].outNeighbors) > 0 ||
+			CXNeighborContainerCount(&network->nodes[node].inNeighbors) > 0) {
+			errno = EINVAL;
+			return CXFalse;
+		}
+	}
+
+	CXNetworkDropEdgeSlots(network);
+
+	/* Degrees go into the (empty) list counts first. Undirected edges are
+	 * mirrored into both lists of both endpoints, as CXNetworkAddEdges does. */
+	CXSize mirror = network->isDirected ? 1 : 2;
+	CXSize total = 0;
+	for (CXIndex edge = 0; edge < network->edgeCapacity; edge++) {
+		if (!network->edgeActive[edge]) {
+			continue;
+		}
+		CXEdge record = network->edges[edge];
+		if ((CXSize)record.from >= network->nodeCapacity || (CXSize)record.to >= network->nodeCapacity) {
+			CXNetworkFrozenResetCounts(network);
+			errno = EINVAL;
+			return CXFalse;
+		}
+		CXIndex endpoints[2] = { record.from, record.to };
+		for (CXSize side = 0; side < 2; side++) {
+			for (CXSize copy = 0; copy < mirror; copy++) {
+				CXNeighborList *list = CXNetworkFrozenList(network, endpoints[side], (side + copy) % 2 == 1);
+				if (list) {
+					list->count++;
+					total++;
+				}
+			}
+		}
+	}
+
+	CXIndex *block = (CXIndex *)malloc(CXMAX(total * 2, (CXSize)1) * sizeof(CXIndex));
+	if (!block) {
+		CXNetworkFrozenResetCounts(network);
+		return CXFalse;
+	}
+	CXSize cursor = 0;
+	for (CXIndex node = 0; node < network->nodeCapacity; node++) {
+		for (int direction = 0; direction < 2; direction++) {
+			CXNeighborList *list = CXNetworkFrozenList(network, node, direction == 1);
+			if (!list) {
+				continue;
+			}
+			free(list->nodes);
+			free(list->edges);
+			list->nodes = block + cursor;
+			list->edges = block + total + cursor;
+			list->capacity = list->count;
+			cursor += list->count;
+			list->count = 0;
+		}
+	}
+	network->frozenAdjacency = block;
+
+	for (CXIndex edge = 0; edge < network->edgeCapacity; edge++) {
+		if (!network->edgeActive[edge]) {
+			continue;
+		}
+		CXEdge record = network->edges[edge];
+		if (!CXNetworkFrozenAppend(network, record.from, CXFalse, record.to, edge) ||
+			!CXNetworkFrozenAppend(network, record.to, CXTrue, record.from, edge)) {
+			return CXFalse;
+		}
+		if (!network->isDirected &&
+			(!CXNetworkFrozenAppend(network, record.from, CXTrue, record.to, edge) ||
+			!CXNetworkFrozenAppend(network, record.to, CXFalse, record.from, edge))) {
+			return CXFalse;
+		}
+	}
+	return CXTrue;
+}
+
+CXBool CXNetworkAdoptFrozenAdjacency(CXNetworkRef network, CXIndex *block, const CXIndex *listOffsets) {
+	if (!network || !block || !listOffsets || network->frozenAdjacency) {
+		errno = EINVAL;
+		return CXFalse;
+	}
+	for (CXIndex node = 0; node < network->nodeCapacity; node++) {
+		if (!CXNetworkFrozenList(network, node, CXFalse) || !CXNetworkFrozenList(network, node, CXTrue) ||
+			CXNeighborContainerCount(&network->nodes[node].outNeighbors) > 0 ||
+			CXNeighborContainerCount(&network->nodes[node].inNeighbors) > 0) {
+			errno = EINVAL;
+			return CXFalse;
+		}
+	}
+	CXNetworkDropEdgeSlots(network);
+	CXSize total = listOffsets[network->nodeCapacity * 2];
+	for (CXIndex node = 0; node < network->nodeCapacity; node++) {
+		for (int direction = 0; direction < 2; direction++) {
+			CXNeighborList *list = CXNetworkFrozenList(network, node, direction == 1);
+			CXIndex start = listOffsets[node * 2 + (CXIndex)direction];
+			CXIndex end = listOffsets[node * 2 + (CXIndex)direction + 1];
+			free(list->nodes);
+			free(list->edges);
+			list->nodes = block + start;
+			list->edges = block + total + start;
+			list->count = end - start;
+			list->capacity = end - start;
+		}
+	}
+	network->frozenAdjacency = block;
+	return CXTrue;
+}
+
+// -----------------------------------------------------------------------------
+// Edge slots
+// -----------------------------------------------------------------------------
+
+/*
+ * With fast edge removal enabled, `edgeSlots[edge * stride + role]` is the
+ * position of the edge inside one list of its endpoints. Roles:
+ * 0 = out list of `from`, 1 = in list of `to`, and for undirected networks
+ * 2 = in list of `from`, 3 = out list of `to`. Entries kept in map-backed
+ * containers are left at CXIndexMAX.
+ */
+#define CX_EDGE_SLOT_FROM_OUT 0
+#define CX_EDGE_SLOT_TO_IN 1
+#define CX_EDGE_SLOT_FROM_IN 2
+#define CX_EDGE_SLOT_TO_OUT 3
+
+static inline CXSize CXNetworkEdgeSlotStride(CXNetworkRef network) {
+	return network->isDirected ? 2 : 4;
+}
+
+static void CXNetworkDropEdgeSlots(CXNetworkRef network) {
+	if (!network) {
+		return;
+	}
+	free(network->edgeSlots);
+	network->edgeSlots = NULL;
+}
+
+/** Builds the slot table from the current neighbour lists when the mode is on. */
+static CXBool CXNetworkEnsureEdgeSlots(CXNetworkRef network) {
+	if (!network->fastEdgeRemoval || network->edgeSlots) {
+		return CXTrue;
+	}
+	CXSize stride = CXNetworkEdgeSlotStride(network);
+	CXSize slotCount = CXMAX(network->edgeCapacity, (CXSize)1) * stride;
+	CXIndex *slots = malloc(sizeof(CXIndex) * slotCount);
+	if (!slots) {
+		return CXFalse;
+	}
+	for (CXSize i = 0; i < slotCount; i++) {
+		slots[i] = CXIndexMAX;
+	}
+	for (CXIndex node = 0; node < network->nodeCapacity; node++) {
+		if (!network->nodeActive[node]) {
+			continue;
+		}
+		for (int direction = 0; direction < 2; direction++) {
+			CXBool inbound = direction == 1;
+			CXNeighborContainer *container = inbound ? &network->nodes[node].inNeighbors : &network->nodes[node].outNeighbors;
+			if (container->storageType != CXNeighborListType) {
+				continue;
+			}
+			const CXNeighborList *list = &container->storage.list;
+			for (CXSize position = 0; position < list->count; position++) {
+				CXIndex edge = list->edges[position];
+				CXIndex *edgeSlots = slots + edge * stride;
+				// Undirected self-loops sit twice in each list: the first
+				// occurrence takes the near-endpoint role, the second the other.
+				CXIndex endpoint = inbound ? network->edges[edge].to : network->edges[edge].from;
+				int nearRole = inbound ? CX_EDGE_SLOT_TO_IN : CX_EDGE_SLOT_FROM_OUT;
+				int farRole = inbound ? CX_EDGE_SLOT_FROM_IN : CX_EDGE_SLOT_TO_OUT;
+				if (network->isDirected || (endpoint == node && edgeSlots[nearRole] == CXIndexMAX)) {
+					edgeSlots[nearRole] = position;
+				} else {
+					edgeSlots[farRole] = position;
+				}
+			}
+		}
+	}
+	network->edgeSlots = slots;
+	return CXTrue;
+}
+
+/** Appends a neighbour entry and records its position in `slot` when tracked. */
+static void CXNetworkAppendNeighbor(CXNeighborContainer *container, CXIndex node, CXIndex edge, CXIndex *slot) {
+	if (!CXNeighborContainerAdd(container, node, edge) || !slot) {
+		return;
+	}
+	*slot = container->storageType == CXNeighborListType ? container->storage.list.count - 1 : CXIndexMAX;
+}
+
+/**
+ * Removes the entry at the recorded position by moving the list's last entry
+ * into it and repointing that entry's slot. Returns CXFalse when the table
+ * does not match the list.
+ */
+static CXBool CXNetworkRemoveEdgeSlot(CXNetworkRef network, CXIndex node, CXBool inbound, CXIndex edge, int role) {
+	CXNeighborContainer *container = inbound ? &network->nodes[node].inNeighbors : &network->nodes[node].outNeighbors;
+	if (container->storageType != CXNeighborListType) {
+		CXNeighborMapRemoveEdgesFromArray(&container->storage.map, &edge, 1);
+		return CXTrue;
+	}
+	CXNeighborList *list = &container->storage.list;
+	CXSize stride = CXNetworkEdgeSlotStride(network);
+	CXIndex position = network->edgeSlots[edge * stride + (CXSize)role];
+	if (position >= list->count || list->edges[position] != edge) {
+		return CXFalse;
+	}
+	CXIndex last = list->count - 1;
+	if (position != last) {
+		CXIndex moved = list->edges[last];
+		list->nodes[position] = list->nodes[last];
+		list->edges[position] = moved;
+		CXIndex *movedSlots = network->edgeSlots + moved * stride;
+		CXIndex endpoint = inbound ? network->edges[moved].to : network->edges[moved].from;
+		int nearRole = inbound ? CX_EDGE_SLOT_TO_IN : CX_EDGE_SLOT_FROM_OUT;
+		int farRole = inbound ? CX_EDGE_SLOT_FROM_IN : CX_EDGE_SLOT_TO_OUT;
+		if (endpoint == node && movedSlots[nearRole] == last) {
+			movedSlots[nearRole] = position;
+		} else if (!network->isDirected) {
+			movedSlots[farRole] = position;
+		}
+	}
+	list->count--;
+	return CXTrue;
+}
+
+CXBool CXNetworkSetFastEdgeRemoval(CXNetworkRef network, CXBool enabled) {
+	if (!network) {
+		return CXFalse;
+	}
+	network->fastEdgeRemoval = enabled ? CXTrue : CXFalse;
+	if (!enabled) {
+		CXNetworkDropEdgeSlots(network);
+	}
+	return CXTrue;
+}
+
+CXBool CXNetworkHasFastEdgeRemoval(CXNetworkRef network) {
+	return (network && network->fastEdgeRemoval) ? CXTrue : CXFalse;
+}
+
 // -----------------------------------------------------------------------------
 // Node management
 // -----------------------------------------------------------------------------
@@ -1514,6 +2067,9 @@ CXBool CXNetworkAddNodes(CXNetworkRef network, CXSize count, CXIndex *outIndices
 	if (!network || count == 0) {
 		return CXFalse;
 	}
+	if (!CXNetworkThaw(network)) {
+		return CXFalse;
+	}
 	if (!CXNetworkEnsureNodeCapacity(network, network->nodeCount + count)) {
 		return CXFalse;
 	}
@@ -1585,11 +2141,24 @@ CXBool CXNetworkRemoveNodes(CXNetworkRef network, const CXIndex *indices, CXSize
 	if (!network || !indices || count == 0) {
 		return CXFalse;
 	}
+	if (!CXNetworkThaw(network)) {
+		return CXFalse;
+	}
+
+	CXNetworkEnsureEdgeSlots(network);
 
 	CXBool removedAnyNode = CXFalse;
 	CXBool removedAnyEdge = CXFalse;
+	CXSize removedNodeCount = 0;
+	CXSize removedEdgeCount = 0;
+	if (count >= CX_NETWORK_REMOVAL_BATCH_MIN &&
+		CXNetworkRemoveBatch(network, indices, count, NULL, 0, &removedNodeCount, &removedEdgeCount)) {
+		removedAnyNode = removedNodeCount > 0;
+		removedAnyEdge = removedEdgeCount > 0;
+		count = 0;
+	}
 
-		for (CXSize i = 0; i < count; i++) {
+	for (CXSize i = 0; i < count; i++) {
 		CXIndex node = indices[i];
 		if (node >= network->nodeCapacity || !network->nodeActive[node]) {
 			continue;
@@ -1600,7 +2169,7 @@ CXBool CXNetworkRemoveNodes(CXNetworkRef network, const CXIndex *indices, CXSize
 		CXSize edgesCount = 0;
 		CXCollectEdgesFromContainer(&network->nodes[node].outNeighbors, &edgesBuffer, &edgesCount);
 		for (CXSize e = 0; e < edgesCount; e++) {
-			removedAnyEdge = CXNetworkDetachEdge(network, edgesBuffer[e], CXTrue) || removedAnyEdge;
+			removedAnyEdge = CXNetworkDetachEdge(network, edgesBuffer[e], CXTrue, node) || removedAnyEdge;
 		}
 		free(edgesBuffer);
 
@@ -1609,7 +2178,7 @@ CXBool CXNetworkRemoveNodes(CXNetworkRef network, const CXIndex *indices, CXSize
 		edgesCount = 0;
 		CXCollectEdgesFromContainer(&network->nodes[node].inNeighbors, &edgesBuffer, &edgesCount);
 		for (CXSize e = 0; e < edgesCount; e++) {
-			removedAnyEdge = CXNetworkDetachEdge(network, edgesBuffer[e], CXTrue) || removedAnyEdge;
+			removedAnyEdge = CXNetworkDetachEdge(network, edgesBuffer[e], CXTrue, node) || removedAnyEdge;
 		}
 		free(edgesBuffer);
 
@@ -1676,19 +2245,41 @@ static void CXNeighborContainerRemoveSingleEdge(CXNeighborContainer *container,
 	}
 }
 
-/** Disconnects an edge from its endpoints and optionally recycles its index. */
-static CXBool CXNetworkDetachEdge(CXNetworkRef network, CXIndex edge, CXBool recycleIndex) {
+/**
+ * Removes the edge from one endpoint list, in constant time when the slot
+ * table is built. A table that disagrees with the list is dropped and the
+ * entry is removed by scanning.
+ */
+static void CXNetworkUnlinkEdge(CXNetworkRef network, CXIndex node, CXBool inbound, CXIndex edge, int role) {
+	if (network->edgeSlots && CXNetworkRemoveEdgeSlot(network, node, inbound, edge, role)) {
+		return;
+	}
+	CXNetworkDropEdgeSlots(network);
+	CXNeighborContainerRemoveSingleEdge(inbound ? &network->nodes[node].inNeighbors : &network->nodes[node].outNeighbors, edge);
+}
+
+/**
+ * Disconnects an edge from its endpoints and optionally recycles its index.
+ * The lists of `releasedNode` (CXIndexMAX for none) are left as they are,
+ * for callers that reset that node afterwards. Callers mark the edge caches
+ * dirty and bump the topology version once per batch.
+ */
+static CXBool CXNetworkDetachEdge(CXNetworkRef network, CXIndex edge, CXBool recycleIndex, CXIndex releasedNode) {
 	if (!network || edge >= network->edgeCapacity || !network->edgeActive[edge]) {
 		return CXFalse;
 	}
-	CXNetworkMarkEdgesDirty(network);
-	network->edgeValidRangeDirty = CXTrue;
 	CXEdge edgeData = network->edges[edge];
-	CXNeighborContainerRemoveSingleEdge(&network->nodes[edgeData.from].outNeighbors, edge);
-	CXNeighborContainerRemoveSingleEdge(&network->nodes[edgeData.to].inNeighbors, edge);
-	if (!network->isDirected) {
-		CXNeighborContainerRemoveSingleEdge(&network->nodes[edgeData.from].inNeighbors, edge);
-		CXNeighborContainerRemoveSingleEdge(&network->nodes[edgeData.to].outNeighbors, edge);
+	if (edgeData.from != releasedNode) {
+		CXNetworkUnlinkEdge(network, edgeData.from, CXFalse, edge, CX_EDGE_SLOT_FROM_OUT);
+		if (!network->isDirected) {
+			CXNetworkUnlinkEdge(network, edgeData.from, CXTrue, edge, CX_EDGE_SLOT_FROM_IN);
+		}
+	}
+	if (edgeData.to != releasedNode) {
+		CXNetworkUnlinkEdge(network, edgeData.to, CXTrue, edge, CX_EDGE_SLOT_TO_IN);
+		if (!network->isDirected) {
+			CXNetworkUnlinkEdge(network, edgeData.to, CXFalse, edge, CX_EDGE_SLOT_TO_OUT);
+		}
 	}
 	network->edgeActive[edge] = CXFalse;
 	CXNetworkResetEdgeRecord(network, edge);
@@ -1698,72 +2289,461 @@ static CXBool CXNetworkDetachEdge(CXNetworkRef network, CXIndex edge, CXBool rec
 	if (network->edgeCount > 0) {
 		network->edgeCount--;
 	}
-	CXNetworkBumpTopologyVersion(network, CXFalse);
 	if (recycleIndex) {
 		CXIndexManagerAddIndex(network->edgeIndexManager, edge);
 	}
 	return CXTrue;
 }
 
-/** Adds new edges to the network, validating endpoints and returning indices. */
+/** Batches at least this large build adjacency from per-node addition counts. */
+#define CX_NETWORK_EDGE_BATCH_MIN 256
+/** Grain of the parallel passes over batch edges and touched nodes. */
+#define CX_NETWORK_EDGE_BATCH_GRAIN 4096
+
+/** Shared state of the parallel passes of `CXNetworkAddEdges`. */
+typedef struct {
+	CXNetworkRef network;
+	const CXEdge *edges;
+	CXIndex *outIndices;
+	const CXIndex *recycled;
+	CXSize recycledCount;
+	CXIndex firstFresh;
+	const CXIndex *touched;
+	const CXSize *outAdded;
+	const CXSize *inAdded;
+	CXBool *workerInvalid;
+} CXEdgeBatch;
+
+/** Index assigned to the `i`-th edge of the batch: recycled slots first, then the fresh range. */
+static inline CXIndex CXEdgeBatchIndex(const CXEdgeBatch *batch, CXSize i) {
+	return i < batch->recycledCount ? batch->recycled[i] : batch->firstFresh + (CXIndex)(i - batch->recycledCount);
+}
+
+static void CXEdgeBatchValidateRange(void *context, CXIndex start, CXIndex end, CXSize workerIndex) {
+	CXEdgeBatch *batch = (CXEdgeBatch *)context;
+	const CXNetworkRef network = batch->network;
+	for (CXIndex i = start; i < end; i++) {
+		CXEdge edge = batch->edges[i];
+		if (edge.from >= network->nodeCapacity || edge.to >= network->nodeCapacity ||
+			!network->nodeActive[edge.from] || !network->nodeActive[edge.to]) {
+			batch->workerInvalid[workerIndex] = CXTrue;
+			return;
+		}
+	}
+}
+
+static void CXEdgeBatchWriteRange(void *context, CXIndex start, CXIndex end, CXSize workerIndex) {
+	(void)workerIndex;
+	CXEdgeBatch *batch = (CXEdgeBatch *)context;
+	CXNetworkRef network = batch->network;
+	for (CXIndex i = start; i < end; i++) {
+		CXIndex edgeIndex = CXEdgeBatchIndex(batch, i);
+		network->edges[edgeIndex] = batch->edges[i];
+		network->edgeActive[edgeIndex] = CXTrue;
+		if (batch->outIndices) {
+			batch->outIndices[i] = edgeIndex;
+		}
+	}
+}
+
+static void CXEdgeBatchReserveRange(void *context, CXIndex start, CXIndex end, CXSize workerIndex) {
+	(void)workerIndex;
+	CXEdgeBatch *batch = (CXEdgeBatch *)context;
+	CXNodeRecord *nodes = batch->network->nodes;
+	for (CXIndex i = start; i < end; i++) {
+		CXIndex node = batch->touched ? batch->touched[i] : i;
+		// A failed reservation is retried by the incremental append below.
+		if (batch->outAdded[node] > 0) {
+			CXNeighborContainerReserve(&nodes[node].outNeighbors, batch->outAdded[node]);
+		}
+		if (batch->inAdded[node] > 0) {
+			CXNeighborContainerReserve(&nodes[node].inNeighbors, batch->inAdded[node]);
+		}
+	}
+}
+
+/** Runs `function` over `[0, count)` on the thread pool when the batch is large enough. */
+static void CXEdgeBatchFor(CXSize count, CXParallelRangeFunction function, CXEdgeBatch *batch) {
+	CXSize workers = CXMIN(CXParallelWorkerCount(count), (count + CX_NETWORK_EDGE_BATCH_GRAIN - 1) / CX_NETWORK_EDGE_BATCH_GRAIN);
+	if (workers > 1) {
+		CXParallelForRange(count, CX_NETWORK_EDGE_BATCH_GRAIN, workers, function, batch);
+	} else if (count > 0) {
+		function(batch, 0, count, 0);
+	}
+}
+
+/**
+ * Sizes every touched neighbour container for its additions in one pass, so
+ * the append loop never reallocates. Returns CXFalse when the counters cannot
+ * be allocated; the caller then appends incrementally.
+ */
+static CXBool CXEdgeBatchReserveAdjacency(CXEdgeBatch *batch, CXSize count) {
+	CXNetworkRef network = batch->network;
+	CXSize *outAdded = calloc(network->nodeCapacity, sizeof(CXSize));
+	CXSize *inAdded = calloc(network->nodeCapacity, sizeof(CXSize));
+	CXIndex *touched = malloc(sizeof(CXIndex) * count * 2);
+	if (!outAdded || !inAdded || !touched) {
+		free(outAdded);
+		free(inAdded);
+		free(touched);
+		return CXFalse;
+	}
+	CXSize touchedCount = 0;
+	for (CXSize i = 0; i < count; i++) {
+		CXIndex from = batch->edges[i].from;
+		CXIndex to = batch->edges[i].to;
+		if (outAdded[from] == 0 && inAdded[from] == 0) {
+			touched[touchedCount++] = from;
+		}
+		outAdded[from]++;
+		if (outAdded[to] == 0 && inAdded[to] == 0) {
+			touched[touchedCount++] = to;
+		}
+		inAdded[to]++;
+		if (!network->isDirected) {
+			inAdded[from]++;
+			outAdded[to]++;
+		}
+	}
+	batch->outAdded = outAdded;
+	batch->inAdded = inAdded;
+	// Dense batches walk the node records in order instead of in touch order.
+	if (touchedCount * 4 >= network->nodeCapacity) {
+		CXEdgeBatchFor(network->nodeCapacity, CXEdgeBatchReserveRange, batch);
+	} else {
+		batch->touched = touched;
+		CXEdgeBatchFor(touchedCount, CXEdgeBatchReserveRange, batch);
+	}
+	batch->touched = NULL;
+	batch->outAdded = NULL;
+	batch->inAdded = NULL;
+	free(outAdded);
+	free(inAdded);
+	free(touched);
+	return CXTrue;
+}
+
+/**
+ * Adds new edges to the network, validating endpoints and returning indices.
+ * The whole batch is validated before anything is written. Recycled indices
+ * are handed out first and the rest come from one contiguous fresh range, so
+ * attribute slots are cleared with a single pass per column.
+ */
 CXBool CXNetworkAddEdges(CXNetworkRef network, const CXEdge *edges, CXSize count, CXIndex *outIndices) {
 	if (!network || !edges || count == 0) {
 		return CXFalse;
 	}
-	if (!CXNetworkEnsureEdgeCapacity(network, network->edgeCount + count)) {
+	if (!CXNetworkThaw(network)) {
 		return CXFalse;
 	}
 
+	CXEdgeBatch batch = {0};
+	batch.network = network;
+	batch.edges = edges;
+	batch.outIndices = outIndices;
+
+	CXBool workerInvalid[CX_THREAD_POOL_MAX_WORKERS] = {0};
+	batch.workerInvalid = workerInvalid;
+	CXEdgeBatchFor(count, CXEdgeBatchValidateRange, &batch);
+	for (CXSize w = 0; w < CX_THREAD_POOL_MAX_WORKERS; w++) {
+		if (workerInvalid[w]) {
+			return CXFalse;
+		}
+	}
+
+	CXIndexManagerRef manager = network->edgeIndexManager;
+	CXSize recycledCount = CXMIN(manager->freeCount, count);
+	CXSize freshCount = count - recycledCount;
+	CXSize required = CXMAX(network->edgeCount + count, (CXSize)manager->nextIndex + freshCount);
+	if (!CXNetworkEnsureEdgeCapacity(network, required)) {
+		return CXFalse;
+	}
 	CXStringDictionaryFOR(entry, network->edgeAttributes) {
 		CXAttributeEnsureCapacity((CXAttributeRef)entry->data, network->edgeCapacity);
 	}
 
-	for (CXSize i = 0; i < count; i++) {
-		CXEdge edge = edges[i];
-		if (edge.from >= network->nodeCapacity || edge.to >= network->nodeCapacity) {
+	CXIndex *recycled = NULL;
+	if (recycledCount > 0) {
+		recycled = malloc(sizeof(CXIndex) * recycledCount);
+		if (!recycled) {
 			return CXFalse;
 		}
-		if (!network->nodeActive[edge.from] || !network->nodeActive[edge.to]) {
+		for (CXSize i = 0; i < recycledCount; i++) {
+			recycled[i] = CXIndexManagerGetIndex(manager);
+		}
+	}
+	CXIndex firstFresh = 0;
+	if (freshCount > 0) {
+		firstFresh = CXIndexManagerTakeRange(manager, freshCount);
+		if (firstFresh == CXIndexMAX) {
+			for (CXSize i = recycledCount; i > 0; i--) {
+				CXIndexManagerAddIndex(manager, recycled[i - 1]);
+			}
+			free(recycled);
 			return CXFalse;
 		}
+	}
+	batch.recycled = recycled;
+	batch.recycledCount = recycledCount;
+	batch.firstFresh = firstFresh;
 
-		CXIndex edgeIndex = CXIndexManagerGetIndex(network->edgeIndexManager);
-		if (edgeIndex == CXInvalidIndexValue) {
-			if (!CXNetworkEnsureEdgeCapacity(network, network->edgeCapacity + 1)) {
-				return CXFalse;
+	CXEdgeBatchFor(count, CXEdgeBatchWriteRange, &batch);
+
+	if (count >= CX_NETWORK_EDGE_BATCH_MIN) {
+		CXEdgeBatchReserveAdjacency(&batch, count);
+	}
+	const CXSize slotStride = CXNetworkEdgeSlotStride(network);
+	for (CXSize i = 0; i < count; i++) {
+		CXEdge edge = edges[i];
+		CXIndex edgeIndex = CXEdgeBatchIndex(&batch, i);
+		CXIndex *slots = network->edgeSlots ? network->edgeSlots + edgeIndex * slotStride : NULL;
+		CXNetworkAppendNeighbor(&network->nodes[edge.from].outNeighbors, edge.to, edgeIndex, slots ? &slots[CX_EDGE_SLOT_FROM_OUT] : NULL);
+		CXNetworkAppendNeighbor(&network->nodes[edge.to].inNeighbors, edge.from, edgeIndex, slots ? &slots[CX_EDGE_SLOT_TO_IN] : NULL);
+		if (!network->isDirected) {
+			CXNetworkAppendNeighbor(&network->nodes[edge.from].inNeighbors, edge.to, edgeIndex, slots ? &slots[CX_EDGE_SLOT_FROM_IN] : NULL);
+			CXNetworkAppendNeighbor(&network->nodes[edge.to].outNeighbors, edge.from, edgeIndex, slots ? &slots[CX_EDGE_SLOT_TO_OUT] : NULL);
+		}
+	}
+
+	CXStringDictionaryFOR(entry, network->edgeAttributes) {
+		CXAttributeRef attribute = (CXAttributeRef)entry->data;
+		for (CXSize i = 0; i < recycledCount; i++) {
+			CXAttributeClearSlot(attribute, recycled[i]);
+		}
+		if (freshCount > 0) {
+			CXAttributeClearRange(attribute, firstFresh, firstFresh + (CXIndex)freshCount);
+		}
+	}
+	free(recycled);
+
+	network->edgeCount += count;
+	if (!CXNetworkEnsureIndexBufferCapacity(&network->edgeIndexBuffer, &network->edgeIndexBufferCapacity, network->edgeCount)) {
+		return CXFalse;
+	}
+	network->edgeValidRangeDirty = CXTrue;
+	CXNetworkMarkEdgesDirty(network);
+	CXNetworkBumpAttributeDictionaryVersions(network->edgeAttributes);
+	CXNetworkBumpTopologyVersion(network, CXFalse);
+	return CXTrue;
+}
+
+/** Grain of the parallel neighbour list compaction. */
+#define CX_NETWORK_REMOVAL_GRAIN 256
+
+/** Shared state of the parallel compaction pass of `CXNetworkRemoveBatch`. */
+typedef struct {
+	CXNetworkRef network;
+	CXBitArray edgeMask;
+	const CXIndex *touched;
+} CXRemovalBatch;
+
+/** Drops every edge flagged in `edgeMask` from one container in a single pass. */
+static void CXRemovalCompactContainer(CXNeighborContainer *container, const CXBitArray edgeMask) {
+	if (container->storageType == CXNeighborListType) {
+		CXNeighborList *list = &container->storage.list;
+		CXSize write = 0;
+		for (CXSize read = 0; read < list->count; read++) {
+			CXIndex edge = list->edges[read];
+			if (CXBitArrayTest(edgeMask, edge)) {
+				continue;
 			}
-			edgeIndex = CXIndexManagerGetIndex(network->edgeIndexManager);
-			if (edgeIndex == CXInvalidIndexValue) {
-				return CXFalse;
+			list->nodes[write] = list->nodes[read];
+			list->edges[write] = edge;
+			write++;
+		}
+		list->count = write;
+		return;
+	}
+	// Map entries cannot be deleted while iterating; remove them in chunks.
+	CXIndex pending[64];
+	CXBool more = CXTrue;
+	while (more) {
+		CXSize pendingCount = 0;
+		more = CXFalse;
+		CXNeighborFOR(neighbor, edge, container) {
+			(void)neighbor;
+			if (CXBitArrayTest(edgeMask, edge)) {
+				if (pendingCount < 64) {
+					pending[pendingCount++] = edge;
+				} else {
+					more = CXTrue;
+				}
 			}
 		}
-		if (outIndices) {
-			outIndices[i] = edgeIndex;
+		if (pendingCount > 0) {
+			CXNeighborMapRemoveEdgesFromArray(&container->storage.map, pending, pendingCount);
 		}
-		network->edges[edgeIndex] = edge;
-		network->edgeActive[edgeIndex] = CXTrue;
+	}
+}
 
-		CXNeighborContainerAdd(&network->nodes[edge.from].outNeighbors, edge.to, edgeIndex);
-		CXNeighborContainerAdd(&network->nodes[edge.to].inNeighbors, edge.from, edgeIndex);
-		if (!network->isDirected) {
-			CXNeighborContainerAdd(&network->nodes[edge.from].inNeighbors, edge.to, edgeIndex);
-			CXNeighborContainerAdd(&network->nodes[edge.to].outNeighbors, edge.from, edgeIndex);
-		}
+static void CXRemovalCompactRange(void *context, CXIndex start, CXIndex end, CXSize workerIndex) {
+	(void)workerIndex;
+	CXRemovalBatch *batch = (CXRemovalBatch *)context;
+	CXNodeRecord *nodes = batch->network->nodes;
+	for (CXIndex i = start; i < end; i++) {
+		CXIndex node = batch->touched[i];
+		CXRemovalCompactContainer(&nodes[node].outNeighbors, batch->edgeMask);
+		CXRemovalCompactContainer(&nodes[node].inNeighbors, batch->edgeMask);
+	}
+}
+
+/**
+ * Removes a batch of nodes, with all their incident edges, plus a batch of
+ * edges in one go:
+ * - removed edges are collected once, deduplicated through a bit mask;
+ * - each surviving endpoint list is compacted once (or, with fast edge
+ *   removal, each entry is swapped out through its slot);
+ * - attribute slots are cleared column by column.
+ * Version bumps and cache invalidation are left to the caller. Returns
+ * CXFalse without touching the network when scratch memory is unavailable.
+ */
+static CXBool CXNetworkRemoveBatch(
+	CXNetworkRef network,
+	const CXIndex *nodeIndices,
+	CXSize nodeCount,
+	const CXIndex *edgeIndices,
+	CXSize edgeCount,
+	CXSize *outRemovedNodes,
+	CXSize *outRemovedEdges
+) {
+	CXBitArray nodeMask = CXNewBitArray(CXMAX(network->nodeCapacity, (CXSize)1));
+	CXBitArray edgeMask = CXNewBitArray(CXMAX(network->edgeCapacity, (CXSize)1));
+	CXIndex *removedNodes = malloc(sizeof(CXIndex) * CXMAX(nodeCount, (CXSize)1));
+	CXIndex *removedEdges = NULL;
+	CXBitArray touchedMask = NULL;
+	CXIndex *touched = NULL;
+	if (!nodeMask || !edgeMask || !removedNodes) {
+		goto fail;
+	}
 
-		CXStringDictionaryFOR(entry, network->edgeAttributes) {
-			CXAttributeClearSlot((CXAttributeRef)entry->data, edgeIndex);
+	CXSize removedNodeCount = 0;
+	CXSize incidentBound = 0;
+	for (CXSize i = 0; i < nodeCount; i++) {
+		CXIndex node = nodeIndices[i];
+		if (node >= network->nodeCapacity || !network->nodeActive[node] || CXBitArrayTest(nodeMask, node)) {
+			continue;
+		}
+		CXBitArraySet(nodeMask, node);
+		removedNodes[removedNodeCount++] = node;
+		incidentBound += CXNeighborContainerCount(&network->nodes[node].outNeighbors);
+		incidentBound += CXNeighborContainerCount(&network->nodes[node].inNeighbors);
+	}
+	removedEdges = malloc(sizeof(CXIndex) * CXMAX(edgeCount + incidentBound, (CXSize)1));
+	if (!removedEdges) {
+		goto fail;
+	}
+	CXSize removedEdgeCount = 0;
+	for (CXSize i = 0; i < edgeCount; i++) {
+		CXIndex edge = edgeIndices[i];
+		if (edge >= network->edgeCapacity || !network->edgeActive[edge] || CXBitArrayTest(edgeMask, edge)) {
+			continue;
 		}
+		CXBitArraySet(edgeMask, edge);
+		removedEdges[removedEdgeCount++] = edge;
+	}
+	for (CXSize i = 0; i < removedNodeCount; i++) {
+		for (int direction = 0; direction < 2; direction++) {
+			CXNodeRecord *record = &network->nodes[removedNodes[i]];
+			CXNeighborFOR(neighbor, edge, direction ? &record->inNeighbors : &record->outNeighbors) {
+				(void)neighbor;
+				if (!CXBitArrayTest(edgeMask, edge)) {
+					CXBitArraySet(edgeMask, edge);
+					removedEdges[removedEdgeCount++] = edge;
+				}
+			}
+		}
+	}
 
-			network->edgeCount++;
+	// Lists of removed nodes are discarded below, so only surviving endpoints
+	// are edited.
+	if (network->edgeSlots) {
+		for (CXSize i = 0; i < removedEdgeCount; i++) {
+			CXIndex edge = removedEdges[i];
+			CXEdge record = network->edges[edge];
+			if (!CXBitArrayTest(nodeMask, record.from)) {
+				CXNetworkUnlinkEdge(network, record.from, CXFalse, edge, CX_EDGE_SLOT_FROM_OUT);
+				if (!network->isDirected) {
+					CXNetworkUnlinkEdge(network, record.from, CXTrue, edge, CX_EDGE_SLOT_FROM_IN);
+				}
+			}
+			if (!CXBitArrayTest(nodeMask, record.to)) {
+				CXNetworkUnlinkEdge(network, record.to, CXTrue, edge, CX_EDGE_SLOT_TO_IN);
+				if (!network->isDirected) {
+					CXNetworkUnlinkEdge(network, record.to, CXFalse, edge, CX_EDGE_SLOT_TO_OUT);
+				}
+			}
 		}
-		if (!CXNetworkEnsureIndexBufferCapacity(&network->edgeIndexBuffer, &network->edgeIndexBufferCapacity, network->edgeCount)) {
-			return CXFalse;
+	} else if (removedEdgeCount > 0) {
+		touchedMask = CXNewBitArray(network->nodeCapacity);
+		touched = malloc(sizeof(CXIndex) * removedEdgeCount * 2);
+		if (!touchedMask || !touched) {
+			goto fail;
 		}
-		network->edgeValidRangeDirty = CXTrue;
-		CXNetworkMarkEdgesDirty(network);
-	CXNetworkBumpAttributeDictionaryVersions(network->edgeAttributes);
-	CXNetworkBumpTopologyVersion(network, CXFalse);
+		CXSize touchedCount = 0;
+		for (CXSize i = 0; i < removedEdgeCount; i++) {
+			CXEdge record = network->edges[removedEdges[i]];
+			CXIndex endpoints[2] = { record.from, record.to };
+			for (int k = 0; k < 2; k++) {
+				CXIndex node = endpoints[k];
+				if (!CXBitArrayTest(nodeMask, node) && !CXBitArrayTest(touchedMask, node)) {
+					CXBitArraySet(touchedMask, node);
+					touched[touchedCount++] = node;
+				}
+			}
+		}
+		CXRemovalBatch batch = { network, edgeMask, touched };
+		CXSize workers = CXMIN(CXParallelWorkerCount(touchedCount), (touchedCount + CX_NETWORK_REMOVAL_GRAIN - 1) / CX_NETWORK_REMOVAL_GRAIN);
+		if (workers > 1) {
+			CXParallelForRange(touchedCount, CX_NETWORK_REMOVAL_GRAIN, workers, CXRemovalCompactRange, &batch);
+		} else if (touchedCount > 0) {
+			CXRemovalCompactRange(&batch, 0, touchedCount, 0);
+		}
+	}
+
+	for (CXSize i = 0; i < removedEdgeCount; i++) {
+		CXIndex edge = removedEdges[i];
+		network->edgeActive[edge] = CXFalse;
+		CXNetworkResetEdgeRecord(network, edge);
+		CXIndexManagerAddIndex(network->edgeIndexManager, edge);
+	}
+	CXStringDictionaryFOR(entry, network->edgeAttributes) {
+		CXAttributeClearSlots((CXAttributeRef)entry->data, removedEdges, removedEdgeCount, edgeMask, network->edgeCapacity);
+	}
+	network->edgeCount = network->edgeCount > removedEdgeCount ? network->edgeCount - removedEdgeCount : 0;
+
+	for (CXSize i = 0; i < removedNodeCount; i++) {
+		CXIndex node = removedNodes[i];
+		CXNetworkResetNodeRecord(network, node);
+		network->nodeActive[node] = CXFalse;
+		CXIndexManagerAddIndex(network->nodeIndexManager, node);
+	}
+	CXStringDictionaryFOR(entry, network->nodeAttributes) {
+		CXAttributeClearSlots((CXAttributeRef)entry->data, removedNodes, removedNodeCount, nodeMask, network->nodeCapacity);
+	}
+	network->nodeCount = network->nodeCount > removedNodeCount ? network->nodeCount - removedNodeCount : 0;
+
+	if (outRemovedNodes) {
+		*outRemovedNodes = removedNodeCount;
+	}
+	if (outRemovedEdges) {
+		*outRemovedEdges = removedEdgeCount;
+	}
+	free(nodeMask);
+	free(edgeMask);
+	free(removedNodes);
+	free(removedEdges);
+	free(touchedMask);
+	free(touched);
 	return CXTrue;
+
+fail:
+	free(nodeMask);
+	free(edgeMask);
+	free(removedNodes);
+	free(removedEdges);
+	free(touchedMask);
+	free(touched);
+	return CXFalse;
 }
 
 /** Removes the referenced edges from the network. */
@@ -1771,12 +2751,25 @@ CXBool CXNetworkRemoveEdges(CXNetworkRef network, const CXIndex *indices, CXSize
 	if (!network || !indices || count == 0) {
 		return CXFalse;
 	}
+	if (!CXNetworkThaw(network)) {
+		return CXFalse;
+	}
+	CXNetworkEnsureEdgeSlots(network);
 	CXBool removedAny = CXFalse;
-	for (CXSize i = 0; i < count; i++) {
-		removedAny = CXNetworkDetachEdge(network, indices[i], CXTrue) || removedAny;
+	CXSize removedCount = 0;
+	if (count >= CX_NETWORK_REMOVAL_BATCH_MIN &&
+		CXNetworkRemoveBatch(network, NULL, 0, indices, count, NULL, &removedCount)) {
+		removedAny = removedCount > 0;
+	} else {
+		for (CXSize i = 0; i < count; i++) {
+			removedAny = CXNetworkDetachEdge(network, indices[i], CXTrue, CXIndexMAX) || removedAny;
+		}
 	}
 	if (removedAny) {
+		network->edgeValidRangeDirty = CXTrue;
+		CXNetworkMarkEdgesDirty(network);
 		CXNetworkBumpAttributeDictionaryVersions(network->edgeAttributes);
+		CXNetworkBumpTopologyVersion(network, CXFalse);
 	}
 	return CXTrue;
 }
@@ -2017,17 +3010,18 @@ static CXBool CXNetworkCollectConcentricNeighbors(
 	const CXBool collectOut = (direction == CXNeighborDirectionOut || direction == CXNeighborDirectionBoth);
 	const CXBool collectIn = (direction == CXNeighborDirectionIn || direction == CXNeighborDirectionBoth);
 
-	CXSize *distances = (CXSize *)malloc(sizeof(CXSize) * (size_t)network->nodeCapacity);
-	CXIndex *queue = (CXIndex *)calloc((size_t)network->nodeCapacity, sizeof(CXIndex));
-	CXIndex *nodeValues = (CXIndex *)calloc((size_t)network->nodeCapacity, sizeof(CXIndex));
-	if (!distances || !queue || !nodeValues) {
-		free(distances);
-		free(queue);
-		free(nodeValues);
+	CXNetworkSnapshotRef snapshot = CXNetworkSnapshotAcquire(network);
+	if (!snapshot) {
 		return CXFalse;
 	}
-	for (CXSize i = 0; i < network->nodeCapacity; i++) {
-		distances[i] = CXSizeMAX;
+	CXIndex *sources = (CXIndex *)malloc(sizeof(CXIndex) * (size_t)sourceCount);
+	CXIndex *nodeValues = (CXIndex *)malloc(sizeof(CXIndex) * (size_t)CXMAX(snapshot->nodeCount, (CXSize)1));
+	CXTraversalBFS bfs;
+	if (!sources || !nodeValues || !CXTraversalBFSInit(&bfs, snapshot, collectOut, collectIn, CXThreadPoolGetWorkerCount())) {
+		free(sources);
+		free(nodeValues);
+		CXNetworkSnapshotRelease(snapshot);
+		return CXFalse;
 	}
 
 	CXIndex *edgeValues = NULL;
@@ -2036,113 +3030,69 @@ static CXBool CXNetworkCollectConcentricNeighbors(
 		edgeValues = (CXIndex *)calloc((size_t)network->edgeCapacity, sizeof(CXIndex));
 		seenEdges = (uint8_t *)calloc((size_t)network->edgeCapacity, sizeof(uint8_t));
 		if (!edgeValues || !seenEdges) {
-			free(distances);
-			free(queue);
+			free(sources);
 			free(nodeValues);
 			free(edgeValues);
 			free(seenEdges);
+			CXTraversalBFSDestroy(&bfs);
+			CXNetworkSnapshotRelease(snapshot);
 			return CXFalse;
 		}
 	}
 
-	CXSize queueHead = 0;
-	CXSize queueTail = 0;
+	CXSize validSourceCount = 0;
 	for (CXSize i = 0; i < sourceCount; i++) {
 		CXIndex source = sourceNodes[i];
 		if (source >= network->nodeCapacity || !network->nodeActive[source]) {
 			continue;
 		}
-		if (distances[source] == CXSizeMAX) {
-			distances[source] = 0;
-			queue[queueTail++] = source;
-		}
+		sources[validSourceCount++] = snapshot->nodeToCompact[source];
 	}
+	CXSize reached = CXTraversalBFSRun(&bfs, sources, validSourceCount, level);
 
+	/* Nodes come out level by level; edges are the BFS-tree layers that lead
+	 * into the selected levels, in the order their tail nodes were reached. */
+	CXSize nodeCount = 0;
 	CXSize edgeCount = 0;
-	while (queueHead < queueTail) {
-		CXIndex node = queue[queueHead++];
-		CXSize distance = distances[node];
-		if (distance >= level) {
+	for (CXSize i = 0; i < reached; i++) {
+		CXIndex u = bfs.order[i];
+		CXSize distance = bfs.distances[u];
+		CXBool includeNode = upToLevel ? (distance <= level) : (distance == level);
+		if (includeNode && (includeSourceNodes || distance > 0)) {
+			nodeValues[nodeCount++] = snapshot->compactToNode[u];
+		}
+		if (!seenEdges || distance >= level) {
 			continue;
 		}
 		CXSize nextDistance = distance + 1;
-
-		if (collectOut) {
-			CXNeighborContainer *container = &network->nodes[node].outNeighbors;
-			CXNeighborIterator iterator;
-			CXNeighborIteratorInit(&iterator, container);
-			while (CXNeighborIteratorNext(&iterator)) {
-				CXIndex neighborNode = iterator.node;
-				CXIndex edgeIndex = iterator.edge;
-				if (neighborNode >= network->nodeCapacity || !network->nodeActive[neighborNode]) {
-					continue;
-				}
-				if (edgeIndex >= network->edgeCapacity || !network->edgeActive[edgeIndex]) {
-					continue;
-				}
-				if (distances[neighborNode] == CXSizeMAX) {
-					distances[neighborNode] = nextDistance;
-					queue[queueTail++] = neighborNode;
-				}
-				if (outEdgeSelector && seenEdges && distances[neighborNode] == nextDistance) {
-					CXBool includeEdge = upToLevel ? (nextDistance <= level) : (nextDistance == level);
-					if (includeEdge && !seenEdges[edgeIndex]) {
-						seenEdges[edgeIndex] = 1;
-						edgeValues[edgeCount++] = edgeIndex;
-					}
-				}
-			}
+		if (!upToLevel && nextDistance != level) {
+			continue;
 		}
-
-		if (collectIn) {
-			CXNeighborContainer *container = &network->nodes[node].inNeighbors;
-			CXNeighborIterator iterator;
-			CXNeighborIteratorInit(&iterator, container);
-			while (CXNeighborIteratorNext(&iterator)) {
-				CXIndex neighborNode = iterator.node;
-				CXIndex edgeIndex = iterator.edge;
-				if (neighborNode >= network->nodeCapacity || !network->nodeActive[neighborNode]) {
-					continue;
-				}
-				if (edgeIndex >= network->edgeCapacity || !network->edgeActive[edgeIndex]) {
-					continue;
-				}
-				if (distances[neighborNode] == CXSizeMAX) {
-					distances[neighborNode] = nextDistance;
-					queue[queueTail++] = neighborNode;
-				}
-				if (outEdgeSelector && seenEdges && distances[neighborNode] == nextDistance) {
-					CXBool includeEdge = upToLevel ? (nextDistance <= level) : (nextDistance == level);
-					if (includeEdge && !seenEdges[edgeIndex]) {
-						seenEdges[edgeIndex] = 1;
-						edgeValues[edgeCount++] = edgeIndex;
-					}
+		for (int pass = 0; pass < 2; pass++) {
+			if ((pass == 0 && !collectOut) || (pass == 1 && !collectIn)) {
+				continue;
+			}
+			const CXIndex *offsets = pass == 0 ? snapshot->outOffsets : snapshot->inOffsets;
+			const CXIndex *neighbors = pass == 0 ? snapshot->outNeighbors : snapshot->inNeighbors;
+			const CXIndex *edges = pass == 0 ? snapshot->outEdges : snapshot->inEdges;
+			for (CXIndex idx = offsets[u]; idx < offsets[u + 1]; idx++) {
+				CXIndex edgeIndex = edges[idx];
+				if (bfs.distances[neighbors[idx]] == nextDistance && !seenEdges[edgeIndex]) {
+					seenEdges[edgeIndex] = 1;
+					edgeValues[edgeCount++] = edgeIndex;
 				}
 			}
 		}
 	}
 
-	CXSize nodeCount = 0;
-	for (CXSize i = 0; i < queueTail; i++) {
-		CXIndex node = queue[i];
-		CXSize distance = distances[node];
-		CXBool includeNode = upToLevel ? (distance <= level) : (distance == level);
-		if (!includeNode) {
-			continue;
-		}
-		if (!includeSourceNodes && distance == 0) {
-			continue;
-		}
-		nodeValues[nodeCount++] = node;
-	}
-
 	CXBool ok = CXNodeSelectorFillMaybeEmpty(outNodeSelector, nodeValues, nodeCount);
 	if (ok && outEdgeSelector) {
 		ok = CXEdgeSelectorFillMaybeEmpty(outEdgeSelector, edgeValues, edgeCount);
 	}
 
-	free(distances);
-	free(queue);
+	CXTraversalBFSDestroy(&bfs);
+	CXNetworkSnapshotRelease(snapshot);
+	free(sources);
 	free(nodeValues);
 	free(edgeValues);
 	free(seenEdges);
@@ -3335,6 +4285,9 @@ CXBool CXNetworkCompact(CXNetworkRef network, const CXString nodeOriginalIndexAt
 	if (!network) {
 		return CXFalse;
 	}
+	if (!CXNetworkThaw(network)) {
+		return CXFalse;
+	}
 
 	CXSize nodeCount = network->nodeCount;
 	CXSize edgeCount = network->edgeCount;
@@ -3371,6 +4324,13 @@ CXBool CXNetworkCompact(CXNetworkRef network, const CXString nodeOriginalIndexAt
 		newAttr->usesJavascriptShadow = attr->usesJavascriptShadow;
 		newAttr->categoricalDictionary = attr->categoricalDictionary;
 		attr->categoricalDictionary = NULL;
+		if (attr->index) {
+			/* Rows are renumbered, so the copy is rebuilt on first use. */
+			newAttr->index = CXAttributeIndexCreate(CXAttributeScopeNode);
+			if (!newAttr->index) {
+				goto fail;
+			}
+		}
 	}
 
 	CXStringDictionaryFOR(edgeEntry, network->edgeAttributes) {
@@ -3389,6 +4349,12 @@ CXBool CXNetworkCompact(CXNetworkRef network, const CXString nodeOriginalIndexAt
 		newAttr->usesJavascriptShadow = attr->usesJavascriptShadow;
 		newAttr->categoricalDictionary = attr->categoricalDictionary;
 		attr->categoricalDictionary = NULL;
+		if (attr->index) {
+			newAttr->index = CXAttributeIndexCreate(CXAttributeScopeEdge);
+			if (!newAttr->index) {
+				goto fail;
+			}
+		}
 	}
 
 	CXStringDictionaryFOR(netEntry, network->networkAttributes) {
@@ -3724,6 +4690,9 @@ CXBool CXNetworkCompact(CXNetworkRef network, const CXString nodeOriginalIndexAt
 		compact->promotionScratch = NULL;
 		compact->promotionScratchCapacity = 0;
 
+	CXNetworkSnapshotInvalidate(network);
+	CXNetworkDropEdgeSlots(network);
+	compact->fastEdgeRemoval = network->fastEdgeRemoval;
 	CXNetwork temp = *network;
 	*network = *compact;
 	compact->nodes = temp.nodes;
@@ -3884,7 +4853,9 @@ static CXBool CXSelectorFillFromArrayInternal(CXSelector *selector, const CXInde
 	if (!CXSelectorEnsureCapacity(selector, count)) {
 		return CXFalse;
 	}
-	memcpy(selector->indices, indices, sizeof(CXIndex) * count);
+	if (count > 0) {
+		memcpy(selector->indices, indices, sizeof(CXIndex) * count);
+	}
 	selector->count = count;
 	return CXTrue;
 }
@@ -5,6 +5,7 @@
 #include "CXDictionary.h"
 
 #include "htslib/bgzf.h"
+#include "htslib/hfile.h"
 
 
 #include <errno.h>
@@ -14,13 +15,27 @@
 #include <string.h>
 #include <zlib.h>
 
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #define CX_NETWORK_MAGIC_BYTES "ZXNETFMT"
 #define CX_NETWORK_FOOTER_MAGIC_BYTES "ZXFOOTER"
+/** Number of edge records decoded per read from an input stream. */
+#define CX_EDGE_DECODE_BATCH 256
+
+/* BGZF worker threads attached to ZXNet handles; 0 follows the thread pool. */
+static CXSize CXZXNetThreadCount = 1;
 
 enum {
 	CX_NETWORK_SERIAL_VERSION_MAJOR = 1,
 	CX_NETWORK_SERIAL_VERSION_MINOR = 0,
-	CX_NETWORK_SERIAL_VERSION_PATCH = 0
+	CX_NETWORK_SERIAL_VERSION_PATCH = 0,
+	/* Minor version written when the optional ADJC chunk is present. */
+	CX_NETWORK_SERIAL_VERSION_MINOR_ADJACENCY = 1
 };
 
 enum {
@@ -109,6 +124,13 @@ static uint64_t cx_read_u64le(const uint8_t *src) {
 		((uint64_t)src[7] << 56);
 }
 
+static CXBool CXHostIsLittleEndian(void) {
+	const uint16_t probe = 1;
+	uint8_t first = 0;
+	memcpy(&first, &probe, 1);
+	return first == 1 ? CXTrue : CXFalse;
+}
+
 static void cx_write_u16le(uint16_t value, uint8_t *dst) {
 	dst[0] = (uint8_t)(value & 0xFF);
 	dst[1] = (uint8_t)((value >> 8) & 0xFF);
@@ -127,12 +149,26 @@ static void cx_write_u64le(uint64_t value, uint8_t *dst) {
 	}
 }
 
+static uint32_t CXChecksumUpdate(uint32_t crc, const uint8_t *data, size_t length) {
+	while (length > 0) {
+		uInt chunk = length > (size_t)(1u << 30) ? (uInt)(1u << 30) : (uInt)length;
+		crc = (uint32_t)crc32(crc, data, chunk);
+		data += chunk;
+		length -= chunk;
+	}
+	return crc;
+}
+
 typedef struct {
 	void *context;
 	ssize_t (*read)(void *ctx, void *buffer, size_t length);
 	int64_t (*tell)(void *ctx);
 	CXBool (*seek)(void *ctx, int64_t offset, int whence);
 	uint32_t *crc;
+	/* Optional: checksum of every byte consumed so far, replacing incremental `crc` updates. */
+	uint32_t (*checksum)(void *ctx);
+	/* Optional: advances past `length` bytes without decoding them. */
+	CXBool (*skip)(void *ctx, uint64_t length);
 } CXInputStream;
 
 static CXBool CXReadExact(CXInputStream *stream, void *buffer, size_t length);
@@ -212,6 +248,11 @@ static int64_t CXBGZFTell(void *ctx) {
 	if (!bgzf) {
 		return -1;
 	}
+	/* Threaded writers only learn block addresses once queued blocks are
+	 * compressed, so settle them before reporting a chunk offset. */
+	if (bgzf->mt && bgzf->is_write && bgzf_flush(bgzf) != 0) {
+		return -1;
+	}
 	int64_t position = bgzf_tell(bgzf);
 	return position >= 0 ? position : -1;
 }
@@ -229,7 +270,7 @@ static CXBool CXOutputStreamWrite(CXOutputStream *stream, const void *data, size
 		return CXFalse;
 	}
 	if (stream->crc) {
-		*stream->crc = (uint32_t)crc32(*stream->crc, (const unsigned char *)data, (uInt)length);
+		*stream->crc = CXChecksumUpdate(*stream->crc, (const uint8_t *)data, length);
 	}
 	return CXTrue;
 }
@@ -712,6 +753,10 @@ static CXBool CXFileSeek(void *ctx, int64_t offset, int whence) {
 #endif
 }
 
+static CXBool CXFileSkip(void *ctx, uint64_t length) {
+	return length <= (uint64_t)INT64_MAX && CXFileSeek(ctx, (int64_t)length, SEEK_CUR);
+}
+
 static ssize_t CXBGZFRead(void *ctx, void *buffer, size_t length) {
 	BGZF *bgzf = (BGZF *)ctx;
 	if (!bgzf) {
@@ -728,6 +773,124 @@ static CXBool CXBGZFSeek(void *ctx, int64_t offset, int whence) {
 	return bgzf_seek(bgzf, offset, whence) >= 0 ? CXTrue : CXFalse;
 }
 
+/* Reads and drops `length` bytes of decompressed data. */
+static CXBool CXBGZFDiscard(BGZF *bgzf, uint64_t length) {
+	uint8_t scratch[4096];
+	while (length > 0) {
+		size_t chunk = length > sizeof(scratch) ? sizeof(scratch) : (size_t)length;
+		if (bgzf_read(bgzf, scratch, chunk) != (ssize_t)chunk) {
+			return CXFalse;
+		}
+		length -= chunk;
+	}
+	return CXTrue;
+}
+
+/*
+ * Skips decompressed bytes by walking BGZF block headers: each block records
+ * its compressed size (BSIZE) and its uncompressed size (ISIZE, in the last
+ * four bytes), so whole blocks are passed over without being inflated. Only
+ * the block the skip ends in is decompressed, by the next read. Threaded
+ * handles read ahead on their own and fall back to discarding.
+ */
+static CXBool CXBGZFSkip(void *ctx, uint64_t length) {
+	BGZF *bgzf = (BGZF *)ctx;
+	if (!bgzf) {
+		return CXFalse;
+	}
+	if (bgzf->mt || bgzf->is_gzip || !bgzf->is_compressed) {
+		return CXBGZFDiscard(bgzf, length);
+	}
+	int available = bgzf->block_length - bgzf->block_offset;
+	if (available > 0) {
+		uint64_t inBlock = CXMIN(length, (uint64_t)available);
+		if (!CXBGZFDiscard(bgzf, inBlock)) {
+			return CXFalse;
+		}
+		length -= inBlock;
+	}
+	if (length == 0) {
+		return CXTrue;
+	}
+
+	/* The current block is used up, so the file sits at the next block. */
+	off_t address = htell(bgzf->fp);
+	for (;;) {
+		uint8_t header[18];
+		uint8_t trailer[4];
+		if (hseek(bgzf->fp, address, SEEK_SET) < 0 || hread(bgzf->fp, header, sizeof(header)) != (ssize_t)sizeof(header)) {
+			return CXFalse;
+		}
+		if (header[0] != 31 || header[1] != 139 || header[2] != 8 || !(header[3] & 4) ||
+			header[12] != 'B' || header[13] != 'C') {
+			errno = EINVAL;
+			return CXFalse;
+		}
+		off_t blockSize = (off_t)cx_read_u16le(header + 16) + 1;
+		if (blockSize < (off_t)(sizeof(header) + sizeof(trailer)) ||
+			hseek(bgzf->fp, address + blockSize - (off_t)sizeof(trailer), SEEK_SET) < 0 ||
+			hread(bgzf->fp, trailer, sizeof(trailer)) != (ssize_t)sizeof(trailer)) {
+			errno = EINVAL;
+			return CXFalse;
+		}
+		uint64_t blockLength = cx_read_u32le(trailer);
+		if (length < blockLength) {
+			break;
+		}
+		length -= blockLength;
+		address += blockSize;
+		if (length == 0) {
+			break;
+		}
+	}
+	return bgzf_seek(bgzf, ((int64_t)address << 16) | (int64_t)length, SEEK_SET) >= 0 ? CXTrue : CXFalse;
+}
+
+typedef struct {
+	const uint8_t *data;
+	size_t length;
+	size_t position;
+} CXMemoryInput;
+
+static ssize_t CXMemoryRead(void *ctx, void *buffer, size_t length) {
+	CXMemoryInput *input = (CXMemoryInput *)ctx;
+	if (!input) {
+		return -1;
+	}
+	size_t available = input->length - input->position;
+	size_t count = length < available ? length : available;
+	if (count > (SIZE_MAX >> 1)) {
+		count = SIZE_MAX >> 1;
+	}
+	memcpy(buffer, input->data + input->position, count);
+	input->position += count;
+	return (ssize_t)count;
+}
+
+static int64_t CXMemoryTell(void *ctx) {
+	CXMemoryInput *input = (CXMemoryInput *)ctx;
+	return input ? (int64_t)input->position : -1;
+}
+
+static CXBool CXMemorySeek(void *ctx, int64_t offset, int whence) {
+	CXMemoryInput *input = (CXMemoryInput *)ctx;
+	if (!input) {
+		return CXFalse;
+	}
+	int64_t base = whence == SEEK_SET ? 0 : (whence == SEEK_CUR ? (int64_t)input->position : (int64_t)input->length);
+	if ((offset < 0 && -offset > base) || (uint64_t)(base + offset) > (uint64_t)input->length) {
+		return CXFalse;
+	}
+	input->position = (size_t)(base + offset);
+	return CXTrue;
+}
+
+/** One crc32 pass over the consumed prefix instead of one update per read. */
+static uint32_t CXMemoryChecksum(void *ctx) {
+	CXMemoryInput *input = (CXMemoryInput *)ctx;
+	return CXChecksumUpdate((uint32_t)crc32(0L, Z_NULL, 0), input->data, input->position);
+}
+
 static CXBool CXReadExact(CXInputStream *stream, void *buffer, size_t length) {
 	if (!stream || !stream->read) {
 		return CXFalse;
@@ -740,7 +903,7 @@ static CXBool CXReadExact(CXInputStream *stream, void *buffer, size_t length) {
 			return CXFalse;
 		}
 		if (stream->crc) {
-			*stream->crc = (uint32_t)crc32(*stream->crc, cursor, (uInt)bytesRead);
+			*stream->crc = CXChecksumUpdate(*stream->crc, cursor, (size_t)bytesRead);
 		}
 		cursor += bytesRead;
 		remaining -= (size_t)bytesRead;
@@ -749,6 +912,10 @@ static CXBool CXReadExact(CXInputStream *stream, void *buffer, size_t length) {
 }
 
 static CXBool CXSkipExact(CXInputStream *stream, uint64_t length) {
+	// Skipped bytes never reach an incremental checksum.
+	if (stream->skip && !stream->crc) {
+		return stream->skip(stream->context, length);
+	}
 	uint8_t scratch[1024];
 	while (length > 0) {
 		size_t chunk = length > sizeof(scratch) ? sizeof(scratch) : (size_t)length;
@@ -812,7 +979,7 @@ static CXBool CXReadHeaderBlock(CXInputStream *stream, CXParsedHeader *outHeader
 	uint16_t versionMajor = cx_read_u16le(buffer + 8);
 	uint16_t versionMinor = cx_read_u16le(buffer + 10);
 	uint32_t versionPatch = cx_read_u32le(buffer + 12);
-	if (versionMajor != CX_NETWORK_SERIAL_VERSION_MAJOR || versionMinor != CX_NETWORK_SERIAL_VERSION_MINOR || versionPatch != CX_NETWORK_SERIAL_VERSION_PATCH) {
+	if (versionMajor != CX_NETWORK_SERIAL_VERSION_MAJOR || versionMinor > CX_NETWORK_SERIAL_VERSION_MINOR_ADJACENCY || versionPatch != CX_NETWORK_SERIAL_VERSION_PATCH) {
 		errno = ENOTSUP;
 		return CXFalse;
 	}
@@ -928,21 +1095,154 @@ static CXBool CXReadEdgeChunk(CXInputStream *stream, uint64_t payloadSize, CXNet
 		return CXFalse;
 	}
 
-	for (CXSize idx = 0; idx < network->edgeCapacity; idx++) {
-		uint8_t buffer[16];
-		if (!CXReadExact(stream, buffer, sizeof(buffer))) {
+	uint8_t buffer[CX_EDGE_DECODE_BATCH * 16];
+	for (CXSize base = 0; base < network->edgeCapacity; base += CX_EDGE_DECODE_BATCH) {
+		CXSize count = CXMIN((CXSize)CX_EDGE_DECODE_BATCH, network->edgeCapacity - base);
+		if (!CXReadExact(stream, buffer, (size_t)count * 16u)) {
 			return CXFalse;
 		}
-		uint64_t from = cx_read_u64le(buffer + 0);
-		uint64_t to = cx_read_u64le(buffer + 8);
-		if (from > (uint64_t)CXIndexMAX || to > (uint64_t)CXIndexMAX) {
-			errno = ERANGE;
+		for (CXSize offset = 0; offset < count; offset++) {
+			uint64_t from = cx_read_u64le(buffer + offset * 16u);
+			uint64_t to = cx_read_u64le(buffer + offset * 16u + 8u);
+			if (from > (uint64_t)CXIndexMAX || to > (uint64_t)CXIndexMAX) {
+				errno = ERANGE;
+				return CXFalse;
+			}
+			network->edges[base + offset].from = (CXUInteger)from;
+			network->edges[base + offset].to = (CXUInteger)to;
+		}
+	}
+	return CXTrue;
+}
+
+/** Reads `count` little-endian u64 values, each at most `maxValue`. */
+static CXBool CXReadIndexArray(CXInputStream *stream, CXIndex *destination, CXSize count, uint64_t maxValue) {
+	uint8_t buffer[CX_EDGE_DECODE_BATCH * 16];
+	const CXSize batch = sizeof(buffer) / 8u;
+	for (CXSize base = 0; base < count; base += batch) {
+		CXSize chunk = CXMIN(batch, count - base);
+		if (!CXReadExact(stream, buffer, (size_t)chunk * 8u)) {
 			return CXFalse;
 		}
-		network->edges[idx].from = (CXUInteger)from;
-		network->edges[idx].to = (CXUInteger)to;
+		for (CXSize offset = 0; offset < chunk; offset++) {
+			uint64_t value = cx_read_u64le(buffer + offset * 8u);
+			if (value > maxValue) {
+				errno = EINVAL;
+				return CXFalse;
+			}
+			destination[base + offset] = (CXIndex)value;
+		}
+	}
+	return CXTrue;
+}
+
+/**
+ * Reads the ADJC chunk into a frozen adjacency block (neighbour ids followed
+ * by edge ids) plus its list offsets, and checks every entry against the EDGE
+ * chunk already loaded into `network`.
+ */
+static CXBool CXReadAdjacencyChunk(CXInputStream *stream, uint64_t payloadSize, CXNetworkRef network, CXIndex **outBlock, CXIndex **outOffsets) {
+	if (!stream || !network || !outBlock || !outOffsets) {
+		return CXFalse;
+	}
+	CXSize listCount = network->nodeCapacity * 2;
+	uint64_t offsetBytes = ((uint64_t)listCount + 1u) * 8u;
+	uint64_t blockSize = 0;
+	if (!CXReadSizedBlockLength(stream, &blockSize)) {
+		return CXFalse;
+	}
+	if (blockSize != offsetBytes || payloadSize < CXSizedBlockLength(offsetBytes) + 2u * CXSizedBlockLength(0)) {
+		errno = EINVAL;
+		return CXFalse;
+	}
+	uint64_t entryBytes = (payloadSize - CXSizedBlockLength(offsetBytes) - 2u * CXSizedBlockLength(0)) / 2u;
+	uint64_t expectedEntries = (uint64_t)network->edgeCount * (network->isDirected ? 2u : 4u);
+	if (entryBytes != expectedEntries * 8u ||
+		payloadSize != CXSizedBlockLength(offsetBytes) + 2u * CXSizedBlockLength(entryBytes)) {
+		errno = EINVAL;
+		return CXFalse;
+	}
+	CXSize total = (CXSize)expectedEntries;
+
+	CXIndex *offsets = malloc(((size_t)listCount + 1u) * sizeof(CXIndex));
+	CXIndex *block = malloc(CXMAX(total * 2, (CXSize)1) * sizeof(CXIndex));
+	uint8_t *seen = calloc(CXMAX(network->edgeCapacity, (CXSize)1), sizeof(uint8_t));
+	if (!offsets || !block || !seen) {
+		errno = ENOMEM;
+		goto fail;
+	}
+	if (!CXReadIndexArray(stream, offsets, listCount + 1, (uint64_t)total)) {
+		goto fail;
+	}
+	if (offsets[0] != 0 || offsets[listCount] != total) {
+		errno = EINVAL;
+		goto fail;
+	}
+	for (CXSize list = 0; list < listCount; list++) {
+		if (offsets[list + 1] < offsets[list]) {
+			errno = EINVAL;
+			goto fail;
+		}
+	}
+
+	if (!CXReadSizedBlockLength(stream, &blockSize) || blockSize != entryBytes) {
+		errno = EINVAL;
+		goto fail;
+	}
+	if (total > 0 && !CXReadIndexArray(stream, block, total, (uint64_t)network->nodeCapacity - 1u)) {
+		goto fail;
 	}
+	if (!CXReadSizedBlockLength(stream, &blockSize) || blockSize != entryBytes) {
+		errno = EINVAL;
+		goto fail;
+	}
+	if (total > 0 && !CXReadIndexArray(stream, block + total, total, (uint64_t)network->edgeCapacity - 1u)) {
+		goto fail;
+	}
+
+	/* Each entry must sit on one of its edge's endpoints. `seen` keeps one bit
+	 * per (list kind, endpoint) so no edge is listed twice in the same place;
+	 * with the entry count fixed above, every active edge is then covered. */
+	for (CXSize list = 0; list < listCount; list++) {
+		CXIndex node = (CXIndex)(list / 2);
+		CXBool inbound = (list % 2) ? CXTrue : CXFalse;
+		for (CXIndex entry = offsets[list]; entry < offsets[list + 1]; entry++) {
+			CXIndex neighbor = block[entry];
+			CXIndex edge = block[total + entry];
+			if (!network->edgeActive[edge]) {
+				errno = EINVAL;
+				goto fail;
+			}
+			CXEdge record = network->edges[edge];
+			CXBool forward = record.from == node && record.to == neighbor;
+			CXBool backward = record.from == neighbor && record.to == node;
+			uint8_t bit = 0;
+			if (network->isDirected) {
+				bit = (inbound ? backward : forward) ? (inbound ? 0x4u : 0x1u) : 0u;
+			} else if (forward || backward) {
+				uint8_t base = inbound ? 0x4u : 0x1u;
+				bit = (forward && !(seen[edge] & base)) ? base : (uint8_t)(base << 1);
+				if (!backward && bit != base) {
+					bit = 0;
+				}
+			}
+			if (!bit || (seen[edge] & bit)) {
+				errno = EINVAL;
+				goto fail;
+			}
+			seen[edge] |= bit;
+		}
+	}
+	free(seen);
+	*outBlock = block;
+	*outOffsets = offsets;
 	return CXTrue;
+
+fail:
+	free(offsets);
+	free(block);
+	free(seen);
+	return CXFalse;
 }
 
 static CXAttributeRef CXDefineAttributeForScope(
@@ -999,7 +1299,7 @@ static uint64_t CXExpectedAttributeCapacity(CXNetworkRef network, CXAttributeSco
 	}
 }
 
-static CXBool CXReadAttributeDefinitionsChunk(CXInputStream *stream, uint64_t payloadSize, CXNetworkRef network, CXAttributeScope scope, CXAttributeLoadList *outList) {
+static CXBool CXReadAttributeDefinitionsChunk(CXInputStream *stream, uint64_t payloadSize, CXNetworkRef network, CXAttributeScope scope, const CXAttributeNameFilter *filter, CXAttributeLoadList *outList) {
 	if (!stream || !network || !outList) {
 		return CXFalse;
 	}
@@ -1100,16 +1400,21 @@ static CXBool CXReadAttributeDefinitionsChunk(CXInputStream *stream, uint64_t pa
 		}
 
 		CXBool hasWeights = (flags & CX_ATTR_FLAG_HAS_MULTICATEGORY_WEIGHTS) ? CXTrue : CXFalse;
-		CXAttributeRef attribute = CXDefineAttributeForScope(network, scope, name, type, dimension, hasWeights);
-		if (!attribute) {
-			free(name);
-			return CXFalse;
-		}
-		if (dictionarySize > 0) {
-			if (!CXReadAttributeDictionary(stream, dictionarySize, attribute)) {
+		CXAttributeRef attribute = NULL;
+		if (CXAttributeListShouldInclude(name, filter)) {
+			attribute = CXDefineAttributeForScope(network, scope, name, type, dimension, hasWeights);
+			if (!attribute) {
+				free(name);
+				return CXFalse;
+			}
+			if (dictionarySize > 0 && !CXReadAttributeDictionary(stream, dictionarySize, attribute)) {
 				free(name);
 				return CXFalse;
 			}
+		} else if (!CXSkipExact(stream, dictionarySize)) {
+			// Filtered out: keep the entry (attribute NULL) so its values are skipped too.
+			free(name);
+			return CXFalse;
 		}
 		if (!CXAttributeLoadListReserve(outList, outList->count + 1)) {
 			free(name);
@@ -1315,6 +1620,12 @@ static CXBool CXReadAttributeValuesIntoPlan(CXInputStream *stream, CXAttributeLo
 		return CXFalse;
 	}
 
+	// Columns stored exactly as they are laid out in memory are read in one piece.
+	if (CXHostIsLittleEndian() && plan->attribute->elementSize == plan->storageWidth &&
+		plan->attribute->stride == (CXSize)(plan->storageWidth * dimension) && expectedBytes <= SIZE_MAX) {
+		return expectedBytes == 0 || CXReadExact(stream, destination, (size_t)expectedBytes) ? CXTrue : CXFalse;
+	}
+
 	for (uint64_t idx = 0; idx < capacity; idx++) {
 		uint8_t *entryBase = destination + (size_t)idx * plan->attribute->stride;
 		for (uint64_t dim = 0; dim < dimension; dim++) {
@@ -1432,7 +1743,11 @@ static CXBool CXReadAttributeValuesChunk(CXInputStream *stream, uint64_t payload
 			return CXFalse;
 		}
 
-		if (!CXReadAttributeValuesIntoPlan(stream, entry, valueSize)) {
+		if (!entry->attribute) {
+			if (!CXSkipExact(stream, valueSize)) {
+				return CXFalse;
+			}
+		} else if (!CXReadAttributeValuesIntoPlan(stream, entry, valueSize)) {
 			return CXFalse;
 		}
 
@@ -1485,30 +1800,7 @@ static CXBool CXRebuildIndexManager(CXIndexManagerRef manager, const CXBool *act
 	return CXTrue;
 }
 
-static CXBool CXRebuildAdjacency(CXNetworkRef network) {
-	if (!network) {
-		return CXFalse;
-	}
-	for (CXSize idx = 0; idx < network->edgeCapacity; idx++) {
-		if (!network->edgeActive[idx]) {
-			continue;
-		}
-		CXEdge edge = network->edges[idx];
-		if ((CXSize)edge.from >= network->nodeCapacity || (CXSize)edge.to >= network->nodeCapacity) {
-			errno = EINVAL;
-			return CXFalse;
-		}
-		if (!CXNeighborContainerAdd(&network->nodes[edge.from].outNeighbors, edge.to, (CXIndex)idx)) {
-			return CXFalse;
-		}
-		if (!CXNeighborContainerAdd(&network->nodes[edge.to].inNeighbors, edge.from, (CXIndex)idx)) {
-			return CXFalse;
-		}
-	}
-	return CXTrue;
-}
-
-static CXBool CXReadFooter(CXInputStream *stream, const CXMetaChunkPayload *meta, uint32_t expectedChecksum) {
+static CXBool CXReadFooter(CXInputStream *stream, const CXMetaChunkPayload *meta, CXBool verifyChecksum, uint32_t expectedChecksum) {
 	if (!stream || !meta) {
 		return CXFalse;
 	}
@@ -1540,7 +1832,7 @@ static CXBool CXReadFooter(CXInputStream *stream, const CXMetaChunkPayload *meta
 		return CXFalse;
 	}
 
-	if (checksum != expectedChecksum) {
+	if (verifyChecksum && checksum != expectedChecksum) {
 		errno = EIO;
 		return CXFalse;
 	}
@@ -2252,14 +2544,106 @@ static CXBool CXWriteEdgeChunk(CXOutputStream *stream, CXWrittenChunkList *chunk
 	return CXTrue;
 }
 
-static CXBool CXWriteHeader(CXOutputStream *stream, CXNetworkRef network, CXNetworkStorageCodec codec) {
+typedef struct {
+	CXNetworkRef network;
+	CXBool writeEdges;
+} CXAdjacencyWriterContext;
+
+static CXNeighborContainer* CXAdjacencyListContainer(CXNetworkRef network, CXSize list) {
+	CXNodeRecord *record = &network->nodes[list / 2];
+	return (list % 2) ? &record->inNeighbors : &record->outNeighbors;
+}
+
+static CXBool CXWriteAdjacencyOffsetsCallback(CXSizedWriterContext *context, void *userData) {
+	CXAdjacencyWriterContext *adjacencyCtx = (CXAdjacencyWriterContext *)userData;
+	CXNetworkRef network = adjacencyCtx->network;
+	uint8_t scratch[4096];
+	size_t scratchOffset = 0;
+	uint64_t offset = 0;
+	CXSize listCount = network->nodeCapacity * 2;
+	for (CXSize list = 0; list <= listCount; list++) {
+		if (scratchOffset + 8 > sizeof(scratch)) {
+			if (!CXSizedWriteBytes(context, scratch, scratchOffset)) {
+				return CXFalse;
+			}
+			scratchOffset = 0;
+		}
+		cx_write_u64le(offset, scratch + scratchOffset);
+		scratchOffset += 8;
+		if (list < listCount) {
+			offset += (uint64_t)CXNeighborContainerCount(CXAdjacencyListContainer(network, list));
+		}
+	}
+	return scratchOffset == 0 || CXSizedWriteBytes(context, scratch, scratchOffset);
+}
+
+static CXBool CXWriteAdjacencyEntriesCallback(CXSizedWriterContext *context, void *userData) {
+	CXAdjacencyWriterContext *adjacencyCtx = (CXAdjacencyWriterContext *)userData;
+	CXNetworkRef network = adjacencyCtx->network;
+	uint8_t scratch[4096];
+	size_t scratchOffset = 0;
+	CXSize listCount = network->nodeCapacity * 2;
+	for (CXSize list = 0; list < listCount; list++) {
+		CXNeighborFOR(neighbor, edge, CXAdjacencyListContainer(network, list)) {
+			if (scratchOffset + 8 > sizeof(scratch)) {
+				if (!CXSizedWriteBytes(context, scratch, scratchOffset)) {
+					return CXFalse;
+				}
+				scratchOffset = 0;
+			}
+			cx_write_u64le((uint64_t)(adjacencyCtx->writeEdges ? edge : neighbor), scratch + scratchOffset);
+			scratchOffset += 8;
+		}
+	}
+	return scratchOffset == 0 || CXSizedWriteBytes(context, scratch, scratchOffset);
+}
+
+/**
+ * Writes the ADJC chunk: CSR offsets over the 2 * nodeCapacity neighbour lists
+ * (out list of node u at 2u, in list at 2u + 1), then every neighbour id, then
+ * every edge id, in the order the containers hold them.
+ */
+static CXBool CXWriteAdjacencyChunk(CXOutputStream *stream, CXWrittenChunkList *chunks, CXNetworkRef network) {
+	if (!stream || !network) {
+		return CXFalse;
+	}
+	uint64_t entryCount = 0;
+	for (CXSize list = 0; list < network->nodeCapacity * 2; list++) {
+		entryCount += (uint64_t)CXNeighborContainerCount(CXAdjacencyListContainer(network, list));
+	}
+	uint64_t offsetBytes = ((uint64_t)network->nodeCapacity * 2u + 1u) * 8u;
+	uint64_t entryBytes = entryCount * 8u;
+	uint64_t chunkPayload = CXSizedBlockLength(offsetBytes) + 2u * CXSizedBlockLength(entryBytes);
+
+	int64_t chunkOffset = stream->tell(stream->context);
+	if (chunkOffset < 0) {
+		return CXFalse;
+	}
+	if (!CXWriteChunkHeader(stream, CX_NETWORK_CHUNK_ADJACENCY, 0, chunkPayload)) {
+		return CXFalse;
+	}
+	CXAdjacencyWriterContext ctx = { network, CXFalse };
+	if (!CXWriteSizedPayload(stream, offsetBytes, CXWriteAdjacencyOffsetsCallback, &ctx)) {
+		return CXFalse;
+	}
+	if (!CXWriteSizedPayload(stream, entryBytes, CXWriteAdjacencyEntriesCallback, &ctx)) {
+		return CXFalse;
+	}
+	ctx.writeEdges = CXTrue;
+	if (!CXWriteSizedPayload(stream, entryBytes, CXWriteAdjacencyEntriesCallback, &ctx)) {
+		return CXFalse;
+	}
+	return CXWrittenChunkListAppend(chunks, CX_NETWORK_CHUNK_ADJACENCY, 0, (uint64_t)chunkOffset, chunkPayload);
+}
+
+static CXBool CXWriteHeader(CXOutputStream *stream, CXNetworkRef network, CXNetworkStorageCodec codec, uint16_t versionMinor) {
 	if (!stream || !network) {
 		return CXFalse;
 	}
 	uint8_t header[CX_NETWORK_FILE_HEADER_SIZE] = {0};
 	memcpy(header, CX_NETWORK_MAGIC_BYTES, sizeof(CX_NETWORK_MAGIC_BYTES) - 1);
 	cx_write_u16le(CX_NETWORK_SERIAL_VERSION_MAJOR, header + 8);
-	cx_write_u16le(CX_NETWORK_SERIAL_VERSION_MINOR, header + 10);
+	cx_write_u16le(versionMinor, header + 10);
 	cx_write_u32le(CX_NETWORK_SERIAL_VERSION_PATCH, header + 12);
 	cx_write_u32le((uint32_t)codec, header + 16);
 
@@ -2318,7 +2702,7 @@ static CXBool CXWriteFooter(CXOutputStream *stream, const CXWrittenChunkList *ch
 	return CXOutputStreamWrite(stream, footer, sizeof(footer));
 }
 
-static CXBool CXNetworkSerialize(CXNetworkRef network, CXOutputStream *stream, CXNetworkStorageCodec codec, const CXAttributeFilterSet *filters) {
+static CXBool CXNetworkSerialize(CXNetworkRef network, CXOutputStream *stream, CXNetworkStorageCodec codec, const CXAttributeFilterSet *filters, CXBool includeAdjacency) {
 	if (!network || !stream) {
 		return CXFalse;
 	}
@@ -2384,7 +2768,8 @@ static CXBool CXNetworkSerialize(CXNetworkRef network, CXOutputStream *stream, C
 		.networkAttributeCount = (uint64_t)networkAttributes.count
 	};
 
-	if (!CXWriteHeader(stream, network, codec)) {
+	uint16_t versionMinor = includeAdjacency ? CX_NETWORK_SERIAL_VERSION_MINOR_ADJACENCY : CX_NETWORK_SERIAL_VERSION_MINOR;
+	if (!CXWriteHeader(stream, network, codec, versionMinor)) {
 		goto cleanup;
 	}
 
@@ -2397,6 +2782,9 @@ static CXBool CXNetworkSerialize(CXNetworkRef network, CXOutputStream *stream, C
 	if (!CXWriteEdgeChunk(stream, &chunkList, network)) {
 		goto cleanup;
 	}
+	if (includeAdjacency && !CXWriteAdjacencyChunk(stream, &chunkList, network)) {
+		goto cleanup;
+	}
 	if (!CXWriteAttributeDefinitionsChunk(stream, &chunkList, CX_NETWORK_CHUNK_NODE_ATTR, &nodeAttributes)) {
 		goto cleanup;
 	}
@@ -2438,7 +2826,7 @@ cleanup:
 	return result;
 }
 
-CXBool CXNetworkWriteBXNet(CXNetworkRef network, const char *path) {
+static CXBool CXWriteBXNetFile(CXNetworkRef network, const char *path, const CXAttributeFilterSet *filters, CXBool includeAdjacency) {
 	if (!network || !path) {
 		errno = EINVAL;
 		return CXFalse;
@@ -2456,7 +2844,7 @@ CXBool CXNetworkWriteBXNet(CXNetworkRef network, const char *path) {
 		.crc = NULL
 	};
 
-	CXBool ok = CXNetworkSerialize(network, &stream, CXNetworkStorageCodecBinary, NULL);
+	CXBool ok = CXNetworkSerialize(network, &stream, CXNetworkStorageCodecBinary, filters, includeAdjacency);
 	int savedErr = errno;
 	if (fclose(fp) != 0) {
 		int closeErr = errno;
@@ -2473,47 +2861,55 @@ CXBool CXNetworkWriteBXNet(CXNetworkRef network, const char *path) {
 	return CXTrue;
 }
 
-CXBool CXNetworkWriteBXNetFiltered(CXNetworkRef network,
-	const char *path,
-	const char **nodeAllow,
-	size_t nodeAllowCount,
-	const char **nodeIgnore,
-	size_t nodeIgnoreCount,
-	const char **edgeAllow,
-	size_t edgeAllowCount,
-	const char **edgeIgnore,
-	size_t edgeIgnoreCount,
-	const char **networkAllow,
-	size_t networkAllowCount,
-	const char **networkIgnore,
-	size_t networkIgnoreCount
-) {
+void CXNetworkSetZXNetThreadCount(CXSize threadCount) {
+	CXZXNetThreadCount = threadCount == 0 ? 0 : CXMIN(threadCount, (CXSize)CX_THREAD_POOL_MAX_WORKERS);
+}
+
+CXSize CXNetworkGetZXNetThreadCount(void) {
+	return CXZXNetThreadCount;
+}
+
+/* Hands block (de)compression to an htslib thread pool. Failing to start the
+ * pool is not fatal: the handle keeps working on the calling thread. */
+static void CXBGZFAttachThreads(BGZF *bgzf) {
+	CXSize threads = CXZXNetThreadCount == 0 ? CXThreadPoolGetWorkerCount() : CXZXNetThreadCount;
+	if (threads > 1) {
+		(void)bgzf_mt(bgzf, (int)threads, 256);
+	}
+}
+
+static CXBool CXWriteZXNetFile(CXNetworkRef network, const char *path, int compressionLevel, const CXAttributeFilterSet *filters, CXBool includeAdjacency) {
 	if (!network || !path) {
 		errno = EINVAL;
 		return CXFalse;
 	}
-	FILE *fp = fopen(path, "wb");
-	if (!fp) {
+	int level = compressionLevel;
+	if (level < 0) level = 0;
+	if (level > 9) level = 9;
+
+	char mode[4] = {0};
+	if (snprintf(mode, sizeof(mode), "w%d", level) < 0) {
+		errno = EINVAL;
 		return CXFalse;
 	}
 
-	CXAttributeFilterSet filters = {
-		.node = { nodeAllow, nodeAllowCount, nodeIgnore, nodeIgnoreCount },
-		.edge = { edgeAllow, edgeAllowCount, edgeIgnore, edgeIgnoreCount },
-		.network = { networkAllow, networkAllowCount, networkIgnore, networkIgnoreCount }
-	};
+	BGZF *bgzf = bgzf_open(path, mode);
+	if (!bgzf) {
+		return CXFalse;
+	}
+	CXBGZFAttachThreads(bgzf);
 
 	CXOutputStream stream = {
-		.context = fp,
-		.write = CXFileWrite,
-		.tell = CXFileTell,
-		.flush = CXFileFlush,
+		.context = bgzf,
+		.write = CXBGZFWrite,
+		.tell = CXBGZFTell,
+		.flush = CXBGZFFlush,
 		.crc = NULL
 	};
 
-	CXBool ok = CXNetworkSerialize(network, &stream, CXNetworkStorageCodecBinary, &filters);
+	CXBool ok = CXNetworkSerialize(network, &stream, CXNetworkStorageCodecBGZF, filters, includeAdjacency);
 	int savedErr = errno;
-	if (fclose(fp) != 0) {
+	if (bgzf_close(bgzf) != 0) {
 		int closeErr = errno;
 		remove(path);
 		errno = closeErr;
@@ -2528,54 +2924,16 @@ CXBool CXNetworkWriteBXNetFiltered(CXNetworkRef network,
 	return CXTrue;
 }
 
-CXBool CXNetworkWriteZXNet(CXNetworkRef network, const char *path, int compressionLevel) {
-	if (!network || !path) {
-		errno = EINVAL;
-        return CXFalse;
-    }
-    int level = compressionLevel;
-    if (level < 0) level = 0;
-    if (level > 9) level = 9;
-
-    char mode[4] = {0};
-    if (snprintf(mode, sizeof(mode), "w%d", level) < 0) {
-        errno = EINVAL;
-        return CXFalse;
-    }
-
-    BGZF *bgzf = bgzf_open(path, mode);
-    if (!bgzf) {
-        return CXFalse;
-    }
-
-    CXOutputStream stream = {
-        .context = bgzf,
-        .write = CXBGZFWrite,
-        .tell = CXBGZFTell,
-        .flush = CXBGZFFlush,
-        .crc = NULL
-    };
-
-    CXBool ok = CXNetworkSerialize(network, &stream, CXNetworkStorageCodecBGZF, NULL);
-	int savedErr = errno;
-	if (bgzf_close(bgzf) != 0) {
-        int closeErr = errno;
-        remove(path);
-        errno = closeErr;
-        return CXFalse;
-    }
-    if (!ok) {
-        remove(path);
-        errno = savedErr;
-        return CXFalse;
-    }
-    errno = savedErr;
-    return CXTrue;
+CXBool CXNetworkWriteBXNet(CXNetworkRef network, const char *path) {
+	return CXWriteBXNetFile(network, path, NULL, CXFalse);
 }
 
-CXBool CXNetworkWriteZXNetFiltered(CXNetworkRef network,
+CXBool CXNetworkWriteBXNetWithAdjacency(CXNetworkRef network, const char *path) {
+	return CXWriteBXNetFile(network, path, NULL, CXTrue);
+}
+
+CXBool CXNetworkWriteBXNetFiltered(CXNetworkRef network,
 	const char *path,
-	int compressionLevel,
 	const char **nodeAllow,
 	size_t nodeAllowCount,
 	const char **nodeIgnore,
@@ -2589,102 +2947,81 @@ CXBool CXNetworkWriteZXNetFiltered(CXNetworkRef network,
 	const char **networkIgnore,
 	size_t networkIgnoreCount
 ) {
-	if (!network || !path) {
-		errno = EINVAL;
-		return CXFalse;
-	}
-	int level = compressionLevel;
-	if (level < 0) level = 0;
-	if (level > 9) level = 9;
-
-	char mode[4] = {0};
-	if (snprintf(mode, sizeof(mode), "w%d", level) < 0) {
-		errno = EINVAL;
-		return CXFalse;
-	}
-
-	BGZF *bgzf = bgzf_open(path, mode);
-	if (!bgzf) {
-		return CXFalse;
-	}
-
 	CXAttributeFilterSet filters = {
 		.node = { nodeAllow, nodeAllowCount, nodeIgnore, nodeIgnoreCount },
 		.edge = { edgeAllow, edgeAllowCount, edgeIgnore, edgeIgnoreCount },
 		.network = { networkAllow, networkAllowCount, networkIgnore, networkIgnoreCount }
 	};
+	return CXWriteBXNetFile(network, path, &filters, CXFalse);
+}
 
-	CXOutputStream stream = {
-		.context = bgzf,
-		.write = CXBGZFWrite,
-		.tell = CXBGZFTell,
-		.flush = CXBGZFFlush,
-		.crc = NULL
-	};
+CXBool CXNetworkWriteZXNet(CXNetworkRef network, const char *path, int compressionLevel) {
+	return CXWriteZXNetFile(network, path, compressionLevel, NULL, CXFalse);
+}
 
-	CXBool ok = CXNetworkSerialize(network, &stream, CXNetworkStorageCodecBGZF, &filters);
-	int savedErr = errno;
-	if (bgzf_close(bgzf) != 0) {
-		int closeErr = errno;
-		remove(path);
-		errno = closeErr;
-		return CXFalse;
-	}
-	if (!ok) {
-		remove(path);
-		errno = savedErr;
-		return CXFalse;
-	}
-	errno = savedErr;
-	return CXTrue;
+CXBool CXNetworkWriteZXNetWithAdjacency(CXNetworkRef network, const char *path, int compressionLevel) {
+	return CXWriteZXNetFile(network, path, compressionLevel, NULL, CXTrue);
 }
 
-struct CXNetwork* CXNetworkReadBXNet(const char *path) {
-	if (!path) {
+CXBool CXNetworkWriteZXNetFiltered(CXNetworkRef network,
+	const char *path,
+	int compressionLevel,
+	const char **nodeAllow,
+	size_t nodeAllowCount,
+	const char **nodeIgnore,
+	size_t nodeIgnoreCount,
+	const char **edgeAllow,
+	size_t edgeAllowCount,
+	const char **edgeIgnore,
+	size_t edgeIgnoreCount,
+	const char **networkAllow,
+	size_t networkAllowCount,
+	const char **networkIgnore,
+	size_t networkIgnoreCount
+) {
+	CXAttributeFilterSet filters = {
+		.node = { nodeAllow, nodeAllowCount, nodeIgnore, nodeIgnoreCount },
+		.edge = { edgeAllow, edgeAllowCount, edgeIgnore, edgeIgnoreCount },
+		.network = { networkAllow, networkAllowCount, networkIgnore, networkIgnoreCount }
+	};
+	return CXWriteZXNetFile(network, path, compressionLevel, &filters, CXFalse);
+}
+
+/**
+ * Decodes a complete BXNet/ZXNet document from `stream`, whose `crc` field is
+ * managed here. The adjacency is rebuilt in bulk and left frozen. Attributes
+ * rejected by `filters` are skipped over; unless the stream can checksum the
+ * skipped bytes itself, the file checksum is then not verified.
+ */
+static CXNetworkRef CXNetworkReadFromStream(CXInputStream *stream, CXNetworkStorageCodec codec, const CXAttributeFilterSet *filters) {
+	if (filters && (!CXValidateNameFilter(&filters->node) || !CXValidateNameFilter(&filters->edge) ||
+		!CXValidateNameFilter(&filters->network))) {
 		errno = EINVAL;
 		return NULL;
 	}
-
-	FILE *fp = fopen(path, "rb");
-	if (!fp) {
-		return NULL;
-	}
-
-	CXInputStream stream = {
-		.context = fp,
-		.read = CXFileRead,
-		.tell = CXFileTell,
-		.seek = CXFileSeek,
-		.crc = NULL
-	};
-
 	uint32_t checksum = crc32(0L, Z_NULL, 0);
-	stream.crc = &checksum;
+	CXBool verifyChecksum = (!filters || stream->checksum) ? CXTrue : CXFalse;
+	stream->crc = (stream->checksum || !verifyChecksum) ? NULL : &checksum;
 
 	CXParsedHeader header = {0};
-	if (!CXReadHeaderBlock(&stream, &header)) {
-		fclose(fp);
+	if (!CXReadHeaderBlock(stream, &header)) {
 		return NULL;
 	}
-	if (header.codec != (uint32_t)CXNetworkStorageCodecBinary) {
-		fclose(fp);
+	if (header.codec != (uint32_t)codec) {
 		errno = EINVAL;
 		return NULL;
 	}
 	if (header.nodeCapacity > (uint64_t)CXSizeMAX || header.edgeCapacity > (uint64_t)CXSizeMAX) {
-		fclose(fp);
 		errno = ERANGE;
 		return NULL;
 	}
 	if (header.nodeCount > header.nodeCapacity || header.edgeCount > header.edgeCapacity) {
-		fclose(fp);
 		errno = EINVAL;
 		return NULL;
 	}
 
 	CXNetworkRef network = CXNewNetworkWithCapacity((header.flags & 1u) ? CXTrue : CXFalse, (CXSize)header.nodeCapacity, (CXSize)header.edgeCapacity);
 	if (!network) {
-		fclose(fp);
 		return NULL;
 	}
 
@@ -2692,6 +3029,8 @@ struct CXNetwork* CXNetworkReadBXNet(const char *path) {
 	CXAttributeLoadList edgeAttributes = {0};
 	CXAttributeLoadList networkAttributes = {0};
 	CXMetaChunkPayload meta = {0};
+	CXIndex *adjacencyBlock = NULL;
+	CXIndex *adjacencyOffsets = NULL;
 
 	const uint32_t expectedChunks[] = {
 		CX_NETWORK_CHUNK_META,
@@ -2709,9 +3048,19 @@ struct CXNetwork* CXNetworkReadBXNet(const char *path) {
 		uint32_t chunkId = 0;
 		uint32_t flags = 0;
 		uint64_t payloadSize = 0;
-		if (!CXReadChunkHeader(&stream, &chunkId, &flags, &payloadSize)) {
+		if (!CXReadChunkHeader(stream, &chunkId, &flags, &payloadSize)) {
 			goto read_fail;
 		}
+		if (chunkId == CX_NETWORK_CHUNK_ADJACENCY && expectedChunks[idx] == CX_NETWORK_CHUNK_NODE_ATTR &&
+			header.versionMinor >= CX_NETWORK_SERIAL_VERSION_MINOR_ADJACENCY && !adjacencyBlock) {
+			// Optional chunk between EDGE and NATT.
+			network->edgeCount = (CXSize)header.edgeCount;
+			if (!CXReadAdjacencyChunk(stream, payloadSize, network, &adjacencyBlock, &adjacencyOffsets)) {
+				goto read_fail;
+			}
+			idx--;
+			continue;
+		}
 		if (chunkId != expectedChunks[idx]) {
 			errno = EINVAL;
 			goto read_fail;
@@ -2720,7 +3069,7 @@ struct CXNetwork* CXNetworkReadBXNet(const char *path) {
 
 		switch (chunkId) {
 			case CX_NETWORK_CHUNK_META:
-				if (!CXReadMetaChunk(&stream, payloadSize, &meta)) {
+				if (!CXReadMetaChunk(stream, payloadSize, &meta)) {
 					goto read_fail;
 				}
 				if (meta.nodeCount != header.nodeCount || meta.edgeCount != header.edgeCount ||
@@ -2730,42 +3079,42 @@ struct CXNetwork* CXNetworkReadBXNet(const char *path) {
 				}
 				break;
 			case CX_NETWORK_CHUNK_NODE:
-				if (!CXReadNodeChunk(&stream, payloadSize, network)) {
+				if (!CXReadNodeChunk(stream, payloadSize, network)) {
 					goto read_fail;
 				}
 				break;
 			case CX_NETWORK_CHUNK_EDGE:
-				if (!CXReadEdgeChunk(&stream, payloadSize, network)) {
+				if (!CXReadEdgeChunk(stream, payloadSize, network)) {
 					goto read_fail;
 				}
 				break;
 			case CX_NETWORK_CHUNK_NODE_ATTR:
-				if (!CXReadAttributeDefinitionsChunk(&stream, payloadSize, network, CXAttributeScopeNode, &nodeAttributes)) {
+				if (!CXReadAttributeDefinitionsChunk(stream, payloadSize, network, CXAttributeScopeNode, filters ? &filters->node : NULL, &nodeAttributes)) {
 					goto read_fail;
 				}
 				break;
 			case CX_NETWORK_CHUNK_EDGE_ATTR:
-				if (!CXReadAttributeDefinitionsChunk(&stream, payloadSize, network, CXAttributeScopeEdge, &edgeAttributes)) {
+				if (!CXReadAttributeDefinitionsChunk(stream, payloadSize, network, CXAttributeScopeEdge, filters ? &filters->edge : NULL, &edgeAttributes)) {
 					goto read_fail;
 				}
 				break;
 			case CX_NETWORK_CHUNK_NET_ATTR:
-				if (!CXReadAttributeDefinitionsChunk(&stream, payloadSize, network, CXAttributeScopeNetwork, &networkAttributes)) {
+				if (!CXReadAttributeDefinitionsChunk(stream, payloadSize, network, CXAttributeScopeNetwork, filters ? &filters->network : NULL, &networkAttributes)) {
 					goto read_fail;
 				}
 				break;
 			case CX_NETWORK_CHUNK_NODE_VALUES:
-				if (!CXReadAttributeValuesChunk(&stream, payloadSize, &nodeAttributes)) {
+				if (!CXReadAttributeValuesChunk(stream, payloadSize, &nodeAttributes)) {
 					goto read_fail;
 				}
 				break;
 			case CX_NETWORK_CHUNK_EDGE_VALUES:
-				if (!CXReadAttributeValuesChunk(&stream, payloadSize, &edgeAttributes)) {
+				if (!CXReadAttributeValuesChunk(stream, payloadSize, &edgeAttributes)) {
 					goto read_fail;
 				}
 				break;
 			case CX_NETWORK_CHUNK_NET_VALUES:
-				if (!CXReadAttributeValuesChunk(&stream, payloadSize, &networkAttributes)) {
+				if (!CXReadAttributeValuesChunk(stream, payloadSize, &networkAttributes)) {
 					goto read_fail;
 				}
 				break;
@@ -2780,8 +3129,11 @@ struct CXNetwork* CXNetworkReadBXNet(const char *path) {
 		goto read_fail;
 	}
 
-	stream.crc = NULL;
-	if (!CXReadFooter(&stream, &meta, checksum)) {
+	stream->crc = NULL;
+	if (stream->checksum) {
+		checksum = stream->checksum(stream->context);
+	}
+	if (!CXReadFooter(stream, &meta, verifyChecksum, checksum)) {
 		goto read_fail;
 	}
 
@@ -2810,221 +3162,233 @@ struct CXNetwork* CXNetworkReadBXNet(const char *path) {
 	if (!CXRebuildIndexManager(network->edgeIndexManager, network->edgeActive, network->edgeCapacity)) {
 		goto read_fail;
 	}
-	if (!CXRebuildAdjacency(network)) {
+	if (adjacencyBlock) {
+		if (!CXNetworkAdoptFrozenAdjacency(network, adjacencyBlock, adjacencyOffsets)) {
+			goto read_fail;
+		}
+		adjacencyBlock = NULL;
+	} else if (!CXNetworkBuildFrozenAdjacency(network)) {
 		goto read_fail;
 	}
 
+	free(adjacencyOffsets);
 	CXAttributeLoadListDestroy(&nodeAttributes);
 	CXAttributeLoadListDestroy(&edgeAttributes);
 	CXAttributeLoadListDestroy(&networkAttributes);
-
-	if (fclose(fp) != 0) {
-		CXFreeNetwork(network);
-		return NULL;
-	}
-
 	return network;
 
 read_fail:
+	free(adjacencyBlock);
+	free(adjacencyOffsets);
 	CXAttributeLoadListDestroy(&nodeAttributes);
 	CXAttributeLoadListDestroy(&edgeAttributes);
 	CXAttributeLoadListDestroy(&networkAttributes);
 	CXFreeNetwork(network);
-	fclose(fp);
 	return NULL;
 }
 
+static CXNetworkRef CXReadBXNetFile(const char *path, const CXAttributeFilterSet *filters) {
+	if (!path) {
+		errno = EINVAL;
+		return NULL;
+	}
+
+	FILE *fp = fopen(path, "rb");
+	if (!fp) {
+		return NULL;
+	}
+
+	CXInputStream stream = {
+		.context = fp,
+		.read = CXFileRead,
+		.tell = CXFileTell,
+		.seek = CXFileSeek,
+		.crc = NULL,
+		.checksum = NULL,
+		.skip = CXFileSkip
+	};
+
+	CXNetworkRef network = CXNetworkReadFromStream(&stream, CXNetworkStorageCodecBinary, filters);
+	if (fclose(fp) != 0 && network) {
+		CXFreeNetwork(network);
+		return NULL;
+	}
+	return network;
+}
+
+struct CXNetwork* CXNetworkReadBXNet(const char *path) {
+	return CXReadBXNetFile(path, NULL);
+}
+
+struct CXNetwork* CXNetworkReadBXNetFiltered(const char *path,
+	const char **nodeAllow,
+	size_t nodeAllowCount,
+	const char **nodeIgnore,
+	size_t nodeIgnoreCount,
+	const char **edgeAllow,
+	size_t edgeAllowCount,
+	const char **edgeIgnore,
+	size_t edgeIgnoreCount,
+	const char **networkAllow,
+	size_t networkAllowCount,
+	const char **networkIgnore,
+	size_t networkIgnoreCount
+) {
+	CXAttributeFilterSet filters = {
+		.node = { nodeAllow, nodeAllowCount, nodeIgnore, nodeIgnoreCount },
+		.edge = { edgeAllow, edgeAllowCount, edgeIgnore, edgeIgnoreCount },
+		.network = { networkAllow, networkAllowCount, networkIgnore, networkIgnoreCount }
+	};
+	return CXReadBXNetFile(path, &filters);
+}
+
+struct CXNetwork* CXNetworkMapBXNet(const char *path) {
+	if (!path) {
+		errno = EINVAL;
+		return NULL;
+	}
+
+#if defined(_WIN32)
+	// No mmap here: slurp the file and decode it from memory all the same.
+	FILE *fp = fopen(path, "rb");
+	if (!fp) {
+		return NULL;
+	}
+	int64_t fileSize = -1;
+	if (_fseeki64(fp, 0, SEEK_END) == 0) {
+		fileSize = _ftelli64(fp);
+	}
+	if (fileSize < 0 || (uint64_t)fileSize > (uint64_t)SIZE_MAX || _fseeki64(fp, 0, SEEK_SET) != 0) {
+		fclose(fp);
+		errno = EIO;
+		return NULL;
+	}
+	size_t length = (size_t)fileSize;
+	uint8_t *data = malloc(length > 0 ? length : 1);
+	if (!data) {
+		fclose(fp);
+		errno = ENOMEM;
+		return NULL;
+	}
+	if (fread(data, 1, length, fp) != length) {
+		free(data);
+		fclose(fp);
+		errno = EIO;
+		return NULL;
+	}
+	fclose(fp);
+#else
+	int fd = open(path, O_RDONLY);
+	if (fd < 0) {
+		return NULL;
+	}
+	struct stat info;
+	if (fstat(fd, &info) != 0) {
+		close(fd);
+		return NULL;
+	}
+	if (info.st_size < (off_t)(CX_NETWORK_FILE_HEADER_SIZE + CX_NETWORK_FILE_FOOTER_SIZE) ||
+		(uint64_t)info.st_size > (uint64_t)SIZE_MAX) {
+		close(fd);
+		errno = EINVAL;
+		return NULL;
+	}
+	size_t length = (size_t)info.st_size;
+	void *data = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (data == MAP_FAILED) {
+		return NULL;
+	}
+#if defined(POSIX_MADV_SEQUENTIAL)
+	posix_madvise(data, length, POSIX_MADV_SEQUENTIAL);
+#endif
+#endif
+
+	CXMemoryInput input = {
+		.data = (const uint8_t *)data,
+		.length = length,
+		.position = 0
+	};
+	CXInputStream stream = {
+		.context = &input,
+		.read = CXMemoryRead,
+		.tell = CXMemoryTell,
+		.seek = CXMemorySeek,
+		.crc = NULL,
+		.checksum = CXMemoryChecksum
+	};
+
+	int savedErrno = 0;
+	CXNetworkRef network = CXNetworkReadFromStream(&stream, CXNetworkStorageCodecBinary, NULL);
+	if (!network) {
+		savedErrno = errno;
+	}
+#if defined(_WIN32)
+	free(data);
+#else
+	munmap(data, length);
+#endif
+	if (!network) {
+		errno = savedErrno;
+	}
+	return network;
+}
+
+static CXNetworkRef CXReadZXNetFile(const char *path, const CXAttributeFilterSet *filters) {
+	if (!path) {
+		errno = EINVAL;
+		return NULL;
+	}
+
+	BGZF *bgzf = bgzf_open(path, "r");
+	if (!bgzf) {
+		return NULL;
+	}
+	// Threaded handles decompress ahead, which would defeat skipping blocks.
+	if (!filters) {
+		CXBGZFAttachThreads(bgzf);
+	}
+
+	CXInputStream stream = {
+		.context = bgzf,
+		.read = CXBGZFRead,
+		.tell = CXBGZFTell,
+		.seek = CXBGZFSeek,
+		.crc = NULL,
+		.checksum = NULL,
+		.skip = CXBGZFSkip
+	};
+
+	CXNetworkRef network = CXNetworkReadFromStream(&stream, CXNetworkStorageCodecBGZF, filters);
+	if (bgzf_close(bgzf) != 0 && network) {
+		CXFreeNetwork(network);
+		return NULL;
+	}
+	return network;
+}
+
 struct CXNetwork* CXNetworkReadZXNet(const char *path) {
-    if (!path) {
-        errno = EINVAL;
-        return NULL;
-    }
-
-    BGZF *bgzf = bgzf_open(path, "r");
-    if (!bgzf) {
-        return NULL;
-    }
-
-    CXInputStream stream = {
-        .context = bgzf,
-        .read = CXBGZFRead,
-        .tell = CXBGZFTell,
-        .seek = CXBGZFSeek,
-        .crc = NULL
-    };
-
-    uint32_t checksum = crc32(0L, Z_NULL, 0);
-    stream.crc = &checksum;
-
-    CXParsedHeader header = {0};
-    if (!CXReadHeaderBlock(&stream, &header)) {
-        bgzf_close(bgzf);
-        return NULL;
-    }
-    if (header.codec != (uint32_t)CXNetworkStorageCodecBGZF) {
-        bgzf_close(bgzf);
-        errno = EINVAL;
-        return NULL;
-    }
-    if (header.nodeCapacity > (uint64_t)CXSizeMAX || header.edgeCapacity > (uint64_t)CXSizeMAX) {
-        bgzf_close(bgzf);
-        errno = ERANGE;
-        return NULL;
-    }
-    if (header.nodeCount > header.nodeCapacity || header.edgeCount > header.edgeCapacity) {
-        bgzf_close(bgzf);
-        errno = EINVAL;
-        return NULL;
-    }
-
-    CXNetworkRef network = CXNewNetworkWithCapacity((header.flags & 1u) ? CXTrue : CXFalse, (CXSize)header.nodeCapacity, (CXSize)header.edgeCapacity);
-    if (!network) {
-        bgzf_close(bgzf);
-        return NULL;
-    }
-
-    CXAttributeLoadList nodeAttributes = {0};
-    CXAttributeLoadList edgeAttributes = {0};
-    CXAttributeLoadList networkAttributes = {0};
-    CXMetaChunkPayload meta = {0};
-
-    const uint32_t expectedChunks[] = {
-        CX_NETWORK_CHUNK_META,
-        CX_NETWORK_CHUNK_NODE,
-        CX_NETWORK_CHUNK_EDGE,
-        CX_NETWORK_CHUNK_NODE_ATTR,
-        CX_NETWORK_CHUNK_EDGE_ATTR,
-        CX_NETWORK_CHUNK_NET_ATTR,
-        CX_NETWORK_CHUNK_NODE_VALUES,
-        CX_NETWORK_CHUNK_EDGE_VALUES,
-        CX_NETWORK_CHUNK_NET_VALUES
-    };
-
-    for (size_t idx = 0; idx < sizeof(expectedChunks) / sizeof(expectedChunks[0]); idx++) {
-        uint32_t chunkId = 0;
-        uint32_t flags = 0;
-        uint64_t payloadSize = 0;
-        if (!CXReadChunkHeader(&stream, &chunkId, &flags, &payloadSize)) {
-            goto read_fail_gz;
-        }
-        if (chunkId != expectedChunks[idx]) {
-            errno = EINVAL;
-            goto read_fail_gz;
-        }
-        (void)flags;
-
-        switch (chunkId) {
-            case CX_NETWORK_CHUNK_META:
-                if (!CXReadMetaChunk(&stream, payloadSize, &meta)) {
-                    goto read_fail_gz;
-                }
-                if (meta.nodeCount != header.nodeCount || meta.edgeCount != header.edgeCount ||
-                    meta.nodeCapacity != header.nodeCapacity || meta.edgeCapacity != header.edgeCapacity) {
-                    errno = EINVAL;
-                    goto read_fail_gz;
-                }
-                break;
-            case CX_NETWORK_CHUNK_NODE:
-                if (!CXReadNodeChunk(&stream, payloadSize, network)) {
-                    goto read_fail_gz;
-                }
-                break;
-            case CX_NETWORK_CHUNK_EDGE:
-                if (!CXReadEdgeChunk(&stream, payloadSize, network)) {
-                    goto read_fail_gz;
-                }
-                break;
-            case CX_NETWORK_CHUNK_NODE_ATTR:
-                if (!CXReadAttributeDefinitionsChunk(&stream, payloadSize, network, CXAttributeScopeNode, &nodeAttributes)) {
-                    goto read_fail_gz;
-                }
-                break;
-            case CX_NETWORK_CHUNK_EDGE_ATTR:
-                if (!CXReadAttributeDefinitionsChunk(&stream, payloadSize, network, CXAttributeScopeEdge, &edgeAttributes)) {
-                    goto read_fail_gz;
-                }
-                break;
-            case CX_NETWORK_CHUNK_NET_ATTR:
-                if (!CXReadAttributeDefinitionsChunk(&stream, payloadSize, network, CXAttributeScopeNetwork, &networkAttributes)) {
-                    goto read_fail_gz;
-                }
-                break;
-            case CX_NETWORK_CHUNK_NODE_VALUES:
-                if (!CXReadAttributeValuesChunk(&stream, payloadSize, &nodeAttributes)) {
-                    goto read_fail_gz;
-                }
-                break;
-            case CX_NETWORK_CHUNK_EDGE_VALUES:
-                if (!CXReadAttributeValuesChunk(&stream, payloadSize, &edgeAttributes)) {
-                    goto read_fail_gz;
-                }
-                break;
-            case CX_NETWORK_CHUNK_NET_VALUES:
-                if (!CXReadAttributeValuesChunk(&stream, payloadSize, &networkAttributes)) {
-                    goto read_fail_gz;
-                }
-                break;
-            default:
-                errno = EINVAL;
-                goto read_fail_gz;
-        }
-    }
-
-    if (meta.nodeCapacity != (uint64_t)network->nodeCapacity || meta.edgeCapacity != (uint64_t)network->edgeCapacity) {
-        errno = EINVAL;
-        goto read_fail_gz;
-    }
-
-    stream.crc = NULL;
-    if (!CXReadFooter(&stream, &meta, checksum)) {
-        goto read_fail_gz;
-    }
-
-    if (meta.nodeCount > (uint64_t)CXSizeMAX || meta.edgeCount > (uint64_t)CXSizeMAX) {
-        errno = ERANGE;
-        goto read_fail_gz;
-    }
-
-    CXSize nodeCount = (CXSize)meta.nodeCount;
-    CXSize edgeCount = (CXSize)meta.edgeCount;
-    if (CXCountActive(network->nodeActive, network->nodeCapacity) != nodeCount) {
-        errno = EINVAL;
-        goto read_fail_gz;
-    }
-    if (CXCountActive(network->edgeActive, network->edgeCapacity) != edgeCount) {
-        errno = EINVAL;
-        goto read_fail_gz;
-    }
-
-    network->nodeCount = nodeCount;
-    network->edgeCount = edgeCount;
-
-    if (!CXRebuildIndexManager(network->nodeIndexManager, network->nodeActive, network->nodeCapacity)) {
-        goto read_fail_gz;
-    }
-    if (!CXRebuildIndexManager(network->edgeIndexManager, network->edgeActive, network->edgeCapacity)) {
-        goto read_fail_gz;
-    }
-    if (!CXRebuildAdjacency(network)) {
-        goto read_fail_gz;
-    }
-
-    CXAttributeLoadListDestroy(&nodeAttributes);
-    CXAttributeLoadListDestroy(&edgeAttributes);
-    CXAttributeLoadListDestroy(&networkAttributes);
-
-    if (bgzf_close(bgzf) != 0) {
-        CXFreeNetwork(network);
-        return NULL;
-    }
-
-    return network;
-
-read_fail_gz:
-    CXAttributeLoadListDestroy(&nodeAttributes);
-    CXAttributeLoadListDestroy(&edgeAttributes);
-    CXAttributeLoadListDestroy(&networkAttributes);
-    CXFreeNetwork(network);
-    bgzf_close(bgzf);
-    return NULL;
+	return CXReadZXNetFile(path, NULL);
+}
+
+struct CXNetwork* CXNetworkReadZXNetFiltered(const char *path,
+	const char **nodeAllow,
+	size_t nodeAllowCount,
+	const char **nodeIgnore,
+	size_t nodeIgnoreCount,
+	const char **edgeAllow,
+	size_t edgeAllowCount,
+	const char **edgeIgnore,
+	size_t edgeIgnoreCount,
+	const char **networkAllow,
+	size_t networkAllowCount,
+	const char **networkIgnore,
+	size_t networkIgnoreCount
+) {
+	CXAttributeFilterSet filters = {
+		.node = { nodeAllow, nodeAllowCount, nodeIgnore, nodeIgnoreCount },
+		.edge = { edgeAllow, edgeAllowCount, edgeIgnore, edgeIgnoreCount },
+		.network = { networkAllow, networkAllowCount, networkIgnore, networkIgnoreCount }
+	};
+	return CXReadZXNetFile(path, &filters);
 }
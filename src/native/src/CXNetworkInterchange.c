@@ -3,9 +3,16 @@
 
 #include "CXNetwork.h"
 #include "CXDictionary.h"
+#include "CXTextWriter.h"
 
 #include <errno.h>
 #include <stdbool.h>
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 typedef enum {
 	InterchangeScopeGraph = 0,
@@ -83,14 +90,63 @@ static CXBool InterchangeCategoryDecodeId(const void *data, int32_t *outId) {
 	return CXTrue;
 }
 
-static const char* InterchangeCategoryLabelForId(CXAttributeRef attr, int32_t id) {
+typedef struct {
+	int32_t id;
+	const char *label;
+} InterchangeCategoryLabel;
+
+/* Category labels of one attribute sorted by id, so each written value costs
+ * a binary search rather than a walk over the dictionary. */
+typedef struct {
+	InterchangeCategoryLabel *items;
+	size_t count;
+} InterchangeCategoryLabels;
+
+static int InterchangeCategoryLabelCompare(const void *lhs, const void *rhs) {
+	int32_t a = ((const InterchangeCategoryLabel *)lhs)->id;
+	int32_t b = ((const InterchangeCategoryLabel *)rhs)->id;
+	return (a > b) - (a < b);
+}
+
+static CXBool InterchangeCategoryLabelsBuild(CXAttributeRef attr, InterchangeCategoryLabels *labels) {
+	labels->items = NULL;
+	labels->count = 0;
 	if (!attr || !attr->categoricalDictionary) {
-		return NULL;
+		return CXTrue;
+	}
+	size_t capacity = (size_t)CXStringDictionaryCount(attr->categoricalDictionary);
+	if (capacity == 0) {
+		return CXTrue;
+	}
+	labels->items = malloc(sizeof(InterchangeCategoryLabel) * capacity);
+	if (!labels->items) {
+		return CXFalse;
 	}
 	CXStringDictionaryFOR(entry, attr->categoricalDictionary) {
-		int32_t entryId = 0;
-		if (InterchangeCategoryDecodeId(entry->data, &entryId) && entryId == id) {
-			return entry->key;
+		int32_t id = 0;
+		if (labels->count < capacity && InterchangeCategoryDecodeId(entry->data, &id)) {
+			labels->items[labels->count].id = id;
+			labels->items[labels->count].label = entry->key;
+			labels->count++;
+		}
+	}
+	qsort(labels->items, labels->count, sizeof(InterchangeCategoryLabel), InterchangeCategoryLabelCompare);
+	return CXTrue;
+}
+
+static const char* InterchangeCategoryLabelForId(const InterchangeCategoryLabels *labels, int32_t id) {
+	size_t low = 0;
+	size_t high = labels->count;
+	while (low < high) {
+		size_t middle = low + (high - low) / 2u;
+		int32_t middleId = labels->items[middle].id;
+		if (middleId == id) {
+			return labels->items[middle].label;
+		}
+		if (middleId < id) {
+			low = middle + 1u;
+		} else {
+			high = middle;
 		}
 	}
 	return NULL;
@@ -202,72 +258,16 @@ static char* InterchangeSanitizeGMLKey(
 	return sanitized;
 }
 
-static void InterchangeWriteGMLEscapedString(FILE *file, const char *text) {
-	fputc('"', file);
-	const unsigned char *cursor = (const unsigned char *)(text ? text : "");
-	while (*cursor) {
-		switch (*cursor) {
-			case '\\':
-				fputs("\\\\", file);
-				break;
-			case '"':
-				fputs("\\\"", file);
-				break;
-			case '\n':
-				fputs("\\n", file);
-				break;
-			case '\r':
-				fputs("\\r", file);
-				break;
-			case '\t':
-				fputs("\\t", file);
-				break;
-			default:
-				fputc((int)*cursor, file);
-				break;
-		}
-		cursor++;
-	}
-	fputc('"', file);
+static void InterchangeWriteGMLEscapedString(CXTextWriter *out, const char *text) {
+	CXTextWriterPutChar(out, '"');
+	CXTextWriterWriteEscaped(out, text ? text : "", CXTextEscapeGML);
+	CXTextWriterPutChar(out, '"');
 }
 
-static void InterchangeWriteJSONEscapedString(FILE *file, const char *text) {
-	fputc('"', file);
-	const unsigned char *cursor = (const unsigned char *)(text ? text : "");
-	while (*cursor) {
-		switch (*cursor) {
-			case '\\':
-				fputs("\\\\", file);
-				break;
-			case '"':
-				fputs("\\\"", file);
-				break;
-			case '\b':
-				fputs("\\b", file);
-				break;
-			case '\f':
-				fputs("\\f", file);
-				break;
-			case '\n':
-				fputs("\\n", file);
-				break;
-			case '\r':
-				fputs("\\r", file);
-				break;
-			case '\t':
-				fputs("\\t", file);
-				break;
-			default:
-				if (*cursor < 0x20u) {
-					fprintf(file, "\\u%04x", (unsigned int)*cursor);
-				} else {
-					fputc((int)*cursor, file);
-				}
-				break;
-		}
-		cursor++;
-	}
-	fputc('"', file);
+static void InterchangeWriteJSONEscapedString(CXTextWriter *out, const char *text) {
+	CXTextWriterPutChar(out, '"');
+	CXTextWriterWriteEscaped(out, text ? text : "", CXTextEscapeJSON);
+	CXTextWriterPutChar(out, '"');
 }
 
 static void* InterchangeAttributeValuePtr(CXAttributeRef attr, CXIndex index) {
@@ -318,50 +318,133 @@ static CXBool InterchangeAttributeSupportedForNodeLinkJSON(CXAttributeRef attr)
 	}
 }
 
-static CXBool InterchangeWriteGMLScalar(FILE *file, CXAttributeRef attr, CXIndex index) {
-	void *ptr = InterchangeAttributeValuePtr(attr, index);
-	if (!ptr) {
+/* One exported attribute of a scope, resolved once per file rather than once
+ * per row: GML keys are sanitized and warnings raised a single time. */
+typedef struct {
+	CXAttributeRef attr;
+	const char *name;
+	char *key;          /* sanitized GML key; NULL for node-link JSON */
+	CXBool reserved;    /* node-link JSON: written inside "attributes" */
+	InterchangeCategoryLabels labels;
+} InterchangeColumn;
+
+typedef struct {
+	InterchangeColumn *items;
+	size_t count;
+	CXBool hasReserved;
+} InterchangeColumnList;
+
+static void InterchangeColumnListFree(InterchangeColumnList *list) {
+	for (size_t i = 0; i < list->count; i += 1) {
+		free(list->items[i].key);
+		free(list->items[i].labels.items);
+	}
+	free(list->items);
+	list->items = NULL;
+	list->count = 0;
+	list->hasReserved = CXFalse;
+}
+
+static CXBool InterchangeColumnListReserve(CXStringDictionaryRef dictionary, InterchangeColumnList *list) {
+	list->items = NULL;
+	list->count = 0;
+	list->hasReserved = CXFalse;
+	size_t capacity = dictionary ? (size_t)CXStringDictionaryCount(dictionary) : 0u;
+	if (capacity == 0) {
+		return CXTrue;
+	}
+	list->items = calloc(capacity, sizeof(InterchangeColumn));
+	return list->items != NULL;
+}
+
+static CXBool InterchangeCollectGMLColumns(CXStringDictionaryRef dictionary, InterchangeScope scope, InterchangeColumnList *list) {
+	if (!InterchangeColumnListReserve(dictionary, list)) {
 		return CXFalse;
 	}
-	switch (attr->type) {
-		case CXBooleanAttributeType: {
-			uint8_t value = *((uint8_t *)ptr);
-			fprintf(file, "%u", value ? 1u : 0u);
-			return CXTrue;
+	if (!list->items) {
+		return CXTrue;
+	}
+	CXStringDictionaryRef usedNames = CXNewStringDictionary();
+	if (!usedNames) {
+		InterchangeColumnListFree(list);
+		return CXFalse;
+	}
+	CXBool ok = CXTrue;
+	CXStringDictionaryFOR(entry, dictionary) {
+		CXAttributeRef attr = (CXAttributeRef)entry->data;
+		if (!attr) {
+			continue;
+		}
+		if (!InterchangeAttributeSupportedForGML(attr)) {
+			InterchangeWarningAppend("GML skipped unsupported %s attribute \"%s\"", InterchangeScopeLabel(scope), entry->key);
+			continue;
+		}
+		CXBool renamed = CXFalse;
+		char *safeBase = InterchangeSanitizeGMLKey(entry->key, scope, usedNames, &renamed);
+		if (!safeBase) {
+			ok = CXFalse;
+			break;
+		}
+		if (renamed) {
+			InterchangeWarningAppend("GML renamed %s attribute \"%s\" to \"%s\"", InterchangeScopeLabel(scope), entry->key, safeBase);
+		}
+		if (attr->dimension > 1) {
+			InterchangeWarningAppend("GML flattened multi-dimensional %s attribute \"%s\"", InterchangeScopeLabel(scope), entry->key);
 		}
+		InterchangeColumn *column = &list->items[list->count++];
+		column->attr = attr;
+		column->name = entry->key;
+		column->key = safeBase;
+		if (!InterchangeCategoryLabelsBuild(attr, &column->labels)) {
+			ok = CXFalse;
+			break;
+		}
+	}
+	CXStringDictionaryDestroy(usedNames);
+	if (!ok) {
+		InterchangeColumnListFree(list);
+	}
+	return ok;
+}
+
+static CXBool InterchangeWriteGMLScalar(CXTextWriter *out, const InterchangeColumn *column, const void *ptr) {
+	switch (column->attr->type) {
+		case CXBooleanAttributeType:
+			CXTextWriterPutChar(out, *((const uint8_t *)ptr) ? '1' : '0');
+			return CXTrue;
 		case CXFloatAttributeType:
-			fprintf(file, "%.9g", (double)(*((float *)ptr)));
+			CXTextWriterWriteFloat(out, *((const float *)ptr));
 			return CXTrue;
 		case CXDoubleAttributeType:
-			fprintf(file, "%.17g", *((double *)ptr));
+			CXTextWriterWriteDouble(out, *((const double *)ptr));
 			return CXTrue;
 		case CXIntegerAttributeType:
-			fprintf(file, "%" PRId32, *((int32_t *)ptr));
+			CXTextWriterWriteInt64(out, *((const int32_t *)ptr));
 			return CXTrue;
 		case CXUnsignedIntegerAttributeType:
-			fprintf(file, "%" PRIu32, *((uint32_t *)ptr));
+			CXTextWriterWriteUInt64(out, *((const uint32_t *)ptr));
 			return CXTrue;
 		case CXBigIntegerAttributeType:
-			fprintf(file, "%" PRId64, *((int64_t *)ptr));
+			CXTextWriterWriteInt64(out, *((const int64_t *)ptr));
 			return CXTrue;
 		case CXUnsignedBigIntegerAttributeType:
-			fprintf(file, "%" PRIu64, *((uint64_t *)ptr));
+			CXTextWriterWriteUInt64(out, *((const uint64_t *)ptr));
 			return CXTrue;
 		case CXStringAttributeType: {
-			CXString value = *((CXString *)ptr);
+			CXString value = *((const CXString *)ptr);
 			if (!value) {
 				return CXFalse;
 			}
-			InterchangeWriteGMLEscapedString(file, value);
+			InterchangeWriteGMLEscapedString(out, value);
 			return CXTrue;
 		}
 		case CXDataAttributeCategoryType: {
-			int32_t raw = *((int32_t *)ptr);
-			const char *label = InterchangeCategoryLabelForId(attr, raw);
+			int32_t raw = *((const int32_t *)ptr);
+			const char *label = InterchangeCategoryLabelForId(&column->labels, raw);
 			if (label) {
-				InterchangeWriteGMLEscapedString(file, label);
+				InterchangeWriteGMLEscapedString(out, label);
 			} else {
-				fprintf(file, "%" PRId32, raw);
+				CXTextWriterWriteInt64(out, raw);
 			}
 			return CXTrue;
 		}
@@ -370,107 +453,146 @@ static CXBool InterchangeWriteGMLScalar(FILE *file, CXAttributeRef attr, CXIndex
 	}
 }
 
-static CXBool InterchangeWriteGMLAttributeLines(
-	FILE *file,
+static const char InterchangeIndent[] = "        ";
+
+static CXBool InterchangeWriteGMLAttributeLines(CXTextWriter *out, const InterchangeColumnList *columns, CXIndex index, int indent) {
+	for (size_t c = 0; c < columns->count; c += 1) {
+		const InterchangeColumn *column = &columns->items[c];
+		const uint8_t *ptr = InterchangeAttributeValuePtr(column->attr, index);
+		if (!ptr) {
+			return CXFalse;
+		}
+		size_t dimension = column->attr->dimension > 0 ? (size_t)column->attr->dimension : 1u;
+		for (size_t component = 0; component < dimension; component += 1) {
+			CXTextWriterWrite(out, InterchangeIndent, (size_t)indent);
+			CXTextWriterPuts(out, column->key);
+			if (dimension > 1u) {
+				CXTextWriterPutChar(out, '_');
+				CXTextWriterWriteUInt64(out, (uint64_t)component);
+			}
+			CXTextWriterPutChar(out, ' ');
+			if (!InterchangeWriteGMLScalar(out, column, ptr + component * column->attr->elementSize)) {
+				return CXFalse;
+			}
+			CXTextWriterPutChar(out, '\n');
+		}
+	}
+	return !out->failed;
+}
+
+static CXBool InterchangeCollectNodeLinkJSONColumns(
 	CXStringDictionaryRef dictionary,
-	CXIndex index,
 	InterchangeScope scope,
-	int indent
+	const char **reserved,
+	size_t reservedCount,
+	InterchangeColumnList *list
 ) {
-	if (!dictionary) {
-		return CXTrue;
-	}
-	CXStringDictionaryRef usedNames = CXNewStringDictionary();
-	if (!usedNames) {
+	if (!InterchangeColumnListReserve(dictionary, list)) {
 		return CXFalse;
 	}
+	if (!list->items) {
+		return CXTrue;
+	}
 	CXStringDictionaryFOR(entry, dictionary) {
 		CXAttributeRef attr = (CXAttributeRef)entry->data;
 		if (!attr) {
 			continue;
 		}
-		if (!InterchangeAttributeSupportedForGML(attr)) {
-			InterchangeWarningAppend("GML skipped unsupported %s attribute \"%s\"", InterchangeScopeLabel(scope), entry->key);
+		if (!InterchangeAttributeSupportedForNodeLinkJSON(attr)) {
+			InterchangeWarningAppend("node-link JSON skipped unsupported %s attribute \"%s\"", InterchangeScopeLabel(scope), entry->key);
 			continue;
 		}
-		CXBool renamed = CXFalse;
-		char *safeBase = InterchangeSanitizeGMLKey(entry->key, scope, usedNames, &renamed);
-		if (!safeBase) {
-			CXStringDictionaryDestroy(usedNames);
-			return CXFalse;
-		}
-		if (renamed) {
-			InterchangeWarningAppend("GML renamed %s attribute \"%s\" to \"%s\"", InterchangeScopeLabel(scope), entry->key, safeBase);
-		}
-		size_t dimension = attr->dimension > 0 ? (size_t)attr->dimension : 1u;
-		if (dimension == 1u) {
-			for (int i = 0; i < indent; i++) {
-				fputc(' ', file);
-			}
-			fprintf(file, "%s ", safeBase);
-			if (!InterchangeWriteGMLScalar(file, attr, index)) {
-				fputc('\n', file);
-				free(safeBase);
-				CXStringDictionaryDestroy(usedNames);
-				return CXFalse;
-			}
-			fputc('\n', file);
-		} else {
-			for (size_t component = 0; component < dimension; component += 1) {
-				char *componentName = CXNewStringFromFormat("%s_%zu", safeBase, component);
-				if (!componentName) {
-					free(safeBase);
-					CXStringDictionaryDestroy(usedNames);
-					return CXFalse;
-				}
-				for (int i = 0; i < indent; i++) {
-					fputc(' ', file);
-				}
-				fprintf(file, "%s ", componentName);
-				CXAttribute temp = *attr;
-				temp.dimension = 1;
-				temp.data = ((uint8_t *)InterchangeAttributeValuePtr(attr, index)) + component * attr->elementSize;
-				temp.stride = attr->elementSize;
-				if (!InterchangeWriteGMLScalar(file, &temp, 0)) {
-					free(componentName);
-					free(safeBase);
-					CXStringDictionaryDestroy(usedNames);
-					return CXFalse;
-				}
-				fputc('\n', file);
-				free(componentName);
+		InterchangeColumn *column = &list->items[list->count++];
+		column->attr = attr;
+		column->name = entry->key;
+		for (size_t r = 0; r < reservedCount; r += 1) {
+			if (strcmp(entry->key, reserved[r]) == 0) {
+				column->reserved = CXTrue;
+				list->hasReserved = CXTrue;
+				break;
 			}
-			InterchangeWarningAppend("GML flattened multi-dimensional %s attribute \"%s\"", InterchangeScopeLabel(scope), entry->key);
 		}
-		free(safeBase);
+		if (!InterchangeCategoryLabelsBuild(attr, &column->labels)) {
+			InterchangeColumnListFree(list);
+			return CXFalse;
+		}
 	}
-	CXStringDictionaryDestroy(usedNames);
-	return !ferror(file);
+	if (list->hasReserved) {
+		InterchangeWarningAppend("node-link JSON moved reserved %s attributes into \"attributes\"", InterchangeScopeLabel(scope));
+	}
+	return CXTrue;
 }
 
-static void InterchangeWriteJSONNumber(FILE *file, double value) {
+static void InterchangeWriteJSONNumber(CXTextWriter *out, double value) {
 	if (isfinite(value)) {
-		fprintf(file, "%.17g", value);
+		CXTextWriterWriteDouble(out, value);
 	} else {
-		fputs("null", file);
+		CXTextWriterPuts(out, "null");
 	}
 }
 
-static void InterchangeWriteJSONInteger64(FILE *file, int64_t value) {
-	fprintf(file, "%" PRId64, value);
+static void InterchangeWriteJSONFloat(CXTextWriter *out, float value) {
+	if (isfinite(value)) {
+		CXTextWriterWriteFloat(out, value);
+	} else {
+		CXTextWriterPuts(out, "null");
+	}
 }
 
-static void InterchangeWriteJSONUnsigned64(FILE *file, uint64_t value) {
-	fprintf(file, "%" PRIu64, value);
+static void InterchangeWriteJSONCategory(CXTextWriter *out, const InterchangeColumn *column, int32_t id) {
+	const char *label = InterchangeCategoryLabelForId(&column->labels, id);
+	if (label) {
+		InterchangeWriteJSONEscapedString(out, label);
+	} else {
+		CXTextWriterWriteInt64(out, id);
+	}
 }
 
-static CXBool InterchangeWriteNodeLinkJSONValue(FILE *file, CXAttributeRef attr, CXIndex index) {
-	if (!attr) {
-		return CXFalse;
+static CXBool InterchangeWriteNodeLinkJSONScalar(CXTextWriter *out, const InterchangeColumn *column, const void *ptr) {
+	switch (column->attr->type) {
+		case CXBooleanAttributeType:
+			CXTextWriterPuts(out, *((const uint8_t *)ptr) ? "true" : "false");
+			return CXTrue;
+		case CXFloatAttributeType:
+			InterchangeWriteJSONFloat(out, *((const float *)ptr));
+			return CXTrue;
+		case CXDoubleAttributeType:
+			InterchangeWriteJSONNumber(out, *((const double *)ptr));
+			return CXTrue;
+		case CXIntegerAttributeType:
+			CXTextWriterWriteInt64(out, *((const int32_t *)ptr));
+			return CXTrue;
+		case CXUnsignedIntegerAttributeType:
+			CXTextWriterWriteUInt64(out, *((const uint32_t *)ptr));
+			return CXTrue;
+		case CXBigIntegerAttributeType:
+			CXTextWriterWriteInt64(out, *((const int64_t *)ptr));
+			return CXTrue;
+		case CXUnsignedBigIntegerAttributeType:
+			CXTextWriterWriteUInt64(out, *((const uint64_t *)ptr));
+			return CXTrue;
+		case CXStringAttributeType: {
+			CXString value = *((const CXString *)ptr);
+			if (!value) {
+				CXTextWriterPuts(out, "null");
+			} else {
+				InterchangeWriteJSONEscapedString(out, value);
+			}
+			return CXTrue;
+		}
+		case CXDataAttributeCategoryType:
+			InterchangeWriteJSONCategory(out, column, *((const int32_t *)ptr));
+			return CXTrue;
+		default:
+			return CXFalse;
 	}
+}
+
+static CXBool InterchangeWriteNodeLinkJSONValue(CXTextWriter *out, const InterchangeColumn *column, CXIndex index) {
+	CXAttributeRef attr = column->attr;
 	if (attr->type == CXDataAttributeMultiCategoryType) {
 		if (!attr->multiCategory) {
-			fputs("[]", file);
+			CXTextWriterPuts(out, "[]");
 			return CXTrue;
 		}
 		uint32_t *offsets = attr->multiCategory->offsets;
@@ -478,313 +600,243 @@ static CXBool InterchangeWriteNodeLinkJSONValue(FILE *file, CXAttributeRef attr,
 		float *weights = attr->multiCategory->weights;
 		CXSize entryCount = attr->multiCategory->entryCount;
 		if (!offsets || index + 1 >= attr->capacity) {
-			fputs("[]", file);
+			CXTextWriterPuts(out, "[]");
 			return CXTrue;
 		}
 		uint32_t start = offsets[index];
 		uint32_t end = offsets[index + 1];
 		if (end < start || end > (uint32_t)entryCount) {
-			fputs("[]", file);
+			CXTextWriterPuts(out, "[]");
 			return CXTrue;
 		}
-		fputc('[', file);
+		CXTextWriterPutChar(out, '[');
 		for (uint32_t cursor = start; cursor < end; cursor += 1) {
 			if (cursor > start) {
-				fputs(", ", file);
+				CXTextWriterPuts(out, ", ");
 			}
 			int32_t categoryId = (int32_t)ids[cursor];
-			const char *label = InterchangeCategoryLabelForId(attr, categoryId);
 			if (attr->multiCategory->hasWeights && weights) {
-				fputs("{\"label\": ", file);
-				if (label) {
-					InterchangeWriteJSONEscapedString(file, label);
-				} else {
-					InterchangeWriteJSONInteger64(file, categoryId);
-				}
-				fputs(", \"weight\": ", file);
-				InterchangeWriteJSONNumber(file, weights[cursor]);
-				fputc('}', file);
-			} else if (label) {
-				InterchangeWriteJSONEscapedString(file, label);
+				CXTextWriterPuts(out, "{\"label\": ");
+				InterchangeWriteJSONCategory(out, column, categoryId);
+				CXTextWriterPuts(out, ", \"weight\": ");
+				InterchangeWriteJSONFloat(out, weights[cursor]);
+				CXTextWriterPutChar(out, '}');
 			} else {
-				InterchangeWriteJSONInteger64(file, categoryId);
+				InterchangeWriteJSONCategory(out, column, categoryId);
 			}
 		}
-		fputc(']', file);
+		CXTextWriterPutChar(out, ']');
 		return CXTrue;
 	}
-	void *ptr = InterchangeAttributeValuePtr(attr, index);
+	const uint8_t *ptr = InterchangeAttributeValuePtr(attr, index);
 	if (!ptr) {
-		fputs("null", file);
+		CXTextWriterPuts(out, "null");
 		return CXTrue;
 	}
 	size_t dimension = attr->dimension > 0 ? (size_t)attr->dimension : 1u;
-	if (dimension > 1u) {
-		fputc('[', file);
-		for (size_t component = 0; component < dimension; component += 1) {
-			if (component > 0) {
-				fputs(", ", file);
-			}
-			CXAttribute temp = *attr;
-			temp.dimension = 1;
-			temp.data = ((uint8_t *)ptr) + component * attr->elementSize;
-			temp.stride = attr->elementSize;
-			if (!InterchangeWriteNodeLinkJSONValue(file, &temp, 0)) {
-				return CXFalse;
-			}
-		}
-		fputc(']', file);
-		return CXTrue;
+	if (dimension == 1u) {
+		return InterchangeWriteNodeLinkJSONScalar(out, column, ptr);
 	}
-	switch (attr->type) {
-		case CXBooleanAttributeType:
-			fputs(*((uint8_t *)ptr) ? "true" : "false", file);
-			return CXTrue;
-		case CXFloatAttributeType:
-			InterchangeWriteJSONNumber(file, *((float *)ptr));
-			return CXTrue;
-		case CXDoubleAttributeType:
-			InterchangeWriteJSONNumber(file, *((double *)ptr));
-			return CXTrue;
-		case CXIntegerAttributeType:
-			fprintf(file, "%" PRId32, *((int32_t *)ptr));
-			return CXTrue;
-		case CXUnsignedIntegerAttributeType:
-			fprintf(file, "%" PRIu32, *((uint32_t *)ptr));
-			return CXTrue;
-		case CXBigIntegerAttributeType:
-			InterchangeWriteJSONInteger64(file, *((int64_t *)ptr));
-			return CXTrue;
-		case CXUnsignedBigIntegerAttributeType:
-			InterchangeWriteJSONUnsigned64(file, *((uint64_t *)ptr));
-			return CXTrue;
-		case CXStringAttributeType: {
-			CXString value = *((CXString *)ptr);
-			if (!value) {
-				fputs("null", file);
-			} else {
-				InterchangeWriteJSONEscapedString(file, value);
-			}
-			return CXTrue;
-		}
-		case CXDataAttributeCategoryType: {
-			int32_t raw = *((int32_t *)ptr);
-			const char *label = InterchangeCategoryLabelForId(attr, raw);
-			if (label) {
-				InterchangeWriteJSONEscapedString(file, label);
-			} else {
-				fprintf(file, "%" PRId32, raw);
-			}
-			return CXTrue;
+	CXTextWriterPutChar(out, '[');
+	for (size_t component = 0; component < dimension; component += 1) {
+		if (component > 0) {
+			CXTextWriterPuts(out, ", ");
 		}
-		default:
+		if (!InterchangeWriteNodeLinkJSONScalar(out, column, ptr + component * attr->elementSize)) {
 			return CXFalse;
+		}
 	}
+	CXTextWriterPutChar(out, ']');
+	return CXTrue;
 }
 
-static CXBool InterchangeWriteNodeLinkJSONObjectAttributes(
-	FILE *file,
-	CXStringDictionaryRef dictionary,
-	CXIndex index,
-	InterchangeScope scope,
-	const char **reserved,
-	size_t reservedCount
-) {
-	if (!dictionary) {
-		return CXTrue;
-	}
-	CXBool firstInline = CXTrue;
-	CXBool needsReservedObject = CXFalse;
-	CXStringDictionaryFOR(entry, dictionary) {
-		CXAttributeRef attr = (CXAttributeRef)entry->data;
-		if (!attr) {
-			continue;
-		}
-		if (!InterchangeAttributeSupportedForNodeLinkJSON(attr)) {
-			InterchangeWarningAppend("node-link JSON skipped unsupported %s attribute \"%s\"", InterchangeScopeLabel(scope), entry->key);
-			continue;
-		}
-		CXBool isReserved = CXFalse;
-		for (size_t r = 0; r < reservedCount; r += 1) {
-			if (strcmp(entry->key, reserved[r]) == 0) {
-				isReserved = CXTrue;
-				break;
-			}
-		}
-		if (isReserved) {
-			needsReservedObject = CXTrue;
+static CXBool InterchangeWriteNodeLinkJSONMember(CXTextWriter *out, const InterchangeColumn *column, CXIndex index) {
+	InterchangeWriteJSONEscapedString(out, column->name);
+	CXTextWriterPuts(out, ": ");
+	return InterchangeWriteNodeLinkJSONValue(out, column, index);
+}
+
+static CXBool InterchangeWriteNodeLinkJSONObjectAttributes(CXTextWriter *out, const InterchangeColumnList *columns, CXIndex index) {
+	for (size_t c = 0; c < columns->count; c += 1) {
+		if (columns->items[c].reserved) {
 			continue;
 		}
-		fputs(", ", file);
-		InterchangeWriteJSONEscapedString(file, entry->key);
-		fputs(": ", file);
-		if (!InterchangeWriteNodeLinkJSONValue(file, attr, index)) {
+		CXTextWriterPuts(out, ", ");
+		if (!InterchangeWriteNodeLinkJSONMember(out, &columns->items[c], index)) {
 			return CXFalse;
 		}
-		firstInline = CXFalse;
-		(void)firstInline;
 	}
-	if (needsReservedObject) {
-		fputs(", \"attributes\": {", file);
+	if (columns->hasReserved) {
+		CXTextWriterPuts(out, ", \"attributes\": {");
 		CXBool firstReserved = CXTrue;
-		CXStringDictionaryFOR(entry, dictionary) {
-			CXAttributeRef attr = (CXAttributeRef)entry->data;
-			if (!attr || !InterchangeAttributeSupportedForNodeLinkJSON(attr)) {
-				continue;
-			}
-			CXBool isReserved = CXFalse;
-			for (size_t r = 0; r < reservedCount; r += 1) {
-				if (strcmp(entry->key, reserved[r]) == 0) {
-					isReserved = CXTrue;
-					break;
-				}
-			}
-			if (!isReserved) {
+		for (size_t c = 0; c < columns->count; c += 1) {
+			if (!columns->items[c].reserved) {
 				continue;
 			}
 			if (!firstReserved) {
-				fputs(", ", file);
+				CXTextWriterPuts(out, ", ");
 			}
 			firstReserved = CXFalse;
-			InterchangeWriteJSONEscapedString(file, entry->key);
-			fputs(": ", file);
-			if (!InterchangeWriteNodeLinkJSONValue(file, attr, index)) {
+			if (!InterchangeWriteNodeLinkJSONMember(out, &columns->items[c], index)) {
 				return CXFalse;
 			}
 		}
-		fputc('}', file);
-		InterchangeWarningAppend("node-link JSON moved reserved %s attributes into \"attributes\"", InterchangeScopeLabel(scope));
+		CXTextWriterPutChar(out, '}');
 	}
-	return !ferror(file);
+	return !out->failed;
 }
 
-CXBool CXNetworkWriteNodeLinkJSON(CXNetworkRef network, const char *path) {
-	InterchangeWarningClear();
-	if (!network || !path) {
-		errno = EINVAL;
-		return CXFalse;
+static CXBool InterchangeWriteNodeLinkJSONDocument(
+	CXTextWriter *out,
+	CXNetworkRef network,
+	const InterchangeColumnList *graphColumns,
+	const InterchangeColumnList *nodeColumns,
+	const InterchangeColumnList *edgeColumns
+) {
+	CXTextWriterPuts(out, "{\n  \"directed\": ");
+	CXTextWriterPuts(out, network->isDirected ? "true" : "false");
+	CXTextWriterPuts(out, ",\n  \"multigraph\": false,\n  \"graph\": {");
+	for (size_t c = 0; c < graphColumns->count; c += 1) {
+		if (c > 0) {
+			CXTextWriterPuts(out, ", ");
+		}
+		if (!InterchangeWriteNodeLinkJSONMember(out, &graphColumns->items[c], 0)) {
+			return CXFalse;
+		}
 	}
-	FILE *file = fopen(path, "wb");
-	if (!file) {
-		return CXFalse;
-	}
-	const char *nodeReserved[] = { "id", "attributes" };
-	const char *edgeReserved[] = { "source", "target", "attributes" };
-	fputs("{\n  \"directed\": ", file);
-	fputs(network->isDirected ? "true" : "false", file);
-	fputs(",\n  \"multigraph\": false,\n  \"graph\": {", file);
-	CXBool firstGraph = CXTrue;
-	if (network->networkAttributes) {
-		CXStringDictionaryFOR(entry, network->networkAttributes) {
-			CXAttributeRef attr = (CXAttributeRef)entry->data;
-			if (!attr) {
-				continue;
-			}
-			if (!InterchangeAttributeSupportedForNodeLinkJSON(attr)) {
-				InterchangeWarningAppend("node-link JSON skipped unsupported graph attribute \"%s\"", entry->key);
-				continue;
-			}
-			if (!firstGraph) {
-				fputs(", ", file);
-			}
-			firstGraph = CXFalse;
-			InterchangeWriteJSONEscapedString(file, entry->key);
-			fputs(": ", file);
-			if (!InterchangeWriteNodeLinkJSONValue(file, attr, 0)) {
-				fclose(file);
-				return CXFalse;
-			}
-		}
-	}
-	fputs("},\n  \"nodes\": [", file);
+	CXTextWriterPuts(out, "},\n  \"nodes\": [");
 	CXBool firstNode = CXTrue;
 	for (CXIndex node = 0; node < network->nodeCapacity; node += 1) {
 		if (!network->nodeActive || !network->nodeActive[node]) {
 			continue;
 		}
 		if (!firstNode) {
-			fputs(",", file);
+			CXTextWriterPutChar(out, ',');
 		}
 		firstNode = CXFalse;
-		fprintf(file, "\n    {\"id\": %" PRIu64, (uint64_t)node);
-		if (!InterchangeWriteNodeLinkJSONObjectAttributes(file, network->nodeAttributes, node, InterchangeScopeNode, nodeReserved, 2)) {
-			fclose(file);
+		CXTextWriterPuts(out, "\n    {\"id\": ");
+		CXTextWriterWriteUInt64(out, (uint64_t)node);
+		if (!InterchangeWriteNodeLinkJSONObjectAttributes(out, nodeColumns, node)) {
 			return CXFalse;
 		}
-		fputc('}', file);
+		CXTextWriterPutChar(out, '}');
 	}
-	fputs("\n  ],\n  \"links\": [", file);
+	CXTextWriterPuts(out, "\n  ],\n  \"links\": [");
 	CXBool firstEdge = CXTrue;
 	for (CXIndex edge = 0; edge < network->edgeCapacity; edge += 1) {
 		if (!network->edgeActive || !network->edgeActive[edge]) {
 			continue;
 		}
 		if (!firstEdge) {
-			fputs(",", file);
+			CXTextWriterPutChar(out, ',');
 		}
 		firstEdge = CXFalse;
-		fprintf(
-			file,
-			"\n    {\"source\": %" PRIu64 ", \"target\": %" PRIu64,
-			(uint64_t)network->edges[edge].from,
-			(uint64_t)network->edges[edge].to
-		);
-		if (!InterchangeWriteNodeLinkJSONObjectAttributes(file, network->edgeAttributes, edge, InterchangeScopeEdge, edgeReserved, 3)) {
-			fclose(file);
+		CXTextWriterPuts(out, "\n    {\"source\": ");
+		CXTextWriterWriteUInt64(out, (uint64_t)network->edges[edge].from);
+		CXTextWriterPuts(out, ", \"target\": ");
+		CXTextWriterWriteUInt64(out, (uint64_t)network->edges[edge].to);
+		if (!InterchangeWriteNodeLinkJSONObjectAttributes(out, edgeColumns, edge)) {
 			return CXFalse;
 		}
-		fputc('}', file);
+		CXTextWriterPutChar(out, '}');
 	}
-	fputs("\n  ]\n}\n", file);
-	CXBool ok = !ferror(file);
-	fclose(file);
-	return ok;
+	CXTextWriterPuts(out, "\n  ]\n}\n");
+	return !out->failed;
 }
 
-CXBool CXNetworkWriteGML(CXNetworkRef network, const char *path) {
+CXBool CXNetworkWriteNodeLinkJSON(CXNetworkRef network, const char *path) {
 	InterchangeWarningClear();
 	if (!network || !path) {
 		errno = EINVAL;
 		return CXFalse;
 	}
-	FILE *file = fopen(path, "wb");
-	if (!file) {
+	CXTextWriter out;
+	if (!CXTextWriterOpen(&out, path)) {
 		return CXFalse;
 	}
-	fputs("graph [\n", file);
-	fprintf(file, "  directed %u\n", network->isDirected ? 1u : 0u);
-	if (!InterchangeWriteGMLAttributeLines(file, network->networkAttributes, 0, InterchangeScopeGraph, 2)) {
-		fclose(file);
+	const char *nodeReserved[] = { "id", "attributes" };
+	const char *edgeReserved[] = { "source", "target", "attributes" };
+	InterchangeColumnList graphColumns = { NULL, 0, CXFalse };
+	InterchangeColumnList nodeColumns = { NULL, 0, CXFalse };
+	InterchangeColumnList edgeColumns = { NULL, 0, CXFalse };
+	CXBool ok = InterchangeCollectNodeLinkJSONColumns(network->networkAttributes, InterchangeScopeGraph, NULL, 0, &graphColumns) &&
+		InterchangeCollectNodeLinkJSONColumns(network->nodeAttributes, InterchangeScopeNode, nodeReserved, 2, &nodeColumns) &&
+		InterchangeCollectNodeLinkJSONColumns(network->edgeAttributes, InterchangeScopeEdge, edgeReserved, 3, &edgeColumns) &&
+		InterchangeWriteNodeLinkJSONDocument(&out, network, &graphColumns, &nodeColumns, &edgeColumns);
+	InterchangeColumnListFree(&graphColumns);
+	InterchangeColumnListFree(&nodeColumns);
+	InterchangeColumnListFree(&edgeColumns);
+	if (!CXTextWriterClose(&out)) {
+		ok = CXFalse;
+	}
+	return ok;
+}
+
+static CXBool InterchangeWriteGMLDocument(
+	CXTextWriter *out,
+	CXNetworkRef network,
+	const InterchangeColumnList *graphColumns,
+	const InterchangeColumnList *nodeColumns,
+	const InterchangeColumnList *edgeColumns
+) {
+	CXTextWriterPuts(out, "graph [\n");
+	CXTextWriterPuts(out, network->isDirected ? "  directed 1\n" : "  directed 0\n");
+	if (!InterchangeWriteGMLAttributeLines(out, graphColumns, 0, 2)) {
 		return CXFalse;
 	}
 	for (CXIndex node = 0; node < network->nodeCapacity; node += 1) {
 		if (!network->nodeActive || !network->nodeActive[node]) {
 			continue;
 		}
-		fputs("  node [\n", file);
-		fprintf(file, "    id %" PRIu64 "\n", (uint64_t)node);
-		if (!InterchangeWriteGMLAttributeLines(file, network->nodeAttributes, node, InterchangeScopeNode, 4)) {
-			fclose(file);
+		CXTextWriterPuts(out, "  node [\n    id ");
+		CXTextWriterWriteUInt64(out, (uint64_t)node);
+		CXTextWriterPutChar(out, '\n');
+		if (!InterchangeWriteGMLAttributeLines(out, nodeColumns, node, 4)) {
 			return CXFalse;
 		}
-		fputs("  ]\n", file);
+		CXTextWriterPuts(out, "  ]\n");
 	}
 	for (CXIndex edge = 0; edge < network->edgeCapacity; edge += 1) {
 		if (!network->edgeActive || !network->edgeActive[edge]) {
 			continue;
 		}
-		fputs("  edge [\n", file);
-		fprintf(file, "    source %" PRIu64 "\n", (uint64_t)network->edges[edge].from);
-		fprintf(file, "    target %" PRIu64 "\n", (uint64_t)network->edges[edge].to);
-		if (!InterchangeWriteGMLAttributeLines(file, network->edgeAttributes, edge, InterchangeScopeEdge, 4)) {
-			fclose(file);
+		CXTextWriterPuts(out, "  edge [\n    source ");
+		CXTextWriterWriteUInt64(out, (uint64_t)network->edges[edge].from);
+		CXTextWriterPuts(out, "\n    target ");
+		CXTextWriterWriteUInt64(out, (uint64_t)network->edges[edge].to);
+		CXTextWriterPutChar(out, '\n');
+		if (!InterchangeWriteGMLAttributeLines(out, edgeColumns, edge, 4)) {
 			return CXFalse;
 		}
-		fputs("  ]\n", file);
+		CXTextWriterPuts(out, "  ]\n");
+	}
+	CXTextWriterPuts(out, "]\n");
+	return !out->failed;
+}
+
+CXBool CXNetworkWriteGML(CXNetworkRef network, const char *path) {
+	InterchangeWarningClear();
+	if (!network || !path) {
+		errno = EINVAL;
+		return CXFalse;
+	}
+	CXTextWriter out;
+	if (!CXTextWriterOpen(&out, path)) {
+		return CXFalse;
+	}
+	InterchangeColumnList graphColumns = { NULL, 0, CXFalse };
+	InterchangeColumnList nodeColumns = { NULL, 0, CXFalse };
+	InterchangeColumnList edgeColumns = { NULL, 0, CXFalse };
+	CXBool ok = InterchangeCollectGMLColumns(network->networkAttributes, InterchangeScopeGraph, &graphColumns) &&
+		InterchangeCollectGMLColumns(network->nodeAttributes, InterchangeScopeNode, &nodeColumns) &&
+		InterchangeCollectGMLColumns(network->edgeAttributes, InterchangeScopeEdge, &edgeColumns) &&
+		InterchangeWriteGMLDocument(&out, network, &graphColumns, &nodeColumns, &edgeColumns);
+	InterchangeColumnListFree(&graphColumns);
+	InterchangeColumnListFree(&nodeColumns);
+	InterchangeColumnListFree(&edgeColumns);
+	if (!CXTextWriterClose(&out)) {
+		ok = CXFalse;
 	}
-	fputs("]\n", file);
-	CXBool ok = !ferror(file);
-	fclose(file);
 	return ok;
 }
 
@@ -798,84 +850,41 @@ typedef enum {
 	GMLTokenRBracket = 6
 } GMLTokenType;
 
+/**
+ * Tokens point into the input, except quoted strings with escapes, which are
+ * decoded into one of the lexer's two scratch buffers. The buffers alternate,
+ * so a key stays readable while the token after it (its value) is current.
+ */
 typedef struct {
 	GMLTokenType type;
-	char *text;
+	const char *text;
+	size_t length;
 	int64_t integerValue;
 	double realValue;
-	size_t line;
-	size_t column;
 } GMLToken;
 
 typedef struct {
-	char *text;
+	const char *text;
 	size_t length;
 	size_t offset;
-	size_t line;
-	size_t column;
 	GMLToken current;
+	char *scratch[2];
+	size_t scratchCapacity[2];
+	unsigned int scratchIndex;
 	char *error;
 } GMLLexer;
 
-typedef enum {
-	GMLValueString = 0,
-	GMLValueInteger = 1,
-	GMLValueReal = 2,
-	GMLValueList = 3
-} GMLValueType;
-
-typedef struct GMLValue GMLValue;
-
 typedef struct {
-	char *key;
-	GMLValue *value;
-} GMLPair;
+	char *data;
+	size_t size;
+	CXBool mapped;
+} GMLInput;
 
+/** Reusable NUL-terminated copy of a token, for dictionary lookups. */
 typedef struct {
-	GMLPair *items;
-	size_t count;
+	char *data;
 	size_t capacity;
-} GMLList;
-
-struct GMLValue {
-	GMLValueType type;
-	union {
-		char *stringValue;
-		int64_t integerValue;
-		double realValue;
-		GMLList listValue;
-	} as;
-};
-
-typedef struct {
-	char *idText;
-	GMLList attributes;
-} GMLParsedNode;
-
-typedef struct {
-	char *sourceText;
-	char *targetText;
-	GMLList attributes;
-} GMLParsedEdge;
-
-typedef struct {
-	GMLParsedNode *items;
-	size_t count;
-	size_t capacity;
-} GMLParsedNodeList;
-
-typedef struct {
-	GMLParsedEdge *items;
-	size_t count;
-	size_t capacity;
-} GMLParsedEdgeList;
-
-typedef struct {
-	CXBool directed;
-	GMLList graphAttributes;
-	GMLParsedNodeList nodes;
-	GMLParsedEdgeList edges;
-} GMLParsedGraph;
+} GMLText;
 
 typedef enum {
 	GMLInferUnknown = 0,
@@ -895,17 +904,171 @@ typedef struct {
 	CXBool coercedToString;
 } GMLAttributeInfer;
 
-static void GMLValueFree(GMLValue *value);
+/**
+ * Key resolved at a given position of a record: the inference slot during the
+ * first pass, the attribute during the second. Records written by the same
+ * tool repeat their keys in the same order, so most lookups end here.
+ */
+typedef struct {
+	char *key;
+	size_t length;
+	void *target;
+} GMLKeyHint;
 
-static void GMLTokenDispose(GMLToken *token) {
-	if (!token) {
-		return;
+typedef struct {
+	GMLKeyHint *items;
+	size_t capacity;
+} GMLKeyHints;
+
+/** Edge endpoint whose node had not been seen when the edge was read. */
+typedef struct {
+	size_t edge;
+	CXBool isTarget;
+	char *id;
+} GMLPendingEndpoint;
+
+/**
+ * State of the two-pass reader. The first pass validates the document, keeps
+ * one id per node and one endpoint pair per edge, and infers attribute types;
+ * the second pass re-lexes the input and writes values into the columns.
+ */
+typedef struct {
+	GMLLexer lexer;
+	CXBool assigning;
+	CXBool directed;
+	GMLText keyText;
+	GMLText idText;
+	GMLText sourceText;
+	GMLText targetText;
+	GMLKeyHints hints[3];
+	CXStringDictionaryRef infer[3];
+
+	char **nodeIds;
+	size_t nodeCount;
+	size_t nodeCapacity;
+	size_t nodeRecords;
+	size_t syntheticIds;
+	CXStringDictionaryRef nodeIdMap;
+	size_t *duplicates;
+	size_t duplicateCount;
+	size_t duplicateCapacity;
+
+	CXEdge *edges;
+	size_t edgeCount;
+	size_t edgeCapacity;
+	size_t edgeRecords;
+	GMLPendingEndpoint *pending;
+	size_t pendingCount;
+	size_t pendingCapacity;
+
+	CXNetworkRef network;
+	CXIndex *nodeIndices;
+	CXIndex *edgeIndices;
+} GMLReader;
+
+static CXBool GMLInputOpen(GMLInput *input, const char *path) {
+#if !defined(_WIN32)
+	int fd = open(path, O_RDONLY);
+	if (fd < 0) {
+		return CXFalse;
 	}
-	free(token->text);
-	token->text = NULL;
-	token->type = GMLTokenEOF;
-	token->integerValue = 0;
-	token->realValue = 0.0;
+	struct stat info;
+	if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0 &&
+		(uint64_t)info.st_size <= (uint64_t)SIZE_MAX) {
+		size_t length = (size_t)info.st_size;
+		void *data = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (data != MAP_FAILED) {
+			close(fd);
+			input->data = data;
+			input->size = length;
+			input->mapped = CXTrue;
+			return CXTrue;
+		}
+	}
+	close(fd);
+#endif
+	FILE *file = fopen(path, "rb");
+	if (!file) {
+		return CXFalse;
+	}
+	size_t capacity = 1 << 16;
+	size_t length = 0;
+	char *data = malloc(capacity);
+	while (data) {
+		length += fread(data + length, 1, capacity - length, file);
+		if (length < capacity) {
+			break;
+		}
+		char *grown = realloc(data, capacity * 2);
+		if (!grown) {
+			free(data);
+			data = NULL;
+			break;
+		}
+		data = grown;
+		capacity *= 2;
+	}
+	CXBool failed = !data || ferror(file);
+	fclose(file);
+	if (failed) {
+		free(data);
+		return CXFalse;
+	}
+	input->data = data;
+	input->size = length;
+	input->mapped = CXFalse;
+	return CXTrue;
+}
+
+static void GMLInputClose(GMLInput *input) {
+#if !defined(_WIN32)
+	if (input->mapped) {
+		munmap(input->data, input->size);
+	} else {
+		free(input->data);
+	}
+#else
+	free(input->data);
+#endif
+	input->data = NULL;
+	input->size = 0;
+}
+
+static CXBool GMLReserve(void **items, size_t *capacity, size_t required, size_t itemSize) {
+	if (*capacity >= required) {
+		return CXTrue;
+	}
+	size_t newCapacity = *capacity > 0 ? *capacity : 16;
+	while (newCapacity < required) {
+		newCapacity = CXCapacityGrow(newCapacity);
+	}
+	void *grown = realloc(*items, newCapacity * itemSize);
+	if (!grown) {
+		return CXFalse;
+	}
+	*items = grown;
+	*capacity = newCapacity;
+	return CXTrue;
+}
+
+static const char* GMLTextAssign(GMLText *text, const char *data, size_t length) {
+	if (text->capacity < length + 1) {
+		size_t capacity = text->capacity > 0 ? text->capacity : 64;
+		while (capacity < length + 1) {
+			capacity *= 2;
+		}
+		char *grown = realloc(text->data, capacity);
+		if (!grown) {
+			return NULL;
+		}
+		text->data = grown;
+		text->capacity = capacity;
+	}
+	if (length > 0) {
+		memcpy(text->data, data, length);
+	}
+	text->data[length] = '\0';
+	return text->data;
 }
 
 static void GMLLexerSetError(GMLLexer *lexer, const char *fmt, ...) {
@@ -920,105 +1083,58 @@ static void GMLLexerSetError(GMLLexer *lexer, const char *fmt, ...) {
 	if (!body) {
 		return;
 	}
-	lexer->error = CXNewStringFromFormat("Line %zu, column %zu: %s", lexer->line, lexer->column, body);
-	free(body);
-}
-
-static int GMLLexerPeek(GMLLexer *lexer) {
-	if (!lexer || lexer->offset >= lexer->length) {
-		return EOF;
-	}
-	return (unsigned char)lexer->text[lexer->offset];
-}
-
-static int GMLLexerAdvance(GMLLexer *lexer) {
-	if (!lexer || lexer->offset >= lexer->length) {
-		return EOF;
-	}
-	unsigned char ch = (unsigned char)lexer->text[lexer->offset++];
-	if (ch == '\n') {
-		lexer->line += 1;
-		lexer->column = 1;
-	} else {
-		lexer->column += 1;
+	size_t line = 1;
+	size_t lineStart = 0;
+	size_t end = CXMIN(lexer->offset, lexer->length);
+	for (size_t i = 0; i < end; i += 1) {
+		if (lexer->text[i] == '\n') {
+			line += 1;
+			lineStart = i + 1;
+		}
 	}
-	return ch;
+	lexer->error = CXNewStringFromFormat("Line %zu, column %zu: %s", line, end - lineStart + 1, body);
+	free(body);
 }
 
 static void GMLLexerSkipSpace(GMLLexer *lexer) {
-	for (;;) {
-		int ch = GMLLexerPeek(lexer);
-		if (ch == EOF) {
-			return;
-		}
+	const char *text = lexer->text;
+	size_t offset = lexer->offset;
+	while (offset < lexer->length) {
+		unsigned char ch = (unsigned char)text[offset];
 		if (isspace(ch)) {
-			GMLLexerAdvance(lexer);
+			offset += 1;
 			continue;
 		}
 		if (ch == '#') {
-			while (ch != EOF && ch != '\n') {
-				ch = GMLLexerAdvance(lexer);
-			}
+			const char *newline = memchr(text + offset, '\n', lexer->length - offset);
+			offset = newline ? (size_t)(newline - text) + 1 : lexer->length;
 			continue;
 		}
-		return;
+		break;
 	}
+	lexer->offset = offset;
 }
 
-static char* GMLLexerReadBareToken(GMLLexer *lexer) {
-	size_t start = lexer->offset;
-	while (lexer->offset < lexer->length) {
-		unsigned char ch = (unsigned char)lexer->text[lexer->offset];
-		if (isspace(ch) || ch == '[' || ch == ']' || ch == '#') {
-			break;
+static CXBool GMLLexerScratchAppend(GMLLexer *lexer, size_t *length, const char *data, size_t count) {
+	unsigned int slot = lexer->scratchIndex;
+	if (*length + count + 1 > lexer->scratchCapacity[slot]) {
+		size_t capacity = lexer->scratchCapacity[slot] > 0 ? lexer->scratchCapacity[slot] : 64;
+		while (*length + count + 1 > capacity) {
+			capacity *= 2;
 		}
-		lexer->offset += 1;
-		lexer->column += 1;
-	}
-	size_t len = lexer->offset - start;
-	char *token = calloc(len + 1, sizeof(char));
-	if (!token) {
-		return NULL;
-	}
-	memcpy(token, lexer->text + start, len);
-	token[len] = '\0';
-	return token;
-}
-
-static CXBool GMLLexerAppendChar(char **buffer, size_t *length, size_t *capacity, char ch) {
-	if (*length + 2 > *capacity) {
-		size_t next = *capacity ? (*capacity * 2) : 16u;
-		char *grown = realloc(*buffer, next);
+		char *grown = realloc(lexer->scratch[slot], capacity);
 		if (!grown) {
 			return CXFalse;
 		}
-		*buffer = grown;
-		*capacity = next;
+		lexer->scratch[slot] = grown;
+		lexer->scratchCapacity[slot] = capacity;
 	}
-	(*buffer)[(*length)++] = ch;
-	(*buffer)[*length] = '\0';
+	memcpy(lexer->scratch[slot] + *length, data, count);
+	*length += count;
+	lexer->scratch[slot][*length] = '\0';
 	return CXTrue;
 }
 
-static CXBool GMLLexerAppendUTF8(char **buffer, size_t *length, size_t *capacity, uint32_t codepoint) {
-	if (codepoint <= 0x7Fu) {
-		return GMLLexerAppendChar(buffer, length, capacity, (char)codepoint);
-	}
-	if (codepoint <= 0x7FFu) {
-		return GMLLexerAppendChar(buffer, length, capacity, (char)(0xC0u | ((codepoint >> 6) & 0x1Fu)))
-			&& GMLLexerAppendChar(buffer, length, capacity, (char)(0x80u | (codepoint & 0x3Fu)));
-	}
-	if (codepoint <= 0xFFFFu) {
-		return GMLLexerAppendChar(buffer, length, capacity, (char)(0xE0u | ((codepoint >> 12) & 0x0Fu)))
-			&& GMLLexerAppendChar(buffer, length, capacity, (char)(0x80u | ((codepoint >> 6) & 0x3Fu)))
-			&& GMLLexerAppendChar(buffer, length, capacity, (char)(0x80u | (codepoint & 0x3Fu)));
-	}
-	return GMLLexerAppendChar(buffer, length, capacity, (char)(0xF0u | ((codepoint >> 18) & 0x07u)))
-		&& GMLLexerAppendChar(buffer, length, capacity, (char)(0x80u | ((codepoint >> 12) & 0x3Fu)))
-		&& GMLLexerAppendChar(buffer, length, capacity, (char)(0x80u | ((codepoint >> 6) & 0x3Fu)))
-		&& GMLLexerAppendChar(buffer, length, capacity, (char)(0x80u | (codepoint & 0x3Fu)));
-}
-
 static int GMLHexValue(int ch) {
 	if (ch >= '0' && ch <= '9') {
 		return ch - '0';
@@ -1032,652 +1148,342 @@ static int GMLHexValue(int ch) {
 	return -1;
 }
 
-static char* GMLLexerReadQuotedString(GMLLexer *lexer) {
-	GMLLexerAdvance(lexer);
-	char *buffer = NULL;
+static size_t GMLEncodeUTF8(char *out, uint32_t codepoint) {
+	if (codepoint <= 0x7Fu) {
+		out[0] = (char)codepoint;
+		return 1;
+	}
+	if (codepoint <= 0x7FFu) {
+		out[0] = (char)(0xC0u | ((codepoint >> 6) & 0x1Fu));
+		out[1] = (char)(0x80u | (codepoint & 0x3Fu));
+		return 2;
+	}
+	out[0] = (char)(0xE0u | ((codepoint >> 12) & 0x0Fu));
+	out[1] = (char)(0x80u | ((codepoint >> 6) & 0x3Fu));
+	out[2] = (char)(0x80u | (codepoint & 0x3Fu));
+	return 3;
+}
+
+/**
+ * Reads a quoted string. Strings without escapes are returned as a span of the
+ * input; the others are decoded into the next scratch buffer.
+ */
+static CXBool GMLLexerReadQuotedString(GMLLexer *lexer) {
+	const char *text = lexer->text;
+	size_t start = lexer->offset + 1;
+	size_t offset = start;
+	while (offset < lexer->length && text[offset] != '"' && text[offset] != '\\') {
+		offset += 1;
+	}
+	if (offset < lexer->length && text[offset] == '"') {
+		lexer->current.text = text + start;
+		lexer->current.length = offset - start;
+		lexer->offset = offset + 1;
+		return CXTrue;
+	}
+	lexer->scratchIndex ^= 1u;
 	size_t length = 0;
-	size_t capacity = 0;
+	if (!GMLLexerScratchAppend(lexer, &length, text + start, offset - start)) {
+		return CXFalse;
+	}
 	for (;;) {
-		int ch = GMLLexerPeek(lexer);
-		if (ch == EOF) {
-			free(buffer);
+		if (offset >= lexer->length) {
+			lexer->offset = lexer->length;
 			GMLLexerSetError(lexer, "unterminated string literal");
-			return NULL;
+			return CXFalse;
 		}
-		GMLLexerAdvance(lexer);
+		char ch = text[offset++];
 		if (ch == '"') {
 			break;
 		}
-		if (ch == '\\') {
-			int escaped = GMLLexerPeek(lexer);
-			if (escaped == EOF) {
-				free(buffer);
-				GMLLexerSetError(lexer, "unterminated escape sequence");
-				return NULL;
+		if (ch != '\\') {
+			if (!GMLLexerScratchAppend(lexer, &length, &ch, 1)) {
+				return CXFalse;
 			}
-			GMLLexerAdvance(lexer);
-			switch (escaped) {
-				case '"':
-				case '\\':
-				case '/':
-					if (!GMLLexerAppendChar(&buffer, &length, &capacity, (char)escaped)) {
-						free(buffer);
-						return NULL;
-					}
-					break;
-				case 'b':
-					if (!GMLLexerAppendChar(&buffer, &length, &capacity, '\b')) {
-						free(buffer);
-						return NULL;
-					}
-					break;
-				case 'f':
-					if (!GMLLexerAppendChar(&buffer, &length, &capacity, '\f')) {
-						free(buffer);
-						return NULL;
-					}
-					break;
-				case 'n':
-					if (!GMLLexerAppendChar(&buffer, &length, &capacity, '\n')) {
-						free(buffer);
-						return NULL;
-					}
-					break;
-				case 'r':
-					if (!GMLLexerAppendChar(&buffer, &length, &capacity, '\r')) {
-						free(buffer);
-						return NULL;
-					}
-					break;
-				case 't':
-					if (!GMLLexerAppendChar(&buffer, &length, &capacity, '\t')) {
-						free(buffer);
-						return NULL;
-					}
-					break;
-				case 'u': {
-					uint32_t codepoint = 0;
-					for (int i = 0; i < 4; i += 1) {
-						int hex = GMLLexerPeek(lexer);
-						int value = GMLHexValue(hex);
-						if (value < 0) {
-							free(buffer);
-							GMLLexerSetError(lexer, "invalid unicode escape");
-							return NULL;
-						}
-						GMLLexerAdvance(lexer);
-						codepoint = (codepoint << 4u) | (uint32_t)value;
-					}
-					if (!GMLLexerAppendUTF8(&buffer, &length, &capacity, codepoint)) {
-						free(buffer);
-						return NULL;
+			continue;
+		}
+		if (offset >= lexer->length) {
+			lexer->offset = offset;
+			GMLLexerSetError(lexer, "unterminated escape sequence");
+			return CXFalse;
+		}
+		char escaped = text[offset++];
+		char decoded[4];
+		size_t decodedLength = 1;
+		switch (escaped) {
+			case 'b':
+				decoded[0] = '\b';
+				break;
+			case 'f':
+				decoded[0] = '\f';
+				break;
+			case 'n':
+				decoded[0] = '\n';
+				break;
+			case 'r':
+				decoded[0] = '\r';
+				break;
+			case 't':
+				decoded[0] = '\t';
+				break;
+			case 'u': {
+				uint32_t codepoint = 0;
+				for (int i = 0; i < 4; i += 1) {
+					int value = offset < lexer->length ? GMLHexValue((unsigned char)text[offset]) : -1;
+					if (value < 0) {
+						lexer->offset = offset;
+						GMLLexerSetError(lexer, "invalid unicode escape");
+						return CXFalse;
 					}
-					break;
+					offset += 1;
+					codepoint = (codepoint << 4u) | (uint32_t)value;
 				}
-				default:
-					if (!GMLLexerAppendChar(&buffer, &length, &capacity, (char)escaped)) {
-						free(buffer);
-						return NULL;
-					}
-					break;
+				decodedLength = GMLEncodeUTF8(decoded, codepoint);
+				break;
 			}
-			continue;
+			default:
+				decoded[0] = escaped;
+				break;
 		}
-		if (!GMLLexerAppendChar(&buffer, &length, &capacity, (char)ch)) {
-			free(buffer);
-			return NULL;
+		if (!GMLLexerScratchAppend(lexer, &length, decoded, decodedLength)) {
+			return CXFalse;
 		}
 	}
-	if (!buffer) {
-		buffer = CXNewStringFromString("");
-	}
-	return buffer;
+	lexer->offset = offset;
+	lexer->current.text = lexer->scratch[lexer->scratchIndex];
+	lexer->current.length = length;
+	return CXTrue;
 }
 
-static CXBool GMLLexerNext(GMLLexer *lexer) {
-	if (!lexer) {
-		return CXFalse;
-	}
-	GMLTokenDispose(&lexer->current);
-	GMLLexerSkipSpace(lexer);
-	lexer->current.line = lexer->line;
-	lexer->current.column = lexer->column;
-	int ch = GMLLexerPeek(lexer);
-	if (ch == EOF) {
-		lexer->current.type = GMLTokenEOF;
-		return CXTrue;
-	}
-	if (ch == '[') {
-		GMLLexerAdvance(lexer);
-		lexer->current.type = GMLTokenLBracket;
-		return CXTrue;
-	}
-	if (ch == ']') {
-		GMLLexerAdvance(lexer);
-		lexer->current.type = GMLTokenRBracket;
-		return CXTrue;
-	}
-	if (ch == '"') {
-		char *text = GMLLexerReadQuotedString(lexer);
-		if (!text && lexer->error) {
-			return CXFalse;
+/**
+ * Classifies a bare token. Plain decimal integers are converted inline; any
+ * other token goes through strtoll/strtod on a terminated copy, so the rules
+ * are the same as for the whole-token conversions of earlier versions.
+ */
+static CXBool GMLLexerClassifyBareToken(GMLLexer *lexer) {
+	GMLToken *token = &lexer->current;
+	const char *text = token->text;
+	size_t length = token->length;
+	size_t start = (text[0] == '-' || text[0] == '+') ? 1 : 0;
+	if (length > start && length - start <= 18) {
+		uint64_t value = 0;
+		size_t i = start;
+		while (i < length && text[i] >= '0' && text[i] <= '9') {
+			value = value * 10u + (uint64_t)(text[i] - '0');
+			i += 1;
+		}
+		if (i == length) {
+			token->type = GMLTokenInteger;
+			token->integerValue = text[0] == '-' ? -(int64_t)value : (int64_t)value;
+			return CXTrue;
 		}
-		lexer->current.type = GMLTokenString;
-		lexer->current.text = text ? text : CXNewStringFromString("");
-		return lexer->current.text != NULL;
 	}
-	char *text = GMLLexerReadBareToken(lexer);
-	if (!text) {
+	char stackCopy[64];
+	char *copy = length < sizeof(stackCopy) ? stackCopy : malloc(length + 1);
+	if (!copy) {
 		return CXFalse;
 	}
+	memcpy(copy, text, length);
+	copy[length] = '\0';
+	token->type = GMLTokenIdentifier;
 	char *endInt = NULL;
 	errno = 0;
-	long long parsedInt = strtoll(text, &endInt, 10);
+	long long parsedInt = strtoll(copy, &endInt, 10);
 	if (errno == 0 && endInt && *endInt == '\0') {
-		lexer->current.type = GMLTokenInteger;
-		lexer->current.text = text;
-		lexer->current.integerValue = (int64_t)parsedInt;
-		return CXTrue;
+		token->type = GMLTokenInteger;
+		token->integerValue = (int64_t)parsedInt;
+	} else {
+		char *endReal = NULL;
+		errno = 0;
+		double parsedReal = strtod(copy, &endReal);
+		if (errno == 0 && endReal && *endReal == '\0' && (strchr(copy, '.') || strchr(copy, 'e') || strchr(copy, 'E'))) {
+			token->type = GMLTokenReal;
+			token->realValue = parsedReal;
+		}
 	}
-	char *endReal = NULL;
-	errno = 0;
-	double parsedReal = strtod(text, &endReal);
-	if (errno == 0 && endReal && *endReal == '\0' && (strchr(text, '.') || strchr(text, 'e') || strchr(text, 'E'))) {
-		lexer->current.type = GMLTokenReal;
-		lexer->current.text = text;
-		lexer->current.realValue = parsedReal;
-		return CXTrue;
+	if (copy != stackCopy) {
+		free(copy);
 	}
-	lexer->current.type = GMLTokenIdentifier;
-	lexer->current.text = text;
 	return CXTrue;
 }
 
-static void GMLListFree(GMLList *list) {
-	if (!list) {
-		return;
-	}
-	for (size_t i = 0; i < list->count; i += 1) {
-		free(list->items[i].key);
-		GMLValueFree(list->items[i].value);
-		free(list->items[i].value);
-	}
-	free(list->items);
-	list->items = NULL;
-	list->count = 0;
-	list->capacity = 0;
-}
-
-static void GMLValueFree(GMLValue *value) {
-	if (!value) {
-		return;
+static CXBool GMLLexerNext(GMLLexer *lexer) {
+	GMLLexerSkipSpace(lexer);
+	GMLToken *token = &lexer->current;
+	token->text = NULL;
+	token->length = 0;
+	token->integerValue = 0;
+	token->realValue = 0.0;
+	if (lexer->offset >= lexer->length) {
+		token->type = GMLTokenEOF;
+		return CXTrue;
 	}
-	if (value->type == GMLValueString) {
-		free(value->as.stringValue);
-	} else if (value->type == GMLValueList) {
-		GMLListFree(&value->as.listValue);
+	char ch = lexer->text[lexer->offset];
+	if (ch == '[' || ch == ']') {
+		lexer->offset += 1;
+		token->type = ch == '[' ? GMLTokenLBracket : GMLTokenRBracket;
+		return CXTrue;
 	}
-}
-
-static CXBool GMLListAppend(GMLList *list, char *key, GMLValue *value) {
-	if (!list || !key || !value) {
-		return CXFalse;
+	if (ch == '"') {
+		token->type = GMLTokenString;
+		return GMLLexerReadQuotedString(lexer);
 	}
-	if (list->count + 1 > list->capacity) {
-		size_t next = list->capacity ? (list->capacity * 2u) : 8u;
-		GMLPair *grown = realloc(list->items, next * sizeof(GMLPair));
-		if (!grown) {
-			return CXFalse;
+	size_t start = lexer->offset;
+	size_t offset = start;
+	while (offset < lexer->length) {
+		unsigned char c = (unsigned char)lexer->text[offset];
+		if (isspace(c) || c == '[' || c == ']' || c == '#') {
+			break;
 		}
-		list->items = grown;
-		list->capacity = next;
+		offset += 1;
 	}
-	list->items[list->count].key = key;
-	list->items[list->count].value = value;
-	list->count += 1;
-	return CXTrue;
+	lexer->offset = offset;
+	token->text = lexer->text + start;
+	token->length = offset - start;
+	return GMLLexerClassifyBareToken(lexer);
 }
 
-static GMLValue* GMLParseValue(GMLLexer *lexer);
-
-static GMLValue* GMLParseListValue(GMLLexer *lexer) {
-	if (!lexer || lexer->current.type != GMLTokenLBracket) {
-		return NULL;
-	}
-	GMLValue *value = calloc(1, sizeof(GMLValue));
-	if (!value) {
-		return NULL;
-	}
-	value->type = GMLValueList;
-	if (!GMLLexerNext(lexer)) {
-		free(value);
-		return NULL;
-	}
-	while (lexer->current.type != GMLTokenRBracket) {
-		if (lexer->current.type == GMLTokenEOF) {
-			GMLValueFree(value);
-			free(value);
-			GMLLexerSetError(lexer, "unterminated list");
-			return NULL;
-		}
-		if (lexer->current.type != GMLTokenIdentifier && lexer->current.type != GMLTokenString) {
-			GMLValueFree(value);
-			free(value);
-			GMLLexerSetError(lexer, "expected key inside list");
-			return NULL;
-		}
-		char *key = CXNewStringFromString(lexer->current.text ? lexer->current.text : "");
-		if (!key) {
-			GMLValueFree(value);
-			free(value);
-			return NULL;
-		}
-		if (!GMLLexerNext(lexer)) {
-			free(key);
-			GMLValueFree(value);
-			free(value);
-			return NULL;
-		}
-		GMLValue *child = GMLParseValue(lexer);
-		if (!child) {
-			free(key);
-			GMLValueFree(value);
-			free(value);
-			return NULL;
-		}
-		if (!GMLListAppend(&value->as.listValue, key, child)) {
-			free(key);
-			GMLValueFree(child);
-			free(child);
-			GMLValueFree(value);
-			free(value);
-			return NULL;
-		}
-	}
-	if (!GMLLexerNext(lexer)) {
-		GMLValueFree(value);
-		free(value);
-		return NULL;
-	}
-	return value;
+static CXBool GMLTokenIs(const GMLToken *token, const char *word) {
+	size_t length = strlen(word);
+	return (token->type == GMLTokenIdentifier || token->type == GMLTokenString) &&
+		token->length == length && memcmp(token->text, word, length) == 0;
 }
 
-static GMLValue* GMLParseValue(GMLLexer *lexer) {
-	if (!lexer) {
-		return NULL;
-	}
-	GMLValue *value = calloc(1, sizeof(GMLValue));
-	if (!value) {
-		return NULL;
-	}
-	switch (lexer->current.type) {
+/** Writes the text of a scalar token into `text` (numbers in the historical `%` formats). */
+static const char* GMLTextAssignToken(GMLText *text, const GMLToken *token) {
+	char number[CX_TEXT_NUMBER_MAX];
+	switch (token->type) {
 		case GMLTokenString:
 		case GMLTokenIdentifier:
-			value->type = GMLValueString;
-			value->as.stringValue = CXNewStringFromString(lexer->current.text ? lexer->current.text : "");
-			if (!value->as.stringValue) {
-				free(value);
-				return NULL;
-			}
-			if (!GMLLexerNext(lexer)) {
-				GMLValueFree(value);
-				free(value);
-				return NULL;
-			}
-			return value;
+			return GMLTextAssign(text, token->text, token->length);
 		case GMLTokenInteger:
-			value->type = GMLValueInteger;
-			value->as.integerValue = lexer->current.integerValue;
-			if (!GMLLexerNext(lexer)) {
-				free(value);
-				return NULL;
-			}
-			return value;
-		case GMLTokenReal:
-			value->type = GMLValueReal;
-			value->as.realValue = lexer->current.realValue;
-			if (!GMLLexerNext(lexer)) {
-				free(value);
-				return NULL;
-			}
-			return value;
-		case GMLTokenLBracket:
-			free(value);
-			return GMLParseListValue(lexer);
-		default:
-			free(value);
-			GMLLexerSetError(lexer, "unexpected token while parsing value");
-			return NULL;
-	}
-}
-
-static const GMLValue* GMLListFindLastValue(const GMLList *list, const char *key) {
-	if (!list || !key) {
-		return NULL;
-	}
-	for (size_t i = list->count; i > 0; i -= 1) {
-		if (strcmp(list->items[i - 1].key, key) == 0) {
-			return list->items[i - 1].value;
+			return GMLTextAssign(text, number, CXTextFormatInt64(number, token->integerValue));
+		case GMLTokenReal: {
+			int length = snprintf(number, sizeof(number), "%.17g", token->realValue);
+			return length > 0 ? GMLTextAssign(text, number, (size_t)length) : NULL;
 		}
-	}
-	return NULL;
-}
-
-static void GMLParsedNodeListFree(GMLParsedNodeList *list) {
-	if (!list) {
-		return;
-	}
-	for (size_t i = 0; i < list->count; i += 1) {
-		free(list->items[i].idText);
-		GMLListFree(&list->items[i].attributes);
-	}
-	free(list->items);
-	list->items = NULL;
-	list->count = 0;
-	list->capacity = 0;
-}
-
-static void GMLParsedEdgeListFree(GMLParsedEdgeList *list) {
-	if (!list) {
-		return;
-	}
-	for (size_t i = 0; i < list->count; i += 1) {
-		free(list->items[i].sourceText);
-		free(list->items[i].targetText);
-		GMLListFree(&list->items[i].attributes);
-	}
-	free(list->items);
-	list->items = NULL;
-	list->count = 0;
-	list->capacity = 0;
-}
-
-static void GMLParsedGraphFree(GMLParsedGraph *graph) {
-	if (!graph) {
-		return;
-	}
-	GMLListFree(&graph->graphAttributes);
-	GMLParsedNodeListFree(&graph->nodes);
-	GMLParsedEdgeListFree(&graph->edges);
-}
-
-static CXBool GMLParsedNodeListAppend(GMLParsedNodeList *list, GMLParsedNode *node) {
-	if (list->count + 1 > list->capacity) {
-		size_t next = list->capacity ? (list->capacity * 2u) : 8u;
-		GMLParsedNode *grown = realloc(list->items, next * sizeof(GMLParsedNode));
-		if (!grown) {
-			return CXFalse;
-		}
-		list->items = grown;
-		list->capacity = next;
-	}
-	list->items[list->count++] = *node;
-	return CXTrue;
-}
-
-static CXBool GMLParsedEdgeListAppend(GMLParsedEdgeList *list, GMLParsedEdge *edge) {
-	if (list->count + 1 > list->capacity) {
-		size_t next = list->capacity ? (list->capacity * 2u) : 8u;
-		GMLParsedEdge *grown = realloc(list->items, next * sizeof(GMLParsedEdge));
-		if (!grown) {
-			return CXFalse;
-		}
-		list->items = grown;
-		list->capacity = next;
-	}
-	list->items[list->count++] = *edge;
-	return CXTrue;
-}
-
-static char* GMLValueToOwnedString(const GMLValue *value) {
-	if (!value) {
-		return NULL;
-	}
-	switch (value->type) {
-		case GMLValueString:
-			return CXNewStringFromString(value->as.stringValue ? value->as.stringValue : "");
-		case GMLValueInteger:
-			return CXNewStringFromFormat("%" PRId64, value->as.integerValue);
-		case GMLValueReal:
-			return CXNewStringFromFormat("%.17g", value->as.realValue);
 		default:
 			return NULL;
 	}
 }
 
-static CXBool GMLValueToBool(const GMLValue *value, CXBool *outValue) {
-	if (!value || !outValue) {
-		return CXFalse;
-	}
-	switch (value->type) {
-		case GMLValueInteger:
-			*outValue = value->as.integerValue != 0 ? CXTrue : CXFalse;
+static CXBool GMLTokenToBool(GMLText *scratch, const GMLToken *token, CXBool *outValue) {
+	switch (token->type) {
+		case GMLTokenInteger:
+			*outValue = token->integerValue != 0 ? CXTrue : CXFalse;
 			return CXTrue;
-		case GMLValueReal:
-			*outValue = fabs(value->as.realValue) > 0.0 ? CXTrue : CXFalse;
+		case GMLTokenReal:
+			*outValue = fabs(token->realValue) > 0.0 ? CXTrue : CXFalse;
 			return CXTrue;
-		case GMLValueString:
-			if (!value->as.stringValue) {
+		case GMLTokenString:
+		case GMLTokenIdentifier: {
+			const char *text = GMLTextAssignToken(scratch, token);
+			if (!text) {
 				return CXFalse;
 			}
-			if (strcasecmp(value->as.stringValue, "true") == 0 || strcmp(value->as.stringValue, "1") == 0 || strcasecmp(value->as.stringValue, "yes") == 0) {
+			if (strcasecmp(text, "true") == 0 || strcmp(text, "1") == 0 || strcasecmp(text, "yes") == 0) {
 				*outValue = CXTrue;
 				return CXTrue;
 			}
-			if (strcasecmp(value->as.stringValue, "false") == 0 || strcmp(value->as.stringValue, "0") == 0 || strcasecmp(value->as.stringValue, "no") == 0) {
+			if (strcasecmp(text, "false") == 0 || strcmp(text, "0") == 0 || strcasecmp(text, "no") == 0) {
 				*outValue = CXFalse;
 				return CXTrue;
 			}
 			return CXFalse;
+		}
+		default:
+			return CXFalse;
+	}
+}
+
+static CXBool GMLLexerExpectKey(GMLLexer *lexer) {
+	if (lexer->current.type == GMLTokenEOF) {
+		GMLLexerSetError(lexer, "unterminated list");
+		return CXFalse;
+	}
+	if (lexer->current.type != GMLTokenIdentifier && lexer->current.type != GMLTokenString) {
+		GMLLexerSetError(lexer, "expected key inside list");
+		return CXFalse;
+	}
+	return CXTrue;
+}
+
+/** Advances from a key to its value, which must be a scalar or a list. */
+static CXBool GMLLexerNextValue(GMLLexer *lexer) {
+	if (!GMLLexerNext(lexer)) {
+		return CXFalse;
+	}
+	switch (lexer->current.type) {
+		case GMLTokenIdentifier:
+		case GMLTokenString:
+		case GMLTokenInteger:
+		case GMLTokenReal:
+		case GMLTokenLBracket:
+			return CXTrue;
 		default:
+			GMLLexerSetError(lexer, "unexpected token while parsing value");
 			return CXFalse;
 	}
 }
 
-static CXBool GMLExtractParsedGraph(const GMLList *root, GMLParsedGraph *outGraph) {
-	if (!root || !outGraph) {
+/** Consumes the current value; lists are walked without recursion. */
+static CXBool GMLLexerSkipValue(GMLLexer *lexer) {
+	if (lexer->current.type != GMLTokenLBracket) {
+		return GMLLexerNext(lexer);
+	}
+	size_t depth = 1;
+	if (!GMLLexerNext(lexer)) {
 		return CXFalse;
 	}
-	memset(outGraph, 0, sizeof(*outGraph));
-	outGraph->directed = CXFalse;
-	size_t autoNodeId = 0;
-	for (size_t i = 0; i < root->count; i += 1) {
-		const GMLPair *pair = &root->items[i];
-		if (strcmp(pair->key, "directed") == 0) {
-			CXBool directed = CXFalse;
-			if (GMLValueToBool(pair->value, &directed)) {
-				outGraph->directed = directed;
-			}
-			continue;
-		}
-		if (strcmp(pair->key, "node") == 0 && pair->value && pair->value->type == GMLValueList) {
-			GMLParsedNode node = {0};
-			const GMLValue *idValue = GMLListFindLastValue(&pair->value->as.listValue, "id");
-			if (idValue) {
-				node.idText = GMLValueToOwnedString(idValue);
-			} else {
-				node.idText = CXNewStringFromFormat("%zu", autoNodeId);
-				InterchangeWarningAppend("GML assigned synthetic node ids to entries without an id");
-			}
-			autoNodeId += 1;
-			if (!node.idText) {
-				GMLParsedGraphFree(outGraph);
-				return CXFalse;
-			}
-			for (size_t j = 0; j < pair->value->as.listValue.count; j += 1) {
-				const GMLPair *child = &pair->value->as.listValue.items[j];
-				if (strcmp(child->key, "id") == 0) {
-					continue;
-				}
-				char *keyCopy = CXNewStringFromString(child->key);
-				GMLValue *valueCopy = calloc(1, sizeof(GMLValue));
-				if (!keyCopy || !valueCopy) {
-					free(keyCopy);
-					free(valueCopy);
-					free(node.idText);
-					GMLParsedGraphFree(outGraph);
-					return CXFalse;
-				}
-				memcpy(valueCopy, child->value, sizeof(GMLValue));
-				if (child->value->type == GMLValueString) {
-					valueCopy->as.stringValue = CXNewStringFromString(child->value->as.stringValue ? child->value->as.stringValue : "");
-				} else if (child->value->type == GMLValueList) {
-					memset(&valueCopy->as.listValue, 0, sizeof(GMLList));
-					for (size_t k = 0; k < child->value->as.listValue.count; k += 1) {
-						const GMLPair *nested = &child->value->as.listValue.items[k];
-						char *nestedKey = CXNewStringFromString(nested->key);
-						GMLValue *nestedValue = calloc(1, sizeof(GMLValue));
-						if (!nestedKey || !nestedValue) {
-							free(nestedKey);
-							free(nestedValue);
-							GMLValueFree(valueCopy);
-							free(valueCopy);
-							free(keyCopy);
-							free(node.idText);
-							GMLParsedGraphFree(outGraph);
-							return CXFalse;
-						}
-						memcpy(nestedValue, nested->value, sizeof(GMLValue));
-						if (nested->value->type == GMLValueString) {
-							nestedValue->as.stringValue = CXNewStringFromString(nested->value->as.stringValue ? nested->value->as.stringValue : "");
-						}
-						if (!GMLListAppend(&valueCopy->as.listValue, nestedKey, nestedValue)) {
-							GMLValueFree(nestedValue);
-							free(nestedValue);
-							free(nestedKey);
-							GMLValueFree(valueCopy);
-							free(valueCopy);
-							free(keyCopy);
-							free(node.idText);
-							GMLParsedGraphFree(outGraph);
-							return CXFalse;
-						}
-					}
-				}
-				if (!GMLListAppend(&node.attributes, keyCopy, valueCopy)) {
-					GMLValueFree(valueCopy);
-					free(valueCopy);
-					free(keyCopy);
-					free(node.idText);
-					GMLParsedGraphFree(outGraph);
-					return CXFalse;
-				}
-			}
-			if (!GMLParsedNodeListAppend(&outGraph->nodes, &node)) {
-				free(node.idText);
-				GMLListFree(&node.attributes);
-				GMLParsedGraphFree(outGraph);
-				return CXFalse;
-			}
-			continue;
-		}
-		if (strcmp(pair->key, "edge") == 0 && pair->value && pair->value->type == GMLValueList) {
-			GMLParsedEdge edge = {0};
-			const GMLValue *sourceValue = GMLListFindLastValue(&pair->value->as.listValue, "source");
-			const GMLValue *targetValue = GMLListFindLastValue(&pair->value->as.listValue, "target");
-			edge.sourceText = GMLValueToOwnedString(sourceValue);
-			edge.targetText = GMLValueToOwnedString(targetValue);
-			if (!edge.sourceText || !edge.targetText) {
-				free(edge.sourceText);
-				free(edge.targetText);
-				GMLParsedGraphFree(outGraph);
+	for (;;) {
+		if (lexer->current.type == GMLTokenRBracket) {
+			if (!GMLLexerNext(lexer)) {
 				return CXFalse;
 			}
-			for (size_t j = 0; j < pair->value->as.listValue.count; j += 1) {
-				const GMLPair *child = &pair->value->as.listValue.items[j];
-				if (strcmp(child->key, "source") == 0 || strcmp(child->key, "target") == 0) {
-					continue;
-				}
-				char *keyCopy = CXNewStringFromString(child->key);
-				GMLValue *valueCopy = calloc(1, sizeof(GMLValue));
-				if (!keyCopy || !valueCopy) {
-					free(keyCopy);
-					free(valueCopy);
-					free(edge.sourceText);
-					free(edge.targetText);
-					GMLParsedGraphFree(outGraph);
-					return CXFalse;
-				}
-				memcpy(valueCopy, child->value, sizeof(GMLValue));
-				if (child->value->type == GMLValueString) {
-					valueCopy->as.stringValue = CXNewStringFromString(child->value->as.stringValue ? child->value->as.stringValue : "");
-				} else if (child->value->type == GMLValueList) {
-					memset(&valueCopy->as.listValue, 0, sizeof(GMLList));
-				}
-				if (!GMLListAppend(&edge.attributes, keyCopy, valueCopy)) {
-					GMLValueFree(valueCopy);
-					free(valueCopy);
-					free(keyCopy);
-					free(edge.sourceText);
-					free(edge.targetText);
-					GMLParsedGraphFree(outGraph);
-					return CXFalse;
-				}
-			}
-			if (!GMLParsedEdgeListAppend(&outGraph->edges, &edge)) {
-				free(edge.sourceText);
-				free(edge.targetText);
-				GMLListFree(&edge.attributes);
-				GMLParsedGraphFree(outGraph);
-				return CXFalse;
+			depth -= 1;
+			if (depth == 0) {
+				return CXTrue;
 			}
 			continue;
 		}
-		char *keyCopy = CXNewStringFromString(pair->key);
-		GMLValue *valueCopy = calloc(1, sizeof(GMLValue));
-		if (!keyCopy || !valueCopy) {
-			free(keyCopy);
-			free(valueCopy);
-			GMLParsedGraphFree(outGraph);
+		if (!GMLLexerExpectKey(lexer) || !GMLLexerNextValue(lexer)) {
 			return CXFalse;
 		}
-		memcpy(valueCopy, pair->value, sizeof(GMLValue));
-		if (pair->value->type == GMLValueString) {
-			valueCopy->as.stringValue = CXNewStringFromString(pair->value->as.stringValue ? pair->value->as.stringValue : "");
+		if (lexer->current.type == GMLTokenLBracket) {
+			depth += 1;
 		}
-		if (!GMLListAppend(&outGraph->graphAttributes, keyCopy, valueCopy)) {
-			GMLValueFree(valueCopy);
-			free(valueCopy);
-			free(keyCopy);
-			GMLParsedGraphFree(outGraph);
+		if (!GMLLexerNext(lexer)) {
 			return CXFalse;
 		}
 	}
-	return CXTrue;
 }
 
-static CXBool GMLGraphEnsureNodeExists(GMLParsedGraph *graph, const char *idText) {
-	if (!graph || !idText) {
-		return CXFalse;
-	}
-	for (size_t i = 0; i < graph->nodes.count; i += 1) {
-		if (strcmp(graph->nodes.items[i].idText, idText) == 0) {
-			return CXTrue;
+static char* GMLTokenToOwnedString(const GMLToken *token) {
+	char number[CX_TEXT_NUMBER_MAX];
+	const char *text = token->text;
+	size_t length = token->length;
+	if (token->type == GMLTokenInteger) {
+		length = CXTextFormatInt64(number, token->integerValue);
+		text = number;
+	} else if (token->type == GMLTokenReal) {
+		int written = snprintf(number, sizeof(number), "%.17g", token->realValue);
+		if (written < 0) {
+			return NULL;
 		}
+		length = (size_t)written;
+		text = number;
+	} else if (token->type != GMLTokenString && token->type != GMLTokenIdentifier) {
+		return NULL;
 	}
-	GMLParsedNode node = {0};
-	node.idText = CXNewStringFromString(idText);
-	if (!node.idText) {
-		return CXFalse;
-	}
-	if (!GMLParsedNodeListAppend(&graph->nodes, &node)) {
-		free(node.idText);
-		return CXFalse;
-	}
-	return CXTrue;
-}
-
-static CXBool GMLGraphEnsureEdgeEndpoints(GMLParsedGraph *graph) {
-	if (!graph) {
-		return CXFalse;
+	char *copy = malloc(length + 1);
+	if (!copy) {
+		return NULL;
 	}
-	for (size_t i = 0; i < graph->edges.count; i += 1) {
-		if (!GMLGraphEnsureNodeExists(graph, graph->edges.items[i].sourceText) ||
-		    !GMLGraphEnsureNodeExists(graph, graph->edges.items[i].targetText)) {
-			return CXFalse;
-		}
+	if (length > 0) {
+		memcpy(copy, text, length);
 	}
-	return CXTrue;
+	copy[length] = '\0';
+	return copy;
 }
 
 static GMLAttributeInfer* GMLInferLookup(CXStringDictionaryRef dictionary, const char *name) {
@@ -1708,42 +1514,41 @@ static GMLAttributeInfer* GMLInferEnsure(CXStringDictionaryRef dictionary, const
 	return infer;
 }
 
-static CXBool GMLInferObserveValue(GMLAttributeInfer *infer, const GMLValue *value) {
+static void GMLInferObserveValue(GMLAttributeInfer *infer, const GMLToken *value) {
 	if (!infer || !value) {
-		return CXTrue;
+		return;
 	}
-	if (value->type == GMLValueList) {
+	if (value->type == GMLTokenLBracket) {
 		infer->kind = GMLInferSkip;
-		return CXTrue;
+		return;
 	}
 	infer->sawValue = CXTrue;
-	if (value->type == GMLValueString) {
+	if (value->type == GMLTokenString || value->type == GMLTokenIdentifier) {
 		if (infer->kind == GMLInferSignedInt || infer->kind == GMLInferUnsignedInt || infer->kind == GMLInferReal) {
 			infer->coercedToString = CXTrue;
 		}
 		infer->kind = GMLInferString;
-		return CXTrue;
+		return;
 	}
-	if (value->type == GMLValueReal) {
+	if (value->type == GMLTokenReal) {
 		if (infer->kind != GMLInferString) {
 			infer->kind = GMLInferReal;
 		}
-		return CXTrue;
+		return;
 	}
-	if (value->type == GMLValueInteger) {
+	if (value->type == GMLTokenInteger) {
 		if (infer->kind == GMLInferUnknown) {
-			infer->kind = value->as.integerValue < 0 ? GMLInferSignedInt : GMLInferUnsignedInt;
-		} else if (infer->kind == GMLInferUnsignedInt && value->as.integerValue < 0) {
+			infer->kind = value->integerValue < 0 ? GMLInferSignedInt : GMLInferUnsignedInt;
+		} else if (infer->kind == GMLInferUnsignedInt && value->integerValue < 0) {
 			infer->kind = GMLInferSignedInt;
 		}
-		if (value->as.integerValue < infer->minInt) {
-			infer->minInt = value->as.integerValue;
+		if (value->integerValue < infer->minInt) {
+			infer->minInt = value->integerValue;
 		}
-		if ((uint64_t)CXMAX((int64_t)0, value->as.integerValue) > infer->maxUInt) {
-			infer->maxUInt = (uint64_t)CXMAX((int64_t)0, value->as.integerValue);
+		if ((uint64_t)CXMAX((int64_t)0, value->integerValue) > infer->maxUInt) {
+			infer->maxUInt = (uint64_t)CXMAX((int64_t)0, value->integerValue);
 		}
 	}
-	return CXTrue;
 }
 
 static void GMLInferDictionaryDestroy(CXStringDictionaryRef dictionary) {
@@ -1784,23 +1589,17 @@ static CXAttributeType GMLInferResolvedType(const GMLAttributeInfer *infer) {
 	}
 }
 
-static CXBool GMLCollectInferredAttributes(const GMLList *list, CXStringDictionaryRef inferMap) {
-	if (!list || !inferMap) {
-		return CXTrue;
+static CXAttributeScope GMLAttributeScope(InterchangeScope scope) {
+	if (scope == InterchangeScopeNode) {
+		return CXAttributeScopeNode;
 	}
-	for (size_t i = 0; i < list->count; i += 1) {
-		GMLAttributeInfer *infer = GMLInferEnsure(inferMap, list->items[i].key);
-		if (!infer) {
-			return CXFalse;
-		}
-		if (!GMLInferObserveValue(infer, list->items[i].value)) {
-			return CXFalse;
-		}
+	if (scope == InterchangeScopeEdge) {
+		return CXAttributeScopeEdge;
 	}
-	return CXTrue;
+	return CXAttributeScopeNetwork;
 }
 
-static CXBool GMLDefineAttributesFromInferMap(CXNetworkRef network, CXAttributeScope scope, CXStringDictionaryRef inferMap) {
+static CXBool GMLDefineAttributesFromInferMap(CXNetworkRef network, InterchangeScope scope, CXStringDictionaryRef inferMap) {
 	if (!network || !inferMap) {
 		return CXTrue;
 	}
@@ -1810,7 +1609,7 @@ static CXBool GMLDefineAttributesFromInferMap(CXNetworkRef network, CXAttributeS
 			continue;
 		}
 		if (infer->kind == GMLInferSkip) {
-			InterchangeWarningAppend("GML skipped nested %s attribute \"%s\"", InterchangeScopeLabel((InterchangeScope)(scope == CXAttributeScopeNetwork ? InterchangeScopeGraph : (scope == CXAttributeScopeNode ? InterchangeScopeNode : InterchangeScopeEdge))), infer->name);
+			InterchangeWarningAppend("GML skipped nested %s attribute \"%s\"", InterchangeScopeLabel(scope), infer->name);
 			continue;
 		}
 		if (infer->coercedToString) {
@@ -1821,9 +1620,9 @@ static CXBool GMLDefineAttributesFromInferMap(CXNetworkRef network, CXAttributeS
 			continue;
 		}
 		CXBool ok = CXFalse;
-		if (scope == CXAttributeScopeNode) {
+		if (scope == InterchangeScopeNode) {
 			ok = CXNetworkDefineNodeAttribute(network, infer->name, type, 1);
-		} else if (scope == CXAttributeScopeEdge) {
+		} else if (scope == InterchangeScopeEdge) {
 			ok = CXNetworkDefineEdgeAttribute(network, infer->name, type, 1);
 		} else {
 			ok = CXNetworkDefineNetworkAttribute(network, infer->name, type, 1);
@@ -1835,55 +1634,54 @@ static CXBool GMLDefineAttributesFromInferMap(CXNetworkRef network, CXAttributeS
 	return CXTrue;
 }
 
-static CXBool GMLAssignAttributeValue(CXAttributeRef attr, CXIndex index, const GMLValue *value) {
-	if (!attr || !value) {
-		return CXTrue;
-	}
+static CXBool GMLAssignAttributeValue(CXAttributeRef attr, CXIndex index, const GMLToken *value) {
 	void *ptr = InterchangeAttributeValuePtr(attr, index);
 	if (!ptr) {
 		return CXFalse;
 	}
 	switch (attr->type) {
 		case CXStringAttributeType: {
-			char *text = GMLValueToOwnedString(value);
+			char *text = GMLTokenToOwnedString(value);
 			if (!text) {
 				return CXFalse;
 			}
+			// A key repeated inside one record keeps its last value.
+			free(*((CXString *)ptr));
 			*((CXString *)ptr) = text;
 			return CXTrue;
 		}
 		case CXDoubleAttributeType:
-			if (value->type == GMLValueInteger) {
-				*((double *)ptr) = (double)value->as.integerValue;
-			} else if (value->type == GMLValueReal) {
-				*((double *)ptr) = value->as.realValue;
+			if (value->type == GMLTokenInteger) {
+				*((double *)ptr) = (double)value->integerValue;
+			} else if (value->type == GMLTokenReal) {
+				*((double *)ptr) = value->realValue;
 			} else {
 				return CXFalse;
 			}
 			return CXTrue;
 		case CXIntegerAttributeType:
-			if (value->type != GMLValueInteger) {
+			if (value->type != GMLTokenInteger) {
 				return CXFalse;
 			}
-			*((int32_t *)ptr) = (int32_t)value->as.integerValue;
+			*((int32_t *)ptr) = (int32_t)value->integerValue;
 			return CXTrue;
 		case CXUnsignedIntegerAttributeType:
-			if (value->type != GMLValueInteger) {
+			if (value->type != GMLTokenInteger) {
 				return CXFalse;
 			}
-			*((uint32_t *)ptr) = (uint32_t)CXMAX((int64_t)0, value->as.integerValue);
+			*((uint32_t *)ptr) = (uint32_t)CXMAX((int64_t)0, value->integerValue);
 			return CXTrue;
 		case CXBigIntegerAttributeType:
-			if (value->type != GMLValueInteger) {
+			if (value->type != GMLTokenInteger) {
 				return CXFalse;
 			}
-			*((int64_t *)ptr) = value->as.integerValue;
+			*((int64_t *)ptr) = value->integerValue;
 			return CXTrue;
 		case CXUnsignedBigIntegerAttributeType:
-			if (value->type != GMLValueInteger) {
+			if (value->type != GMLTokenInteger) {
 				return CXFalse;
 			}
-			*((uint64_t *)ptr) = (uint64_t)CXMAX((int64_t)0, value->as.integerValue);
+			*((uint64_t *)ptr) = (uint64_t)CXMAX((int64_t)0, value->integerValue);
 			return CXTrue;
 		default:
 			return CXFalse;
@@ -1903,245 +1701,451 @@ static CXAttributeRef GMLGetAttributeForScope(CXNetworkRef network, CXAttributeS
 	return CXNetworkGetNetworkAttribute(network, name);
 }
 
-static CXBool GMLAssignAttributesFromList(CXNetworkRef network, CXAttributeScope scope, CXIndex index, const GMLList *list) {
-	if (!network || !list) {
-		return CXTrue;
+static void GMLKeyHintsReset(GMLKeyHints *hints) {
+	for (size_t i = 0; i < hints->capacity; i += 1) {
+		free(hints->items[i].key);
+		hints->items[i].key = NULL;
+		hints->items[i].length = 0;
+		hints->items[i].target = NULL;
 	}
-	for (size_t i = 0; i < list->count; i += 1) {
-		CXAttributeRef attr = GMLGetAttributeForScope(network, scope, list->items[i].key);
-		if (!attr) {
-			continue;
+}
+
+static void GMLKeyHintsFree(GMLKeyHints *hints) {
+	GMLKeyHintsReset(hints);
+	free(hints->items);
+	hints->items = NULL;
+	hints->capacity = 0;
+}
+
+/**
+ * Resolves `key`, the member at `position` of a record in `scope`, to its
+ * inference slot (first pass) or attribute (second pass; NULL when the
+ * attribute was not defined).
+ */
+static CXBool GMLReaderResolveKey(GMLReader *reader, InterchangeScope scope, size_t position, const GMLToken *key, void **outTarget) {
+	GMLKeyHints *hints = &reader->hints[scope];
+	if (position < hints->capacity) {
+		GMLKeyHint *hint = &hints->items[position];
+		if (hint->key && hint->length == key->length && memcmp(hint->key, key->text, key->length) == 0) {
+			*outTarget = hint->target;
+			return CXTrue;
 		}
-		if (list->items[i].value->type == GMLValueList) {
-			continue;
+	} else {
+		size_t previous = hints->capacity;
+		if (!GMLReserve((void **)&hints->items, &hints->capacity, position + 1, sizeof(GMLKeyHint))) {
+			return CXFalse;
 		}
-		if (!GMLAssignAttributeValue(attr, index, list->items[i].value)) {
+		memset(hints->items + previous, 0, (hints->capacity - previous) * sizeof(GMLKeyHint));
+	}
+	const char *name = GMLTextAssign(&reader->keyText, key->text, key->length);
+	if (!name) {
+		return CXFalse;
+	}
+	void *target = NULL;
+	if (reader->assigning) {
+		target = GMLGetAttributeForScope(reader->network, GMLAttributeScope(scope), name);
+	} else {
+		target = GMLInferEnsure(reader->infer[scope], name);
+		if (!target) {
 			return CXFalse;
 		}
 	}
+	GMLKeyHint *hint = &hints->items[position];
+	char *copy = malloc(key->length + 1);
+	if (copy) {
+		memcpy(copy, name, key->length + 1);
+		free(hint->key);
+		hint->key = copy;
+		hint->length = key->length;
+		hint->target = target;
+	}
+	*outTarget = target;
 	return CXTrue;
 }
 
-struct CXNetwork* CXNetworkReadGML(const char *path) {
-	InterchangeWarningClear();
-	if (!path) {
-		errno = EINVAL;
-		return NULL;
+/** Handles one attribute member; `key` is the member key and the current token its value. */
+static CXBool GMLReaderMember(GMLReader *reader, InterchangeScope scope, size_t position, CXIndex index, const GMLToken *key) {
+	GMLLexer *lexer = &reader->lexer;
+	void *target = NULL;
+	if (!GMLReaderResolveKey(reader, scope, position, key, &target)) {
+		return CXFalse;
 	}
-	FILE *file = fopen(path, "rb");
-	if (!file) {
-		return NULL;
+	if (!reader->assigning) {
+		GMLInferObserveValue((GMLAttributeInfer *)target, &lexer->current);
+	} else if (target && lexer->current.type != GMLTokenLBracket &&
+		!GMLAssignAttributeValue((CXAttributeRef)target, index, &lexer->current)) {
+		return CXFalse;
 	}
-	fseek(file, 0, SEEK_END);
-	long size = ftell(file);
-	if (size < 0) {
-		fclose(file);
-		return NULL;
+	return GMLLexerSkipValue(lexer);
+}
+
+static CXBool GMLReaderAddNodeId(GMLReader *reader, const char *id) {
+	if (!GMLReserve((void **)&reader->nodeIds, &reader->nodeCapacity, reader->nodeCount + 1, sizeof(char *))) {
+		return CXFalse;
 	}
-	fseek(file, 0, SEEK_SET);
-	char *buffer = calloc((size_t)size + 1u, sizeof(char));
-	if (!buffer) {
-		fclose(file);
-		return NULL;
+	char *copy = CXNewStringFromString((CXString)id);
+	if (!copy) {
+		return CXFalse;
 	}
-	if (size > 0 && fread(buffer, 1, (size_t)size, file) != (size_t)size) {
-		free(buffer);
-		fclose(file);
-		return NULL;
+	size_t position = reader->nodeCount;
+	reader->nodeIds[reader->nodeCount++] = copy;
+	if (CXStringDictionaryEntryForKey(reader->nodeIdMap, copy)) {
+		if (!GMLReserve((void **)&reader->duplicates, &reader->duplicateCapacity, reader->duplicateCount + 1, sizeof(size_t))) {
+			return CXFalse;
+		}
+		reader->duplicates[reader->duplicateCount++] = position;
+		return CXTrue;
 	}
-	fclose(file);
+	CXStringDictionarySetEntry(reader->nodeIdMap, copy, (void *)(uintptr_t)(position + 1u));
+	return CXTrue;
+}
 
-	GMLLexer lexer = {
-		.text = buffer,
-		.length = (size_t)size,
-		.offset = 0,
-		.line = 1,
-		.column = 1,
-		.current = {0},
-		.error = NULL,
-	};
-	GMLValue *rootValue = NULL;
-	GMLParsedGraph parsed = {0};
-	CXNetworkRef network = NULL;
-	CXStringDictionaryRef nodeIdMap = NULL;
-	CXIndex *nodeIndices = NULL;
-	CXEdge *edges = NULL;
-	CXIndex *edgeIndices = NULL;
-
-	if (!GMLLexerNext(&lexer)) {
-		goto cleanup;
-	}
-	if ((lexer.current.type == GMLTokenIdentifier || lexer.current.type == GMLTokenString) &&
-	    lexer.current.text && strcmp(lexer.current.text, "graph") == 0) {
-		if (!GMLLexerNext(&lexer) || lexer.current.type != GMLTokenLBracket) {
-			GMLLexerSetError(&lexer, "expected '[' after graph");
-			goto cleanup;
-		}
-		rootValue = GMLParseListValue(&lexer);
-	} else if (lexer.current.type == GMLTokenLBracket) {
-		rootValue = GMLParseListValue(&lexer);
-	} else {
-		GMLLexerSetError(&lexer, "expected graph [ ... ]");
-		goto cleanup;
+static CXBool GMLReaderNode(GMLReader *reader) {
+	GMLLexer *lexer = &reader->lexer;
+	CXIndex index = reader->assigning ? reader->nodeIndices[reader->nodeRecords] : 0;
+	CXBool hasId = CXFalse;
+	CXBool idIsList = CXFalse;
+	size_t position = 0;
+	if (!GMLLexerNext(lexer)) {
+		return CXFalse;
+	}
+	while (lexer->current.type != GMLTokenRBracket) {
+		if (!GMLLexerExpectKey(lexer)) {
+			return CXFalse;
+		}
+		GMLToken key = lexer->current;
+		if (!GMLLexerNextValue(lexer)) {
+			return CXFalse;
+		}
+		if (GMLTokenIs(&key, "id")) {
+			if (!reader->assigning) {
+				hasId = CXTrue;
+				idIsList = lexer->current.type == GMLTokenLBracket;
+				if (!idIsList && !GMLTextAssignToken(&reader->idText, &lexer->current)) {
+					return CXFalse;
+				}
+			}
+			if (!GMLLexerSkipValue(lexer)) {
+				return CXFalse;
+			}
+			continue;
+		}
+		if (!GMLReaderMember(reader, InterchangeScopeNode, position, index, &key)) {
+			return CXFalse;
+		}
+		position += 1;
 	}
-	if (!rootValue || rootValue->type != GMLValueList) {
-		goto cleanup;
+	if (!GMLLexerNext(lexer)) {
+		return CXFalse;
 	}
-	if (!GMLExtractParsedGraph(&rootValue->as.listValue, &parsed)) {
-		goto cleanup;
+	size_t record = reader->nodeRecords++;
+	if (reader->assigning) {
+		return CXTrue;
 	}
-	if (!GMLGraphEnsureEdgeEndpoints(&parsed)) {
-		goto cleanup;
+	if (idIsList) {
+		GMLLexerSetError(lexer, "node id must be a scalar value");
+		return CXFalse;
 	}
-	if (parsed.nodes.count == 0) {
-		network = CXNewNetwork(parsed.directed);
-		goto cleanup_success;
+	if (!hasId) {
+		char number[CX_TEXT_NUMBER_MAX];
+		CXTextFormatUInt64(number, (uint64_t)record);
+		reader->syntheticIds += 1;
+		return GMLReaderAddNodeId(reader, number);
 	}
-	network = CXNewNetworkWithCapacity(parsed.directed, parsed.nodes.count, parsed.edges.count > 0 ? parsed.edges.count : 1);
-	if (!network) {
-		goto cleanup;
+	return GMLReaderAddNodeId(reader, reader->idText.data);
+}
+
+static CXBool GMLReaderResolveEndpoint(GMLReader *reader, const char *id, CXBool isTarget, CXIndex *outPosition) {
+	void *entry = CXStringDictionaryEntryForKey(reader->nodeIdMap, (CXString)id);
+	if (entry) {
+		*outPosition = (CXIndex)((uintptr_t)entry - 1u);
+		return CXTrue;
+	}
+	// Resolved once every node has been seen; missing ones are created then.
+	if (!GMLReserve((void **)&reader->pending, &reader->pendingCapacity, reader->pendingCount + 1, sizeof(GMLPendingEndpoint))) {
+		return CXFalse;
 	}
-	nodeIndices = calloc(parsed.nodes.count, sizeof(CXIndex));
-	if (!nodeIndices || !CXNetworkAddNodes(network, (CXSize)parsed.nodes.count, nodeIndices)) {
-		goto cleanup;
+	char *copy = CXNewStringFromString((CXString)id);
+	if (!copy) {
+		return CXFalse;
 	}
-	nodeIdMap = CXNewStringDictionary();
-	if (!nodeIdMap) {
-		goto cleanup;
+	reader->pending[reader->pendingCount].edge = reader->edgeCount;
+	reader->pending[reader->pendingCount].isTarget = isTarget;
+	reader->pending[reader->pendingCount].id = copy;
+	reader->pendingCount += 1;
+	*outPosition = 0;
+	return CXTrue;
+}
+
+static CXBool GMLReaderEdge(GMLReader *reader) {
+	GMLLexer *lexer = &reader->lexer;
+	CXIndex index = reader->assigning ? reader->edgeIndices[reader->edgeRecords] : 0;
+	CXBool hasSource = CXFalse;
+	CXBool hasTarget = CXFalse;
+	size_t position = 0;
+	if (!GMLLexerNext(lexer)) {
+		return CXFalse;
 	}
-	for (size_t i = 0; i < parsed.nodes.count; i += 1) {
-		if (CXStringDictionaryEntryForKey(nodeIdMap, parsed.nodes.items[i].idText)) {
-			InterchangeWarningAppend("GML duplicated node id \"%s\"; keeping the first occurrence", parsed.nodes.items[i].idText);
+	while (lexer->current.type != GMLTokenRBracket) {
+		if (!GMLLexerExpectKey(lexer)) {
+			return CXFalse;
+		}
+		GMLToken key = lexer->current;
+		if (!GMLLexerNextValue(lexer)) {
+			return CXFalse;
+		}
+		CXBool isSource = GMLTokenIs(&key, "source");
+		if (isSource || GMLTokenIs(&key, "target")) {
+			if (!reader->assigning) {
+				CXBool scalar = lexer->current.type != GMLTokenLBracket;
+				if (scalar && !GMLTextAssignToken(isSource ? &reader->sourceText : &reader->targetText, &lexer->current)) {
+					return CXFalse;
+				}
+				if (isSource) {
+					hasSource = scalar;
+				} else {
+					hasTarget = scalar;
+				}
+			}
+			if (!GMLLexerSkipValue(lexer)) {
+				return CXFalse;
+			}
 			continue;
 		}
-		CXStringDictionarySetEntry(nodeIdMap, parsed.nodes.items[i].idText, (void *)(uintptr_t)(nodeIndices[i] + 1u));
+		if (!GMLReaderMember(reader, InterchangeScopeEdge, position, index, &key)) {
+			return CXFalse;
+		}
+		position += 1;
+	}
+	if (!GMLLexerNext(lexer)) {
+		return CXFalse;
+	}
+	reader->edgeRecords += 1;
+	if (reader->assigning) {
+		return CXTrue;
+	}
+	if (!hasSource || !hasTarget) {
+		GMLLexerSetError(lexer, "edge without a scalar source and target");
+		return CXFalse;
+	}
+	if (!GMLReserve((void **)&reader->edges, &reader->edgeCapacity, reader->edgeCount + 1, sizeof(CXEdge))) {
+		return CXFalse;
+	}
+	CXEdge *edge = &reader->edges[reader->edgeCount];
+	if (!GMLReaderResolveEndpoint(reader, reader->sourceText.data, CXFalse, &edge->from) ||
+		!GMLReaderResolveEndpoint(reader, reader->targetText.data, CXTrue, &edge->to)) {
+		return CXFalse;
 	}
+	reader->edgeCount += 1;
+	return CXTrue;
+}
 
-	if (!CXNetworkDefineNodeAttribute(network, "_original_ids_", CXStringAttributeType, 1)) {
-		goto cleanup;
+/** Walks the whole document once; which pass it is depends on `reader->assigning`. */
+static CXBool GMLReaderWalk(GMLReader *reader) {
+	GMLLexer *lexer = &reader->lexer;
+	lexer->offset = 0;
+	reader->nodeRecords = 0;
+	reader->edgeRecords = 0;
+	size_t graphPosition = 0;
+	if (!GMLLexerNext(lexer)) {
+		return CXFalse;
 	}
-	CXString *originalIds = (CXString *)CXNetworkGetNodeAttributeBuffer(network, "_original_ids_");
-	if (!originalIds) {
-		goto cleanup;
-	}
-	for (size_t i = 0; i < parsed.nodes.count; i += 1) {
-		originalIds[nodeIndices[i]] = CXNewStringFromString(parsed.nodes.items[i].idText);
-		if (!originalIds[nodeIndices[i]]) {
-			goto cleanup;
-		}
-	}
-
-	CXStringDictionaryRef graphInfer = CXNewStringDictionary();
-	CXStringDictionaryRef nodeInfer = CXNewStringDictionary();
-	CXStringDictionaryRef edgeInfer = CXNewStringDictionary();
-	if (!graphInfer || !nodeInfer || !edgeInfer) {
-		GMLInferDictionaryDestroy(graphInfer);
-		GMLInferDictionaryDestroy(nodeInfer);
-		GMLInferDictionaryDestroy(edgeInfer);
-		goto cleanup;
-	}
-	if (!GMLCollectInferredAttributes(&parsed.graphAttributes, graphInfer)) {
-		GMLInferDictionaryDestroy(graphInfer);
-		GMLInferDictionaryDestroy(nodeInfer);
-		GMLInferDictionaryDestroy(edgeInfer);
-		goto cleanup;
-	}
-	for (size_t i = 0; i < parsed.nodes.count; i += 1) {
-		if (!GMLCollectInferredAttributes(&parsed.nodes.items[i].attributes, nodeInfer)) {
-			GMLInferDictionaryDestroy(graphInfer);
-			GMLInferDictionaryDestroy(nodeInfer);
-			GMLInferDictionaryDestroy(edgeInfer);
-			goto cleanup;
-		}
-	}
-	for (size_t i = 0; i < parsed.edges.count; i += 1) {
-		if (!GMLCollectInferredAttributes(&parsed.edges.items[i].attributes, edgeInfer)) {
-			GMLInferDictionaryDestroy(graphInfer);
-			GMLInferDictionaryDestroy(nodeInfer);
-			GMLInferDictionaryDestroy(edgeInfer);
-			goto cleanup;
-		}
-	}
-	if (!GMLDefineAttributesFromInferMap(network, CXAttributeScopeNetwork, graphInfer) ||
-	    !GMLDefineAttributesFromInferMap(network, CXAttributeScopeNode, nodeInfer) ||
-	    !GMLDefineAttributesFromInferMap(network, CXAttributeScopeEdge, edgeInfer)) {
-		GMLInferDictionaryDestroy(graphInfer);
-		GMLInferDictionaryDestroy(nodeInfer);
-		GMLInferDictionaryDestroy(edgeInfer);
-		goto cleanup;
-	}
-	GMLInferDictionaryDestroy(graphInfer);
-	GMLInferDictionaryDestroy(nodeInfer);
-	GMLInferDictionaryDestroy(edgeInfer);
-
-	if (!GMLAssignAttributesFromList(network, CXAttributeScopeNetwork, 0, &parsed.graphAttributes)) {
-		goto cleanup;
-	}
-	for (size_t i = 0; i < parsed.nodes.count; i += 1) {
-		if (!GMLAssignAttributesFromList(network, CXAttributeScopeNode, nodeIndices[i], &parsed.nodes.items[i].attributes)) {
-			goto cleanup;
-		}
-	}
-
-	if (parsed.edges.count > 0) {
-		edges = calloc(parsed.edges.count, sizeof(CXEdge));
-		edgeIndices = calloc(parsed.edges.count, sizeof(CXIndex));
-		if (!edges || !edgeIndices) {
-			goto cleanup;
-		}
-		for (size_t i = 0; i < parsed.edges.count; i += 1) {
-			void *fromEntry = CXStringDictionaryEntryForKey(nodeIdMap, parsed.edges.items[i].sourceText);
-			void *toEntry = CXStringDictionaryEntryForKey(nodeIdMap, parsed.edges.items[i].targetText);
-			if (!fromEntry || !toEntry) {
-				goto cleanup;
+	if (GMLTokenIs(&lexer->current, "graph")) {
+		if (!GMLLexerNext(lexer) || lexer->current.type != GMLTokenLBracket) {
+			GMLLexerSetError(lexer, "expected '[' after graph");
+			return CXFalse;
+		}
+	} else if (lexer->current.type != GMLTokenLBracket) {
+		GMLLexerSetError(lexer, "expected graph [ ... ]");
+		return CXFalse;
+	}
+	if (!GMLLexerNext(lexer)) {
+		return CXFalse;
+	}
+	while (lexer->current.type != GMLTokenRBracket) {
+		if (!GMLLexerExpectKey(lexer)) {
+			return CXFalse;
+		}
+		GMLToken key = lexer->current;
+		if (!GMLLexerNextValue(lexer)) {
+			return CXFalse;
+		}
+		if (GMLTokenIs(&key, "directed")) {
+			CXBool directed = CXFalse;
+			if (!reader->assigning && GMLTokenToBool(&reader->idText, &lexer->current, &directed)) {
+				reader->directed = directed;
+			}
+			if (!GMLLexerSkipValue(lexer)) {
+				return CXFalse;
 			}
-			edges[i].from = (CXIndex)((uintptr_t)fromEntry - 1u);
-			edges[i].to = (CXIndex)((uintptr_t)toEntry - 1u);
+			continue;
 		}
-		if (!CXNetworkAddEdges(network, edges, (CXSize)parsed.edges.count, edgeIndices)) {
-			goto cleanup;
+		if (lexer->current.type == GMLTokenLBracket && GMLTokenIs(&key, "node")) {
+			if (!GMLReaderNode(reader)) {
+				return CXFalse;
+			}
+			continue;
 		}
-		for (size_t i = 0; i < parsed.edges.count; i += 1) {
-			if (!GMLAssignAttributesFromList(network, CXAttributeScopeEdge, edgeIndices[i], &parsed.edges.items[i].attributes)) {
-				goto cleanup;
+		if (lexer->current.type == GMLTokenLBracket && GMLTokenIs(&key, "edge")) {
+			if (!GMLReaderEdge(reader)) {
+				return CXFalse;
 			}
+			continue;
+		}
+		if (!GMLReaderMember(reader, InterchangeScopeGraph, graphPosition, 0, &key)) {
+			return CXFalse;
 		}
+		graphPosition += 1;
 	}
+	return GMLLexerNext(lexer);
+}
 
-cleanup_success:
-	GMLParsedGraphFree(&parsed);
-	if (nodeIdMap) {
-		CXStringDictionaryDestroy(nodeIdMap);
+/**
+ * Reports synthetic and duplicate ids, then settles the endpoints that named
+ * nodes declared later in the file or not at all; the latter are appended as
+ * new nodes in edge order.
+ */
+static CXBool GMLReaderFinishNodes(GMLReader *reader) {
+	if (reader->syntheticIds > 0) {
+		InterchangeWarningAppend("GML assigned synthetic node ids to entries without an id");
+	}
+	for (size_t i = 0; i < reader->duplicateCount; i += 1) {
+		InterchangeWarningAppend("GML duplicated node id \"%s\"; keeping the first occurrence", reader->nodeIds[reader->duplicates[i]]);
+	}
+	for (size_t i = 0; i < reader->pendingCount; i += 1) {
+		GMLPendingEndpoint *pending = &reader->pending[i];
+		void *entry = CXStringDictionaryEntryForKey(reader->nodeIdMap, pending->id);
+		if (!entry) {
+			if (!GMLReaderAddNodeId(reader, pending->id)) {
+				return CXFalse;
+			}
+			entry = (void *)(uintptr_t)reader->nodeCount;
+		}
+		CXIndex position = (CXIndex)((uintptr_t)entry - 1u);
+		if (pending->isTarget) {
+			reader->edges[pending->edge].to = position;
+		} else {
+			reader->edges[pending->edge].from = position;
+		}
 	}
-	free(nodeIndices);
-	free(edges);
-	free(edgeIndices);
-	GMLValueFree(rootValue);
-	free(rootValue);
-	GMLTokenDispose(&lexer.current);
-	free(lexer.error);
-	free(buffer);
-	return network;
+	return CXTrue;
+}
 
-cleanup:
-	if (lexer.error) {
-		InterchangeWarningAppend("%s", lexer.error);
-	}
-	if (network) {
-		CXFreeNetwork(network);
-		network = NULL;
-	}
-	GMLParsedGraphFree(&parsed);
-	if (nodeIdMap) {
-		CXStringDictionaryDestroy(nodeIdMap);
-	}
-	free(nodeIndices);
-	free(edges);
-	free(edgeIndices);
-	GMLValueFree(rootValue);
-	free(rootValue);
-	GMLTokenDispose(&lexer.current);
-	free(lexer.error);
-	free(buffer);
-	return NULL;
+static void GMLReaderDispose(GMLReader *reader) {
+	free(reader->lexer.scratch[0]);
+	free(reader->lexer.scratch[1]);
+	free(reader->lexer.error);
+	free(reader->keyText.data);
+	free(reader->idText.data);
+	free(reader->sourceText.data);
+	free(reader->targetText.data);
+	for (int scope = 0; scope < 3; scope += 1) {
+		GMLKeyHintsFree(&reader->hints[scope]);
+		GMLInferDictionaryDestroy(reader->infer[scope]);
+	}
+	for (size_t i = 0; i < reader->nodeCount; i += 1) {
+		free(reader->nodeIds[i]);
+	}
+	free(reader->nodeIds);
+	if (reader->nodeIdMap) {
+		CXStringDictionaryDestroy(reader->nodeIdMap);
+	}
+	free(reader->duplicates);
+	free(reader->edges);
+	for (size_t i = 0; i < reader->pendingCount; i += 1) {
+		free(reader->pending[i].id);
+	}
+	free(reader->pending);
+	free(reader->nodeIndices);
+	free(reader->edgeIndices);
+}
+
+/**
+ * Builds the network between the two passes: nodes with their original ids,
+ * attributes from the inferred types, and every edge in one batch.
+ */
+static CXBool GMLReaderBuildNetwork(GMLReader *reader) {
+	CXNetworkRef network = CXNewNetworkWithCapacity(reader->directed, reader->nodeCount, reader->edgeCount > 0 ? reader->edgeCount : 1);
+	if (!network) {
+		return CXFalse;
+	}
+	reader->network = network;
+	reader->nodeIndices = calloc(reader->nodeCount, sizeof(CXIndex));
+	if (!reader->nodeIndices || !CXNetworkAddNodes(network, (CXSize)reader->nodeCount, reader->nodeIndices)) {
+		return CXFalse;
+	}
+	if (!CXNetworkDefineNodeAttribute(network, "_original_ids_", CXStringAttributeType, 1)) {
+		return CXFalse;
+	}
+	CXString *originalIds = (CXString *)CXNetworkGetNodeAttributeBuffer(network, "_original_ids_");
+	if (!originalIds) {
+		return CXFalse;
+	}
+	for (size_t i = 0; i < reader->nodeCount; i += 1) {
+		originalIds[reader->nodeIndices[i]] = reader->nodeIds[i];
+		reader->nodeIds[i] = NULL;
+	}
+	if (!GMLDefineAttributesFromInferMap(network, InterchangeScopeGraph, reader->infer[InterchangeScopeGraph]) ||
+		!GMLDefineAttributesFromInferMap(network, InterchangeScopeNode, reader->infer[InterchangeScopeNode]) ||
+		!GMLDefineAttributesFromInferMap(network, InterchangeScopeEdge, reader->infer[InterchangeScopeEdge])) {
+		return CXFalse;
+	}
+	if (reader->edgeCount == 0) {
+		return CXTrue;
+	}
+	for (size_t i = 0; i < reader->edgeCount; i += 1) {
+		reader->edges[i].from = reader->nodeIndices[reader->edges[i].from];
+		reader->edges[i].to = reader->nodeIndices[reader->edges[i].to];
+	}
+	reader->edgeIndices = calloc(reader->edgeCount, sizeof(CXIndex));
+	return reader->edgeIndices && CXNetworkAddEdges(network, reader->edges, (CXSize)reader->edgeCount, reader->edgeIndices);
+}
+
+struct CXNetwork* CXNetworkReadGML(const char *path) {
+	InterchangeWarningClear();
+	if (!path) {
+		errno = EINVAL;
+		return NULL;
+	}
+	GMLInput input = { NULL, 0, CXFalse };
+	if (!GMLInputOpen(&input, path)) {
+		return NULL;
+	}
+	GMLReader reader;
+	memset(&reader, 0, sizeof(reader));
+	reader.lexer.text = input.data;
+	reader.lexer.length = input.size;
+	reader.nodeIdMap = CXNewStringDictionary();
+	CXBool ok = reader.nodeIdMap != NULL;
+	for (int scope = 0; ok && scope < 3; scope += 1) {
+		reader.infer[scope] = CXNewStringDictionary();
+		ok = reader.infer[scope] != NULL;
+	}
+	ok = ok && GMLReaderWalk(&reader) && GMLReaderFinishNodes(&reader);
+	if (ok && reader.nodeCount == 0) {
+		reader.network = CXNewNetwork(reader.directed);
+		ok = reader.network != NULL;
+	} else if (ok) {
+		ok = GMLReaderBuildNetwork(&reader);
+		if (ok) {
+			reader.assigning = CXTrue;
+			for (int scope = 0; scope < 3; scope += 1) {
+				GMLKeyHintsReset(&reader.hints[scope]);
+			}
+			ok = GMLReaderWalk(&reader);
+		}
+	}
+	CXNetworkRef network = reader.network;
+	if (!ok) {
+		if (reader.lexer.error) {
+			InterchangeWarningAppend("%s", reader.lexer.error);
+		}
+		if (network) {
+			CXFreeNetwork(network);
+			network = NULL;
+		}
+	}
+	GMLReaderDispose(&reader);
+	GMLInputClose(&input);
+	return network;
 }
@@ -6,7 +6,6 @@
 #include <stdlib.h>
 #include <string.h>
 
-#define CX_DIMENSION_MAX_PARALLEL_WORKERS 32u
 #define CX_DIMENSION_FORWARD_MAX_ORDER 6u
 #define CX_DIMENSION_BACKWARD_MAX_ORDER 6u
 #define CX_DIMENSION_CENTRAL_MAX_ORDER 4u
@@ -272,90 +271,13 @@ static float CXDimensionEstimateFromAverageSeries(
 	return isfinite(value) ? (float)value : 0.0f;
 }
 
-static CXBool CXDimensionComputeNodeCapacity(
-	CXNetworkRef network,
-	CXIndex source,
-	CXSize maxLevel,
-	int32_t *distances,
-	CXIndex *queue,
-	uint32_t *levelCounts,
-	uint32_t *capacity
-) {
-	if (!network || !distances || !queue || !levelCounts || !capacity) {
-		return CXFalse;
-	}
-	if (source >= network->nodeCapacity || !network->nodeActive[source]) {
-		return CXFalse;
-	}
-
-	CXSize levels = maxLevel + 1;
-	memset(levelCounts, 0, levels * sizeof(uint32_t));
-
-	CXSize head = 0;
-	CXSize tail = 0;
-	queue[tail++] = source;
-	distances[source] = 0;
-
-	while (head < tail) {
-		CXIndex node = queue[head++];
-		int32_t distance = distances[node];
-		if (distance < 0) {
-			continue;
-		}
-		if ((CXSize)distance > maxLevel) {
-			continue;
-		}
-		if (levelCounts[distance] < UINT32_MAX) {
-			levelCounts[distance] += 1;
-		}
-		if ((CXSize)distance == maxLevel) {
-			continue;
-		}
-
-		CXNeighborContainer *neighbors = &network->nodes[node].outNeighbors;
-		if (neighbors->storageType == CXNeighborListType) {
-			CXNeighborList *list = &neighbors->storage.list;
-			for (CXSize i = 0; i < list->count; i++) {
-				CXIndex neighborNode = list->nodes[i];
-				if (neighborNode >= network->nodeCapacity || !network->nodeActive[neighborNode]) {
-					continue;
-				}
-				if (distances[neighborNode] >= 0) {
-					continue;
-				}
-				distances[neighborNode] = distance + 1;
-				queue[tail++] = neighborNode;
-			}
-		} else {
-			CXNeighborMap *map = &neighbors->storage.map;
-			if (map->edgeToNode) {
-				CXUIntegerDictionaryFOR(entry, map->edgeToNode) {
-					CXIndex *nodePtr = (CXIndex *)entry->data;
-					CXIndex neighborNode = nodePtr ? *nodePtr : CXIndexMAX;
-					if (neighborNode >= network->nodeCapacity || !network->nodeActive[neighborNode]) {
-						continue;
-					}
-					if (distances[neighborNode] >= 0) {
-						continue;
-					}
-					distances[neighborNode] = distance + 1;
-					queue[tail++] = neighborNode;
-				}
-			}
-		}
-	}
-
+/* Converts per-level discovery counts into cumulative ball sizes. */
+static void CXDimensionAccumulateCapacity(const uint32_t *levelCounts, CXSize maxLevel, uint32_t *capacity) {
 	uint64_t running = 0;
 	for (CXSize r = 0; r <= maxLevel; r++) {
 		running += (uint64_t)levelCounts[r];
 		capacity[r] = running > UINT32_MAX ? UINT32_MAX : (uint32_t)running;
 	}
-
-	for (CXSize i = 0; i < tail; i++) {
-		distances[queue[i]] = -1;
-	}
-
-	return CXTrue;
 }
 
 CXBool CXNetworkMeasureNodeDimension(
@@ -384,30 +306,27 @@ CXBool CXNetworkMeasureNodeDimension(
 	CXSize capacityMaxLevel = maxLevel + extraPadding;
 	CXSize outputLevels = maxLevel + 1;
 	CXSize capacityLevels = capacityMaxLevel + 1;
-	int32_t *distances = (int32_t *)malloc(network->nodeCapacity * sizeof(int32_t));
-	CXIndex *queue = (CXIndex *)malloc(network->nodeCapacity * sizeof(CXIndex));
 	uint32_t *levelCounts = (uint32_t *)calloc(capacityLevels, sizeof(uint32_t));
 	uint32_t *capacity = (uint32_t *)calloc(capacityLevels, sizeof(uint32_t));
-	if (!distances || !queue || !levelCounts || !capacity) {
-		free(distances);
-		free(queue);
+	CXNetworkSnapshotRef snapshot = CXNetworkSnapshotAcquire(network);
+	CXTraversalBFS bfs;
+	if (!levelCounts || !capacity || !snapshot
+		|| !CXTraversalBFSInit(&bfs, snapshot, CXTrue, CXFalse, CXThreadPoolGetWorkerCount())) {
 		free(levelCounts);
 		free(capacity);
+		CXNetworkSnapshotRelease(snapshot);
 		return CXFalse;
 	}
 
-	for (CXSize i = 0; i < network->nodeCapacity; i++) {
-		distances[i] = -1;
-	}
-
-	CXBool ok = CXDimensionComputeNodeCapacity(network, node, capacityMaxLevel, distances, queue, levelCounts, capacity);
-	if (!ok) {
-		free(distances);
-		free(queue);
-		free(levelCounts);
-		free(capacity);
-		return CXFalse;
+	CXIndex source = snapshot->nodeToCompact[node];
+	CXTraversalBFSRun(&bfs, &source, 1, capacityMaxLevel);
+	for (CXSize r = 0; r < bfs.levelCount && r <= capacityMaxLevel; r++) {
+		CXSize count = bfs.levelOffsets[r + 1] - bfs.levelOffsets[r];
+		levelCounts[r] = count > UINT32_MAX ? UINT32_MAX : (uint32_t)count;
 	}
+	CXDimensionAccumulateCapacity(levelCounts, capacityMaxLevel, capacity);
+	CXTraversalBFSDestroy(&bfs);
+	CXNetworkSnapshotRelease(snapshot);
 
 	if (outCapacity) {
 		memcpy(outCapacity, capacity, outputLevels * sizeof(uint32_t));
@@ -419,13 +338,114 @@ CXBool CXNetworkMeasureNodeDimension(
 		}
 	}
 
-	free(distances);
-	free(queue);
 	free(levelCounts);
 	free(capacity);
 	return CXTrue;
 }
 
+typedef struct {
+	CXTraversalMultiBFS bfs;
+	CXBool hasTraversal;
+	uint32_t *levelCounts; /* CX_TRAVERSAL_BATCH_SIZE rows of capacityLevels */
+	uint32_t *capacity;
+	float *localDimensions;
+	double *capacitySum;
+	double *dimensionSum;
+	double *dimensionSqSum;
+} CXDimensionWorkerState;
+
+typedef struct {
+	const CXIndex *selectedNodes; /* compact ids */
+	CXSize selectedCount;
+	CXSize maxLevel;
+	CXSize capacityMaxLevel;
+	CXDimensionDifferenceMethod method;
+	CXSize order;
+	CXDimensionWorkerState *workers;
+} CXDimensionMeasureTask;
+
+typedef struct {
+	uint32_t *levelCounts;
+	CXSize capacityLevels;
+} CXDimensionBatchCounts;
+
+static void CXDimensionWorkerStateDestroy(CXDimensionWorkerState *state) {
+	if (state->hasTraversal) {
+		CXTraversalMultiBFSDestroy(&state->bfs);
+	}
+	free(state->levelCounts);
+	free(state->capacity);
+	free(state->localDimensions);
+	free(state->capacitySum);
+	free(state->dimensionSum);
+	free(state->dimensionSqSum);
+	memset(state, 0, sizeof(*state));
+}
+
+static CXBool CXDimensionWorkerStateInit(CXDimensionWorkerState *state, CXNetworkSnapshotRef snapshot, CXSize capacityLevels, CXSize outputLevels) {
+	memset(state, 0, sizeof(*state));
+	state->hasTraversal = CXTraversalMultiBFSInit(&state->bfs, snapshot, CXTrue, CXFalse);
+	state->levelCounts = (uint32_t *)calloc(CX_TRAVERSAL_BATCH_SIZE * capacityLevels, sizeof(uint32_t));
+	state->capacity = (uint32_t *)calloc(capacityLevels, sizeof(uint32_t));
+	state->localDimensions = (float *)calloc(outputLevels, sizeof(float));
+	state->capacitySum = (double *)calloc(capacityLevels, sizeof(double));
+	state->dimensionSum = (double *)calloc(outputLevels, sizeof(double));
+	state->dimensionSqSum = (double *)calloc(outputLevels, sizeof(double));
+	if (!state->hasTraversal || !state->levelCounts || !state->capacity || !state->localDimensions || !state->capacitySum || !state->dimensionSum || !state->dimensionSqSum) {
+		CXDimensionWorkerStateDestroy(state);
+		return CXFalse;
+	}
+	return CXTrue;
+}
+
+static void CXDimensionCountVisit(void *context, CXIndex node, CXSize level, uint64_t sourceMask) {
+	(void)node;
+	CXDimensionBatchCounts *counts = (CXDimensionBatchCounts *)context;
+	while (sourceMask) {
+		CXSize source = CXTraversalLowestBit(sourceMask);
+		sourceMask &= sourceMask - 1;
+		uint32_t *count = &counts->levelCounts[source * counts->capacityLevels + level];
+		if (*count < UINT32_MAX) {
+			*count += 1;
+		}
+	}
+}
+
+/* Each block is one batch of up to CX_TRAVERSAL_BATCH_SIZE sources advanced
+ * together by the bit-parallel traversal. */
+static void CXDimensionMeasureRange(void *context, CXIndex start, CXIndex end, CXSize workerIndex) {
+	(void)end;
+	CXDimensionMeasureTask *task = (CXDimensionMeasureTask *)context;
+	CXDimensionWorkerState *state = &task->workers[workerIndex];
+	CXSize capacityLevels = task->capacityMaxLevel + 1;
+	CXIndex first = start * CX_TRAVERSAL_BATCH_SIZE;
+	CXSize batchCount = CXMIN((CXSize)CX_TRAVERSAL_BATCH_SIZE, task->selectedCount - first);
+
+	memset(state->levelCounts, 0, batchCount * capacityLevels * sizeof(uint32_t));
+	CXDimensionBatchCounts counts = {
+		.levelCounts = state->levelCounts,
+		.capacityLevels = capacityLevels
+	};
+	CXTraversalMultiBFSRun(&state->bfs, task->selectedNodes + first, batchCount, task->capacityMaxLevel, CXDimensionCountVisit, &counts);
+
+	for (CXSize b = 0; b < batchCount; b++) {
+		CXDimensionAccumulateCapacity(state->levelCounts + b * capacityLevels, task->capacityMaxLevel, state->capacity);
+		for (CXSize r = 0; r <= task->capacityMaxLevel; r++) {
+			state->capacitySum[r] += (double)state->capacity[r];
+		}
+
+		state->localDimensions[0] = 0.0f;
+		for (CXSize r = 1; r <= task->maxLevel; r++) {
+			state->localDimensions[r] = CXDimensionEstimateFromCapacity(state->capacity, task->capacityMaxLevel, r, task->method, task->order);
+		}
+		for (CXSize r = 0; r <= task->maxLevel; r++) {
+			double value = (double)state->localDimensions[r];
+			state->dimensionSum[r] += value;
+			state->dimensionSqSum[r] += value * value;
+		}
+	}
+}
+
 CXSize CXNetworkMeasureDimension(
 	CXNetworkRef network,
 	const CXIndex *nodes,
@@ -453,33 +473,40 @@ CXSize CXNetworkMeasureDimension(
 	CXSize outputLevels = maxLevel + 1;
 	CXSize capacityLevels = capacityMaxLevel + 1;
 
+	CXNetworkSnapshotRef snapshot = CXNetworkSnapshotAcquire(network);
+	if (!snapshot) {
+		return 0;
+	}
+
+	/* Sources are kept as compact snapshot ids. */
 	CXIndex *selectedNodes = NULL;
 	CXSize selectedCount = 0;
 	if (nodes && nodeCount > 0) {
 		selectedNodes = (CXIndex *)malloc(nodeCount * sizeof(CXIndex));
 		if (!selectedNodes) {
+			CXNetworkSnapshotRelease(snapshot);
 			return 0;
 		}
 		for (CXSize i = 0; i < nodeCount; i++) {
 			CXIndex node = nodes[i];
 			if (node < network->nodeCapacity && network->nodeActive[node]) {
-				selectedNodes[selectedCount++] = node;
+				selectedNodes[selectedCount++] = snapshot->nodeToCompact[node];
 			}
 		}
 	} else {
-		selectedNodes = (CXIndex *)malloc(network->nodeCount * sizeof(CXIndex));
+		selectedNodes = (CXIndex *)malloc(snapshot->nodeCount * sizeof(CXIndex));
 		if (!selectedNodes) {
+			CXNetworkSnapshotRelease(snapshot);
 			return 0;
 		}
-		for (CXSize node = 0; node < network->nodeCapacity; node++) {
-			if (network->nodeActive[node]) {
-				selectedNodes[selectedCount++] = node;
-			}
+		for (CXSize u = 0; u < snapshot->nodeCount; u++) {
+			selectedNodes[selectedCount++] = u;
 		}
 	}
 
 	if (selectedCount == 0) {
 		free(selectedNodes);
+		CXNetworkSnapshotRelease(snapshot);
 		return 0;
 	}
 
@@ -493,88 +520,53 @@ CXSize CXNetworkMeasureDimension(
 		free(sumLocalDimension);
 		free(sumSqLocalDimension);
 		free(averageCapacity);
+		CXNetworkSnapshotRelease(snapshot);
 		return 0;
 	}
 
-	CXSize workerCount = CXMIN(selectedCount, (CXSize)CX_DIMENSION_MAX_PARALLEL_WORKERS);
-	if (workerCount == 0) {
-		workerCount = 1;
+	CXSize batchCount = 1 + (selectedCount - 1) / CX_TRAVERSAL_BATCH_SIZE;
+	CXSize workerCount = CXParallelWorkerCount(batchCount);
+	CXDimensionWorkerState *workers = (CXDimensionWorkerState *)calloc(workerCount, sizeof(CXDimensionWorkerState));
+	CXBool workersOk = workers != NULL;
+	for (CXSize w = 0; workersOk && w < workerCount; w++) {
+		workersOk = CXDimensionWorkerStateInit(&workers[w], snapshot, capacityLevels, outputLevels);
 	}
-	CXSize chunkSize = 1 + ((selectedCount - 1) / workerCount);
-
-	CXParallelForStart(dimensionMeasureLoop, workerIndex, workerCount) {
-		CXSize start = workerIndex * chunkSize;
-		CXSize end = CXMIN(selectedCount, (workerIndex + 1) * chunkSize);
-		if (start >= end) {
-			continue;
-		}
-
-		int32_t *distances = (int32_t *)malloc(network->nodeCapacity * sizeof(int32_t));
-		CXIndex *queue = (CXIndex *)malloc(network->nodeCapacity * sizeof(CXIndex));
-		uint32_t *levelCounts = (uint32_t *)calloc(capacityLevels, sizeof(uint32_t));
-		uint32_t *capacity = (uint32_t *)calloc(capacityLevels, sizeof(uint32_t));
-		float *localDimensions = (float *)calloc(outputLevels, sizeof(float));
-		double *localCapacitySum = (double *)calloc(capacityLevels, sizeof(double));
-		double *localDimensionSum = (double *)calloc(outputLevels, sizeof(double));
-		double *localDimensionSqSum = (double *)calloc(outputLevels, sizeof(double));
-
-		if (!distances || !queue || !levelCounts || !capacity || !localDimensions || !localCapacitySum || !localDimensionSum || !localDimensionSqSum) {
-			free(distances);
-			free(queue);
-			free(levelCounts);
-			free(capacity);
-			free(localDimensions);
-			free(localCapacitySum);
-			free(localDimensionSum);
-			free(localDimensionSqSum);
-			continue;
-		}
-
-		for (CXSize i = 0; i < network->nodeCapacity; i++) {
-			distances[i] = -1;
+	if (!workersOk) {
+		for (CXSize w = 0; workers && w < workerCount; w++) {
+			CXDimensionWorkerStateDestroy(&workers[w]);
 		}
+		free(workers);
+		free(selectedNodes);
+		free(sumCapacity);
+		free(sumLocalDimension);
+		free(sumSqLocalDimension);
+		free(averageCapacity);
+		CXNetworkSnapshotRelease(snapshot);
+		return 0;
+	}
 
-		for (CXSize idx = start; idx < end; idx++) {
-			CXIndex node = selectedNodes[idx];
-			if (!CXDimensionComputeNodeCapacity(network, node, capacityMaxLevel, distances, queue, levelCounts, capacity)) {
-				continue;
-			}
-			for (CXSize r = 0; r <= capacityMaxLevel; r++) {
-				localCapacitySum[r] += (double)capacity[r];
-			}
+	CXDimensionMeasureTask task = {
+		.selectedNodes = selectedNodes,
+		.selectedCount = selectedCount,
+		.maxLevel = maxLevel,
+		.capacityMaxLevel = capacityMaxLevel,
+		.method = method,
+		.order = order,
+		.workers = workers
+	};
+	CXParallelForRange(batchCount, 1, workerCount, CXDimensionMeasureRange, &task);
 
-			localDimensions[0] = 0.0f;
-			for (CXSize r = 1; r <= maxLevel; r++) {
-				localDimensions[r] = CXDimensionEstimateFromCapacity(capacity, capacityMaxLevel, r, method, order);
-			}
-			for (CXSize r = 0; r <= maxLevel; r++) {
-				double value = (double)localDimensions[r];
-				localDimensionSum[r] += value;
-				localDimensionSqSum[r] += value * value;
-			}
+	for (CXSize w = 0; w < workerCount; w++) {
+		for (CXSize r = 0; r <= capacityMaxLevel; r++) {
+			sumCapacity[r] += workers[w].capacitySum[r];
 		}
-
-		CXParallelLoopCriticalRegionStart(dimensionMeasureLoop) {
-			for (CXSize r = 0; r <= capacityMaxLevel; r++) {
-				sumCapacity[r] += localCapacitySum[r];
-			}
-			for (CXSize r = 0; r <= maxLevel; r++) {
-				sumLocalDimension[r] += localDimensionSum[r];
-				sumSqLocalDimension[r] += localDimensionSqSum[r];
-			}
+		for (CXSize r = 0; r <= maxLevel; r++) {
+			sumLocalDimension[r] += workers[w].dimensionSum[r];
+			sumSqLocalDimension[r] += workers[w].dimensionSqSum[r];
 		}
-		CXParallelLoopCriticalRegionEnd(dimensionMeasureLoop);
-
-		free(distances);
-		free(queue);
-		free(levelCounts);
-		free(capacity);
-		free(localDimensions);
-		free(localCapacitySum);
-		free(localDimensionSum);
-		free(localDimensionSqSum);
+		CXDimensionWorkerStateDestroy(&workers[w]);
 	}
-	CXParallelForEnd(dimensionMeasureLoop);
+	free(workers);
 
 	double invCount = 1.0 / (double)selectedCount;
 	for (CXSize r = 0; r <= capacityMaxLevel; r++) {
@@ -611,12 +603,14 @@ CXSize CXNetworkMeasureDimension(
 	free(sumLocalDimension);
 	free(sumSqLocalDimension);
 	free(averageCapacity);
+	CXNetworkSnapshotRelease(snapshot);
 	return selectedCount;
 }
 
 // Additional node measurements ------------------------------------------------
 
-#define CX_MEASUREMENT_MAX_PARALLEL_WORKERS 32u
+#define CX_MEASUREMENT_BLOCKS_PER_WORKER 8u
+#define CX_MEASUREMENT_MIN_GRAIN 256u
 #define CX_MEASUREMENT_WEIGHT_EPSILON 1e-12
 #define CX_MEASUREMENT_EIGENVECTOR_SHIFT 1.0
 
@@ -628,19 +622,23 @@ typedef struct {
 	CXMeasurementEdgeWeightReader read;
 } CXMeasurementEdgeWeights;
 
+/* Borrowed view over the network's cached CSR snapshot; weights are attached
+ * on demand by the kernels that need them. */
 typedef struct {
+	CXNetworkSnapshotRef snapshot;
+	CXNetworkSnapshotWeightsRef weightColumn;
 	CXBool directed;
 	CXSize nodeCount;
 	CXSize nodeCapacity;
-	CXIndex *compactToNode; /* nodeCount */
-	CXIndex *nodeToCompact; /* nodeCapacity */
-	CXIndex *outOffsets;    /* nodeCount + 1 */
-	CXIndex *outNeighbors;  /* outEdgeCount */
-	double *outWeights;     /* outEdgeCount */
+	const CXIndex *compactToNode; /* nodeCount */
+	const CXIndex *nodeToCompact; /* nodeCapacity */
+	const CXIndex *outOffsets;    /* nodeCount + 1 */
+	const CXIndex *outNeighbors;  /* outEdgeCount */
+	const double *outWeights;     /* outEdgeCount */
 	CXSize outEdgeCount;
-	CXIndex *inOffsets;     /* nodeCount + 1 */
-	CXIndex *inNeighbors;   /* inEdgeCount */
-	double *inWeights;      /* inEdgeCount */
+	const CXIndex *inOffsets;     /* nodeCount + 1 */
+	const CXIndex *inNeighbors;   /* inEdgeCount */
+	const double *inWeights;      /* inEdgeCount */
 	CXSize inEdgeCount;
 } CXMeasurementGraph;
 
@@ -752,13 +750,16 @@ static CXSize CXMeasurementResolveWorkerCount(CXMeasurementExecutionMode mode, C
 	if (mode == CXMeasurementExecutionSingleThread) {
 		return 1;
 	}
-#if CX_ENABLE_PARALLELISM
-	CXSize workers = CXMIN(taskCount, (CXSize)CX_MEASUREMENT_MAX_PARALLEL_WORKERS);
+	CXSize workers = CXParallelWorkerCount(taskCount);
 	return workers == 0 ? 1 : workers;
-#else
-	(void)mode;
-	return 1;
-#endif
+}
+
+/* Block size giving every worker several blocks to steal from while keeping
+ * per-block overhead negligible for cheap per-node kernels. */
+static CXSize CXMeasurementGrainSize(CXSize taskCount, CXSize workerCount) {
+	CXSize blocks = CXMAX((CXSize)1, workerCount) * CX_MEASUREMENT_BLOCKS_PER_WORKER;
+	CXSize grain = taskCount / blocks;
+	return CXMAX(grain, (CXSize)CX_MEASUREMENT_MIN_GRAIN);
 }
 
 static CXBool CXMeasurementResolveEdgeWeights(CXNetworkRef network, const CXString name, CXMeasurementEdgeWeights *outWeights) {
@@ -809,124 +810,50 @@ static void CXMeasurementGraphDestroy(CXMeasurementGraph *graph) {
 	if (!graph) {
 		return;
 	}
-	free(graph->compactToNode);
-	free(graph->nodeToCompact);
-	free(graph->outOffsets);
-	free(graph->outNeighbors);
-	free(graph->outWeights);
-	free(graph->inOffsets);
-	free(graph->inNeighbors);
-	free(graph->inWeights);
+	CXNetworkSnapshotWeightsRelease(graph->weightColumn);
+	CXNetworkSnapshotRelease(graph->snapshot);
 	memset(graph, 0, sizeof(*graph));
 }
 
-static CXBool CXMeasurementGraphBuild(
-	CXMeasurementGraph *outGraph,
-	CXNetworkRef network,
-	const CXMeasurementEdgeWeights *weights
-) {
-	if (!outGraph || !network || !weights) {
+static CXBool CXMeasurementGraphBuild(CXMeasurementGraph *outGraph, CXNetworkRef network) {
+	if (!outGraph || !network) {
 		return CXFalse;
 	}
 	memset(outGraph, 0, sizeof(*outGraph));
 
-	outGraph->directed = network->isDirected;
-	outGraph->nodeCapacity = network->nodeCapacity;
-	for (CXIndex node = 0; node < network->nodeCapacity; node++) {
-		if (network->nodeActive[node]) {
-			outGraph->nodeCount += 1;
-		}
-	}
-	if (outGraph->nodeCount == 0) {
-		return CXTrue;
-	}
-
-	outGraph->compactToNode = (CXIndex *)malloc(outGraph->nodeCount * sizeof(CXIndex));
-	outGraph->nodeToCompact = (CXIndex *)malloc(outGraph->nodeCapacity * sizeof(CXIndex));
-	if (!outGraph->compactToNode || !outGraph->nodeToCompact) {
-		CXMeasurementGraphDestroy(outGraph);
+	CXNetworkSnapshotRef snapshot = CXNetworkSnapshotAcquire(network);
+	if (!snapshot) {
 		return CXFalse;
 	}
+	outGraph->snapshot = snapshot;
+	outGraph->directed = snapshot->directed;
+	outGraph->nodeCount = snapshot->nodeCount;
+	outGraph->nodeCapacity = snapshot->nodeCapacity;
+	outGraph->compactToNode = snapshot->compactToNode;
+	outGraph->nodeToCompact = snapshot->nodeToCompact;
+	outGraph->outOffsets = snapshot->outOffsets;
+	outGraph->outNeighbors = snapshot->outNeighbors;
+	outGraph->outEdgeCount = snapshot->outEdgeCount;
+	outGraph->inOffsets = snapshot->inOffsets;
+	outGraph->inNeighbors = snapshot->inNeighbors;
+	outGraph->inEdgeCount = snapshot->inEdgeCount;
+	return CXTrue;
+}
 
-	for (CXIndex node = 0; node < outGraph->nodeCapacity; node++) {
-		outGraph->nodeToCompact[node] = CXIndexMAX;
-	}
-	CXIndex cursor = 0;
-	for (CXIndex node = 0; node < network->nodeCapacity; node++) {
-		if (!network->nodeActive[node]) {
-			continue;
-		}
-		outGraph->compactToNode[cursor] = node;
-		outGraph->nodeToCompact[node] = cursor;
-		cursor += 1;
-	}
-
-	outGraph->outOffsets = (CXIndex *)calloc(outGraph->nodeCount + 1, sizeof(CXIndex));
-	outGraph->inOffsets = (CXIndex *)calloc(outGraph->nodeCount + 1, sizeof(CXIndex));
-	if (!outGraph->outOffsets || !outGraph->inOffsets) {
-		CXMeasurementGraphDestroy(outGraph);
+/* Attaches the weight column of `edgeWeightAttribute` (unit weights for a
+ * NULL/empty name). Fails for missing or non-numeric attributes. */
+static CXBool CXMeasurementGraphAttachWeights(CXMeasurementGraph *graph, CXNetworkRef network, const CXString edgeWeightAttribute) {
+	if (!graph || !graph->snapshot) {
 		return CXFalse;
 	}
-
-	CXSize outEdgeCount = 0;
-	CXSize inEdgeCount = 0;
-	for (CXIndex u = 0; u < outGraph->nodeCount; u++) {
-		CXIndex node = outGraph->compactToNode[u];
-		outEdgeCount += CXNeighborContainerCount(&network->nodes[node].outNeighbors);
-		inEdgeCount += CXNeighborContainerCount(&network->nodes[node].inNeighbors);
-	}
-	outGraph->outEdgeCount = outEdgeCount;
-	outGraph->inEdgeCount = inEdgeCount;
-	outGraph->outNeighbors = outEdgeCount ? (CXIndex *)malloc(outEdgeCount * sizeof(CXIndex)) : NULL;
-	outGraph->outWeights = outEdgeCount ? (double *)malloc(outEdgeCount * sizeof(double)) : NULL;
-	outGraph->inNeighbors = inEdgeCount ? (CXIndex *)malloc(inEdgeCount * sizeof(CXIndex)) : NULL;
-	outGraph->inWeights = inEdgeCount ? (double *)malloc(inEdgeCount * sizeof(double)) : NULL;
-	if ((outEdgeCount && (!outGraph->outNeighbors || !outGraph->outWeights))
-		|| (inEdgeCount && (!outGraph->inNeighbors || !outGraph->inWeights))) {
-		CXMeasurementGraphDestroy(outGraph);
+	CXNetworkSnapshotWeightsRef column = CXNetworkSnapshotAcquireWeights(graph->snapshot, network, edgeWeightAttribute);
+	if (!column) {
 		return CXFalse;
 	}
-
-	CXIndex outCursor = 0;
-	CXIndex inCursor = 0;
-	for (CXIndex u = 0; u < outGraph->nodeCount; u++) {
-		CXIndex node = outGraph->compactToNode[u];
-		outGraph->outOffsets[u] = outCursor;
-		CXNeighborIterator iterator;
-		CXNeighborIteratorInit(&iterator, &network->nodes[node].outNeighbors);
-		while (CXNeighborIteratorNext(&iterator)) {
-			CXIndex neighbor = iterator.node;
-			if (neighbor >= outGraph->nodeCapacity || !network->nodeActive[neighbor]) {
-				continue;
-			}
-			CXIndex v = outGraph->nodeToCompact[neighbor];
-			if (v == CXIndexMAX) {
-				continue;
-			}
-			outGraph->outNeighbors[outCursor] = v;
-			outGraph->outWeights[outCursor] = weights->read(weights->base, weights->stride, iterator.edge);
-			outCursor += 1;
-		}
-		outGraph->inOffsets[u] = inCursor;
-		CXNeighborIteratorInit(&iterator, &network->nodes[node].inNeighbors);
-		while (CXNeighborIteratorNext(&iterator)) {
-			CXIndex neighbor = iterator.node;
-			if (neighbor >= outGraph->nodeCapacity || !network->nodeActive[neighbor]) {
-				continue;
-			}
-			CXIndex v = outGraph->nodeToCompact[neighbor];
-			if (v == CXIndexMAX) {
-				continue;
-			}
-			outGraph->inNeighbors[inCursor] = v;
-			outGraph->inWeights[inCursor] = weights->read(weights->base, weights->stride, iterator.edge);
-			inCursor += 1;
-		}
-	}
-	outGraph->outOffsets[outGraph->nodeCount] = outCursor;
-	outGraph->inOffsets[outGraph->nodeCount] = inCursor;
-	outGraph->outEdgeCount = outCursor;
-	outGraph->inEdgeCount = inCursor;
+	CXNetworkSnapshotWeightsRelease(graph->weightColumn);
+	graph->weightColumn = column;
+	graph->outWeights = column->outWeights;
+	graph->inWeights = column->inWeights;
 	return CXTrue;
 }
 
@@ -1081,114 +1008,6 @@ static float CXMeasurementStrengthReduce(double sum, double minValue, double max
 	}
 }
 
-static double CXMeasurementDirectedEdgeWeight(
-	CXNetworkRef network,
-	CXIndex from,
-	CXIndex to,
-	const CXMeasurementEdgeWeights *weights,
-	CXBool *outFound
-) {
-	if (outFound) {
-		*outFound = CXFalse;
-	}
-	if (!network || !weights || from >= network->nodeCapacity || to >= network->nodeCapacity) {
-		return 0.0;
-	}
-	if (!network->nodeActive[from] || !network->nodeActive[to]) {
-		return 0.0;
-	}
-
-	double total = 0.0;
-	CXBool found = CXFalse;
-	CXNeighborIterator iterator;
-	CXNeighborIteratorInit(&iterator, &network->nodes[from].outNeighbors);
-	while (CXNeighborIteratorNext(&iterator)) {
-		if (iterator.node != to) {
-			continue;
-		}
-		total += weights->read(weights->base, weights->stride, iterator.edge);
-		found = CXTrue;
-	}
-	if (outFound) {
-		*outFound = found;
-	}
-	return total;
-}
-
-static double CXMeasurementUndirectedEdgeWeight(
-	CXNetworkRef network,
-	CXIndex a,
-	CXIndex b,
-	const CXMeasurementEdgeWeights *weights,
-	CXBool *outFound
-) {
-	CXBool foundAB = CXFalse;
-	CXBool foundBA = CXFalse;
-	double ab = CXMeasurementDirectedEdgeWeight(network, a, b, weights, &foundAB);
-	double ba = CXMeasurementDirectedEdgeWeight(network, b, a, weights, &foundBA);
-
-	if (outFound) {
-		*outFound = (foundAB || foundBA) ? CXTrue : CXFalse;
-	}
-	if (foundAB && foundBA) {
-		return 0.5 * (ab + ba);
-	}
-	if (foundAB) {
-		return ab;
-	}
-	if (foundBA) {
-		return ba;
-	}
-	return 0.0;
-}
-
-static CXSize CXMeasurementCollectNeighbors(
-	CXNetworkRef network,
-	CXIndex node,
-	CXNeighborDirection direction,
-	uint32_t stamp,
-	uint32_t *seen,
-	CXIndex *neighbors
-) {
-	if (!network || !seen || !neighbors || node >= network->nodeCapacity || !network->nodeActive[node]) {
-		return 0;
-	}
-	CXSize count = 0;
-	CXNeighborIterator iterator;
-
-	if (direction == CXNeighborDirectionOut || direction == CXNeighborDirectionBoth) {
-		CXNeighborIteratorInit(&iterator, &network->nodes[node].outNeighbors);
-		while (CXNeighborIteratorNext(&iterator)) {
-			CXIndex neighbor = iterator.node;
-			if (neighbor == node || neighbor >= network->nodeCapacity || !network->nodeActive[neighbor]) {
-				continue;
-			}
-			if (seen[neighbor] == stamp) {
-				continue;
-			}
-			seen[neighbor] = stamp;
-			neighbors[count++] = neighbor;
-		}
-	}
-
-	if (direction == CXNeighborDirectionIn || (direction == CXNeighborDirectionBoth && network->isDirected)) {
-		CXNeighborIteratorInit(&iterator, &network->nodes[node].inNeighbors);
-		while (CXNeighborIteratorNext(&iterator)) {
-			CXIndex neighbor = iterator.node;
-			if (neighbor == node || neighbor >= network->nodeCapacity || !network->nodeActive[neighbor]) {
-				continue;
-			}
-			if (seen[neighbor] == stamp) {
-				continue;
-			}
-			seen[neighbor] = stamp;
-			neighbors[count++] = neighbor;
-		}
-	}
-
-	return count;
-}
-
 typedef struct CXCorenessSession {
 	CXNetworkRef network;
 	CXNeighborDirection direction;
@@ -1207,6 +1026,26 @@ typedef struct CXCorenessSession {
 	CXCorenessPhase phase;
 } CXCorenessSession;
 
+static void CXCorenessDegreeInitRange(void *context, CXIndex start, CXIndex end, CXSize workerIndex) {
+	(void)workerIndex;
+	CXCorenessSession *session = (CXCorenessSession *)context;
+	for (CXIndex u = start; u < end; u++) {
+		uint32_t degree = 0;
+		CXIndex outDegree = session->graph.outOffsets[u + 1] - session->graph.outOffsets[u];
+		CXIndex inDegree = session->graph.inOffsets[u + 1] - session->graph.inOffsets[u];
+		if (!session->graph.directed) {
+			degree = (uint32_t)outDegree;
+		} else if (session->direction == CXNeighborDirectionOut) {
+			degree = (uint32_t)outDegree;
+		} else if (session->direction == CXNeighborDirectionIn) {
+			degree = (uint32_t)inDegree;
+		} else {
+			degree = (uint32_t)(outDegree + inDegree);
+		}
+		session->degrees[u] = degree;
+	}
+}
+
 static CXBool CXCorenessSessionBuildInitialDegrees(CXCorenessSession *session) {
 	if (!session) {
 		return CXFalse;
@@ -1218,45 +1057,10 @@ static CXBool CXCorenessSessionBuildInitialDegrees(CXCorenessSession *session) {
 
 	const CXSize workerCount = CXMeasurementResolveWorkerCount(session->executionMode, nodeCount);
 	if (workerCount <= 1) {
-		for (CXIndex u = 0; u < nodeCount; u++) {
-			uint32_t degree = 0;
-			CXIndex outDegree = session->graph.outOffsets[u + 1] - session->graph.outOffsets[u];
-			CXIndex inDegree = session->graph.inOffsets[u + 1] - session->graph.inOffsets[u];
-			if (!session->graph.directed) {
-				degree = (uint32_t)outDegree;
-			} else if (session->direction == CXNeighborDirectionOut) {
-				degree = (uint32_t)outDegree;
-			} else if (session->direction == CXNeighborDirectionIn) {
-				degree = (uint32_t)inDegree;
-			} else {
-				degree = (uint32_t)(outDegree + inDegree);
-			}
-			session->degrees[u] = degree;
-		}
+		CXCorenessDegreeInitRange(session, 0, nodeCount, 0);
 		return CXTrue;
 	}
-
-	const CXSize chunkSize = 1 + ((nodeCount - 1) / workerCount);
-	CXParallelForStart(corenessDegreeInitLoop, workerIndex, workerCount) {
-		const CXSize start = workerIndex * chunkSize;
-		const CXSize end = CXMIN(nodeCount, (workerIndex + 1) * chunkSize);
-		for (CXSize u = start; u < end; u++) {
-			uint32_t degree = 0;
-			CXIndex outDegree = session->graph.outOffsets[u + 1] - session->graph.outOffsets[u];
-			CXIndex inDegree = session->graph.inOffsets[u + 1] - session->graph.inOffsets[u];
-			if (!session->graph.directed) {
-				degree = (uint32_t)outDegree;
-			} else if (session->direction == CXNeighborDirectionOut) {
-				degree = (uint32_t)outDegree;
-			} else if (session->direction == CXNeighborDirectionIn) {
-				degree = (uint32_t)inDegree;
-			} else {
-				degree = (uint32_t)(outDegree + inDegree);
-			}
-			session->degrees[u] = degree;
-		}
-	}
-	CXParallelForEnd(corenessDegreeInitLoop);
+	CXParallelForRange(nodeCount, CXMeasurementGrainSize(nodeCount, workerCount), workerCount, CXCorenessDegreeInitRange, session);
 	return CXTrue;
 }
 
@@ -1318,9 +1122,7 @@ CXCorenessSessionRef CXCorenessSessionCreate(
 	session->direction = CXMeasurementNormalizeDirection(network, direction);
 	session->executionMode = CXMeasurementNormalizeExecutionMode(executionMode);
 
-	CXMeasurementEdgeWeights weights = {0};
-	weights.read = CXMeasurementWeightConstantOne;
-	if (!CXMeasurementGraphBuild(&session->graph, network, &weights)) {
+	if (!CXMeasurementGraphBuild(&session->graph, network)) {
 		free(session);
 		return NULL;
 	}
@@ -1878,9 +1680,7 @@ CXConnectedComponentsSessionRef CXConnectedComponentsSessionCreate(
 	session->network = network;
 	session->mode = CXConnectedComponentsNormalizeMode(network, mode);
 
-	CXMeasurementEdgeWeights weights = {0};
-	weights.read = CXMeasurementWeightConstantOne;
-	if (!CXMeasurementGraphBuild(&session->graph, network, &weights)) {
+	if (!CXMeasurementGraphBuild(&session->graph, network)) {
 		free(session);
 		return NULL;
 	}
@@ -2117,59 +1917,49 @@ CXSize CXNetworkMeasureConnectedComponents(
 	return (CXSize)componentCount;
 }
 
+/* Brandes accumulation on top of a level-ordered BFS: path counts are pulled
+ * level by level from predecessors, then dependencies are pushed back in
+ * reverse level order. Only nodes reached from `source` are touched. */
 static void CXMeasurementBetweennessSourceUnweighted(
 	const CXMeasurementGraph *graph,
 	CXIndex source,
 	double *centrality,
-	int32_t *dist,
+	CXTraversalBFS *bfs,
 	double *sigma,
-	double *delta,
-	CXIndex *queue,
-	CXIndex *stack
+	double *delta
 ) {
-	const CXSize n = graph->nodeCount;
-	for (CXSize i = 0; i < n; i++) {
-		dist[i] = -1;
-		sigma[i] = 0.0;
-		delta[i] = 0.0;
+	CXSize reached = CXTraversalBFSRun(bfs, &source, 1, CXSizeMAX);
+	const uint32_t *dist = bfs->distances;
+	const CXIndex *order = bfs->order;
+	for (CXSize i = 0; i < reached; i++) {
+		sigma[order[i]] = 0.0;
+		delta[order[i]] = 0.0;
 	}
-
-	CXSize qHead = 0;
-	CXSize qTail = 0;
-	CXSize stackCount = 0;
-	dist[source] = 0;
 	sigma[source] = 1.0;
-	queue[qTail++] = source;
 
-	while (qHead < qTail) {
-		CXIndex v = queue[qHead++];
-		stack[stackCount++] = v;
-		for (CXIndex idx = graph->outOffsets[v]; idx < graph->outOffsets[v + 1]; idx++) {
-			CXIndex w = graph->outNeighbors[idx];
-			if (dist[w] < 0) {
-				dist[w] = dist[v] + 1;
-				queue[qTail++] = w;
-			}
-			if (dist[w] == dist[v] + 1) {
-				sigma[w] += sigma[v];
+	for (CXSize i = bfs->levelOffsets[1]; i < reached; i++) {
+		CXIndex w = order[i];
+		uint32_t parentLevel = dist[w] - 1;
+		double paths = 0.0;
+		for (CXIndex idx = graph->inOffsets[w]; idx < graph->inOffsets[w + 1]; idx++) {
+			CXIndex v = graph->inNeighbors[idx];
+			if (dist[v] == parentLevel) {
+				paths += sigma[v];
 			}
 		}
+		sigma[w] = paths;
 	}
 
-	for (CXSize pos = stackCount; pos > 0; pos--) {
-		CXIndex w = stack[pos - 1];
-		if (sigma[w] <= 0.0) {
-			continue;
-		}
+	for (CXSize pos = reached; pos > bfs->levelOffsets[1]; pos--) {
+		CXIndex w = order[pos - 1];
+		uint32_t parentLevel = dist[w] - 1;
 		for (CXIndex idx = graph->inOffsets[w]; idx < graph->inOffsets[w + 1]; idx++) {
 			CXIndex v = graph->inNeighbors[idx];
-			if (dist[v] == dist[w] - 1 && sigma[v] > 0.0) {
+			if (dist[v] == parentLevel) {
 				delta[v] += (sigma[v] / sigma[w]) * (1.0 + delta[w]);
 			}
 		}
-		if (w != source) {
-			centrality[w] += delta[w];
-		}
+		centrality[w] += delta[w];
 	}
 }
 
@@ -2341,125 +2131,804 @@ CXBool CXNetworkMeasureStrength(
 	return CXTrue;
 }
 
-CXBool CXNetworkMeasureLocalClusteringCoefficient(
-	CXNetworkRef network,
-	const CXString edgeWeightAttribute,
-	CXNeighborDirection direction,
-	CXClusteringCoefficientVariant variant,
-	float *outNodeCoefficient
-) {
-	if (!network || !outNodeCoefficient) {
-		return CXFalse;
-	}
-	direction = CXMeasurementNormalizeDirection(network, direction);
-	variant = CXMeasurementNormalizeClusteringVariant(variant);
-
-	CXMeasurementEdgeWeights weights;
-	if (!CXMeasurementResolveEdgeWeights(network, edgeWeightAttribute, &weights)) {
-		return CXFalse;
-	}
+// Triangle kernels -------------------------------------------------------------
 
-	double maxWeight = 1.0;
-	if (variant == CXClusteringCoefficientOnnela) {
-		maxWeight = 0.0;
-		for (CXIndex edge = 0; edge < network->edgeCapacity; edge++) {
-			if (!network->edgeActive[edge]) {
-				continue;
-			}
-			double w = fabs(weights.read(weights.base, weights.stride, edge));
-			if (isfinite(w) && w > maxWeight) {
-				maxWeight = w;
-			}
-		}
-		if (!(maxWeight > 0.0)) {
-			maxWeight = 1.0;
-		}
-	}
+#define CX_TRIANGLE_GALLOP_RATIO 16u
+#define CX_TRIANGLE_LINK_OUT 1u
+#define CX_TRIANGLE_LINK_IN 2u
+#define CX_TRIANGLE_LINK_BOTH (CX_TRIANGLE_LINK_OUT | CX_TRIANGLE_LINK_IN)
 
-	memset(outNodeCoefficient, 0, network->nodeCapacity * sizeof(float));
-	if (network->nodeCapacity == 0) {
-		return CXTrue;
-	}
+/* Undirected projection of a measurement graph: for every node the sorted,
+ * distinct neighbours joined to it by an edge in either direction (self-loops
+ * dropped). `links` records which directions exist; `weights` holds the pair
+ * weight used by the weighted clustering variants (parallel edges summed, the
+ * two directions averaged when both exist). Entries of node u live in
+ * [offsets[u], ends[u]). */
+typedef struct {
+	CXSize nodeCount;
+	CXIndex *offsets; /* nodeCount + 1, upper-bound slot starts */
+	CXIndex *ends;    /* nodeCount */
+	CXIndex *neighbors;
+	uint8_t *links;
+	double *weights;  /* NULL for unweighted projections */
+} CXTriangleProjection;
 
-	uint32_t *seen = (uint32_t *)calloc(network->nodeCapacity, sizeof(uint32_t));
-	CXIndex *neighbors = (CXIndex *)malloc(network->nodeCapacity * sizeof(CXIndex));
-	double *neighborWeights = (double *)malloc(network->nodeCapacity * sizeof(double));
-	if (!seen || !neighbors || !neighborWeights) {
-		free(seen);
-		free(neighbors);
-		free(neighborWeights);
-		return CXFalse;
-	}
+typedef struct {
+	CXIndex node;
+	uint8_t links;
+	double outWeight;
+	double inWeight;
+} CXTriangleProjectionEntry;
 
-	uint32_t stamp = 1;
-	for (CXIndex node = 0; node < network->nodeCapacity; node++) {
-		if (!network->nodeActive[node]) {
-			continue;
+typedef struct {
+	CXTriangleProjectionEntry *entries;
+	CXSize entryCapacity;
+	CXIndex *nodes;
+	double *weights;
+	CXSize nodeCapacity;
+	CXBool failed;
+} CXTriangleWorkerState;
+
+typedef struct {
+	double triangles;
+	double onnela;
+	double newman;
+} CXTriangleSums;
+
+typedef struct {
+	const CXMeasurementGraph *graph;
+	CXTriangleProjection *projection;
+	CXTriangleWorkerState *workers;
+} CXTriangleProjectionTask;
+
+typedef struct {
+	const CXMeasurementGraph *graph;
+	const CXTriangleProjection *projection;
+	CXTriangleWorkerState *workers;
+	uint8_t mask;
+	CXClusteringCoefficientVariant variant;
+	double invMaxWeight;
+	float *outNodeCoefficient; /* by node index, optional */
+	float *outNodeTriangles;   /* by node index, optional */
+	double *nodeTriangles;     /* compact ids, optional */
+} CXTriangleLocalTask;
+
+typedef struct {
+	const CXTriangleProjection *projection;
+	CXIndex *forwardOffsets;  /* nodeCount + 1 */
+	CXIndex *forwardNeighbors;
+	uint64_t *blockTriangles;
+	CXSize grainSize;
+} CXTriangleForwardTask;
+
+static void CXTriangleProjectionDestroy(CXTriangleProjection *projection) {
+	if (!projection) {
+		return;
+	}
+	free(projection->offsets);
+	free(projection->ends);
+	free(projection->neighbors);
+	free(projection->links);
+	free(projection->weights);
+	memset(projection, 0, sizeof(*projection));
+}
+
+static void CXTriangleWorkerStatesDestroy(CXTriangleWorkerState *workers, CXSize workerCount) {
+	if (!workers) {
+		return;
+	}
+	for (CXSize w = 0; w < workerCount; w++) {
+		free(workers[w].entries);
+		free(workers[w].nodes);
+		free(workers[w].weights);
+	}
+	free(workers);
+}
+
+static CXBool CXTriangleWorkersFailed(const CXTriangleWorkerState *workers, CXSize workerCount) {
+	for (CXSize w = 0; w < workerCount; w++) {
+		if (workers[w].failed) {
+			return CXTrue;
 		}
-		if (++stamp == 0) {
-			memset(seen, 0, network->nodeCapacity * sizeof(uint32_t));
-			stamp = 1;
+	}
+	return CXFalse;
+}
+
+static CXBool CXTriangleReserveEntries(CXTriangleWorkerState *state, CXSize count) {
+	if (count <= state->entryCapacity) {
+		return CXTrue;
+	}
+	CXSize capacity = CXMAX(count, state->entryCapacity * 2);
+	CXTriangleProjectionEntry *entries = (CXTriangleProjectionEntry *)realloc(state->entries, capacity * sizeof(CXTriangleProjectionEntry));
+	if (!entries) {
+		return CXFalse;
+	}
+	state->entries = entries;
+	state->entryCapacity = capacity;
+	return CXTrue;
+}
+
+static CXBool CXTriangleReserveNodes(CXTriangleWorkerState *state, CXSize count, CXBool weighted) {
+	if (count <= state->nodeCapacity) {
+		return CXTrue;
+	}
+	CXSize capacity = CXMAX(count, state->nodeCapacity * 2);
+	CXIndex *nodes = (CXIndex *)realloc(state->nodes, capacity * sizeof(CXIndex));
+	if (!nodes) {
+		return CXFalse;
+	}
+	state->nodes = nodes;
+	if (weighted) {
+		double *weights = (double *)realloc(state->weights, capacity * sizeof(double));
+		if (!weights) {
+			return CXFalse;
 		}
+		state->weights = weights;
+	}
+	state->nodeCapacity = capacity;
+	return CXTrue;
+}
 
-		CXSize k = CXMeasurementCollectNeighbors(network, node, direction, stamp, seen, neighbors);
-		if (k < 2) {
-			outNodeCoefficient[node] = 0.0f;
+static int CXTriangleEntryCompare(const void *left, const void *right) {
+	CXIndex a = ((const CXTriangleProjectionEntry *)left)->node;
+	CXIndex b = ((const CXTriangleProjectionEntry *)right)->node;
+	return (a > b) - (a < b);
+}
+
+static void CXTriangleProjectionGatherRange(void *context, CXIndex start, CXIndex end, CXSize workerIndex) {
+	CXTriangleProjectionTask *task = (CXTriangleProjectionTask *)context;
+	const CXMeasurementGraph *graph = task->graph;
+	CXTriangleProjection *projection = task->projection;
+	CXTriangleWorkerState *state = &task->workers[workerIndex];
+	CXBool weighted = projection->weights ? CXTrue : CXFalse;
+
+	for (CXIndex u = start; u < end; u++) {
+		CXSize bound = projection->offsets[u + 1] - projection->offsets[u];
+		projection->ends[u] = projection->offsets[u];
+		if (state->failed || bound == 0) {
 			continue;
 		}
+		if (!CXTriangleReserveEntries(state, bound)) {
+			state->failed = CXTrue;
+			continue;
+		}
+		CXTriangleProjectionEntry *entries = state->entries;
+		CXSize count = 0;
+		uint8_t outLinks = graph->directed ? CX_TRIANGLE_LINK_OUT : CX_TRIANGLE_LINK_BOTH;
+		for (CXIndex idx = graph->outOffsets[u]; idx < graph->outOffsets[u + 1]; idx++) {
+			CXIndex v = graph->outNeighbors[idx];
+			if (v == u) {
+				continue;
+			}
+			entries[count].node = v;
+			entries[count].links = outLinks;
+			entries[count].outWeight = weighted ? graph->outWeights[idx] : 0.0;
+			entries[count].inWeight = 0.0;
+			count++;
+		}
+		if (graph->directed) {
+			for (CXIndex idx = graph->inOffsets[u]; idx < graph->inOffsets[u + 1]; idx++) {
+				CXIndex v = graph->inNeighbors[idx];
+				if (v == u) {
+					continue;
+				}
+				entries[count].node = v;
+				entries[count].links = CX_TRIANGLE_LINK_IN;
+				entries[count].outWeight = 0.0;
+				entries[count].inWeight = weighted ? graph->inWeights[idx] : 0.0;
+				count++;
+			}
+		}
+		if (count > 1) {
+			qsort(entries, count, sizeof(CXTriangleProjectionEntry), CXTriangleEntryCompare);
+		}
+
+		CXIndex cursor = projection->offsets[u];
+		for (CXSize i = 0; i < count;) {
+			CXIndex v = entries[i].node;
+			uint8_t links = 0;
+			double outWeight = 0.0;
+			double inWeight = 0.0;
+			for (; i < count && entries[i].node == v; i++) {
+				links |= entries[i].links;
+				outWeight += entries[i].outWeight;
+				inWeight += entries[i].inWeight;
+			}
+			projection->neighbors[cursor] = v;
+			projection->links[cursor] = links;
+			if (weighted) {
+				if (!graph->directed) {
+					projection->weights[cursor] = outWeight;
+				} else if (links == CX_TRIANGLE_LINK_BOTH) {
+					projection->weights[cursor] = 0.5 * (outWeight + inWeight);
+				} else {
+					projection->weights[cursor] = (links & CX_TRIANGLE_LINK_OUT) ? outWeight : inWeight;
+				}
+			}
+			cursor++;
+		}
+		projection->ends[u] = cursor;
+	}
+}
+
+static CXBool CXTriangleProjectionBuild(
+	CXTriangleProjection *projection,
+	const CXMeasurementGraph *graph,
+	CXBool weighted,
+	CXTriangleWorkerState *workers,
+	CXSize workerCount
+) {
+	memset(projection, 0, sizeof(*projection));
+	CXSize n = graph->nodeCount;
+	projection->nodeCount = n;
+	projection->offsets = (CXIndex *)malloc((n + 1) * sizeof(CXIndex));
+	projection->ends = (CXIndex *)malloc(CXMAX(n, (CXSize)1) * sizeof(CXIndex));
+	if (!projection->offsets || !projection->ends) {
+		CXTriangleProjectionDestroy(projection);
+		return CXFalse;
+	}
+	/* Each node owns at most out-degree (+ in-degree when directed) slots. */
+	for (CXSize u = 0; u <= n; u++) {
+		projection->offsets[u] = graph->outOffsets[u] + (graph->directed ? graph->inOffsets[u] : 0);
+	}
+	CXSize slots = projection->offsets[n];
+	if (slots > 0) {
+		projection->neighbors = (CXIndex *)malloc(slots * sizeof(CXIndex));
+		projection->links = (uint8_t *)malloc(slots * sizeof(uint8_t));
+		projection->weights = weighted ? (double *)malloc(slots * sizeof(double)) : NULL;
+		if (!projection->neighbors || !projection->links || (weighted && !projection->weights)) {
+			CXTriangleProjectionDestroy(projection);
+			return CXFalse;
+		}
+	}
+
+	CXTriangleProjectionTask task = {
+		.graph = graph,
+		.projection = projection,
+		.workers = workers
+	};
+	CXParallelForRange(n, CXMeasurementGrainSize(n, workerCount), workerCount, CXTriangleProjectionGatherRange, &task);
+	if (CXTriangleWorkersFailed(workers, workerCount)) {
+		CXTriangleProjectionDestroy(projection);
+		return CXFalse;
+	}
+	return CXTrue;
+}
+
+/* First index in [from, count) whose value is >= target, probing with
+ * exponentially growing steps before the binary search. */
+static CXSize CXTriangleGallop(const CXIndex *values, CXSize from, CXSize count, CXIndex target) {
+	CXSize step = 1;
+	CXSize low = from;
+	CXSize high = from;
+	while (high < count && values[high] < target) {
+		low = high + 1;
+		high = from + step;
+		step <<= 1;
+	}
+	if (high > count) {
+		high = count;
+	}
+	while (low < high) {
+		CXSize mid = low + ((high - low) >> 1);
+		if (values[mid] < target) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+	return low;
+}
+
+static inline void CXTriangleAccumulate(
+	CXTriangleSums *sums,
+	CXClusteringCoefficientVariant variant,
+	double invMaxWeight,
+	double pivotWeight,
+	const double *leftWeights,
+	CXSize leftIndex,
+	const double *rightWeights,
+	CXSize rightIndex
+) {
+	sums->triangles += 1.0;
+	if (variant == CXClusteringCoefficientOnnela) {
+		double wa = fabs(pivotWeight) * invMaxWeight;
+		double wb = fabs(leftWeights[leftIndex]) * invMaxWeight;
+		double wc = fabs(rightWeights[rightIndex]) * invMaxWeight;
+		sums->onnela += cbrt(CXMAX(0.0, wa * wb * wc));
+	} else if (variant == CXClusteringCoefficientNewman) {
+		sums->newman += 0.5 * (pivotWeight + leftWeights[leftIndex]);
+	}
+}
+
+/* Intersects two sorted id lists. Weighted variants need both weight arrays;
+ * `pivotWeight` is the weight of the edge that led to `right`. Lists of very
+ * different lengths are intersected by galloping through the longer one. */
+static void CXTriangleIntersect(
+	const CXIndex *left,
+	const double *leftWeights,
+	CXSize leftCount,
+	const CXIndex *right,
+	const double *rightWeights,
+	CXSize rightCount,
+	double pivotWeight,
+	CXClusteringCoefficientVariant variant,
+	double invMaxWeight,
+	CXTriangleSums *sums
+) {
+	if (leftCount == 0 || rightCount == 0) {
+		return;
+	}
+	if (left[leftCount - 1] < right[0] || right[rightCount - 1] < left[0]) {
+		return;
+	}
+	if (rightCount > leftCount * CX_TRIANGLE_GALLOP_RATIO) {
+		CXSize j = 0;
+		for (CXSize i = 0; i < leftCount && j < rightCount; i++) {
+			j = CXTriangleGallop(right, j, rightCount, left[i]);
+			if (j < rightCount && right[j] == left[i]) {
+				CXTriangleAccumulate(sums, variant, invMaxWeight, pivotWeight, leftWeights, i, rightWeights, j);
+				j++;
+			}
+		}
+		return;
+	}
+	if (leftCount > rightCount * CX_TRIANGLE_GALLOP_RATIO) {
+		CXSize i = 0;
+		for (CXSize j = 0; j < rightCount && i < leftCount; j++) {
+			i = CXTriangleGallop(left, i, leftCount, right[j]);
+			if (i < leftCount && left[i] == right[j]) {
+				CXTriangleAccumulate(sums, variant, invMaxWeight, pivotWeight, leftWeights, i, rightWeights, j);
+				i++;
+			}
+		}
+		return;
+	}
+	CXSize i = 0;
+	CXSize j = 0;
+	while (i < leftCount && j < rightCount) {
+		if (left[i] < right[j]) {
+			i++;
+		} else if (right[j] < left[i]) {
+			j++;
+		} else {
+			CXTriangleAccumulate(sums, variant, invMaxWeight, pivotWeight, leftWeights, i, rightWeights, j);
+			i++;
+			j++;
+		}
+	}
+}
+
+static void CXTriangleLocalRange(void *context, CXIndex start, CXIndex end, CXSize workerIndex) {
+	CXTriangleLocalTask *task = (CXTriangleLocalTask *)context;
+	const CXTriangleProjection *projection = task->projection;
+	CXTriangleWorkerState *state = &task->workers[workerIndex];
+	const CXBool weighted = projection->weights ? CXTrue : CXFalse;
+
+	for (CXIndex u = start; u < end; u++) {
+		const CXIndex *neighbors = projection->neighbors + projection->offsets[u];
+		const double *weights = weighted ? projection->weights + projection->offsets[u] : NULL;
+		CXSize k = projection->ends[u] - projection->offsets[u];
+		if (task->mask != CX_TRIANGLE_LINK_BOTH && k > 0) {
+			if (state->failed || !CXTriangleReserveNodes(state, k, weighted)) {
+				state->failed = CXTrue;
+				continue;
+			}
+			CXSize selected = 0;
+			for (CXSize i = 0; i < k; i++) {
+				if (!(projection->links[projection->offsets[u] + i] & task->mask)) {
+					continue;
+				}
+				state->nodes[selected] = neighbors[i];
+				if (weighted) {
+					state->weights[selected] = weights[i];
+				}
+				selected++;
+			}
+			neighbors = state->nodes;
+			weights = weighted ? state->weights : NULL;
+			k = selected;
+		}
 
+		CXTriangleSums sums = {0};
 		double nodeStrength = 0.0;
-		for (CXSize i = 0; i < k; i++) {
-			CXBool found = CXFalse;
-			double wij = CXMeasurementUndirectedEdgeWeight(network, node, neighbors[i], &weights, &found);
-			if (!found) {
-				wij = 0.0;
-			}
-			neighborWeights[i] = wij;
-			nodeStrength += wij;
-		}
-
-		double triangleCount = 0.0;
-		double onnelaSum = 0.0;
-		double newmanNumerator = 0.0;
-		for (CXSize a = 0; a < k; a++) {
-			for (CXSize b = a + 1; b < k; b++) {
-				CXBool found = CXFalse;
-				double wjk = CXMeasurementUndirectedEdgeWeight(network, neighbors[a], neighbors[b], &weights, &found);
-				if (!found) {
+		if (k >= 2) {
+			for (CXSize i = 0; i < k; i++) {
+				CXIndex a = neighbors[i];
+				double pivotWeight = weighted ? weights[i] : 1.0;
+				nodeStrength += pivotWeight;
+				CXSize remaining = k - i - 1;
+				if (remaining == 0) {
 					continue;
 				}
-				triangleCount += 1.0;
-				if (variant == CXClusteringCoefficientOnnela) {
-					double wa = fabs(neighborWeights[a]) / maxWeight;
-					double wb = fabs(neighborWeights[b]) / maxWeight;
-					double wc = fabs(wjk) / maxWeight;
-					double term = cbrt(CXMAX(0.0, wa * wb * wc));
-					onnelaSum += term;
-				} else if (variant == CXClusteringCoefficientNewman) {
-					newmanNumerator += 0.5 * (neighborWeights[a] + neighborWeights[b]);
+				CXIndex aStart = projection->offsets[a];
+				CXSize aCount = projection->ends[a] - aStart;
+				/* Only partners after `a` in the sorted list, so each pair is seen once. */
+				CXSize from = CXTriangleGallop(projection->neighbors + aStart, 0, aCount, neighbors[i + 1]);
+				CXTriangleIntersect(
+					neighbors + i + 1,
+					weighted ? weights + i + 1 : NULL,
+					remaining,
+					projection->neighbors + aStart + from,
+					weighted ? projection->weights + aStart + from : NULL,
+					aCount - from,
+					pivotWeight,
+					task->variant,
+					task->invMaxWeight,
+					&sums
+				);
+			}
+		}
+
+		CXIndex node = task->graph->compactToNode[u];
+		if (task->nodeTriangles) {
+			task->nodeTriangles[u] = sums.triangles;
+		}
+		if (task->outNodeTriangles) {
+			task->outNodeTriangles[node] = (float)sums.triangles;
+		}
+		if (task->outNodeCoefficient) {
+			double coefficient = 0.0;
+			if (k >= 2) {
+				double denomPairs = (double)k * (double)(k - 1);
+				if (task->variant == CXClusteringCoefficientUnweighted) {
+					coefficient = (2.0 * sums.triangles) / denomPairs;
+				} else if (task->variant == CXClusteringCoefficientOnnela) {
+					coefficient = (2.0 * sums.onnela) / denomPairs;
+				} else {
+					double denom = nodeStrength * (double)(k - 1);
+					coefficient = denom > 0.0 ? (2.0 * sums.newman) / denom : 0.0;
 				}
 			}
+			task->outNodeCoefficient[node] = (float)(isfinite(coefficient) ? coefficient : 0.0);
 		}
+	}
+}
 
-		double denomPairs = (double)k * (double)(k - 1);
-		double coefficient = 0.0;
-		if (variant == CXClusteringCoefficientUnweighted) {
-			coefficient = denomPairs > 0.0 ? (2.0 * triangleCount) / denomPairs : 0.0;
-		} else if (variant == CXClusteringCoefficientOnnela) {
-			coefficient = denomPairs > 0.0 ? (2.0 * onnelaSum) / denomPairs : 0.0;
-		} else {
-			double denom = nodeStrength * (double)(k - 1);
-			coefficient = denom > 0.0 ? (2.0 * newmanNumerator) / denom : 0.0;
+/* Degree ordering: u precedes v when it has fewer neighbours (ties by id). */
+static inline CXBool CXTriangleRanksBefore(const CXTriangleProjection *projection, CXIndex u, CXIndex v) {
+	CXSize du = projection->ends[u] - projection->offsets[u];
+	CXSize dv = projection->ends[v] - projection->offsets[v];
+	return (du < dv || (du == dv && u < v)) ? CXTrue : CXFalse;
+}
+
+static void CXTriangleForwardCountRange(void *context, CXIndex start, CXIndex end, CXSize workerIndex) {
+	(void)workerIndex;
+	CXTriangleForwardTask *task = (CXTriangleForwardTask *)context;
+	const CXTriangleProjection *projection = task->projection;
+	for (CXIndex u = start; u < end; u++) {
+		CXIndex count = 0;
+		for (CXIndex idx = projection->offsets[u]; idx < projection->ends[u]; idx++) {
+			if (CXTriangleRanksBefore(projection, u, projection->neighbors[idx])) {
+				count++;
+			}
 		}
-		outNodeCoefficient[node] = (float)(isfinite(coefficient) ? coefficient : 0.0);
+		task->forwardOffsets[u + 1] = count;
 	}
+}
 
-	free(seen);
-	free(neighbors);
-	free(neighborWeights);
+static void CXTriangleForwardFillRange(void *context, CXIndex start, CXIndex end, CXSize workerIndex) {
+	(void)workerIndex;
+	CXTriangleForwardTask *task = (CXTriangleForwardTask *)context;
+	const CXTriangleProjection *projection = task->projection;
+	for (CXIndex u = start; u < end; u++) {
+		CXIndex cursor = task->forwardOffsets[u];
+		for (CXIndex idx = projection->offsets[u]; idx < projection->ends[u]; idx++) {
+			CXIndex v = projection->neighbors[idx];
+			if (CXTriangleRanksBefore(projection, u, v)) {
+				task->forwardNeighbors[cursor++] = v;
+			}
+		}
+	}
+}
+
+static void CXTriangleForwardIntersectRange(void *context, CXIndex start, CXIndex end, CXSize workerIndex) {
+	(void)workerIndex;
+	CXTriangleForwardTask *task = (CXTriangleForwardTask *)context;
+	uint64_t total = 0;
+	for (CXIndex u = start; u < end; u++) {
+		const CXIndex *forward = task->forwardNeighbors + task->forwardOffsets[u];
+		CXSize forwardCount = task->forwardOffsets[u + 1] - task->forwardOffsets[u];
+		for (CXSize i = 0; i < forwardCount; i++) {
+			CXIndex v = forward[i];
+			CXTriangleSums sums = {0};
+			CXTriangleIntersect(
+				forward,
+				NULL,
+				forwardCount,
+				task->forwardNeighbors + task->forwardOffsets[v],
+				NULL,
+				task->forwardOffsets[v + 1] - task->forwardOffsets[v],
+				1.0,
+				CXClusteringCoefficientUnweighted,
+				1.0,
+				&sums
+			);
+			total += (uint64_t)sums.triangles;
+		}
+	}
+	task->blockTriangles[start / task->grainSize] = total;
+}
+
+/* Counts each triangle once by orienting every edge towards the higher-ranked
+ * endpoint, which bounds the forward lists by O(sqrt(m)). */
+static CXBool CXTriangleCountForward(const CXTriangleProjection *projection, CXSize workerCount, uint64_t *outTriangles) {
+	CXSize n = projection->nodeCount;
+	*outTriangles = 0;
+	if (n == 0) {
+		return CXTrue;
+	}
+	CXSize grainSize = CXMeasurementGrainSize(n, workerCount);
+	CXSize blockCount = 1 + (n - 1) / grainSize;
+	CXTriangleForwardTask task = {
+		.projection = projection,
+		.forwardOffsets = (CXIndex *)calloc(n + 1, sizeof(CXIndex)),
+		.forwardNeighbors = NULL,
+		.blockTriangles = (uint64_t *)calloc(blockCount, sizeof(uint64_t)),
+		.grainSize = grainSize
+	};
+	if (!task.forwardOffsets || !task.blockTriangles) {
+		free(task.forwardOffsets);
+		free(task.blockTriangles);
+		return CXFalse;
+	}
+	CXParallelForRange(n, grainSize, workerCount, CXTriangleForwardCountRange, &task);
+	for (CXSize u = 0; u < n; u++) {
+		task.forwardOffsets[u + 1] += task.forwardOffsets[u];
+	}
+	if (task.forwardOffsets[n] > 0) {
+		task.forwardNeighbors = (CXIndex *)malloc(task.forwardOffsets[n] * sizeof(CXIndex));
+		if (!task.forwardNeighbors) {
+			free(task.forwardOffsets);
+			free(task.blockTriangles);
+			return CXFalse;
+		}
+		CXParallelForRange(n, grainSize, workerCount, CXTriangleForwardFillRange, &task);
+		CXParallelForRange(n, grainSize, workerCount, CXTriangleForwardIntersectRange, &task);
+	}
+	uint64_t total = 0;
+	for (CXSize block = 0; block < blockCount; block++) {
+		total += task.blockTriangles[block];
+	}
+	*outTriangles = total;
+	free(task.forwardOffsets);
+	free(task.forwardNeighbors);
+	free(task.blockTriangles);
 	return CXTrue;
 }
 
+CXBool CXNetworkMeasureTriangles(
+	CXNetworkRef network,
+	CXMeasurementExecutionMode executionMode,
+	float *outNodeTriangles,
+	uint64_t *outTriangleCount,
+	double *outTransitivity
+) {
+	if (!network) {
+		return CXFalse;
+	}
+	if (outNodeTriangles) {
+		memset(outNodeTriangles, 0, network->nodeCapacity * sizeof(float));
+	}
+	if (outTriangleCount) {
+		*outTriangleCount = 0;
+	}
+	if (outTransitivity) {
+		*outTransitivity = 0.0;
+	}
+
+	CXMeasurementGraph graph;
+	if (!CXMeasurementGraphBuild(&graph, network)) {
+		return CXFalse;
+	}
+	if (graph.nodeCount == 0) {
+		CXMeasurementGraphDestroy(&graph);
+		return CXTrue;
+	}
+
+	CXSize workerCount = CXMeasurementResolveWorkerCount(executionMode, graph.nodeCount);
+	CXTriangleWorkerState *workers = (CXTriangleWorkerState *)calloc(workerCount, sizeof(CXTriangleWorkerState));
+	CXTriangleProjection projection;
+	if (!workers || !CXTriangleProjectionBuild(&projection, &graph, CXFalse, workers, workerCount)) {
+		CXTriangleWorkerStatesDestroy(workers, workerCount);
+		CXMeasurementGraphDestroy(&graph);
+		return CXFalse;
+	}
+
+	uint64_t triangles = 0;
+	CXBool ok = CXTrue;
+	if (outNodeTriangles) {
+		double *nodeTriangles = (double *)malloc(graph.nodeCount * sizeof(double));
+		ok = nodeTriangles ? CXTrue : CXFalse;
+		if (ok) {
+			CXTriangleLocalTask task = {
+				.graph = &graph,
+				.projection = &projection,
+				.workers = workers,
+				.mask = CX_TRIANGLE_LINK_BOTH,
+				.variant = CXClusteringCoefficientUnweighted,
+				.invMaxWeight = 1.0,
+				.outNodeTriangles = outNodeTriangles,
+				.nodeTriangles = nodeTriangles
+			};
+			CXParallelForRange(graph.nodeCount, CXMeasurementGrainSize(graph.nodeCount, workerCount), workerCount, CXTriangleLocalRange, &task);
+			ok = !CXTriangleWorkersFailed(workers, workerCount);
+			double sum = 0.0;
+			for (CXSize u = 0; u < graph.nodeCount; u++) {
+				sum += nodeTriangles[u];
+			}
+			triangles = (uint64_t)llround(sum / 3.0);
+		}
+		free(nodeTriangles);
+	} else if (outTriangleCount || outTransitivity) {
+		ok = CXTriangleCountForward(&projection, workerCount, &triangles);
+	}
+
+	if (ok) {
+		if (outTriangleCount) {
+			*outTriangleCount = triangles;
+		}
+		if (outTransitivity) {
+			double triples = 0.0;
+			for (CXSize u = 0; u < projection.nodeCount; u++) {
+				double degree = (double)(projection.ends[u] - projection.offsets[u]);
+				triples += 0.5 * degree * (degree - 1.0);
+			}
+			*outTransitivity = triples > 0.0 ? (3.0 * (double)triangles) / triples : 0.0;
+		}
+	}
+
+	CXTriangleProjectionDestroy(&projection);
+	CXTriangleWorkerStatesDestroy(workers, workerCount);
+	CXMeasurementGraphDestroy(&graph);
+	return ok;
+}
+
+CXBool CXNetworkMeasureLocalClusteringCoefficient(
+	CXNetworkRef network,
+	const CXString edgeWeightAttribute,
+	CXNeighborDirection direction,
+	CXClusteringCoefficientVariant variant,
+	float *outNodeCoefficient
+) {
+	if (!network || !outNodeCoefficient) {
+		return CXFalse;
+	}
+	direction = CXMeasurementNormalizeDirection(network, direction);
+	variant = CXMeasurementNormalizeClusteringVariant(variant);
+
+	CXMeasurementEdgeWeights weights;
+	if (!CXMeasurementResolveEdgeWeights(network, edgeWeightAttribute, &weights)) {
+		return CXFalse;
+	}
+
+	double maxWeight = 1.0;
+	if (variant == CXClusteringCoefficientOnnela) {
+		maxWeight = 0.0;
+		for (CXIndex edge = 0; edge < network->edgeCapacity; edge++) {
+			if (!network->edgeActive[edge]) {
+				continue;
+			}
+			double w = fabs(weights.read(weights.base, weights.stride, edge));
+			if (isfinite(w) && w > maxWeight) {
+				maxWeight = w;
+			}
+		}
+		if (!(maxWeight > 0.0)) {
+			maxWeight = 1.0;
+		}
+	}
+
+	memset(outNodeCoefficient, 0, network->nodeCapacity * sizeof(float));
+	if (network->nodeCapacity == 0) {
+		return CXTrue;
+	}
+
+	CXBool weighted = (variant != CXClusteringCoefficientUnweighted) ? CXTrue : CXFalse;
+	CXMeasurementGraph graph;
+	if (!CXMeasurementGraphBuild(&graph, network)) {
+		return CXFalse;
+	}
+	if (weighted && !CXMeasurementGraphAttachWeights(&graph, network, edgeWeightAttribute)) {
+		CXMeasurementGraphDestroy(&graph);
+		return CXFalse;
+	}
+	if (graph.nodeCount == 0) {
+		CXMeasurementGraphDestroy(&graph);
+		return CXTrue;
+	}
+
+	CXSize workerCount = CXMeasurementResolveWorkerCount(CXMeasurementExecutionAuto, graph.nodeCount);
+	CXTriangleWorkerState *workers = (CXTriangleWorkerState *)calloc(workerCount, sizeof(CXTriangleWorkerState));
+	CXTriangleProjection projection;
+	if (!workers || !CXTriangleProjectionBuild(&projection, &graph, weighted, workers, workerCount)) {
+		CXTriangleWorkerStatesDestroy(workers, workerCount);
+		CXMeasurementGraphDestroy(&graph);
+		return CXFalse;
+	}
+
+	uint8_t mask = CX_TRIANGLE_LINK_BOTH;
+	if (graph.directed && direction == CXNeighborDirectionOut) {
+		mask = CX_TRIANGLE_LINK_OUT;
+	} else if (graph.directed && direction == CXNeighborDirectionIn) {
+		mask = CX_TRIANGLE_LINK_IN;
+	}
+	CXTriangleLocalTask task = {
+		.graph = &graph,
+		.projection = &projection,
+		.workers = workers,
+		.mask = mask,
+		.variant = variant,
+		.invMaxWeight = 1.0 / maxWeight,
+		.outNodeCoefficient = outNodeCoefficient
+	};
+	CXParallelForRange(graph.nodeCount, CXMeasurementGrainSize(graph.nodeCount, workerCount), workerCount, CXTriangleLocalRange, &task);
+	CXBool ok = !CXTriangleWorkersFailed(workers, workerCount);
+
+	CXTriangleProjectionDestroy(&projection);
+	CXTriangleWorkerStatesDestroy(workers, workerCount);
+	CXMeasurementGraphDestroy(&graph);
+	return ok;
+}
+
+typedef struct {
+	const CXMeasurementGraph *graph;
+	CXNeighborDirection direction;
+	const double *x;
+	double *y;
+	double invNorm;
+	CXSize grainSize;
+	double *blockNorm;
+	double *blockLambda;
+	double *blockDelta;
+} CXEigenvectorTask;
+
+static void CXEigenvectorMultiplyRange(void *context, CXIndex start, CXIndex end, CXSize workerIndex) {
+	(void)workerIndex;
+	CXEigenvectorTask *task = (CXEigenvectorTask *)context;
+	const CXMeasurementGraph *graph = task->graph;
+	const double *x = task->x;
+	double normPart = 0.0;
+	double lambdaPart = 0.0;
+
+	for (CXIndex u = start; u < end; u++) {
+		double sum = 0.0;
+		if (task->direction == CXNeighborDirectionOut || task->direction == CXNeighborDirectionBoth || !graph->directed) {
+			for (CXIndex idx = graph->outOffsets[u]; idx < graph->outOffsets[u + 1]; idx++) {
+				sum += graph->outWeights[idx] * x[graph->outNeighbors[idx]];
+			}
+		}
+		if (graph->directed && (task->direction == CXNeighborDirectionIn || task->direction == CXNeighborDirectionBoth)) {
+			for (CXIndex idx = graph->inOffsets[u]; idx < graph->inOffsets[u + 1]; idx++) {
+				sum += graph->inWeights[idx] * x[graph->inNeighbors[idx]];
+			}
+		}
+		double adjusted = sum + CX_MEASUREMENT_EIGENVECTOR_SHIFT * x[u];
+		task->y[u] = adjusted;
+		normPart += adjusted * adjusted;
+		lambdaPart += x[u] * sum;
+	}
+
+	CXSize block = start / task->grainSize;
+	task->blockNorm[block] = normPart;
+	task->blockLambda[block] = lambdaPart;
+}
+
+static void CXEigenvectorNormalizeRange(void *context, CXIndex start, CXIndex end, CXSize workerIndex) {
+	(void)workerIndex;
+	CXEigenvectorTask *task = (CXEigenvectorTask *)context;
+	double deltaPart = 0.0;
+	for (CXIndex u = start; u < end; u++) {
+		double normalized = task->y[u] * task->invNorm;
+		double diff = fabs(normalized - task->x[u]);
+		if (diff > deltaPart) {
+			deltaPart = diff;
+		}
+		task->y[u] = normalized;
+	}
+	task->blockDelta[start / task->grainSize] = deltaPart;
+}
+
 CXBool CXNetworkMeasureEigenvectorCentrality(
 	CXNetworkRef network,
 	const CXString edgeWeightAttribute,
@@ -2488,13 +2957,12 @@ CXBool CXNetworkMeasureEigenvectorCentrality(
 
 	memset(outNodeCentrality, 0, network->nodeCapacity * sizeof(float));
 
-	CXMeasurementEdgeWeights weights;
-	if (!CXMeasurementResolveEdgeWeights(network, edgeWeightAttribute, &weights)) {
+	CXMeasurementGraph graph;
+	if (!CXMeasurementGraphBuild(&graph, network)) {
 		return CXFalse;
 	}
-
-	CXMeasurementGraph graph;
-	if (!CXMeasurementGraphBuild(&graph, network, &weights)) {
+	if (!CXMeasurementGraphAttachWeights(&graph, network, edgeWeightAttribute)) {
+		CXMeasurementGraphDestroy(&graph);
 		return CXFalse;
 	}
 	if (graph.nodeCount == 0) {
@@ -2543,10 +3011,11 @@ CXBool CXNetworkMeasureEigenvectorCentrality(
 	if (workerCount == 0) {
 		workerCount = 1;
 	}
-	CXSize chunkSize = 1 + ((graph.nodeCount - 1) / workerCount);
-	double *localNorm = (double *)calloc(workerCount, sizeof(double));
-	double *localLambda = (double *)calloc(workerCount, sizeof(double));
-	double *localDelta = (double *)calloc(workerCount, sizeof(double));
+	CXSize grainSize = CXMeasurementGrainSize(graph.nodeCount, workerCount);
+	CXSize blockCount = 1 + ((graph.nodeCount - 1) / grainSize);
+	double *localNorm = (double *)calloc(blockCount, sizeof(double));
+	double *localLambda = (double *)calloc(blockCount, sizeof(double));
+	double *localDelta = (double *)calloc(blockCount, sizeof(double));
 	if (!localNorm || !localLambda || !localDelta) {
 		free(localNorm);
 		free(localLambda);
@@ -2586,43 +3055,22 @@ CXBool CXNetworkMeasureEigenvectorCentrality(
 				lambdaNumerator += x[u] * sum;
 			}
 		} else {
-			memset(localNorm, 0, workerCount * sizeof(double));
-			memset(localLambda, 0, workerCount * sizeof(double));
-
-			CXParallelForStart(eigenvectorMultiplyLoop, workerIndex, workerCount) {
-				CXSize start = workerIndex * chunkSize;
-				CXSize end = CXMIN(graph.nodeCount, (workerIndex + 1) * chunkSize);
-				double normPart = 0.0;
-				double lambdaPart = 0.0;
-
-				for (CXSize u = start; u < end; u++) {
-					double sum = 0.0;
-					if (direction == CXNeighborDirectionOut || direction == CXNeighborDirectionBoth || !graph.directed) {
-						for (CXIndex idx = graph.outOffsets[u]; idx < graph.outOffsets[u + 1]; idx++) {
-							CXIndex v = graph.outNeighbors[idx];
-							sum += graph.outWeights[idx] * x[v];
-						}
-					}
-					if (graph.directed && (direction == CXNeighborDirectionIn || direction == CXNeighborDirectionBoth)) {
-						for (CXIndex idx = graph.inOffsets[u]; idx < graph.inOffsets[u + 1]; idx++) {
-							CXIndex v = graph.inNeighbors[idx];
-							sum += graph.inWeights[idx] * x[v];
-						}
-					}
-					double adjusted = sum + CX_MEASUREMENT_EIGENVECTOR_SHIFT * x[u];
-					y[u] = adjusted;
-					normPart += adjusted * adjusted;
-					lambdaPart += x[u] * sum;
-				}
-
-				localNorm[workerIndex] = normPart;
-				localLambda[workerIndex] = lambdaPart;
-			}
-			CXParallelForEnd(eigenvectorMultiplyLoop);
-
-			for (CXSize w = 0; w < workerCount; w++) {
-				normSq += localNorm[w];
-				lambdaNumerator += localLambda[w];
+			CXEigenvectorTask task = {
+				.graph = &graph,
+				.direction = direction,
+				.x = x,
+				.y = y,
+				.invNorm = 0.0,
+				.grainSize = grainSize,
+				.blockNorm = localNorm,
+				.blockLambda = localLambda,
+				.blockDelta = localDelta
+			};
+			CXParallelForRange(graph.nodeCount, grainSize, workerCount, CXEigenvectorMultiplyRange, &task);
+
+			for (CXSize block = 0; block < blockCount; block++) {
+				normSq += localNorm[block];
+				lambdaNumerator += localLambda[block];
 			}
 		}
 		eigenvalue = lambdaNumerator;
@@ -2645,27 +3093,23 @@ CXBool CXNetworkMeasureEigenvectorCentrality(
 				y[u] = normalized;
 			}
 		} else {
-			memset(localDelta, 0, workerCount * sizeof(double));
-			CXParallelForStart(eigenvectorNormalizeLoop, workerIndexNorm, workerCount) {
-				CXSize start = workerIndexNorm * chunkSize;
-				CXSize end = CXMIN(graph.nodeCount, (workerIndexNorm + 1) * chunkSize);
-				double deltaPart = 0.0;
-				for (CXSize u = start; u < end; u++) {
-					double normalized = y[u] * invNorm;
-					double diff = fabs(normalized - x[u]);
-					if (diff > deltaPart) {
-						deltaPart = diff;
-					}
-					y[u] = normalized;
-				}
-				localDelta[workerIndexNorm] = deltaPart;
-			}
-			CXParallelForEnd(eigenvectorNormalizeLoop);
+			CXEigenvectorTask task = {
+				.graph = &graph,
+				.direction = direction,
+				.x = x,
+				.y = y,
+				.invNorm = invNorm,
+				.grainSize = grainSize,
+				.blockNorm = localNorm,
+				.blockLambda = localLambda,
+				.blockDelta = localDelta
+			};
+			CXParallelForRange(graph.nodeCount, grainSize, workerCount, CXEigenvectorNormalizeRange, &task);
 
 			delta = 0.0;
-			for (CXSize w = 0; w < workerCount; w++) {
-				if (localDelta[w] > delta) {
-					delta = localDelta[w];
+			for (CXSize block = 0; block < blockCount; block++) {
+				if (localDelta[block] > delta) {
+					delta = localDelta[block];
 				}
 			}
 		}
@@ -2706,6 +3150,105 @@ CXBool CXNetworkMeasureEigenvectorCentrality(
 	return CXTrue;
 }
 
+typedef struct {
+	double *contrib;
+	CXBool ownsContrib;
+	CXTraversalBFS bfs;
+	CXBool hasTraversal;
+	double *distWeighted;
+	double *sigma;
+	double *delta;
+	CXBool *settled;
+	CXIndex *stack;
+	CXMeasurementMinHeap heap;
+	CXBool hasHeap;
+} CXBetweennessWorkerState;
+
+typedef struct {
+	const CXMeasurementGraph *graph;
+	const CXIndex *sources;
+	CXBool weighted;
+	CXBetweennessWorkerState *workers;
+} CXBetweennessTask;
+
+static void CXBetweennessWorkerStateDestroy(CXBetweennessWorkerState *state) {
+	if (state->ownsContrib) {
+		free(state->contrib);
+	}
+	if (state->hasTraversal) {
+		CXTraversalBFSDestroy(&state->bfs);
+	}
+	free(state->distWeighted);
+	free(state->sigma);
+	free(state->delta);
+	free(state->settled);
+	free(state->stack);
+	if (state->hasHeap) {
+		CXMeasurementMinHeapDestroy(&state->heap);
+	}
+	memset(state, 0, sizeof(*state));
+}
+
+/* Worker 0 accumulates straight into the shared buffer; the others get a
+ * private accumulator that is reduced after the loop. */
+static CXBool CXBetweennessWorkerStateInit(CXBetweennessWorkerState *state, const CXMeasurementGraph *graph, CXBool weighted, double *sharedContrib) {
+	CXSize nodeCount = graph->nodeCount;
+	memset(state, 0, sizeof(*state));
+	if (sharedContrib) {
+		state->contrib = sharedContrib;
+	} else {
+		state->contrib = (double *)calloc(nodeCount, sizeof(double));
+		state->ownsContrib = CXTrue;
+	}
+	state->sigma = (double *)malloc(nodeCount * sizeof(double));
+	state->delta = (double *)malloc(nodeCount * sizeof(double));
+	if (weighted) {
+		state->stack = (CXIndex *)malloc(nodeCount * sizeof(CXIndex));
+		state->distWeighted = (double *)malloc(nodeCount * sizeof(double));
+		state->settled = (CXBool *)malloc(nodeCount * sizeof(CXBool));
+		state->hasHeap = CXMeasurementMinHeapInit(&state->heap, nodeCount + 1);
+	} else {
+		/* Sources already run in parallel, so each traversal stays serial. */
+		state->hasTraversal = CXTraversalBFSInit(&state->bfs, graph->snapshot, CXTrue, CXFalse, 1);
+	}
+	CXBool scratchOk = weighted ? (state->stack && state->distWeighted && state->settled && state->hasHeap) : state->hasTraversal;
+	if (!state->contrib || !state->sigma || !state->delta || !scratchOk) {
+		CXBetweennessWorkerStateDestroy(state);
+		return CXFalse;
+	}
+	return CXTrue;
+}
+
+static void CXBetweennessSourceRange(void *context, CXIndex start, CXIndex end, CXSize workerIndex) {
+	CXBetweennessTask *task = (CXBetweennessTask *)context;
+	CXBetweennessWorkerState *state = &task->workers[workerIndex];
+	for (CXIndex i = start; i < end; i++) {
+		CXIndex source = task->sources[i];
+		if (task->weighted) {
+			CXMeasurementBetweennessSourceWeighted(
+				task->graph,
+				source,
+				state->contrib,
+				state->distWeighted,
+				state->sigma,
+				state->delta,
+				state->settled,
+				state->stack,
+				&state->heap
+			);
+		} else {
+			CXMeasurementBetweennessSourceUnweighted(
+				task->graph,
+				source,
+				state->contrib,
+				&state->bfs,
+				state->sigma,
+				state->delta
+			);
+		}
+	}
+}
+
 CXSize CXNetworkMeasureBetweennessCentrality(
 	CXNetworkRef network,
 	const CXString edgeWeightAttribute,
@@ -2725,14 +3268,14 @@ CXSize CXNetworkMeasureBetweennessCentrality(
 		memset(inOutNodeBetweenness, 0, network->nodeCapacity * sizeof(float));
 	}
 
-	CXMeasurementEdgeWeights weights;
-	if (!CXMeasurementResolveEdgeWeights(network, edgeWeightAttribute, &weights)) {
-		return 0;
-	}
 	CXBool weighted = (edgeWeightAttribute && edgeWeightAttribute[0]) ? CXTrue : CXFalse;
 
 	CXMeasurementGraph graph;
-	if (!CXMeasurementGraphBuild(&graph, network, &weights)) {
+	if (!CXMeasurementGraphBuild(&graph, network)) {
+		return 0;
+	}
+	if (weighted && !CXMeasurementGraphAttachWeights(&graph, network, edgeWeightAttribute)) {
+		CXMeasurementGraphDestroy(&graph);
 		return 0;
 	}
 	if (graph.nodeCount == 0) {
@@ -2801,156 +3344,41 @@ CXSize CXNetworkMeasureBetweennessCentrality(
 	if (workerCount == 0) {
 		workerCount = 1;
 	}
-	CXSize chunkSize = 1 + ((selectedCount - 1) / workerCount);
-
-	if (workerCount == 1) {
-		int32_t *dist = (int32_t *)malloc(graph.nodeCount * sizeof(int32_t));
-		double *distWeighted = (double *)malloc(graph.nodeCount * sizeof(double));
-		double *sigma = (double *)malloc(graph.nodeCount * sizeof(double));
-		double *delta = (double *)malloc(graph.nodeCount * sizeof(double));
-		CXBool *settled = (CXBool *)malloc(graph.nodeCount * sizeof(CXBool));
-		CXIndex *queue = (CXIndex *)malloc(graph.nodeCount * sizeof(CXIndex));
-		CXIndex *stack = (CXIndex *)malloc(graph.nodeCount * sizeof(CXIndex));
-		CXMeasurementMinHeap heap;
-		CXBool heapOk = weighted ? CXMeasurementMinHeapInit(&heap, graph.nodeCount + 1) : CXTrue;
-		if (!dist || !distWeighted || !sigma || !delta || !settled || !queue || !stack || !heapOk) {
-			free(dist);
-			free(distWeighted);
-			free(sigma);
-			free(delta);
-			free(settled);
-			free(queue);
-			free(stack);
-			if (weighted && heapOk) {
-				CXMeasurementMinHeapDestroy(&heap);
-			}
-			free(centrality);
-			free(contrib);
-			free(sources);
-			CXMeasurementGraphDestroy(&graph);
-			return 0;
-		}
-
-		for (CXSize i = 0; i < selectedCount; i++) {
-			CXIndex source = sources[i];
-			if (weighted) {
-				CXMeasurementBetweennessSourceWeighted(
-					&graph,
-					source,
-					contrib,
-					distWeighted,
-					sigma,
-					delta,
-					settled,
-					stack,
-					&heap
-				);
-			} else {
-				CXMeasurementBetweennessSourceUnweighted(
-					&graph,
-					source,
-					contrib,
-					dist,
-					sigma,
-					delta,
-					queue,
-					stack
-				);
-			}
-		}
-
-		free(dist);
-		free(distWeighted);
-		free(sigma);
-		free(delta);
-		free(settled);
-		free(queue);
-		free(stack);
-		if (weighted) {
-			CXMeasurementMinHeapDestroy(&heap);
+	CXBetweennessWorkerState *workers = (CXBetweennessWorkerState *)calloc(workerCount, sizeof(CXBetweennessWorkerState));
+	CXBool workersOk = workers != NULL;
+	for (CXSize w = 0; workersOk && w < workerCount; w++) {
+		workersOk = CXBetweennessWorkerStateInit(&workers[w], &graph, weighted, w == 0 ? contrib : NULL);
+	}
+	if (!workersOk) {
+		for (CXSize w = 0; workers && w < workerCount; w++) {
+			CXBetweennessWorkerStateDestroy(&workers[w]);
 		}
-	} else {
-		CXParallelForStart(betweennessParallelLoop, workerIndex, workerCount) {
-			CXSize start = workerIndex * chunkSize;
-			CXSize end = CXMIN(selectedCount, (workerIndex + 1) * chunkSize);
-			if (start >= end) {
-				continue;
-			}
-
-			double *local = (double *)calloc(graph.nodeCount, sizeof(double));
-			int32_t *dist = (int32_t *)malloc(graph.nodeCount * sizeof(int32_t));
-			double *distWeighted = (double *)malloc(graph.nodeCount * sizeof(double));
-			double *sigma = (double *)malloc(graph.nodeCount * sizeof(double));
-			double *delta = (double *)malloc(graph.nodeCount * sizeof(double));
-			CXBool *settled = (CXBool *)malloc(graph.nodeCount * sizeof(CXBool));
-			CXIndex *queue = (CXIndex *)malloc(graph.nodeCount * sizeof(CXIndex));
-			CXIndex *stack = (CXIndex *)malloc(graph.nodeCount * sizeof(CXIndex));
-			CXMeasurementMinHeap heap;
-			CXBool heapOk = weighted ? CXMeasurementMinHeapInit(&heap, graph.nodeCount + 1) : CXTrue;
-			if (!local || !dist || !distWeighted || !sigma || !delta || !settled || !queue || !stack || !heapOk) {
-				free(local);
-				free(dist);
-				free(distWeighted);
-				free(sigma);
-				free(delta);
-				free(settled);
-				free(queue);
-				free(stack);
-				if (weighted && heapOk) {
-					CXMeasurementMinHeapDestroy(&heap);
-				}
-				continue;
-			}
-
-			for (CXSize i = start; i < end; i++) {
-				CXIndex source = sources[i];
-				if (weighted) {
-					CXMeasurementBetweennessSourceWeighted(
-						&graph,
-						source,
-						local,
-						distWeighted,
-						sigma,
-						delta,
-						settled,
-						stack,
-						&heap
-					);
-				} else {
-					CXMeasurementBetweennessSourceUnweighted(
-						&graph,
-						source,
-						local,
-						dist,
-						sigma,
-						delta,
-						queue,
-						stack
-					);
-				}
-			}
+		free(workers);
+		free(centrality);
+		free(contrib);
+		free(sources);
+		CXMeasurementGraphDestroy(&graph);
+		return 0;
+	}
 
-			CXParallelLoopCriticalRegionStart(betweennessParallelLoop) {
-				for (CXSize u = 0; u < graph.nodeCount; u++) {
-					contrib[u] += local[u];
-				}
-			}
-			CXParallelLoopCriticalRegionEnd(betweennessParallelLoop);
+	CXBetweennessTask task = {
+		.graph = &graph,
+		.sources = sources,
+		.weighted = weighted,
+		.workers = workers
+	};
+	CXParallelForRange(selectedCount, 1, workerCount, CXBetweennessSourceRange, &task);
 
-			free(local);
-			free(dist);
-			free(distWeighted);
-			free(sigma);
-			free(delta);
-			free(settled);
-			free(queue);
-			free(stack);
-			if (weighted) {
-				CXMeasurementMinHeapDestroy(&heap);
-			}
+	for (CXSize w = 1; w < workerCount; w++) {
+		const double *local = workers[w].contrib;
+		for (CXIndex u = 0; u < graph.nodeCount; u++) {
+			contrib[u] += local[u];
 		}
-		CXParallelForEnd(betweennessParallelLoop);
 	}
+	for (CXSize w = 0; w < workerCount; w++) {
+		CXBetweennessWorkerStateDestroy(&workers[w]);
+	}
+	free(workers);
 
 	if (!graph.directed) {
 		for (CXIndex u = 0; u < graph.nodeCount; u++) {
@@ -0,0 +1,1880 @@
+#include "CXNetworkNodeLinkJSON.h"
+
+#include "CXNetwork.h"
+#include "CXDictionary.h"
+#include "CXTextWriter.h"
+
+#include <errno.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*
+ * Streaming node-link JSON reader.
+ *
+ * The document is scanned in place, without building a value tree. A first
+ * pass validates the syntax and records where `nodes`, `links`/`edges`,
+ * `graph`/`network` and `directed` live. A second pass walks the node and
+ * link arrays once to assign node ids, resolve endpoints and infer a column
+ * type per attribute. After the network and its columns exist, a third pass
+ * walks the same arrays again and writes every value straight into its
+ * column. Memory beyond the input mapping is proportional to the output
+ * graph: one id per node, one endpoint pair per link and the columns.
+ *
+ * Type inference, id handling and warning texts follow the JavaScript loader
+ * (`fromNodeLinkJSON` in `HeliosNetwork.js`).
+ */
+
+#define NODE_LINK_MAX_DEPTH 512
+#define NODE_LINK_NUMBER_INLINE 64
+#define NODE_LINK_SHADOW_DICTIONARY_MIN 16
+
+typedef struct {
+	char *data;
+	size_t size;
+	CXBool mapped;
+} NodeLinkInput;
+
+typedef struct {
+	const char *begin;
+	const char *cursor;
+	const char *end;
+	const char *error;
+	const char *errorAt;
+	unsigned depth;
+} NodeLinkScanner;
+
+typedef enum {
+	NodeLinkNull = 0,
+	NodeLinkFalse = 1,
+	NodeLinkTrue = 2,
+	NodeLinkNumber = 3,
+	NodeLinkString = 4,
+	NodeLinkArray = 5,
+	NodeLinkObject = 6
+} NodeLinkKind;
+
+/* A scanned value. Strings span their contents without the quotes;
+ * containers span their brackets. */
+typedef struct {
+	NodeLinkKind kind;
+	CXBool escaped;
+	const char *start;
+	const char *end;
+	double number;
+} NodeLinkValue;
+
+typedef struct {
+	char *data;
+	size_t length;
+	size_t capacity;
+} NodeLinkText;
+
+typedef struct {
+	size_t keyOffset;
+	CXBool shadowed;
+	NodeLinkValue value;
+} NodeLinkMember;
+
+/* Members of one node, link or graph record after `attributes` was merged
+ * in. Reserved keys (`id`, or `source` and `target`) are held apart. */
+typedef struct {
+	NodeLinkMember *members;
+	size_t count;
+	size_t capacity;
+	NodeLinkText keys;
+	NodeLinkValue reserved[2];
+	CXBool hasReserved[2];
+} NodeLinkRecord;
+
+typedef enum {
+	NodeLinkModeString = 0,
+	NodeLinkModeBoolean = 1,
+	NodeLinkModeNumber = 2,
+	NodeLinkModeVector = 3,
+	NodeLinkModeMultiCategory = 4,
+	NodeLinkModeJSONString = 5
+} NodeLinkMode;
+
+typedef struct {
+	NodeLinkMode mode;
+	CXAttributeType type;
+	CXSize dimension;
+	CXBool hasWeights;
+} NodeLinkShape;
+
+typedef struct {
+	CXIndex row;
+	size_t start;
+	size_t count;
+} NodeLinkCategorySegment;
+
+/* Multi-category entries are gathered per column and packed once at the end
+ * instead of going through the per-entry setters, which shift every later
+ * offset on each call. */
+typedef struct {
+	CXStringDictionaryRef labelIds;
+	CXString *labels;
+	size_t labelCount;
+	size_t labelCapacity;
+	uint32_t *ids;
+	float *weights;
+	size_t idCount;
+	size_t idCapacity;
+	NodeLinkCategorySegment *segments;
+	size_t segmentCount;
+	size_t segmentCapacity;
+} NodeLinkCategories;
+
+typedef struct {
+	char *name;
+	NodeLinkShape shape;
+	CXBool skipped;
+	CXAttributeRef attr;
+	NodeLinkCategories *categories;
+} NodeLinkColumn;
+
+typedef struct {
+	CXAttributeScope scope;
+	CXStringDictionaryRef lookup;
+	NodeLinkColumn **items;
+	size_t count;
+	size_t capacity;
+	NodeLinkColumn **coerced;
+	size_t coercedCount;
+	size_t coercedCapacity;
+	/* Column seen at each member position of the previous record; records
+	 * usually list their keys in the same order. */
+	NodeLinkColumn **hints;
+	size_t hintCapacity;
+} NodeLinkColumnSet;
+
+typedef struct {
+	NodeLinkValue directed;
+	NodeLinkValue nodes;
+	NodeLinkValue links;
+	NodeLinkValue edges;
+	NodeLinkValue graph;
+	NodeLinkValue network;
+	CXBool hasDirected;
+	CXBool hasNodes;
+	CXBool hasLinks;
+	CXBool hasEdges;
+	CXBool hasGraph;
+	CXBool hasNetwork;
+} NodeLinkDocument;
+
+typedef struct {
+	NodeLinkDocument document;
+	NodeLinkRecord record;
+	NodeLinkText text;
+	CXStringDictionaryRef shadow;
+	CXStringDictionaryRef nodeIds;
+	/* Tagged node ids ("s" + text for strings, "j" + JSON otherwise) in
+	 * insertion order, synthesized endpoints last. */
+	CXString *nodeKeys;
+	size_t nodeCount;
+	size_t nodeCapacity;
+	CXEdge *edges;
+	size_t edgeCount;
+	size_t edgeCapacity;
+	NodeLinkColumnSet columns[3];
+	char *error;
+} NodeLinkReader;
+
+static const char *const NodeLinkNodeReserved[] = { "id" };
+static const char *const NodeLinkLinkReserved[] = { "source", "target" };
+
+static CXBool NodeLinkReserve(void **items, size_t *capacity, size_t required, size_t itemSize) {
+	if (*capacity >= required) {
+		return CXTrue;
+	}
+	size_t newCapacity = *capacity > 0 ? *capacity : 8;
+	while (newCapacity < required) {
+		newCapacity = CXCapacityGrow(newCapacity);
+	}
+	void *grown = realloc(*items, newCapacity * itemSize);
+	if (!grown) {
+		return CXFalse;
+	}
+	*items = grown;
+	*capacity = newCapacity;
+	return CXTrue;
+}
+
+static CXBool NodeLinkInputOpen(NodeLinkInput *input, const char *path) {
+#if !defined(_WIN32)
+	int fd = open(path, O_RDONLY);
+	if (fd < 0) {
+		return CXFalse;
+	}
+	struct stat info;
+	if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0 &&
+		(uint64_t)info.st_size <= (uint64_t)SIZE_MAX) {
+		size_t length = (size_t)info.st_size;
+		void *data = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (data != MAP_FAILED) {
+			close(fd);
+#if defined(POSIX_MADV_SEQUENTIAL)
+			posix_madvise(data, length, POSIX_MADV_SEQUENTIAL);
+#endif
+			input->data = data;
+			input->size = length;
+			input->mapped = CXTrue;
+			return CXTrue;
+		}
+	}
+	close(fd);
+#endif
+	FILE *file = fopen(path, "rb");
+	if (!file) {
+		return CXFalse;
+	}
+	size_t capacity = 1 << 16;
+	size_t length = 0;
+	char *data = malloc(capacity);
+	while (data) {
+		length += fread(data + length, 1, capacity - length, file);
+		if (length < capacity) {
+			break;
+		}
+		char *grown = realloc(data, capacity * 2);
+		if (!grown) {
+			free(data);
+			data = NULL;
+			break;
+		}
+		data = grown;
+		capacity *= 2;
+	}
+	CXBool failed = !data || ferror(file);
+	fclose(file);
+	if (failed) {
+		free(data);
+		return CXFalse;
+	}
+	input->data = data;
+	input->size = length;
+	input->mapped = CXFalse;
+	return CXTrue;
+}
+
+static void NodeLinkInputClose(NodeLinkInput *input) {
+#if !defined(_WIN32)
+	if (input->mapped) {
+		munmap(input->data, input->size);
+	} else {
+		free(input->data);
+	}
+#else
+	free(input->data);
+#endif
+	input->data = NULL;
+	input->size = 0;
+}
+
+static CXBool NodeLinkTextReserve(NodeLinkText *text, size_t extra) {
+	return NodeLinkReserve((void **)&text->data, &text->capacity, text->length + extra + 1, 1);
+}
+
+static CXBool NodeLinkTextAppend(NodeLinkText *text, const char *data, size_t length) {
+	if (!NodeLinkTextReserve(text, length)) {
+		return CXFalse;
+	}
+	memcpy(text->data + text->length, data, length);
+	text->length += length;
+	text->data[text->length] = '\0';
+	return CXTrue;
+}
+
+static CXBool NodeLinkTextPutChar(NodeLinkText *text, char ch) {
+	return NodeLinkTextAppend(text, &ch, 1);
+}
+
+static void NodeLinkScannerInit(NodeLinkScanner *scanner, const char *start, const char *end) {
+	scanner->begin = start;
+	scanner->cursor = start;
+	scanner->end = end;
+	scanner->error = NULL;
+	scanner->errorAt = NULL;
+	scanner->depth = 0;
+}
+
+static CXBool NodeLinkFail(NodeLinkScanner *scanner, const char *message) {
+	if (!scanner->error) {
+		scanner->error = message;
+		scanner->errorAt = scanner->cursor;
+	}
+	return CXFalse;
+}
+
+static void NodeLinkSkipSpace(NodeLinkScanner *scanner) {
+	const char *cursor = scanner->cursor;
+	const char *end = scanner->end;
+	while (cursor < end && (*cursor == ' ' || *cursor == '\n' || *cursor == '\r' || *cursor == '\t')) {
+		cursor += 1;
+	}
+	scanner->cursor = cursor;
+}
+
+static int NodeLinkHexValue(char ch) {
+	if (ch >= '0' && ch <= '9') {
+		return ch - '0';
+	}
+	if (ch >= 'a' && ch <= 'f') {
+		return ch - 'a' + 10;
+	}
+	if (ch >= 'A' && ch <= 'F') {
+		return ch - 'A' + 10;
+	}
+	return -1;
+}
+
+static CXBool NodeLinkScanString(NodeLinkScanner *scanner, NodeLinkValue *value) {
+	const char *cursor = scanner->cursor + 1;
+	const char *end = scanner->end;
+	value->kind = NodeLinkString;
+	value->escaped = CXFalse;
+	value->start = cursor;
+	while (cursor < end) {
+		unsigned char ch = (unsigned char)*cursor;
+		if (ch == '"') {
+			value->end = cursor;
+			scanner->cursor = cursor + 1;
+			return CXTrue;
+		}
+		if (ch < 0x20) {
+			scanner->cursor = cursor;
+			return NodeLinkFail(scanner, "control character in string");
+		}
+		if (ch == '\\') {
+			value->escaped = CXTrue;
+			if (cursor + 1 >= end) {
+				break;
+			}
+			char escape = cursor[1];
+			if (escape == 'u') {
+				if (end - cursor < 6 ||
+					NodeLinkHexValue(cursor[2]) < 0 || NodeLinkHexValue(cursor[3]) < 0 ||
+					NodeLinkHexValue(cursor[4]) < 0 || NodeLinkHexValue(cursor[5]) < 0) {
+					scanner->cursor = cursor;
+					return NodeLinkFail(scanner, "invalid \\u escape");
+				}
+				cursor += 6;
+				continue;
+			}
+			if (!strchr("\"\\/bfnrt", escape) || escape == '\0') {
+				scanner->cursor = cursor;
+				return NodeLinkFail(scanner, "invalid escape sequence");
+			}
+			cursor += 2;
+			continue;
+		}
+		cursor += 1;
+	}
+	scanner->cursor = end;
+	return NodeLinkFail(scanner, "unterminated string");
+}
+
+static CXBool NodeLinkScanNumber(NodeLinkScanner *scanner, NodeLinkValue *value) {
+	const char *start = scanner->cursor;
+	const char *cursor = start;
+	const char *end = scanner->end;
+	CXBool simple = CXTrue;
+	if (cursor < end && *cursor == '-') {
+		cursor += 1;
+	}
+	if (cursor >= end || *cursor < '0' || *cursor > '9') {
+		scanner->cursor = cursor;
+		return NodeLinkFail(scanner, "invalid number");
+	}
+	if (*cursor == '0') {
+		cursor += 1;
+	} else {
+		while (cursor < end && *cursor >= '0' && *cursor <= '9') {
+			cursor += 1;
+		}
+	}
+	if (cursor < end && *cursor == '.') {
+		simple = CXFalse;
+		cursor += 1;
+		if (cursor >= end || *cursor < '0' || *cursor > '9') {
+			scanner->cursor = cursor;
+			return NodeLinkFail(scanner, "invalid number");
+		}
+		while (cursor < end && *cursor >= '0' && *cursor <= '9') {
+			cursor += 1;
+		}
+	}
+	if (cursor < end && (*cursor == 'e' || *cursor == 'E')) {
+		simple = CXFalse;
+		cursor += 1;
+		if (cursor < end && (*cursor == '+' || *cursor == '-')) {
+			cursor += 1;
+		}
+		if (cursor >= end || *cursor < '0' || *cursor > '9') {
+			scanner->cursor = cursor;
+			return NodeLinkFail(scanner, "invalid number");
+		}
+		while (cursor < end && *cursor >= '0' && *cursor <= '9') {
+			cursor += 1;
+		}
+	}
+	value->kind = NodeLinkNumber;
+	value->escaped = CXFalse;
+	value->start = start;
+	value->end = cursor;
+	scanner->cursor = cursor;
+
+	size_t length = (size_t)(cursor - start);
+	CXBool negative = *start == '-';
+	if (simple && length - (negative ? 1u : 0u) <= 15u) {
+		// Up to 15 digits are exact in a double.
+		uint64_t integer = 0;
+		for (const char *digit = start + (negative ? 1 : 0); digit < cursor; digit += 1) {
+			integer = integer * 10u + (uint64_t)(*digit - '0');
+		}
+		value->number = negative ? -(double)integer : (double)integer;
+		return CXTrue;
+	}
+	char inlineBuffer[NODE_LINK_NUMBER_INLINE];
+	char *buffer = length < sizeof(inlineBuffer) ? inlineBuffer : malloc(length + 1);
+	if (!buffer) {
+		return NodeLinkFail(scanner, "out of memory");
+	}
+	memcpy(buffer, start, length);
+	buffer[length] = '\0';
+	value->number = strtod(buffer, NULL);
+	if (buffer != inlineBuffer) {
+		free(buffer);
+	}
+	return CXTrue;
+}
+
+static CXBool NodeLinkScanLiteral(NodeLinkScanner *scanner, const char *literal, size_t length, NodeLinkKind kind, NodeLinkValue *value) {
+	if ((size_t)(scanner->end - scanner->cursor) < length || memcmp(scanner->cursor, literal, length) != 0) {
+		return NodeLinkFail(scanner, "unexpected character");
+	}
+	value->kind = kind;
+	value->escaped = CXFalse;
+	value->start = scanner->cursor;
+	value->end = scanner->cursor + length;
+	scanner->cursor += length;
+	return CXTrue;
+}
+
+static CXBool NodeLinkScanValue(NodeLinkScanner *scanner, NodeLinkValue *value);
+
+/*
+ * Moves to the next member of the object being scanned. Returns 1 with the
+ * key in `key` and the cursor on the member value, 0 after the closing brace,
+ * and -1 on a syntax error.
+ */
+static int NodeLinkObjectNext(NodeLinkScanner *scanner, CXBool *started, NodeLinkValue *key) {
+	NodeLinkSkipSpace(scanner);
+	if (scanner->cursor >= scanner->end) {
+		NodeLinkFail(scanner, "unterminated object");
+		return -1;
+	}
+	if (*scanner->cursor == '}') {
+		scanner->cursor += 1;
+		return 0;
+	}
+	if (*started) {
+		if (*scanner->cursor != ',') {
+			NodeLinkFail(scanner, "expected ',' or '}'");
+			return -1;
+		}
+		scanner->cursor += 1;
+		NodeLinkSkipSpace(scanner);
+	}
+	*started = CXTrue;
+	if (scanner->cursor >= scanner->end || *scanner->cursor != '"') {
+		NodeLinkFail(scanner, "expected string key");
+		return -1;
+	}
+	if (!NodeLinkScanString(scanner, key)) {
+		return -1;
+	}
+	NodeLinkSkipSpace(scanner);
+	if (scanner->cursor >= scanner->end || *scanner->cursor != ':') {
+		NodeLinkFail(scanner, "expected ':'");
+		return -1;
+	}
+	scanner->cursor += 1;
+	return 1;
+}
+
+/* Array counterpart of `NodeLinkObjectNext`; 1 leaves the cursor on the next
+ * element. */
+static int NodeLinkArrayNext(NodeLinkScanner *scanner, CXBool *started) {
+	NodeLinkSkipSpace(scanner);
+	if (scanner->cursor >= scanner->end) {
+		NodeLinkFail(scanner, "unterminated array");
+		return -1;
+	}
+	if (*scanner->cursor == ']') {
+		scanner->cursor += 1;
+		return 0;
+	}
+	if (*started) {
+		if (*scanner->cursor != ',') {
+			NodeLinkFail(scanner, "expected ',' or ']'");
+			return -1;
+		}
+		scanner->cursor += 1;
+	}
+	*started = CXTrue;
+	return 1;
+}
+
+static CXBool NodeLinkSkipContainer(NodeLinkScanner *scanner, NodeLinkValue *value) {
+	char open = *scanner->cursor;
+	if (scanner->depth >= NODE_LINK_MAX_DEPTH) {
+		return NodeLinkFail(scanner, "nesting too deep");
+	}
+	value->kind = open == '{' ? NodeLinkObject : NodeLinkArray;
+	value->escaped = CXFalse;
+	value->start = scanner->cursor;
+	scanner->depth += 1;
+	scanner->cursor += 1;
+	CXBool started = CXFalse;
+	NodeLinkValue item;
+	int status;
+	if (open == '{') {
+		NodeLinkValue key;
+		while ((status = NodeLinkObjectNext(scanner, &started, &key)) == 1) {
+			if (!NodeLinkScanValue(scanner, &item)) {
+				return CXFalse;
+			}
+		}
+	} else {
+		while ((status = NodeLinkArrayNext(scanner, &started)) == 1) {
+			if (!NodeLinkScanValue(scanner, &item)) {
+				return CXFalse;
+			}
+		}
+	}
+	if (status < 0) {
+		return CXFalse;
+	}
+	scanner->depth -= 1;
+	value->end = scanner->cursor;
+	return CXTrue;
+}
+
+static CXBool NodeLinkScanValue(NodeLinkScanner *scanner, NodeLinkValue *value) {
+	NodeLinkSkipSpace(scanner);
+	if (scanner->cursor >= scanner->end) {
+		return NodeLinkFail(scanner, "unexpected end of input");
+	}
+	switch (*scanner->cursor) {
+		case '{':
+		case '[':
+			return NodeLinkSkipContainer(scanner, value);
+		case '"':
+			return NodeLinkScanString(scanner, value);
+		case 't':
+			return NodeLinkScanLiteral(scanner, "true", 4, NodeLinkTrue, value);
+		case 'f':
+			return NodeLinkScanLiteral(scanner, "false", 5, NodeLinkFalse, value);
+		case 'n':
+			return NodeLinkScanLiteral(scanner, "null", 4, NodeLinkNull, value);
+		default:
+			if (*scanner->cursor == '-' || (*scanner->cursor >= '0' && *scanner->cursor <= '9')) {
+				return NodeLinkScanNumber(scanner, value);
+			}
+			return NodeLinkFail(scanner, "unexpected character");
+	}
+}
+
+/* Opens a scanner positioned inside an already validated container. */
+static void NodeLinkEnter(NodeLinkScanner *scanner, const NodeLinkValue *container) {
+	NodeLinkScannerInit(scanner, container->start, container->end);
+	scanner->cursor += 1;
+}
+
+static CXBool NodeLinkAppendUTF8(NodeLinkText *text, uint32_t codepoint) {
+	char bytes[4];
+	size_t length = 0;
+	if (codepoint < 0x80) {
+		bytes[length++] = (char)codepoint;
+	} else if (codepoint < 0x800) {
+		bytes[length++] = (char)(0xC0 | (codepoint >> 6));
+		bytes[length++] = (char)(0x80 | (codepoint & 0x3F));
+	} else if (codepoint < 0x10000) {
+		bytes[length++] = (char)(0xE0 | (codepoint >> 12));
+		bytes[length++] = (char)(0x80 | ((codepoint >> 6) & 0x3F));
+		bytes[length++] = (char)(0x80 | (codepoint & 0x3F));
+	} else {
+		bytes[length++] = (char)(0xF0 | (codepoint >> 18));
+		bytes[length++] = (char)(0x80 | ((codepoint >> 12) & 0x3F));
+		bytes[length++] = (char)(0x80 | ((codepoint >> 6) & 0x3F));
+		bytes[length++] = (char)(0x80 | (codepoint & 0x3F));
+	}
+	return NodeLinkTextAppend(text, bytes, length);
+}
+
+static uint32_t NodeLinkReadHex4(const char *cursor) {
+	return (uint32_t)((NodeLinkHexValue(cursor[0]) << 12) | (NodeLinkHexValue(cursor[1]) << 8) |
+		(NodeLinkHexValue(cursor[2]) << 4) | NodeLinkHexValue(cursor[3]));
+}
+
+/* Appends the decoded contents of a scanned string. */
+static CXBool NodeLinkDecodeString(const NodeLinkValue *value, NodeLinkText *text) {
+	const char *cursor = value->start;
+	const char *end = value->end;
+	if (!value->escaped) {
+		return NodeLinkTextAppend(text, cursor, (size_t)(end - cursor));
+	}
+	while (cursor < end) {
+		const char *run = cursor;
+		while (cursor < end && *cursor != '\\') {
+			cursor += 1;
+		}
+		if (cursor > run && !NodeLinkTextAppend(text, run, (size_t)(cursor - run))) {
+			return CXFalse;
+		}
+		if (cursor >= end) {
+			break;
+		}
+		char escape = cursor[1];
+		cursor += 2;
+		char decoded = 0;
+		switch (escape) {
+			case 'b': decoded = '\b'; break;
+			case 'f': decoded = '\f'; break;
+			case 'n': decoded = '\n'; break;
+			case 'r': decoded = '\r'; break;
+			case 't': decoded = '\t'; break;
+			case 'u': {
+				uint32_t codepoint = NodeLinkReadHex4(cursor);
+				cursor += 4;
+				if (codepoint >= 0xD800 && codepoint <= 0xDBFF && end - cursor >= 6 && cursor[0] == '\\' && cursor[1] == 'u') {
+					uint32_t low = NodeLinkReadHex4(cursor + 2);
+					if (low >= 0xDC00 && low <= 0xDFFF) {
+						codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+						cursor += 6;
+					}
+				}
+				if (!NodeLinkAppendUTF8(text, codepoint)) {
+					return CXFalse;
+				}
+				continue;
+			}
+			default: decoded = escape; break;
+		}
+		if (!NodeLinkTextPutChar(text, decoded)) {
+			return CXFalse;
+		}
+	}
+	if (!NodeLinkTextReserve(text, 0)) {
+		return CXFalse;
+	}
+	text->data[text->length] = '\0';
+	return CXTrue;
+}
+
+static CXBool NodeLinkStringEquals(const NodeLinkValue *value, const char *literal, NodeLinkText *scratch) {
+	size_t length = strlen(literal);
+	if (!value->escaped) {
+		return (size_t)(value->end - value->start) == length && memcmp(value->start, literal, length) == 0;
+	}
+	scratch->length = 0;
+	return NodeLinkDecodeString(value, scratch) && scratch->length == length && memcmp(scratch->data, literal, length) == 0;
+}
+
+/* Number text as `JSON.stringify` would print it for the common cases:
+ * integers below 1e21 in full, other values as their shortest decimal. */
+static size_t NodeLinkFormatNumber(char *out, double number) {
+	if (!isfinite(number)) {
+		memcpy(out, "null", 5);
+		return 4;
+	}
+	if (number == 0.0) {
+		memcpy(out, "0", 2);
+		return 1;
+	}
+	if (number == floor(number) && fabs(number) < 1e21) {
+		if (fabs(number) < 9007199254740992.0) {
+			return CXTextFormatInt64(out, (int64_t)number);
+		}
+		return (size_t)snprintf(out, CX_TEXT_NUMBER_MAX, "%.0f", number);
+	}
+	size_t length = CXTextFormatDouble(out, number);
+	char *exponent = strchr(out, 'e');
+	if (exponent) {
+		// "1e-07" -> "1e-7"
+		char *digits = exponent + 2;
+		char *first = digits;
+		while (*first == '0' && first[1] != '\0') {
+			first += 1;
+		}
+		if (first != digits) {
+			memmove(digits, first, strlen(first) + 1);
+			length = strlen(out);
+		}
+	}
+	return length;
+}
+
+static CXBool NodeLinkAppendJSONString(NodeLinkText *text, const char *data, size_t length) {
+	static const char hex[] = "0123456789abcdef";
+	if (!NodeLinkTextPutChar(text, '"')) {
+		return CXFalse;
+	}
+	for (size_t i = 0; i < length; i += 1) {
+		unsigned char ch = (unsigned char)data[i];
+		char escape[6];
+		size_t escapeLength = 2;
+		escape[0] = '\\';
+		switch (ch) {
+			case '"': escape[1] = '"'; break;
+			case '\\': escape[1] = '\\'; break;
+			case '\b': escape[1] = 'b'; break;
+			case '\f': escape[1] = 'f'; break;
+			case '\n': escape[1] = 'n'; break;
+			case '\r': escape[1] = 'r'; break;
+			case '\t': escape[1] = 't'; break;
+			default:
+				if (ch >= 0x20) {
+					escapeLength = 0;
+				} else {
+					escape[1] = 'u';
+					escape[2] = '0';
+					escape[3] = '0';
+					escape[4] = hex[ch >> 4];
+					escape[5] = hex[ch & 0xF];
+					escapeLength = 6;
+				}
+				break;
+		}
+		CXBool ok = escapeLength ? NodeLinkTextAppend(text, escape, escapeLength) : NodeLinkTextPutChar(text, (char)ch);
+		if (!ok) {
+			return CXFalse;
+		}
+	}
+	return NodeLinkTextPutChar(text, '"');
+}
+
+/* Appends `value` as compact JSON, the form `JSON.stringify` produces. */
+static CXBool NodeLinkAppendCompact(NodeLinkText *text, const NodeLinkValue *value, NodeLinkText *scratch) {
+	switch (value->kind) {
+		case NodeLinkNull:
+			return NodeLinkTextAppend(text, "null", 4);
+		case NodeLinkFalse:
+			return NodeLinkTextAppend(text, "false", 5);
+		case NodeLinkTrue:
+			return NodeLinkTextAppend(text, "true", 4);
+		case NodeLinkNumber: {
+			char buffer[CX_TEXT_NUMBER_MAX];
+			size_t length = NodeLinkFormatNumber(buffer, value->number);
+			return NodeLinkTextAppend(text, buffer, length);
+		}
+		case NodeLinkString:
+			if (!value->escaped) {
+				return NodeLinkTextPutChar(text, '"') &&
+					NodeLinkTextAppend(text, value->start, (size_t)(value->end - value->start)) &&
+					NodeLinkTextPutChar(text, '"');
+			}
+			scratch->length = 0;
+			return NodeLinkDecodeString(value, scratch) && NodeLinkAppendJSONString(text, scratch->data, scratch->length);
+		case NodeLinkArray:
+		case NodeLinkObject: {
+			NodeLinkScanner scanner;
+			NodeLinkEnter(&scanner, value);
+			CXBool started = CXFalse;
+			CXBool isObject = value->kind == NodeLinkObject;
+			NodeLinkValue key;
+			NodeLinkValue item;
+			int status;
+			if (!NodeLinkTextPutChar(text, isObject ? '{' : '[')) {
+				return CXFalse;
+			}
+			CXBool first = CXTrue;
+			while ((status = isObject ? NodeLinkObjectNext(&scanner, &started, &key) : NodeLinkArrayNext(&scanner, &started)) == 1) {
+				if (!NodeLinkScanValue(&scanner, &item)) {
+					return CXFalse;
+				}
+				if (!first && !NodeLinkTextPutChar(text, ',')) {
+					return CXFalse;
+				}
+				first = CXFalse;
+				if (isObject && (!NodeLinkAppendCompact(text, &key, scratch) || !NodeLinkTextPutChar(text, ':'))) {
+					return CXFalse;
+				}
+				if (!NodeLinkAppendCompact(text, &item, scratch)) {
+					return CXFalse;
+				}
+			}
+			return status == 0 && NodeLinkTextPutChar(text, isObject ? '}' : ']');
+		}
+	}
+	return CXFalse;
+}
+
+/* Reads a `{label, weight}` multi-category item; the last duplicate key wins. */
+static void NodeLinkReadLabelObject(const NodeLinkValue *object, NodeLinkValue *label, CXBool *hasLabel, NodeLinkValue *weight, CXBool *hasWeight, NodeLinkText *scratch) {
+	NodeLinkScanner scanner;
+	NodeLinkEnter(&scanner, object);
+	CXBool started = CXFalse;
+	NodeLinkValue key;
+	NodeLinkValue item;
+	*hasLabel = CXFalse;
+	*hasWeight = CXFalse;
+	while (NodeLinkObjectNext(&scanner, &started, &key) == 1 && NodeLinkScanValue(&scanner, &item)) {
+		if (NodeLinkStringEquals(&key, "label", scratch)) {
+			*label = item;
+			*hasLabel = CXTrue;
+		} else if (NodeLinkStringEquals(&key, "weight", scratch)) {
+			*weight = item;
+			*hasWeight = CXTrue;
+		}
+	}
+}
+
+static CXBool NodeLinkIsInteger(double number) {
+	return isfinite(number) && number == floor(number);
+}
+
+static void NodeLinkClassifyArray(const NodeLinkValue *value, NodeLinkShape *shape, NodeLinkText *scratch) {
+	NodeLinkScanner scanner;
+	NodeLinkEnter(&scanner, value);
+	CXBool started = CXFalse;
+	NodeLinkValue item;
+	size_t length = 0;
+	size_t nonNull = 0;
+	CXBool allNumbers = CXTrue;
+	CXBool allStrings = CXTrue;
+	CXBool allLabels = CXTrue;
+	CXBool wantsDouble = CXFalse;
+	CXBool wantsSigned = CXFalse;
+	while (NodeLinkArrayNext(&scanner, &started) == 1 && NodeLinkScanValue(&scanner, &item)) {
+		length += 1;
+		if (item.kind == NodeLinkNull) {
+			continue;
+		}
+		nonNull += 1;
+		if (item.kind == NodeLinkNumber && isfinite(item.number)) {
+			CXBool integer = NodeLinkIsInteger(item.number);
+			if (!integer || item.number > 4294967295.0 || item.number < -2147483648.0) {
+				wantsDouble = CXTrue;
+			}
+			if (integer && item.number < 0) {
+				wantsSigned = CXTrue;
+			}
+			allStrings = CXFalse;
+			allLabels = CXFalse;
+			continue;
+		}
+		allNumbers = CXFalse;
+		if (item.kind != NodeLinkString) {
+			allStrings = CXFalse;
+		}
+		if (allLabels) {
+			NodeLinkValue label;
+			NodeLinkValue weight;
+			CXBool hasLabel = CXFalse;
+			CXBool hasWeight = CXFalse;
+			if (item.kind == NodeLinkObject) {
+				NodeLinkReadLabelObject(&item, &label, &hasLabel, &weight, &hasWeight, scratch);
+			}
+			if (!hasLabel || label.kind != NodeLinkString || (hasWeight && weight.kind != NodeLinkNumber)) {
+				allLabels = CXFalse;
+			}
+		}
+	}
+	shape->dimension = 1;
+	shape->hasWeights = CXFalse;
+	if (nonNull == 0) {
+		shape->mode = NodeLinkModeJSONString;
+		shape->type = CXStringAttributeType;
+	} else if (allNumbers) {
+		shape->mode = NodeLinkModeVector;
+		shape->type = wantsDouble ? CXDoubleAttributeType : (wantsSigned ? CXIntegerAttributeType : CXUnsignedIntegerAttributeType);
+		shape->dimension = (CXSize)length;
+	} else if (allStrings || allLabels) {
+		shape->mode = NodeLinkModeMultiCategory;
+		shape->type = CXDataAttributeMultiCategoryType;
+		shape->hasWeights = !allStrings;
+	} else {
+		shape->mode = NodeLinkModeJSONString;
+		shape->type = CXStringAttributeType;
+	}
+}
+
+/* Column shape implied by one value; CXFalse for null, which is skipped. */
+static CXBool NodeLinkClassify(const NodeLinkValue *value, NodeLinkShape *shape, NodeLinkText *scratch) {
+	shape->dimension = 1;
+	shape->hasWeights = CXFalse;
+	switch (value->kind) {
+		case NodeLinkNull:
+			return CXFalse;
+		case NodeLinkString:
+			shape->mode = NodeLinkModeString;
+			shape->type = CXStringAttributeType;
+			return CXTrue;
+		case NodeLinkFalse:
+		case NodeLinkTrue:
+			shape->mode = NodeLinkModeBoolean;
+			shape->type = CXBooleanAttributeType;
+			return CXTrue;
+		case NodeLinkNumber:
+			if (!isfinite(value->number)) {
+				shape->mode = NodeLinkModeJSONString;
+				shape->type = CXStringAttributeType;
+			} else if (NodeLinkIsInteger(value->number) && value->number >= 0 && value->number <= 4294967295.0) {
+				shape->mode = NodeLinkModeNumber;
+				shape->type = CXUnsignedIntegerAttributeType;
+			} else if (NodeLinkIsInteger(value->number) && value->number >= -2147483648.0 && value->number <= 2147483647.0) {
+				shape->mode = NodeLinkModeNumber;
+				shape->type = CXIntegerAttributeType;
+			} else {
+				shape->mode = NodeLinkModeNumber;
+				shape->type = CXDoubleAttributeType;
+			}
+			return CXTrue;
+		case NodeLinkArray:
+			NodeLinkClassifyArray(value, shape, scratch);
+			return CXTrue;
+		case NodeLinkObject:
+			shape->mode = NodeLinkModeJSONString;
+			shape->type = CXStringAttributeType;
+			return CXTrue;
+	}
+	return CXFalse;
+}
+
+static NodeLinkShape NodeLinkMergeShape(NodeLinkShape existing, NodeLinkShape candidate) {
+	NodeLinkShape stringShape = { NodeLinkModeJSONString, CXStringAttributeType, 1, CXFalse };
+	if (existing.mode == NodeLinkModeJSONString || candidate.mode == NodeLinkModeJSONString) {
+		return stringShape;
+	}
+	if (existing.mode == NodeLinkModeMultiCategory && candidate.mode == NodeLinkModeMultiCategory) {
+		existing.hasWeights = existing.hasWeights || candidate.hasWeights;
+		return existing;
+	}
+	if (existing.mode == candidate.mode && existing.dimension == candidate.dimension) {
+		if ((existing.mode == NodeLinkModeNumber || existing.mode == NodeLinkModeVector) && existing.type != candidate.type) {
+			existing.type = CXDoubleAttributeType;
+		}
+		return existing;
+	}
+	return stringShape;
+}
+
+static void NodeLinkCategoriesFree(NodeLinkCategories *categories) {
+	if (!categories) {
+		return;
+	}
+	if (categories->labelIds) {
+		CXStringDictionaryDestroy(categories->labelIds);
+	}
+	for (size_t i = 0; i < categories->labelCount; i += 1) {
+		free(categories->labels[i]);
+	}
+	free(categories->labels);
+	free(categories->ids);
+	free(categories->weights);
+	free(categories->segments);
+	free(categories);
+}
+
+static void NodeLinkColumnSetFree(NodeLinkColumnSet *set) {
+	for (size_t i = 0; i < set->count; i += 1) {
+		NodeLinkCategoriesFree(set->items[i]->categories);
+		free(set->items[i]->name);
+		free(set->items[i]);
+	}
+	if (set->lookup) {
+		CXStringDictionaryDestroy(set->lookup);
+	}
+	free(set->items);
+	free(set->coerced);
+	free(set->hints);
+	memset(set, 0, sizeof(*set));
+}
+
+static NodeLinkColumn* NodeLinkColumnFind(NodeLinkColumnSet *set, size_t position, const char *name) {
+	if (position < set->hintCapacity) {
+		NodeLinkColumn *hint = set->hints[position];
+		if (hint && strcmp(hint->name, name) == 0) {
+			return hint;
+		}
+	}
+	NodeLinkColumn *column = (NodeLinkColumn *)CXStringDictionaryEntryForKey(set->lookup, (CXString)name);
+	size_t hintCapacity = set->hintCapacity;
+	if (column && NodeLinkReserve((void **)&set->hints, &set->hintCapacity, position + 1, sizeof(NodeLinkColumn *))) {
+		memset(set->hints + hintCapacity, 0, (set->hintCapacity - hintCapacity) * sizeof(NodeLinkColumn *));
+		set->hints[position] = column;
+	}
+	return column;
+}
+
+static CXBool NodeLinkMarkCoerced(NodeLinkColumnSet *set, NodeLinkColumn *column) {
+	if (!NodeLinkReserve((void **)&set->coerced, &set->coercedCapacity, set->coercedCount + 1, sizeof(NodeLinkColumn *))) {
+		return CXFalse;
+	}
+	set->coerced[set->coercedCount++] = column;
+	return CXTrue;
+}
+
+static CXBool NodeLinkObserve(NodeLinkColumnSet *set, size_t position, const char *name, const NodeLinkValue *value, NodeLinkText *scratch) {
+	NodeLinkShape candidate;
+	if (!NodeLinkClassify(value, &candidate, scratch)) {
+		return CXTrue;
+	}
+	NodeLinkColumn *column = NodeLinkColumnFind(set, position, name);
+	if (!column) {
+		if (!NodeLinkReserve((void **)&set->items, &set->capacity, set->count + 1, sizeof(NodeLinkColumn *))) {
+			return CXFalse;
+		}
+		column = calloc(1, sizeof(NodeLinkColumn));
+		if (!column) {
+			return CXFalse;
+		}
+		column->name = CXNewStringFromString((CXString)name);
+		if (!column->name) {
+			free(column);
+			return CXFalse;
+		}
+		column->shape = candidate;
+		set->items[set->count++] = column;
+		CXStringDictionarySetEntry(set->lookup, column->name, column);
+		return candidate.mode != NodeLinkModeJSONString || NodeLinkMarkCoerced(set, column);
+	}
+	NodeLinkShape merged = NodeLinkMergeShape(column->shape, candidate);
+	if (merged.mode == NodeLinkModeJSONString && column->shape.mode != NodeLinkModeJSONString && !NodeLinkMarkCoerced(set, column)) {
+		return CXFalse;
+	}
+	column->shape = merged;
+	return CXTrue;
+}
+
+static CXBool NodeLinkRecordAppend(NodeLinkRecord *record, const NodeLinkValue *key, const NodeLinkValue *value) {
+	size_t offset = record->keys.length;
+	if (!NodeLinkDecodeString(key, &record->keys) || !NodeLinkTextPutChar(&record->keys, '\0')) {
+		return CXFalse;
+	}
+	if (!NodeLinkReserve((void **)&record->members, &record->capacity, record->count + 1, sizeof(NodeLinkMember))) {
+		return CXFalse;
+	}
+	NodeLinkMember *member = &record->members[record->count++];
+	member->keyOffset = offset;
+	member->shadowed = CXFalse;
+	member->value = *value;
+	return CXTrue;
+}
+
+static const char* NodeLinkMemberName(const NodeLinkRecord *record, const NodeLinkMember *member) {
+	return record->keys.data + member->keyOffset;
+}
+
+/* Flags members overridden by a later member with the same name, so each
+ * name keeps the value `JSON.parse` plus the `attributes` merge would. */
+static CXBool NodeLinkRecordShadow(NodeLinkReader *reader) {
+	NodeLinkRecord *record = &reader->record;
+	if (record->count < 2) {
+		return CXTrue;
+	}
+	if (record->count < NODE_LINK_SHADOW_DICTIONARY_MIN) {
+		for (size_t i = 0; i + 1 < record->count; i += 1) {
+			const char *name = NodeLinkMemberName(record, &record->members[i]);
+			for (size_t j = i + 1; j < record->count; j += 1) {
+				if (strcmp(name, NodeLinkMemberName(record, &record->members[j])) == 0) {
+					record->members[i].shadowed = CXTrue;
+					break;
+				}
+			}
+		}
+		return CXTrue;
+	}
+	if (!reader->shadow) {
+		reader->shadow = CXNewStringDictionary();
+		if (!reader->shadow) {
+			return CXFalse;
+		}
+	}
+	for (size_t i = record->count; i-- > 0;) {
+		const char *name = NodeLinkMemberName(record, &record->members[i]);
+		if (CXStringDictionaryEntryForKey(reader->shadow, (CXString)name)) {
+			record->members[i].shadowed = CXTrue;
+		} else {
+			CXStringDictionarySetEntry(reader->shadow, (CXString)name, (void *)(uintptr_t)1u);
+		}
+	}
+	CXStringDictionaryClear(reader->shadow);
+	return CXTrue;
+}
+
+/* Collects the members of one record object, merging its `attributes`. */
+static CXBool NodeLinkReadRecord(NodeLinkReader *reader, const NodeLinkValue *object, const char *const *reserved, size_t reservedCount) {
+	NodeLinkRecord *record = &reader->record;
+	record->count = 0;
+	record->keys.length = 0;
+	record->hasReserved[0] = CXFalse;
+	record->hasReserved[1] = CXFalse;
+	NodeLinkValue attributes = {0};
+	CXBool hasAttributes = CXFalse;
+
+	NodeLinkScanner scanner;
+	NodeLinkEnter(&scanner, object);
+	CXBool started = CXFalse;
+	NodeLinkValue key;
+	NodeLinkValue value;
+	int status;
+	while ((status = NodeLinkObjectNext(&scanner, &started, &key)) == 1) {
+		if (!NodeLinkScanValue(&scanner, &value)) {
+			return CXFalse;
+		}
+		CXBool handled = CXFalse;
+		for (size_t i = 0; i < reservedCount; i += 1) {
+			if (NodeLinkStringEquals(&key, reserved[i], &reader->text)) {
+				record->reserved[i] = value;
+				record->hasReserved[i] = CXTrue;
+				handled = CXTrue;
+				break;
+			}
+		}
+		if (handled) {
+			continue;
+		}
+		if (NodeLinkStringEquals(&key, "attributes", &reader->text)) {
+			attributes = value;
+			hasAttributes = CXTrue;
+			continue;
+		}
+		if (!NodeLinkRecordAppend(record, &key, &value)) {
+			return CXFalse;
+		}
+	}
+	if (status < 0) {
+		return CXFalse;
+	}
+	if (hasAttributes && attributes.kind == NodeLinkObject) {
+		NodeLinkEnter(&scanner, &attributes);
+		started = CXFalse;
+		while ((status = NodeLinkObjectNext(&scanner, &started, &key)) == 1) {
+			if (!NodeLinkScanValue(&scanner, &value) || !NodeLinkRecordAppend(record, &key, &value)) {
+				return CXFalse;
+			}
+		}
+		if (status < 0) {
+			return CXFalse;
+		}
+	}
+	return NodeLinkRecordShadow(reader);
+}
+
+static CXBool NodeLinkObserveRecord(NodeLinkReader *reader, NodeLinkColumnSet *set) {
+	NodeLinkRecord *record = &reader->record;
+	for (size_t i = 0; i < record->count; i += 1) {
+		NodeLinkMember *member = &record->members[i];
+		if (member->shadowed) {
+			continue;
+		}
+		if (!NodeLinkObserve(set, i, NodeLinkMemberName(record, member), &member->value, &reader->text)) {
+			return CXFalse;
+		}
+	}
+	return CXTrue;
+}
+
+/* Node id lookup key: strings are tagged "s", everything else is tagged "j"
+ * and spelled as compact JSON. The text after the tag is the display id. */
+static CXString NodeLinkIdKey(NodeLinkReader *reader, const NodeLinkValue *value) {
+	NodeLinkText key = {0};
+	CXBool ok = NodeLinkTextPutChar(&key, value->kind == NodeLinkString ? 's' : 'j');
+	if (ok) {
+		ok = value->kind == NodeLinkString
+			? NodeLinkDecodeString(value, &key)
+			: NodeLinkAppendCompact(&key, value, &reader->text);
+	}
+	if (!ok) {
+		free(key.data);
+		return NULL;
+	}
+	return key.data;
+}
+
+static CXBool NodeLinkAppendNodeKey(NodeLinkReader *reader, CXString key) {
+	if (!NodeLinkReserve((void **)&reader->nodeKeys, &reader->nodeCapacity, reader->nodeCount + 1, sizeof(CXString))) {
+		free(key);
+		return CXFalse;
+	}
+	reader->nodeKeys[reader->nodeCount++] = key;
+	return CXTrue;
+}
+
+static CXBool NodeLinkScanNodes(NodeLinkReader *reader, const NodeLinkValue *nodes) {
+	NodeLinkScanner scanner;
+	NodeLinkEnter(&scanner, nodes);
+	CXBool started = CXFalse;
+	NodeLinkValue item;
+	size_t position = 0;
+	for (; NodeLinkArrayNext(&scanner, &started) == 1 && NodeLinkScanValue(&scanner, &item); position += 1) {
+		if (item.kind != NodeLinkObject) {
+			CXNetworkSerializationWarningAppend("Node-link JSON skipped non-object node at position %zu", position);
+			continue;
+		}
+		if (!NodeLinkReadRecord(reader, &item, NodeLinkNodeReserved, 1)) {
+			return CXFalse;
+		}
+		CXString key = NULL;
+		if (!reader->record.hasReserved[0] || reader->record.reserved[0].kind == NodeLinkNull) {
+			key = CXNewStringFromFormat("s__helios_node_%zu", position);
+			CXNetworkSerializationWarningAppend("Node-link JSON synthesized an id for node at position %zu", position);
+		} else {
+			key = NodeLinkIdKey(reader, &reader->record.reserved[0]);
+		}
+		if (!key || !NodeLinkAppendNodeKey(reader, key)) {
+			return CXFalse;
+		}
+		if (!NodeLinkObserveRecord(reader, &reader->columns[CXAttributeScopeNode])) {
+			return CXFalse;
+		}
+	}
+
+	for (size_t i = 0; i < reader->nodeCount; i += 1) {
+		CXString key = reader->nodeKeys[i];
+		if (CXStringDictionaryEntryForKey(reader->nodeIds, key)) {
+			CXString replacement = NULL;
+			for (size_t suffix = 1;; suffix += 1) {
+				replacement = CXNewStringFromFormat("s%s#%zu", key + 1, suffix);
+				if (!replacement) {
+					return CXFalse;
+				}
+				if (!CXStringDictionaryEntryForKey(reader->nodeIds, replacement)) {
+					break;
+				}
+				free(replacement);
+			}
+			CXNetworkSerializationWarningAppend("Node-link JSON renamed duplicate node id %s to %s", key + 1, replacement + 1);
+			free(key);
+			reader->nodeKeys[i] = key = replacement;
+		}
+		CXStringDictionarySetEntry(reader->nodeIds, key, (void *)(uintptr_t)(i + 1u));
+	}
+	return CXTrue;
+}
+
+static CXBool NodeLinkResolveEndpoint(NodeLinkReader *reader, const NodeLinkValue *endpoint, CXUInteger *outPosition) {
+	CXString key = NodeLinkIdKey(reader, endpoint);
+	if (!key) {
+		return CXFalse;
+	}
+	void *entry = CXStringDictionaryEntryForKey(reader->nodeIds, key);
+	if (entry) {
+		*outPosition = (CXUInteger)((uintptr_t)entry - 1u);
+		free(key);
+		return CXTrue;
+	}
+	CXNetworkSerializationWarningAppend("Node-link JSON synthesized a node for missing endpoint %s", key + 1);
+	*outPosition = (CXUInteger)reader->nodeCount;
+	CXStringDictionarySetEntry(reader->nodeIds, key, (void *)(uintptr_t)(reader->nodeCount + 1u));
+	return NodeLinkAppendNodeKey(reader, key);
+}
+
+static CXBool NodeLinkLinkUsable(const NodeLinkRecord *record) {
+	return record->hasReserved[0] && record->reserved[0].kind != NodeLinkNull &&
+		record->hasReserved[1] && record->reserved[1].kind != NodeLinkNull;
+}
+
+static CXBool NodeLinkScanLinks(NodeLinkReader *reader, const NodeLinkValue *links) {
+	NodeLinkScanner scanner;
+	NodeLinkEnter(&scanner, links);
+	CXBool started = CXFalse;
+	NodeLinkValue item;
+	size_t position = 0;
+	for (; NodeLinkArrayNext(&scanner, &started) == 1 && NodeLinkScanValue(&scanner, &item); position += 1) {
+		if (item.kind != NodeLinkObject) {
+			CXNetworkSerializationWarningAppend("Node-link JSON skipped non-object link at position %zu", position);
+			continue;
+		}
+		if (!NodeLinkReadRecord(reader, &item, NodeLinkLinkReserved, 2)) {
+			return CXFalse;
+		}
+		if (!NodeLinkLinkUsable(&reader->record)) {
+			CXNetworkSerializationWarningAppend("Node-link JSON skipped link at position %zu because source/target is missing", position);
+			continue;
+		}
+		if (!NodeLinkReserve((void **)&reader->edges, &reader->edgeCapacity, reader->edgeCount + 1, sizeof(CXEdge))) {
+			return CXFalse;
+		}
+		CXEdge *edge = &reader->edges[reader->edgeCount];
+		if (!NodeLinkResolveEndpoint(reader, &reader->record.reserved[0], &edge->from) ||
+			!NodeLinkResolveEndpoint(reader, &reader->record.reserved[1], &edge->to)) {
+			return CXFalse;
+		}
+		reader->edgeCount += 1;
+		if (!NodeLinkObserveRecord(reader, &reader->columns[CXAttributeScopeEdge])) {
+			return CXFalse;
+		}
+	}
+	return CXTrue;
+}
+
+static CXBool NodeLinkDefineColumn(CXNetworkRef network, CXAttributeScope scope, NodeLinkColumn *column) {
+	if (column->shape.mode == NodeLinkModeMultiCategory) {
+		if (!CXNetworkDefineMultiCategoryAttribute(network, scope, column->name, column->shape.hasWeights)) {
+			return CXFalse;
+		}
+		column->categories = calloc(1, sizeof(NodeLinkCategories));
+		if (!column->categories) {
+			return CXFalse;
+		}
+		column->categories->labelIds = CXNewStringDictionary();
+		if (!column->categories->labelIds) {
+			return CXFalse;
+		}
+	} else {
+		CXBool ok = CXFalse;
+		if (scope == CXAttributeScopeNode) {
+			ok = CXNetworkDefineNodeAttribute(network, column->name, column->shape.type, column->shape.dimension);
+		} else if (scope == CXAttributeScopeEdge) {
+			ok = CXNetworkDefineEdgeAttribute(network, column->name, column->shape.type, column->shape.dimension);
+		} else {
+			ok = CXNetworkDefineNetworkAttribute(network, column->name, column->shape.type, column->shape.dimension);
+		}
+		if (!ok) {
+			return CXFalse;
+		}
+	}
+	if (scope == CXAttributeScopeNode) {
+		column->attr = CXNetworkGetNodeAttribute(network, column->name);
+	} else if (scope == CXAttributeScopeEdge) {
+		column->attr = CXNetworkGetEdgeAttribute(network, column->name);
+	} else {
+		column->attr = CXNetworkGetNetworkAttribute(network, column->name);
+	}
+	return column->attr != NULL;
+}
+
+static void NodeLinkStoreNumber(CXAttributeType type, void *slot, double number) {
+	switch (type) {
+		case CXUnsignedIntegerAttributeType:
+			*(uint32_t *)slot = (uint32_t)number;
+			break;
+		case CXIntegerAttributeType:
+			*(int32_t *)slot = (int32_t)number;
+			break;
+		default:
+			*(double *)slot = number;
+			break;
+	}
+}
+
+static CXBool NodeLinkCategoriesAdd(NodeLinkCategories *categories, const char *label, float weight) {
+	void *entry = CXStringDictionaryEntryForKey(categories->labelIds, (CXString)label);
+	uint32_t id = 0;
+	if (entry) {
+		id = (uint32_t)((uintptr_t)entry - 1u);
+	} else {
+		if (!NodeLinkReserve((void **)&categories->labels, &categories->labelCapacity, categories->labelCount + 1, sizeof(CXString))) {
+			return CXFalse;
+		}
+		CXString copy = CXNewStringFromString((CXString)label);
+		if (!copy) {
+			return CXFalse;
+		}
+		id = (uint32_t)categories->labelCount;
+		categories->labels[categories->labelCount++] = copy;
+		CXStringDictionarySetEntry(categories->labelIds, copy, (void *)(uintptr_t)(id + 1u));
+	}
+	if (categories->idCount == categories->idCapacity) {
+		size_t capacity = CXCapacityGrow(CXMAX(categories->idCapacity, (size_t)8));
+		uint32_t *ids = realloc(categories->ids, capacity * sizeof(uint32_t));
+		if (!ids) {
+			return CXFalse;
+		}
+		categories->ids = ids;
+		float *weights = realloc(categories->weights, capacity * sizeof(float));
+		if (!weights) {
+			return CXFalse;
+		}
+		categories->weights = weights;
+		categories->idCapacity = capacity;
+	}
+	categories->ids[categories->idCount] = id;
+	categories->weights[categories->idCount] = weight;
+	categories->idCount += 1;
+	return CXTrue;
+}
+
+static CXBool NodeLinkAssignCategories(NodeLinkReader *reader, NodeLinkColumn *column, CXIndex row, const NodeLinkValue *value) {
+	NodeLinkCategories *categories = column->categories;
+	size_t start = categories->idCount;
+	if (value->kind == NodeLinkArray) {
+		NodeLinkScanner scanner;
+		NodeLinkEnter(&scanner, value);
+		CXBool started = CXFalse;
+		NodeLinkValue item;
+		while (NodeLinkArrayNext(&scanner, &started) == 1 && NodeLinkScanValue(&scanner, &item)) {
+			NodeLinkValue label = item;
+			float weight = 1.0f;
+			if (column->shape.hasWeights) {
+				NodeLinkValue weightValue;
+				CXBool hasLabel = CXFalse;
+				CXBool hasWeight = CXFalse;
+				if (item.kind != NodeLinkObject) {
+					continue;
+				}
+				NodeLinkReadLabelObject(&item, &label, &hasLabel, &weightValue, &hasWeight, &reader->text);
+				if (!hasLabel || label.kind != NodeLinkString) {
+					continue;
+				}
+				if (hasWeight && weightValue.kind == NodeLinkNumber) {
+					weight = (float)weightValue.number;
+				}
+			} else if (item.kind != NodeLinkString) {
+				continue;
+			}
+			reader->text.length = 0;
+			if (!NodeLinkDecodeString(&label, &reader->text) ||
+				!NodeLinkCategoriesAdd(categories, reader->text.data, weight)) {
+				return CXFalse;
+			}
+		}
+	}
+	if (!NodeLinkReserve((void **)&categories->segments, &categories->segmentCapacity, categories->segmentCount + 1, sizeof(NodeLinkCategorySegment))) {
+		return CXFalse;
+	}
+	NodeLinkCategorySegment *segment = &categories->segments[categories->segmentCount++];
+	segment->row = row;
+	segment->start = start;
+	segment->count = categories->idCount - start;
+	return CXTrue;
+}
+
+static CXBool NodeLinkAssign(NodeLinkReader *reader, NodeLinkColumn *column, CXIndex row, const NodeLinkValue *value) {
+	CXAttributeRef attr = column->attr;
+	if (value->kind == NodeLinkNull || row >= attr->capacity) {
+		return CXTrue;
+	}
+	if (column->shape.mode == NodeLinkModeMultiCategory) {
+		return NodeLinkAssignCategories(reader, column, row, value);
+	}
+	uint8_t *slot = attr->data + (size_t)row * (size_t)attr->stride;
+	switch (column->shape.mode) {
+		case NodeLinkModeString:
+		case NodeLinkModeJSONString: {
+			reader->text.length = 0;
+			NodeLinkText compact = {0};
+			CXString text = NULL;
+			if (value->kind == NodeLinkString) {
+				if (!NodeLinkDecodeString(value, &reader->text)) {
+					return CXFalse;
+				}
+				text = CXNewStringFromString(reader->text.data);
+			} else {
+				if (!NodeLinkAppendCompact(&compact, value, &reader->text)) {
+					free(compact.data);
+					return CXFalse;
+				}
+				text = compact.data;
+			}
+			if (!text) {
+				return CXFalse;
+			}
+			free(*(CXString *)slot);
+			*(CXString *)slot = text;
+			return CXTrue;
+		}
+		case NodeLinkModeBoolean:
+			*slot = value->kind == NodeLinkTrue ? 1u : 0u;
+			return CXTrue;
+		case NodeLinkModeNumber:
+			NodeLinkStoreNumber(column->shape.type, slot, value->number);
+			return CXTrue;
+		case NodeLinkModeVector: {
+			NodeLinkScanner scanner;
+			NodeLinkEnter(&scanner, value);
+			CXBool started = CXFalse;
+			NodeLinkValue item;
+			CXSize component = 0;
+			while (component < column->shape.dimension && NodeLinkArrayNext(&scanner, &started) == 1 && NodeLinkScanValue(&scanner, &item)) {
+				double number = item.kind == NodeLinkNumber && isfinite(item.number) ? item.number : 0.0;
+				NodeLinkStoreNumber(column->shape.type, slot + component * attr->elementSize, number);
+				component += 1;
+			}
+			return CXTrue;
+		}
+		default:
+			return CXTrue;
+	}
+}
+
+static CXBool NodeLinkAssignRecord(NodeLinkReader *reader, NodeLinkColumnSet *set, CXIndex row) {
+	NodeLinkRecord *record = &reader->record;
+	for (size_t i = 0; i < record->count; i += 1) {
+		NodeLinkMember *member = &record->members[i];
+		if (member->shadowed) {
+			continue;
+		}
+		NodeLinkColumn *column = NodeLinkColumnFind(set, i, NodeLinkMemberName(record, member));
+		if (!column || column->skipped) {
+			continue;
+		}
+		if (!NodeLinkAssign(reader, column, row, &member->value)) {
+			return CXFalse;
+		}
+	}
+	return CXTrue;
+}
+
+static CXBool NodeLinkFinishCategories(CXNetworkRef network, CXAttributeScope scope, NodeLinkColumn *column) {
+	NodeLinkCategories *categories = column->categories;
+	CXSize rows = column->attr->capacity;
+	uint32_t *offsets = calloc((size_t)rows + 1u, sizeof(uint32_t));
+	uint32_t *ids = malloc(CXMAX(categories->idCount, (size_t)1) * sizeof(uint32_t));
+	float *weights = malloc(CXMAX(categories->idCount, (size_t)1) * sizeof(float));
+	CXBool ok = offsets && ids && weights;
+	for (size_t i = 0; ok && i < categories->segmentCount; i += 1) {
+		offsets[categories->segments[i].row + 1] = (uint32_t)categories->segments[i].count;
+	}
+	for (CXSize row = 0; ok && row < rows; row += 1) {
+		offsets[row + 1] += offsets[row];
+	}
+	for (size_t i = 0; ok && i < categories->segmentCount; i += 1) {
+		const NodeLinkCategorySegment *segment = &categories->segments[i];
+		memcpy(ids + offsets[segment->row], categories->ids + segment->start, segment->count * sizeof(uint32_t));
+		memcpy(weights + offsets[segment->row], categories->weights + segment->start, segment->count * sizeof(float));
+	}
+	if (ok && categories->labelCount > 0) {
+		ok = CXNetworkSetAttributeCategoryDictionary(network, scope, column->name, categories->labels, NULL, (CXSize)categories->labelCount, CXFalse);
+	}
+	if (ok) {
+		ok = CXNetworkSetMultiCategoryBuffers(network, scope, column->name, offsets, rows + 1, ids, (CXSize)categories->idCount,
+			column->shape.hasWeights ? weights : NULL);
+	}
+	free(offsets);
+	free(ids);
+	free(weights);
+	return ok;
+}
+
+static CXBool NodeLinkAssignNodes(NodeLinkReader *reader, const NodeLinkValue *nodes, const CXIndex *nodeIndices) {
+	NodeLinkScanner scanner;
+	NodeLinkEnter(&scanner, nodes);
+	CXBool started = CXFalse;
+	NodeLinkValue item;
+	size_t row = 0;
+	while (NodeLinkArrayNext(&scanner, &started) == 1 && NodeLinkScanValue(&scanner, &item)) {
+		if (item.kind != NodeLinkObject) {
+			continue;
+		}
+		if (!NodeLinkReadRecord(reader, &item, NodeLinkNodeReserved, 1) ||
+			!NodeLinkAssignRecord(reader, &reader->columns[CXAttributeScopeNode], nodeIndices[row])) {
+			return CXFalse;
+		}
+		row += 1;
+	}
+	return CXTrue;
+}
+
+static CXBool NodeLinkAssignLinks(NodeLinkReader *reader, const NodeLinkValue *links, const CXIndex *edgeIndices) {
+	NodeLinkScanner scanner;
+	NodeLinkEnter(&scanner, links);
+	CXBool started = CXFalse;
+	NodeLinkValue item;
+	size_t row = 0;
+	while (NodeLinkArrayNext(&scanner, &started) == 1 && NodeLinkScanValue(&scanner, &item)) {
+		if (item.kind != NodeLinkObject) {
+			continue;
+		}
+		if (!NodeLinkReadRecord(reader, &item, NodeLinkLinkReserved, 2)) {
+			return CXFalse;
+		}
+		if (!NodeLinkLinkUsable(&reader->record)) {
+			continue;
+		}
+		if (!NodeLinkAssignRecord(reader, &reader->columns[CXAttributeScopeEdge], edgeIndices[row])) {
+			return CXFalse;
+		}
+		row += 1;
+	}
+	return CXTrue;
+}
+
+static CXBool NodeLinkTruthy(const NodeLinkValue *value) {
+	switch (value->kind) {
+		case NodeLinkNull:
+		case NodeLinkFalse:
+			return CXFalse;
+		case NodeLinkNumber:
+			return value->number != 0.0 && !isnan(value->number);
+		case NodeLinkString:
+			return value->end > value->start;
+		default:
+			return CXTrue;
+	}
+}
+
+static CXBool NodeLinkScanDocument(NodeLinkReader *reader, NodeLinkScanner *scanner) {
+	NodeLinkDocument *document = &reader->document;
+	NodeLinkSkipSpace(scanner);
+	if (scanner->cursor >= scanner->end || *scanner->cursor != '{') {
+		reader->error = CXNewStringFromString("Node-link JSON root must be an object");
+		return CXFalse;
+	}
+	scanner->depth = 1;
+	scanner->cursor += 1;
+	CXBool started = CXFalse;
+	NodeLinkValue key;
+	NodeLinkValue value;
+	int status;
+	while ((status = NodeLinkObjectNext(scanner, &started, &key)) == 1) {
+		if (!NodeLinkScanValue(scanner, &value)) {
+			return CXFalse;
+		}
+		reader->text.length = 0;
+		if (!NodeLinkDecodeString(&key, &reader->text)) {
+			return CXFalse;
+		}
+		const char *name = reader->text.data;
+		if (strcmp(name, "directed") == 0) {
+			document->directed = value;
+			document->hasDirected = CXTrue;
+		} else if (strcmp(name, "nodes") == 0) {
+			document->nodes = value;
+			document->hasNodes = CXTrue;
+		} else if (strcmp(name, "links") == 0) {
+			document->links = value;
+			document->hasLinks = CXTrue;
+		} else if (strcmp(name, "edges") == 0) {
+			document->edges = value;
+			document->hasEdges = CXTrue;
+		} else if (strcmp(name, "graph") == 0) {
+			document->graph = value;
+			document->hasGraph = CXTrue;
+		} else if (strcmp(name, "network") == 0) {
+			document->network = value;
+			document->hasNetwork = CXTrue;
+		}
+	}
+	if (status < 0) {
+		return CXFalse;
+	}
+	NodeLinkSkipSpace(scanner);
+	if (scanner->cursor != scanner->end) {
+		return NodeLinkFail(scanner, "unexpected data after the root object");
+	}
+	return CXTrue;
+}
+
+static void NodeLinkReaderFree(NodeLinkReader *reader) {
+	free(reader->record.members);
+	free(reader->record.keys.data);
+	free(reader->text.data);
+	if (reader->shadow) {
+		CXStringDictionaryDestroy(reader->shadow);
+	}
+	if (reader->nodeIds) {
+		CXStringDictionaryDestroy(reader->nodeIds);
+	}
+	for (size_t i = 0; i < reader->nodeCount; i += 1) {
+		free(reader->nodeKeys[i]);
+	}
+	free(reader->nodeKeys);
+	free(reader->edges);
+	for (size_t i = 0; i < 3; i += 1) {
+		NodeLinkColumnSetFree(&reader->columns[i]);
+	}
+	free(reader->error);
+}
+
+static void NodeLinkWarnCoerced(const NodeLinkColumnSet *set) {
+	for (size_t i = 0; i < set->coercedCount; i += 1) {
+		CXNetworkSerializationWarningAppend("Node-link JSON coerced attribute \"%s\" to a string payload during load", set->coerced[i]->name);
+	}
+}
+
+static CXNetworkRef NodeLinkLoad(NodeLinkReader *reader, const char *data, size_t size) {
+	NodeLinkScanner scanner;
+	NodeLinkScannerInit(&scanner, data, data + size);
+	CXNetworkRef network = NULL;
+	CXIndex *nodeIndices = NULL;
+	CXIndex *edgeIndices = NULL;
+	const NodeLinkDocument *document = &reader->document;
+	const NodeLinkValue *links = NULL;
+	const NodeLinkValue *graph = NULL;
+
+	if (!NodeLinkScanDocument(reader, &scanner)) {
+		goto fail;
+	}
+	if (document->hasNodes && document->nodes.kind != NodeLinkNull && document->nodes.kind != NodeLinkArray) {
+		reader->error = CXNewStringFromString("Node-link JSON \"nodes\" must be an array when present");
+		goto fail;
+	}
+	if (document->hasLinks && document->links.kind != NodeLinkNull) {
+		links = &document->links;
+	} else if (document->hasEdges && document->edges.kind != NodeLinkNull) {
+		links = &document->edges;
+	}
+	if (links && links->kind != NodeLinkArray) {
+		reader->error = CXNewStringFromString("Node-link JSON \"links\" or \"edges\" must be an array when present");
+		goto fail;
+	}
+
+	for (size_t i = 0; i < 3; i += 1) {
+		reader->columns[i].scope = (CXAttributeScope)i;
+		reader->columns[i].lookup = CXNewStringDictionary();
+		if (!reader->columns[i].lookup) {
+			goto fail;
+		}
+	}
+	reader->nodeIds = CXNewStringDictionary();
+	if (!reader->nodeIds) {
+		goto fail;
+	}
+	if (document->hasNodes && document->nodes.kind == NodeLinkArray && !NodeLinkScanNodes(reader, &document->nodes)) {
+		goto fail;
+	}
+	if (links && !NodeLinkScanLinks(reader, links)) {
+		goto fail;
+	}
+
+	if (document->hasGraph && document->graph.kind == NodeLinkObject) {
+		graph = &document->graph;
+	} else if (document->hasNetwork && document->network.kind == NodeLinkObject) {
+		graph = &document->network;
+	}
+	if (document->hasGraph && document->graph.kind != NodeLinkObject) {
+		CXNetworkSerializationWarningAppend("Node-link JSON ignored top-level \"graph\" because it is not an object");
+	}
+	if (document->hasNetwork && document->network.kind != NodeLinkObject) {
+		CXNetworkSerializationWarningAppend("Node-link JSON ignored top-level \"network\" because it is not an object");
+	}
+	if (graph && (!NodeLinkReadRecord(reader, graph, NULL, 0) ||
+		!NodeLinkObserveRecord(reader, &reader->columns[CXAttributeScopeNetwork]))) {
+		goto fail;
+	}
+
+	NodeLinkWarnCoerced(&reader->columns[CXAttributeScopeNode]);
+	NodeLinkWarnCoerced(&reader->columns[CXAttributeScopeEdge]);
+	NodeLinkWarnCoerced(&reader->columns[CXAttributeScopeNetwork]);
+	NodeLinkColumn *reservedIds = (NodeLinkColumn *)CXStringDictionaryEntryForKey(reader->columns[CXAttributeScopeNode].lookup, "_original_ids_");
+	if (reservedIds) {
+		reservedIds->skipped = CXTrue;
+		CXNetworkSerializationWarningAppend("Node-link JSON reserved \"_original_ids_\" during load and replaced the input payload with imported node ids");
+	}
+
+	network = CXNewNetworkWithCapacity(
+		document->hasDirected && NodeLinkTruthy(&document->directed),
+		reader->nodeCount > 0 ? reader->nodeCount : 1,
+		reader->edgeCount > 0 ? reader->edgeCount : 1
+	);
+	if (!network) {
+		goto fail;
+	}
+	nodeIndices = calloc(CXMAX(reader->nodeCount, (size_t)1), sizeof(CXIndex));
+	if (!nodeIndices || (reader->nodeCount > 0 && !CXNetworkAddNodes(network, (CXSize)reader->nodeCount, nodeIndices))) {
+		goto fail;
+	}
+	if (reader->edgeCount > 0) {
+		for (size_t i = 0; i < reader->edgeCount; i += 1) {
+			reader->edges[i].from = (CXUInteger)nodeIndices[reader->edges[i].from];
+			reader->edges[i].to = (CXUInteger)nodeIndices[reader->edges[i].to];
+		}
+		edgeIndices = calloc(reader->edgeCount, sizeof(CXIndex));
+		if (!edgeIndices || !CXNetworkAddEdges(network, reader->edges, (CXSize)reader->edgeCount, edgeIndices)) {
+			goto fail;
+		}
+	}
+
+	for (size_t scope = 0; scope < 3; scope += 1) {
+		NodeLinkColumnSet *set = &reader->columns[scope];
+		for (size_t i = 0; i < set->count; i += 1) {
+			if (!set->items[i]->skipped && !NodeLinkDefineColumn(network, (CXAttributeScope)scope, set->items[i])) {
+				goto fail;
+			}
+		}
+	}
+	if (document->hasNodes && document->nodes.kind == NodeLinkArray && !NodeLinkAssignNodes(reader, &document->nodes, nodeIndices)) {
+		goto fail;
+	}
+	if (links && !NodeLinkAssignLinks(reader, links, edgeIndices)) {
+		goto fail;
+	}
+	if (graph && (!NodeLinkReadRecord(reader, graph, NULL, 0) ||
+		!NodeLinkAssignRecord(reader, &reader->columns[CXAttributeScopeNetwork], 0))) {
+		goto fail;
+	}
+	for (size_t scope = 0; scope < 3; scope += 1) {
+		NodeLinkColumnSet *set = &reader->columns[scope];
+		for (size_t i = 0; i < set->count; i += 1) {
+			if (set->items[i]->categories && !NodeLinkFinishCategories(network, (CXAttributeScope)scope, set->items[i])) {
+				goto fail;
+			}
+		}
+	}
+
+	if (!CXNetworkDefineNodeAttribute(network, "_original_ids_", CXStringAttributeType, 1)) {
+		goto fail;
+	}
+	CXString *originalIds = (CXString *)CXNetworkGetNodeAttributeBuffer(network, "_original_ids_");
+	if (!originalIds) {
+		goto fail;
+	}
+	for (size_t i = 0; i < reader->nodeCount; i += 1) {
+		originalIds[nodeIndices[i]] = CXNewStringFromString(reader->nodeKeys[i] + 1);
+		if (!originalIds[nodeIndices[i]]) {
+			goto fail;
+		}
+	}
+
+	free(nodeIndices);
+	free(edgeIndices);
+	return network;
+
+fail:
+	if (scanner.error) {
+		free(reader->error);
+		reader->error = CXNewStringFromFormat("Node-link JSON parse error at byte %zu: %s",
+			(size_t)(scanner.errorAt - scanner.begin), scanner.error);
+	}
+	if (network) {
+		CXFreeNetwork(network);
+	}
+	free(nodeIndices);
+	free(edgeIndices);
+	return NULL;
+}
+
+CXNetworkRef CXNetworkReadNodeLinkJSON(const char *path) {
+	CXNetworkSerializationWarningClear();
+	if (!path) {
+		errno = EINVAL;
+		return NULL;
+	}
+	NodeLinkInput input = {0};
+	if (!NodeLinkInputOpen(&input, path)) {
+		return NULL;
+	}
+	NodeLinkReader reader;
+	memset(&reader, 0, sizeof(reader));
+	CXNetworkRef network = NodeLinkLoad(&reader, input.data, input.size);
+	if (!network) {
+		if (reader.error) {
+			// Warnings gathered before the failure describe a load that did
+			// not happen; report only the reason it stopped.
+			CXNetworkSerializationWarningClear();
+			CXNetworkSerializationWarningAppend("%s", reader.error);
+			errno = EINVAL;
+		} else {
+			errno = ENOMEM;
+		}
+	}
+	NodeLinkReaderFree(&reader);
+	NodeLinkInputClose(&input);
+	return network;
+}
@@ -92,6 +92,24 @@ typedef enum {
 	CXQueryAccessDot
 } CXQueryAccessMode;
 
+typedef enum {
+	CXQueryKernelGeneric = 0,
+	CXQueryKernelNumeric,
+	CXQueryKernelAccessor, /* reducing accessor compared like a numeric column */
+	CXQueryKernelNever
+} CXQueryKernel;
+
+/* What a regex predicate can decide from its literal text alone, see
+ * CXQueryAnalyzeRegex. */
+typedef enum {
+	CXQueryLiteralNone = 0, /* no required literal, regexec decides */
+	CXQueryLiteralFilter,   /* the literal must occur, regexec decides */
+	CXQueryLiteralContains, /* the whole pattern is the literal */
+	CXQueryLiteralPrefix,   /* ^literal */
+	CXQueryLiteralSuffix,   /* literal$ */
+	CXQueryLiteralEquals    /* ^literal$ */
+} CXQueryLiteralMatch;
+
 typedef struct {
 	char *name;
 	CXQueryQualifier qualifier;
@@ -111,8 +129,16 @@ typedef struct {
 	char *regexPattern;
 	regex_t regex;
 	CXBool regexCompiled;
+	char *regexLiteral;
+	size_t regexLiteralLength;
+	CXQueryLiteralMatch regexLiteralMatch;
+	uint8_t *labelMatches; /* categorical regex: one flag per id + 1 */
+	CXSize labelMatchCount;
 	CXAttributeRef attribute;
 	CXAttributeScope scope;
+	CXQueryKernel kernel;
+	double kernelTarget;
+	uint64_t *nodeBits; /* endpoint/neighbour qualifiers: node bitmap, set during a run */
 } CXQueryPredicate;
 
 typedef enum {
@@ -887,6 +913,8 @@ static void CXQueryFreeExpr(CXQueryExpr *expr) {
 			if (expr->data.predicate.regexCompiled) {
 				regfree(&expr->data.predicate.regex);
 			}
+			free(expr->data.predicate.regexLiteral);
+			free(expr->data.predicate.labelMatches);
 			break;
 		case CXQueryExprNot:
 			CXQueryFreeExpr(expr->data.notExpr.expr);
@@ -973,6 +1001,206 @@ static CXBool CXQueryResolveAttributeByName(CXNetworkRef network, CXAttributeSco
 	return CXTrue;
 }
 
+static CXBool CXQueryRegexIsSpecial(char c) {
+	return c != '\0' && strchr(".[]()*+?{}|^$\\", c) != NULL;
+}
+
+/* Returns the position after the bracket expression opened at `i`, or 0 when
+ * it is not terminated. */
+static size_t CXQueryRegexSkipBracket(const char *pattern, size_t i) {
+	i++;
+	if (pattern[i] == '^') {
+		i++;
+	}
+	if (pattern[i] == ']') {
+		i++;
+	}
+	while (pattern[i] && pattern[i] != ']') {
+		if (pattern[i] == '[' && (pattern[i + 1] == ':' || pattern[i + 1] == '=' || pattern[i + 1] == '.')) {
+			char kind = pattern[i + 1];
+			i += 2;
+			while (pattern[i] && !(pattern[i] == kind && pattern[i + 1] == ']')) {
+				i++;
+			}
+			if (!pattern[i]) {
+				return 0;
+			}
+			i += 2;
+			continue;
+		}
+		i++;
+	}
+	return pattern[i] ? i + 1 : 0;
+}
+
+/* Returns the position after the group opened at `i`, or 0 when it is not
+ * closed. */
+static size_t CXQueryRegexSkipGroup(const char *pattern, size_t i) {
+	size_t depth = 0;
+	while (pattern[i]) {
+		if (pattern[i] == '\\') {
+			if (!pattern[i + 1]) {
+				return 0;
+			}
+			i += 2;
+			continue;
+		}
+		if (pattern[i] == '[') {
+			i = CXQueryRegexSkipBracket(pattern, i);
+			if (!i) {
+				return 0;
+			}
+			continue;
+		}
+		if (pattern[i] == '(') {
+			depth++;
+		} else if (pattern[i] == ')' && --depth == 0) {
+			return i + 1;
+		}
+		i++;
+	}
+	return 0;
+}
+
+/* Drops the last character of a literal run, with all its UTF-8 bytes. */
+static size_t CXQueryRegexDropLastChar(const char *run, size_t length) {
+	while (length > 0 && ((unsigned char)run[length - 1] & 0xC0u) == 0x80u) {
+		length--;
+	}
+	return length > 0 ? length - 1 : 0;
+}
+
+static void CXQueryRegexKeepLongest(char *best, size_t *bestLength, const char *run, size_t runLength) {
+	if (runLength > *bestLength) {
+		memcpy(best, run, runLength);
+		*bestLength = runLength;
+	}
+}
+
+/* Finds the longest literal every match of the pattern has to contain, and
+ * whether the pattern is nothing but that literal (optionally anchored), in
+ * which case string comparisons replace regexec altogether. Runs after a
+ * successful regcomp; whatever it does not recognise only shortens or drops the
+ * literal. Returns CXFalse when out of memory. */
+static CXBool CXQueryAnalyzeRegex(CXQueryPredicate *pred) {
+	const char *pattern = pred->regexPattern;
+	size_t length = strlen(pattern);
+	char *run = malloc(length + 1);
+	char *best = malloc(length + 1);
+	if (!run || !best) {
+		free(run);
+		free(best);
+		return CXFalse;
+	}
+	size_t runLength = 0;
+	size_t bestLength = 0;
+	CXBool pure = CXTrue;
+	CXBool alternation = CXFalse;
+	CXBool lastLiteral = CXFalse;
+	CXBool anchoredStart = pattern[0] == '^';
+	CXBool anchoredEnd = CXFalse;
+	size_t i = anchoredStart ? 1 : 0;
+	while (pattern[i]) {
+		char c = pattern[i];
+		if (c == '\\' && CXQueryRegexIsSpecial(pattern[i + 1])) {
+			run[runLength++] = pattern[i + 1];
+			lastLiteral = CXTrue;
+			i += 2;
+			continue;
+		}
+		if (!CXQueryRegexIsSpecial(c)) {
+			run[runLength++] = c;
+			lastLiteral = CXTrue;
+			i++;
+			continue;
+		}
+		if (c == '|') {
+			/* Top level alternation: no single literal is required. */
+			alternation = CXTrue;
+			break;
+		}
+		if (c == '$' && pattern[i + 1] == '\0') {
+			anchoredEnd = CXTrue;
+			break;
+		}
+		pure = CXFalse;
+		if ((c == '*' || c == '?' || c == '{') && lastLiteral) {
+			/* The quantified character may be absent. */
+			runLength = CXQueryRegexDropLastChar(run, runLength);
+		}
+		CXQueryRegexKeepLongest(best, &bestLength, run, runLength);
+		runLength = 0;
+		lastLiteral = CXFalse;
+		if (c == '[') {
+			i = CXQueryRegexSkipBracket(pattern, i);
+		} else if (c == '(') {
+			i = CXQueryRegexSkipGroup(pattern, i);
+		} else if (c == '{') {
+			const char *close = strchr(pattern + i, '}');
+			i = close ? (size_t)(close - pattern) + 1 : 0;
+		} else if (c == '\\') {
+			i += 2;
+		} else {
+			i++;
+		}
+		if (!i) {
+			alternation = CXTrue;
+			break;
+		}
+	}
+	free(pred->regexLiteral);
+	pred->regexLiteral = NULL;
+	pred->regexLiteralLength = 0;
+	pred->regexLiteralMatch = CXQueryLiteralNone;
+	if (!alternation) {
+		if (pure) {
+			CXQueryRegexKeepLongest(best, &bestLength, run, runLength);
+			pred->regexLiteralMatch = anchoredStart
+				? (anchoredEnd ? CXQueryLiteralEquals : CXQueryLiteralPrefix)
+				: (anchoredEnd ? CXQueryLiteralSuffix : CXQueryLiteralContains);
+		} else {
+			CXQueryRegexKeepLongest(best, &bestLength, run, runLength);
+			pred->regexLiteralMatch = bestLength > 0 ? CXQueryLiteralFilter : CXQueryLiteralNone;
+		}
+	}
+	free(run);
+	if (pred->regexLiteralMatch == CXQueryLiteralNone) {
+		free(best);
+		return CXTrue;
+	}
+	best[bestLength] = '\0';
+	pred->regexLiteral = best;
+	pred->regexLiteralLength = bestLength;
+	return CXTrue;
+}
+
+static CXBool CXQueryRegexMatches(const CXQueryPredicate *pred, const char *value) {
+	const char *literal = pred->regexLiteral;
+	size_t length = pred->regexLiteralLength;
+	switch (pred->regexLiteralMatch) {
+		case CXQueryLiteralContains:
+			return strstr(value, literal) != NULL ? CXTrue : CXFalse;
+		case CXQueryLiteralPrefix:
+			return strncmp(value, literal, length) == 0 ? CXTrue : CXFalse;
+		case CXQueryLiteralSuffix: {
+			size_t valueLength = strlen(value);
+			return valueLength >= length && memcmp(value + valueLength - length, literal, length) == 0 ? CXTrue : CXFalse;
+		}
+		case CXQueryLiteralEquals:
+			return strcmp(value, literal) == 0 ? CXTrue : CXFalse;
+		case CXQueryLiteralFilter:
+			/* strstr scans with word-at-a-time/SIMD loops in the usual libcs,
+			 * far cheaper than starting the matcher on every row. */
+			if (!strstr(value, literal)) {
+				return CXFalse;
+			}
+			break;
+		default:
+			break;
+	}
+	return regexec(&pred->regex, value, 0, NULL, 0) == 0 ? CXTrue : CXFalse;
+}
+
 static CXBool CXQueryBindAttributes(CXNetworkRef network, CXQueryExpr *expr, CXAttributeScope selfScope, const char **outError) {
 	if (!expr) {
 		return CXTrue;
@@ -1000,8 +1228,10 @@ static CXBool CXQueryBindAttributes(CXNetworkRef network, CXQueryExpr *expr, CXA
 				return CXFalse;
 			}
 			if (pred->op == CXQueryOpRegex) {
-				if (pred->attribute->type != CXStringAttributeType) {
-					*outError = "Regex queries are only supported for string attributes";
+				if (pred->attribute->type != CXStringAttributeType &&
+					pred->attribute->type != CXDataAttributeCategoryType &&
+					pred->attribute->type != CXDataAttributeMultiCategoryType) {
+					*outError = "Regex queries are only supported for string and categorical attributes";
 					return CXFalse;
 				}
 				if (!pred->regexPattern) {
@@ -1013,6 +1243,10 @@ static CXBool CXQueryBindAttributes(CXNetworkRef network, CXQueryExpr *expr, CXA
 					return CXFalse;
 				}
 				pred->regexCompiled = CXTrue;
+				if (!CXQueryAnalyzeRegex(pred)) {
+					*outError = "Out of memory";
+					return CXFalse;
+				}
 			}
 			if (pred->op == CXQueryOpIn && pred->valueType == CXQueryValueList) {
 				if (pred->attribute->type == CXStringAttributeType) {
@@ -1020,7 +1254,8 @@ static CXBool CXQueryBindAttributes(CXNetworkRef network, CXQueryExpr *expr, CXA
 						*outError = "IN list cannot be empty";
 						return CXFalse;
 					}
-				} else if (pred->attribute->type == CXDataAttributeCategoryType) {
+				} else if (pred->attribute->type == CXDataAttributeCategoryType ||
+					pred->attribute->type == CXDataAttributeMultiCategoryType) {
 					if (!pred->stringList || pred->listCount == 0) {
 						*outError = "IN list cannot be empty";
 						return CXFalse;
@@ -1130,21 +1365,33 @@ static const char *CXQueryGetStringValueAt(CXAttributeRef attr, CXIndex index, C
 	return NULL;
 }
 
-static int CXQueryCompareDouble(const void *lhs, const void *rhs);
+/* Looks up a category id in the per-label regex results. */
+static inline CXBool CXQueryLabelMatches(const CXQueryPredicate *pred, double id) {
+	return id >= -1.0 && id + 1.0 < (double)pred->labelMatchCount && pred->labelMatches[(size_t)(id + 1.0)]
+		? CXTrue
+		: CXFalse;
+}
+
 static CXBool CXQueryComputeNumericAccessor(const CXQueryPredicate *predicate, CXIndex index, double *outValue);
 static CXBool CXQueryComparePredicateAt(CXQueryPredicate *predicate, CXIndex index, CXSize dim) {
 	if (!predicate || !predicate->attribute) {
 		return CXFalse;
 	}
 	if (predicate->op == CXQueryOpRegex) {
-		if (predicate->attribute->type != CXStringAttributeType || !predicate->regexCompiled) {
+		if (!predicate->regexCompiled) {
 			return CXFalse;
 		}
+		if (predicate->attribute->type == CXDataAttributeCategoryType) {
+			double id = 0.0;
+			return CXQueryGetNumericValueAt(predicate->attribute, index, dim, &id) && CXQueryLabelMatches(predicate, id)
+				? CXTrue
+				: CXFalse;
+		}
 		const char *value = CXQueryGetStringValueAt(predicate->attribute, index, dim);
 		if (!value) {
 			return CXFalse;
 		}
-		return regexec(&predicate->regex, value, 0, NULL, 0) == 0 ? CXTrue : CXFalse;
+		return CXQueryRegexMatches(predicate, value);
 	}
 	if (predicate->op == CXQueryOpIn && predicate->valueType == CXQueryValueList) {
 		if (predicate->attribute->type == CXStringAttributeType && predicate->stringList) {
@@ -1227,45 +1474,187 @@ static CXBool CXQueryComparePredicateAt(CXQueryPredicate *predicate, CXIndex ind
 	}
 }
 
-static CXBool CXQueryComputeNumericAccessor(const CXQueryPredicate *predicate, CXIndex index, double *outValue) {
-	if (!predicate || !predicate->attribute || !outValue) {
+#define CX_QUERY_LOAD_ROW(type, convert) do { \
+	const type *components = (const type *)base; \
+	for (CXSize dim = 0; dim < dimension; dim++) { \
+		out[dim] = convert(components[dim]); \
+	} \
+} while (0)
+
+#define CX_QUERY_AS_DOUBLE(value) ((double)(value))
+#define CX_QUERY_AS_FLAG(value) ((value) ? 1.0 : 0.0)
+
+/* Converts the `dimension` components of one row to doubles. */
+static CXBool CXQueryLoadRow(CXAttributeRef attr, CXIndex index, CXSize dimension, double *out) {
+	if (!attr->data || index >= attr->capacity) {
 		return CXFalse;
 	}
+	const uint8_t *base = attr->data + (size_t)index * attr->stride;
+	switch (attr->type) {
+		case CXBooleanAttributeType:
+			CX_QUERY_LOAD_ROW(uint8_t, CX_QUERY_AS_FLAG);
+			return CXTrue;
+		case CXFloatAttributeType:
+			CX_QUERY_LOAD_ROW(float, CX_QUERY_AS_DOUBLE);
+			return CXTrue;
+		case CXDoubleAttributeType:
+			CX_QUERY_LOAD_ROW(double, CX_QUERY_AS_DOUBLE);
+			return CXTrue;
+		case CXIntegerAttributeType:
+		case CXDataAttributeCategoryType:
+			CX_QUERY_LOAD_ROW(int32_t, CX_QUERY_AS_DOUBLE);
+			return CXTrue;
+		case CXUnsignedIntegerAttributeType:
+			CX_QUERY_LOAD_ROW(uint32_t, CX_QUERY_AS_DOUBLE);
+			return CXTrue;
+		case CXBigIntegerAttributeType:
+			CX_QUERY_LOAD_ROW(int64_t, CX_QUERY_AS_DOUBLE);
+			return CXTrue;
+		case CXUnsignedBigIntegerAttributeType:
+			CX_QUERY_LOAD_ROW(uint64_t, CX_QUERY_AS_DOUBLE);
+			return CXTrue;
+		default:
+			return CXFalse;
+	}
+}
+
+#undef CX_QUERY_LOAD_ROW
+#undef CX_QUERY_AS_DOUBLE
+#undef CX_QUERY_AS_FLAG
+
+static inline void CXQuerySortPair(double *a, double *b) {
+	if (*b < *a) {
+		double swap = *a;
+		*a = *b;
+		*b = swap;
+	}
+}
+
+static inline void CXQuerySwap(double *values, int64_t a, int64_t b) {
+	double swap = values[a];
+	values[a] = values[b];
+	values[b] = swap;
+}
+
+/* Rearranges `values` so that `values[k]` holds the k-th smallest value, with
+ * no larger value before it (quickselect, three-way partition). */
+static double CXQuerySelectKth(double *values, CXSize count, CXSize k) {
+	int64_t left = 0;
+	int64_t right = (int64_t)count - 1;
+	while (left < right) {
+		double a = values[left];
+		double b = values[left + (right - left) / 2];
+		double c = values[right];
+		CXQuerySortPair(&a, &b);
+		CXQuerySortPair(&b, &c);
+		CXQuerySortPair(&a, &b);
+		double pivot = b;
+		int64_t lt = left;
+		int64_t gt = right;
+		int64_t i = left;
+		while (i <= gt) {
+			if (values[i] < pivot) {
+				CXQuerySwap(values, lt++, i++);
+			} else if (values[i] > pivot) {
+				CXQuerySwap(values, i, gt--);
+			} else {
+				i++;
+			}
+		}
+		if ((int64_t)k < lt) {
+			right = lt - 1;
+		} else if ((int64_t)k > gt) {
+			left = gt + 1;
+		} else {
+			return values[k];
+		}
+	}
+	return values[k];
+}
+
+#define CX_QUERY_MEDIAN_SORT_LIMIT 16u
+
+/* Median of `count` loaded components; reorders them. Same value as sorting
+ * and averaging the middle pair, without the sort. */
+static double CXQueryMedian(double *values, CXSize count) {
+	switch (count) {
+		case 1:
+			return values[0];
+		case 2:
+			return (values[0] + values[1]) / 2.0;
+		case 3:
+			CXQuerySortPair(&values[0], &values[1]);
+			CXQuerySortPair(&values[1], &values[2]);
+			CXQuerySortPair(&values[0], &values[1]);
+			return values[1];
+		case 4:
+			CXQuerySortPair(&values[0], &values[1]);
+			CXQuerySortPair(&values[2], &values[3]);
+			CXQuerySortPair(&values[0], &values[2]);
+			CXQuerySortPair(&values[1], &values[3]);
+			CXQuerySortPair(&values[1], &values[2]);
+			return (values[1] + values[2]) / 2.0;
+		default:
+			break;
+	}
+	CXSize mid = count / 2;
+	if (count <= CX_QUERY_MEDIAN_SORT_LIMIT) {
+		/* Short vectors: an insertion sort beats partitioning. */
+		for (CXSize i = 1; i < count; i++) {
+			double value = values[i];
+			CXSize j = i;
+			while (j > 0 && value < values[j - 1]) {
+				values[j] = values[j - 1];
+				j--;
+			}
+			values[j] = value;
+		}
+		return count % 2 != 0 ? values[mid] : (values[mid - 1] + values[mid]) / 2.0;
+	}
+	double upper = CXQuerySelectKth(values, count, mid);
+	if (count % 2 != 0) {
+		return upper;
+	}
+	double lower = values[0];
+	for (CXSize i = 1; i < mid; i++) {
+		if (values[i] > lower) {
+			lower = values[i];
+		}
+	}
+	return (lower + upper) / 2.0;
+}
+
+/* Evaluates a reducing accessor (.min, .max, .avg, .median, .std, .abs,
+ * .dot) on one row. `scratch` holds CXQueryAccessorScratchSize(predicate)
+ * doubles and is overwritten; callers keep one per worker so rows never touch
+ * the allocator. */
+static CXBool CXQueryReduceRow(const CXQueryPredicate *predicate, CXIndex index, double *scratch, double *outValue) {
 	CXAttributeRef attr = predicate->attribute;
 	CXSize dimension = attr->dimension > 0 ? attr->dimension : 1;
+	double *values = scratch;
+	if (!CXQueryLoadRow(attr, index, dimension, values)) {
+		return CXFalse;
+	}
 	if (dimension <= 1) {
-		return CXQueryGetNumericValueAt(attr, index, 0, outValue);
+		*outValue = values[0];
+		return CXTrue;
 	}
 	switch (predicate->accessMode) {
 		case CXQueryAccessMin: {
-			double value = 0.0;
-			if (!CXQueryGetNumericValueAt(attr, index, 0, &value)) {
-				return CXFalse;
-			}
-			double minValue = value;
+			double minValue = values[0];
 			for (CXSize dim = 1; dim < dimension; dim++) {
-				if (!CXQueryGetNumericValueAt(attr, index, dim, &value)) {
-					return CXFalse;
-				}
-				if (value < minValue) {
-					minValue = value;
+				if (values[dim] < minValue) {
+					minValue = values[dim];
 				}
 			}
 			*outValue = minValue;
 			return CXTrue;
 		}
 		case CXQueryAccessMax: {
-			double value = 0.0;
-			if (!CXQueryGetNumericValueAt(attr, index, 0, &value)) {
-				return CXFalse;
-			}
-			double maxValue = value;
+			double maxValue = values[0];
 			for (CXSize dim = 1; dim < dimension; dim++) {
-				if (!CXQueryGetNumericValueAt(attr, index, dim, &value)) {
-					return CXFalse;
-				}
-				if (value > maxValue) {
-					maxValue = value;
+				if (values[dim] > maxValue) {
+					maxValue = values[dim];
 				}
 			}
 			*outValue = maxValue;
@@ -1274,53 +1663,23 @@ static CXBool CXQueryComputeNumericAccessor(const CXQueryPredicate *predicate, C
 		case CXQueryAccessAvg: {
 			double total = 0.0;
 			for (CXSize dim = 0; dim < dimension; dim++) {
-				double value = 0.0;
-				if (!CXQueryGetNumericValueAt(attr, index, dim, &value)) {
-					return CXFalse;
-				}
-				total += value;
+				total += values[dim];
 			}
 			*outValue = total / (double)dimension;
 			return CXTrue;
 		}
-		case CXQueryAccessMedian: {
-			double *values = (double *)malloc(sizeof(double) * dimension);
-			if (!values) {
-				return CXFalse;
-			}
-			for (CXSize dim = 0; dim < dimension; dim++) {
-				if (!CXQueryGetNumericValueAt(attr, index, dim, &values[dim])) {
-					free(values);
-					return CXFalse;
-				}
-			}
-			qsort(values, dimension, sizeof(double), CXQueryCompareDouble);
-			if (dimension % 2 == 0) {
-				CXSize mid = dimension / 2;
-				*outValue = (values[mid - 1] + values[mid]) / 2.0;
-			} else {
-				*outValue = values[dimension / 2];
-			}
-			free(values);
+		case CXQueryAccessMedian:
+			*outValue = CXQueryMedian(values, dimension);
 			return CXTrue;
-		}
 		case CXQueryAccessStd: {
 			double total = 0.0;
 			for (CXSize dim = 0; dim < dimension; dim++) {
-				double value = 0.0;
-				if (!CXQueryGetNumericValueAt(attr, index, dim, &value)) {
-					return CXFalse;
-				}
-				total += value;
+				total += values[dim];
 			}
 			double mean = total / (double)dimension;
 			double variance = 0.0;
 			for (CXSize dim = 0; dim < dimension; dim++) {
-				double value = 0.0;
-				if (!CXQueryGetNumericValueAt(attr, index, dim, &value)) {
-					return CXFalse;
-				}
-				double diff = value - mean;
+				double diff = values[dim] - mean;
 				variance += diff * diff;
 			}
 			variance /= (double)dimension;
@@ -1330,36 +1689,24 @@ static CXBool CXQueryComputeNumericAccessor(const CXQueryPredicate *predicate, C
 		case CXQueryAccessAbs: {
 			double sumSquares = 0.0;
 			for (CXSize dim = 0; dim < dimension; dim++) {
-				double value = 0.0;
-				if (!CXQueryGetNumericValueAt(attr, index, dim, &value)) {
-					return CXFalse;
-				}
-				sumSquares += value * value;
+				sumSquares += values[dim] * values[dim];
 			}
 			*outValue = sqrt(sumSquares);
 			return CXTrue;
 		}
 		case CXQueryAccessDot: {
-			if (!predicate->dotAttribute) {
-				if (!predicate->dotVector || predicate->dotCount != dimension) {
+			const double *other = predicate->dotVector;
+			if (predicate->dotAttribute) {
+				if (!CXQueryLoadRow(predicate->dotAttribute, index, dimension, scratch + dimension)) {
 					return CXFalse;
 				}
+				other = scratch + dimension;
+			} else if (!other || predicate->dotCount != dimension) {
+				return CXFalse;
 			}
 			double total = 0.0;
 			for (CXSize dim = 0; dim < dimension; dim++) {
-				double a = 0.0;
-				double b = 0.0;
-				if (!CXQueryGetNumericValueAt(attr, index, dim, &a)) {
-					return CXFalse;
-				}
-				if (predicate->dotAttribute) {
-					if (!CXQueryGetNumericValueAt(predicate->dotAttribute, index, dim, &b)) {
-						return CXFalse;
-					}
-				} else {
-					b = predicate->dotVector[dim];
-				}
-				total += a * b;
+				total += values[dim] * other[dim];
 			}
 			*outValue = total;
 			return CXTrue;
@@ -1370,22 +1717,82 @@ static CXBool CXQueryComputeNumericAccessor(const CXQueryPredicate *predicate, C
 	return CXFalse;
 }
 
-static int CXQueryCompareDouble(const void *lhs, const void *rhs) {
-	const double a = *(const double *)lhs;
-	const double b = *(const double *)rhs;
-	if (a < b) {
-		return -1;
+static CXSize CXQueryAccessorScratchSize(const CXQueryPredicate *predicate) {
+	CXSize dimension = predicate->attribute && predicate->attribute->dimension > 0 ? predicate->attribute->dimension : 1;
+	return predicate->accessMode == CXQueryAccessDot ? dimension * 2u : dimension;
+}
+
+#define CX_QUERY_ACCESSOR_STACK_SIZE 64u
+
+/* Row interpreter entry point, left to neighbour qualifiers once accessor
+ * predicates are compiled; typical vectors fit the stack buffer. */
+static CXBool CXQueryComputeNumericAccessor(const CXQueryPredicate *predicate, CXIndex index, double *outValue) {
+	if (!predicate || !predicate->attribute || !outValue) {
+		return CXFalse;
+	}
+	double local[CX_QUERY_ACCESSOR_STACK_SIZE];
+	CXSize size = CXQueryAccessorScratchSize(predicate);
+	double *scratch = size <= CX_QUERY_ACCESSOR_STACK_SIZE ? local : malloc(sizeof(double) * size);
+	if (!scratch) {
+		return CXFalse;
 	}
-	if (a > b) {
-		return 1;
+	CXBool ok = CXQueryReduceRow(predicate, index, scratch, outValue);
+	if (scratch != local) {
+		free(scratch);
+	}
+	return ok;
+}
+
+/* Multi-category rows hold a set of ids: `==` tests membership, `!=` its
+ * absence, and `IN` and `=~` whether any listed or matching category is
+ * present. Labels are resolved once by CXQueryCompilePredicate. */
+static CXBool CXQueryCompareMultiCategory(const CXQueryPredicate *predicate, CXIndex index) {
+	const CXMultiCategoryBuffer *buffer = predicate->attribute->multiCategory;
+	if (!buffer || !buffer->offsets || index >= predicate->attribute->capacity) {
+		return CXFalse;
+	}
+	const uint32_t *ids = buffer->ids + buffer->offsets[index];
+	CXSize count = buffer->offsets[index + 1] - buffer->offsets[index];
+	switch (predicate->op) {
+		case CXQueryOpEq:
+		case CXQueryOpNe: {
+			CXBool found = CXFalse;
+			for (CXSize i = 0; i < count && !found; i++) {
+				found = (double)ids[i] == predicate->kernelTarget;
+			}
+			return predicate->op == CXQueryOpEq ? found : !found;
+		}
+		case CXQueryOpRegex:
+			for (CXSize i = 0; i < count; i++) {
+				if (CXQueryLabelMatches(predicate, (double)ids[i])) {
+					return CXTrue;
+				}
+			}
+			return CXFalse;
+		case CXQueryOpIn:
+			if (!predicate->numberList) {
+				return CXFalse;
+			}
+			for (CXSize i = 0; i < count; i++) {
+				for (size_t item = 0; item < predicate->listCount; item++) {
+					if ((double)ids[i] == predicate->numberList[item]) {
+						return CXTrue;
+					}
+				}
+			}
+			return CXFalse;
+		default:
+			return CXFalse;
 	}
-	return 0;
 }
 
 static CXBool CXQueryComparePredicate(CXQueryPredicate *predicate, CXIndex index) {
 	if (!predicate || !predicate->attribute) {
 		return CXFalse;
 	}
+	if (predicate->attribute->type == CXDataAttributeMultiCategoryType) {
+		return CXQueryCompareMultiCategory(predicate, index);
+	}
 	if (predicate->accessMode == CXQueryAccessIndex) {
 		return CXQueryComparePredicateAt(predicate, index, predicate->accessIndex);
 	}
@@ -1512,80 +1919,992 @@ static CXBool CXQueryEvaluateEdgePredicate(CXNetworkRef network, CXQueryPredicat
 	}
 }
 
-static CXBool CXQueryEvaluateNodeExpr(CXNetworkRef network, CXQueryExpr *expr, CXIndex nodeIndex) {
-	if (!expr) {
-		return CXFalse;
+/* Compiled evaluation: every predicate produces a bitmap over the row range of
+ * its scope, one column at a time, and AND/OR/NOT combine the bitmaps. The row
+ * range is cut into tiles of CX_QUERY_TILE_WORDS words that are evaluated
+ * independently, so partitions can run on pool workers and the matches are
+ * gathered in row order whatever the worker count. */
+
+#define CX_QUERY_BLOCK_ROWS 64u
+#define CX_QUERY_TILE_WORDS 64u
+/* Tiles with fewer than 1 active row in this many are evaluated row by row. */
+#define CX_QUERY_SPARSE_RATIO 32u
+/* An index narrows an AND chain only when it keeps at most 1 row in this many. */
+#define CX_QUERY_INDEX_SELECTIVITY 8u
+
+typedef struct {
+	CXNetworkRef network;
+	CXAttributeScope scope;
+	CXSize rowCount;
+	CXSize wordCount;
+	const CXBool *activeFlags;
+	const uint64_t *candidates; /* rows an index allows, NULL to scan all */
+	CXBool candidatesExact;     /* the candidates are the answer */
+	CXQueryExpr *expr;
+	CXSize scratchDepth; /* right-hand temporaries needed by expr */
+	uint64_t *scratch;   /* per worker: active tile + scratchDepth tiles */
+	double *rowScratch;  /* per worker: rowScratchSize doubles for accessors */
+	CXSize rowScratchSize;
+	CXNetworkSnapshotRef snapshot; /* CSR adjacency for neighbour qualifiers */
+	uint64_t *result;    /* wordCount */
+	CXSize tileCount;
+	CXSize grain;        /* tiles per block */
+	CXSize *blockCounts;
+	CXIndex *matches;
+} CXQueryRunContext;
+
+static inline CXSize CXQueryLowestBit(uint64_t bits) {
+#if defined(__GNUC__)
+	return (CXSize)__builtin_ctzll(bits);
+#else
+	CXSize index = 0;
+	while (!(bits & 1u)) {
+		bits >>= 1;
+		index++;
 	}
-	switch (expr->type) {
-		case CXQueryExprPredicate:
-			return CXQueryEvaluateNodePredicate(network, &expr->data.predicate, nodeIndex);
-		case CXQueryExprNot:
-			return CXQueryEvaluateNodeExpr(network, expr->data.notExpr.expr, nodeIndex) ? CXFalse : CXTrue;
-		case CXQueryExprBinary: {
-			if (expr->data.binary.op == CXQueryBinaryAnd) {
-				if (!CXQueryEvaluateNodeExpr(network, expr->data.binary.left, nodeIndex)) {
-					return CXFalse;
-				}
-				return CXQueryEvaluateNodeExpr(network, expr->data.binary.right, nodeIndex);
-			}
-			if (CXQueryEvaluateNodeExpr(network, expr->data.binary.left, nodeIndex)) {
-				return CXTrue;
-			}
-			return CXQueryEvaluateNodeExpr(network, expr->data.binary.right, nodeIndex);
+	return index;
+#endif
+}
+
+static inline CXSize CXQueryPopCount(uint64_t bits) {
+#if defined(__GNUC__)
+	return (CXSize)__builtin_popcountll(bits);
+#else
+	CXSize count = 0;
+	while (bits) {
+		bits &= bits - 1u;
+		count++;
+	}
+	return count;
+#endif
+}
+
+static CXSize CXQueryWordCount(CXSize rowCount) {
+	return (rowCount + CX_QUERY_BLOCK_ROWS - 1u) / CX_QUERY_BLOCK_ROWS;
+}
+
+static void CXQueryActiveWords(const CXBool *flags, CXSize rowCount, CXSize firstWord, CXSize wordCount, uint64_t *out) {
+	for (CXSize word = 0; word < wordCount; word++) {
+		CXSize start = (firstWord + word) * CX_QUERY_BLOCK_ROWS;
+		CXSize count = CXMIN(CX_QUERY_BLOCK_ROWS, rowCount - start);
+		uint64_t value = 0;
+		for (CXSize i = 0; i < count; i++) {
+			value |= (uint64_t)(flags[start + i] != 0) << i;
 		}
+		out[word] = value;
+	}
+}
+
+static CXBool CXQueryIsColumnOperator(CXQueryOperator op) {
+	switch (op) {
+		case CXQueryOpEq:
+		case CXQueryOpNe:
+		case CXQueryOpLt:
+		case CXQueryOpLte:
+		case CXQueryOpGt:
+		case CXQueryOpGte:
+		case CXQueryOpIn:
+			return CXTrue;
 		default:
 			return CXFalse;
 	}
 }
 
-static CXBool CXQueryEvaluateEdgeExpr(CXNetworkRef network, CXQueryExpr *expr, CXIndex edgeIndex) {
-	if (!expr) {
+/* Runs a categorical regex once per dictionary label, so rows only look up
+ * their ids. Returns CXFalse when out of memory. */
+static CXBool CXQueryCompileLabelMatches(CXQueryPredicate *pred, CXBool *outAny) {
+	CXStringDictionaryRef dictionary = pred->attribute->categoricalDictionary;
+	int64_t maxId = -1;
+	if (dictionary) {
+		CXStringDictionaryFOR(entry, dictionary) {
+			int32_t id = 0;
+			if (CXQueryDecodeCategoryId(entry->data, &id) && id > maxId) {
+				maxId = id;
+			}
+		}
+	}
+	free(pred->labelMatches);
+	pred->labelMatchCount = (CXSize)(maxId + 2);
+	pred->labelMatches = calloc(pred->labelMatchCount, sizeof(uint8_t));
+	if (!pred->labelMatches) {
+		pred->labelMatchCount = 0;
 		return CXFalse;
 	}
-	switch (expr->type) {
-		case CXQueryExprPredicate:
-			return CXQueryEvaluateEdgePredicate(network, &expr->data.predicate, edgeIndex);
-		case CXQueryExprNot:
-			return CXQueryEvaluateEdgeExpr(network, expr->data.notExpr.expr, edgeIndex) ? CXFalse : CXTrue;
-		case CXQueryExprBinary: {
-			if (expr->data.binary.op == CXQueryBinaryAnd) {
-				if (!CXQueryEvaluateEdgeExpr(network, expr->data.binary.left, edgeIndex)) {
-					return CXFalse;
-				}
-				return CXQueryEvaluateEdgeExpr(network, expr->data.binary.right, edgeIndex);
-			}
-			if (CXQueryEvaluateEdgeExpr(network, expr->data.binary.left, edgeIndex)) {
-				return CXTrue;
+	*outAny = CXFalse;
+	if (dictionary) {
+		CXStringDictionaryFOR(entry, dictionary) {
+			int32_t id = 0;
+			if (CXQueryDecodeCategoryId(entry->data, &id) && CXQueryRegexMatches(pred, entry->key)) {
+				pred->labelMatches[(size_t)id + 1u] = 1u;
+				*outAny = CXTrue;
 			}
-			return CXQueryEvaluateEdgeExpr(network, expr->data.binary.right, edgeIndex);
 		}
-		default:
-			return CXFalse;
 	}
+	return CXTrue;
 }
 
-static CXQueryExpr *CXQueryParse(const CXString query, CXQueryParser *parser) {
-	parser->input = query ? query : "";
-	parser->length = query ? strlen(query) : 0;
-	parser->pos = 0;
-	parser->hasError = CXFalse;
-	parser->errorMessage = NULL;
-	parser->errorOffset = 0;
-	parser->current.type = CXQueryTokenEof;
-	parser->current.start = parser->input;
-	parser->current.length = 0;
-	parser->current.number = 0.0;
-	parser->current.string = NULL;
-	CXQueryAdvance(parser);
-	CXQueryExpr *expr = CXQueryParseExpression(parser);
-	if (!parser->hasError && parser->current.type != CXQueryTokenEof) {
-		parser->hasError = CXTrue;
-		parser->errorMessage = "Unexpected token";
-		parser->errorOffset = parser->current.start ? (size_t)(parser->current.start - parser->input) : parser->pos;
+/* Picks the column kernel for a bound predicate. Anything the kernels do not
+ * cover (strings, string regex) stays on the row interpreter. Returns CXFalse
+ * when out of memory. */
+static CXBool CXQueryCompilePredicate(CXQueryPredicate *pred) {
+	pred->kernel = CXQueryKernelGeneric;
+	pred->kernelTarget = pred->numberValue;
+	CXAttributeRef attr = pred->attribute;
+	if (attr && pred->op == CXQueryOpRegex) {
+		if (attr->type != CXDataAttributeCategoryType && attr->type != CXDataAttributeMultiCategoryType) {
+			return CXTrue;
+		}
+		CXBool any = CXFalse;
+		if (!CXQueryCompileLabelMatches(pred, &any)) {
+			return CXFalse;
+		}
+		if (attr->type == CXDataAttributeCategoryType) {
+			pred->kernel = any ? CXQueryKernelNumeric : CXQueryKernelNever;
+		}
+		return CXTrue;
 	}
-	return expr;
-}
-
+	if (attr && attr->type == CXDataAttributeMultiCategoryType && pred->valueType == CXQueryValueString) {
+		/* Unknown labels compare as -1, which no stored id equals. */
+		void *encoded = attr->categoricalDictionary
+			? CXStringDictionaryEntryForKey(attr->categoricalDictionary, pred->stringValue)
+			: NULL;
+		int32_t id = 0;
+		pred->kernelTarget = encoded && CXQueryDecodeCategoryId(encoded, &id) ? (double)id : -1.0;
+		return CXTrue;
+	}
+	if (!attr || !CXQueryAttributeIsNumeric(attr) || !CXQueryIsColumnOperator(pred->op)) {
+		return CXTrue;
+	}
+	if (pred->accessMode != CXQueryAccessNone &&
+		pred->accessMode != CXQueryAccessIndex &&
+		pred->accessMode != CXQueryAccessAny &&
+		pred->accessMode != CXQueryAccessAll) {
+		CXBool hasTarget = pred->op == CXQueryOpIn
+			? (pred->valueType == CXQueryValueList && pred->numberList && pred->listCount > 0)
+			: pred->valueType == CXQueryValueNumber;
+		if (hasTarget) {
+			pred->kernel = CXQueryKernelAccessor;
+		}
+		return CXTrue;
+	}
+	if (pred->op == CXQueryOpIn) {
+		if (pred->valueType == CXQueryValueList && pred->numberList && pred->listCount > 0) {
+			pred->kernel = CXQueryKernelNumeric;
+		}
+		return CXTrue;
+	}
+	if (pred->valueType == CXQueryValueNumber) {
+		pred->kernel = CXQueryKernelNumeric;
+		return CXTrue;
+	}
+	if (pred->valueType == CXQueryValueString && attr->type == CXDataAttributeCategoryType) {
+		/* The label is resolved once here instead of once per row. */
+		void *encoded = attr->categoricalDictionary
+			? CXStringDictionaryEntryForKey(attr->categoricalDictionary, pred->stringValue)
+			: NULL;
+		int32_t id = 0;
+		if (!encoded || !CXQueryDecodeCategoryId(encoded, &id)) {
+			pred->kernel = CXQueryKernelNever;
+			return CXTrue;
+		}
+		pred->kernelTarget = (double)id;
+		pred->kernel = CXQueryKernelNumeric;
+	}
+	return CXTrue;
+}
+
+static CXBool CXQueryCompileExpr(CXQueryExpr *expr) {
+	if (!expr) {
+		return CXTrue;
+	}
+	switch (expr->type) {
+		case CXQueryExprPredicate:
+			return CXQueryCompilePredicate(&expr->data.predicate);
+		case CXQueryExprNot:
+			return CXQueryCompileExpr(expr->data.notExpr.expr);
+		case CXQueryExprBinary:
+			return CXQueryCompileExpr(expr->data.binary.left) &&
+				CXQueryCompileExpr(expr->data.binary.right);
+		default:
+			return CXTrue;
+	}
+}
+
+#define CX_QUERY_LOAD_BLOCK(type, convert) do { \
+	if (attr->stride == sizeof(type)) { \
+		const type *values = (const type *)base; \
+		for (CXSize i = 0; i < count; i++) { \
+			out[i] = convert(values[i]); \
+		} \
+	} else { \
+		for (CXSize i = 0; i < count; i++) { \
+			out[i] = convert(*(const type *)(base + i * attr->stride)); \
+		} \
+	} \
+} while (0)
+
+#define CX_QUERY_AS_DOUBLE(value) ((double)(value))
+#define CX_QUERY_AS_FLAG(value) ((value) ? 1.0 : 0.0)
+
+/* Converts `count` consecutive rows of one component to doubles, which is what
+ * the row interpreter compares, so both paths agree on every value. */
+static void CXQueryLoadBlock(CXAttributeRef attr, CXIndex start, CXSize count, CXSize dim, double *out) {
+	const uint8_t *base = attr->data + (size_t)start * attr->stride + (size_t)dim * attr->elementSize;
+	switch (attr->type) {
+		case CXBooleanAttributeType:
+			CX_QUERY_LOAD_BLOCK(uint8_t, CX_QUERY_AS_FLAG);
+			break;
+		case CXFloatAttributeType:
+			CX_QUERY_LOAD_BLOCK(float, CX_QUERY_AS_DOUBLE);
+			break;
+		case CXDoubleAttributeType:
+			CX_QUERY_LOAD_BLOCK(double, CX_QUERY_AS_DOUBLE);
+			break;
+		case CXIntegerAttributeType:
+		case CXDataAttributeCategoryType:
+			CX_QUERY_LOAD_BLOCK(int32_t, CX_QUERY_AS_DOUBLE);
+			break;
+		case CXUnsignedIntegerAttributeType:
+			CX_QUERY_LOAD_BLOCK(uint32_t, CX_QUERY_AS_DOUBLE);
+			break;
+		case CXBigIntegerAttributeType:
+			CX_QUERY_LOAD_BLOCK(int64_t, CX_QUERY_AS_DOUBLE);
+			break;
+		case CXUnsignedBigIntegerAttributeType:
+			CX_QUERY_LOAD_BLOCK(uint64_t, CX_QUERY_AS_DOUBLE);
+			break;
+		default:
+			memset(out, 0, sizeof(double) * count);
+			break;
+	}
+}
+
+#undef CX_QUERY_LOAD_BLOCK
+#undef CX_QUERY_AS_DOUBLE
+#undef CX_QUERY_AS_FLAG
+
+#define CX_QUERY_COMPARE_BLOCK(expression) do { \
+	for (CXSize i = 0; i < count; i++) { \
+		bits |= (uint64_t)(expression) << i; \
+	} \
+} while (0)
+
+static uint64_t CXQueryCompareBlock(const CXQueryPredicate *pred, const double *values, CXSize count) {
+	const double target = pred->kernelTarget;
+	uint64_t bits = 0;
+	switch (pred->op) {
+		case CXQueryOpEq: CX_QUERY_COMPARE_BLOCK(values[i] == target); break;
+		case CXQueryOpNe: CX_QUERY_COMPARE_BLOCK(values[i] != target); break;
+		case CXQueryOpLt: CX_QUERY_COMPARE_BLOCK(values[i] < target); break;
+		case CXQueryOpLte: CX_QUERY_COMPARE_BLOCK(values[i] <= target); break;
+		case CXQueryOpGt: CX_QUERY_COMPARE_BLOCK(values[i] > target); break;
+		case CXQueryOpGte: CX_QUERY_COMPARE_BLOCK(values[i] >= target); break;
+		case CXQueryOpRegex: CX_QUERY_COMPARE_BLOCK(CXQueryLabelMatches(pred, values[i])); break;
+		case CXQueryOpIn:
+			for (size_t item = 0; item < pred->listCount; item++) {
+				const double candidate = pred->numberList[item];
+				CX_QUERY_COMPARE_BLOCK(values[i] == candidate);
+			}
+			break;
+		default:
+			break;
+	}
+	return bits;
+}
+
+#undef CX_QUERY_COMPARE_BLOCK
+
+/* Reducing accessors: each row in `active` (every row when NULL) is reduced
+ * in the worker's `rowScratch`, then the block is compared at once. */
+static void CXQueryAccessorKernel(const CXQueryPredicate *pred, CXSize rows, CXSize firstWord, CXSize wordCount, const uint64_t *active, double *rowScratch, uint64_t *out) {
+	double values[CX_QUERY_BLOCK_ROWS];
+	for (CXSize word = 0; word < wordCount; word++) {
+		CXIndex start = (firstWord + word) * CX_QUERY_BLOCK_ROWS;
+		if (start >= rows) {
+			break;
+		}
+		CXSize count = CXMIN(CX_QUERY_BLOCK_ROWS, rows - start);
+		uint64_t pending = active ? active[word] : ~(uint64_t)0;
+		if (!pending) {
+			continue;
+		}
+		uint64_t valid = 0;
+		for (CXSize i = 0; i < count; i++) {
+			values[i] = 0.0;
+			if (((pending >> i) & 1u) && CXQueryReduceRow(pred, start + i, rowScratch, &values[i])) {
+				valid |= (uint64_t)1 << i;
+			}
+		}
+		out[word] = CXQueryCompareBlock(pred, values, count) & valid;
+	}
+}
+
+/* Fills `out` with the predicate evaluated on rows [firstWord * 64,
+ * (firstWord + wordCount) * 64) of its own attribute; components combine as
+ * any/all like the interpreter. */
+static void CXQueryNumericKernel(const CXQueryPredicate *pred, CXSize rowCount, CXSize firstWord, CXSize wordCount, const uint64_t *active, double *rowScratch, uint64_t *out) {
+	CXAttributeRef attr = pred->attribute;
+	memset(out, 0, sizeof(uint64_t) * wordCount);
+	if (pred->kernel == CXQueryKernelNever || !attr->data) {
+		return;
+	}
+	if (pred->kernel == CXQueryKernelAccessor) {
+		CXQueryAccessorKernel(pred, CXMIN(rowCount, attr->capacity), firstWord, wordCount, active, rowScratch, out);
+		return;
+	}
+	CXSize dimension = attr->dimension > 0 ? attr->dimension : 1;
+	CXSize firstDim = 0;
+	CXSize lastDim = dimension;
+	if (pred->accessMode == CXQueryAccessIndex) {
+		firstDim = pred->accessIndex;
+		lastDim = pred->accessIndex + 1;
+	}
+	CXBool requireAll = pred->accessMode == CXQueryAccessAll;
+	CXSize rows = CXMIN(rowCount, attr->capacity);
+	double values[CX_QUERY_BLOCK_ROWS];
+	for (CXSize word = 0; word < wordCount; word++) {
+		CXIndex start = (firstWord + word) * CX_QUERY_BLOCK_ROWS;
+		if (start >= rows) {
+			break;
+		}
+		CXSize count = CXMIN(CX_QUERY_BLOCK_ROWS, rows - start);
+		uint64_t bits = requireAll ? ~(uint64_t)0 : 0;
+		for (CXSize dim = firstDim; dim < lastDim; dim++) {
+			CXQueryLoadBlock(attr, start, count, dim, values);
+			uint64_t dimBits = CXQueryCompareBlock(pred, values, count);
+			bits = requireAll ? (bits & dimBits) : (bits | dimBits);
+		}
+		if (count < CX_QUERY_BLOCK_ROWS) {
+			bits &= ((uint64_t)1 << count) - 1u;
+		}
+		out[word] = bits;
+	}
+}
+
+static void CXQueryGenericKernel(const CXQueryRunContext *context, CXQueryPredicate *pred, CXSize firstWord, CXSize wordCount, const uint64_t *active, uint64_t *out) {
+	memset(out, 0, sizeof(uint64_t) * wordCount);
+	for (CXSize word = 0; word < wordCount; word++) {
+		uint64_t pending = active[word];
+		while (pending) {
+			CXIndex row = (firstWord + word) * CX_QUERY_BLOCK_ROWS + CXQueryLowestBit(pending);
+			pending &= pending - 1u;
+			CXBool match = context->scope == CXAttributeScopeNode
+				? CXQueryEvaluateNodePredicate(context->network, pred, row)
+				: CXQueryEvaluateEdgePredicate(context->network, pred, row);
+			if (match) {
+				out[word] |= (uint64_t)1 << (row % CX_QUERY_BLOCK_ROWS);
+			}
+		}
+	}
+}
+
+static inline uint64_t CXQueryTestBit(const uint64_t *bits, CXSize rowCount, CXIndex row) {
+	return row < rowCount ? (bits[row / CX_QUERY_BLOCK_ROWS] >> (row % CX_QUERY_BLOCK_ROWS)) & 1u : 0u;
+}
+
+static CXBool CXQueryIsEndpointQualifier(CXQueryQualifier qualifier) {
+	return qualifier == CXQueryQualifierSrc ||
+		qualifier == CXQueryQualifierDst ||
+		qualifier == CXQueryQualifierAny ||
+		qualifier == CXQueryQualifierBoth;
+}
+
+static CXBool CXQueryIsNeighborQualifier(CXQueryQualifier qualifier) {
+	return qualifier == CXQueryQualifierNeighborAny || qualifier == CXQueryQualifierNeighborBoth;
+}
+
+/* Endpoint qualifiers: the node predicate was evaluated once per node before
+ * the run (see CXQueryPrepareNodeBits) and each edge just looks up the bits of
+ * its endpoints. */
+static void CXQueryEndpointKernel(const CXQueryRunContext *context, const CXQueryPredicate *pred, CXSize firstWord, CXSize wordCount, uint64_t *out) {
+	CXNetworkRef network = context->network;
+	CXSize nodeRows = network->nodeCapacity;
+	const uint64_t *nodeBits = pred->nodeBits;
+	for (CXSize word = 0; word < wordCount; word++) {
+		CXIndex start = (firstWord + word) * CX_QUERY_BLOCK_ROWS;
+		CXSize count = CXMIN(CX_QUERY_BLOCK_ROWS, context->rowCount - start);
+		const CXEdge *edges = network->edges + start;
+		uint64_t bits = 0;
+		for (CXSize i = 0; i < count; i++) {
+			uint64_t from = CXQueryTestBit(nodeBits, nodeRows, edges[i].from);
+			uint64_t to = CXQueryTestBit(nodeBits, nodeRows, edges[i].to);
+			uint64_t match = 0;
+			switch (pred->qualifier) {
+				case CXQueryQualifierSrc: match = from; break;
+				case CXQueryQualifierDst: match = to; break;
+				case CXQueryQualifierAny: match = from | to; break;
+				case CXQueryQualifierBoth: match = from & to; break;
+				default: break;
+			}
+			bits |= match << i;
+		}
+		out[word] = bits;
+	}
+}
+
+/* Tests the CSR neighbours of one node against the inner predicate bitmap:
+ * $any ORs and $both ANDs over them, stopping at the first neighbour that
+ * decides. Nodes without neighbours never match. */
+static CXBool CXQueryNeighborsMatch(const CXNetworkSnapshot *snapshot, const uint64_t *nodeBits, CXSize nodeRows, CXIndex compact, CXBool requireAll) {
+	const CXIndex *lists[2] = {
+		snapshot->outNeighbors + snapshot->outOffsets[compact],
+		snapshot->inNeighbors + snapshot->inOffsets[compact]
+	};
+	CXSize counts[2] = {
+		snapshot->outOffsets[compact + 1] - snapshot->outOffsets[compact],
+		snapshot->inOffsets[compact + 1] - snapshot->inOffsets[compact]
+	};
+	if (counts[0] + counts[1] == 0) {
+		return CXFalse;
+	}
+	for (int list = 0; list < 2; list++) {
+		for (CXSize i = 0; i < counts[list]; i++) {
+			uint64_t bit = CXQueryTestBit(nodeBits, nodeRows, snapshot->compactToNode[lists[list][i]]);
+			if (requireAll ? !bit : bit) {
+				return requireAll ? CXFalse : CXTrue;
+			}
+		}
+	}
+	return requireAll;
+}
+
+/* Neighbour qualifiers: a semi-join of each active node's adjacency against
+ * the node bitmap of the inner predicate, so every node is evaluated once
+ * however many nodes list it as a neighbour. */
+static void CXQueryNeighborKernel(const CXQueryRunContext *context, const CXQueryPredicate *pred, CXSize firstWord, CXSize wordCount, const uint64_t *active, uint64_t *out) {
+	const CXNetworkSnapshot *snapshot = context->snapshot;
+	CXBool requireAll = pred->qualifier == CXQueryQualifierNeighborBoth;
+	for (CXSize word = 0; word < wordCount; word++) {
+		uint64_t pending = active[word];
+		uint64_t bits = 0;
+		while (pending) {
+			CXSize bit = CXQueryLowestBit(pending);
+			CXIndex row = (firstWord + word) * CX_QUERY_BLOCK_ROWS + bit;
+			pending &= pending - 1u;
+			CXIndex compact = row < snapshot->nodeCapacity ? snapshot->nodeToCompact[row] : CXIndexMAX;
+			if (compact != CXIndexMAX && CXQueryNeighborsMatch(snapshot, pred->nodeBits, context->rowCount, compact, requireAll)) {
+				bits |= (uint64_t)1 << bit;
+			}
+		}
+		out[word] = bits;
+	}
+}
+
+static void CXQueryEvaluatePredicateTile(const CXQueryRunContext *context, CXQueryPredicate *pred, CXSize firstWord, CXSize wordCount, const uint64_t *active, CXBool sparse, double *rowScratch, uint64_t *out) {
+	if (pred->nodeBits && CXQueryIsNeighborQualifier(pred->qualifier) && context->snapshot) {
+		CXQueryNeighborKernel(context, pred, firstWord, wordCount, active, out);
+		return;
+	}
+	if (pred->nodeBits && CXQueryIsEndpointQualifier(pred->qualifier)) {
+		CXQueryEndpointKernel(context, pred, firstWord, wordCount, out);
+		for (CXSize word = 0; word < wordCount; word++) {
+			out[word] &= active[word];
+		}
+		return;
+	}
+	/* The accessor kernel only visits active rows, so it suits sparse tiles
+	 * as well. */
+	if (pred->qualifier != CXQueryQualifierSelf || pred->kernel == CXQueryKernelGeneric ||
+		(sparse && pred->kernel != CXQueryKernelAccessor)) {
+		CXQueryGenericKernel(context, pred, firstWord, wordCount, active, out);
+		return;
+	}
+	CXQueryNumericKernel(pred, context->rowCount, firstWord, wordCount, active, rowScratch, out);
+	for (CXSize word = 0; word < wordCount; word++) {
+		out[word] &= active[word];
+	}
+}
+
+static CXBool CXQueryBitmapIsEmpty(const uint64_t *bits, CXSize wordCount) {
+	for (CXSize word = 0; word < wordCount; word++) {
+		if (bits[word]) {
+			return CXFalse;
+		}
+	}
+	return CXTrue;
+}
+
+/* Evaluates one tile. Right-hand operands go to `scratch`, one tile per level
+ * of nesting (CXQueryScratchDepth), so nothing is allocated per tile. Sparse
+ * tiles test their few active rows one by one instead of whole columns. */
+static void CXQueryEvaluateTile(const CXQueryRunContext *context, CXQueryExpr *expr, CXSize firstWord, CXSize wordCount, const uint64_t *active, CXBool sparse, double *rowScratch, uint64_t *out, uint64_t *scratch) {
+	switch (expr ? expr->type : CXQueryExprPredicate) {
+		case CXQueryExprPredicate:
+			if (!expr) {
+				memset(out, 0, sizeof(uint64_t) * wordCount);
+				return;
+			}
+			CXQueryEvaluatePredicateTile(context, &expr->data.predicate, firstWord, wordCount, active, sparse, rowScratch, out);
+			return;
+		case CXQueryExprNot:
+			CXQueryEvaluateTile(context, expr->data.notExpr.expr, firstWord, wordCount, active, sparse, rowScratch, out, scratch);
+			for (CXSize word = 0; word < wordCount; word++) {
+				out[word] = ~out[word] & active[word];
+			}
+			return;
+		case CXQueryExprBinary: {
+			CXBool isAnd = expr->data.binary.op == CXQueryBinaryAnd;
+			CXQueryEvaluateTile(context, expr->data.binary.left, firstWord, wordCount, active, sparse, rowScratch, out, scratch);
+			/* Same short circuit as the interpreter, decided per tile. */
+			if (isAnd && CXQueryBitmapIsEmpty(out, wordCount)) {
+				return;
+			}
+			CXQueryEvaluateTile(context, expr->data.binary.right, firstWord, wordCount, active, sparse, rowScratch, scratch, scratch + CX_QUERY_TILE_WORDS);
+			for (CXSize word = 0; word < wordCount; word++) {
+				out[word] = isAnd ? (out[word] & scratch[word]) : (out[word] | scratch[word]);
+			}
+			return;
+		}
+		default:
+			memset(out, 0, sizeof(uint64_t) * wordCount);
+			return;
+	}
+}
+
+static CXSize CXQueryScratchDepth(const CXQueryExpr *expr) {
+	if (!expr) {
+		return 0;
+	}
+	switch (expr->type) {
+		case CXQueryExprNot:
+			return CXQueryScratchDepth(expr->data.notExpr.expr);
+		case CXQueryExprBinary: {
+			CXSize left = CXQueryScratchDepth(expr->data.binary.left);
+			CXSize right = CXQueryScratchDepth(expr->data.binary.right) + 1u;
+			return CXMAX(left, right);
+		}
+		default:
+			return 0;
+	}
+}
+
+static CXBool CXQueryHasNeighborQualifier(const CXQueryExpr *expr) {
+	if (!expr) {
+		return CXFalse;
+	}
+	switch (expr->type) {
+		case CXQueryExprPredicate:
+			return CXQueryIsNeighborQualifier(expr->data.predicate.qualifier);
+		case CXQueryExprNot:
+			return CXQueryHasNeighborQualifier(expr->data.notExpr.expr);
+		case CXQueryExprBinary:
+			return CXQueryHasNeighborQualifier(expr->data.binary.left) ||
+				CXQueryHasNeighborQualifier(expr->data.binary.right);
+		default:
+			return CXFalse;
+	}
+}
+
+/* Largest accessor scratch any compiled predicate of `expr` needs. */
+static CXSize CXQueryRowScratchSize(const CXQueryExpr *expr) {
+	if (!expr) {
+		return 0;
+	}
+	switch (expr->type) {
+		case CXQueryExprPredicate:
+			return expr->data.predicate.kernel == CXQueryKernelAccessor
+				? CXQueryAccessorScratchSize(&expr->data.predicate)
+				: 0;
+		case CXQueryExprNot:
+			return CXQueryRowScratchSize(expr->data.notExpr.expr);
+		case CXQueryExprBinary: {
+			CXSize left = CXQueryRowScratchSize(expr->data.binary.left);
+			CXSize right = CXQueryRowScratchSize(expr->data.binary.right);
+			return CXMAX(left, right);
+		}
+		default:
+			return 0;
+	}
+}
+
+static inline double *CXQueryWorkerRowScratch(const CXQueryRunContext *context, CXSize workerIndex) {
+	return context->rowScratch ? context->rowScratch + workerIndex * context->rowScratchSize : NULL;
+}
+
+static CXSize CXQueryTileGrain(CXSize tileCount, CXSize workerCount) {
+	CXSize grain = tileCount / (CXMAX((CXSize)1, workerCount) * 8u);
+	return CXMAX(grain, (CXSize)1);
+}
+
+typedef struct {
+	const CXQueryRunContext *context;
+	CXQueryPredicate *pred;
+	CXSize rowCount;
+	CXSize wordCount;
+	uint64_t *bits;
+} CXQueryNodeBitsTask;
+
+static void CXQueryNodeBitsRange(void *context, CXIndex start, CXIndex end, CXSize workerIndex) {
+	CXQueryNodeBitsTask *task = (CXQueryNodeBitsTask *)context;
+	CXSize firstWord = start * CX_QUERY_TILE_WORDS;
+	CXSize wordCount = CXMIN(end * CX_QUERY_TILE_WORDS, task->wordCount) - firstWord;
+	uint64_t *bits = task->bits + firstWord;
+	if (task->pred->kernel != CXQueryKernelGeneric) {
+		double *rowScratch = CXQueryWorkerRowScratch(task->context, workerIndex);
+		CXQueryNumericKernel(task->pred, task->rowCount, firstWord, wordCount, NULL, rowScratch, bits);
+		return;
+	}
+	/* Only active nodes can be endpoints or neighbours. */
+	CXQueryActiveWords(task->context->network->nodeActive, task->rowCount, firstWord, wordCount, bits);
+	for (CXSize word = 0; word < wordCount; word++) {
+		uint64_t pending = bits[word];
+		bits[word] = 0;
+		while (pending) {
+			CXSize bit = CXQueryLowestBit(pending);
+			pending &= pending - 1u;
+			if (CXQueryComparePredicate(task->pred, (firstWord + word) * CX_QUERY_BLOCK_ROWS + bit)) {
+				bits[word] |= (uint64_t)1 << bit;
+			}
+		}
+	}
+}
+
+/* Evaluates the node predicate behind every endpoint (edge queries) and
+ * neighbour (node queries) qualifier once per node, in parallel. The bitmaps
+ * live on the predicates for the duration of one run. */
+static CXBool CXQueryPrepareNodeBits(const CXQueryRunContext *context, CXQueryExpr *expr, CXSize workerCount) {
+	if (!expr) {
+		return CXTrue;
+	}
+	switch (expr->type) {
+		case CXQueryExprPredicate: {
+			CXQueryPredicate *pred = &expr->data.predicate;
+			CXBool endpoint = context->scope == CXAttributeScopeEdge && CXQueryIsEndpointQualifier(pred->qualifier);
+			CXBool neighbor = context->scope == CXAttributeScopeNode && CXQueryIsNeighborQualifier(pred->qualifier);
+			if (!endpoint && !neighbor) {
+				return CXTrue;
+			}
+			CXQueryNodeBitsTask task = {0};
+			task.context = context;
+			task.pred = pred;
+			task.rowCount = context->network->nodeCapacity;
+			task.wordCount = CXQueryWordCount(task.rowCount);
+			task.bits = malloc(sizeof(uint64_t) * CXMAX(task.wordCount, 1));
+			if (!task.bits) {
+				return CXFalse;
+			}
+			CXSize tileCount = (task.wordCount + CX_QUERY_TILE_WORDS - 1u) / CX_QUERY_TILE_WORDS;
+			if (tileCount > 0) {
+				CXSize workers = CXMIN(workerCount, tileCount);
+				CXParallelForRange(tileCount, CXQueryTileGrain(tileCount, workers), workers, CXQueryNodeBitsRange, &task);
+			}
+			pred->nodeBits = task.bits;
+			return CXTrue;
+		}
+		case CXQueryExprNot:
+			return CXQueryPrepareNodeBits(context, expr->data.notExpr.expr, workerCount);
+		case CXQueryExprBinary:
+			return CXQueryPrepareNodeBits(context, expr->data.binary.left, workerCount) &&
+				CXQueryPrepareNodeBits(context, expr->data.binary.right, workerCount);
+		default:
+			return CXTrue;
+	}
+}
+
+static void CXQueryReleaseNodeBits(CXQueryExpr *expr) {
+	if (!expr) {
+		return;
+	}
+	switch (expr->type) {
+		case CXQueryExprPredicate:
+			free(expr->data.predicate.nodeBits);
+			expr->data.predicate.nodeBits = NULL;
+			break;
+		case CXQueryExprNot:
+			CXQueryReleaseNodeBits(expr->data.notExpr.expr);
+			break;
+		case CXQueryExprBinary:
+			CXQueryReleaseNodeBits(expr->data.binary.left);
+			CXQueryReleaseNodeBits(expr->data.binary.right);
+			break;
+		default:
+			break;
+	}
+}
+
+/* First pass: evaluates the tiles of one block into the shared result bitmap
+ * (blocks write disjoint words) and records how many rows matched. */
+static void CXQueryRunRange(void *contextPtr, CXIndex start, CXIndex end, CXSize workerIndex) {
+	CXQueryRunContext *context = (CXQueryRunContext *)contextPtr;
+	uint64_t *active = context->scratch + workerIndex * (context->scratchDepth + 1u) * CX_QUERY_TILE_WORDS;
+	double *rowScratch = CXQueryWorkerRowScratch(context, workerIndex);
+	CXSize matchCount = 0;
+	for (CXIndex tile = start; tile < end; tile++) {
+		CXSize firstWord = tile * CX_QUERY_TILE_WORDS;
+		CXSize wordCount = CXMIN(CX_QUERY_TILE_WORDS, context->wordCount - firstWord);
+		uint64_t *out = context->result + firstWord;
+		CXQueryActiveWords(context->activeFlags, context->rowCount, firstWord, wordCount, active);
+		CXSize activeCount = 0;
+		for (CXSize word = 0; word < wordCount; word++) {
+			if (context->candidates) {
+				active[word] &= context->candidates[firstWord + word];
+			}
+			activeCount += CXQueryPopCount(active[word]);
+		}
+		if (activeCount == 0) {
+			memset(out, 0, sizeof(uint64_t) * wordCount);
+			continue;
+		}
+		if (context->candidatesExact) {
+			memcpy(out, active, sizeof(uint64_t) * wordCount);
+			matchCount += activeCount;
+			continue;
+		}
+		CXBool sparse = activeCount * CX_QUERY_SPARSE_RATIO < wordCount * CX_QUERY_BLOCK_ROWS;
+		CXQueryEvaluateTile(context, context->expr, firstWord, wordCount, active, sparse, rowScratch, out, active + CX_QUERY_TILE_WORDS);
+		for (CXSize word = 0; word < wordCount; word++) {
+			matchCount += CXQueryPopCount(out[word]);
+		}
+	}
+	context->blockCounts[start / context->grain] = matchCount;
+}
+
+/* Second pass: each block writes its matches from the offset given by the
+ * prefix sum of the block counts, which keeps them in ascending order. */
+static void CXQueryGatherRange(void *contextPtr, CXIndex start, CXIndex end, CXSize workerIndex) {
+	(void)workerIndex;
+	CXQueryRunContext *context = (CXQueryRunContext *)contextPtr;
+	CXSize position = context->blockCounts[start / context->grain];
+	CXSize lastWord = CXMIN(end * CX_QUERY_TILE_WORDS, context->wordCount);
+	for (CXSize word = start * CX_QUERY_TILE_WORDS; word < lastWord; word++) {
+		uint64_t bits = context->result[word];
+		while (bits) {
+			context->matches[position++] = word * CX_QUERY_BLOCK_ROWS + CXQueryLowestBit(bits);
+			bits &= bits - 1u;
+		}
+	}
+}
+
+/* Index planning: a predicate on an indexed attribute that is a conjunct of
+ * the whole query bounds its result, so the rows listed by the index are the
+ * only ones worth evaluating. */
+static CXBool CXQueryPredicateUsesIndex(CXNetworkRef network, const CXQueryPredicate *pred, CXAttributeIndexRef *outIndex) {
+	CXAttributeRef attr = pred->attribute;
+	if (pred->qualifier != CXQueryQualifierSelf || !attr || !attr->index || pred->kernel == CXQueryKernelAccessor) {
+		return CXFalse;
+	}
+	if (pred->accessMode == CXQueryAccessIndex && pred->accessIndex != 0) {
+		return CXFalse;
+	}
+	switch (attr->type) {
+		case CXDataAttributeMultiCategoryType:
+			if (pred->op != CXQueryOpEq && pred->op != CXQueryOpIn && pred->op != CXQueryOpRegex) {
+				return CXFalse;
+			}
+			break;
+		case CXDataAttributeCategoryType:
+			if (pred->kernel == CXQueryKernelGeneric ||
+				(pred->op != CXQueryOpEq && pred->op != CXQueryOpIn && pred->op != CXQueryOpRegex)) {
+				return CXFalse;
+			}
+			break;
+		default:
+			if (pred->kernel == CXQueryKernelGeneric || pred->op == CXQueryOpNe) {
+				return CXFalse;
+			}
+			break;
+	}
+	*outIndex = CXAttributeIndexAcquire(network, attr);
+	return *outIndex != NULL;
+}
+
+static CXBool CXQueryListRepeats(const double *values, size_t item) {
+	for (size_t i = 0; i < item; i++) {
+		if (values[i] == values[item]) {
+			return CXTrue;
+		}
+	}
+	return CXFalse;
+}
+
+static void CXQueryIndexMarkRows(CXAttributeIndexRef index, CXSize start, CXSize end, CXSize rowCount, uint64_t *bits) {
+	for (CXSize i = start; i < end; i++) {
+		CXIndex row = index->rows[i];
+		if (row < rowCount) {
+			bits[row / CX_QUERY_BLOCK_ROWS] |= (uint64_t)1 << (row % CX_QUERY_BLOCK_ROWS);
+		}
+	}
+}
+
+/* Returns how many index entries match `pred` and, when `bits` is given, sets
+ * their rows in it. */
+static CXSize CXQueryIndexCandidates(const CXQueryPredicate *pred, CXAttributeIndexRef index, CXSize rowCount, uint64_t *bits) {
+	if (pred->kernel == CXQueryKernelNever) {
+		return 0;
+	}
+	if (pred->op == CXQueryOpRegex) {
+		/* Postings of every label the pattern matched at compile time. */
+		CXSize total = 0;
+		for (CXSize slot = 0; slot < pred->labelMatchCount; slot++) {
+			if (!pred->labelMatches[slot]) {
+				continue;
+			}
+			CXSize start = 0;
+			CXSize end = 0;
+			CXAttributeIndexPostings(index, (int64_t)slot - 1, &start, &end);
+			total += end - start;
+			if (bits) {
+				CXQueryIndexMarkRows(index, start, end, rowCount, bits);
+			}
+		}
+		return total;
+	}
+	CXAttributeIndexCompare compare = CXAttributeIndexCompareEq;
+	switch (pred->op) {
+		case CXQueryOpLt: compare = CXAttributeIndexCompareLt; break;
+		case CXQueryOpLte: compare = CXAttributeIndexCompareLte; break;
+		case CXQueryOpGt: compare = CXAttributeIndexCompareGt; break;
+		case CXQueryOpGte: compare = CXAttributeIndexCompareGte; break;
+		default: break;
+	}
+	CXBool isList = pred->op == CXQueryOpIn;
+	size_t targetCount = isList ? (pred->numberList ? pred->listCount : 0) : 1;
+	CXSize total = 0;
+	for (size_t item = 0; item < targetCount; item++) {
+		if (isList && CXQueryListRepeats(pred->numberList, item)) {
+			continue;
+		}
+		double target = isList ? pred->numberList[item] : pred->kernelTarget;
+		CXSize start = 0;
+		CXSize end = 0;
+		if (index->kind == CXAttributeIndexKindSorted) {
+			CXAttributeIndexRange(index, compare, target, &start, &end);
+		} else if (target >= -2147483648.0 && target <= 4294967295.0 && target == (double)(int64_t)target) {
+			CXAttributeIndexPostings(index, (int64_t)target, &start, &end);
+		}
+		total += end - start;
+		if (bits) {
+			CXQueryIndexMarkRows(index, start, end, rowCount, bits);
+		}
+	}
+	return total;
+}
+
+typedef struct {
+	CXQueryExpr *expr;
+	CXAttributeIndexRef index;
+	CXSize count;
+} CXQueryIndexPlan;
+
+/* Picks the indexed conjunct with the fewest matching rows. */
+static void CXQueryPlanIndex(CXNetworkRef network, CXQueryExpr *expr, CXSize rowCount, CXQueryIndexPlan *plan) {
+	if (!expr) {
+		return;
+	}
+	if (expr->type == CXQueryExprBinary && expr->data.binary.op == CXQueryBinaryAnd) {
+		CXQueryPlanIndex(network, expr->data.binary.left, rowCount, plan);
+		CXQueryPlanIndex(network, expr->data.binary.right, rowCount, plan);
+		return;
+	}
+	CXAttributeIndexRef index = NULL;
+	if (expr->type != CXQueryExprPredicate || !CXQueryPredicateUsesIndex(network, &expr->data.predicate, &index)) {
+		return;
+	}
+	CXSize count = CXQueryIndexCandidates(&expr->data.predicate, index, rowCount, NULL);
+	if (!plan->expr || count < plan->count) {
+		plan->expr = expr;
+		plan->index = index;
+		plan->count = count;
+	}
+}
+
+/* Runs a bound, compiled expression over every active row of `scope` and
+ * returns the matching indices in ascending order. */
+static CXBool CXQueryCollectMatches(CXNetworkRef network, CXQueryExpr *expr, CXAttributeScope scope, CXIndex **outMatches, CXSize *outCount) {
+	CXQueryRunContext context = {0};
+	context.network = network;
+	context.scope = scope;
+	context.rowCount = scope == CXAttributeScopeNode ? network->nodeCapacity : network->edgeCapacity;
+	context.wordCount = CXQueryWordCount(context.rowCount);
+	context.activeFlags = scope == CXAttributeScopeNode ? network->nodeActive : network->edgeActive;
+	context.expr = expr;
+	context.scratchDepth = CXQueryScratchDepth(expr);
+	context.tileCount = (context.wordCount + CX_QUERY_TILE_WORDS - 1u) / CX_QUERY_TILE_WORDS;
+	CXSize workerCount = CXMAX(CXParallelWorkerCount(context.tileCount), (CXSize)1);
+	context.grain = CXQueryTileGrain(context.tileCount, workerCount);
+	CXSize blockCount = (context.tileCount + context.grain - 1u) / context.grain;
+	context.scratch = malloc(sizeof(uint64_t) * CX_QUERY_TILE_WORDS * (context.scratchDepth + 1u) * workerCount);
+	context.result = malloc(sizeof(uint64_t) * CXMAX(context.wordCount, 1));
+	context.blockCounts = calloc(CXMAX(blockCount, 1), sizeof(CXSize));
+	context.rowScratchSize = CXQueryRowScratchSize(expr);
+	if (context.rowScratchSize > 0) {
+		context.rowScratch = malloc(sizeof(double) * context.rowScratchSize * workerCount);
+	}
+	CXBool ok = context.scratch && context.result && context.blockCounts &&
+		(context.rowScratchSize == 0 || context.rowScratch);
+	uint64_t *candidates = NULL;
+	CXQueryIndexPlan plan = {0};
+	CXQueryPlanIndex(network, expr, context.rowCount, &plan);
+	if (ok && plan.expr && (plan.expr == expr || plan.count * CX_QUERY_INDEX_SELECTIVITY <= context.rowCount)) {
+		candidates = calloc(CXMAX(context.wordCount, 1), sizeof(uint64_t));
+		ok = candidates != NULL;
+		if (ok) {
+			CXQueryIndexCandidates(&plan.expr->data.predicate, plan.index, context.rowCount, candidates);
+			context.candidates = candidates;
+			context.candidatesExact = plan.expr == expr;
+		}
+	}
+	if (ok && scope == CXAttributeScopeNode && CXQueryHasNeighborQualifier(expr)) {
+		context.snapshot = CXNetworkSnapshotAcquire(network);
+		ok = context.snapshot != NULL;
+	}
+	ok = ok && CXQueryPrepareNodeBits(&context, expr, workerCount);
+	CXSize matchCount = 0;
+	if (ok) {
+		if (context.tileCount > 0) {
+			CXParallelForRange(context.tileCount, context.grain, workerCount, CXQueryRunRange, &context);
+		}
+		for (CXSize block = 0; block < blockCount; block++) {
+			CXSize count = context.blockCounts[block];
+			context.blockCounts[block] = matchCount;
+			matchCount += count;
+		}
+		context.matches = malloc(sizeof(CXIndex) * CXMAX(matchCount, 1));
+		ok = context.matches != NULL;
+	}
+	if (ok && matchCount > 0) {
+		CXParallelForRange(context.tileCount, context.grain, workerCount, CXQueryGatherRange, &context);
+	}
+	CXQueryReleaseNodeBits(expr);
+	if (context.snapshot) {
+		CXNetworkSnapshotRelease(context.snapshot);
+	}
+	free(candidates);
+	free(context.scratch);
+	free(context.rowScratch);
+	free(context.result);
+	free(context.blockCounts);
+	if (!ok) {
+		free(context.matches);
+		return CXFalse;
+	}
+	*outMatches = context.matches;
+	*outCount = matchCount;
+	return CXTrue;
+}
+
+static CXQueryExpr *CXQueryParse(const CXString query, CXQueryParser *parser) {
+	parser->input = query ? query : "";
+	parser->length = query ? strlen(query) : 0;
+	parser->pos = 0;
+	parser->hasError = CXFalse;
+	parser->errorMessage = NULL;
+	parser->errorOffset = 0;
+	parser->current.type = CXQueryTokenEof;
+	parser->current.start = parser->input;
+	parser->current.length = 0;
+	parser->current.number = 0.0;
+	parser->current.string = NULL;
+	CXQueryAdvance(parser);
+	CXQueryExpr *expr = CXQueryParseExpression(parser);
+	if (!parser->hasError && parser->current.type != CXQueryTokenEof) {
+		parser->hasError = CXTrue;
+		parser->errorMessage = "Unexpected token";
+		parser->errorOffset = parser->current.start ? (size_t)(parser->current.start - parser->input) : parser->pos;
+	}
+	return expr;
+}
+
 static CXBool CXQueryValidateQualifierForScope(CXQueryPredicate *predicate, CXAttributeScope scope, const char **outError) {
 	if (scope == CXAttributeScopeNode) {
 		switch (predicate->qualifier) {
@@ -1738,130 +3057,229 @@ static CXBool CXQueryBindPredicateConstraints(CXNetworkRef network, CXQueryExpr
 	}
 }
 
-static CXBool CXQuerySelectNodes(CXNetworkRef network, const CXString query, CXNodeSelectorRef selector) {
-	if (!network || !selector) {
-		CXQuerySetError("Network or selector missing", 0);
-		return CXFalse;
-	}
+/* Parses, validates, binds and compiles `query` for `scope`. Sets the query
+ * error and returns NULL on failure. */
+static CXQueryExpr *CXQueryBuild(CXNetworkRef network, const CXString query, CXAttributeScope scope) {
 	CXQueryParser parser = {0};
 	CXQueryExpr *expr = CXQueryParse(query, &parser);
+	CXQueryTokenFree(&parser.current);
 	if (parser.hasError || !expr) {
 		CXQuerySetError(parser.errorMessage, parser.errorOffset);
-		CXQueryTokenFree(&parser.current);
 		CXQueryFreeExpr(expr);
-		return CXFalse;
+		return NULL;
 	}
 	const char *error = NULL;
-	if (!CXQueryValidateQualifiers(expr, CXAttributeScopeNode, &error)) {
+	if (!CXQueryValidateQualifiers(expr, scope, &error) ||
+		!CXQueryBindAttributes(network, expr, scope, &error) ||
+		!CXQueryBindPredicateConstraints(network, expr, scope, &error)) {
 		CXQuerySetError(error, 0);
 		CXQueryFreeExpr(expr);
-		CXQueryTokenFree(&parser.current);
-		return CXFalse;
-	}
-	if (!CXQueryBindAttributes(network, expr, CXAttributeScopeNode, &error)) {
-		CXQuerySetError(error, 0);
-		CXQueryFreeExpr(expr);
-		CXQueryTokenFree(&parser.current);
-		return CXFalse;
+		return NULL;
 	}
-	if (!CXQueryBindPredicateConstraints(network, expr, CXAttributeScopeNode, &error)) {
-		CXQuerySetError(error, 0);
+	if (!CXQueryCompileExpr(expr)) {
+		CXQuerySetError("Out of memory", 0);
 		CXQueryFreeExpr(expr);
-		CXQueryTokenFree(&parser.current);
-		return CXFalse;
+		return NULL;
 	}
+	return expr;
+}
 
+static CXBool CXQueryRun(CXNetworkRef network, CXQueryExpr *expr, CXAttributeScope scope, CXSelector *selector) {
 	CXIndex *matches = NULL;
 	CXSize matchCount = 0;
-	CXSize matchCapacity = 0;
-	for (CXIndex idx = 0; idx < network->nodeCapacity; idx++) {
-		if (!network->nodeActive[idx]) {
-			continue;
-		}
-		if (CXQueryEvaluateNodeExpr(network, expr, idx)) {
-			CXGrowArrayAddElement(idx, sizeof(CXIndex), matchCount, matchCapacity, matches);
-		}
-	}
-	CXIndex dummy = 0;
-	const CXIndex *input = matches ? matches : &dummy;
-	if (!CXNodeSelectorFillFromArray(selector, input, matchCount)) {
-		free(matches);
-		CXQuerySetError("Failed to populate selector", 0);
-		CXQueryFreeExpr(expr);
-		CXQueryTokenFree(&parser.current);
+	if (!CXQueryCollectMatches(network, expr, scope, &matches, &matchCount)) {
+		CXQuerySetError("Out of memory", 0);
 		return CXFalse;
 	}
+	CXBool ok = scope == CXAttributeScopeNode
+		? CXNodeSelectorFillFromArray(selector, matches, matchCount)
+		: CXEdgeSelectorFillFromArray(selector, matches, matchCount);
 	free(matches);
-	CXQueryFreeExpr(expr);
-	CXQueryTokenFree(&parser.current);
-	return CXTrue;
+	if (!ok) {
+		CXQuerySetError("Failed to populate selector", 0);
+	}
+	return ok;
 }
 
-static CXBool CXQuerySelectEdges(CXNetworkRef network, const CXString query, CXEdgeSelectorRef selector) {
+static CXBool CXQuerySelect(CXNetworkRef network, const CXString query, CXAttributeScope scope, CXSelector *selector) {
 	if (!network || !selector) {
 		CXQuerySetError("Network or selector missing", 0);
 		return CXFalse;
 	}
-	CXQueryParser parser = {0};
-	CXQueryExpr *expr = CXQueryParse(query, &parser);
-	if (parser.hasError || !expr) {
-		CXQuerySetError(parser.errorMessage, parser.errorOffset);
-		CXQueryTokenFree(&parser.current);
-		CXQueryFreeExpr(expr);
+	CXQueryExpr *expr = CXQueryBuild(network, query, scope);
+	if (!expr) {
 		return CXFalse;
 	}
-	const char *error = NULL;
-	if (!CXQueryValidateQualifiers(expr, CXAttributeScopeEdge, &error)) {
-		CXQuerySetError(error, 0);
-		CXQueryFreeExpr(expr);
-		CXQueryTokenFree(&parser.current);
-		return CXFalse;
+	CXBool ok = CXQueryRun(network, expr, scope, selector);
+	CXQueryFreeExpr(expr);
+	return ok;
+}
+
+/* One attribute a prepared plan was bound against. */
+typedef struct {
+	CXAttributeScope scope;
+	const char *name; /* owned by the plan's expression */
+	CXAttributeRef attribute;
+	CXAttributeType type;
+	CXSize dimension;
+	CXStringDictionaryRef categoricalDictionary;
+	uint64_t version;
+} CXQueryBinding;
+
+struct CXPreparedQuery {
+	CXNetworkRef network;
+	CXAttributeScope scope;
+	char *text;
+	CXQueryExpr *expr;
+	CXQueryBinding *bindings;
+	CXSize bindingCount;
+	CXSize bindingCapacity;
+};
+
+static CXBool CXQueryAddBinding(CXPreparedQueryRef prepared, CXAttributeScope scope, const char *name, CXAttributeRef attribute) {
+	if (!name || !attribute) {
+		return CXTrue;
 	}
-	if (!CXQueryBindAttributes(network, expr, CXAttributeScopeEdge, &error)) {
-		CXQuerySetError(error, 0);
-		CXQueryFreeExpr(expr);
-		CXQueryTokenFree(&parser.current);
-		return CXFalse;
+	CXQueryBinding binding = {
+		.scope = scope,
+		.name = name,
+		.attribute = attribute,
+		.type = attribute->type,
+		.dimension = attribute->dimension,
+		.categoricalDictionary = attribute->categoricalDictionary,
+		.version = attribute->version
+	};
+	CXGrowArrayAddElement(binding, sizeof(CXQueryBinding), prepared->bindingCount, prepared->bindingCapacity, prepared->bindings);
+	return prepared->bindings != NULL;
+}
+
+static CXBool CXQueryCollectBindings(CXPreparedQueryRef prepared, CXQueryExpr *expr) {
+	if (!expr) {
+		return CXTrue;
 	}
-	if (!CXQueryBindPredicateConstraints(network, expr, CXAttributeScopeEdge, &error)) {
-		CXQuerySetError(error, 0);
-		CXQueryFreeExpr(expr);
-		CXQueryTokenFree(&parser.current);
-		return CXFalse;
+	switch (expr->type) {
+		case CXQueryExprPredicate: {
+			CXQueryPredicate *pred = &expr->data.predicate;
+			return CXQueryAddBinding(prepared, pred->scope, pred->name, pred->attribute) &&
+				CXQueryAddBinding(prepared, prepared->scope, pred->dotName, pred->dotAttribute);
+		}
+		case CXQueryExprNot:
+			return CXQueryCollectBindings(prepared, expr->data.notExpr.expr);
+		case CXQueryExprBinary:
+			return CXQueryCollectBindings(prepared, expr->data.binary.left) &&
+				CXQueryCollectBindings(prepared, expr->data.binary.right);
+		default:
+			return CXTrue;
 	}
+}
 
-	CXIndex *matches = NULL;
-	CXSize matchCount = 0;
-	CXSize matchCapacity = 0;
-	for (CXIndex idx = 0; idx < network->edgeCapacity; idx++) {
-		if (!network->edgeActive[idx]) {
-			continue;
+/* A plan stays valid while every attribute it was bound to is still the one
+ * registered under its name with the same layout. Value writes bump versions
+ * but the kernels read the live buffers, so only categorical columns, whose
+ * labels were resolved to ids at compile time, are also checked by version. */
+static CXBool CXQueryBindingsAreCurrent(CXPreparedQueryRef prepared) {
+	if (!prepared->expr) {
+		return CXFalse;
+	}
+	for (CXSize i = 0; i < prepared->bindingCount; i++) {
+		const CXQueryBinding *binding = &prepared->bindings[i];
+		CXAttributeRef current = NULL;
+		if (!CXQueryResolveAttributeByName(prepared->network, binding->scope, binding->name, &current) ||
+			current != binding->attribute ||
+			current->type != binding->type ||
+			current->dimension != binding->dimension ||
+			current->categoricalDictionary != binding->categoricalDictionary) {
+			return CXFalse;
 		}
-		if (CXQueryEvaluateEdgeExpr(network, expr, idx)) {
-			CXGrowArrayAddElement(idx, sizeof(CXIndex), matchCount, matchCapacity, matches);
+		if ((current->type == CXDataAttributeCategoryType || current->type == CXDataAttributeMultiCategoryType) &&
+			current->version != binding->version) {
+			return CXFalse;
 		}
 	}
-	CXIndex dummy = 0;
-	const CXIndex *input = matches ? matches : &dummy;
-	if (!CXEdgeSelectorFillFromArray(selector, input, matchCount)) {
-		free(matches);
-		CXQuerySetError("Failed to populate selector", 0);
-		CXQueryFreeExpr(expr);
-		CXQueryTokenFree(&parser.current);
+	return CXTrue;
+}
+
+static CXBool CXQueryRebind(CXPreparedQueryRef prepared) {
+	CXQueryFreeExpr(prepared->expr);
+	prepared->expr = NULL;
+	prepared->bindingCount = 0;
+	CXQueryExpr *expr = CXQueryBuild(prepared->network, prepared->text, prepared->scope);
+	if (!expr) {
+		return CXFalse;
+	}
+	prepared->expr = expr;
+	if (!CXQueryCollectBindings(prepared, expr)) {
+		CXQueryFreeExpr(prepared->expr);
+		prepared->expr = NULL;
+		prepared->bindingCount = 0;
+		CXQuerySetError("Out of memory", 0);
 		return CXFalse;
 	}
-	free(matches);
-	CXQueryFreeExpr(expr);
-	CXQueryTokenFree(&parser.current);
 	return CXTrue;
 }
 
+CXPreparedQueryRef CXQueryPrepare(CXNetworkRef network, CXAttributeScope scope, const CXString query) {
+	CXQueryClearError();
+	if (!network || !query) {
+		CXQuerySetError("Network or query missing", 0);
+		return NULL;
+	}
+	if (scope != CXAttributeScopeNode && scope != CXAttributeScopeEdge) {
+		CXQuerySetError("Queries select nodes or edges", 0);
+		return NULL;
+	}
+	CXPreparedQueryRef prepared = calloc(1, sizeof(struct CXPreparedQuery));
+	if (!prepared) {
+		CXQuerySetError("Out of memory", 0);
+		return NULL;
+	}
+	prepared->network = network;
+	prepared->scope = scope;
+	prepared->text = CXNewStringFromString(query);
+	if (!prepared->text) {
+		CXQuerySetError("Out of memory", 0);
+		CXQueryFree(prepared);
+		return NULL;
+	}
+	if (!CXQueryRebind(prepared)) {
+		CXQueryFree(prepared);
+		return NULL;
+	}
+	return prepared;
+}
+
+CXBool CXQueryExecute(CXPreparedQueryRef prepared, CXSelector *selector) {
+	CXQueryClearError();
+	if (!prepared || !selector) {
+		CXQuerySetError("Prepared query or selector missing", 0);
+		return CXFalse;
+	}
+	if (!CXQueryBindingsAreCurrent(prepared) && !CXQueryRebind(prepared)) {
+		return CXFalse;
+	}
+	return CXQueryRun(prepared->network, prepared->expr, prepared->scope, selector);
+}
+
+CXAttributeScope CXQueryScope(CXPreparedQueryRef prepared) {
+	return prepared ? prepared->scope : CXAttributeScopeNode;
+}
+
+void CXQueryFree(CXPreparedQueryRef prepared) {
+	if (!prepared) {
+		return;
+	}
+	CXQueryFreeExpr(prepared->expr);
+	free(prepared->bindings);
+	free(prepared->text);
+	free(prepared);
+}
+
 CXBool CXNetworkSelectNodesByQuery(CXNetworkRef network, const CXString query, CXNodeSelectorRef selector) {
 	CXQueryClearError();
-	return CXQuerySelectNodes(network, query, selector);
+	return CXQuerySelect(network, query, CXAttributeScopeNode, selector);
 }
 
 CXBool CXNetworkSelectEdgesByQuery(CXNetworkRef network, const CXString query, CXEdgeSelectorRef selector) {
 	CXQueryClearError();
-	return CXQuerySelectEdges(network, query, selector);
+	return CXQuerySelect(network, query, CXAttributeScopeEdge, selector);
 }
@@ -0,0 +1,377 @@
+//
+//  CXNetworkSnapshot.c
+//  Helios Network Core
+//
+
+#include "CXNetwork.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define CX_SNAPSHOT_MIN_GRAIN 1024u
+
+typedef struct {
+	CXNetworkRef network;
+	CXNetworkSnapshot *snapshot;
+	CXBool inbound;
+	CXIndex *counts;
+} CXNetworkSnapshotBuildTask;
+
+typedef struct {
+	const CXIndex *edges;
+	double *weights;
+	const CXAttribute *attribute;
+} CXNetworkSnapshotWeightTask;
+
+static CXSize CXNetworkSnapshotGrain(CXSize count, CXSize workerCount) {
+	CXSize grain = count / (CXMAX((CXSize)1, workerCount) * 8u);
+	return CXMAX(grain, (CXSize)CX_SNAPSHOT_MIN_GRAIN);
+}
+
+static void CXNetworkSnapshotFree(CXNetworkSnapshot *snapshot) {
+	if (!snapshot) {
+		return;
+	}
+	CXNetworkSnapshotWeights *column = snapshot->weights;
+	while (column) {
+		CXNetworkSnapshotWeights *next = column->next;
+		column->next = NULL;
+		CXNetworkSnapshotWeightsRelease(column);
+		column = next;
+	}
+	free(snapshot->compactToNode);
+	free(snapshot->nodeToCompact);
+	free(snapshot->outOffsets);
+	free(snapshot->outNeighbors);
+	free(snapshot->outEdges);
+	free(snapshot->inOffsets);
+	free(snapshot->inNeighbors);
+	free(snapshot->inEdges);
+	free(snapshot);
+}
+
+static CXNeighborContainer *CXNetworkSnapshotContainer(CXNetworkRef network, CXIndex node, CXBool inbound) {
+	return inbound ? &network->nodes[node].inNeighbors : &network->nodes[node].outNeighbors;
+}
+
+static void CXNetworkSnapshotCountRange(void *context, CXIndex start, CXIndex end, CXSize workerIndex) {
+	(void)workerIndex;
+	CXNetworkSnapshotBuildTask *task = (CXNetworkSnapshotBuildTask *)context;
+	CXNetworkRef network = task->network;
+	const CXNetworkSnapshot *snapshot = task->snapshot;
+	for (CXIndex u = start; u < end; u++) {
+		CXIndex count = 0;
+		CXNeighborIterator iterator;
+		CXNeighborIteratorInit(&iterator, CXNetworkSnapshotContainer(network, snapshot->compactToNode[u], task->inbound));
+		while (CXNeighborIteratorNext(&iterator)) {
+			CXIndex neighbor = iterator.node;
+			if (neighbor < snapshot->nodeCapacity && snapshot->nodeToCompact[neighbor] != CXIndexMAX) {
+				count++;
+			}
+		}
+		task->counts[u + 1] = count;
+	}
+}
+
+static void CXNetworkSnapshotFillRange(void *context, CXIndex start, CXIndex end, CXSize workerIndex) {
+	(void)workerIndex;
+	CXNetworkSnapshotBuildTask *task = (CXNetworkSnapshotBuildTask *)context;
+	CXNetworkRef network = task->network;
+	CXNetworkSnapshot *snapshot = task->snapshot;
+	CXIndex *neighbors = task->inbound ? snapshot->inNeighbors : snapshot->outNeighbors;
+	CXIndex *edges = task->inbound ? snapshot->inEdges : snapshot->outEdges;
+	for (CXIndex u = start; u < end; u++) {
+		CXIndex cursor = task->counts[u];
+		CXNeighborIterator iterator;
+		CXNeighborIteratorInit(&iterator, CXNetworkSnapshotContainer(network, snapshot->compactToNode[u], task->inbound));
+		while (CXNeighborIteratorNext(&iterator)) {
+			CXIndex neighbor = iterator.node;
+			if (neighbor >= snapshot->nodeCapacity) {
+				continue;
+			}
+			CXIndex v = snapshot->nodeToCompact[neighbor];
+			if (v == CXIndexMAX) {
+				continue;
+			}
+			neighbors[cursor] = v;
+			edges[cursor] = iterator.edge;
+			cursor++;
+		}
+	}
+}
+
+static CXBool CXNetworkSnapshotBuildDirection(CXNetworkRef network, CXNetworkSnapshot *snapshot, CXBool inbound, CXSize workerCount) {
+	CXIndex *offsets = (CXIndex *)calloc(snapshot->nodeCount + 1, sizeof(CXIndex));
+	if (!offsets) {
+		return CXFalse;
+	}
+	CXNetworkSnapshotBuildTask task = {
+		.network = network,
+		.snapshot = snapshot,
+		.inbound = inbound,
+		.counts = offsets
+	};
+	CXSize grain = CXNetworkSnapshotGrain(snapshot->nodeCount, workerCount);
+	CXParallelForRange(snapshot->nodeCount, grain, workerCount, CXNetworkSnapshotCountRange, &task);
+	for (CXSize u = 0; u < snapshot->nodeCount; u++) {
+		offsets[u + 1] += offsets[u];
+	}
+	CXSize edgeCount = offsets[snapshot->nodeCount];
+	CXIndex *neighbors = edgeCount ? (CXIndex *)malloc(edgeCount * sizeof(CXIndex)) : NULL;
+	CXIndex *edges = edgeCount ? (CXIndex *)malloc(edgeCount * sizeof(CXIndex)) : NULL;
+	if (edgeCount && (!neighbors || !edges)) {
+		free(offsets);
+		free(neighbors);
+		free(edges);
+		return CXFalse;
+	}
+	if (inbound) {
+		snapshot->inOffsets = offsets;
+		snapshot->inNeighbors = neighbors;
+		snapshot->inEdges = edges;
+		snapshot->inEdgeCount = edgeCount;
+	} else {
+		snapshot->outOffsets = offsets;
+		snapshot->outNeighbors = neighbors;
+		snapshot->outEdges = edges;
+		snapshot->outEdgeCount = edgeCount;
+	}
+	CXParallelForRange(snapshot->nodeCount, grain, workerCount, CXNetworkSnapshotFillRange, &task);
+	return CXTrue;
+}
+
+static CXNetworkSnapshot *CXNetworkSnapshotBuild(CXNetworkRef network) {
+	CXNetworkSnapshot *snapshot = (CXNetworkSnapshot *)calloc(1, sizeof(CXNetworkSnapshot));
+	if (!snapshot) {
+		return NULL;
+	}
+	snapshot->referenceCount = 1;
+	snapshot->nodeTopologyVersion = network->nodeTopologyVersion;
+	snapshot->edgeTopologyVersion = network->edgeTopologyVersion;
+	snapshot->directed = network->isDirected;
+	snapshot->nodeCapacity = network->nodeCapacity;
+	for (CXIndex node = 0; node < network->nodeCapacity; node++) {
+		if (network->nodeActive[node]) {
+			snapshot->nodeCount += 1;
+		}
+	}
+
+	snapshot->compactToNode = (CXIndex *)malloc(CXMAX(snapshot->nodeCount, (CXSize)1) * sizeof(CXIndex));
+	snapshot->nodeToCompact = (CXIndex *)malloc(CXMAX(snapshot->nodeCapacity, (CXSize)1) * sizeof(CXIndex));
+	if (!snapshot->compactToNode || !snapshot->nodeToCompact) {
+		CXNetworkSnapshotFree(snapshot);
+		return NULL;
+	}
+	CXIndex cursor = 0;
+	for (CXIndex node = 0; node < network->nodeCapacity; node++) {
+		if (network->nodeActive[node]) {
+			snapshot->compactToNode[cursor] = node;
+			snapshot->nodeToCompact[node] = cursor;
+			cursor += 1;
+		} else {
+			snapshot->nodeToCompact[node] = CXIndexMAX;
+		}
+	}
+
+	CXSize workerCount = CXParallelWorkerCount(snapshot->nodeCount);
+	if (!CXNetworkSnapshotBuildDirection(network, snapshot, CXFalse, workerCount)
+		|| !CXNetworkSnapshotBuildDirection(network, snapshot, CXTrue, workerCount)) {
+		CXNetworkSnapshotFree(snapshot);
+		return NULL;
+	}
+	return snapshot;
+}
+
+CXNetworkSnapshotRef CXNetworkSnapshotAcquire(CXNetworkRef network) {
+	if (!network) {
+		return NULL;
+	}
+	CXNetworkSnapshot *snapshot = network->snapshot;
+	if (snapshot
+		&& snapshot->nodeTopologyVersion == network->nodeTopologyVersion
+		&& snapshot->edgeTopologyVersion == network->edgeTopologyVersion
+		&& snapshot->nodeCapacity == network->nodeCapacity) {
+		snapshot->referenceCount += 1;
+		return snapshot;
+	}
+	CXNetworkSnapshotInvalidate(network);
+	snapshot = CXNetworkSnapshotBuild(network);
+	if (!snapshot) {
+		return NULL;
+	}
+	network->snapshot = snapshot;
+	snapshot->referenceCount += 1;
+	return snapshot;
+}
+
+void CXNetworkSnapshotRelease(CXNetworkSnapshotRef snapshot) {
+	if (!snapshot) {
+		return;
+	}
+	if (snapshot->referenceCount > 1) {
+		snapshot->referenceCount -= 1;
+		return;
+	}
+	CXNetworkSnapshotFree(snapshot);
+}
+
+void CXNetworkSnapshotInvalidate(CXNetworkRef network) {
+	if (!network || !network->snapshot) {
+		return;
+	}
+	CXNetworkSnapshot *snapshot = network->snapshot;
+	network->snapshot = NULL;
+	CXNetworkSnapshotRelease(snapshot);
+}
+
+static double CXNetworkSnapshotReadWeight(const CXAttribute *attribute, CXIndex edge) {
+	const uint8_t *ptr = attribute->data + (size_t)edge * attribute->stride;
+	switch (attribute->type) {
+		case CXFloatAttributeType: {
+			float value = 0.0f;
+			memcpy(&value, ptr, sizeof(float));
+			return (double)value;
+		}
+		case CXDoubleAttributeType: {
+			double value = 0.0;
+			memcpy(&value, ptr, sizeof(double));
+			return value;
+		}
+		case CXIntegerAttributeType: {
+			int32_t value = 0;
+			memcpy(&value, ptr, sizeof(int32_t));
+			return (double)value;
+		}
+		case CXUnsignedIntegerAttributeType:
+		case CXDataAttributeCategoryType: {
+			uint32_t value = 0;
+			memcpy(&value, ptr, sizeof(uint32_t));
+			return (double)value;
+		}
+		case CXBigIntegerAttributeType: {
+			int64_t value = 0;
+			memcpy(&value, ptr, sizeof(int64_t));
+			return (double)value;
+		}
+		case CXUnsignedBigIntegerAttributeType: {
+			uint64_t value = 0;
+			memcpy(&value, ptr, sizeof(uint64_t));
+			return (double)value;
+		}
+		default:
+			return 0.0;
+	}
+}
+
+static CXBool CXNetworkSnapshotWeightTypeSupported(CXAttributeType type) {
+	switch (type) {
+		case CXFloatAttributeType:
+		case CXDoubleAttributeType:
+		case CXIntegerAttributeType:
+		case CXUnsignedIntegerAttributeType:
+		case CXDataAttributeCategoryType:
+		case CXBigIntegerAttributeType:
+		case CXUnsignedBigIntegerAttributeType:
+			return CXTrue;
+		default:
+			return CXFalse;
+	}
+}
+
+static void CXNetworkSnapshotWeightRange(void *context, CXIndex start, CXIndex end, CXSize workerIndex) {
+	(void)workerIndex;
+	CXNetworkSnapshotWeightTask *task = (CXNetworkSnapshotWeightTask *)context;
+	if (!task->attribute) {
+		for (CXIndex i = start; i < end; i++) {
+			task->weights[i] = 1.0;
+		}
+		return;
+	}
+	for (CXIndex i = start; i < end; i++) {
+		task->weights[i] = CXNetworkSnapshotReadWeight(task->attribute, task->edges[i]);
+	}
+}
+
+static CXBool CXNetworkSnapshotFillWeights(double *weights, const CXIndex *edges, CXSize count, const CXAttribute *attribute) {
+	if (count == 0) {
+		return CXTrue;
+	}
+	if (!weights) {
+		return CXFalse;
+	}
+	CXNetworkSnapshotWeightTask task = {
+		.edges = edges,
+		.weights = weights,
+		.attribute = attribute
+	};
+	CXSize workerCount = CXParallelWorkerCount(count);
+	CXParallelForRange(count, CXNetworkSnapshotGrain(count, workerCount), workerCount, CXNetworkSnapshotWeightRange, &task);
+	return CXTrue;
+}
+
+CXNetworkSnapshotWeightsRef CXNetworkSnapshotAcquireWeights(
+	CXNetworkSnapshotRef snapshot,
+	CXNetworkRef network,
+	const CXString edgeWeightAttribute
+) {
+	if (!snapshot || !network || network->snapshot != snapshot) {
+		return NULL;
+	}
+	const CXAttribute *attribute = NULL;
+	if (edgeWeightAttribute && edgeWeightAttribute[0]) {
+		attribute = CXNetworkGetEdgeAttribute(network, edgeWeightAttribute);
+		if (!attribute || !attribute->data || attribute->dimension != 1 || !CXNetworkSnapshotWeightTypeSupported(attribute->type)) {
+			return NULL;
+		}
+	}
+
+	CXNetworkSnapshotWeights **link = &snapshot->weights;
+	while (*link) {
+		CXNetworkSnapshotWeights *column = *link;
+		if (column->attribute == attribute) {
+			if (!attribute || (column->data == attribute->data && column->version == attribute->version)) {
+				column->referenceCount += 1;
+				return column;
+			}
+			/* Superseded version: unlink it; current holders keep it alive. */
+			*link = column->next;
+			column->next = NULL;
+			CXNetworkSnapshotWeightsRelease(column);
+			continue;
+		}
+		link = &column->next;
+	}
+
+	CXNetworkSnapshotWeights *column = (CXNetworkSnapshotWeights *)calloc(1, sizeof(CXNetworkSnapshotWeights));
+	if (!column) {
+		return NULL;
+	}
+	column->referenceCount = 1;
+	column->attribute = attribute;
+	column->data = attribute ? attribute->data : NULL;
+	column->version = attribute ? attribute->version : 0;
+	column->outWeights = snapshot->outEdgeCount ? (double *)malloc(snapshot->outEdgeCount * sizeof(double)) : NULL;
+	column->inWeights = snapshot->inEdgeCount ? (double *)malloc(snapshot->inEdgeCount * sizeof(double)) : NULL;
+	if (!CXNetworkSnapshotFillWeights(column->outWeights, snapshot->outEdges, snapshot->outEdgeCount, attribute)
+		|| !CXNetworkSnapshotFillWeights(column->inWeights, snapshot->inEdges, snapshot->inEdgeCount, attribute)) {
+		CXNetworkSnapshotWeightsRelease(column);
+		return NULL;
+	}
+	column->next = snapshot->weights;
+	snapshot->weights = column;
+	column->referenceCount += 1;
+	return column;
+}
+
+void CXNetworkSnapshotWeightsRelease(CXNetworkSnapshotWeightsRef weights) {
+	if (!weights) {
+		return;
+	}
+	if (weights->referenceCount > 1) {
+		weights->referenceCount -= 1;
+		return;
+	}
+	free(weights->outWeights);
+	free(weights->inWeights);
+	free(weights);
+}
@@ -0,0 +1,453 @@
+//
+//  CXNetworkTraversal.c
+//  Helios Network Core
+//
+
+#include "CXNetwork.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/* Switching thresholds from Beamer et al.: go bottom-up once the frontier
+ * owns more than 1/ALPHA of the unexplored edges, return to top-down when it
+ * shrinks below 1/BETA of the nodes. */
+#define CX_TRAVERSAL_ALPHA 14u
+#define CX_TRAVERSAL_BETA 24u
+#define CX_TRAVERSAL_MIN_GRAIN 4096u
+
+typedef struct {
+	CXTraversalBFS *bfs;
+	uint32_t level;
+} CXTraversalBottomUpTask;
+
+static CXSize CXTraversalWordCount(CXSize nodeCount) {
+	return (nodeCount + 63u) / 64u;
+}
+
+static void CXTraversalAdjacencyInit(
+	CXTraversalAdjacency *adjacency,
+	CXNetworkSnapshotRef snapshot,
+	CXBool followOut,
+	CXBool followIn
+) {
+	memset(adjacency, 0, sizeof(*adjacency));
+	adjacency->nodeCount = snapshot->nodeCount;
+	if (!snapshot->directed) {
+		if (!followOut && !followIn) {
+			return;
+		}
+		/* Undirected edges already appear in both endpoints' out lists. */
+		adjacency->listCount = 1;
+		adjacency->forwardOffsets[0] = snapshot->outOffsets;
+		adjacency->forwardNeighbors[0] = snapshot->outNeighbors;
+		adjacency->backwardOffsets[0] = snapshot->outOffsets;
+		adjacency->backwardNeighbors[0] = snapshot->outNeighbors;
+		adjacency->edgeCount = snapshot->outEdgeCount;
+		return;
+	}
+	if (followOut) {
+		CXSize list = adjacency->listCount++;
+		adjacency->forwardOffsets[list] = snapshot->outOffsets;
+		adjacency->forwardNeighbors[list] = snapshot->outNeighbors;
+		adjacency->backwardOffsets[list] = snapshot->inOffsets;
+		adjacency->backwardNeighbors[list] = snapshot->inNeighbors;
+		adjacency->edgeCount += snapshot->outEdgeCount;
+	}
+	if (followIn) {
+		CXSize list = adjacency->listCount++;
+		adjacency->forwardOffsets[list] = snapshot->inOffsets;
+		adjacency->forwardNeighbors[list] = snapshot->inNeighbors;
+		adjacency->backwardOffsets[list] = snapshot->outOffsets;
+		adjacency->backwardNeighbors[list] = snapshot->outNeighbors;
+		adjacency->edgeCount += snapshot->inEdgeCount;
+	}
+}
+
+static inline CXSize CXTraversalForwardDegree(const CXTraversalAdjacency *adjacency, CXIndex node) {
+	CXSize degree = 0;
+	for (CXSize list = 0; list < adjacency->listCount; list++) {
+		degree += adjacency->forwardOffsets[list][node + 1] - adjacency->forwardOffsets[list][node];
+	}
+	return degree;
+}
+
+// Single-source traversal -----------------------------------------------------
+
+CXBool CXTraversalBFSInit(
+	CXTraversalBFS *bfs,
+	CXNetworkSnapshotRef snapshot,
+	CXBool followOut,
+	CXBool followIn,
+	CXSize workerCount
+) {
+	if (!bfs) {
+		return CXFalse;
+	}
+	memset(bfs, 0, sizeof(*bfs));
+	if (!snapshot) {
+		return CXFalse;
+	}
+	bfs->snapshot = snapshot;
+	CXTraversalAdjacencyInit(&bfs->adjacency, snapshot, followOut, followIn);
+	bfs->workerCount = CXMAX(workerCount, (CXSize)1);
+
+	CXSize n = snapshot->nodeCount;
+	CXSize words = CXMAX(CXTraversalWordCount(n), (CXSize)1);
+	bfs->distances = (uint32_t *)malloc(CXMAX(n, (CXSize)1) * sizeof(uint32_t));
+	bfs->order = (CXIndex *)malloc(CXMAX(n, (CXSize)1) * sizeof(CXIndex));
+	bfs->levelOffsets = (CXIndex *)calloc(n + 2, sizeof(CXIndex));
+	bfs->frontierBits = (uint64_t *)calloc(words, sizeof(uint64_t));
+	bfs->nextBits = (uint64_t *)calloc(words, sizeof(uint64_t));
+	if (!bfs->distances || !bfs->order || !bfs->levelOffsets || !bfs->frontierBits || !bfs->nextBits) {
+		CXTraversalBFSDestroy(bfs);
+		return CXFalse;
+	}
+	for (CXSize u = 0; u < n; u++) {
+		bfs->distances[u] = CX_TRAVERSAL_UNVISITED;
+	}
+	return CXTrue;
+}
+
+void CXTraversalBFSDestroy(CXTraversalBFS *bfs) {
+	if (!bfs) {
+		return;
+	}
+	free(bfs->distances);
+	free(bfs->order);
+	free(bfs->levelOffsets);
+	free(bfs->frontierBits);
+	free(bfs->nextBits);
+	memset(bfs, 0, sizeof(*bfs));
+}
+
+/* Expands the frontier list and appends newly reached nodes in discovery
+ * order. Returns the forward degree of the appended nodes. */
+static CXSize CXTraversalTopDownStep(CXTraversalBFS *bfs, CXIndex frontierStart, CXIndex frontierEnd, uint32_t level) {
+	const CXTraversalAdjacency *adjacency = &bfs->adjacency;
+	CXSize discoveredEdges = 0;
+	for (CXIndex i = frontierStart; i < frontierEnd; i++) {
+		CXIndex u = bfs->order[i];
+		for (CXSize list = 0; list < adjacency->listCount; list++) {
+			const CXIndex *offsets = adjacency->forwardOffsets[list];
+			const CXIndex *neighbors = adjacency->forwardNeighbors[list];
+			for (CXIndex idx = offsets[u]; idx < offsets[u + 1]; idx++) {
+				CXIndex w = neighbors[idx];
+				if (bfs->distances[w] != CX_TRAVERSAL_UNVISITED) {
+					continue;
+				}
+				bfs->distances[w] = level + 1;
+				bfs->order[bfs->visitedCount++] = w;
+				discoveredEdges += CXTraversalForwardDegree(adjacency, w);
+			}
+		}
+	}
+	return discoveredEdges;
+}
+
+/* Blocks are multiples of 64 nodes, so every worker owns whole words of
+ * `nextBits` and writes the distances of its own nodes only. */
+static void CXTraversalBottomUpRange(void *context, CXIndex start, CXIndex end, CXSize workerIndex) {
+	(void)workerIndex;
+	CXTraversalBottomUpTask *task = (CXTraversalBottomUpTask *)context;
+	CXTraversalBFS *bfs = task->bfs;
+	const CXTraversalAdjacency *adjacency = &bfs->adjacency;
+	const uint64_t *frontierBits = bfs->frontierBits;
+	for (CXIndex v = start; v < end; v++) {
+		if (bfs->distances[v] != CX_TRAVERSAL_UNVISITED) {
+			continue;
+		}
+		CXBool found = CXFalse;
+		for (CXSize list = 0; list < adjacency->listCount && !found; list++) {
+			const CXIndex *offsets = adjacency->backwardOffsets[list];
+			const CXIndex *neighbors = adjacency->backwardNeighbors[list];
+			for (CXIndex idx = offsets[v]; idx < offsets[v + 1]; idx++) {
+				CXIndex u = neighbors[idx];
+				if (frontierBits[u >> 6] & (UINT64_C(1) << (u & 63u))) {
+					found = CXTrue;
+					break;
+				}
+			}
+		}
+		if (found) {
+			bfs->distances[v] = task->level + 1;
+			bfs->nextBits[v >> 6] |= UINT64_C(1) << (v & 63u);
+		}
+	}
+}
+
+/* Lets every unvisited node search its parents in the frontier bitmap, then
+ * appends the discovered nodes in ascending id order. Returns the forward
+ * degree of the appended nodes. */
+static CXSize CXTraversalBottomUpStep(CXTraversalBFS *bfs, CXIndex frontierStart, CXIndex frontierEnd, uint32_t level) {
+	CXSize n = bfs->adjacency.nodeCount;
+	for (CXIndex i = frontierStart; i < frontierEnd; i++) {
+		CXIndex u = bfs->order[i];
+		bfs->frontierBits[u >> 6] |= UINT64_C(1) << (u & 63u);
+	}
+
+	CXTraversalBottomUpTask task = {
+		.bfs = bfs,
+		.level = level
+	};
+	CXSize grain = CXMAX((CXSize)CX_TRAVERSAL_MIN_GRAIN, n / (bfs->workerCount * 8u));
+	grain = (grain + 63u) & ~(CXSize)63u;
+	CXParallelForRange(n, grain, bfs->workerCount, CXTraversalBottomUpRange, &task);
+
+	CXSize discoveredEdges = 0;
+	CXSize words = CXTraversalWordCount(n);
+	for (CXSize word = 0; word < words; word++) {
+		uint64_t bits = bfs->nextBits[word];
+		if (!bits) {
+			continue;
+		}
+		bfs->nextBits[word] = 0;
+		while (bits) {
+			CXIndex v = (CXIndex)(word * 64u + CXTraversalLowestBit(bits));
+			bits &= bits - 1;
+			bfs->order[bfs->visitedCount++] = v;
+			discoveredEdges += CXTraversalForwardDegree(&bfs->adjacency, v);
+		}
+	}
+
+	for (CXIndex i = frontierStart; i < frontierEnd; i++) {
+		CXIndex u = bfs->order[i];
+		bfs->frontierBits[u >> 6] = 0;
+	}
+	return discoveredEdges;
+}
+
+CXSize CXTraversalBFSRun(
+	CXTraversalBFS *bfs,
+	const CXIndex *sources,
+	CXSize sourceCount,
+	CXSize maxLevel
+) {
+	if (!bfs || !bfs->distances) {
+		return 0;
+	}
+	const CXTraversalAdjacency *adjacency = &bfs->adjacency;
+	CXSize n = adjacency->nodeCount;
+	for (CXSize i = 0; i < bfs->visitedCount; i++) {
+		bfs->distances[bfs->order[i]] = CX_TRAVERSAL_UNVISITED;
+	}
+	bfs->visitedCount = 0;
+	bfs->levelCount = 0;
+	bfs->levelOffsets[0] = 0;
+
+	CXSize exploredEdges = 0;
+	for (CXSize i = 0; sources && i < sourceCount; i++) {
+		CXIndex source = sources[i];
+		if (source >= n || bfs->distances[source] != CX_TRAVERSAL_UNVISITED) {
+			continue;
+		}
+		bfs->distances[source] = 0;
+		bfs->order[bfs->visitedCount++] = source;
+		exploredEdges += CXTraversalForwardDegree(adjacency, source);
+	}
+	if (bfs->visitedCount == 0) {
+		return 0;
+	}
+	bfs->levelOffsets[1] = bfs->visitedCount;
+	bfs->levelCount = 1;
+
+	CXSize remainingEdges = adjacency->edgeCount - CXMIN(exploredEdges, adjacency->edgeCount);
+	CXSize frontierEdges = exploredEdges;
+	CXBool bottomUp = CXFalse;
+	if (maxLevel > (CXSize)UINT32_MAX - 1) {
+		maxLevel = (CXSize)UINT32_MAX - 1;
+	}
+	for (CXSize level = 0; level < maxLevel && adjacency->listCount > 0; level++) {
+		CXIndex frontierStart = bfs->levelOffsets[level];
+		CXIndex frontierEnd = bfs->levelOffsets[level + 1];
+		if (frontierStart == frontierEnd) {
+			break;
+		}
+		CXSize frontierSize = frontierEnd - frontierStart;
+		if (!bottomUp && frontierEdges > remainingEdges / CX_TRAVERSAL_ALPHA) {
+			bottomUp = CXTrue;
+		} else if (bottomUp && frontierSize < n / CX_TRAVERSAL_BETA) {
+			bottomUp = CXFalse;
+		}
+
+		if (bottomUp) {
+			frontierEdges = CXTraversalBottomUpStep(bfs, frontierStart, frontierEnd, (uint32_t)level);
+			bfs->bottomUpSteps++;
+		} else {
+			frontierEdges = CXTraversalTopDownStep(bfs, frontierStart, frontierEnd, (uint32_t)level);
+			bfs->topDownSteps++;
+		}
+		remainingEdges -= CXMIN(frontierEdges, remainingEdges);
+		if (bfs->visitedCount == frontierEnd) {
+			break;
+		}
+		bfs->levelOffsets[level + 2] = bfs->visitedCount;
+		bfs->levelCount++;
+	}
+	return bfs->visitedCount;
+}
+
+// Multi-source traversal ------------------------------------------------------
+
+CXBool CXTraversalMultiBFSInit(
+	CXTraversalMultiBFS *bfs,
+	CXNetworkSnapshotRef snapshot,
+	CXBool followOut,
+	CXBool followIn
+) {
+	if (!bfs) {
+		return CXFalse;
+	}
+	memset(bfs, 0, sizeof(*bfs));
+	if (!snapshot) {
+		return CXFalse;
+	}
+	bfs->snapshot = snapshot;
+	CXTraversalAdjacencyInit(&bfs->adjacency, snapshot, followOut, followIn);
+
+	CXSize n = CXMAX(snapshot->nodeCount, (CXSize)1);
+	bfs->seen = (uint64_t *)calloc(n, sizeof(uint64_t));
+	bfs->visit = (uint64_t *)calloc(n, sizeof(uint64_t));
+	bfs->visitNext = (uint64_t *)calloc(n, sizeof(uint64_t));
+	bfs->frontier = (CXIndex *)malloc(n * sizeof(CXIndex));
+	bfs->next = (CXIndex *)malloc(n * sizeof(CXIndex));
+	bfs->touched = (CXIndex *)malloc(n * sizeof(CXIndex));
+	if (!bfs->seen || !bfs->visit || !bfs->visitNext || !bfs->frontier || !bfs->next || !bfs->touched) {
+		CXTraversalMultiBFSDestroy(bfs);
+		return CXFalse;
+	}
+	return CXTrue;
+}
+
+void CXTraversalMultiBFSDestroy(CXTraversalMultiBFS *bfs) {
+	if (!bfs) {
+		return;
+	}
+	free(bfs->seen);
+	free(bfs->visit);
+	free(bfs->visitNext);
+	free(bfs->frontier);
+	free(bfs->next);
+	free(bfs->touched);
+	memset(bfs, 0, sizeof(*bfs));
+}
+
+CXBool CXTraversalMultiBFSRun(
+	CXTraversalMultiBFS *bfs,
+	const CXIndex *sources,
+	CXSize sourceCount,
+	CXSize maxLevel,
+	CXTraversalVisitFunction visit,
+	void *context
+) {
+	if (!bfs || !bfs->seen || !visit || (sourceCount > 0 && !sources) || sourceCount > CX_TRAVERSAL_BATCH_SIZE) {
+		return CXFalse;
+	}
+	const CXTraversalAdjacency *adjacency = &bfs->adjacency;
+	CXSize n = adjacency->nodeCount;
+	for (CXSize i = 0; i < bfs->touchedCount; i++) {
+		bfs->seen[bfs->touched[i]] = 0;
+	}
+	bfs->touchedCount = 0;
+	if (sourceCount == 0) {
+		return CXTrue;
+	}
+	const uint64_t allSources = sourceCount == 64u ? UINT64_MAX : ((UINT64_C(1) << sourceCount) - 1u);
+
+	CXSize frontierCount = 0;
+	for (CXSize i = 0; i < sourceCount; i++) {
+		CXIndex source = sources[i];
+		if (source >= n) {
+			continue;
+		}
+		if (!bfs->seen[source]) {
+			bfs->touched[bfs->touchedCount++] = source;
+		}
+		if (!bfs->visit[source]) {
+			bfs->frontier[frontierCount++] = source;
+		}
+		bfs->seen[source] |= UINT64_C(1) << i;
+		bfs->visit[source] |= UINT64_C(1) << i;
+	}
+	for (CXSize i = 0; i < frontierCount; i++) {
+		visit(context, bfs->frontier[i], 0, bfs->visit[bfs->frontier[i]]);
+	}
+
+	for (CXSize level = 0; level < maxLevel && frontierCount > 0 && adjacency->listCount > 0; level++) {
+		CXSize frontierEdges = 0;
+		for (CXSize i = 0; i < frontierCount; i++) {
+			frontierEdges += CXTraversalForwardDegree(adjacency, bfs->frontier[i]);
+		}
+
+		CXSize nextCount = 0;
+		if (frontierEdges > adjacency->edgeCount / CX_TRAVERSAL_ALPHA) {
+			/* Bottom-up: gather the frontier bits of every parent; a node stops
+			 * scanning once all sources that still miss it have been found. */
+			for (CXIndex v = 0; v < n; v++) {
+				uint64_t missing = allSources & ~bfs->seen[v];
+				if (!missing) {
+					continue;
+				}
+				uint64_t reached = 0;
+				for (CXSize list = 0; list < adjacency->listCount && reached != missing; list++) {
+					const CXIndex *offsets = adjacency->backwardOffsets[list];
+					const CXIndex *neighbors = adjacency->backwardNeighbors[list];
+					for (CXIndex idx = offsets[v]; idx < offsets[v + 1]; idx++) {
+						reached |= bfs->visit[neighbors[idx]] & missing;
+						if (reached == missing) {
+							break;
+						}
+					}
+				}
+				if (reached) {
+					bfs->visitNext[v] = reached;
+					bfs->next[nextCount++] = v;
+				}
+			}
+		} else {
+			for (CXSize i = 0; i < frontierCount; i++) {
+				CXIndex u = bfs->frontier[i];
+				uint64_t sourcesAtU = bfs->visit[u];
+				for (CXSize list = 0; list < adjacency->listCount; list++) {
+					const CXIndex *offsets = adjacency->forwardOffsets[list];
+					const CXIndex *neighbors = adjacency->forwardNeighbors[list];
+					for (CXIndex idx = offsets[u]; idx < offsets[u + 1]; idx++) {
+						CXIndex w = neighbors[idx];
+						uint64_t reached = sourcesAtU & ~bfs->seen[w];
+						if (!reached) {
+							continue;
+						}
+						if (!bfs->visitNext[w]) {
+							bfs->next[nextCount++] = w;
+						}
+						bfs->visitNext[w] |= reached;
+					}
+				}
+			}
+		}
+
+		for (CXSize i = 0; i < frontierCount; i++) {
+			bfs->visit[bfs->frontier[i]] = 0;
+		}
+		for (CXSize i = 0; i < nextCount; i++) {
+			CXIndex w = bfs->next[i];
+			uint64_t reached = bfs->visitNext[w];
+			if (!bfs->seen[w]) {
+				bfs->touched[bfs->touchedCount++] = w;
+			}
+			bfs->seen[w] |= reached;
+			visit(context, w, level + 1, reached);
+		}
+
+		uint64_t *swapBits = bfs->visit;
+		bfs->visit = bfs->visitNext;
+		bfs->visitNext = swapBits;
+		CXIndex *swapList = bfs->frontier;
+		bfs->frontier = bfs->next;
+		bfs->next = swapList;
+		frontierCount = nextCount;
+	}
+	for (CXSize i = 0; i < frontierCount; i++) {
+		bfs->visit[bfs->frontier[i]] = 0;
+	}
+	return CXTrue;
+}
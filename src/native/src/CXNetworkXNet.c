@@ -2,6 +2,7 @@
 
 #include "CXNetwork.h"
 #include "CXDictionary.h"
+#include "CXTextWriter.h"
 
 #include <ctype.h>
 #include <errno.h>
@@ -14,6 +15,13 @@
 #include <stdlib.h>
 #include <string.h>
 
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #define XNET_VERSION_STRING "1.0.0"
 #define XNET_HEADER_LINE "#XNET " XNET_VERSION_STRING
 #define XNET_LEGACY_CATEGORY_SUFFIX "__category"
@@ -94,8 +102,17 @@ typedef struct {
 	char *message;
 } XNetError;
 
+/*
+ * Lines are handed out in place from `data`, the whole file mapped
+ * copy-on-write (or read into memory where mapping is unavailable), so the
+ * reader never allocates per line. Lines stay valid for the parser lifetime.
+ */
 typedef struct {
-	FILE *file;
+	char *data;
+	size_t size;
+	size_t offset;
+	CXBool mapped;
+	char *tail;
 	size_t line;
 	XNetPendingLine pending;
 	CXBool legacy;
@@ -358,11 +375,102 @@ static CXBool XNetAttributeListHasName(const XNetAttributeList *list, const char
 	return CXFalse;
 }
 
-static char* XNetReadLine(FILE *file) {
+static CXBool XNetInputOpen(XNetParser *parser, const char *path) {
+#if !defined(_WIN32)
+	int fd = open(path, O_RDONLY);
+	if (fd < 0) {
+		return CXFalse;
+	}
+	struct stat info;
+	if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0 &&
+		(uint64_t)info.st_size <= (uint64_t)SIZE_MAX) {
+		size_t length = (size_t)info.st_size;
+		// Private and writable so lines can be NUL-terminated in place.
+		void *data = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+		if (data != MAP_FAILED) {
+			close(fd);
+#if defined(POSIX_MADV_SEQUENTIAL)
+			posix_madvise(data, length, POSIX_MADV_SEQUENTIAL);
+#endif
+			parser->data = data;
+			parser->size = length;
+			parser->mapped = CXTrue;
+			return CXTrue;
+		}
+	}
+	close(fd);
+#endif
+	FILE *file = fopen(path, "rb");
 	if (!file) {
+		return CXFalse;
+	}
+	size_t capacity = 1 << 16;
+	size_t length = 0;
+	char *data = malloc(capacity);
+	while (data) {
+		length += fread(data + length, 1, capacity - length - 1, file);
+		if (length < capacity - 1) {
+			break;
+		}
+		char *grown = realloc(data, capacity * 2);
+		if (!grown) {
+			free(data);
+			data = NULL;
+			break;
+		}
+		data = grown;
+		capacity *= 2;
+	}
+	CXBool failed = !data || ferror(file);
+	fclose(file);
+	if (failed) {
+		free(data);
+		return CXFalse;
+	}
+	data[length] = '\0';
+	parser->data = data;
+	parser->size = length;
+	parser->mapped = CXFalse;
+	return CXTrue;
+}
+
+static void XNetInputClose(XNetParser *parser) {
+#if !defined(_WIN32)
+	if (parser->mapped) {
+		munmap(parser->data, parser->size);
+	} else {
+		free(parser->data);
+	}
+#else
+	free(parser->data);
+#endif
+	free(parser->tail);
+	parser->data = NULL;
+	parser->tail = NULL;
+	parser->size = 0;
+	parser->offset = 0;
+	parser->mapped = CXFalse;
+}
+
+/*
+ * NUL-terminates the line [start, end). Only the last line of a mapping has
+ * no byte to spare after it; that one is copied out.
+ */
+static char* XNetTerminateLine(XNetParser *parser, char *start, char *end) {
+	if (end < parser->data + parser->size || !parser->mapped) {
+		*end = '\0';
+		return start;
+	}
+	size_t length = (size_t)(end - start);
+	char *copy = malloc(length + 1);
+	if (!copy) {
 		return NULL;
 	}
-	return CXNewStringReadingLine(file);
+	memcpy(copy, start, length);
+	copy[length] = '\0';
+	free(parser->tail);
+	parser->tail = copy;
+	return copy;
 }
 
 static char* XNetTrimTrailing(char *line) {
@@ -414,36 +522,56 @@ static CXBool XNetIsBlank(const char *line) {
 	return CXTrue;
 }
 
-static CXBool XNetGetLine(XNetParser *parser, char **outLine, size_t *outLineNumber) {
-	if (!parser || !outLine || !outLineNumber) {
+/*
+ * Returns the next line as [*outLine, *outEnd) without its newline. With
+ * `terminate` the line is also NUL-terminated; numeric sections skip that
+ * and parse the range directly, leaving the mapped pages untouched.
+ */
+static CXBool XNetGetLineRange(XNetParser *parser, CXBool terminate, char **outLine, char **outEnd, size_t *outLineNumber) {
+	if (!parser || !outLine || !outEnd || !outLineNumber) {
 		return CXFalse;
 	}
 	if (parser->pending.valid) {
 		*outLine = parser->pending.text;
+		*outEnd = parser->pending.text + strlen(parser->pending.text);
 		*outLineNumber = parser->pending.line;
 		parser->pending.valid = CXFalse;
 		parser->pending.text = NULL;
 		parser->pending.line = 0;
 		return CXTrue;
 	}
-	char *line = XNetReadLine(parser->file);
-	if (!line) {
+	if (parser->offset >= parser->size) {
 		return CXFalse;
 	}
+	char *start = parser->data + parser->offset;
+	char *newline = memchr(start, '\n', parser->size - parser->offset);
+	char *end = newline ? newline : parser->data + parser->size;
+	parser->offset = (size_t)(end - parser->data) + (newline ? 1 : 0);
 	parser->line++;
-	*outLine = line;
+	if (terminate) {
+		size_t length = (size_t)(end - start);
+		start = XNetTerminateLine(parser, start, end);
+		if (!start) {
+			return CXFalse;
+		}
+		end = start + length;
+	}
+	*outLine = start;
+	*outEnd = end;
 	*outLineNumber = parser->line;
 	return CXTrue;
 }
 
+static CXBool XNetGetLine(XNetParser *parser, char **outLine, size_t *outLineNumber) {
+	char *end = NULL;
+	return XNetGetLineRange(parser, CXTrue, outLine, &end, outLineNumber);
+}
+
+/* Pushes back a NUL-terminated line; the next XNetGetLine returns it again. */
 static void XNetUnreadLine(XNetParser *parser, char *line, size_t lineNumber) {
 	if (!parser || !line) {
 		return;
 	}
-	if (parser->pending.valid) {
-		free(parser->pending.text);
-		parser->pending.text = NULL;
-	}
 	parser->pending.valid = CXTrue;
 	parser->pending.text = line;
 	parser->pending.line = lineNumber;
@@ -1215,57 +1343,210 @@ static CXBool XNetParseInteger(const char *text, CXBool unsignedMode, int base,
 	return CXTrue;
 }
 
-static CXBool XNetParseFloatLine(const char *line, CXSize dimension, float *dest, XNetError *error, size_t lineNumber) {
+static inline CXBool XNetIsSpace(char ch) {
+	return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\v' || ch == '\f' || ch == '\n';
+}
+
+static inline CXBool XNetIsDigit(char ch) {
+	return ch >= '0' && ch <= '9';
+}
+
+static const char* XNetSkipSpaces(const char *cursor, const char *end) {
+	while (cursor < end && XNetIsSpace(*cursor)) {
+		cursor++;
+	}
+	return cursor;
+}
+
+static CXBool XNetRangeIsBlank(const char *line, const char *end) {
+	return XNetSkipSpaces(line, end) == end;
+}
+
+static CXBool XNetRangeIsComment(const char *line, const char *end) {
+	return end - line >= 2 && line[0] == '#' && line[1] == '#';
+}
+
+/*
+ * Slow path of the number scanners: hands the token (up to the next space)
+ * to strtod/strtoll/strtoull, so anything the fast paths do not cover keeps
+ * the C library's behaviour. Returns the end of the converted prefix, or
+ * NULL when nothing converts or the value is out of range.
+ */
+static const char* XNetScanNumberSlow(const char *cursor, const char *end, int kind, double *outDouble, int64_t *outSigned, uint64_t *outUnsigned) {
+	const char *tokenEnd = cursor;
+	while (tokenEnd < end && !XNetIsSpace(*tokenEnd)) {
+		tokenEnd++;
+	}
+	size_t length = (size_t)(tokenEnd - cursor);
+	char stackBuffer[64];
+	char *token = length < sizeof(stackBuffer) ? stackBuffer : malloc(length + 1);
+	if (!token) {
+		return NULL;
+	}
+	memcpy(token, cursor, length);
+	token[length] = '\0';
+	char *converted = NULL;
+	errno = 0;
+	if (kind == 0) {
+		*outDouble = strtod(token, &converted);
+	} else if (kind == 1) {
+		*outSigned = (int64_t)strtoll(token, &converted, 10);
+	} else {
+		*outUnsigned = (uint64_t)strtoull(token, &converted, 10);
+	}
+	CXBool ok = !errno && converted != token;
+	size_t consumed = (size_t)(converted - token);
+	if (token != stackBuffer) {
+		free(token);
+	}
+	return ok ? cursor + consumed : NULL;
+}
+
+static const double XNetExactPowersOfTen[] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/*
+ * Parses a decimal floating-point number starting at `cursor` (leading
+ * spaces skipped), returning the position after it or NULL. Plain decimals
+ * whose significand fits in 53 bits and whose exponent is within +-22 are
+ * converted exactly with one multiplication or division (Clinger's fast
+ * path), which covers what the writer emits; everything else goes through
+ * strtod.
+ */
+static const char* XNetScanDouble(const char *cursor, const char *end, double *outValue) {
+	cursor = XNetSkipSpaces(cursor, end);
+	const char *p = cursor;
+	CXBool negative = CXFalse;
+	if (p < end && (*p == '+' || *p == '-')) {
+		negative = *p == '-';
+		p++;
+	}
+	uint64_t significand = 0;
+	int digits = 0;
+	int exponent = 0;
+	CXBool sawDigit = CXFalse;
+	for (int fraction = 0; fraction < 2; fraction++) {
+		while (p < end && XNetIsDigit(*p)) {
+			sawDigit = CXTrue;
+			if (significand || *p != '0') {
+				if (++digits > 19) {
+					return XNetScanNumberSlow(cursor, end, 0, outValue, NULL, NULL);
+				}
+				significand = significand * 10u + (uint64_t)(*p - '0');
+			}
+			exponent -= fraction;
+			p++;
+		}
+		if (fraction || p >= end || *p != '.') {
+			break;
+		}
+		p++;
+	}
+	if (!sawDigit) {
+		return XNetScanNumberSlow(cursor, end, 0, outValue, NULL, NULL);
+	}
+	if (p < end && (*p == 'e' || *p == 'E')) {
+		const char *q = p + 1;
+		CXBool negativeExponent = CXFalse;
+		if (q < end && (*q == '+' || *q == '-')) {
+			negativeExponent = *q == '-';
+			q++;
+		}
+		if (q >= end || !XNetIsDigit(*q)) {
+			return XNetScanNumberSlow(cursor, end, 0, outValue, NULL, NULL);
+		}
+		int value = 0;
+		while (q < end && XNetIsDigit(*q)) {
+			value = value < 10000 ? value * 10 + (*q - '0') : value;
+			q++;
+		}
+		exponent += negativeExponent ? -value : value;
+		p = q;
+	}
+	if ((p < end && !XNetIsSpace(*p)) || significand > ((uint64_t)1 << 53) || exponent < -22 || exponent > 22) {
+		return XNetScanNumberSlow(cursor, end, 0, outValue, NULL, NULL);
+	}
+	double value = (double)significand;
+	value = exponent < 0 ? value / XNetExactPowersOfTen[-exponent] : value * XNetExactPowersOfTen[exponent];
+	*outValue = negative ? -value : value;
+	return p;
+}
+
+/*
+ * Parses a base-10 integer starting at `cursor` (leading spaces skipped).
+ * Up to 18 digits are accumulated inline; longer or unusual tokens go
+ * through strtoll/strtoull.
+ */
+static const char* XNetScanInteger(const char *cursor, const char *end, CXBool unsignedMode, int64_t *outSigned, uint64_t *outUnsigned) {
+	cursor = XNetSkipSpaces(cursor, end);
+	const char *p = cursor;
+	CXBool negative = CXFalse;
+	if (p < end && (*p == '+' || *p == '-')) {
+		negative = *p == '-';
+		p++;
+	}
+	const char *digitsStart = p;
+	uint64_t value = 0;
+	while (p < end && XNetIsDigit(*p) && p - digitsStart < 18) {
+		value = value * 10u + (uint64_t)(*p - '0');
+		p++;
+	}
+	if (p == digitsStart || (p < end && !XNetIsSpace(*p)) || (negative && unsignedMode)) {
+		return XNetScanNumberSlow(cursor, end, unsignedMode ? 2 : 1, NULL, outSigned, outUnsigned);
+	}
+	if (unsignedMode) {
+		*outUnsigned = value;
+	} else {
+		*outSigned = negative ? -(int64_t)value : (int64_t)value;
+	}
+	return p;
+}
+
+static CXBool XNetParseFloatLine(const char *line, const char *lineEnd, CXSize dimension, float *dest, XNetError *error, size_t lineNumber) {
 	if (!line || !dest || dimension == 0) {
 		return CXFalse;
 	}
 	const char *cursor = line;
 	for (CXSize i = 0; i < dimension; i++) {
-		while (*cursor && isspace((unsigned char)*cursor)) {
-			cursor++;
-		}
-		if (*cursor == '\0') {
+		cursor = XNetSkipSpaces(cursor, lineEnd);
+		if (cursor == lineEnd) {
 			XNetErrorSet(error, lineNumber, "Expected %zu float values, found %zu", (size_t)dimension, (size_t)i);
 			return CXFalse;
 		}
-		errno = 0;
-		char *end = NULL;
-		double value = strtod(cursor, &end);
-		if (errno || end == cursor) {
+		double value = 0.0;
+		const char *end = XNetScanDouble(cursor, lineEnd, &value);
+		if (!end) {
 			XNetErrorSet(error, lineNumber, "Invalid float value");
 			return CXFalse;
 		}
 		dest[i] = (float)value;
 		cursor = end;
 	}
-	while (*cursor && isspace((unsigned char)*cursor)) {
-		cursor++;
-	}
-	if (*cursor != '\0') {
+	if (XNetSkipSpaces(cursor, lineEnd) != lineEnd) {
 		XNetErrorSet(error, lineNumber, "Unexpected trailing characters in float vector");
 		return CXFalse;
 	}
 	return CXTrue;
 }
 
-static CXBool XNetParseIntLine(const char *line, CXSize dimension, CXBool unsignedMode, int bits, void *dest, XNetError *error, size_t lineNumber) {
+static CXBool XNetParseIntLine(const char *line, const char *lineEnd, CXSize dimension, CXBool unsignedMode, int bits, void *dest, XNetError *error, size_t lineNumber) {
 	if (!line || !dest || dimension == 0) {
 		return CXFalse;
 	}
 	const char *cursor = line;
 	for (CXSize i = 0; i < dimension; i++) {
-		while (*cursor && isspace((unsigned char)*cursor)) {
-			cursor++;
-		}
-		if (*cursor == '\0') {
+		cursor = XNetSkipSpaces(cursor, lineEnd);
+		if (cursor == lineEnd) {
 			XNetErrorSet(error, lineNumber, "Expected %zu integer values, found %zu", (size_t)dimension, (size_t)i);
 			return CXFalse;
 		}
-		char *end = NULL;
-		errno = 0;
+		const char *end = NULL;
 		if (unsignedMode) {
-			unsigned long long value = strtoull(cursor, &end, 10);
-			if (errno || end == cursor) {
+			uint64_t value = 0;
+			end = XNetScanInteger(cursor, lineEnd, CXTrue, NULL, &value);
+			if (!end) {
 				XNetErrorSet(error, lineNumber, "Invalid unsigned integer value");
 				return CXFalse;
 			}
@@ -1276,15 +1557,12 @@ static CXBool XNetParseIntLine(const char *line, CXSize dimension, CXBool unsign
 				}
 				((uint32_t *)dest)[i] = (uint32_t)value;
 			} else {
-				if ((uint64_t)value > UINT64_MAX) {
-					XNetErrorSet(error, lineNumber, "Unsigned integer value out of range");
-					return CXFalse;
-				}
-				((uint64_t *)dest)[i] = (uint64_t)value;
+				((uint64_t *)dest)[i] = value;
 			}
 		} else {
-			long long value = strtoll(cursor, &end, 10);
-			if (errno || end == cursor) {
+			int64_t value = 0;
+			end = XNetScanInteger(cursor, lineEnd, CXFalse, &value, NULL);
+			if (!end) {
 				XNetErrorSet(error, lineNumber, "Invalid integer value");
 				return CXFalse;
 			}
@@ -1295,19 +1573,12 @@ static CXBool XNetParseIntLine(const char *line, CXSize dimension, CXBool unsign
 				}
 				((int32_t *)dest)[i] = (int32_t)value;
 			} else {
-				if (value < LLONG_MIN || value > LLONG_MAX) {
-					XNetErrorSet(error, lineNumber, "Integer value out of range");
-					return CXFalse;
-				}
-				((int64_t *)dest)[i] = (int64_t)value;
+				((int64_t *)dest)[i] = value;
 			}
 		}
 		cursor = end;
 	}
-	while (*cursor && isspace((unsigned char)*cursor)) {
-		cursor++;
-	}
-	if (*cursor != '\0') {
+	if (XNetSkipSpaces(cursor, lineEnd) != lineEnd) {
 		XNetErrorSet(error, lineNumber, "Unexpected trailing characters in integer vector");
 		return CXFalse;
 	}
@@ -1707,13 +1978,11 @@ static CXBool XNetParseCategoryDictionary(XNetParser *parser, XNetAttributeScope
 		}
 		if (XNetIsComment(entryLine) || XNetIsBlank(entryLine)) {
 			XNetErrorSet(error, entryLineNumber, "Comments and blank lines are not allowed inside categorical dictionaries");
-			free(entryLine);
 			return CXFalse;
 		}
 		int32_t id = 0;
 		char *label = NULL;
 		CXBool ok = XNetParseCategoryEntryLine(entryLine, &id, &label, error, entryLineNumber);
-		free(entryLine);
 		if (!ok) {
 			return CXFalse;
 		}
@@ -1951,22 +2220,306 @@ static CXBool XNetConsumeLegacyLabels(XNetParser *parser, XNetError *error) {
 				return CXTrue;
 			}
 			XNetErrorSet(error, lineNumber, "Legacy label block ended early");
-			free(line);
 			return CXFalse;
 		}
 		XNetTrimTrailing(line);
 		char *value = NULL;
 		if (!XNetParseStringValue(line, parser->legacy, &value, error, lineNumber)) {
-			free(line);
 			return CXFalse;
 		}
 		parser->legacyLabels.values.asString[idx] = value;
-		free(line);
 	}
 	parser->hasLegacyLabels = CXTrue;
 	return CXTrue;
 }
 
+/* Sections with at least this many lines are parsed across the thread pool. */
+#define XNET_PARALLEL_MIN_LINES 65536
+/* Lines per chunk of a parallel section. */
+#define XNET_PARALLEL_CHUNK_LINES 16384
+
+/*
+ * A run of lines ahead of the cursor split into chunks of
+ * XNET_PARALLEL_CHUNK_LINES lines. Chunk `c` spans
+ * `data[offsets[c], offsets[c + 1])` and starts at line
+ * `firstLine + c * XNET_PARALLEL_CHUNK_LINES`.
+ */
+typedef struct {
+	size_t *offsets;
+	size_t chunkCount;
+	size_t lineCount;
+	size_t firstLine;
+} XNetSectionChunks;
+
+/*
+ * Splits up to `maxLines` lines ahead of the cursor into chunks, stopping
+ * early at EOF or, with `stopAtDirective`, before a line starting with '#'.
+ * Nothing is consumed. Returns CXFalse when out of memory.
+ */
+static CXBool XNetSplitSection(const XNetParser *parser, size_t maxLines, CXBool stopAtDirective, XNetSectionChunks *out) {
+	memset(out, 0, sizeof(*out));
+	out->firstLine = parser->line + 1;
+	size_t capacity = 16;
+	out->offsets = malloc(sizeof(size_t) * capacity);
+	if (!out->offsets) {
+		return CXFalse;
+	}
+	out->offsets[0] = parser->offset;
+	const char *cursor = parser->data + parser->offset;
+	const char *limit = parser->data + parser->size;
+	while (cursor < limit && out->lineCount < maxLines) {
+		const char *newline = memchr(cursor, '\n', (size_t)(limit - cursor));
+		const char *lineEnd = newline ? newline : limit;
+		if (stopAtDirective) {
+			const char *first = XNetSkipSpaces(cursor, lineEnd);
+			if (first < lineEnd && *first == '#') {
+				break;
+			}
+		}
+		cursor = newline ? newline + 1 : limit;
+		out->lineCount++;
+		if (out->lineCount % XNET_PARALLEL_CHUNK_LINES == 0) {
+			if (out->chunkCount + 3 > capacity) {
+				capacity *= 2;
+				size_t *grown = realloc(out->offsets, sizeof(size_t) * capacity);
+				if (!grown) {
+					free(out->offsets);
+					out->offsets = NULL;
+					return CXFalse;
+				}
+				out->offsets = grown;
+			}
+			out->offsets[++out->chunkCount] = (size_t)(cursor - parser->data);
+		}
+	}
+	if (out->lineCount % XNET_PARALLEL_CHUNK_LINES != 0) {
+		out->offsets[++out->chunkCount] = (size_t)(cursor - parser->data);
+	}
+	return CXTrue;
+}
+
+static CXBool XNetSectionIsParallel(const XNetSectionChunks *chunks) {
+	return chunks->lineCount >= XNET_PARALLEL_MIN_LINES && CXParallelWorkerCount(chunks->chunkCount) > 1;
+}
+
+/* Parses one value line of a numeric attribute block into row `idx`. */
+static CXBool XNetParseNumericValue(XNetAttributeBlock *block, CXSize idx, const char *line, const char *end, XNetError *error, size_t lineNumber) {
+	size_t offset = (size_t)idx * block->dimension;
+	switch (block->base) {
+		case XNetBaseFloat:
+			return XNetParseFloatLine(line, end, block->dimension, block->values.asFloat + offset, error, lineNumber);
+		case XNetBaseInt32:
+			return XNetParseIntLine(line, end, block->dimension, CXFalse, 32, block->values.asInt32 + offset, error, lineNumber);
+		case XNetBaseUInt32:
+			return XNetParseIntLine(line, end, block->dimension, CXTrue, 32, block->values.asUInt32 + offset, error, lineNumber);
+		case XNetBaseCategory:
+			return XNetParseIntLine(line, end, block->dimension, CXFalse, 32, block->values.asUInt32 + offset, error, lineNumber);
+		case XNetBaseInt64:
+			return XNetParseIntLine(line, end, block->dimension, CXFalse, 64, block->values.asInt64 + offset, error, lineNumber);
+		case XNetBaseUInt64:
+			return XNetParseIntLine(line, end, block->dimension, CXTrue, 64, block->values.asUInt64 + offset, error, lineNumber);
+		default:
+			return CXFalse;
+	}
+}
+
+/*
+ * Shared state of a parallel section. Every chunk writes a disjoint slice of
+ * the destination and keeps its own error; the earliest one is reported, so
+ * the outcome matches the serial parser.
+ */
+typedef struct {
+	XNetParser *parser;
+	const XNetSectionChunks *chunks;
+	XNetAttributeBlock *block;
+	CXBool weighted;
+	size_t *produced;
+	XNetError *errors;
+} XNetSectionJob;
+
+static void XNetParseValueChunks(void *context, CXIndex start, CXIndex end, CXSize workerIndex) {
+	(void)workerIndex;
+	XNetSectionJob *job = (XNetSectionJob *)context;
+	for (CXIndex chunk = start; chunk < end; chunk++) {
+		const char *cursor = job->parser->data + job->chunks->offsets[chunk];
+		const char *limit = job->parser->data + job->chunks->offsets[chunk + 1];
+		size_t row = (size_t)chunk * XNET_PARALLEL_CHUNK_LINES;
+		XNetError *error = &job->errors[chunk];
+		for (; cursor < limit; row++) {
+			const char *newline = memchr(cursor, '\n', (size_t)(limit - cursor));
+			const char *lineEnd = newline ? newline : limit;
+			size_t lineNumber = job->chunks->firstLine + row;
+			if (XNetRangeIsComment(cursor, lineEnd)) {
+				XNetErrorSet(error, lineNumber, "Comments are not allowed inside attribute blocks");
+				break;
+			}
+			if (XNetRangeIsBlank(cursor, lineEnd)) {
+				XNetErrorSet(error, lineNumber, "Empty lines are not allowed inside attribute blocks");
+				break;
+			}
+			if (!XNetParseNumericValue(job->block, (CXSize)row, cursor, lineEnd, error, lineNumber)) {
+				break;
+			}
+			cursor = newline ? newline + 1 : limit;
+		}
+	}
+}
+
+static void XNetParseEdgeChunks(void *context, CXIndex start, CXIndex end, CXSize workerIndex) {
+	(void)workerIndex;
+	XNetSectionJob *job = (XNetSectionJob *)context;
+	XNetParser *parser = job->parser;
+	for (CXIndex chunk = start; chunk < end; chunk++) {
+		const char *cursor = parser->data + job->chunks->offsets[chunk];
+		const char *limit = parser->data + job->chunks->offsets[chunk + 1];
+		size_t line = (size_t)chunk * XNET_PARALLEL_CHUNK_LINES;
+		// Each chunk writes from its first line's slot; blank lines leave gaps
+		// that are closed afterwards.
+		CXEdge *edges = parser->edges.items + parser->edges.count + line;
+		float *weights = job->weighted ? parser->legacyWeights.items + parser->legacyWeights.count + line : NULL;
+		size_t produced = 0;
+		XNetError *error = &job->errors[chunk];
+		for (; cursor < limit; line++) {
+			const char *newline = memchr(cursor, '\n', (size_t)(limit - cursor));
+			const char *lineEnd = newline ? newline : limit;
+			const char *field = XNetSkipSpaces(cursor, lineEnd);
+			size_t lineNumber = job->chunks->firstLine + line;
+			cursor = newline ? newline + 1 : limit;
+			if (field == lineEnd) {
+				continue;
+			}
+			int64_t from = 0;
+			int64_t to = 0;
+			double weight = 0.0;
+			const char *next = XNetScanInteger(field, lineEnd, CXFalse, &from, NULL);
+			if (!next || from < 0) {
+				XNetErrorSet(error, lineNumber, "Invalid source vertex index");
+				break;
+			}
+			next = XNetScanInteger(next, lineEnd, CXFalse, &to, NULL);
+			if (!next || to < 0) {
+				XNetErrorSet(error, lineNumber, "Invalid destination vertex index");
+				break;
+			}
+			if (job->weighted) {
+				next = XNetScanDouble(next, lineEnd, &weight);
+				if (!next) {
+					XNetErrorSet(error, lineNumber, "Invalid edge weight");
+					break;
+				}
+			}
+			if (XNetSkipSpaces(next, lineEnd) != lineEnd) {
+				XNetErrorSet(error, lineNumber, "Unexpected trailing characters in edge line");
+				break;
+			}
+			if ((uint64_t)from >= parser->vertexCount || (uint64_t)to >= parser->vertexCount) {
+				XNetErrorSet(error, lineNumber, "Edge references vertex outside of range");
+				break;
+			}
+			edges[produced].from = (CXIndex)from;
+			edges[produced].to = (CXIndex)to;
+			if (weights) {
+				weights[produced] = (float)weight;
+			}
+			produced++;
+		}
+		job->produced[chunk] = produced;
+	}
+}
+
+/*
+ * Runs `kernel` over the chunks, then reports the earliest chunk error (if
+ * any) and advances the cursor past the section.
+ */
+static CXBool XNetRunSectionJob(XNetSectionJob *job, void (*kernel)(void *, CXIndex, CXIndex, CXSize), XNetError *error) {
+	const XNetSectionChunks *chunks = job->chunks;
+	job->errors = calloc(chunks->chunkCount, sizeof(XNetError));
+	job->produced = calloc(chunks->chunkCount, sizeof(size_t));
+	if (!job->errors || !job->produced) {
+		free(job->errors);
+		free(job->produced);
+		job->errors = NULL;
+		job->produced = NULL;
+		XNetErrorSet(error, job->parser->line, "Failed to allocate parser workspace");
+		return CXFalse;
+	}
+	CXParallelForRange(chunks->chunkCount, 1, CXParallelWorkerCount(chunks->chunkCount), kernel, job);
+	CXBool ok = CXTrue;
+	for (size_t chunk = 0; chunk < chunks->chunkCount; chunk++) {
+		if (job->errors[chunk].message) {
+			if (ok && error && !error->message) {
+				error->message = job->errors[chunk].message;
+				job->errors[chunk].message = NULL;
+			}
+			ok = CXFalse;
+			free(job->errors[chunk].message);
+		}
+	}
+	free(job->errors);
+	job->errors = NULL;
+	if (ok) {
+		job->parser->offset = chunks->offsets[chunks->chunkCount];
+		job->parser->line += chunks->lineCount;
+	}
+	return ok;
+}
+
+/*
+ * Parses the `count` value lines of a numeric attribute block in parallel
+ * when the block is large enough. `*outHandled` tells whether it did; when
+ * it did not (small block, single worker, truncated file) the serial loop
+ * takes over and reports any error as before.
+ */
+static CXBool XNetParseValuesParallel(XNetParser *parser, XNetAttributeBlock *block, CXSize count, CXBool *outHandled, XNetError *error) {
+	*outHandled = CXFalse;
+	if (parser->pending.valid || count < XNET_PARALLEL_MIN_LINES || CXThreadPoolGetWorkerCount() < 2) {
+		return CXTrue;
+	}
+	XNetSectionChunks chunks;
+	if (!XNetSplitSection(parser, (size_t)count, CXFalse, &chunks)) {
+		return CXTrue;
+	}
+	if (chunks.lineCount < count || !XNetSectionIsParallel(&chunks)) {
+		free(chunks.offsets);
+		return CXTrue;
+	}
+	XNetSectionJob job = { parser, &chunks, block, CXFalse, NULL, NULL };
+	CXBool ok = XNetRunSectionJob(&job, XNetParseValueChunks, error);
+	free(job.produced);
+	free(chunks.offsets);
+	*outHandled = CXTrue;
+	return ok;
+}
+
+/* Parses a split edge section in parallel and closes the gaps left by blank lines. */
+static CXBool XNetParseEdgesParallel(XNetParser *parser, const XNetSectionChunks *chunks, CXBool weighted, XNetError *error) {
+	XNetSectionJob job = { parser, chunks, NULL, weighted, NULL, NULL };
+	if (!XNetRunSectionJob(&job, XNetParseEdgeChunks, error)) {
+		free(job.produced);
+		return CXFalse;
+	}
+	CXEdge *edges = parser->edges.items + parser->edges.count;
+	float *weights = weighted ? parser->legacyWeights.items + parser->legacyWeights.count : NULL;
+	size_t added = 0;
+	for (size_t chunk = 0; chunk < chunks->chunkCount; chunk++) {
+		size_t read = chunk * XNET_PARALLEL_CHUNK_LINES;
+		size_t produced = job.produced[chunk];
+		if (read != added) {
+			memmove(edges + added, edges + read, produced * sizeof(CXEdge));
+			if (weights) {
+				memmove(weights + added, weights + read, produced * sizeof(float));
+			}
+		}
+		added += produced;
+	}
+	parser->edges.count += added;
+	if (weighted) {
+		parser->legacyWeights.count += added;
+	}
+	free(job.produced);
+	return CXTrue;
+}
+
 static CXBool XNetParseVertexAttribute(XNetParser *parser, const char *line, XNetError *error, size_t lineNumber) {
 	if (!parser || !line) {
 		return CXFalse;
@@ -2037,38 +2590,42 @@ static CXBool XNetParseVertexAttribute(XNetParser *parser, const char *line, XNe
 		char *trimmed = XNetSkipWhitespace(dictLine);
 		if (strncmp(trimmed, "#vdict", 6) == 0) {
 			CXBool ok = XNetParseCategoryDictionary(parser, XNetScopeNode, block, trimmed, error, dictLineNumber);
-			free(dictLine);
 			if (!ok) {
 				return CXFalse;
 			}
 		} else {
 			if (trimmed[0] == '#') {
 				XNetErrorSet(error, dictLineNumber, "Unexpected directive inside vertex attribute '%s'", name);
-				free(dictLine);
 				return CXFalse;
 			}
 			XNetUnreadLine(parser, dictLine, dictLineNumber);
 		}
 	}
 
-	for (CXSize idx = 0; idx < parser->vertexCount; idx++) {
+	// Numeric values are parsed straight from the line range, in parallel for
+	// large blocks.
+	CXBool terminate = block->base == XNetBaseString || block->base == XNetBaseMultiCategory;
+	CXBool handled = CXFalse;
+	if (!terminate && !XNetParseValuesParallel(parser, block, parser->vertexCount, &handled, error)) {
+		return CXFalse;
+	}
+	for (CXSize idx = handled ? parser->vertexCount : 0; idx < parser->vertexCount; idx++) {
 		char *valueLine = NULL;
+		char *valueEnd = NULL;
 		size_t valueLineNumber = 0;
-		if (!XNetGetLine(parser, &valueLine, &valueLineNumber)) {
+		if (!XNetGetLineRange(parser, terminate, &valueLine, &valueEnd, &valueLineNumber)) {
 			XNetErrorSet(error, lineNumber, "Unexpected EOF in vertex attribute '%s'", name);
 			return CXFalse;
 		}
-		if (XNetIsComment(valueLine)) {
+		if (XNetRangeIsComment(valueLine, valueEnd)) {
 			XNetErrorSet(error, valueLineNumber, "Comments are not allowed inside attribute blocks");
-			free(valueLine);
 			return CXFalse;
 		}
-		if (XNetIsBlank(valueLine)) {
+		if (XNetRangeIsBlank(valueLine, valueEnd)) {
 			if (block->base == XNetBaseMultiCategory) {
 				// Allow empty multi-category entries (empty set).
 			} else {
 				XNetErrorSet(error, valueLineNumber, "Empty lines are not allowed inside attribute blocks");
-				free(valueLine);
 				return CXFalse;
 			}
 		}
@@ -2080,22 +2637,11 @@ static CXBool XNetParseVertexAttribute(XNetParser *parser, const char *line, XNe
 			if (ok) {
 				block->values.asString[idx] = decoded;
 			}
-		} else if (block->base == XNetBaseFloat) {
-			ok = XNetParseFloatLine(valueLine, block->dimension, block->values.asFloat + (size_t)idx * block->dimension, error, valueLineNumber);
-		} else if (block->base == XNetBaseInt32) {
-			ok = XNetParseIntLine(valueLine, block->dimension, CXFalse, 32, block->values.asInt32 + (size_t)idx * block->dimension, error, valueLineNumber);
-		} else if (block->base == XNetBaseUInt32) {
-			ok = XNetParseIntLine(valueLine, block->dimension, CXTrue, 32, block->values.asUInt32 + (size_t)idx * block->dimension, error, valueLineNumber);
-		} else if (block->base == XNetBaseCategory) {
-			ok = XNetParseIntLine(valueLine, block->dimension, CXFalse, 32, block->values.asUInt32 + (size_t)idx * block->dimension, error, valueLineNumber);
 		} else if (block->base == XNetBaseMultiCategory) {
 			ok = XNetParseMultiCategoryLine(block, valueLine, idx, error, valueLineNumber);
-		} else if (block->base == XNetBaseInt64) {
-			ok = XNetParseIntLine(valueLine, block->dimension, CXFalse, 64, block->values.asInt64 + (size_t)idx * block->dimension, error, valueLineNumber);
-		} else if (block->base == XNetBaseUInt64) {
-			ok = XNetParseIntLine(valueLine, block->dimension, CXTrue, 64, block->values.asUInt64 + (size_t)idx * block->dimension, error, valueLineNumber);
+		} else {
+			ok = XNetParseNumericValue(block, idx, valueLine, valueEnd, error, valueLineNumber);
 		}
-		free(valueLine);
 		if (!ok) {
 			return CXFalse;
 		}
@@ -2178,38 +2724,42 @@ static CXBool XNetParseEdgeAttribute(XNetParser *parser, const char *line, XNetE
 		char *trimmed = XNetSkipWhitespace(dictLine);
 		if (strncmp(trimmed, "#edict", 6) == 0) {
 			CXBool ok = XNetParseCategoryDictionary(parser, XNetScopeEdge, block, trimmed, error, dictLineNumber);
-			free(dictLine);
 			if (!ok) {
 				return CXFalse;
 			}
 		} else {
 			if (trimmed[0] == '#') {
 				XNetErrorSet(error, dictLineNumber, "Unexpected directive inside edge attribute '%s'", name);
-				free(dictLine);
 				return CXFalse;
 			}
 			XNetUnreadLine(parser, dictLine, dictLineNumber);
 		}
 	}
 
-	for (CXSize idx = 0; idx < parser->edges.count; idx++) {
+	// Numeric values are parsed straight from the line range, in parallel for
+	// large blocks.
+	CXBool terminate = block->base == XNetBaseString || block->base == XNetBaseMultiCategory;
+	CXBool handled = CXFalse;
+	if (!terminate && !XNetParseValuesParallel(parser, block, parser->edges.count, &handled, error)) {
+		return CXFalse;
+	}
+	for (CXSize idx = handled ? parser->edges.count : 0; idx < parser->edges.count; idx++) {
 		char *valueLine = NULL;
+		char *valueEnd = NULL;
 		size_t valueLineNumber = 0;
-		if (!XNetGetLine(parser, &valueLine, &valueLineNumber)) {
+		if (!XNetGetLineRange(parser, terminate, &valueLine, &valueEnd, &valueLineNumber)) {
 			XNetErrorSet(error, lineNumber, "Unexpected EOF in edge attribute '%s'", name);
 			return CXFalse;
 		}
-		if (XNetIsComment(valueLine)) {
+		if (XNetRangeIsComment(valueLine, valueEnd)) {
 			XNetErrorSet(error, valueLineNumber, "Comments are not allowed inside attribute blocks");
-			free(valueLine);
 			return CXFalse;
 		}
-		if (XNetIsBlank(valueLine)) {
+		if (XNetRangeIsBlank(valueLine, valueEnd)) {
 			if (block->base == XNetBaseMultiCategory) {
 				// Allow empty multi-category entries (empty set).
 			} else {
 				XNetErrorSet(error, valueLineNumber, "Empty lines are not allowed inside attribute blocks");
-				free(valueLine);
 				return CXFalse;
 			}
 		}
@@ -2221,22 +2771,11 @@ static CXBool XNetParseEdgeAttribute(XNetParser *parser, const char *line, XNetE
 			if (ok) {
 				block->values.asString[idx] = decoded;
 			}
-		} else if (block->base == XNetBaseFloat) {
-			ok = XNetParseFloatLine(valueLine, block->dimension, block->values.asFloat + (size_t)idx * block->dimension, error, valueLineNumber);
-		} else if (block->base == XNetBaseInt32) {
-			ok = XNetParseIntLine(valueLine, block->dimension, CXFalse, 32, block->values.asInt32 + (size_t)idx * block->dimension, error, valueLineNumber);
-		} else if (block->base == XNetBaseUInt32) {
-			ok = XNetParseIntLine(valueLine, block->dimension, CXTrue, 32, block->values.asUInt32 + (size_t)idx * block->dimension, error, valueLineNumber);
-		} else if (block->base == XNetBaseCategory) {
-			ok = XNetParseIntLine(valueLine, block->dimension, CXFalse, 32, block->values.asUInt32 + (size_t)idx * block->dimension, error, valueLineNumber);
 		} else if (block->base == XNetBaseMultiCategory) {
 			ok = XNetParseMultiCategoryLine(block, valueLine, idx, error, valueLineNumber);
-		} else if (block->base == XNetBaseInt64) {
-			ok = XNetParseIntLine(valueLine, block->dimension, CXFalse, 64, block->values.asInt64 + (size_t)idx * block->dimension, error, valueLineNumber);
-		} else if (block->base == XNetBaseUInt64) {
-			ok = XNetParseIntLine(valueLine, block->dimension, CXTrue, 64, block->values.asUInt64 + (size_t)idx * block->dimension, error, valueLineNumber);
+		} else {
+			ok = XNetParseNumericValue(block, idx, valueLine, valueEnd, error, valueLineNumber);
 		}
-		free(valueLine);
 		if (!ok) {
 			return CXFalse;
 		}
@@ -2312,14 +2851,12 @@ static CXBool XNetParseGraphAttribute(XNetParser *parser, const char *line, XNet
 		char *trimmed = XNetSkipWhitespace(dictLine);
 		if (strncmp(trimmed, "#gdict", 6) == 0) {
 			CXBool ok = XNetParseCategoryDictionary(parser, XNetScopeGraph, block, trimmed, error, dictLineNumber);
-			free(dictLine);
 			if (!ok) {
 				return CXFalse;
 			}
 		} else {
 			if (trimmed[0] == '#') {
 				XNetErrorSet(error, dictLineNumber, "Unexpected directive inside graph attribute '%s'", name);
-				free(dictLine);
 				return CXFalse;
 			}
 			XNetUnreadLine(parser, dictLine, dictLineNumber);
@@ -2327,14 +2864,14 @@ static CXBool XNetParseGraphAttribute(XNetParser *parser, const char *line, XNet
 	}
 
 	char *valueLine = NULL;
+	char *valueEnd = NULL;
 	size_t valueLineNumber = 0;
-	if (!XNetGetLine(parser, &valueLine, &valueLineNumber)) {
+	if (!XNetGetLineRange(parser, CXTrue, &valueLine, &valueEnd, &valueLineNumber)) {
 		XNetErrorSet(error, lineNumber, "Unexpected EOF reading graph attribute '%s'", name);
 		return CXFalse;
 	}
 	if (XNetIsComment(valueLine)) {
 		XNetErrorSet(error, valueLineNumber, "Comments are not allowed inside attribute blocks");
-		free(valueLine);
 		return CXFalse;
 	}
 	if (XNetIsBlank(valueLine)) {
@@ -2342,7 +2879,6 @@ static CXBool XNetParseGraphAttribute(XNetParser *parser, const char *line, XNet
 			// Allow empty multi-category entries (empty set).
 		} else {
 			XNetErrorSet(error, valueLineNumber, "Empty line encountered in graph attribute");
-			free(valueLine);
 			return CXFalse;
 		}
 	}
@@ -2354,22 +2890,11 @@ static CXBool XNetParseGraphAttribute(XNetParser *parser, const char *line, XNet
 		if (ok) {
 			block->values.asString[0] = decoded;
 		}
-	} else if (block->base == XNetBaseFloat) {
-		ok = XNetParseFloatLine(valueLine, block->dimension, block->values.asFloat, error, valueLineNumber);
-	} else if (block->base == XNetBaseInt32) {
-		ok = XNetParseIntLine(valueLine, block->dimension, CXFalse, 32, block->values.asInt32, error, valueLineNumber);
-	} else if (block->base == XNetBaseUInt32) {
-		ok = XNetParseIntLine(valueLine, block->dimension, CXTrue, 32, block->values.asUInt32, error, valueLineNumber);
-	} else if (block->base == XNetBaseCategory) {
-		ok = XNetParseIntLine(valueLine, block->dimension, CXFalse, 32, block->values.asUInt32, error, valueLineNumber);
 	} else if (block->base == XNetBaseMultiCategory) {
 		ok = XNetParseMultiCategoryLine(block, valueLine, 0, error, valueLineNumber);
-	} else if (block->base == XNetBaseInt64) {
-		ok = XNetParseIntLine(valueLine, block->dimension, CXFalse, 64, block->values.asInt64, error, valueLineNumber);
-	} else if (block->base == XNetBaseUInt64) {
-		ok = XNetParseIntLine(valueLine, block->dimension, CXTrue, 64, block->values.asUInt64, error, valueLineNumber);
+	} else {
+		ok = XNetParseNumericValue(block, 0, valueLine, valueEnd, error, valueLineNumber);
 	}
-	free(valueLine);
 	if (!ok) {
 		return CXFalse;
 	}
@@ -2382,102 +2907,106 @@ static CXBool XNetParseEdges(XNetParser *parser, CXBool weighted, XNetError *err
 	if (!parser) {
 		return CXFalse;
 	}
+	// Size the edge (and weight) arrays for the whole section up front; large
+	// sections are then parsed in parallel, and the loop below picks up
+	// whatever follows them.
+	XNetSectionChunks chunks;
+	if (!XNetSplitSection(parser, SIZE_MAX, CXTrue, &chunks)) {
+		XNetErrorSet(error, parser->line, "Failed to allocate parser workspace");
+		return CXFalse;
+	}
+	size_t expected = chunks.lineCount + 1;
+	if (!XNetEdgeListEnsureCapacity(&parser->edges, parser->edges.count + expected) ||
+		(weighted && !XNetFloatListEnsureCapacity(&parser->legacyWeights, parser->legacyWeights.count + expected))) {
+		free(chunks.offsets);
+		XNetErrorSet(error, parser->line, "Failed to grow edge list");
+		return CXFalse;
+	}
+	if (!parser->pending.valid && XNetSectionIsParallel(&chunks) && !XNetParseEdgesParallel(parser, &chunks, weighted, error)) {
+		free(chunks.offsets);
+		return CXFalse;
+	}
+	free(chunks.offsets);
 	while (1) {
 		char *line = NULL;
+		char *lineEnd = NULL;
 		size_t lineNumber = 0;
-		if (!XNetGetLine(parser, &line, &lineNumber)) {
+		if (!XNetGetLineRange(parser, CXFalse, &line, &lineEnd, &lineNumber)) {
 			break;
 		}
-		char *trimmedLeading = XNetSkipWhitespace(line);
-		if (*trimmedLeading == '#') {
-			if (XNetIsComment(trimmedLeading)) {
+		const char *cursor = XNetSkipSpaces(line, lineEnd);
+		if (cursor < lineEnd && *cursor == '#') {
+			if (XNetRangeIsComment(cursor, lineEnd)) {
 				XNetErrorSet(error, lineNumber, "Comments are not allowed inside edge lists");
-				free(line);
 				return CXFalse;
 			}
-			XNetUnreadLine(parser, line, lineNumber);
+			char *terminated = XNetTerminateLine(parser, line, lineEnd);
+			if (!terminated) {
+				XNetErrorSet(error, lineNumber, "Failed to allocate line buffer");
+				return CXFalse;
+			}
+			XNetUnreadLine(parser, terminated, lineNumber);
 			break;
 		}
-		if (XNetIsBlank(trimmedLeading)) {
-			free(line);
+		if (cursor == lineEnd) {
 			continue;
 		}
 		if (!XNetEdgeListEnsureCapacity(&parser->edges, parser->edges.count + 1)) {
 			XNetErrorSet(error, lineNumber, "Failed to grow edge list");
-			free(line);
 			return CXFalse;
 		}
-		CXIndex fromIndex = 0;
-		CXIndex toIndex = 0;
-		float weightValue = 0.0f;
-
-		char *cursor = trimmedLeading;
-		char *end = NULL;
-		errno = 0;
-		long long from = strtoll(cursor, &end, 10);
-		if (errno || end == cursor || from < 0) {
+		int64_t from = 0;
+		int64_t to = 0;
+		const char *end = XNetScanInteger(cursor, lineEnd, CXFalse, &from, NULL);
+		if (!end || from < 0) {
 			XNetErrorSet(error, lineNumber, "Invalid source vertex index");
-			free(line);
 			return CXFalse;
 		}
 		cursor = end;
-		long long to = strtoll(cursor, &end, 10);
-		if (errno || end == cursor || to < 0) {
+		end = XNetScanInteger(cursor, lineEnd, CXFalse, &to, NULL);
+		if (!end || to < 0) {
 			XNetErrorSet(error, lineNumber, "Invalid destination vertex index");
-			free(line);
 			return CXFalse;
 		}
 		cursor = end;
+		double weight = 0.0;
 		if (weighted) {
-			errno = 0;
-			float weight = (float)strtod(cursor, &end);
-			if (errno || end == cursor) {
+			end = XNetScanDouble(cursor, lineEnd, &weight);
+			if (!end) {
 				XNetErrorSet(error, lineNumber, "Invalid edge weight");
-				free(line);
 				return CXFalse;
 			}
-			weightValue = weight;
 			cursor = end;
 		}
-		while (*cursor && isspace((unsigned char)*cursor)) {
-			cursor++;
-		}
-		if (*cursor != '\0') {
+		if (XNetSkipSpaces(cursor, lineEnd) != lineEnd) {
 			XNetErrorSet(error, lineNumber, "Unexpected trailing characters in edge line");
-			free(line);
 			return CXFalse;
 		}
 		if ((uint64_t)from >= parser->vertexCount || (uint64_t)to >= parser->vertexCount) {
 			XNetErrorSet(error, lineNumber, "Edge references vertex outside of range");
-			free(line);
 			return CXFalse;
 		}
-		fromIndex = (CXIndex)from;
-		toIndex = (CXIndex)to;
-		parser->edges.items[parser->edges.count].from = fromIndex;
-		parser->edges.items[parser->edges.count].to = toIndex;
+		parser->edges.items[parser->edges.count].from = (CXIndex)from;
+		parser->edges.items[parser->edges.count].to = (CXIndex)to;
 
 		if (weighted) {
 			if (!XNetFloatListEnsureCapacity(&parser->legacyWeights, parser->legacyWeights.count + 1)) {
 				XNetErrorSet(error, lineNumber, "Failed to allocate legacy weight buffer");
-				free(line);
 				return CXFalse;
 			}
-			parser->legacyWeights.items[parser->legacyWeights.count] = weightValue;
+			parser->legacyWeights.items[parser->legacyWeights.count] = (float)weight;
 			parser->legacyWeights.count++;
 		}
 		parser->edges.count++;
-		free(line);
 	}
 	return CXTrue;
 }
 
-static void XNetParserInit(XNetParser *parser, FILE *file) {
+static void XNetParserInit(XNetParser *parser) {
 	if (!parser) {
 		return;
 	}
 	memset(parser, 0, sizeof(*parser));
-	parser->file = file;
 	parser->directed = CXFalse;
 	parser->legacy = CXFalse;
 	parser->pending.text = NULL;
@@ -2501,10 +3030,8 @@ static void XNetParserDestroy(XNetParser *parser) {
 	XNetEdgeListFree(&parser->edges);
 	XNetFloatListFree(&parser->legacyWeights);
 	XNetAttributeBlockFree(&parser->legacyLabels);
-	if (parser->pending.valid && parser->pending.text) {
-		free(parser->pending.text);
-		parser->pending.text = NULL;
-	}
+	XNetInputClose(parser);
+	parser->pending.text = NULL;
 	parser->pending.valid = CXFalse;
 }
 
@@ -2524,15 +3051,12 @@ static CXBool XNetParserRun(XNetParser *parser, XNetError *error) {
 		char *trimLeading = XNetSkipWhitespace(line);
 		XNetTrimTrailing(trimLeading);
 		if (*trimLeading == '\0') {
-			free(line);
 			continue;
 		}
 		if (XNetIsComment(trimLeading)) {
-			free(line);
 			continue;
 		}
 		if (parser->legacy && parser->legacyTrailingVertexAttributeRowsAllowed && trimLeading[0] != '#') {
-			free(line);
 			continue;
 		}
 		parser->legacyTrailingVertexAttributeRowsAllowed = CXFalse;
@@ -2540,37 +3064,30 @@ static CXBool XNetParserRun(XNetParser *parser, XNetError *error) {
 			if (strncmp(trimLeading, "#XNET", 5) == 0) {
 				if (strcmp(trimLeading, XNET_HEADER_LINE) != 0) {
 					XNetErrorSet(error, lineNumber, "Unsupported XNET version, expected %s", XNET_HEADER_LINE);
-					free(line);
 					return CXFalse;
 				}
 				parser->headerSeen = CXTrue;
-				free(line);
 				continue;
 			}
 			if (strncmp(trimLeading, "#vertices", 9) == 0) {
 				parser->legacy = CXTrue;
 				parser->headerSeen = CXTrue;
 				if (!XNetParseVertices(parser, trimLeading, CXTrue, error, lineNumber)) {
-					free(line);
 					return CXFalse;
 				}
-				free(line);
 				if (!XNetConsumeLegacyLabels(parser, error)) {
 					return CXFalse;
 				}
 				continue;
 			}
 			XNetErrorSet(error, lineNumber, "Unexpected first directive '%s'", trimLeading);
-			free(line);
 			return CXFalse;
 		}
 
 		if (strncmp(trimLeading, "#vertices", 9) == 0) {
 			if (!XNetParseVertices(parser, trimLeading, parser->legacy, error, lineNumber)) {
-				free(line);
 				return CXFalse;
 			}
-			free(line);
 			if (parser->legacy && !XNetConsumeLegacyLabels(parser, error)) {
 				return CXFalse;
 			}
@@ -2578,10 +3095,8 @@ static CXBool XNetParserRun(XNetParser *parser, XNetError *error) {
 		}
 		if (strncmp(trimLeading, "#edges", 6) == 0) {
 			if (!XNetParseEdgesDirective(parser, trimLeading, parser->legacy, &legacyWeighted, error, lineNumber)) {
-				free(line);
 				return CXFalse;
 			}
-			free(line);
 			if (!XNetParseEdges(parser, legacyWeighted, error)) {
 				return CXFalse;
 			}
@@ -2590,40 +3105,31 @@ static CXBool XNetParserRun(XNetParser *parser, XNetError *error) {
 		if (strncmp(trimLeading, "#v ", 3) == 0) {
 			if (!parser->vertexCount && !parser->legacy) {
 				XNetErrorSet(error, lineNumber, "Vertex attribute encountered before #vertices");
-				free(line);
 				return CXFalse;
 			}
 			if (!XNetParseVertexAttribute(parser, trimLeading, error, lineNumber)) {
-				free(line);
 				return CXFalse;
 			}
-			free(line);
 			continue;
 		}
 		if (strncmp(trimLeading, "#e ", 3) == 0) {
 			if (!parser->edgesSeen) {
 				XNetErrorSet(error, lineNumber, "Edge attribute encountered before #edges");
-				free(line);
 				return CXFalse;
 			}
 			if (!XNetParseEdgeAttribute(parser, trimLeading, error, lineNumber)) {
-				free(line);
 				return CXFalse;
 			}
-			free(line);
 			continue;
 		}
 		if (strncmp(trimLeading, "#g ", 3) == 0) {
 			if (!XNetParseGraphAttribute(parser, trimLeading, error, lineNumber)) {
-				free(line);
 				return CXFalse;
 			}
-			free(line);
 			continue;
 		}
 
 		XNetErrorSet(error, lineNumber, "Unknown directive '%s'", trimLeading);
-		free(line);
 		return CXFalse;
 	}
 
@@ -2993,15 +3499,15 @@ struct CXNetwork* CXNetworkReadXNet(const char *path) {
 	if (!path) {
 		return NULL;
 	}
-	FILE *file = fopen(path, "rb");
-	if (!file) {
+	XNetParser parserState;
+	XNetParserInit(&parserState);
+	if (!XNetInputOpen(&parserState, path)) {
+		XNetParserDestroy(&parserState);
 		return NULL;
 	}
-	XNetParser parserState;
-	XNetParserInit(&parserState, file);
 	XNetError error = {0};
 	CXBool ok = XNetParserRun(&parserState, &error);
-	fclose(file);
+	XNetInputClose(&parserState);
 
 	if (!ok) {
 		if (error.message) {
@@ -3293,9 +3799,9 @@ static CXBool XNetCollectAttributes(CXStringDictionaryRef dictionary, XNetAttrib
 	return CXTrue;
 }
 
-static void XNetWriteEscapedString(FILE *file, const char *value) {
+static void XNetWriteEscapedString(CXTextWriter *out, const char *value) {
 	if (!value) {
-		fputs("\"\"", file);
+		CXTextWriterPuts(out, "\"\"");
 		return;
 	}
 	CXBool needsQuote = CXFalse;
@@ -3317,29 +3823,12 @@ static void XNetWriteEscapedString(FILE *file, const char *value) {
 		}
 	}
 	if (!needsQuote) {
-		fputs(value, file);
+		CXTextWriterPuts(out, value);
 		return;
 	}
-	fputc('"', file);
-	for (const char *ptr = value; *ptr; ptr++) {
-		char ch = *ptr;
-		switch (ch) {
-			case '\\': fputs("\\\\", file); break;
-			case '"': fputs("\\\"", file); break;
-			case '\n': fputs("\\n", file); break;
-			case '\t': fputs("\\t", file); break;
-			case '\r': fputs("\\r", file); break;
-			default:
-				if ((unsigned char)ch < 0x20 || (unsigned char)ch == 0x7F) {
-					// control character, escape
-					fprintf(file, "\\x%02X", (unsigned char)ch);
-				} else {
-					fputc(ch, file);
-				}
-				break;
-		}
-	}
-	fputc('"', file);
+	CXTextWriterPutChar(out, '"');
+	CXTextWriterWriteEscaped(out, value, CXTextEscapeXNet);
+	CXTextWriterPutChar(out, '"');
 }
 
 typedef struct {
@@ -3419,8 +3908,8 @@ static const char* XNetLookupCategoryLabel(const XNetCategoryWriteEntry *entries
 	return NULL;
 }
 
-static CXBool XNetWriteMultiCategoryLine(FILE *file, const CXAttributeRef attribute, const XNetCategoryWriteEntry *entries, size_t entryCount, CXIndex index) {
-	if (!file || !attribute || !attribute->multiCategory) {
+static CXBool XNetWriteMultiCategoryLine(CXTextWriter *out, const CXAttributeRef attribute, const XNetCategoryWriteEntry *entries, size_t entryCount, CXIndex index) {
+	if (!out || !attribute || !attribute->multiCategory) {
 		return CXFalse;
 	}
 	const CXMultiCategoryBuffer *buffer = attribute->multiCategory;
@@ -3428,28 +3917,29 @@ static CXBool XNetWriteMultiCategoryLine(FILE *file, const CXAttributeRef attrib
 	uint32_t end = buffer->offsets ? buffer->offsets[index + 1] : 0;
 	for (uint32_t pos = start; pos < end; pos++) {
 		if (pos > start) {
-			fputc(' ', file);
+			CXTextWriterPutChar(out, ' ');
 		}
 		uint32_t id = buffer->ids ? buffer->ids[pos] : 0;
 		const char *label = XNetLookupCategoryLabel(entries, entryCount, (int32_t)id);
 		if (label) {
-			XNetWriteEscapedString(file, label);
+			XNetWriteEscapedString(out, label);
 		} else {
 			char fallback[32];
 			snprintf(fallback, sizeof(fallback), "%" PRIu32, id);
-			XNetWriteEscapedString(file, fallback);
+			XNetWriteEscapedString(out, fallback);
 		}
 		if (buffer->hasWeights) {
 			float weight = buffer->weights ? buffer->weights[pos] : 0.0f;
-			fprintf(file, ":%0.9g", weight);
+			CXTextWriterPutChar(out, ':');
+			CXTextWriterWriteFloat(out, weight);
 		}
 	}
-	fputc('\n', file);
+	CXTextWriterPutChar(out, '\n');
 	return CXTrue;
 }
 
-static CXBool XNetWriteCategoryDictionary(FILE *file, const XNetAttributeView *view, XNetAttributeScope scope) {
-	if (!file || !view || !view->attribute) {
+static CXBool XNetWriteCategoryDictionary(CXTextWriter *out, const XNetAttributeView *view, XNetAttributeScope scope) {
+	if (!out || !view || !view->attribute) {
 		return CXFalse;
 	}
 	if (view->base != XNetBaseCategory && view->base != XNetBaseMultiCategory) {
@@ -3479,17 +3969,18 @@ static CXBool XNetWriteCategoryDictionary(FILE *file, const XNetAttributeView *v
 			free(entries);
 			return CXFalse;
 	}
-	fprintf(file, "%s \"%s\" %zu\n", prefix, view->name, entryCount);
+	CXTextWriterPrintf(out, "%s \"%s\" %zu\n", prefix, view->name, entryCount);
 	for (size_t idx = 0; idx < entryCount; idx++) {
-		fprintf(file, "%" PRId32 " ", entries[idx].id);
-		XNetWriteEscapedString(file, entries[idx].label);
-		fputc('\n', file);
+		CXTextWriterWriteInt64(out, entries[idx].id);
+		CXTextWriterPutChar(out, ' ');
+		XNetWriteEscapedString(out, entries[idx].label);
+		CXTextWriterPutChar(out, '\n');
 	}
 	free(entries);
 	return CXTrue;
 }
 
-static CXBool XNetWriteVertexAttributes(FILE *file, const XNetAttributeViewList *attrs, const CXIndex *activeNodes, CXSize nodeCount) {
+static CXBool XNetWriteVertexAttributes(CXTextWriter *out, const XNetAttributeViewList *attrs, const CXIndex *activeNodes, CXSize nodeCount) {
 	for (size_t i = 0; i < attrs->count; i++) {
 		const XNetAttributeView *view = &attrs->items[i];
 		char typeCode[16];
@@ -3497,8 +3988,8 @@ static CXBool XNetWriteVertexAttributes(FILE *file, const XNetAttributeViewList
 		if (!typeStr) {
 			return CXFalse;
 		}
-		fprintf(file, "#v \"%s\" %s\n", view->name, typeStr);
-		if (!XNetWriteCategoryDictionary(file, view, XNetScopeNode)) {
+		CXTextWriterPrintf(out, "#v \"%s\" %s\n", view->name, typeStr);
+		if (!XNetWriteCategoryDictionary(out, view, XNetScopeNode)) {
 			return CXFalse;
 		}
 		XNetCategoryWriteEntry *entries = NULL;
@@ -3511,8 +4002,8 @@ static CXBool XNetWriteVertexAttributes(FILE *file, const XNetAttributeViewList
 			for (CXSize idx = 0; idx < nodeCount; idx++) {
 				CXIndex original = activeNodes[idx];
 				CXString value = values ? values[original] : NULL;
-				XNetWriteEscapedString(file, value ? value : "");
-				fputc('\n', file);
+				XNetWriteEscapedString(out, value ? value : "");
+				CXTextWriterPutChar(out, '\n');
 			}
 		} else if (view->base == XNetBaseFloat) {
 			float *values = (float *)view->attribute->data;
@@ -3520,12 +4011,12 @@ static CXBool XNetWriteVertexAttributes(FILE *file, const XNetAttributeViewList
 				CXIndex original = activeNodes[idx];
 				for (CXSize d = 0; d < view->dimension; d++) {
 					if (d > 0) {
-						fputc(' ', file);
+						CXTextWriterPutChar(out, ' ');
 					}
 					float value = values[(size_t)original * view->attribute->dimension + d];
-					fprintf(file, "%.9g", value);
+					CXTextWriterWriteFloat(out, value);
 				}
-				fputc('\n', file);
+				CXTextWriterPutChar(out, '\n');
 			}
 		} else if (view->base == XNetBaseInt32) {
 			int32_t *values = (int32_t *)view->attribute->data;
@@ -3533,12 +4024,12 @@ static CXBool XNetWriteVertexAttributes(FILE *file, const XNetAttributeViewList
 				CXIndex original = activeNodes[idx];
 				for (CXSize d = 0; d < view->dimension; d++) {
 					if (d > 0) {
-						fputc(' ', file);
+						CXTextWriterPutChar(out, ' ');
 					}
 					int32_t value = values[(size_t)original * view->attribute->dimension + d];
-					fprintf(file, "%" PRId32, value);
+					CXTextWriterWriteInt64(out, value);
 				}
-				fputc('\n', file);
+				CXTextWriterPutChar(out, '\n');
 			}
 		} else if (view->base == XNetBaseUInt32) {
 			uint32_t *values = (uint32_t *)view->attribute->data;
@@ -3546,12 +4037,12 @@ static CXBool XNetWriteVertexAttributes(FILE *file, const XNetAttributeViewList
 				CXIndex original = activeNodes[idx];
 				for (CXSize d = 0; d < view->dimension; d++) {
 					if (d > 0) {
-						fputc(' ', file);
+						CXTextWriterPutChar(out, ' ');
 					}
 					uint32_t value = values[(size_t)original * view->attribute->dimension + d];
-					fprintf(file, "%" PRIu32, value);
+					CXTextWriterWriteUInt64(out, value);
 				}
-				fputc('\n', file);
+				CXTextWriterPutChar(out, '\n');
 			}
 		} else if (view->base == XNetBaseInt64) {
 			int64_t *values = (int64_t *)view->attribute->data;
@@ -3559,12 +4050,12 @@ static CXBool XNetWriteVertexAttributes(FILE *file, const XNetAttributeViewList
 				CXIndex original = activeNodes[idx];
 				for (CXSize d = 0; d < view->dimension; d++) {
 					if (d > 0) {
-						fputc(' ', file);
+						CXTextWriterPutChar(out, ' ');
 					}
 					int64_t value = values[(size_t)original * view->attribute->dimension + d];
-					fprintf(file, "%" PRId64, value);
+					CXTextWriterWriteInt64(out, value);
 				}
-				fputc('\n', file);
+				CXTextWriterPutChar(out, '\n');
 			}
 		} else if (view->base == XNetBaseUInt64) {
 			uint64_t *values = (uint64_t *)view->attribute->data;
@@ -3572,12 +4063,12 @@ static CXBool XNetWriteVertexAttributes(FILE *file, const XNetAttributeViewList
 				CXIndex original = activeNodes[idx];
 				for (CXSize d = 0; d < view->dimension; d++) {
 					if (d > 0) {
-						fputc(' ', file);
+						CXTextWriterPutChar(out, ' ');
 					}
 					uint64_t value = values[(size_t)original * view->attribute->dimension + d];
-					fprintf(file, "%" PRIu64, value);
+					CXTextWriterWriteUInt64(out, value);
 				}
-				fputc('\n', file);
+				CXTextWriterPutChar(out, '\n');
 			}
 		} else if (view->base == XNetBaseCategory) {
 			int32_t *values = (int32_t *)view->attribute->data;
@@ -3585,17 +4076,17 @@ static CXBool XNetWriteVertexAttributes(FILE *file, const XNetAttributeViewList
 				CXIndex original = activeNodes[idx];
 				for (CXSize d = 0; d < view->dimension; d++) {
 					if (d > 0) {
-						fputc(' ', file);
+						CXTextWriterPutChar(out, ' ');
 					}
 					int32_t value = values[(size_t)original * view->attribute->dimension + d];
-					fprintf(file, "%" PRId32, value);
+					CXTextWriterWriteInt64(out, value);
 				}
-				fputc('\n', file);
+				CXTextWriterPutChar(out, '\n');
 			}
 		} else if (view->base == XNetBaseMultiCategory) {
 			for (CXSize idx = 0; idx < nodeCount; idx++) {
 				CXIndex original = activeNodes[idx];
-				if (!XNetWriteMultiCategoryLine(file, view->attribute, entries, entryCount, original)) {
+				if (!XNetWriteMultiCategoryLine(out, view->attribute, entries, entryCount, original)) {
 					free(entries);
 					return CXFalse;
 				}
@@ -3606,7 +4097,7 @@ static CXBool XNetWriteVertexAttributes(FILE *file, const XNetAttributeViewList
 	return CXTrue;
 }
 
-static CXBool XNetWriteEdgeAttributes(FILE *file, const XNetAttributeViewList *attrs, const CXIndex *edgeOrder, CXSize edgeCount) {
+static CXBool XNetWriteEdgeAttributes(CXTextWriter *out, const XNetAttributeViewList *attrs, const CXIndex *edgeOrder, CXSize edgeCount) {
 	for (size_t i = 0; i < attrs->count; i++) {
 		const XNetAttributeView *view = &attrs->items[i];
 		char typeCode[16];
@@ -3614,8 +4105,8 @@ static CXBool XNetWriteEdgeAttributes(FILE *file, const XNetAttributeViewList *a
 		if (!typeStr) {
 			return CXFalse;
 		}
-		fprintf(file, "#e \"%s\" %s\n", view->name, typeStr);
-		if (!XNetWriteCategoryDictionary(file, view, XNetScopeEdge)) {
+		CXTextWriterPrintf(out, "#e \"%s\" %s\n", view->name, typeStr);
+		if (!XNetWriteCategoryDictionary(out, view, XNetScopeEdge)) {
 			return CXFalse;
 		}
 		XNetCategoryWriteEntry *entries = NULL;
@@ -3628,8 +4119,8 @@ static CXBool XNetWriteEdgeAttributes(FILE *file, const XNetAttributeViewList *a
 			for (CXSize idx = 0; idx < edgeCount; idx++) {
 				CXIndex original = edgeOrder[idx];
 				CXString value = values ? values[original] : NULL;
-				XNetWriteEscapedString(file, value ? value : "");
-				fputc('\n', file);
+				XNetWriteEscapedString(out, value ? value : "");
+				CXTextWriterPutChar(out, '\n');
 			}
 		} else if (view->base == XNetBaseFloat) {
 			float *values = (float *)view->attribute->data;
@@ -3637,12 +4128,12 @@ static CXBool XNetWriteEdgeAttributes(FILE *file, const XNetAttributeViewList *a
 				CXIndex original = edgeOrder[idx];
 				for (CXSize d = 0; d < view->dimension; d++) {
 					if (d > 0) {
-						fputc(' ', file);
+						CXTextWriterPutChar(out, ' ');
 					}
 					float value = values[(size_t)original * view->attribute->dimension + d];
-					fprintf(file, "%.9g", value);
+					CXTextWriterWriteFloat(out, value);
 				}
-				fputc('\n', file);
+				CXTextWriterPutChar(out, '\n');
 			}
 		} else if (view->base == XNetBaseInt32) {
 			int32_t *values = (int32_t *)view->attribute->data;
@@ -3650,12 +4141,12 @@ static CXBool XNetWriteEdgeAttributes(FILE *file, const XNetAttributeViewList *a
 				CXIndex original = edgeOrder[idx];
 				for (CXSize d = 0; d < view->dimension; d++) {
 					if (d > 0) {
-						fputc(' ', file);
+						CXTextWriterPutChar(out, ' ');
 					}
 					int32_t value = values[(size_t)original * view->attribute->dimension + d];
-					fprintf(file, "%" PRId32, value);
+					CXTextWriterWriteInt64(out, value);
 				}
-				fputc('\n', file);
+				CXTextWriterPutChar(out, '\n');
 			}
 		} else if (view->base == XNetBaseUInt32) {
 			uint32_t *values = (uint32_t *)view->attribute->data;
@@ -3663,12 +4154,12 @@ static CXBool XNetWriteEdgeAttributes(FILE *file, const XNetAttributeViewList *a
 				CXIndex original = edgeOrder[idx];
 				for (CXSize d = 0; d < view->dimension; d++) {
 					if (d > 0) {
-						fputc(' ', file);
+						CXTextWriterPutChar(out, ' ');
 					}
 					uint32_t value = values[(size_t)original * view->attribute->dimension + d];
-					fprintf(file, "%" PRIu32, value);
+					CXTextWriterWriteUInt64(out, value);
 				}
-				fputc('\n', file);
+				CXTextWriterPutChar(out, '\n');
 			}
 		} else if (view->base == XNetBaseInt64) {
 			int64_t *values = (int64_t *)view->attribute->data;
@@ -3676,12 +4167,12 @@ static CXBool XNetWriteEdgeAttributes(FILE *file, const XNetAttributeViewList *a
 				CXIndex original = edgeOrder[idx];
 				for (CXSize d = 0; d < view->dimension; d++) {
 					if (d > 0) {
-						fputc(' ', file);
+						CXTextWriterPutChar(out, ' ');
 					}
 					int64_t value = values[(size_t)original * view->attribute->dimension + d];
-					fprintf(file, "%" PRId64, value);
+					CXTextWriterWriteInt64(out, value);
 				}
-				fputc('\n', file);
+				CXTextWriterPutChar(out, '\n');
 			}
 		} else if (view->base == XNetBaseUInt64) {
 			uint64_t *values = (uint64_t *)view->attribute->data;
@@ -3689,12 +4180,12 @@ static CXBool XNetWriteEdgeAttributes(FILE *file, const XNetAttributeViewList *a
 				CXIndex original = edgeOrder[idx];
 				for (CXSize d = 0; d < view->dimension; d++) {
 					if (d > 0) {
-						fputc(' ', file);
+						CXTextWriterPutChar(out, ' ');
 					}
 					uint64_t value = values[(size_t)original * view->attribute->dimension + d];
-					fprintf(file, "%" PRIu64, value);
+					CXTextWriterWriteUInt64(out, value);
 				}
-				fputc('\n', file);
+				CXTextWriterPutChar(out, '\n');
 			}
 		} else if (view->base == XNetBaseCategory) {
 			int32_t *values = (int32_t *)view->attribute->data;
@@ -3702,17 +4193,17 @@ static CXBool XNetWriteEdgeAttributes(FILE *file, const XNetAttributeViewList *a
 				CXIndex original = edgeOrder[idx];
 				for (CXSize d = 0; d < view->dimension; d++) {
 					if (d > 0) {
-						fputc(' ', file);
+						CXTextWriterPutChar(out, ' ');
 					}
 					int32_t value = values[(size_t)original * view->attribute->dimension + d];
-					fprintf(file, "%" PRId32, value);
+					CXTextWriterWriteInt64(out, value);
 				}
-				fputc('\n', file);
+				CXTextWriterPutChar(out, '\n');
 			}
 		} else if (view->base == XNetBaseMultiCategory) {
 			for (CXSize idx = 0; idx < edgeCount; idx++) {
 				CXIndex original = edgeOrder[idx];
-				if (!XNetWriteMultiCategoryLine(file, view->attribute, entries, entryCount, original)) {
+				if (!XNetWriteMultiCategoryLine(out, view->attribute, entries, entryCount, original)) {
 					free(entries);
 					return CXFalse;
 				}
@@ -3723,7 +4214,7 @@ static CXBool XNetWriteEdgeAttributes(FILE *file, const XNetAttributeViewList *a
 	return CXTrue;
 }
 
-static CXBool XNetWriteGraphAttributes(FILE *file, const XNetAttributeViewList *attrs) {
+static CXBool XNetWriteGraphAttributes(CXTextWriter *out, const XNetAttributeViewList *attrs) {
 	for (size_t i = 0; i < attrs->count; i++) {
 		const XNetAttributeView *view = &attrs->items[i];
 		char typeCode[16];
@@ -3731,8 +4222,8 @@ static CXBool XNetWriteGraphAttributes(FILE *file, const XNetAttributeViewList *
 		if (!typeStr) {
 			return CXFalse;
 		}
-		fprintf(file, "#g \"%s\" %s\n", view->name, typeStr);
-		if (!XNetWriteCategoryDictionary(file, view, XNetScopeGraph)) {
+		CXTextWriterPrintf(out, "#g \"%s\" %s\n", view->name, typeStr);
+		if (!XNetWriteCategoryDictionary(out, view, XNetScopeGraph)) {
 			return CXFalse;
 		}
 		XNetCategoryWriteEntry *entries = NULL;
@@ -3742,64 +4233,64 @@ static CXBool XNetWriteGraphAttributes(FILE *file, const XNetAttributeViewList *
 		}
 		if (view->base == XNetBaseString) {
 			CXString *value = (CXString *)view->attribute->data;
-			XNetWriteEscapedString(file, value && value[0] ? value[0] : "");
-			fputc('\n', file);
+			XNetWriteEscapedString(out, value && value[0] ? value[0] : "");
+			CXTextWriterPutChar(out, '\n');
 		} else if (view->base == XNetBaseFloat) {
 			float *value = (float *)view->attribute->data;
 			for (CXSize d = 0; d < view->dimension; d++) {
 				if (d > 0) {
-					fputc(' ', file);
+					CXTextWriterPutChar(out, ' ');
 				}
-				fprintf(file, "%.9g", value[d]);
+				CXTextWriterWriteFloat(out, value[d]);
 			}
-			fputc('\n', file);
+			CXTextWriterPutChar(out, '\n');
 		} else if (view->base == XNetBaseInt32) {
 			int32_t *value = (int32_t *)view->attribute->data;
 			for (CXSize d = 0; d < view->dimension; d++) {
 				if (d > 0) {
-					fputc(' ', file);
+					CXTextWriterPutChar(out, ' ');
 				}
-				fprintf(file, "%" PRId32, value[d]);
+				CXTextWriterWriteInt64(out, value[d]);
 			}
-			fputc('\n', file);
+			CXTextWriterPutChar(out, '\n');
 		} else if (view->base == XNetBaseUInt32) {
 			uint32_t *value = (uint32_t *)view->attribute->data;
 			for (CXSize d = 0; d < view->dimension; d++) {
 				if (d > 0) {
-					fputc(' ', file);
+					CXTextWriterPutChar(out, ' ');
 				}
-				fprintf(file, "%" PRIu32, value[d]);
+				CXTextWriterWriteUInt64(out, value[d]);
 			}
-			fputc('\n', file);
+			CXTextWriterPutChar(out, '\n');
 		} else if (view->base == XNetBaseInt64) {
 			int64_t *value = (int64_t *)view->attribute->data;
 			for (CXSize d = 0; d < view->dimension; d++) {
 				if (d > 0) {
-					fputc(' ', file);
+					CXTextWriterPutChar(out, ' ');
 				}
-				fprintf(file, "%" PRId64, value[d]);
+				CXTextWriterWriteInt64(out, value[d]);
 			}
-			fputc('\n', file);
+			CXTextWriterPutChar(out, '\n');
 		} else if (view->base == XNetBaseUInt64) {
 			uint64_t *value = (uint64_t *)view->attribute->data;
 			for (CXSize d = 0; d < view->dimension; d++) {
 				if (d > 0) {
-					fputc(' ', file);
+					CXTextWriterPutChar(out, ' ');
 				}
-				fprintf(file, "%" PRIu64, value[d]);
+				CXTextWriterWriteUInt64(out, value[d]);
 			}
-			fputc('\n', file);
+			CXTextWriterPutChar(out, '\n');
 		} else if (view->base == XNetBaseCategory) {
 			int32_t *value = (int32_t *)view->attribute->data;
 			for (CXSize d = 0; d < view->dimension; d++) {
 				if (d > 0) {
-					fputc(' ', file);
+					CXTextWriterPutChar(out, ' ');
 				}
-				fprintf(file, "%" PRId32, value[d]);
+				CXTextWriterWriteInt64(out, value[d]);
 			}
-			fputc('\n', file);
+			CXTextWriterPutChar(out, '\n');
 		} else if (view->base == XNetBaseMultiCategory) {
-			if (!XNetWriteMultiCategoryLine(file, view->attribute, entries, entryCount, 0)) {
+			if (!XNetWriteMultiCategoryLine(out, view->attribute, entries, entryCount, 0)) {
 				free(entries);
 				return CXFalse;
 			}
@@ -3839,8 +4330,9 @@ CXBool CXNetworkWriteXNetFiltered(CXNetworkRef network,
 		errno = EINVAL;
 		return CXFalse;
 	}
-	FILE *file = fopen(path, "wb");
-	if (!file) {
+	CXTextWriter writer;
+	CXTextWriter *out = &writer;
+	if (!CXTextWriterOpen(out, path)) {
 		return CXFalse;
 	}
 
@@ -3852,10 +4344,9 @@ CXBool CXNetworkWriteXNetFiltered(CXNetworkRef network,
 	CXIndex *activeNodes = nodeCount > 0 ? malloc(sizeof(CXIndex) * nodeCount) : NULL;
 	CXIndex *edgeOrder = edgeCount > 0 ? malloc(sizeof(CXIndex) * edgeCount) : NULL;
 	CXEdge *compactEdges = edgeCount > 0 ? malloc(sizeof(CXEdge) * edgeCount) : NULL;
-	char **originalIdStrings = nodeCount > 0 ? calloc(nodeCount, sizeof(char *)) : NULL;
 	CXBool success = CXFalse;
 
-	if ((nodeCount > 0 && (!nodeRemap || !activeNodes || !originalIdStrings)) ||
+	if ((nodeCount > 0 && (!nodeRemap || !activeNodes)) ||
 	    (edgeCount > 0 && (!edgeOrder || !compactEdges))) {
 		goto cleanup;
 	}
@@ -3870,12 +4361,6 @@ CXBool CXNetworkWriteXNetFiltered(CXNetworkRef network,
 			if (activeNodes) {
 				activeNodes[nextNode] = (CXIndex)i;
 			}
-			if (originalIdStrings) {
-				originalIdStrings[nextNode] = CXNewStringFromFormat("%" PRIu64, (uint64_t)i);
-				if (!originalIdStrings[nextNode]) {
-					goto cleanup;
-				}
-			}
 			nextNode++;
 		}
 	}
@@ -3925,35 +4410,38 @@ CXBool CXNetworkWriteXNetFiltered(CXNetworkRef network,
 		goto cleanup;
 	}
 
-	fprintf(file, "%s\n", XNET_HEADER_LINE);
-	fprintf(file, "#vertices %zu\n", (size_t)nodeCount);
-	if (!XNetWriteGraphAttributes(file, &graphAttrs)) {
+	CXTextWriterPrintf(out, "%s\n", XNET_HEADER_LINE);
+	CXTextWriterPrintf(out, "#vertices %zu\n", (size_t)nodeCount);
+	if (!XNetWriteGraphAttributes(out, &graphAttrs)) {
 		XNetAttributeViewListFree(&nodeAttrs);
 		XNetAttributeViewListFree(&edgeAttrs);
 		XNetAttributeViewListFree(&graphAttrs);
 		goto cleanup;
 	}
-	fprintf(file, "#edges %s\n", directed ? "directed" : "undirected");
+	CXTextWriterPrintf(out, "#edges %s\n", directed ? "directed" : "undirected");
 	for (CXSize i = 0; i < edgeCount; i++) {
-		fprintf(file, "%zu %zu\n", (size_t)compactEdges[i].from, (size_t)compactEdges[i].to);
+		CXTextWriterWriteUInt64(out, (uint64_t)compactEdges[i].from);
+		CXTextWriterPutChar(out, ' ');
+		CXTextWriterWriteUInt64(out, (uint64_t)compactEdges[i].to);
+		CXTextWriterPutChar(out, '\n');
 	}
-	if (!XNetWriteVertexAttributes(file, &nodeAttrs, activeNodes, nodeCount)) {
+	if (!XNetWriteVertexAttributes(out, &nodeAttrs, activeNodes, nodeCount)) {
 		XNetAttributeViewListFree(&nodeAttrs);
 		XNetAttributeViewListFree(&edgeAttrs);
 		XNetAttributeViewListFree(&graphAttrs);
 		goto cleanup;
 	}
 
-	// Write original IDs attribute
+	// Write original IDs attribute (plain decimal ids never need quoting)
 	if (nodeCount > 0) {
-		fprintf(file, "#v \"_original_ids_\" s\n");
+		CXTextWriterPuts(out, "#v \"_original_ids_\" s\n");
 		for (CXSize i = 0; i < nodeCount; i++) {
-			XNetWriteEscapedString(file, originalIdStrings[i] ? originalIdStrings[i] : "");
-			fputc('\n', file);
+			CXTextWriterWriteUInt64(out, (uint64_t)activeNodes[i]);
+			CXTextWriterPutChar(out, '\n');
 		}
 	}
 
-	if (!XNetWriteEdgeAttributes(file, &edgeAttrs, edgeOrder, edgeCount)) {
+	if (!XNetWriteEdgeAttributes(out, &edgeAttrs, edgeOrder, edgeCount)) {
 		XNetAttributeViewListFree(&nodeAttrs);
 		XNetAttributeViewListFree(&edgeAttrs);
 		XNetAttributeViewListFree(&graphAttrs);
@@ -3964,24 +4452,20 @@ CXBool CXNetworkWriteXNetFiltered(CXNetworkRef network,
 	XNetAttributeViewListFree(&edgeAttrs);
 	XNetAttributeViewListFree(&graphAttrs);
 
-	if (ferror(file)) {
+	if (out->failed) {
 		goto cleanup;
 	}
 	success = CXTrue;
 
 cleanup:
-	if (originalIdStrings) {
-		for (CXSize i = 0; i < nodeCount; i++) {
-			free(originalIdStrings[i]);
-		}
-	}
-	free(originalIdStrings);
 	free(nodeRemap);
 	free(activeNodes);
 	free(edgeOrder);
 	free(compactEdges);
 
-	fclose(file);
+	if (!CXTextWriterClose(out)) {
+		success = CXFalse;
+	}
 	return success;
 }
 
@@ -0,0 +1,372 @@
+//
+//  CXTextWriter.c
+//  Helios Network Core
+//
+
+#include "CXTextWriter.h"
+
+#include <errno.h>
+#include <float.h>
+#include <math.h>
+#include <stdarg.h>
+#include <stdlib.h>
+
+static const char CXTextDigitPairs[201] =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+static const double CXTextPowersOfTen[] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+CXBool CXTextWriterOpen(CXTextWriter *writer, const char *path) {
+	if (!writer || !path) {
+		errno = EINVAL;
+		return CXFalse;
+	}
+	memset(writer, 0, sizeof(*writer));
+	writer->buffer = malloc(CX_TEXT_WRITER_BUFFER_SIZE);
+	if (!writer->buffer) {
+		errno = ENOMEM;
+		return CXFalse;
+	}
+	writer->file = fopen(path, "wb");
+	if (!writer->file) {
+		free(writer->buffer);
+		writer->buffer = NULL;
+		return CXFalse;
+	}
+	/* Output already arrives in large blocks; a second stdio copy buys nothing. */
+	setvbuf(writer->file, NULL, _IONBF, 0);
+	writer->capacity = CX_TEXT_WRITER_BUFFER_SIZE;
+	return CXTrue;
+}
+
+CXBool CXTextWriterFlush(CXTextWriter *writer) {
+	if (writer->failed) {
+		writer->length = 0;
+		return CXFalse;
+	}
+	if (writer->length > 0 && fwrite(writer->buffer, 1, writer->length, writer->file) != writer->length) {
+		writer->failed = CXTrue;
+	}
+	writer->length = 0;
+	return !writer->failed;
+}
+
+CXBool CXTextWriterClose(CXTextWriter *writer) {
+	if (!writer || !writer->file) {
+		return CXFalse;
+	}
+	CXBool ok = CXTextWriterFlush(writer);
+	if (fclose(writer->file) != 0) {
+		ok = CXFalse;
+	}
+	free(writer->buffer);
+	memset(writer, 0, sizeof(*writer));
+	return ok;
+}
+
+void CXTextWriterWriteSlow(CXTextWriter *writer, const void *data, size_t length) {
+	if (!CXTextWriterFlush(writer)) {
+		return;
+	}
+	if (length >= writer->capacity) {
+		if (fwrite(data, 1, length, writer->file) != length) {
+			writer->failed = CXTrue;
+		}
+		return;
+	}
+	memcpy(writer->buffer, data, length);
+	writer->length = length;
+}
+
+void CXTextWriterPrintf(CXTextWriter *writer, const char *format, ...) {
+	va_list args;
+	va_start(args, format);
+	va_list retry;
+	va_copy(retry, args);
+	size_t room = writer->capacity - writer->length;
+	int needed = vsnprintf(writer->buffer + writer->length, room, format, args);
+	va_end(args);
+	if (needed < 0) {
+		writer->failed = CXTrue;
+	} else if ((size_t)needed < room) {
+		writer->length += (size_t)needed;
+	} else {
+		char *text = malloc((size_t)needed + 1u);
+		if (text) {
+			vsnprintf(text, (size_t)needed + 1u, format, retry);
+			CXTextWriterWrite(writer, text, (size_t)needed);
+			free(text);
+		} else {
+			writer->failed = CXTrue;
+		}
+	}
+	va_end(retry);
+}
+
+size_t CXTextFormatUInt64(char *out, uint64_t value) {
+	char scratch[24];
+	char *cursor = scratch + sizeof(scratch);
+	while (value >= 100u) {
+		unsigned pair = (unsigned)(value % 100u) * 2u;
+		value /= 100u;
+		*--cursor = CXTextDigitPairs[pair + 1u];
+		*--cursor = CXTextDigitPairs[pair];
+	}
+	if (value >= 10u) {
+		*--cursor = CXTextDigitPairs[value * 2u + 1u];
+		*--cursor = CXTextDigitPairs[value * 2u];
+	} else {
+		*--cursor = (char)('0' + value);
+	}
+	size_t length = (size_t)(scratch + sizeof(scratch) - cursor);
+	memcpy(out, cursor, length);
+	out[length] = '\0';
+	return length;
+}
+
+size_t CXTextFormatInt64(char *out, int64_t value) {
+	if (value < 0) {
+		out[0] = '-';
+		return 1u + CXTextFormatUInt64(out + 1, (uint64_t)0 - (uint64_t)value);
+	}
+	return CXTextFormatUInt64(out, (uint64_t)value);
+}
+
+/* Distance, in units of the last double place, from `value` to the nearest
+ * point halfway between two adjacent normal floats (those points are the
+ * doubles whose 29 bits below float precision are 1 followed by zeros). */
+static uint32_t CXTextFloatMidpointDistance(double value) {
+	uint64_t bits = 0;
+	memcpy(&bits, &value, sizeof(bits));
+	uint32_t low = (uint32_t)(bits & 0x1FFFFFFFu);
+	return low >= 0x10000000u ? low - 0x10000000u : 0x10000000u - low;
+}
+
+/*
+ * Shortest decimal m * 10^k that reads back as `value` (positive, finite).
+ * Candidates with 1, 2, ... significant digits are tried in turn and rebuilt
+ * as doubles to check them. While m < 2^53 and |k| <= 22 the rebuild is one
+ * exact multiply or divide, so it is the correctly rounded double and the
+ * check is exact for doubles. Floats round that double once more, which can
+ * only go astray when an inexact rebuild lands on a float midpoint; such
+ * candidates are skipped. Normal floats outside the exact range are rebuilt
+ * through pow() instead, skipping candidates within a few double places of a
+ * midpoint. Returns CXFalse when no candidate passes or the value is out of
+ * range; callers fall back to printf then.
+ */
+static CXBool CXTextShortestDecimal(double value, CXBool single, uint64_t *outDigits, int *outExponent) {
+	int maxDigits = single ? 9 : 15;
+	int e10 = (int)floor(log10(value));
+	if (single ? value < (double)FLT_MIN : (e10 > 22 || e10 - maxDigits + 1 < -22)) {
+		return CXFalse;
+	}
+	if (e10 >= 0 && e10 <= 22 && value < CXTextPowersOfTen[e10]) {
+		e10--;
+	} else if (e10 + 1 >= 0 && e10 + 1 <= 22 && value >= CXTextPowersOfTen[e10 + 1]) {
+		e10++;
+	}
+	float target = (float)value;
+	for (int digits = 1; digits <= maxDigits; digits++) {
+		int k = e10 - digits + 1;
+		CXBool exact = k >= -22 && k <= 22;
+		if (!exact && !single) {
+			continue;
+		}
+		double scaled = exact
+			? (k >= 0 ? value / CXTextPowersOfTen[k] : value * CXTextPowersOfTen[-k])
+			: value * pow(10.0, -k);
+		double rounded = floor(scaled + 0.5);
+		if (rounded < 1.0 || rounded >= 9007199254740992.0) {
+			continue;
+		}
+		double back = exact
+			? (k >= 0 ? rounded * CXTextPowersOfTen[k] : rounded / CXTextPowersOfTen[-k])
+			: rounded * pow(10.0, k);
+		/* Whole numbers below 2^53 are rebuilt without any rounding at all. */
+		CXBool wholeNumber = exact && k >= 0 && back < 9007199254740992.0;
+		CXBool matches = single
+			? ((float)back == target && (wholeNumber || CXTextFloatMidpointDistance(back) > (exact ? 0u : 8u)))
+			: back == value;
+		if (matches) {
+			*outDigits = (uint64_t)rounded;
+			*outExponent = k;
+			return CXTrue;
+		}
+	}
+	return CXFalse;
+}
+
+/* Lays out m * 10^k the way `%.<precision>g` does, minus trailing zeros. */
+static size_t CXTextLayoutDecimal(char *out, CXBool negative, uint64_t mantissa, int exponent, int precision) {
+	while (mantissa % 10u == 0u) {
+		mantissa /= 10u;
+		exponent++;
+	}
+	char digits[24];
+	int count = (int)CXTextFormatUInt64(digits, mantissa);
+	int decimalExponent = exponent + count - 1;
+	char *cursor = out;
+	if (negative) {
+		*cursor++ = '-';
+	}
+	if (decimalExponent < -4 || decimalExponent >= precision) {
+		*cursor++ = digits[0];
+		if (count > 1) {
+			*cursor++ = '.';
+			memcpy(cursor, digits + 1, (size_t)count - 1u);
+			cursor += count - 1;
+		}
+		*cursor++ = 'e';
+		*cursor++ = decimalExponent < 0 ? '-' : '+';
+		int magnitude = decimalExponent < 0 ? -decimalExponent : decimalExponent;
+		if (magnitude >= 100) {
+			*cursor++ = (char)('0' + magnitude / 100);
+			magnitude %= 100;
+		}
+		*cursor++ = CXTextDigitPairs[magnitude * 2];
+		*cursor++ = CXTextDigitPairs[magnitude * 2 + 1];
+	} else if (exponent >= 0) {
+		memcpy(cursor, digits, (size_t)count);
+		cursor += count;
+		for (int i = 0; i < exponent; i++) {
+			*cursor++ = '0';
+		}
+	} else if (decimalExponent >= 0) {
+		memcpy(cursor, digits, (size_t)decimalExponent + 1u);
+		cursor += decimalExponent + 1;
+		*cursor++ = '.';
+		memcpy(cursor, digits + decimalExponent + 1, (size_t)(count - decimalExponent - 1));
+		cursor += count - decimalExponent - 1;
+	} else {
+		*cursor++ = '0';
+		*cursor++ = '.';
+		for (int i = -1; i > decimalExponent; i--) {
+			*cursor++ = '0';
+		}
+		memcpy(cursor, digits, (size_t)count);
+		cursor += count;
+	}
+	*cursor = '\0';
+	return (size_t)(cursor - out);
+}
+
+static size_t CXTextFormatReal(char *out, double value, CXBool single) {
+	int precision = single ? 9 : 17;
+	if (value == 0.0) {
+		return (size_t)snprintf(out, CX_TEXT_NUMBER_MAX, "%s", signbit(value) ? "-0" : "0");
+	}
+	if (isfinite(value)) {
+		uint64_t mantissa = 0;
+		int exponent = 0;
+		if (CXTextShortestDecimal(fabs(value), single, &mantissa, &exponent)) {
+			return CXTextLayoutDecimal(out, value < 0.0, mantissa, exponent, precision);
+		}
+	}
+	int length = snprintf(out, CX_TEXT_NUMBER_MAX, "%.*g", precision, value);
+	return length > 0 ? (size_t)length : 0u;
+}
+
+size_t CXTextFormatFloat(char *out, float value) {
+	return CXTextFormatReal(out, (double)value, CXTrue);
+}
+
+size_t CXTextFormatDouble(char *out, double value) {
+	return CXTextFormatReal(out, value, CXFalse);
+}
+
+void CXTextWriterWriteInt64(CXTextWriter *writer, int64_t value) {
+	char *out = CXTextWriterReserve(writer, CX_TEXT_NUMBER_MAX);
+	if (out) {
+		writer->length += CXTextFormatInt64(out, value);
+	}
+}
+
+void CXTextWriterWriteUInt64(CXTextWriter *writer, uint64_t value) {
+	char *out = CXTextWriterReserve(writer, CX_TEXT_NUMBER_MAX);
+	if (out) {
+		writer->length += CXTextFormatUInt64(out, value);
+	}
+}
+
+void CXTextWriterWriteFloat(CXTextWriter *writer, float value) {
+	char *out = CXTextWriterReserve(writer, CX_TEXT_NUMBER_MAX);
+	if (out) {
+		writer->length += CXTextFormatFloat(out, value);
+	}
+}
+
+void CXTextWriterWriteDouble(CXTextWriter *writer, double value) {
+	char *out = CXTextWriterReserve(writer, CX_TEXT_NUMBER_MAX);
+	if (out) {
+		writer->length += CXTextFormatDouble(out, value);
+	}
+}
+
+static CXBool CXTextNeedsEscape(unsigned char ch, CXTextEscapeStyle style) {
+	if (ch == '"' || ch == '\\') {
+		return CXTrue;
+	}
+	if (ch < 0x20u) {
+		return style != CXTextEscapeGML || ch == '\n' || ch == '\r' || ch == '\t';
+	}
+	return style == CXTextEscapeXNet && ch == 0x7Fu;
+}
+
+void CXTextWriterWriteEscaped(CXTextWriter *writer, const char *text, CXTextEscapeStyle style) {
+	static const char hex[] = "0123456789abcdef0123456789ABCDEF";
+	if (!text) {
+		return;
+	}
+	const unsigned char *cursor = (const unsigned char *)text;
+	while (*cursor) {
+		const unsigned char *run = cursor;
+		while (*cursor && !CXTextNeedsEscape(*cursor, style)) {
+			cursor++;
+		}
+		if (cursor > run) {
+			CXTextWriterWrite(writer, run, (size_t)(cursor - run));
+		}
+		if (!*cursor) {
+			break;
+		}
+		unsigned char ch = *cursor++;
+		char escape[6] = { '\\', 0, 0, 0, 0, 0 };
+		size_t length = 2;
+		switch (ch) {
+			case '\\': escape[1] = '\\'; break;
+			case '"': escape[1] = '"'; break;
+			case '\n': escape[1] = 'n'; break;
+			case '\r': escape[1] = 'r'; break;
+			case '\t': escape[1] = 't'; break;
+			case '\b': escape[1] = style == CXTextEscapeJSON ? 'b' : 0; break;
+			case '\f': escape[1] = style == CXTextEscapeJSON ? 'f' : 0; break;
+			default: break;
+		}
+		if (!escape[1]) {
+			if (style == CXTextEscapeJSON) {
+				memcpy(escape + 1, "u00", 3);
+				escape[4] = hex[ch >> 4];
+				escape[5] = hex[ch & 0x0Fu];
+				length = 6;
+			} else {
+				escape[1] = 'x';
+				escape[2] = hex[16 + (ch >> 4)];
+				escape[3] = hex[16 + (ch & 0x0Fu)];
+				length = 4;
+			}
+		}
+		CXTextWriterWrite(writer, escape, length);
+	}
+}
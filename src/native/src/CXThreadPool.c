@@ -0,0 +1,324 @@
+//
+//  CXThreadPool.c
+//  Helios Network Core
+//
+//  Persistent worker pool with per-worker block cursors. The calling thread
+//  always participates as worker 0; pool threads are spawned lazily the first
+//  time a loop needs them and are reused afterwards.
+//
+
+#include "CXThreadPool.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if CX_THREAD_POOL_THREADED
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
+#if defined(__EMSCRIPTEN__)
+#include <emscripten/threading.h>
+#endif
+#endif
+
+#define CX_THREAD_POOL_CACHE_LINE 64u
+
+#if CX_THREAD_POOL_THREADED
+
+typedef struct {
+	atomic_uint_fast64_t next;
+	uint64_t end;
+	char padding[CX_THREAD_POOL_CACHE_LINE - sizeof(atomic_uint_fast64_t) - sizeof(uint64_t)];
+} CXThreadPoolCursor;
+
+typedef struct {
+	CXParallelRangeFunction function;
+	void *context;
+	CXSize count;
+	CXSize grainSize;
+	CXSize workerCount;
+	atomic_size_t pendingWorkers;
+	CXThreadPoolCursor cursors[CX_THREAD_POOL_MAX_WORKERS];
+} CXThreadPoolJob;
+
+typedef struct {
+	pthread_mutex_t mutex;
+	pthread_cond_t wakeCondition;
+	pthread_cond_t doneCondition;
+	pthread_mutex_t submitMutex;
+	pthread_t threads[CX_THREAD_POOL_MAX_WORKERS];
+	CXSize startGenerations[CX_THREAD_POOL_MAX_WORKERS];
+	CXSize threadCount;
+	CXSize generation;
+	CXSize jobWorkerCount;
+	CXThreadPoolJob *job;
+	CXBool stopping;
+} CXThreadPoolState;
+
+static CXThreadPoolState CXThreadPoolShared = {
+	.mutex = PTHREAD_MUTEX_INITIALIZER,
+	.wakeCondition = PTHREAD_COND_INITIALIZER,
+	.doneCondition = PTHREAD_COND_INITIALIZER,
+	.submitMutex = PTHREAD_MUTEX_INITIALIZER,
+};
+
+static atomic_size_t CXThreadPoolConfiguredWorkers = 0;
+static atomic_size_t CXThreadPoolDefaultWorkers = 0;
+static _Thread_local CXBool CXThreadPoolInsideLoop = CXFalse;
+
+#endif
+
+CXSize CXThreadPoolHardwareConcurrency(void) {
+#if CX_THREAD_POOL_THREADED
+#if defined(__EMSCRIPTEN__)
+	int cores = emscripten_num_logical_cores();
+	return cores > 0 ? (CXSize)cores : 1;
+#elif defined(_SC_NPROCESSORS_ONLN)
+	long cores = sysconf(_SC_NPROCESSORS_ONLN);
+	return cores > 0 ? (CXSize)cores : 1;
+#else
+	return 1;
+#endif
+#else
+	return 1;
+#endif
+}
+
+static CXSize CXThreadPoolClampWorkers(CXSize workers) {
+	if (workers == 0) {
+		return 1;
+	}
+	return CXMIN(workers, (CXSize)CX_THREAD_POOL_MAX_WORKERS);
+}
+
+void CXThreadPoolSetWorkerCount(CXSize workerCount) {
+#if CX_THREAD_POOL_THREADED
+	atomic_store(&CXThreadPoolConfiguredWorkers, (size_t)(workerCount == 0 ? 0 : CXThreadPoolClampWorkers(workerCount)));
+#else
+	(void)workerCount;
+#endif
+}
+
+CXSize CXThreadPoolGetWorkerCount(void) {
+#if CX_THREAD_POOL_THREADED
+	size_t configured = atomic_load(&CXThreadPoolConfiguredWorkers);
+	if (configured > 0) {
+		return (CXSize)configured;
+	}
+	size_t fallback = atomic_load(&CXThreadPoolDefaultWorkers);
+	if (fallback == 0) {
+		CXSize workers = 0;
+		const char *env = getenv("HELIOS_NUM_THREADS");
+		if (env && env[0]) {
+			char *endPtr = NULL;
+			unsigned long long parsed = strtoull(env, &endPtr, 10);
+			if (endPtr && *endPtr == '\0') {
+				workers = (CXSize)parsed;
+			}
+		}
+		if (workers == 0) {
+			workers = CXThreadPoolHardwareConcurrency();
+		}
+		fallback = (size_t)CXThreadPoolClampWorkers(workers);
+		atomic_store(&CXThreadPoolDefaultWorkers, fallback);
+	}
+	return (CXSize)fallback;
+#else
+	return 1;
+#endif
+}
+
+CXSize CXParallelWorkerCount(CXSize taskCount) {
+	if (taskCount == 0) {
+		return 0;
+	}
+	return CXMIN(taskCount, CXThreadPoolGetWorkerCount());
+}
+
+static void CXThreadPoolRunSerial(CXSize count, CXSize grainSize, CXParallelRangeFunction function, void *context) {
+	for (CXIndex start = 0; start < count; start += grainSize) {
+		CXIndex end = CXMIN(count, start + grainSize);
+		function(context, start, end, 0);
+	}
+}
+
+#if CX_THREAD_POOL_THREADED
+
+static void CXThreadPoolDrainCursor(CXThreadPoolJob *job, CXSize victim, CXSize workerIndex) {
+	CXThreadPoolCursor *cursor = &job->cursors[victim];
+	for (;;) {
+		uint64_t block = atomic_fetch_add_explicit(&cursor->next, 1, memory_order_relaxed);
+		if (block >= cursor->end) {
+			return;
+		}
+		CXIndex start = (CXIndex)block * job->grainSize;
+		CXIndex end = CXMIN(job->count, start + job->grainSize);
+		job->function(job->context, start, end, workerIndex);
+	}
+}
+
+static void CXThreadPoolRunJob(CXThreadPoolJob *job, CXSize workerIndex) {
+	CXThreadPoolDrainCursor(job, workerIndex, workerIndex);
+	for (CXSize offset = 1; offset < job->workerCount; offset++) {
+		CXThreadPoolDrainCursor(job, (workerIndex + offset) % job->workerCount, workerIndex);
+	}
+}
+
+static void CXThreadPoolFinishWorker(CXThreadPoolJob *job) {
+	if (atomic_fetch_sub_explicit(&job->pendingWorkers, 1, memory_order_acq_rel) == 1) {
+		pthread_mutex_lock(&CXThreadPoolShared.mutex);
+		pthread_cond_broadcast(&CXThreadPoolShared.doneCondition);
+		pthread_mutex_unlock(&CXThreadPoolShared.mutex);
+	}
+}
+
+static void *CXThreadPoolWorkerMain(void *argument) {
+	CXSize workerIndex = (CXSize)(uintptr_t)argument;
+	CXThreadPoolState *pool = &CXThreadPoolShared;
+	CXThreadPoolInsideLoop = CXTrue;
+
+	pthread_mutex_lock(&pool->mutex);
+	CXSize seenGeneration = pool->startGenerations[workerIndex];
+	for (;;) {
+		while (!pool->stopping && pool->generation == seenGeneration) {
+			pthread_cond_wait(&pool->wakeCondition, &pool->mutex);
+		}
+		if (pool->stopping) {
+			break;
+		}
+		seenGeneration = pool->generation;
+		CXThreadPoolJob *job = workerIndex < pool->jobWorkerCount ? pool->job : NULL;
+		pthread_mutex_unlock(&pool->mutex);
+
+		if (job) {
+			CXThreadPoolRunJob(job, workerIndex);
+			CXThreadPoolFinishWorker(job);
+		}
+
+		pthread_mutex_lock(&pool->mutex);
+	}
+	pthread_mutex_unlock(&pool->mutex);
+	return NULL;
+}
+
+/* Must be called with pool->mutex held. Returns the number of usable workers. */
+static CXSize CXThreadPoolEnsureThreads(CXThreadPoolState *pool, CXSize workerCount) {
+	while (pool->threadCount + 1 < workerCount) {
+		CXSize workerIndex = pool->threadCount + 1;
+		pool->startGenerations[workerIndex] = pool->generation;
+		if (pthread_create(&pool->threads[pool->threadCount], NULL, CXThreadPoolWorkerMain, (void *)(uintptr_t)workerIndex) != 0) {
+			break;
+		}
+		pool->threadCount++;
+	}
+	return CXMIN(workerCount, pool->threadCount + 1);
+}
+
+#endif
+
+void CXParallelForRange(
+	CXSize count,
+	CXSize grainSize,
+	CXSize workerCount,
+	CXParallelRangeFunction function,
+	void *context
+) {
+	if (count == 0 || !function) {
+		return;
+	}
+	if (grainSize == 0) {
+		grainSize = 1;
+	}
+	CXSize blockCount = 1 + ((count - 1) / grainSize);
+	workerCount = CXMIN(CXMIN(workerCount, blockCount), (CXSize)CX_THREAD_POOL_MAX_WORKERS);
+
+#if CX_THREAD_POOL_THREADED
+	CXThreadPoolState *pool = &CXThreadPoolShared;
+	if (workerCount <= 1 || CXThreadPoolInsideLoop || pthread_mutex_trylock(&pool->submitMutex) != 0) {
+		CXThreadPoolRunSerial(count, grainSize, function, context);
+		return;
+	}
+
+	CXThreadPoolJob *job = (CXThreadPoolJob *)malloc(sizeof(CXThreadPoolJob));
+	if (!job) {
+		pthread_mutex_unlock(&pool->submitMutex);
+		CXThreadPoolRunSerial(count, grainSize, function, context);
+		return;
+	}
+
+	pthread_mutex_lock(&pool->mutex);
+	workerCount = CXThreadPoolEnsureThreads(pool, workerCount);
+	if (workerCount <= 1) {
+		pthread_mutex_unlock(&pool->mutex);
+		pthread_mutex_unlock(&pool->submitMutex);
+		free(job);
+		CXThreadPoolRunSerial(count, grainSize, function, context);
+		return;
+	}
+
+	job->function = function;
+	job->context = context;
+	job->count = count;
+	job->grainSize = grainSize;
+	job->workerCount = workerCount;
+	CXSize blocksPerWorker = blockCount / workerCount;
+	CXSize extraBlocks = blockCount % workerCount;
+	CXSize nextBlock = 0;
+	for (CXSize w = 0; w < workerCount; w++) {
+		CXSize span = blocksPerWorker + (w < extraBlocks ? 1 : 0);
+		atomic_init(&job->cursors[w].next, (uint_fast64_t)nextBlock);
+		job->cursors[w].end = (uint64_t)(nextBlock + span);
+		nextBlock += span;
+	}
+	atomic_init(&job->pendingWorkers, (size_t)workerCount);
+
+	pool->job = job;
+	pool->jobWorkerCount = workerCount;
+	pool->generation++;
+	pthread_cond_broadcast(&pool->wakeCondition);
+	pthread_mutex_unlock(&pool->mutex);
+
+	CXThreadPoolInsideLoop = CXTrue;
+	CXThreadPoolRunJob(job, 0);
+	CXThreadPoolInsideLoop = CXFalse;
+	atomic_fetch_sub_explicit(&job->pendingWorkers, 1, memory_order_acq_rel);
+
+	pthread_mutex_lock(&pool->mutex);
+	while (atomic_load_explicit(&job->pendingWorkers, memory_order_acquire) > 0) {
+		pthread_cond_wait(&pool->doneCondition, &pool->mutex);
+	}
+	pool->job = NULL;
+	pool->jobWorkerCount = 0;
+	pthread_mutex_unlock(&pool->mutex);
+	pthread_mutex_unlock(&pool->submitMutex);
+	free(job);
+#else
+	(void)workerCount;
+	CXThreadPoolRunSerial(count, grainSize, function, context);
+#endif
+}
+
+void CXThreadPoolShutdown(void) {
+#if CX_THREAD_POOL_THREADED
+	CXThreadPoolState *pool = &CXThreadPoolShared;
+	if (CXThreadPoolInsideLoop) {
+		return;
+	}
+	pthread_mutex_lock(&pool->submitMutex);
+	pthread_mutex_lock(&pool->mutex);
+	pool->stopping = CXTrue;
+	pthread_cond_broadcast(&pool->wakeCondition);
+	CXSize threadCount = pool->threadCount;
+	pthread_mutex_unlock(&pool->mutex);
+
+	for (CXSize i = 0; i < threadCount; i++) {
+		pthread_join(pool->threads[i], NULL);
+	}
+
+	pthread_mutex_lock(&pool->mutex);
+	pool->threadCount = 0;
+	pool->stopping = CXFalse;
+	pthread_mutex_unlock(&pool->mutex);
+	pthread_mutex_unlock(&pool->submitMutex);
+#endif
+}
@@ -194,6 +194,13 @@ test('can select nodes and edges with query expressions', async () => {
 	const regexNodes = network.selectNodes('label =~ \"^g\"');
 	expect(Array.from(regexNodes)).toEqual([nodes[2]]);
 
+	network.defineNodeAttribute('kind', AttributeType.String, 1);
+	network.setNodeStringAttribute('kind', nodes[0], 'red');
+	network.setNodeStringAttribute('kind', nodes[1], 'dark_red');
+	network.setNodeStringAttribute('kind', nodes[2], 'blue');
+	network.categorizeNodeAttribute('kind');
+	expect(Array.from(network.selectNodes('kind =~ \"red$\"'))).toEqual([nodes[0], nodes[1]]);
+
 	network.defineNodeAttribute('vec2', AttributeType.Float, 2);
 	const dim = 2;
 	withNodeBuffer(network, 'vec2', (vecBuffer) => {
@@ -239,6 +246,73 @@ test('can select nodes and edges with query expressions', async () => {
 	network.dispose();
 });
 
+test('prepared queries re-run against updated attribute values', async () => {
+	const network = await HeliosNetwork.create({ directed: false });
+	try {
+		const nodes = network.addNodes(3);
+		network.defineNodeAttribute('score', AttributeType.Float, 1);
+		withNodeBuffer(network, 'score', ({ view }) => {
+			view[nodes[0]] = 0.5;
+			view[nodes[1]] = 2.0;
+			view[nodes[2]] = 3.5;
+		});
+
+		const query = network.prepareQuery('score > 1.0');
+		expect(Array.from(query.execute())).toEqual([nodes[1], nodes[2]]);
+		withNodeBuffer(network, 'score', ({ view }) => {
+			view[nodes[0]] = 4.0;
+			view[nodes[1]] = 0.0;
+		});
+		expect(Array.from(query.execute())).toEqual([nodes[0], nodes[2]]);
+
+		const edges = network.addEdges([
+			{ from: nodes[0], to: nodes[1] },
+			{ from: nodes[0], to: nodes[2] },
+		]);
+		const edgeQuery = network.prepareQuery('$both.score > 1.0', { scope: 'edge' });
+		expect(Array.from(edgeQuery.execute())).toEqual([edges[1]]);
+
+		query.dispose();
+		edgeQuery.dispose();
+		expect(() => query.execute()).toThrow();
+		expect(() => network.prepareQuery('score >')).toThrow();
+	} finally {
+		network.dispose();
+	}
+});
+
+test('attribute indexes answer selective queries and follow value updates', async () => {
+	const network = await HeliosNetwork.create({ directed: false });
+	try {
+		const nodes = network.addNodes(4);
+		network.defineNodeAttribute('score', AttributeType.Float, 1);
+		withNodeBuffer(network, 'score', ({ view, bumpVersion }) => {
+			view[nodes[0]] = 0.5;
+			view[nodes[1]] = 2.0;
+			view[nodes[2]] = 3.5;
+			view[nodes[3]] = 2.0;
+			bumpVersion();
+		});
+
+		expect(network.hasAttributeIndex('node', 'score')).toBe(false);
+		network.createAttributeIndex('node', 'score');
+		expect(network.hasAttributeIndex('node', 'score')).toBe(true);
+		expect(Array.from(network.selectNodes('score == 2.0'))).toEqual([nodes[1], nodes[3]]);
+
+		withNodeBuffer(network, 'score', ({ view, bumpVersion }) => {
+			view[nodes[0]] = 2.0;
+			bumpVersion();
+		});
+		expect(Array.from(network.selectNodes('score == 2.0'))).toEqual([nodes[0], nodes[1], nodes[3]]);
+
+		expect(network.dropAttributeIndex('node', 'score')).toBe(true);
+		expect(network.dropAttributeIndex('node', 'score')).toBe(false);
+		expect(() => network.createAttributeIndex('network', 'score')).toThrow();
+	} finally {
+		network.dispose();
+	}
+});
+
 test('can build filtered subgraphs with induced-edge semantics and optional ordering', async () => {
 	const network = await HeliosNetwork.create({ directed: false });
 	try {
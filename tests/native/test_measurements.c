@@ -200,6 +200,100 @@ static void test_clustering_variants(void) {
 	CXFreeNetwork(path);
 }
 
+static void test_triangles_and_transitivity(void) {
+	/* Diamond 0-1-2-3 with chord 1-2 and a pendant node 4. The directed copy adds
+	 * a reciprocal edge, a parallel edge, and a self-loop, none of which change
+	 * the undirected projection. */
+	const CXEdge diamondEdges[] = {
+		{ .from = 0, .to = 1 },
+		{ .from = 0, .to = 2 },
+		{ .from = 1, .to = 2 },
+		{ .from = 1, .to = 3 },
+		{ .from = 2, .to = 3 },
+		{ .from = 3, .to = 4 },
+		{ .from = 2, .to = 1 },
+		{ .from = 0, .to = 1 },
+		{ .from = 4, .to = 4 }
+	};
+	const double expectedNodeTriangles[] = {1.0, 2.0, 2.0, 1.0, 0.0};
+	for (int directed = 0; directed <= 1; directed++) {
+		CXSize edgeCount = directed ? 9 : 6;
+		CXIndex nodeIndices[5] = {0};
+		CXNetworkRef network = build_network(directed ? CXTrue : CXFalse, 5, diamondEdges, edgeCount, NULL, NULL, nodeIndices, NULL);
+		CXSize capacity = CXNetworkNodeCapacity(network);
+		float *nodeTriangles = (float *)calloc(capacity, sizeof(float));
+		assert(nodeTriangles);
+		uint64_t total = 0;
+		double transitivity = 0.0;
+		assert(CXNetworkMeasureTriangles(network, CXMeasurementExecutionParallel, nodeTriangles, &total, &transitivity) == CXTrue);
+		assert(total == 2);
+		assert_near(transitivity, 0.6, 1e-12);
+		for (CXSize i = 0; i < 5; i++) {
+			assert_near(nodeTriangles[nodeIndices[i]], expectedNodeTriangles[i], 1e-6);
+		}
+		total = 0;
+		transitivity = 0.0;
+		assert(CXNetworkMeasureTriangles(network, CXMeasurementExecutionSingleThread, NULL, &total, &transitivity) == CXTrue);
+		assert(total == 2);
+		assert_near(transitivity, 0.6, 1e-12);
+		free(nodeTriangles);
+		CXFreeNetwork(network);
+	}
+
+	/* Pseudo-random graph with a hub (exercises galloping) checked against an
+	 * adjacency-matrix count. */
+	enum { nodeCount = 96, edgeCount = 900 };
+	CXEdge *edges = (CXEdge *)malloc(edgeCount * sizeof(CXEdge));
+	unsigned char *adjacency = (unsigned char *)calloc(nodeCount * nodeCount, 1);
+	assert(edges);
+	assert(adjacency);
+	uint32_t state = 12345u;
+	for (CXSize i = 0; i < edgeCount; i++) {
+		state = state * 1664525u + 1013904223u;
+		CXIndex from = (i % 3 == 0) ? 0 : (CXIndex)((state >> 8) % nodeCount);
+		state = state * 1664525u + 1013904223u;
+		CXIndex to = (CXIndex)((state >> 8) % nodeCount);
+		edges[i].from = from;
+		edges[i].to = to;
+		if (from != to) {
+			adjacency[from * nodeCount + to] = 1;
+			adjacency[to * nodeCount + from] = 1;
+		}
+	}
+	uint64_t expectedTotal = 0;
+	double expectedTriples = 0.0;
+	for (CXIndex a = 0; a < nodeCount; a++) {
+		double degree = 0.0;
+		for (CXIndex b = 0; b < nodeCount; b++) {
+			degree += adjacency[a * nodeCount + b];
+			if (b <= a || !adjacency[a * nodeCount + b]) {
+				continue;
+			}
+			for (CXIndex c = b + 1; c < nodeCount; c++) {
+				if (adjacency[a * nodeCount + c] && adjacency[b * nodeCount + c]) {
+					expectedTotal++;
+				}
+			}
+		}
+		expectedTriples += 0.5 * degree * (degree - 1.0);
+	}
+	CXNetworkRef network = build_network(CXTrue, nodeCount, edges, edgeCount, NULL, NULL, NULL, NULL);
+	uint64_t forwardTotal = 0;
+	uint64_t localTotal = 0;
+	double transitivity = 0.0;
+	float *nodeTriangles = (float *)calloc(CXNetworkNodeCapacity(network), sizeof(float));
+	assert(nodeTriangles);
+	assert(CXNetworkMeasureTriangles(network, CXMeasurementExecutionParallel, NULL, &forwardTotal, &transitivity) == CXTrue);
+	assert(CXNetworkMeasureTriangles(network, CXMeasurementExecutionParallel, nodeTriangles, &localTotal, NULL) == CXTrue);
+	assert(forwardTotal == expectedTotal);
+	assert(localTotal == expectedTotal);
+	assert_near(transitivity, 3.0 * (double)expectedTotal / expectedTriples, 1e-12);
+	free(nodeTriangles);
+	CXFreeNetwork(network);
+	free(adjacency);
+	free(edges);
+}
+
 static void test_eigenvector_centrality_modes(void) {
 	const CXEdge edges[] = {
 		{ .from = 0, .to = 1 },
@@ -579,12 +673,347 @@ static void test_coreness_measurement_and_session(void) {
 	CXFreeNetwork(network);
 }
 
+typedef struct {
+	uint32_t *visits;
+	CXSize workerLimit;
+	CXSize nestedBlocks;
+} ThreadPoolProbe;
+
+static void thread_pool_count_nested(void *context, CXIndex start, CXIndex end, CXSize workerIndex) {
+	(void)start;
+	(void)end;
+	assert(workerIndex == 0);
+	(*(CXSize *)context)++;
+}
+
+static void thread_pool_visit(void *context, CXIndex start, CXIndex end, CXSize workerIndex) {
+	ThreadPoolProbe *probe = (ThreadPoolProbe *)context;
+	assert(workerIndex < probe->workerLimit);
+	assert(start % 7 == 0);
+	for (CXIndex i = start; i < end; i++) {
+		probe->visits[i]++;
+	}
+	if (start == 0) {
+		CXSize nested = 0;
+		CXParallelForRange(10, 1, 4, thread_pool_count_nested, &nested);
+		probe->nestedBlocks = nested;
+	}
+}
+
+static void test_thread_pool_and_parallel_measurements(void) {
+	CXThreadPoolSetWorkerCount(4);
+	assert(CXThreadPoolGetWorkerCount() >= 1);
+	assert(CXThreadPoolGetWorkerCount() <= 4);
+	assert(CXParallelWorkerCount(0) == 0);
+	assert(CXParallelWorkerCount(1) == 1);
+
+	const CXSize count = 1000;
+	ThreadPoolProbe probe = {
+		.visits = (uint32_t *)calloc(count, sizeof(uint32_t)),
+		.workerLimit = CXParallelWorkerCount(count),
+		.nestedBlocks = 0
+	};
+	assert(probe.visits);
+	for (int round = 0; round < 3; round++) {
+		CXParallelForRange(count, 7, probe.workerLimit, thread_pool_visit, &probe);
+	}
+	for (CXSize i = 0; i < count; i++) {
+		assert(probe.visits[i] == 3);
+	}
+	assert(probe.nestedBlocks == 10);
+	free(probe.visits);
+
+	CXNetworkRef ring = CXNetworkGenerateWattsStrogatz(600, 2, 0.0, CXFalse, 7);
+	assert(ring);
+	CXSize capacity = CXNetworkNodeCapacity(ring);
+	float *single = (float *)calloc(capacity, sizeof(float));
+	float *parallel = (float *)calloc(capacity, sizeof(float));
+	assert(single && parallel);
+
+	assert(CXNetworkMeasureBetweennessCentrality(ring, NULL, CXMeasurementExecutionSingleThread, NULL, 0, CXTrue, CXFalse, single) == 600);
+	assert(CXNetworkMeasureBetweennessCentrality(ring, NULL, CXMeasurementExecutionParallel, NULL, 0, CXTrue, CXFalse, parallel) == 600);
+	for (CXSize i = 0; i < capacity; i++) {
+		assert_near(parallel[i], single[i], 1e-6);
+	}
+
+	float singleDimension[5] = {0};
+	float parallelDimension[5] = {0};
+	CXThreadPoolSetWorkerCount(1);
+	assert(CXThreadPoolGetWorkerCount() == 1);
+	assert(CXNetworkMeasureDimension(ring, NULL, 0, 4, CXDimensionLeastSquaresDifferenceMethod, 2, NULL, singleDimension, NULL, NULL) == 600);
+	CXThreadPoolSetWorkerCount(4);
+	assert(CXNetworkMeasureDimension(ring, NULL, 0, 4, CXDimensionLeastSquaresDifferenceMethod, 2, NULL, parallelDimension, NULL, NULL) == 600);
+	for (CXSize r = 0; r <= 4; r++) {
+		assert_near(parallelDimension[r], singleDimension[r], 1e-6);
+	}
+
+	free(single);
+	free(parallel);
+	CXFreeNetwork(ring);
+	CXThreadPoolSetWorkerCount(0);
+	CXThreadPoolShutdown();
+}
+
+static void test_snapshot_cache_and_invalidation(void) {
+	const CXEdge edges[] = {
+		{ .from = 0, .to = 1 },
+		{ .from = 1, .to = 2 },
+		{ .from = 2, .to = 0 }
+	};
+	const float weights[] = { 1.0f, 2.0f, 3.0f };
+	CXIndex nodeIndices[4] = {0};
+	CXIndex edgeIndices[3] = {0};
+	CXNetworkRef network = build_network(CXTrue, 4, edges, 3, weights, "w", nodeIndices, edgeIndices);
+	assert(network);
+
+	CXNetworkSnapshotRef first = CXNetworkSnapshotAcquire(network);
+	CXNetworkSnapshotRef second = CXNetworkSnapshotAcquire(network);
+	assert(first && first == second);
+	assert(first->nodeCount == 4);
+	assert(first->outEdgeCount == 3);
+	assert(first->inEdgeCount == 3);
+	CXNetworkSnapshotRelease(second);
+
+	CXNetworkSnapshotWeightsRef column = CXNetworkSnapshotAcquireWeights(first, network, "w");
+	assert(column);
+	assert(CXNetworkSnapshotAcquireWeights(first, network, "missing") == NULL);
+	CXNetworkSnapshotWeightsRef unit = CXNetworkSnapshotAcquireWeights(first, network, NULL);
+	assert(unit && unit != column);
+	CXIndex u1 = first->nodeToCompact[nodeIndices[1]];
+	assert(first->outOffsets[u1 + 1] - first->outOffsets[u1] == 1);
+	assert_near(column->outWeights[first->outOffsets[u1]], 2.0, 1e-12);
+	assert_near(unit->outWeights[first->outOffsets[u1]], 1.0, 1e-12);
+	CXNetworkSnapshotWeightsRelease(unit);
+
+	CXNetworkSnapshotWeightsRef same = CXNetworkSnapshotAcquireWeights(first, network, "w");
+	assert(same == column);
+	CXNetworkSnapshotWeightsRelease(same);
+
+	float *buffer = (float *)CXNetworkGetEdgeAttributeBuffer(network, "w");
+	buffer[edgeIndices[1]] = 5.0f;
+	CXNetworkBumpEdgeAttributeVersion(network, "w");
+	CXNetworkSnapshotWeightsRef refreshed = CXNetworkSnapshotAcquireWeights(first, network, "w");
+	assert(refreshed && refreshed != column);
+	assert_near(refreshed->outWeights[first->outOffsets[u1]], 5.0, 1e-12);
+	assert_near(column->outWeights[first->outOffsets[u1]], 2.0, 1e-12);
+	CXNetworkSnapshotWeightsRelease(refreshed);
+	CXNetworkSnapshotWeightsRelease(column);
+
+	CXConnectedComponentsSessionRef session = CXConnectedComponentsSessionCreate(network, CXConnectedComponentsWeak);
+	assert(session);
+
+	CXEdge extra = { .from = nodeIndices[2], .to = nodeIndices[3] };
+	assert(CXNetworkAddEdges(network, &extra, 1, NULL) == CXTrue);
+	CXNetworkSnapshotRef rebuilt = CXNetworkSnapshotAcquire(network);
+	assert(rebuilt && rebuilt != first);
+	assert(rebuilt->outEdgeCount == 4);
+	assert(first->outEdgeCount == 3);
+	assert(CXNetworkSnapshotAcquireWeights(first, network, "w") == NULL);
+	CXNetworkSnapshotRelease(rebuilt);
+	CXNetworkSnapshotRelease(first);
+
+	/* The session keeps measuring the topology it was created from. */
+	CXSize guard = 0;
+	while (CXConnectedComponentsSessionStep(session, 1) != CXConnectedComponentsPhaseDone) {
+		guard += 1;
+		assert(guard < 1000);
+	}
+	CXSize capacity = CXNetworkNodeCapacity(network);
+	uint32_t *components = (uint32_t *)calloc(capacity, sizeof(uint32_t));
+	assert(components);
+	uint32_t componentCount = 0;
+	assert(CXConnectedComponentsSessionFinalize(session, components, capacity, &componentCount, NULL) == CXTrue);
+	assert(componentCount == 2);
+	CXConnectedComponentsSessionDestroy(session);
+
+	assert(CXNetworkMeasureConnectedComponents(network, CXConnectedComponentsWeak, components, NULL) == 1);
+	free(components);
+	CXFreeNetwork(network);
+}
+
+typedef struct {
+	uint32_t *levels; /* CX_TRAVERSAL_BATCH_SIZE rows of nodeCount */
+	CXSize nodeCount;
+} traversal_batch_levels;
+
+static void record_batch_level(void *context, CXIndex node, CXSize level, uint64_t sourceMask) {
+	traversal_batch_levels *levels = (traversal_batch_levels *)context;
+	for (CXSize bit = 0; bit < CX_TRAVERSAL_BATCH_SIZE; bit++) {
+		if (sourceMask & (UINT64_C(1) << bit)) {
+			assert(levels->levels[bit * levels->nodeCount + node] == CX_TRAVERSAL_UNVISITED);
+			levels->levels[bit * levels->nodeCount + node] = (uint32_t)level;
+		}
+	}
+}
+
+static void test_direction_optimizing_traversal(void) {
+	/* Dense random digraph: the frontier quickly owns most edges, so the
+	 * traversal has to switch to bottom-up steps. */
+	enum { nodeCount = 400, edgeCount = 6000 };
+	CXEdge *edges = (CXEdge *)malloc(edgeCount * sizeof(CXEdge));
+	assert(edges);
+	uint32_t state = 99u;
+	for (CXSize i = 0; i < edgeCount; i++) {
+		state = state * 1664525u + 1013904223u;
+		edges[i].from = (CXIndex)((state >> 8) % nodeCount);
+		state = state * 1664525u + 1013904223u;
+		edges[i].to = (CXIndex)((state >> 8) % nodeCount);
+	}
+	CXNetworkRef network = build_network(CXTrue, nodeCount, edges, edgeCount, NULL, NULL, NULL, NULL);
+	CXNetworkSnapshotRef snapshot = CXNetworkSnapshotAcquire(network);
+	assert(snapshot);
+	CXSize n = snapshot->nodeCount;
+
+	uint32_t *expected = (uint32_t *)malloc(n * sizeof(uint32_t));
+	CXIndex *queue = (CXIndex *)malloc(n * sizeof(CXIndex));
+	assert(expected);
+	assert(queue);
+
+	CXTraversalBFS bfs;
+	assert(CXTraversalBFSInit(&bfs, snapshot, CXTrue, CXFalse, 4) == CXTrue);
+	for (CXIndex source = 0; source < 8; source++) {
+		for (CXSize u = 0; u < n; u++) {
+			expected[u] = CX_TRAVERSAL_UNVISITED;
+		}
+		CXSize head = 0;
+		CXSize tail = 0;
+		expected[source] = 0;
+		queue[tail++] = source;
+		while (head < tail) {
+			CXIndex u = queue[head++];
+			for (CXIndex idx = snapshot->outOffsets[u]; idx < snapshot->outOffsets[u + 1]; idx++) {
+				CXIndex w = snapshot->outNeighbors[idx];
+				if (expected[w] == CX_TRAVERSAL_UNVISITED) {
+					expected[w] = expected[u] + 1;
+					queue[tail++] = w;
+				}
+			}
+		}
+
+		assert(CXTraversalBFSRun(&bfs, &source, 1, CXSizeMAX) == tail);
+		for (CXSize u = 0; u < n; u++) {
+			assert(bfs.distances[u] == expected[u]);
+		}
+		for (CXSize r = 0; r < bfs.levelCount; r++) {
+			for (CXIndex i = bfs.levelOffsets[r]; i < bfs.levelOffsets[r + 1]; i++) {
+				assert(bfs.distances[bfs.order[i]] == r);
+			}
+		}
+
+		CXSize withinOne = 0;
+		for (CXSize u = 0; u < n; u++) {
+			withinOne += expected[u] <= 1 ? 1 : 0;
+		}
+		assert(CXTraversalBFSRun(&bfs, &source, 1, 1) == withinOne);
+		for (CXSize u = 0; u < n; u++) {
+			assert(bfs.distances[u] == (expected[u] <= 1 ? expected[u] : CX_TRAVERSAL_UNVISITED));
+		}
+	}
+	assert(bfs.bottomUpSteps > 0);
+	assert(bfs.topDownSteps > 0);
+
+	/* The bit-parallel variant must reproduce every per-source distance. */
+	CXTraversalMultiBFS multi;
+	assert(CXTraversalMultiBFSInit(&multi, snapshot, CXTrue, CXFalse) == CXTrue);
+	CXIndex sources[CX_TRAVERSAL_BATCH_SIZE];
+	for (CXSize i = 0; i < CX_TRAVERSAL_BATCH_SIZE; i++) {
+		sources[i] = (CXIndex)((i * 37u) % n);
+	}
+	traversal_batch_levels levels = {
+		.levels = (uint32_t *)malloc(CX_TRAVERSAL_BATCH_SIZE * n * sizeof(uint32_t)),
+		.nodeCount = n
+	};
+	assert(levels.levels);
+	for (CXSize maxLevel = 2; maxLevel <= 64; maxLevel += 62) {
+		for (CXSize i = 0; i < CX_TRAVERSAL_BATCH_SIZE * n; i++) {
+			levels.levels[i] = CX_TRAVERSAL_UNVISITED;
+		}
+		assert(CXTraversalMultiBFSRun(&multi, sources, CX_TRAVERSAL_BATCH_SIZE, maxLevel, record_batch_level, &levels) == CXTrue);
+		for (CXSize i = 0; i < CX_TRAVERSAL_BATCH_SIZE; i++) {
+			CXTraversalBFSRun(&bfs, &sources[i], 1, maxLevel);
+			for (CXSize u = 0; u < n; u++) {
+				assert(levels.levels[i * n + u] == bfs.distances[u]);
+			}
+		}
+	}
+
+	free(levels.levels);
+	CXTraversalMultiBFSDestroy(&multi);
+	CXTraversalBFSDestroy(&bfs);
+	free(queue);
+	free(expected);
+	CXNetworkSnapshotRelease(snapshot);
+	CXFreeNetwork(network);
+	free(edges);
+}
+
+static void test_parallel_leiden_determinism(void) {
+	const CXSize blockSizes[6] = {200, 200, 200, 200, 200, 200};
+	double probabilities[36];
+	for (CXSize i = 0; i < 36; i++) {
+		probabilities[i] = (i / 6 == i % 6) ? 0.1 : 0.002;
+	}
+	for (int directed = 0; directed <= 1; directed++) {
+		CXNetworkRef network = CXNetworkGenerateStochasticBlockModel(6, blockSizes, probabilities, directed ? CXTrue : CXFalse, 11);
+		assert(network);
+		CXSize capacity = CXNetworkNodeCapacity(network);
+		uint32_t *oneWorker = (uint32_t *)malloc(capacity * sizeof(uint32_t));
+		assert(oneWorker);
+
+		double sequentialModularity = 0.0;
+		assert(CXNetworkLeidenModularity(network, NULL, 1.0, 5, 32, 8, CXMeasurementExecutionSingleThread, "leiden", &sequentialModularity) > 0);
+
+		double oneWorkerModularity = 0.0;
+		CXThreadPoolSetWorkerCount(1);
+		assert(CXNetworkLeidenModularity(network, NULL, 1.0, 5, 32, 8, CXMeasurementExecutionParallel, "leiden", &oneWorkerModularity) == 6);
+		memcpy(oneWorker, CXNetworkGetNodeAttributeBuffer(network, "leiden"), capacity * sizeof(uint32_t));
+
+		double fourWorkerModularity = 0.0;
+		CXThreadPoolSetWorkerCount(4);
+		assert(CXNetworkLeidenModularity(network, NULL, 1.0, 5, 32, 8, CXMeasurementExecutionParallel, "leiden", &fourWorkerModularity) == 6);
+		const uint32_t *fourWorker = (const uint32_t *)CXNetworkGetNodeAttributeBuffer(network, "leiden");
+		assert(memcmp(oneWorker, fourWorker, capacity * sizeof(uint32_t)) == 0);
+		assert(oneWorkerModularity == fourWorkerModularity);
+		assert(fourWorkerModularity > sequentialModularity - 0.02);
+		/* The generator lays blocks out contiguously; each must be one community. */
+		for (CXSize u = 0; u < 1200; u++) {
+			assert(fourWorker[u] == fourWorker[(u / 200) * 200]);
+		}
+
+		/* Stepping with a small budget walks the same batches. */
+		CXLeidenSessionRef session = CXLeidenSessionCreate(network, NULL, 1.0, 5, 32, 8, CXMeasurementExecutionParallel);
+		assert(session);
+		CXLeidenPhase phase = CXLeidenPhaseBuildGraph;
+		while (phase != CXLeidenPhaseDone && phase != CXLeidenPhaseFailed) {
+			phase = CXLeidenSessionStep(session, 100);
+		}
+		assert(phase == CXLeidenPhaseDone);
+		double sessionModularity = 0.0;
+		uint32_t sessionCommunities = 0;
+		assert(CXLeidenSessionFinalize(session, "leiden_session", &sessionModularity, &sessionCommunities) == CXTrue);
+		CXLeidenSessionDestroy(session);
+		assert(sessionCommunities == 6);
+		assert(sessionModularity == fourWorkerModularity);
+		assert(memcmp(oneWorker, CXNetworkGetNodeAttributeBuffer(network, "leiden_session"), capacity * sizeof(uint32_t)) == 0);
+
+		free(oneWorker);
+		CXFreeNetwork(network);
+	}
+	CXThreadPoolSetWorkerCount(0);
+	CXThreadPoolShutdown();
+}
+
 int main(void) {
 	test_degree_and_strength();
 	test_clustering_variants();
+	test_triangles_and_transitivity();
 	test_eigenvector_centrality_modes();
 	test_betweenness_centrality_modes_and_chunks();
 	test_connected_components_measurement_and_session();
 	test_coreness_measurement_and_session();
+	test_thread_pool_and_parallel_measurements();
+	test_snapshot_cache_and_invalidation();
+	test_direction_optimizing_traversal();
+	test_parallel_leiden_determinism();
 	return 0;
 }
@@ -1,6 +1,7 @@
 #include <assert.h>
 #include <fcntl.h>
 #include <math.h>
+#include <regex.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -12,6 +13,8 @@
 #include "CXNetworkGT.h"
 #include "CXNetworkNodeLinkJSON.h"
 #include "CXNetworkXNet.h"
+#include "CXTextWriter.h"
+#include "htslib/bgzf.h"
 
 static void free_attribute_strings(CXAttributeRef attr, CXSize count) {
 	if (!attr || !attr->data || attr->type != CXStringAttributeType) {
@@ -234,6 +237,374 @@ static void test_neighbor_collection(void) {
 	CXFreeNetwork(net);
 }
 
+static void test_bulk_edge_insert(void) {
+	CXThreadPoolSetWorkerCount(4);
+	CXNetworkRef net = CXNewNetwork(CXFalse);
+	assert(net);
+	const CXSize nodeCount = 2000;
+	const CXSize edgeCount = 20000;
+	CXIndex *nodes = calloc(nodeCount, sizeof(CXIndex));
+	CXEdge *edges = calloc(edgeCount, sizeof(CXEdge));
+	CXIndex *edgeIds = calloc(edgeCount, sizeof(CXIndex));
+	CXSize *degree = calloc(nodeCount, sizeof(CXSize));
+	assert(nodes && edges && edgeIds && degree);
+	assert(CXNetworkAddNodes(net, nodeCount, nodes));
+	assert(CXNetworkDefineEdgeAttribute(net, "weight", CXFloatAttributeType, 1));
+	assert(CXNetworkDefineMultiCategoryAttribute(net, CXAttributeScopeEdge, "tags", CXFalse));
+
+	srand(11);
+	for (CXSize i = 0; i < edgeCount; i++) {
+		CXSize from = (CXSize)rand() % nodeCount;
+		CXSize to = i % 97 == 0 ? from : (CXSize)rand() % nodeCount;
+		edges[i].from = nodes[from];
+		edges[i].to = nodes[to];
+		degree[from]++;
+		degree[to]++;
+	}
+	assert(CXNetworkAddEdges(net, edges, edgeCount, edgeIds));
+	assert(CXNetworkEdgeCount(net) == edgeCount);
+	for (CXSize i = 0; i < edgeCount; i++) {
+		assert(edgeIds[i] == i);
+	}
+	for (CXSize n = 0; n < nodeCount; n++) {
+		CXNeighborContainer *out = CXNetworkOutNeighbors(net, nodes[n]);
+		CXNeighborContainer *in = CXNetworkInNeighbors(net, nodes[n]);
+		assert(CXNeighborContainerCount(out) == degree[n]);
+		assert(CXNeighborContainerCount(in) == degree[n]);
+	}
+	// Neighbour lists keep the batch order.
+	CXNeighborContainer *out0 = CXNetworkOutNeighbors(net, edges[0].from);
+	assert(out0->storageType == CXNeighborListType);
+	assert(out0->storage.list.edges[0] == edgeIds[0]);
+	assert(out0->storage.list.capacity == out0->storage.list.count);
+
+	float *weights = (float *)CXNetworkGetEdgeAttributeBuffer(net, "weight");
+	for (CXSize i = 0; i < edgeCount; i++) {
+		weights[i] = 1.0f;
+	}
+	const char *tags[] = { "a", "b" };
+	for (CXSize i = 0; i < 100; i++) {
+		assert(CXNetworkSetMultiCategoryEntryByLabels(net, CXAttributeScopeEdge, "tags", edgeIds[i], tags, 2, NULL));
+	}
+	CXIndex removed[50];
+	for (CXSize i = 0; i < 50; i++) {
+		removed[i] = edgeIds[i * 2];
+	}
+	assert(CXNetworkRemoveEdges(net, removed, 50));
+
+	// A batch with an inactive endpoint leaves the network untouched.
+	CXIndex dropped = nodes[nodeCount - 1];
+	assert(CXNetworkRemoveNodes(net, &dropped, 1));
+	CXSize edgesBefore = CXNetworkEdgeCount(net);
+	CXEdge invalid[2] = {
+		{ .from = nodes[0], .to = nodes[1] },
+		{ .from = nodes[0], .to = dropped },
+	};
+	assert(!CXNetworkAddEdges(net, invalid, 2, NULL));
+	assert(CXNetworkEdgeCount(net) == edgesBefore);
+
+	// Recycled indices are reused before the fresh range; every slot is cleared.
+	const CXSize extraCount = 300;
+	CXEdge extra[300];
+	CXIndex extraIds[300];
+	for (CXSize i = 0; i < extraCount; i++) {
+		extra[i].from = nodes[i % 10];
+		extra[i].to = nodes[(i * 7) % 10];
+	}
+	const CXSize highWater = edgeCount;
+	assert(CXNetworkAddEdges(net, extra, extraCount, extraIds));
+	assert(CXNetworkEdgeCount(net) == edgesBefore + extraCount);
+	weights = (float *)CXNetworkGetEdgeAttributeBuffer(net, "weight");
+	CXSize recycledSeen = 0;
+	for (CXSize i = 0; i < extraCount; i++) {
+		assert(CXNetworkIsEdgeActive(net, extraIds[i]));
+		assert(weights[extraIds[i]] == 0.0f);
+		CXSize tagStart = 0;
+		CXSize tagEnd = 0;
+		assert(CXNetworkGetMultiCategoryEntryRange(net, CXAttributeScopeEdge, "tags", extraIds[i], &tagStart, &tagEnd));
+		assert(tagStart == tagEnd);
+		if (extraIds[i] < highWater) {
+			recycledSeen++;
+		} else {
+			assert(extraIds[i] == highWater + (i - recycledSeen));
+		}
+	}
+	assert(recycledSeen > 0);
+
+	free(nodes);
+	free(edges);
+	free(edgeIds);
+	free(degree);
+	CXFreeNetwork(net);
+	CXThreadPoolSetWorkerCount(0);
+}
+
+static void check_adjacency_matches_edges(CXNetworkRef net) {
+	CXSize *outDegree = calloc(CXNetworkNodeCapacity(net), sizeof(CXSize));
+	CXSize *inDegree = calloc(CXNetworkNodeCapacity(net), sizeof(CXSize));
+	assert(outDegree && inDegree);
+	for (CXIndex e = 0; e < CXNetworkEdgeCapacity(net); e++) {
+		if (!CXNetworkIsEdgeActive(net, e)) {
+			continue;
+		}
+		CXEdge edge = net->edges[e];
+		outDegree[edge.from]++;
+		inDegree[edge.to]++;
+		if (!CXNetworkIsDirected(net)) {
+			inDegree[edge.from]++;
+			outDegree[edge.to]++;
+		}
+	}
+	for (CXIndex node = 0; node < CXNetworkNodeCapacity(net); node++) {
+		if (!CXNetworkIsNodeActive(net, node)) {
+			continue;
+		}
+		for (int direction = 0; direction < 2; direction++) {
+			CXNeighborContainer *container = direction ? CXNetworkInNeighbors(net, node) : CXNetworkOutNeighbors(net, node);
+			assert(CXNeighborContainerCount(container) == (direction ? inDegree[node] : outDegree[node]));
+			CXNeighborFOR(neighbor, edgeIndex, container) {
+				assert(CXNetworkIsEdgeActive(net, edgeIndex));
+				CXEdge edge = net->edges[edgeIndex];
+				if (CXNetworkIsDirected(net)) {
+					assert(direction ? (edge.to == node && edge.from == neighbor) : (edge.from == node && edge.to == neighbor));
+				} else {
+					assert((edge.from == node && edge.to == neighbor) || (edge.to == node && edge.from == neighbor));
+				}
+			}
+		}
+	}
+	free(outDegree);
+	free(inDegree);
+}
+
+static void test_fast_edge_removal(void) {
+	for (int directed = 0; directed < 2; directed++) {
+		CXNetworkRef net = CXNewNetwork(directed ? CXTrue : CXFalse);
+		assert(net);
+		assert(!CXNetworkHasFastEdgeRemoval(net));
+		assert(CXNetworkSetFastEdgeRemoval(net, CXTrue));
+		assert(CXNetworkHasFastEdgeRemoval(net));
+
+		const CXSize nodeCount = 200;
+		const CXSize edgeCount = 4000;
+		CXIndex nodes[200];
+		assert(CXNetworkAddNodes(net, nodeCount, nodes));
+		CXEdge *edges = calloc(edgeCount, sizeof(CXEdge));
+		CXIndex *edgeIds = calloc(edgeCount, sizeof(CXIndex));
+		assert(edges && edgeIds);
+		srand(23 + directed);
+		for (CXSize i = 0; i < edgeCount; i++) {
+			// Node 0 is a hub; every 50th edge is a self-loop.
+			edges[i].from = nodes[i % 3 == 0 ? 0 : (CXSize)rand() % nodeCount];
+			edges[i].to = i % 50 == 0 ? edges[i].from : nodes[(CXSize)rand() % nodeCount];
+		}
+		assert(CXNetworkAddEdges(net, edges, edgeCount, edgeIds));
+
+		// The first removal builds the slot table; later inserts keep it current.
+		CXIndex removed[1000];
+		for (CXSize i = 0; i < 1000; i++) {
+			removed[i] = edgeIds[(i * 7) % edgeCount];
+		}
+		assert(CXNetworkRemoveEdges(net, removed, 1000));
+		assert(net->edgeSlots);
+		check_adjacency_matches_edges(net);
+
+		assert(CXNetworkAddEdges(net, edges, 500, NULL));
+		assert(net->edgeSlots);
+		for (CXSize i = 0; i < 1000; i++) {
+			removed[i] = edgeIds[(i * 13 + 5) % edgeCount];
+		}
+		CXNetworkRemoveEdges(net, removed, 1000);
+		check_adjacency_matches_edges(net);
+
+		CXIndex hub = nodes[0];
+		assert(CXNetworkRemoveNodes(net, &hub, 1));
+		assert(net->edgeSlots);
+		check_adjacency_matches_edges(net);
+
+		// Freezing keeps list order, so the table stays valid across a thaw.
+		assert(CXNetworkFreeze(net));
+		for (CXSize i = 0; i < 200; i++) {
+			removed[i] = (CXIndex)(i * 11);
+		}
+		CXNetworkRemoveEdges(net, removed, 200);
+		assert(net->edgeSlots);
+		check_adjacency_matches_edges(net);
+
+		assert(CXNetworkSetFastEdgeRemoval(net, CXFalse));
+		assert(!net->edgeSlots);
+		free(edges);
+		free(edgeIds);
+		CXFreeNetwork(net);
+	}
+}
+
+static void test_batch_node_removal(void) {
+	for (int directed = 0; directed < 2; directed++) {
+		CXNetworkRef net = CXNewNetwork(directed ? CXTrue : CXFalse);
+		assert(net);
+		const CXSize nodeCount = 1000;
+		const CXSize edgeCount = 8000;
+		CXIndex *nodes = calloc(nodeCount, sizeof(CXIndex));
+		CXEdge *edges = calloc(edgeCount, sizeof(CXEdge));
+		CXIndex *edgeIds = calloc(edgeCount, sizeof(CXIndex));
+		assert(nodes && edges && edgeIds);
+		assert(CXNetworkAddNodes(net, nodeCount, nodes));
+		srand(41 + directed);
+		for (CXSize i = 0; i < edgeCount; i++) {
+			edges[i].from = nodes[(CXSize)rand() % nodeCount];
+			edges[i].to = i % 100 == 0 ? edges[i].from : nodes[(CXSize)rand() % nodeCount];
+		}
+		assert(CXNetworkAddEdges(net, edges, edgeCount, edgeIds));
+
+		assert(CXNetworkDefineEdgeAttribute(net, "weight", CXFloatAttributeType, 1));
+		assert(CXNetworkDefineMultiCategoryAttribute(net, CXAttributeScopeEdge, "tags", CXFalse));
+		assert(CXNetworkDefineMultiCategoryAttribute(net, CXAttributeScopeNode, "groups", CXFalse));
+		float *weight = (float *)CXNetworkGetEdgeAttributeBuffer(net, "weight");
+		for (CXSize i = 0; i < edgeCount; i++) {
+			weight[edgeIds[i]] = (float)edgeIds[i];
+			uint32_t tags[2] = { (uint32_t)(edgeIds[i] % 7), (uint32_t)(edgeIds[i] % 7 + 7) };
+			assert(CXNetworkSetMultiCategoryEntry(net, CXAttributeScopeEdge, "tags", edgeIds[i], tags, i % 2 ? 2 : 1, NULL));
+		}
+		for (CXSize i = 0; i < nodeCount; i++) {
+			uint32_t group = (uint32_t)nodes[i];
+			assert(CXNetworkSetMultiCategoryEntry(net, CXAttributeScopeNode, "groups", nodes[i], &group, 1, NULL));
+		}
+
+		// Every third node, listed twice, plus ids that are out of range.
+		CXSize removedCount = 0;
+		CXIndex *removed = calloc(nodeCount, sizeof(CXIndex));
+		assert(removed);
+		for (CXSize i = 0; i < nodeCount; i += 3) {
+			removed[removedCount++] = nodes[i];
+		}
+		CXSize uniqueRemoved = removedCount;
+		removed[removedCount++] = nodes[0];
+		removed[removedCount++] = (CXIndex)(CXNetworkNodeCapacity(net) + 5);
+		CXSize expectedEdges = 0;
+		for (CXSize i = 0; i < edgeCount; i++) {
+			if (edges[i].from % 3 != 0 && edges[i].to % 3 != 0) {
+				expectedEdges++;
+			}
+		}
+
+		uint64_t nodeVersion = CXNetworkNodeTopologyVersion(net);
+		uint64_t edgeVersion = CXNetworkEdgeTopologyVersion(net);
+		assert(CXNetworkRemoveNodes(net, removed, removedCount));
+		assert(CXNetworkNodeTopologyVersion(net) == nodeVersion + 1);
+		assert(CXNetworkEdgeTopologyVersion(net) == edgeVersion + 1);
+		assert(CXNetworkNodeCount(net) == nodeCount - uniqueRemoved);
+		assert(CXNetworkEdgeCount(net) == expectedEdges);
+		check_adjacency_matches_edges(net);
+
+		CXSize tagEntries = 0;
+		for (CXSize i = 0; i < edgeCount; i++) {
+			CXIndex edge = edgeIds[i];
+			CXSize start = 0;
+			CXSize end = 0;
+			assert(CXNetworkGetMultiCategoryEntryRange(net, CXAttributeScopeEdge, "tags", edge, &start, &end));
+			if (CXNetworkIsEdgeActive(net, edge)) {
+				assert(weight[edge] == (float)edge);
+				assert(end - start == (i % 2 ? 2u : 1u));
+				assert(CXNetworkGetMultiCategoryIds(net, CXAttributeScopeEdge, "tags")[start] == edge % 7);
+				tagEntries += end - start;
+			} else {
+				assert(weight[edge] == 0.0f);
+				assert(end == start);
+			}
+		}
+		assert(CXNetworkGetMultiCategoryEntryCount(net, CXAttributeScopeEdge, "tags") == tagEntries);
+		for (CXSize i = 0; i < nodeCount; i++) {
+			CXSize start = 0;
+			CXSize end = 0;
+			assert(CXNetworkGetMultiCategoryEntryRange(net, CXAttributeScopeNode, "groups", nodes[i], &start, &end));
+			assert(end - start == (i % 3 == 0 ? 0u : 1u));
+		}
+
+		// A large edge batch takes the same path.
+		CXSize edgeBatch = 0;
+		for (CXSize i = 0; i < edgeCount && edgeBatch < nodeCount; i += 2) {
+			removed[edgeBatch++] = edgeIds[i];
+		}
+		CXSize before = CXNetworkEdgeCount(net);
+		CXSize stillActive = 0;
+		for (CXSize i = 0; i < edgeBatch; i++) {
+			stillActive += CXNetworkIsEdgeActive(net, removed[i]) ? 1 : 0;
+		}
+		edgeVersion = CXNetworkEdgeTopologyVersion(net);
+		assert(CXNetworkRemoveEdges(net, removed, edgeBatch));
+		assert(CXNetworkEdgeTopologyVersion(net) == edgeVersion + 1);
+		assert(CXNetworkEdgeCount(net) == before - stillActive);
+		check_adjacency_matches_edges(net);
+
+		free(removed);
+		free(nodes);
+		free(edges);
+		free(edgeIds);
+		CXFreeNetwork(net);
+	}
+}
+
+static void test_freeze_and_thaw(void) {
+	CXNetworkRef net = CXNewNetwork(CXFalse);
+	assert(net);
+
+	CXIndex nodes[4] = {0};
+	assert(CXNetworkAddNodes(net, 4, nodes));
+	CXEdge edges[3] = {
+		{ .from = nodes[0], .to = nodes[1] },
+		{ .from = nodes[0], .to = nodes[2] },
+		{ .from = nodes[2], .to = nodes[3] },
+	};
+	CXIndex edgeIds[3] = {0};
+	assert(CXNetworkAddEdges(net, edges, 3, edgeIds));
+
+	assert(!CXNetworkIsFrozen(net));
+	assert(CXNetworkFreeze(net));
+	assert(CXNetworkIsFrozen(net));
+	assert(CXNetworkFreeze(net));
+
+	CXNeighborContainer *out0 = CXNetworkOutNeighbors(net, nodes[0]);
+	CXNeighborContainer *out2 = CXNetworkOutNeighbors(net, nodes[2]);
+	assert(CXNeighborContainerCount(out0) == 2);
+	assert(out0->storage.list.nodes + 2 <= out2->storage.list.nodes);
+	CXSize visited = 0;
+	CXNeighborFOR(neighbor, edge, out0) {
+		assert(neighbor == nodes[1] || neighbor == nodes[2]);
+		assert(edge == edgeIds[0] || edge == edgeIds[1]);
+		visited++;
+	}
+	assert(visited == 2);
+
+	CXNodeSelectorRef nodeSelector = CXNodeSelectorCreate(0);
+	CXEdgeSelectorRef edgeSelector = CXEdgeSelectorCreate(0);
+	assert(nodeSelector && edgeSelector);
+	assert(CXNetworkCollectNeighbors(net, &nodes[2], 1, CXNeighborDirectionOut, CXFalse, nodeSelector, edgeSelector));
+	assert(CXNodeSelectorCount(nodeSelector) == 2);
+
+	/* First mutation thaws transparently and keeps the existing adjacency. */
+	CXEdge extra = { .from = nodes[1], .to = nodes[3] };
+	assert(CXNetworkAddEdges(net, &extra, 1, NULL));
+	assert(!CXNetworkIsFrozen(net));
+	assert(CXNeighborContainerCount(CXNetworkOutNeighbors(net, nodes[0])) == 2);
+	assert(CXNeighborContainerCount(CXNetworkOutNeighbors(net, nodes[3])) == 2);
+
+	assert(CXNetworkFreeze(net));
+	assert(CXNetworkRemoveNodes(net, &nodes[0], 1));
+	assert(!CXNetworkIsFrozen(net));
+	assert(CXNeighborContainerCount(CXNetworkOutNeighbors(net, nodes[1])) == 1);
+	assert(CXNetworkEdgeCount(net) == 2);
+
+	assert(CXNetworkFreeze(net));
+	assert(CXNetworkThaw(net));
+	assert(CXNetworkThaw(net));
+	assert(CXNetworkFreeze(net));
+
+	CXNodeSelectorDestroy(nodeSelector);
+	CXEdgeSelectorDestroy(edgeSelector);
+	CXFreeNetwork(net);
+}
+
 static void test_attributes(void) {
 	CXNetworkRef net = CXNewNetwork(CXFalse);
 	assert(net);
@@ -614,6 +985,34 @@ static void verify_compaction(CXNetworkRef net, const CXIndex *activeNodes, CXSi
 	}
 }
 
+static CXBool container_has_entry(CXNeighborContainer *container, CXIndex node, CXIndex edge) {
+	CXNeighborFOR(neighbor, neighborEdge, container) {
+		if (neighbor == node && neighborEdge == edge) {
+			return CXTrue;
+		}
+	}
+	return CXFalse;
+}
+
+static void compare_adjacency(CXNetworkRef original, CXNetworkRef reloaded) {
+	assert(original->nodeCapacity == reloaded->nodeCapacity);
+	for (CXIndex node = 0; node < original->nodeCapacity; node++) {
+		if (!original->nodeActive[node]) {
+			continue;
+		}
+		CXNeighborContainer *containers[2][2] = {
+			{ &original->nodes[node].outNeighbors, &reloaded->nodes[node].outNeighbors },
+			{ &original->nodes[node].inNeighbors, &reloaded->nodes[node].inNeighbors },
+		};
+		for (int direction = 0; direction < 2; direction++) {
+			assert(CXNeighborContainerCount(containers[direction][0]) == CXNeighborContainerCount(containers[direction][1]));
+			CXNeighborFOR(neighbor, edge, containers[direction][1]) {
+				assert(container_has_entry(containers[direction][0], neighbor, edge));
+			}
+		}
+	}
+}
+
 static void verify_round_trip(CXNetworkRef net) {
 	CXSize nodeActiveCount = 0;
 	CXIndex *activeNodes = collect_active_nodes(net, &nodeActiveCount);
@@ -637,10 +1036,40 @@ static void verify_round_trip(CXNetworkRef net) {
 	assert(loadedBx);
 	CXNetworkRef loadedZx = CXNetworkReadZXNet(zxTemplate);
 	assert(loadedZx);
+	CXNetworkRef mappedBx = CXNetworkMapBXNet(bxTemplate);
+	assert(mappedBx);
 
 	unlink(bxTemplate);
 	unlink(zxTemplate);
 
+	assert(mappedBx->nodeCount == net->nodeCount);
+	assert(mappedBx->edgeCount == net->edgeCount);
+	assert(mappedBx->isDirected == net->isDirected);
+	assert(CXNetworkIsFrozen(mappedBx));
+	compare_attributes(net, mappedBx);
+	compare_adjacency(net, mappedBx);
+	compare_adjacency(net, loadedZx);
+	for (CXIndex node = 0; node < mappedBx->nodeCapacity; node++) {
+		CXIndex previous = 0;
+		CXSize position = 0;
+		CXNeighborFOR(neighbor, edge, &mappedBx->nodes[node].outNeighbors) {
+			(void)neighbor;
+			assert(position == 0 || edge >= previous);
+			previous = edge;
+			position++;
+		}
+	}
+
+	/* The first mutation thaws the bulk-built adjacency like any frozen one. */
+	CXIndex mappedNodes[2] = {0};
+	assert(CXNetworkAddNodes(mappedBx, 2, mappedNodes));
+	CXEdge mappedEdge = { .from = mappedNodes[0], .to = mappedNodes[1] };
+	assert(CXNetworkAddEdges(mappedBx, &mappedEdge, 1, NULL));
+	assert(!CXNetworkIsFrozen(mappedBx));
+	assert(CXNeighborContainerCount(CXNetworkOutNeighbors(mappedBx, mappedNodes[0])) == 1);
+	assert(CXNetworkEdgeCount(mappedBx) == net->edgeCount + 1);
+	CXFreeNetwork(mappedBx);
+
 	assert(loadedBx->nodeCount == net->nodeCount);
 	assert(loadedBx->edgeCount == net->edgeCount);
 	assert(loadedBx->isDirected == net->isDirected);
@@ -651,6 +1080,43 @@ static void verify_round_trip(CXNetworkRef net) {
 	compare_attributes(net, loadedBx);
 	compare_attributes(net, loadedZx);
 
+	/* Files carrying the ADJC chunk load the stored lists as they were written. */
+	char adjTemplate[] = "/tmp/cxnet-adj-XXXXXX";
+	int adjFd = mkstemp(adjTemplate);
+	assert(adjFd >= 0);
+	close(adjFd);
+	char adjZxTemplate[] = "/tmp/cxnet-adjz-XXXXXX";
+	int adjZxFd = mkstemp(adjZxTemplate);
+	assert(adjZxFd >= 0);
+	close(adjZxFd);
+	assert(CXNetworkWriteBXNetWithAdjacency(net, adjTemplate));
+	assert(CXNetworkWriteZXNetWithAdjacency(net, adjZxTemplate, 4));
+	CXNetworkRef adjacencyLoads[3] = {
+		CXNetworkReadBXNet(adjTemplate),
+		CXNetworkMapBXNet(adjTemplate),
+		CXNetworkReadZXNet(adjZxTemplate),
+	};
+	unlink(adjTemplate);
+	unlink(adjZxTemplate);
+	for (int i = 0; i < 3; i++) {
+		CXNetworkRef loaded = adjacencyLoads[i];
+		assert(loaded);
+		assert(CXNetworkIsFrozen(loaded));
+		assert(loaded->edgeCount == net->edgeCount);
+		compare_attributes(net, loaded);
+		compare_adjacency(net, loaded);
+		for (CXIndex node = 0; node < net->nodeCapacity; node++) {
+			if (!net->nodeActive[node]) {
+				continue;
+			}
+			CXIndex *expected = CXNetworkOutNeighbors(net, node)->storage.list.nodes;
+			CXIndex *actual = CXNetworkOutNeighbors(loaded, node)->storage.list.nodes;
+			CXSize count = CXNeighborContainerCount(CXNetworkOutNeighbors(net, node));
+			assert(count == 0 || memcmp(expected, actual, count * sizeof(CXIndex)) == 0);
+		}
+		CXFreeNetwork(loaded);
+	}
+
 	verify_compaction(loadedZx, activeNodes, nodeActiveCount, activeEdges, edgeActiveCount);
 
 	free(activeNodes);
@@ -1330,6 +1796,147 @@ static void test_xnet_string_escaping(void) {
 	CXFreeNetwork(net);
 }
 
+static void test_xnet_number_parsing(void) {
+	// CRLF endings, numbers on and off the fast paths, and a last line that
+	// ends exactly on a page boundary without a newline.
+	const char *head =
+		"#XNET 1.0.0\r\n"
+		"#vertices 4\r\n"
+		"#edges directed\r\n"
+		"0 1\r\n"
+		"  +1\t2  \r\n"
+		"\r\n"
+		"3 0\r\n"
+		"#v \"F\" f2\r\n"
+		"1.5 -2.5e-3\r\n"
+		".5 3.\r\n"
+		"1e30 0.1234567890123456789012\r\n"
+		"0x10 -0\r\n"
+		"#v \"Big\" I\r\n"
+		"9223372036854775807\r\n"
+		"-9223372036854775808\r\n"
+		"123456789012345678\r\n"
+		"-7\r\n"
+		"#e \"U\" U\r\n"
+		"18446744073709551615\r\n"
+		"0\r\n"
+		"42\r\n"
+		"#g \"Pad\" s\r\n"
+		"\"";
+	long pageSize = sysconf(_SC_PAGESIZE);
+	size_t headLen = strlen(head);
+	assert(pageSize > 0 && headLen + 1 < (size_t)pageSize);
+	size_t total = (size_t)pageSize;
+	char *content = malloc(total);
+	assert(content);
+	memcpy(content, head, headLen);
+	memset(content + headLen, 'x', total - headLen - 1);
+	content[total - 1] = '"';
+
+	char path[] = "/tmp/cxnet-numbers-XXXXXX";
+	int fd = mkstemp(path);
+	assert(fd >= 0);
+	assert(write(fd, content, total) == (ssize_t)total);
+	close(fd);
+	CXNetworkRef net = CXNetworkReadXNet(path);
+	unlink(path);
+	assert(net);
+	assert(net->nodeCount == 4);
+	assert(net->edgeCount == 3);
+	assert(net->edges[1].from == 1 && net->edges[1].to == 2);
+
+	const float *values = (const float *)CXNetworkGetNodeAttributeBuffer(net, "F");
+	assert(values);
+	const char *expected[8] = { "1.5", "-2.5e-3", ".5", "3.", "1e30", "0.1234567890123456789012", "0x10", "-0" };
+	for (int i = 0; i < 8; i++) {
+		assert(values[i] == (float)strtod(expected[i], NULL));
+	}
+	const int64_t *big = (const int64_t *)CXNetworkGetNodeAttributeBuffer(net, "Big");
+	assert(big);
+	assert(big[0] == INT64_MAX);
+	assert(big[1] == INT64_MIN);
+	assert(big[2] == 123456789012345678LL);
+	assert(big[3] == -7);
+	const uint64_t *unsignedValues = (const uint64_t *)CXNetworkGetEdgeAttributeBuffer(net, "U");
+	assert(unsignedValues);
+	assert(unsignedValues[0] == UINT64_MAX);
+	assert(unsignedValues[2] == 42);
+
+	CXString *pad = (CXString *)CXNetworkGetNetworkAttributeBuffer(net, "Pad");
+	assert(pad && pad[0]);
+	assert(strlen(pad[0]) == total - headLen - 1);
+
+	release_all_string_attributes(net);
+	CXFreeNetwork(net);
+	free(content);
+}
+
+static char *write_parallel_xnet_fixture(size_t nodeCount, size_t edgeCount, size_t badEdgeLine) {
+	char path[] = "/tmp/cxnet-parallel-XXXXXX";
+	int fd = mkstemp(path);
+	assert(fd >= 0);
+	FILE *file = fdopen(fd, "w");
+	assert(file);
+	fprintf(file, "#XNET 1.0.0\n#vertices %zu\n#edges directed\n", nodeCount);
+	for (size_t i = 0; i < edgeCount; i++) {
+		if (i % 5000 == 17) {
+			fprintf(file, "  \n");
+		}
+		if (i == badEdgeLine) {
+			fprintf(file, "%zu x\n", i % nodeCount);
+			continue;
+		}
+		fprintf(file, "%zu %zu\n", (i * 7) % nodeCount, (i * 13 + 1) % nodeCount);
+	}
+	fprintf(file, "#v \"Pos\" f2\n");
+	for (size_t i = 0; i < nodeCount; i++) {
+		fprintf(file, "%zu.25 -%zue-3\n", i, i % 977);
+	}
+	fprintf(file, "#e \"Rank\" I\n");
+	for (size_t i = 0; i < edgeCount; i++) {
+		fprintf(file, "%lld\n", (long long)i * 1000003LL - 5000000000LL);
+	}
+	fclose(file);
+	return strdup(path);
+}
+
+static void test_xnet_parallel_sections(void) {
+	const size_t nodeCount = 70000;
+	const size_t edgeCount = 140000;
+	char *path = write_parallel_xnet_fixture(nodeCount, edgeCount, SIZE_MAX);
+	CXThreadPoolSetWorkerCount(1);
+	CXNetworkRef serial = CXNetworkReadXNet(path);
+	CXThreadPoolSetWorkerCount(4);
+	CXNetworkRef parallel = CXNetworkReadXNet(path);
+	unlink(path);
+	free(path);
+	assert(serial && parallel);
+	assert(serial->edgeCount == edgeCount && parallel->edgeCount == edgeCount);
+	for (CXIndex e = 0; e < edgeCount; e++) {
+		assert(parallel->edges[e].from == serial->edges[e].from);
+		assert(parallel->edges[e].to == serial->edges[e].to);
+	}
+	assert(serial->edges[edgeCount - 1].from == ((edgeCount - 1) * 7) % nodeCount);
+	const float *serialPos = (const float *)CXNetworkGetNodeAttributeBuffer(serial, "Pos");
+	const float *parallelPos = (const float *)CXNetworkGetNodeAttributeBuffer(parallel, "Pos");
+	assert(memcmp(serialPos, parallelPos, nodeCount * 2 * sizeof(float)) == 0);
+	const int64_t *serialRank = (const int64_t *)CXNetworkGetEdgeAttributeBuffer(serial, "Rank");
+	const int64_t *parallelRank = (const int64_t *)CXNetworkGetEdgeAttributeBuffer(parallel, "Rank");
+	assert(memcmp(serialRank, parallelRank, edgeCount * sizeof(int64_t)) == 0);
+	assert(parallelRank[edgeCount - 1] == (int64_t)(edgeCount - 1) * 1000003LL - 5000000000LL);
+	CXFreeNetwork(serial);
+	CXFreeNetwork(parallel);
+
+	// A bad line deep inside a chunk fails both ways.
+	path = write_parallel_xnet_fixture(nodeCount, edgeCount, 100000);
+	assert(CXNetworkReadXNet(path) == NULL);
+	CXThreadPoolSetWorkerCount(1);
+	assert(CXNetworkReadXNet(path) == NULL);
+	unlink(path);
+	free(path);
+	CXThreadPoolSetWorkerCount(0);
+}
+
 static void test_xnet_invalid_inputs(void) {
 	struct {
 		const char *name;
@@ -1351,6 +1958,14 @@ static void test_xnet_invalid_inputs(void) {
 			"attribute count mismatch",
 			"#XNET 1.0.0\n#vertices 2\n#edges undirected\n0 1\n#v \"Value\" f\n1\n",
 		},
+		{
+			"integer overflow",
+			"#XNET 1.0.0\n#vertices 1\n#edges undirected\n#v \"Value\" I\n9223372036854775808\n",
+		},
+		{
+			"malformed edge",
+			"#XNET 1.0.0\n#vertices 2\n#edges undirected\n0 1x\n",
+		},
 		{
 			"comment inside block",
 			"#XNET 1.0.0\n#vertices 1\n#edges undirected\n#v \"Value\" f\n## nope\n0.5\n",
@@ -1374,6 +1989,80 @@ static void test_xnet_invalid_inputs(void) {
 	}
 }
 
+static void test_text_writer_formatting(void) {
+	char text[CX_TEXT_NUMBER_MAX];
+	struct { float value; const char *expected; } floats[] = {
+		{ 0.1f, "0.1" }, { 3.0f, "3" }, { -2.5f, "-2.5" }, { 1e10f, "1e+10" },
+		{ 1e-7f, "1e-07" }, { 123456792.0f, "123456790" }, { 0.0f, "0" }, { -0.0f, "-0" }
+	};
+	for (size_t i = 0; i < sizeof(floats) / sizeof(floats[0]); i++) {
+		CXTextFormatFloat(text, floats[i].value);
+		assert(strcmp(text, floats[i].expected) == 0);
+	}
+	CXTextFormatDouble(text, 0.1);
+	assert(strcmp(text, "0.1") == 0);
+	CXTextFormatDouble(text, 0.1 + 0.2);
+	assert(strcmp(text, "0.30000000000000004") == 0);
+	CXTextFormatInt64(text, INT64_MIN);
+	assert(strcmp(text, "-9223372036854775808") == 0);
+	CXTextFormatUInt64(text, UINT64_MAX);
+	assert(strcmp(text, "18446744073709551615") == 0);
+
+	// Every written value must read back bit-for-bit, across all magnitudes.
+	uint64_t state = 0x9E3779B97F4A7C15ULL;
+	for (int i = 0; i < 200000; i++) {
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		uint32_t floatBits = (uint32_t)state;
+		float f = 0.0f;
+		double d = 0.0;
+		memcpy(&f, &floatBits, sizeof(f));
+		memcpy(&d, &state, sizeof(d));
+		if (isfinite(f)) {
+			CXTextFormatFloat(text, f);
+			assert(strtof(text, NULL) == f);
+		}
+		if (isfinite(d)) {
+			CXTextFormatDouble(text, d);
+			assert(strtod(text, NULL) == d);
+		}
+	}
+
+	char path[] = "/tmp/cxnet-text-writer-XXXXXX";
+	int fd = mkstemp(path);
+	assert(fd >= 0);
+	close(fd);
+	CXTextWriter writer;
+	assert(CXTextWriterOpen(&writer, path));
+	CXTextWriterWriteEscaped(&writer, "a\"b\\\n\x01", CXTextEscapeJSON);
+	CXTextWriterPutChar(&writer, ' ');
+	CXTextWriterWriteEscaped(&writer, "\x01\x7f\t", CXTextEscapeXNet);
+	CXTextWriterPutChar(&writer, ' ');
+	CXTextWriterWriteEscaped(&writer, "\x01\r", CXTextEscapeGML);
+	// Longer than the buffer, so it goes straight to the file.
+	size_t bulkLength = CX_TEXT_WRITER_BUFFER_SIZE + 17u;
+	char *bulk = malloc(bulkLength);
+	assert(bulk);
+	memset(bulk, 'z', bulkLength);
+	CXTextWriterWrite(&writer, bulk, bulkLength);
+	assert(CXTextWriterClose(&writer));
+
+	const char *expected = "a\\\"b\\\\\\n\\u0001 \\x01\\x7F\\t \x01\\r";
+	size_t expectedLength = strlen(expected);
+	FILE *file = fopen(path, "rb");
+	assert(file);
+	char *content = malloc(expectedLength + bulkLength + 1u);
+	assert(content);
+	assert(fread(content, 1, expectedLength + bulkLength + 1u, file) == expectedLength + bulkLength);
+	fclose(file);
+	unlink(path);
+	assert(memcmp(content, expected, expectedLength) == 0);
+	assert(memcmp(content + expectedLength, bulk, bulkLength) == 0);
+	free(content);
+	free(bulk);
+}
+
 static void test_xnet_compaction_mapping(void) {
 	CXNetworkRef net = CXNewNetwork(CXFalse);
 	assert(net);
@@ -1576,6 +2265,54 @@ static void test_gml_loose_loader(void) {
 	CXFreeNetwork(net);
 }
 
+static CXNetworkRef read_gml_text(const char *payload) {
+	char path[] = "/tmp/cxnet-gml-stream-XXXXXX";
+	int fd = mkstemp(path);
+	assert(fd >= 0);
+	size_t len = strlen(payload);
+	assert(write(fd, payload, len) == (ssize_t)len);
+	close(fd);
+	CXNetworkRef net = CXNetworkReadGML(path);
+	unlink(path);
+	return net;
+}
+
+static void test_gml_streaming_reader(void) {
+	// Edges may name nodes declared later; unknown endpoints become new nodes.
+	CXNetworkRef net = read_gml_text(
+		"graph [\n"
+		"  edge [ source b target a w 1 ]\n"
+		"  node [ id a tag \"x\\\"y\" tag \"last\" meta 4.5 ]\n"
+		"  edge [ source a target c w -2 extra [ q 1 ] ]\n"
+		"  node [ id b tag plain meta [ k [ deep 1 ] ] ]\n"
+		"]\n");
+	assert(net);
+	assert(net->nodeCount == 3);
+	assert(net->edgeCount == 2);
+	const char *warning = CXNetworkSerializationLastWarningMessage();
+	assert(warning && strstr(warning, "skipped nested node attribute \"meta\"") != NULL);
+
+	CXString *ids = (CXString *)CXNetworkGetNodeAttributeBuffer(net, "_original_ids_");
+	assert(ids);
+	assert(strcmp(ids[0], "a") == 0 && strcmp(ids[1], "b") == 0 && strcmp(ids[2], "c") == 0);
+	CXString *tags = (CXString *)CXNetworkGetNodeAttributeBuffer(net, "tag");
+	assert(tags && strcmp(tags[0], "last") == 0 && strcmp(tags[1], "plain") == 0 && tags[2] == NULL);
+	assert(!CXNetworkGetNodeAttribute(net, "meta"));
+	CXEdge *edges = CXNetworkEdgesBuffer(net);
+	assert(edges[0].from == 1 && edges[0].to == 0);
+	assert(edges[1].from == 0 && edges[1].to == 2);
+	CXAttributeRef weight = CXNetworkGetEdgeAttribute(net, "w");
+	assert(weight && weight->type == CXIntegerAttributeType);
+	assert(((int32_t *)weight->data)[1] == -2);
+	release_all_string_attributes(net);
+	CXFreeNetwork(net);
+
+	assert(!read_gml_text("graph [ node [ id 1 ] edge [ source 1 ] ]"));
+	assert(strstr(CXNetworkSerializationLastWarningMessage(), "source and target") != NULL);
+	assert(!read_gml_text("graph [ node [ id 1 label \"open ] ]"));
+	assert(strstr(CXNetworkSerializationLastWarningMessage(), "unterminated string literal") != NULL);
+}
+
 static void test_gt_round_trip(void) {
 	CXNetworkRef net = CXNewNetwork(CXTrue);
 	assert(net);
@@ -1798,6 +2535,953 @@ static void test_node_link_json_export(void) {
 	CXFreeNetwork(net);
 }
 
+static CXNetworkRef read_node_link_json_text(const char *payload) {
+	char path[] = "/tmp/cxnet-node-link-read-XXXXXX";
+	int fd = mkstemp(path);
+	assert(fd >= 0);
+	size_t len = strlen(payload);
+	assert(write(fd, payload, len) == (ssize_t)len);
+	close(fd);
+	CXNetworkRef net = CXNetworkReadNodeLinkJSON(path);
+	unlink(path);
+	return net;
+}
+
+static void test_node_link_json_read(void) {
+	const char *payload =
+		"{\"directed\": true,\n"
+		" \"graph\": {\"title\": \"Demo\", \"meta\": {\"b\": [1.0, 2.5, \"x\\n\"]}},\n"
+		" \"nodes\": [\n"
+		"  {\"id\": \"a\", \"label\": \"Alpha\", \"coords\": [1, 2], \"score\": 1, \"tags\": [\"x\", \"y\"], \"flag\": true},\n"
+		"  {\"id\": \"b\", \"coords\": [3, 4], \"tags\": [\"y\"], \"attributes\": {\"score\": -2.5, \"label\": \"B\\u00e9ta\"}},\n"
+		"  {\"id\": \"a\", \"mixed\": 1},\n"
+		"  7,\n"
+		"  {\"label\": \"anon\", \"mixed\": \"text\", \"_original_ids_\": \"taken\"}\n"
+		" ],\n"
+		" \"links\": [\n"
+		"  {\"source\": \"a\", \"target\": \"b\", \"weight\": 2, \"cats\": [{\"label\": \"k\", \"weight\": 0.5}, {\"label\": \"m\"}]},\n"
+		"  {\"source\": \"b\", \"target\": \"ghost\"},\n"
+		"  {\"source\": 5, \"target\": \"a\", \"weight\": 3},\n"
+		"  {\"source\": \"a\"},\n"
+		"  {\"source\": \"a\", \"target\": \"b\", \"weight\": null}\n"
+		" ]}\n";
+
+	CXNetworkRef net = read_node_link_json_text(payload);
+	assert(net);
+	const char *warning = CXNetworkSerializationLastWarningMessage();
+	assert(strstr(warning, "skipped non-object node at position 3") != NULL);
+	assert(strstr(warning, "synthesized an id for node at position 4") != NULL);
+	assert(strstr(warning, "renamed duplicate node id a to a#1") != NULL);
+	assert(strstr(warning, "synthesized a node for missing endpoint ghost") != NULL);
+	assert(strstr(warning, "skipped link at position 3 because source/target is missing") != NULL);
+	assert(strstr(warning, "coerced attribute \"mixed\"") != NULL);
+	assert(strstr(warning, "coerced attribute \"meta\"") != NULL);
+	assert(strstr(warning, "reserved \"_original_ids_\"") != NULL);
+
+	assert(CXNetworkIsDirected(net));
+	assert(net->nodeCount == 6);
+	assert(net->edgeCount == 4);
+
+	CXString *originalIds = (CXString *)CXNetworkGetNodeAttributeBuffer(net, "_original_ids_");
+	assert(originalIds);
+	const char *expectedIds[] = { "a", "b", "a#1", "__helios_node_4", "ghost", "5" };
+	for (CXIndex i = 0; i < 6; i++) {
+		assert(strcmp(originalIds[i], expectedIds[i]) == 0);
+	}
+
+	CXAttributeRef label = CXNetworkGetNodeAttribute(net, "label");
+	assert(label && label->type == CXStringAttributeType);
+	CXString *labels = (CXString *)label->data;
+	assert(strcmp(labels[0], "Alpha") == 0);
+	assert(strcmp(labels[1], "B\xC3\xA9ta") == 0);
+	assert(strcmp(labels[3], "anon") == 0);
+
+	CXAttributeRef coords = CXNetworkGetNodeAttribute(net, "coords");
+	assert(coords && coords->type == CXUnsignedIntegerAttributeType && coords->dimension == 2);
+	assert(((uint32_t *)coords->data)[2] == 3 && ((uint32_t *)coords->data)[3] == 4);
+
+	CXAttributeRef score = CXNetworkGetNodeAttribute(net, "score");
+	assert(score && score->type == CXDoubleAttributeType);
+	assert(((double *)score->data)[0] == 1.0 && ((double *)score->data)[1] == -2.5);
+
+	CXAttributeRef flag = CXNetworkGetNodeAttribute(net, "flag");
+	assert(flag && flag->type == CXBooleanAttributeType && flag->data[0] == 1 && flag->data[1] == 0);
+
+	CXAttributeRef mixed = CXNetworkGetNodeAttribute(net, "mixed");
+	assert(mixed && mixed->type == CXStringAttributeType);
+	assert(strcmp(((CXString *)mixed->data)[2], "1") == 0);
+	assert(strcmp(((CXString *)mixed->data)[3], "text") == 0);
+
+	CXSize start = 0;
+	CXSize end = 0;
+	assert(CXNetworkGetMultiCategoryEntryRange(net, CXAttributeScopeNode, "tags", 0, &start, &end));
+	assert(end - start == 2);
+	uint32_t *tagIds = CXNetworkGetMultiCategoryIds(net, CXAttributeScopeNode, "tags");
+	uint32_t yId = tagIds[start + 1];
+	assert(CXNetworkGetMultiCategoryEntryRange(net, CXAttributeScopeNode, "tags", 1, &start, &end));
+	assert(end - start == 1 && tagIds[start] == yId);
+	assert(CXNetworkGetMultiCategoryEntryRange(net, CXAttributeScopeNode, "tags", 2, &start, &end));
+	assert(end == start);
+
+	CXAttributeRef weight = CXNetworkGetEdgeAttribute(net, "weight");
+	assert(weight && weight->type == CXUnsignedIntegerAttributeType);
+	assert(((uint32_t *)weight->data)[0] == 2 && ((uint32_t *)weight->data)[2] == 3);
+	assert(net->edges[2].from == 5 && net->edges[2].to == 0);
+	assert(CXNetworkMultiCategoryHasWeights(net, CXAttributeScopeEdge, "cats"));
+	assert(CXNetworkGetMultiCategoryEntryRange(net, CXAttributeScopeEdge, "cats", 0, &start, &end));
+	float *catWeights = CXNetworkGetMultiCategoryWeights(net, CXAttributeScopeEdge, "cats");
+	assert(end - start == 2 && catWeights[start] == 0.5f && catWeights[start + 1] == 1.0f);
+
+	CXString *title = (CXString *)CXNetworkGetNetworkAttributeBuffer(net, "title");
+	assert(title && strcmp(title[0], "Demo") == 0);
+	CXString *meta = (CXString *)CXNetworkGetNetworkAttributeBuffer(net, "meta");
+	assert(meta && strcmp(meta[0], "{\"b\":[1,2.5,\"x\\n\"]}") == 0);
+
+	release_all_string_attributes(net);
+	CXFreeNetwork(net);
+
+	assert(read_node_link_json_text("{\"nodes\": [{\"id\": 1},]}") == NULL);
+	assert(strstr(CXNetworkSerializationLastWarningMessage(), "parse error") != NULL);
+	assert(read_node_link_json_text("{\"nodes\": {}}") == NULL);
+	assert(strstr(CXNetworkSerializationLastWarningMessage(), "\"nodes\" must be an array") != NULL);
+	assert(read_node_link_json_text("[]") == NULL);
+}
+
+/* Every footer locator of a ZXNet file must seek to its chunk header. */
+static void verify_zxnet_locators(const char *path) {
+	BGZF *bgzf = bgzf_open(path, "r");
+	assert(bgzf);
+	size_t capacity = 1u << 20;
+	size_t size = 0;
+	uint8_t *bytes = malloc(capacity);
+	assert(bytes);
+	for (;;) {
+		if (size == capacity) {
+			capacity *= 2;
+			bytes = realloc(bytes, capacity);
+			assert(bytes);
+		}
+		ssize_t got = bgzf_read(bgzf, bytes + size, capacity - size);
+		assert(got >= 0);
+		if (got == 0) {
+			break;
+		}
+		size += (size_t)got;
+	}
+	assert(size >= CX_NETWORK_FILE_FOOTER_SIZE);
+	const uint8_t *footer = bytes + size - CX_NETWORK_FILE_FOOTER_SIZE;
+	uint32_t chunkCount = 0;
+	memcpy(&chunkCount, footer + 8, sizeof(chunkCount));
+	assert(chunkCount >= 9);
+	for (uint32_t i = 0; i < chunkCount; i++) {
+		uint32_t chunkId = 0;
+		int64_t offset = 0;
+		memcpy(&chunkId, footer + 16 + i * 24u, sizeof(chunkId));
+		memcpy(&offset, footer + 16 + i * 24u + 8u, sizeof(offset));
+		uint32_t found = 0;
+		assert(bgzf_seek(bgzf, offset, SEEK_SET) == 0);
+		assert(bgzf_read(bgzf, &found, sizeof(found)) == (ssize_t)sizeof(found));
+		assert(found == chunkId);
+	}
+	free(bytes);
+	bgzf_close(bgzf);
+}
+
+static void test_zxnet_threaded_round_trip(void) {
+	/* Large enough to span many BGZF blocks. */
+	CXNetworkRef net = CXNetworkGenerateWattsStrogatz(20000, 3, 0.1, CXFalse, 23);
+	assert(net);
+
+	char serialPath[] = "/tmp/cxnet-zx-serial-XXXXXX";
+	int serialFd = mkstemp(serialPath);
+	assert(serialFd >= 0);
+	close(serialFd);
+	char threadedPath[] = "/tmp/cxnet-zx-threaded-XXXXXX";
+	int threadedFd = mkstemp(threadedPath);
+	assert(threadedFd >= 0);
+	close(threadedFd);
+
+	assert(CXNetworkGetZXNetThreadCount() == 1);
+	assert(CXNetworkWriteZXNet(net, serialPath, 6));
+	CXNetworkSetZXNetThreadCount(4);
+	assert(CXNetworkGetZXNetThreadCount() == 4);
+	assert(CXNetworkWriteZXNet(net, threadedPath, 6));
+	verify_zxnet_locators(serialPath);
+	verify_zxnet_locators(threadedPath);
+
+	CXNetworkRef loadedSerial = CXNetworkReadZXNet(serialPath);
+	CXNetworkRef loadedThreaded = CXNetworkReadZXNet(threadedPath);
+	CXNetworkSetZXNetThreadCount(1);
+	unlink(serialPath);
+	unlink(threadedPath);
+	CXNetworkRef loads[2] = { loadedSerial, loadedThreaded };
+	for (int i = 0; i < 2; i++) {
+		assert(loads[i]);
+		assert(loads[i]->edgeCount == net->edgeCount);
+		compare_attributes(net, loads[i]);
+		compare_adjacency(net, loads[i]);
+		CXFreeNetwork(loads[i]);
+	}
+	CXFreeNetwork(net);
+}
+
+static void test_filtered_read(void) {
+	/* Dropped columns span many BGZF blocks so whole blocks get skipped. */
+	CXNetworkRef net = CXNetworkGenerateWattsStrogatz(20000, 3, 0.1, CXFalse, 29);
+	assert(net);
+	assert(CXNetworkDefineNodeAttribute(net, "keep", CXDoubleAttributeType, 1));
+	assert(CXNetworkDefineNodeAttribute(net, "drop", CXDoubleAttributeType, 8));
+	assert(CXNetworkDefineNodeAttribute(net, "label", CXStringAttributeType, 1));
+	assert(CXNetworkDefineEdgeAttribute(net, "weight", CXFloatAttributeType, 1));
+	assert(CXNetworkDefineEdgeAttribute(net, "noise", CXDoubleAttributeType, 4));
+	assert(CXNetworkDefineNetworkAttribute(net, "title", CXStringAttributeType, 1));
+	srand(5);
+	randomize_node_attributes(net, CXNetworkGetNodeAttribute(net, "keep"));
+	randomize_node_attributes(net, CXNetworkGetNodeAttribute(net, "drop"));
+	randomize_edge_attributes(net, CXNetworkGetEdgeAttribute(net, "weight"));
+	randomize_edge_attributes(net, CXNetworkGetEdgeAttribute(net, "noise"));
+	CXString *labels = (CXString *)CXNetworkGetNodeAttributeBuffer(net, "label");
+	labels[0] = CXNewStringFromString("first");
+	labels[19999] = CXNewStringFromString("last");
+	CXString *title = (CXString *)CXNetworkGetNetworkAttributeBuffer(net, "title");
+	title[0] = CXNewStringFromString("filtered");
+
+	char bxPath[] = "/tmp/cxnet-filter-bx-XXXXXX";
+	int bxFd = mkstemp(bxPath);
+	assert(bxFd >= 0);
+	close(bxFd);
+	char zxPath[] = "/tmp/cxnet-filter-zx-XXXXXX";
+	int zxFd = mkstemp(zxPath);
+	assert(zxFd >= 0);
+	close(zxFd);
+	assert(CXNetworkWriteBXNet(net, bxPath));
+	assert(CXNetworkWriteZXNet(net, zxPath, 6));
+
+	const char *nodeAllow[] = { "keep" };
+	const char *edgeIgnore[] = { "noise" };
+	const char *networkAllow[] = { "missing" };
+	CXNetworkRef loads[3] = {
+		CXNetworkReadBXNetFiltered(bxPath, nodeAllow, 1, NULL, 0, NULL, 0, edgeIgnore, 1, networkAllow, 1, NULL, 0),
+		CXNetworkReadZXNetFiltered(zxPath, nodeAllow, 1, NULL, 0, NULL, 0, edgeIgnore, 1, networkAllow, 1, NULL, 0),
+		NULL
+	};
+	/* Threaded handles fall back to the plain reader path. */
+	CXNetworkSetZXNetThreadCount(4);
+	loads[2] = CXNetworkReadZXNetFiltered(zxPath, nodeAllow, 1, NULL, 0, NULL, 0, edgeIgnore, 1, networkAllow, 1, NULL, 0);
+	CXNetworkSetZXNetThreadCount(1);
+
+	CXAttributeRef keep = CXNetworkGetNodeAttribute(net, "keep");
+	CXAttributeRef weight = CXNetworkGetEdgeAttribute(net, "weight");
+	for (int i = 0; i < 3; i++) {
+		CXNetworkRef loaded = loads[i];
+		assert(loaded);
+		assert(loaded->edgeCount == net->edgeCount);
+		compare_adjacency(net, loaded);
+		assert(!CXNetworkGetNodeAttribute(loaded, "drop"));
+		assert(!CXNetworkGetNodeAttribute(loaded, "label"));
+		assert(!CXNetworkGetEdgeAttribute(loaded, "noise"));
+		assert(!CXNetworkGetNetworkAttribute(loaded, "title"));
+		CXAttributeRef loadedKeep = CXNetworkGetNodeAttribute(loaded, "keep");
+		CXAttributeRef loadedWeight = CXNetworkGetEdgeAttribute(loaded, "weight");
+		assert(loadedKeep && loadedWeight);
+		for (CXIndex node = 0; node < net->nodeCount; node++) {
+			assert(memcmp((uint8_t *)keep->data + node * keep->stride, (uint8_t *)loadedKeep->data + node * loadedKeep->stride, keep->stride) == 0);
+		}
+		for (CXIndex edge = 0; edge < net->edgeCount; edge++) {
+			assert(memcmp((uint8_t *)weight->data + edge * weight->stride, (uint8_t *)loadedWeight->data + edge * loadedWeight->stride, weight->stride) == 0);
+		}
+		CXFreeNetwork(loaded);
+	}
+
+	/* Unfiltered reads still see every attribute and verify the checksum. */
+	CXNetworkRef full = CXNetworkReadZXNet(zxPath);
+	assert(full);
+	assert(CXNetworkGetNodeAttribute(full, "drop") && CXNetworkGetEdgeAttribute(full, "noise"));
+	CXString *fullLabels = (CXString *)CXNetworkGetNodeAttributeBuffer(full, "label");
+	assert(strcmp(fullLabels[0], "first") == 0 && strcmp(fullLabels[19999], "last") == 0);
+	CXString *fullTitle = (CXString *)CXNetworkGetNetworkAttributeBuffer(full, "title");
+	assert(strcmp(fullTitle[0], "filtered") == 0);
+	release_all_string_attributes(full);
+	CXFreeNetwork(full);
+
+	unlink(bxPath);
+	unlink(zxPath);
+	release_all_string_attributes(net);
+	CXFreeNetwork(net);
+}
+
+typedef CXBool (*QueryReference)(CXNetworkRef net, CXIndex index);
+
+static float *g_query_score;
+static int32_t *g_query_rank;
+static int64_t *g_query_big;
+static uint8_t *g_query_flag;
+static double *g_query_vec;
+static int32_t *g_query_group;
+static int32_t g_query_group_ids[3];
+static double *g_query_weight;
+
+static void expect_query(CXNetworkRef net, CXAttributeScope scope, const char *query, QueryReference reference) {
+	CXSize capacity = scope == CXAttributeScopeNode ? net->nodeCapacity : net->edgeCapacity;
+	const CXBool *active = scope == CXAttributeScopeNode ? net->nodeActive : net->edgeActive;
+	CXIndex *expected = malloc(sizeof(CXIndex) * (capacity + 1));
+	assert(expected);
+	CXSize expectedCount = 0;
+	for (CXIndex i = 0; i < capacity; i++) {
+		if (active[i] && reference(net, i)) {
+			expected[expectedCount++] = i;
+		}
+	}
+	const CXIndex *data = NULL;
+	CXSize count = 0;
+	CXNodeSelectorRef nodes = NULL;
+	CXEdgeSelectorRef edges = NULL;
+	if (scope == CXAttributeScopeNode) {
+		nodes = CXNodeSelectorCreate(0);
+		assert(nodes && CXNetworkSelectNodesByQuery(net, query, nodes));
+		data = CXNodeSelectorData(nodes);
+		count = CXNodeSelectorCount(nodes);
+	} else {
+		edges = CXEdgeSelectorCreate(0);
+		assert(edges && CXNetworkSelectEdgesByQuery(net, query, edges));
+		data = CXEdgeSelectorData(edges);
+		count = CXEdgeSelectorCount(edges);
+	}
+	if (count != expectedCount || (count > 0 && memcmp(data, expected, sizeof(CXIndex) * count) != 0)) {
+		fprintf(stderr, "Query mismatch for '%s': %zu vs %zu\n", query, (size_t)count, (size_t)expectedCount);
+		assert(0);
+	}
+	if (nodes) {
+		CXNodeSelectorDestroy(nodes);
+	}
+	if (edges) {
+		CXEdgeSelectorDestroy(edges);
+	}
+	free(expected);
+}
+
+static CXBool ref_score_gt(CXNetworkRef net, CXIndex i) { (void)net; return g_query_score[i] > 0.5; }
+static CXBool ref_rank_flag(CXNetworkRef net, CXIndex i) { (void)net; return g_query_rank[i] <= 10 && !(g_query_flag[i] == 1); }
+static CXBool ref_big_or(CXNetworkRef net, CXIndex i) { (void)net; return g_query_big[i] != 7 || g_query_score[i] < 0.1; }
+static CXBool ref_vec_any(CXNetworkRef net, CXIndex i) { (void)net; return g_query_vec[i * 3] > 0.8 || g_query_vec[i * 3 + 1] > 0.8 || g_query_vec[i * 3 + 2] > 0.8; }
+static CXBool ref_vec_all(CXNetworkRef net, CXIndex i) { (void)net; return g_query_vec[i * 3] > 0.2 && g_query_vec[i * 3 + 1] > 0.2 && g_query_vec[i * 3 + 2] > 0.2; }
+static CXBool ref_vec_index(CXNetworkRef net, CXIndex i) { (void)net; return g_query_vec[i * 3 + 1] < 0.3; }
+static CXBool ref_group_eq(CXNetworkRef net, CXIndex i) { (void)net; return g_query_group[i] == g_query_group_ids[1]; }
+static CXBool ref_group_in(CXNetworkRef net, CXIndex i) { (void)net; return g_query_group[i] == g_query_group_ids[0] || g_query_group[i] == g_query_group_ids[2]; }
+static CXBool ref_none(CXNetworkRef net, CXIndex i) { (void)net; (void)i; return CXFalse; }
+static CXBool ref_all(CXNetworkRef net, CXIndex i) { (void)net; (void)i; return CXTrue; }
+static CXBool ref_rank_in(CXNetworkRef net, CXIndex i) { (void)net; return g_query_rank[i] >= 1 && g_query_rank[i] <= 3; }
+static CXBool ref_neighbor_any(CXNetworkRef net, CXIndex i) {
+	CXNodeRecord *record = &net->nodes[i];
+	CXNeighborContainer *containers[2] = { &record->outNeighbors, &record->inNeighbors };
+	for (int c = 0; c < 2; c++) {
+		CXNeighborFOR(neighbor, edge, containers[c]) {
+			(void)edge;
+			if (g_query_score[neighbor] > 0.9f) {
+				return CXTrue;
+			}
+		}
+	}
+	return CXFalse;
+}
+static CXString *g_query_names;
+static CXBool ref_neighbor_both_rank(CXNetworkRef net, CXIndex i) {
+	CXNodeRecord *record = &net->nodes[i];
+	CXNeighborContainer *containers[2] = { &record->outNeighbors, &record->inNeighbors };
+	CXBool hasNeighbor = CXFalse;
+	for (int c = 0; c < 2; c++) {
+		CXNeighborFOR(neighbor, edge, containers[c]) {
+			(void)edge;
+			hasNeighbor = CXTrue;
+			if (!(g_query_rank[neighbor] > 0)) {
+				return CXFalse;
+			}
+		}
+	}
+	return hasNeighbor;
+}
+static CXBool ref_neighbor_any_name(CXNetworkRef net, CXIndex i) {
+	CXNodeRecord *record = &net->nodes[i];
+	CXNeighborContainer *containers[2] = { &record->outNeighbors, &record->inNeighbors };
+	for (int c = 0; c < 2; c++) {
+		CXNeighborFOR(neighbor, edge, containers[c]) {
+			(void)edge;
+			if (strcmp(g_query_names[neighbor], "n7") == 0) {
+				return CXTrue;
+			}
+		}
+	}
+	return CXFalse;
+}
+static CXBool ref_edge_src_name(CXNetworkRef net, CXIndex e) { return strncmp(g_query_names[net->edges[e].from], "n1", 2) == 0; }
+static CXBool ref_edge_src_group(CXNetworkRef net, CXIndex e) { return g_query_weight[e] > 0.5 && g_query_group[net->edges[e].from] == g_query_group_ids[1]; }
+static CXBool ref_edge_both_rank(CXNetworkRef net, CXIndex e) { return g_query_rank[net->edges[e].from] < 20 && g_query_rank[net->edges[e].to] < 20; }
+static CXBool ref_edge_any_score(CXNetworkRef net, CXIndex e) { return g_query_score[net->edges[e].from] > 0.9f || g_query_score[net->edges[e].to] > 0.9f; }
+static CXBool ref_edge_not_dst_flag(CXNetworkRef net, CXIndex e) { return !(g_query_flag[net->edges[e].to] == 1) || g_query_weight[e] < 0.2; }
+
+static void test_query_selection(void) {
+	CXNetworkRef net = CXNewNetwork(CXTrue);
+	assert(net);
+	const CXSize nodeCount = 300;
+	CXIndex nodes[300];
+	assert(CXNetworkAddNodes(net, nodeCount, nodes));
+	srand(17);
+	CXEdge edges[900];
+	for (CXSize i = 0; i < 900; i++) {
+		edges[i].from = nodes[(CXSize)rand() % nodeCount];
+		edges[i].to = nodes[(CXSize)rand() % nodeCount];
+	}
+	assert(CXNetworkAddEdges(net, edges, 900, NULL));
+
+	assert(CXNetworkDefineNodeAttribute(net, "score", CXFloatAttributeType, 1));
+	assert(CXNetworkDefineNodeAttribute(net, "rank", CXIntegerAttributeType, 1));
+	assert(CXNetworkDefineNodeAttribute(net, "big", CXBigIntegerAttributeType, 1));
+	assert(CXNetworkDefineNodeAttribute(net, "flag", CXBooleanAttributeType, 1));
+	assert(CXNetworkDefineNodeAttribute(net, "vec", CXDoubleAttributeType, 3));
+	assert(CXNetworkDefineNodeAttribute(net, "group", CXStringAttributeType, 1));
+	assert(CXNetworkDefineEdgeAttribute(net, "weight", CXDoubleAttributeType, 1));
+	g_query_score = CXNetworkGetNodeAttributeBuffer(net, "score");
+	g_query_rank = CXNetworkGetNodeAttributeBuffer(net, "rank");
+	g_query_big = CXNetworkGetNodeAttributeBuffer(net, "big");
+	g_query_flag = CXNetworkGetNodeAttributeBuffer(net, "flag");
+	g_query_vec = CXNetworkGetNodeAttributeBuffer(net, "vec");
+	g_query_weight = CXNetworkGetEdgeAttributeBuffer(net, "weight");
+	CXString *labels = CXNetworkGetNodeAttributeBuffer(net, "group");
+	const char *groupNames[3] = { "g0", "g1", "g2" };
+	for (CXSize i = 0; i < nodeCount; i++) {
+		g_query_score[i] = (float)random_unit();
+		g_query_rank[i] = rand() % 40 - 5;
+		g_query_big[i] = rand() % 10;
+		g_query_flag[i] = (uint8_t)(rand() % 2);
+		for (int d = 0; d < 3; d++) {
+			g_query_vec[i * 3 + d] = random_unit();
+		}
+		labels[i] = CXNewStringFromString(groupNames[rand() % 3]);
+	}
+	for (CXSize e = 0; e < 900; e++) {
+		g_query_weight[e] = random_unit();
+	}
+	assert(CXNetworkCategorizeAttribute(net, CXAttributeScopeNode, "group", CX_CATEGORY_SORT_NONE, "__NA__"));
+	CXAttributeRef group = CXNetworkGetNodeAttribute(net, "group");
+	g_query_group = (int32_t *)group->data;
+	for (int i = 0; i < 3; i++) {
+		void *encoded = CXStringDictionaryEntryForKey(group->categoricalDictionary, groupNames[i]);
+		assert(encoded);
+		g_query_group_ids[i] = (int32_t)((uintptr_t)encoded - 2u);
+	}
+
+	/* Leave holes so inactive rows must be masked out. */
+	CXIndex removedNodes[] = { 3, 64, 65, 127, 299 };
+	assert(CXNetworkRemoveNodes(net, removedNodes, 5));
+	CXIndex removedEdges[] = { 0, 1, 63, 64, 500 };
+	for (size_t i = 0; i < 5; i++) {
+		if (net->edgeActive[removedEdges[i]]) {
+			assert(CXNetworkRemoveEdges(net, &removedEdges[i], 1));
+		}
+	}
+
+	expect_query(net, CXAttributeScopeNode, "score > 0.5", ref_score_gt);
+	expect_query(net, CXAttributeScopeNode, "rank <= 10 AND NOT flag == 1", ref_rank_flag);
+	expect_query(net, CXAttributeScopeNode, "big != 7 OR score < 0.1", ref_big_or);
+	expect_query(net, CXAttributeScopeNode, "vec > 0.8", ref_vec_any);
+	expect_query(net, CXAttributeScopeNode, "vec.all > 0.2", ref_vec_all);
+	expect_query(net, CXAttributeScopeNode, "vec[1] < 0.3", ref_vec_index);
+	expect_query(net, CXAttributeScopeNode, "group == \"g1\"", ref_group_eq);
+	expect_query(net, CXAttributeScopeNode, "group IN (\"g0\", \"g2\")", ref_group_in);
+	expect_query(net, CXAttributeScopeNode, "group == \"missing\"", ref_none);
+	expect_query(net, CXAttributeScopeNode, "NOT group == \"missing\"", ref_all);
+	expect_query(net, CXAttributeScopeNode, "rank IN (1, 2, 3)", ref_rank_in);
+	expect_query(net, CXAttributeScopeNode, "$any.neighbor.score > 0.9", ref_neighbor_any);
+	expect_query(net, CXAttributeScopeEdge, "weight > 0.5 AND $src.group == \"g1\"", ref_edge_src_group);
+	expect_query(net, CXAttributeScopeEdge, "$both.rank < 20", ref_edge_both_rank);
+	expect_query(net, CXAttributeScopeEdge, "$any.score > 0.9", ref_edge_any_score);
+	expect_query(net, CXAttributeScopeEdge, "NOT $dst.flag == 1 OR weight < 0.2", ref_edge_not_dst_flag);
+
+	CXFreeNetwork(net);
+}
+
+static void test_parallel_query(void) {
+	/* Enough rows for several partitions, so tiles land on different workers. */
+	CXNetworkRef net = CXNewNetwork(CXTrue);
+	assert(net);
+	const CXSize nodeCount = 40000;
+	const CXSize edgeCount = 120000;
+	CXIndex *nodes = malloc(sizeof(CXIndex) * nodeCount);
+	CXEdge *edges = malloc(sizeof(CXEdge) * edgeCount);
+	assert(nodes && edges);
+	assert(CXNetworkAddNodes(net, nodeCount, nodes));
+	srand(23);
+	for (CXSize i = 0; i < edgeCount; i++) {
+		edges[i].from = nodes[(CXSize)rand() % nodeCount];
+		edges[i].to = nodes[(CXSize)rand() % nodeCount];
+	}
+	assert(CXNetworkAddEdges(net, edges, edgeCount, NULL));
+	assert(CXNetworkDefineNodeAttribute(net, "score", CXFloatAttributeType, 1));
+	assert(CXNetworkDefineNodeAttribute(net, "rank", CXIntegerAttributeType, 1));
+	assert(CXNetworkDefineNodeAttribute(net, "flag", CXBooleanAttributeType, 1));
+	assert(CXNetworkDefineEdgeAttribute(net, "weight", CXDoubleAttributeType, 1));
+	assert(CXNetworkDefineNodeAttribute(net, "name", CXStringAttributeType, 1));
+	g_query_score = CXNetworkGetNodeAttributeBuffer(net, "score");
+	g_query_rank = CXNetworkGetNodeAttributeBuffer(net, "rank");
+	g_query_flag = CXNetworkGetNodeAttributeBuffer(net, "flag");
+	g_query_weight = CXNetworkGetEdgeAttributeBuffer(net, "weight");
+	g_query_names = CXNetworkGetNodeAttributeBuffer(net, "name");
+	char name[16];
+	for (CXSize i = 0; i < nodeCount; i++) {
+		g_query_score[i] = (float)random_unit();
+		g_query_rank[i] = rand() % 40 - 1;
+		g_query_flag[i] = (uint8_t)(rand() % 2);
+		snprintf(name, sizeof(name), "n%d", rand() % 300);
+		g_query_names[i] = CXNewStringFromString(name);
+	}
+	for (CXSize e = 0; e < edgeCount; e++) {
+		g_query_weight[e] = random_unit();
+	}
+	for (CXIndex node = 5; node < nodeCount; node += 997) {
+		assert(CXNetworkRemoveNodes(net, &node, 1));
+	}
+
+	CXSize workerCounts[2] = { 1, 4 };
+	for (int run = 0; run < 2; run++) {
+		CXThreadPoolSetWorkerCount(workerCounts[run]);
+		expect_query(net, CXAttributeScopeNode, "score > 0.5", ref_score_gt);
+		expect_query(net, CXAttributeScopeNode, "rank <= 10 AND NOT flag == 1", ref_rank_flag);
+		expect_query(net, CXAttributeScopeNode, "$any.neighbor.score > 0.9", ref_neighbor_any);
+		expect_query(net, CXAttributeScopeNode, "$both.neighbor.rank > 0", ref_neighbor_both_rank);
+		expect_query(net, CXAttributeScopeNode, "$any.neighbor.name == \"n7\"", ref_neighbor_any_name);
+		expect_query(net, CXAttributeScopeNode, "score > 2", ref_none);
+		expect_query(net, CXAttributeScopeEdge, "$both.rank < 20", ref_edge_both_rank);
+		expect_query(net, CXAttributeScopeEdge, "$src.name =~ \"^n1\"", ref_edge_src_name);
+		expect_query(net, CXAttributeScopeEdge, "$any.score > 0.9", ref_edge_any_score);
+		expect_query(net, CXAttributeScopeEdge, "NOT $dst.flag == 1 OR weight < 0.2", ref_edge_not_dst_flag);
+	}
+	CXThreadPoolSetWorkerCount(0);
+
+	free(nodes);
+	free(edges);
+	CXFreeNetwork(net);
+}
+
+static CXAttributeRef g_query_tags;
+static int32_t g_query_tag_ids[3];
+
+static CXBool ref_tags_has(CXIndex i, int32_t id) {
+	const CXMultiCategoryBuffer *buffer = g_query_tags->multiCategory;
+	for (uint32_t k = buffer->offsets[i]; k < buffer->offsets[i + 1]; k++) {
+		if ((int32_t)buffer->ids[k] == id) {
+			return CXTrue;
+		}
+	}
+	return CXFalse;
+}
+static CXBool ref_tags_a(CXNetworkRef net, CXIndex i) { (void)net; return ref_tags_has(i, g_query_tag_ids[0]); }
+static CXBool ref_tags_not_b(CXNetworkRef net, CXIndex i) { (void)net; return !ref_tags_has(i, g_query_tag_ids[1]); }
+static CXBool ref_tags_b_or_c(CXNetworkRef net, CXIndex i) { (void)net; return ref_tags_has(i, g_query_tag_ids[1]) || ref_tags_has(i, g_query_tag_ids[2]); }
+static CXBool ref_score_band(CXNetworkRef net, CXIndex i) { (void)net; return g_query_score[i] >= 0.25f && g_query_score[i] < 0.3f; }
+static CXBool ref_rank_eq_flag(CXNetworkRef net, CXIndex i) { (void)net; return g_query_rank[i] == 7 && g_query_flag[i] == 1; }
+static CXBool ref_group_rank(CXNetworkRef net, CXIndex i) { (void)net; return g_query_group[i] == g_query_group_ids[2] && g_query_rank[i] > 30; }
+
+static void check_indexed_queries(CXNetworkRef net) {
+	expect_query(net, CXAttributeScopeNode, "score > 0.5", ref_score_gt);
+	expect_query(net, CXAttributeScopeNode, "score >= 0.25 AND score < 0.3", ref_score_band);
+	expect_query(net, CXAttributeScopeNode, "rank IN (1, 2, 3, 2)", ref_rank_in);
+	expect_query(net, CXAttributeScopeNode, "rank == 7 AND flag == 1", ref_rank_eq_flag);
+	expect_query(net, CXAttributeScopeNode, "rank <= 10 AND NOT flag == 1", ref_rank_flag);
+	expect_query(net, CXAttributeScopeNode, "group == \"g1\"", ref_group_eq);
+	expect_query(net, CXAttributeScopeNode, "group IN (\"g0\", \"g2\")", ref_group_in);
+	expect_query(net, CXAttributeScopeNode, "group == \"g2\" AND rank > 30", ref_group_rank);
+	expect_query(net, CXAttributeScopeNode, "group == \"missing\"", ref_none);
+	expect_query(net, CXAttributeScopeNode, "tags == \"a\"", ref_tags_a);
+	expect_query(net, CXAttributeScopeNode, "tags != \"b\"", ref_tags_not_b);
+	expect_query(net, CXAttributeScopeNode, "tags IN (\"b\", \"c\")", ref_tags_b_or_c);
+}
+
+static void test_attribute_index(void) {
+	CXNetworkRef net = CXNewNetwork(CXFalse);
+	assert(net);
+	const CXSize nodeCount = 6000;
+	CXIndex *nodes = malloc(sizeof(CXIndex) * nodeCount);
+	assert(nodes && CXNetworkAddNodes(net, nodeCount, nodes));
+	assert(CXNetworkDefineNodeAttribute(net, "score", CXFloatAttributeType, 1));
+	assert(CXNetworkDefineNodeAttribute(net, "rank", CXIntegerAttributeType, 1));
+	assert(CXNetworkDefineNodeAttribute(net, "flag", CXBooleanAttributeType, 1));
+	assert(CXNetworkDefineNodeAttribute(net, "group", CXStringAttributeType, 1));
+	assert(CXNetworkDefineNodeAttribute(net, "vec", CXDoubleAttributeType, 3));
+	assert(CXNetworkDefineMultiCategoryAttribute(net, CXAttributeScopeNode, "tags", CXFalse));
+	g_query_score = CXNetworkGetNodeAttributeBuffer(net, "score");
+	g_query_rank = CXNetworkGetNodeAttributeBuffer(net, "rank");
+	g_query_flag = CXNetworkGetNodeAttributeBuffer(net, "flag");
+	CXString *labels = CXNetworkGetNodeAttributeBuffer(net, "group");
+	const char *groupNames[3] = { "g0", "g1", "g2" };
+	const char *tagNames[3] = { "a", "b", "c" };
+	srand(29);
+	for (CXSize i = 0; i < nodeCount; i++) {
+		g_query_score[i] = (float)random_unit();
+		g_query_rank[i] = rand() % 40 - 5;
+		g_query_flag[i] = (uint8_t)(rand() % 2);
+		labels[i] = CXNewStringFromString(groupNames[rand() % 3]);
+		const char *tags[3];
+		CXSize tagCount = 0;
+		for (int t = 0; t < 3; t++) {
+			if (rand() % 3 == 0) {
+				tags[tagCount++] = tagNames[t];
+			}
+		}
+		if (tagCount == 2) {
+			tags[tagCount++] = tags[0]; /* repeated ids are listed once */
+		}
+		assert(CXNetworkSetMultiCategoryEntryByLabels(net, CXAttributeScopeNode, "tags", nodes[i], tags, tagCount, NULL));
+	}
+	assert(CXNetworkCategorizeAttribute(net, CXAttributeScopeNode, "group", CX_CATEGORY_SORT_NONE, "__NA__"));
+	CXAttributeRef group = CXNetworkGetNodeAttribute(net, "group");
+	g_query_group = (int32_t *)group->data;
+	g_query_tags = CXNetworkGetNodeAttribute(net, "tags");
+	for (int i = 0; i < 3; i++) {
+		g_query_group_ids[i] = (int32_t)((uintptr_t)CXStringDictionaryEntryForKey(group->categoricalDictionary, groupNames[i]) - 2u);
+		g_query_tag_ids[i] = (int32_t)((uintptr_t)CXStringDictionaryEntryForKey(g_query_tags->categoricalDictionary, tagNames[i]) - 2u);
+	}
+	CXIndex removed[] = { 0, 1, 63, 64, 1000, 5999 };
+	assert(CXNetworkRemoveNodes(net, removed, 6));
+
+	/* The same queries before and after indexing. */
+	check_indexed_queries(net);
+	assert(!CXNetworkCreateAttributeIndex(net, CXAttributeScopeNode, "vec"));
+	assert(!CXNetworkCreateAttributeIndex(net, CXAttributeScopeNode, "missing"));
+	assert(!CXNetworkHasAttributeIndex(net, CXAttributeScopeNode, "score"));
+	const char *indexed[] = { "score", "rank", "group", "tags" };
+	for (int i = 0; i < 4; i++) {
+		assert(CXNetworkCreateAttributeIndex(net, CXAttributeScopeNode, indexed[i]));
+		assert(CXNetworkHasAttributeIndex(net, CXAttributeScopeNode, indexed[i]));
+	}
+	check_indexed_queries(net);
+
+	CXAttributeIndexRef scoreIndex = CXAttributeIndexAcquire(net, CXNetworkGetNodeAttribute(net, "score"));
+	assert(scoreIndex && scoreIndex->kind == CXAttributeIndexKindSorted && scoreIndex->entryCount == nodeCount - 6);
+	for (CXSize i = 1; i < scoreIndex->entryCount; i++) {
+		assert(scoreIndex->values[i - 1] <= scoreIndex->values[i]);
+	}
+	CXAttributeIndexRef tagIndex = CXAttributeIndexAcquire(net, g_query_tags);
+	assert(tagIndex && tagIndex->kind == CXAttributeIndexKindPostings);
+	CXSize start = 0;
+	CXSize end = 0;
+	CXAttributeIndexPostings(tagIndex, g_query_tag_ids[0], &start, &end);
+	for (CXSize i = start + 1; i < end; i++) {
+		assert(tagIndex->rows[i - 1] < tagIndex->rows[i]);
+	}
+
+	/* Value writes are picked up after a version bump, topology changes on
+	 * their own. */
+	for (CXSize i = 2; i < nodeCount; i += 5) {
+		g_query_score[i] = 0.27f;
+		g_query_rank[i] = 7;
+	}
+	CXNetworkBumpNodeAttributeVersion(net, "score");
+	CXNetworkBumpNodeAttributeVersion(net, "rank");
+	check_indexed_queries(net);
+	CXIndex removedMore[] = { 2, 7, 3001 };
+	assert(CXNetworkRemoveNodes(net, removedMore, 3));
+	CXIndex added[40];
+	assert(CXNetworkAddNodes(net, 40, added));
+	g_query_score = CXNetworkGetNodeAttributeBuffer(net, "score");
+	g_query_rank = CXNetworkGetNodeAttributeBuffer(net, "rank");
+	g_query_flag = CXNetworkGetNodeAttributeBuffer(net, "flag");
+	g_query_group = (int32_t *)group->data;
+	check_indexed_queries(net);
+
+	assert(CXNetworkDropAttributeIndex(net, CXAttributeScopeNode, "score"));
+	assert(!CXNetworkDropAttributeIndex(net, CXAttributeScopeNode, "score"));
+	check_indexed_queries(net);
+
+	free(nodes);
+	CXFreeNetwork(net);
+}
+
+static regex_t g_regex_reference;
+static CXString *g_regex_names;
+static int32_t *g_regex_kind;
+static const char *g_regex_kind_labels[8];
+static CXAttributeRef g_regex_tags;
+static const char *g_regex_tag_labels[8];
+
+static CXBool regex_reference_matches(const char *value) {
+	return value && regexec(&g_regex_reference, value, 0, NULL, 0) == 0;
+}
+static CXBool ref_regex_name(CXNetworkRef net, CXIndex i) { (void)net; return regex_reference_matches(g_regex_names[i]); }
+static CXBool ref_regex_kind(CXNetworkRef net, CXIndex i) {
+	(void)net;
+	int32_t id = g_regex_kind[i];
+	return id >= 0 && id < 8 && regex_reference_matches(g_regex_kind_labels[id]);
+}
+static CXBool ref_regex_tags(CXNetworkRef net, CXIndex i) {
+	(void)net;
+	const CXMultiCategoryBuffer *buffer = g_regex_tags->multiCategory;
+	for (uint32_t k = buffer->offsets[i]; k < buffer->offsets[i + 1]; k++) {
+		if (buffer->ids[k] < 8 && regex_reference_matches(g_regex_tag_labels[buffer->ids[k]])) {
+			return CXTrue;
+		}
+	}
+	return CXFalse;
+}
+
+/* Checks `name =~ pattern` against regexec run on every row. */
+static void expect_regex(CXNetworkRef net, const char *name, const char *pattern, QueryReference reference) {
+	char query[256];
+	size_t length = (size_t)snprintf(query, sizeof(query), "%s =~ \"", name);
+	for (const char *c = pattern; *c; c++) {
+		if (*c == '\\' || *c == '"') {
+			query[length++] = '\\';
+		}
+		query[length++] = *c;
+	}
+	query[length++] = '"';
+	query[length] = '\0';
+	assert(regcomp(&g_regex_reference, pattern, REG_EXTENDED | REG_NOSUB) == 0);
+	expect_query(net, CXAttributeScopeNode, query, reference);
+	regfree(&g_regex_reference);
+}
+
+static void test_regex_query(void) {
+	CXNetworkRef net = CXNewNetwork(CXFalse);
+	assert(net);
+	const CXSize nodeCount = 5000;
+	CXIndex *nodes = malloc(sizeof(CXIndex) * nodeCount);
+	assert(nodes && CXNetworkAddNodes(net, nodeCount, nodes));
+	assert(CXNetworkDefineNodeAttribute(net, "name", CXStringAttributeType, 1));
+	assert(CXNetworkDefineNodeAttribute(net, "kind", CXStringAttributeType, 1));
+	assert(CXNetworkDefineMultiCategoryAttribute(net, CXAttributeScopeNode, "tags", CXFalse));
+	g_regex_names = CXNetworkGetNodeAttributeBuffer(net, "name");
+	CXString *kinds = CXNetworkGetNodeAttributeBuffer(net, "kind");
+	const char *kindNames[5] = { "alpha", "beta", "gamma", "delta_x", "epsilon" };
+	const char *tagNames[4] = { "red", "green", "blue", "dark_red" };
+	char text[64];
+	for (CXSize i = 0; i < nodeCount; i++) {
+		if (i % 113 == 0) {
+			/* left unset */
+		} else if (i % 97 == 0) {
+			g_regex_names[i] = CXNewStringFromString("");
+		} else if (i % 50 == 0) {
+			snprintf(text, sizeof(text), "a.b%zu", (size_t)i);
+			g_regex_names[i] = CXNewStringFromString(text);
+		} else {
+			snprintf(text, sizeof(text), i % 7 == 0 ? "hub_%zu" : "node_%zu", (size_t)i);
+			g_regex_names[i] = CXNewStringFromString(text);
+		}
+		kinds[i] = CXNewStringFromString(kindNames[(i * 7) % 5]);
+		const char *tags[2] = { tagNames[i % 4], tagNames[(i / 4) % 4] };
+		assert(CXNetworkSetMultiCategoryEntryByLabels(net, CXAttributeScopeNode, "tags", nodes[i], tags, i % 3, NULL));
+	}
+	assert(CXNetworkCategorizeAttribute(net, CXAttributeScopeNode, "kind", CX_CATEGORY_SORT_NONE, "__NA__"));
+	CXAttributeRef kind = CXNetworkGetNodeAttribute(net, "kind");
+	g_regex_kind = (int32_t *)kind->data;
+	g_regex_tags = CXNetworkGetNodeAttribute(net, "tags");
+	for (int i = 0; i < 5; i++) {
+		int32_t id = (int32_t)((uintptr_t)CXStringDictionaryEntryForKey(kind->categoricalDictionary, kindNames[i]) - 2u);
+		assert(id >= 0 && id < 8);
+		g_regex_kind_labels[id] = kindNames[i];
+	}
+	for (int i = 0; i < 4; i++) {
+		int32_t id = (int32_t)((uintptr_t)CXStringDictionaryEntryForKey(g_regex_tags->categoricalDictionary, tagNames[i]) - 2u);
+		assert(id >= 0 && id < 8);
+		g_regex_tag_labels[id] = tagNames[i];
+	}
+	CXIndex removed[] = { 3, 70, 1000 };
+	assert(CXNetworkRemoveNodes(net, removed, 3));
+
+	/* Plain literals, anchored literals, literal prefilters, and patterns
+	 * without a usable literal. */
+	const char *patterns[] = {
+		"ode_12", "^node_1", "_7$", "^hub_35$", "^$", "", "a\\.b", "a.b1",
+		"n(o|x)de_2[0-9]+", "hub|node_3", "x*node_4", "no?de_9", "[0-9]{3}$",
+		"^hub_1+0", "node_(12)*3$", "[[:alpha:]]+_49"
+	};
+	for (size_t i = 0; i < sizeof(patterns) / sizeof(patterns[0]); i++) {
+		expect_regex(net, "name", patterns[i], ref_regex_name);
+	}
+	const char *labelPatterns[] = { "^(alpha|beta)$", "a", "_x$", "^zeta", "red", "^re" };
+	for (size_t i = 0; i < sizeof(labelPatterns) / sizeof(labelPatterns[0]); i++) {
+		expect_regex(net, "kind", labelPatterns[i], ref_regex_kind);
+		expect_regex(net, "tags", labelPatterns[i], ref_regex_tags);
+	}
+	assert(CXNetworkCreateAttributeIndex(net, CXAttributeScopeNode, "kind"));
+	assert(CXNetworkCreateAttributeIndex(net, CXAttributeScopeNode, "tags"));
+	for (size_t i = 0; i < sizeof(labelPatterns) / sizeof(labelPatterns[0]); i++) {
+		expect_regex(net, "kind", labelPatterns[i], ref_regex_kind);
+		expect_regex(net, "tags", labelPatterns[i], ref_regex_tags);
+	}
+
+	CXNodeSelectorRef selector = CXNodeSelectorCreate(0);
+	assert(selector);
+	assert(!CXNetworkSelectNodesByQuery(net, "name =~ \"(\"", selector));
+	CXNodeSelectorDestroy(selector);
+
+	free(nodes);
+	CXFreeNetwork(net);
+}
+
+static double *g_accessor_values;
+static CXSize g_accessor_dim;
+
+static int compare_doubles(const void *lhs, const void *rhs) {
+	double a = *(const double *)lhs;
+	double b = *(const double *)rhs;
+	return a < b ? -1 : (a > b ? 1 : 0);
+}
+
+static double accessor_median(CXIndex i) {
+	double sorted[128];
+	memcpy(sorted, g_accessor_values + i * g_accessor_dim, sizeof(double) * g_accessor_dim);
+	qsort(sorted, g_accessor_dim, sizeof(double), compare_doubles);
+	CXSize mid = g_accessor_dim / 2;
+	return g_accessor_dim % 2 == 0 ? (sorted[mid - 1] + sorted[mid]) / 2.0 : sorted[mid];
+}
+
+static double accessor_std(CXIndex i) {
+	const double *row = g_accessor_values + i * g_accessor_dim;
+	double total = 0.0;
+	for (CXSize d = 0; d < g_accessor_dim; d++) {
+		total += row[d];
+	}
+	double mean = total / (double)g_accessor_dim;
+	double variance = 0.0;
+	for (CXSize d = 0; d < g_accessor_dim; d++) {
+		variance += (row[d] - mean) * (row[d] - mean);
+	}
+	return sqrt(variance / (double)g_accessor_dim);
+}
+
+static double accessor_min(CXIndex i) {
+	const double *row = g_accessor_values + i * g_accessor_dim;
+	double value = row[0];
+	for (CXSize d = 1; d < g_accessor_dim; d++) {
+		value = row[d] < value ? row[d] : value;
+	}
+	return value;
+}
+
+static double accessor_dot_ramp(CXIndex i) {
+	const double *row = g_accessor_values + i * g_accessor_dim;
+	double total = 0.0;
+	for (CXSize d = 0; d < g_accessor_dim; d++) {
+		total += row[d] * (double)d;
+	}
+	return total;
+}
+
+static CXBool ref_median_pos(CXNetworkRef net, CXIndex i) { (void)net; return accessor_median(i) > 0.0; }
+static CXBool ref_median_eq(CXNetworkRef net, CXIndex i) { (void)net; return accessor_median(i) == 0.1; }
+static CXBool ref_std_min(CXNetworkRef net, CXIndex i) { (void)net; return accessor_std(i) < 0.4 || accessor_min(i) >= 0.0; }
+static CXBool ref_not_median_in(CXNetworkRef net, CXIndex i) {
+	(void)net;
+	double median = accessor_median(i);
+	return !(median == 0.2 || median == -0.3);
+}
+static CXBool ref_dot_ramp(CXNetworkRef net, CXIndex i) { (void)net; return accessor_dot_ramp(i) > 0.5; }
+
+static void test_vector_accessor_query(void) {
+	const CXSize dimensions[] = { 2, 3, 4, 5, 8, 100 };
+	for (size_t run = 0; run < sizeof(dimensions) / sizeof(dimensions[0]); run++) {
+		CXNetworkRef net = CXNewNetwork(CXFalse);
+		assert(net);
+		const CXSize nodeCount = run == 5 ? 3000 : 12000;
+		CXIndex *nodes = malloc(sizeof(CXIndex) * nodeCount);
+		assert(nodes && CXNetworkAddNodes(net, nodeCount, nodes));
+		g_accessor_dim = dimensions[run];
+		assert(CXNetworkDefineNodeAttribute(net, "v", CXDoubleAttributeType, g_accessor_dim));
+		g_accessor_values = CXNetworkGetNodeAttributeBuffer(net, "v");
+		srand(31 + (unsigned)run);
+		for (CXSize i = 0; i < nodeCount * g_accessor_dim; i++) {
+			/* One decimal so medians tie and hit the IN/== targets. */
+			g_accessor_values[i] = (double)(rand() % 21 - 10) / 10.0;
+		}
+		/* Leave a sparse tile behind. */
+		for (CXIndex node = 4096; node < CXMIN(nodeCount, (CXSize)8192); node++) {
+			if (node % 97 != 0) {
+				assert(CXNetworkRemoveNodes(net, &node, 1));
+			}
+		}
+		char dotQuery[1024];
+		size_t length = (size_t)snprintf(dotQuery, sizeof(dotQuery), "v.dot([");
+		for (CXSize d = 0; d < g_accessor_dim; d++) {
+			length += (size_t)snprintf(dotQuery + length, sizeof(dotQuery) - length, d ? ", %zu" : "%zu", (size_t)d);
+		}
+		snprintf(dotQuery + length, sizeof(dotQuery) - length, "]) > 0.5");
+
+		CXSize workerCounts[2] = { 1, 4 };
+		for (int pass = 0; pass < 2; pass++) {
+			CXThreadPoolSetWorkerCount(workerCounts[pass]);
+			expect_query(net, CXAttributeScopeNode, "v.median > 0", ref_median_pos);
+			expect_query(net, CXAttributeScopeNode, "v.median == 0.1", ref_median_eq);
+			expect_query(net, CXAttributeScopeNode, "v.std < 0.4 OR v.min >= 0", ref_std_min);
+			expect_query(net, CXAttributeScopeNode, "NOT v.median IN (0.2, -0.3)", ref_not_median_in);
+			expect_query(net, CXAttributeScopeNode, dotQuery, ref_dot_ramp);
+		}
+		CXThreadPoolSetWorkerCount(0);
+		free(nodes);
+		CXFreeNetwork(net);
+	}
+}
+
+static void test_prepared_query(void) {
+	CXNetworkRef net = CXNewNetwork(CXFalse);
+	assert(net);
+	CXIndex nodes[4];
+	assert(CXNetworkAddNodes(net, 4, nodes));
+	assert(CXNetworkDefineNodeAttribute(net, "score", CXDoubleAttributeType, 1));
+	double *score = CXNetworkGetNodeAttributeBuffer(net, "score");
+	for (int i = 0; i < 4; i++) {
+		score[nodes[i]] = (double)i;
+	}
+	assert(!CXQueryPrepare(net, CXAttributeScopeNode, "score >"));
+	assert(!CXQueryPrepare(net, CXAttributeScopeNode, "missing > 1"));
+	assert(!CXQueryPrepare(net, CXAttributeScopeNetwork, "score > 1"));
+
+	CXPreparedQueryRef query = CXQueryPrepare(net, CXAttributeScopeNode, "score > 1.5");
+	assert(query && CXQueryScope(query) == CXAttributeScopeNode);
+	CXNodeSelectorRef selector = CXNodeSelectorCreate(0);
+	assert(CXQueryExecute(query, selector));
+	assert(CXNodeSelectorCount(selector) == 2);
+
+	/* Value writes are seen without rebinding. */
+	score[nodes[0]] = 9.0;
+	CXNetworkBumpNodeAttributeVersion(net, "score");
+	assert(CXQueryExecute(query, selector));
+	assert(CXNodeSelectorCount(selector) == 3 && CXNodeSelectorData(selector)[0] == nodes[0]);
+
+	/* Removing the attribute invalidates the plan; redefining it rebinds. */
+	assert(CXNetworkRemoveNodeAttribute(net, "score"));
+	assert(!CXQueryExecute(query, selector));
+	assert(CXNetworkDefineNodeAttribute(net, "score", CXFloatAttributeType, 1));
+	float *floatScore = CXNetworkGetNodeAttributeBuffer(net, "score");
+	floatScore[nodes[3]] = 2.0f;
+	assert(CXQueryExecute(query, selector));
+	assert(CXNodeSelectorCount(selector) == 1 && CXNodeSelectorData(selector)[0] == nodes[3]);
+
+	/* Category ids are re-resolved when the dictionary changes. */
+	assert(CXNetworkDefineNodeAttribute(net, "group", CXStringAttributeType, 1));
+	CXString *labels = CXNetworkGetNodeAttributeBuffer(net, "group");
+	const char *names[4] = { "b", "a", "b", "c" };
+	for (int i = 0; i < 4; i++) {
+		labels[nodes[i]] = CXNewStringFromString(names[i]);
+	}
+	CXPreparedQueryRef groupQuery = CXQueryPrepare(net, CXAttributeScopeNode, "group == \"b\"");
+	assert(groupQuery);
+	assert(CXQueryExecute(groupQuery, selector));
+	assert(CXNodeSelectorCount(selector) == 2);
+	assert(CXNetworkCategorizeAttribute(net, CXAttributeScopeNode, "group", CX_CATEGORY_SORT_ALPHABETICAL, "__NA__"));
+	assert(CXQueryExecute(groupQuery, selector));
+	assert(CXNodeSelectorCount(selector) == 2 && CXNodeSelectorData(selector)[1] == nodes[2]);
+	assert(CXNetworkDecategorizeAttribute(net, CXAttributeScopeNode, "group", "__NA__"));
+	assert(CXQueryExecute(groupQuery, selector));
+	assert(CXNodeSelectorCount(selector) == 2);
+
+	CXNodeSelectorDestroy(selector);
+	release_all_string_attributes(net);
+	CXFreeNetwork(net);
+	/* Handles may outlive their network as long as they are only freed. */
+	CXQueryFree(query);
+	CXQueryFree(groupQuery);
+}
+
 static void test_serialization_fuzz(void) {
 	srand(42);
 	CXSize sizes[] = {0, 1, 4, 12};
@@ -1857,6 +3541,10 @@ static void test_network_generators(void) {
 int main(void) {
 	test_basic_network();
 	test_neighbor_collection();
+	test_bulk_edge_insert();
+	test_fast_edge_removal();
+	test_batch_node_removal();
+	test_freeze_and_thaw();
 	test_attributes();
 	test_xnet_round_trip();
 	test_categorical_serialization();
@@ -1866,14 +3554,27 @@ int main(void) {
 	test_xnet_legacy_multicategory();
 	test_xnet_legacy_vertices_tokens_and_unescaped_strings();
 	test_xnet_string_escaping();
+	test_xnet_number_parsing();
 	test_xnet_invalid_inputs();
+	test_xnet_parallel_sections();
+	test_text_writer_formatting();
 	test_xnet_compaction_mapping();
 	test_gml_round_trip_and_warnings();
 	test_gml_loose_loader();
+	test_gml_streaming_reader();
 	test_gt_round_trip();
 	test_gt_zst_read();
 	test_node_link_json_export();
+	test_node_link_json_read();
 	test_serialization_fuzz();
+	test_zxnet_threaded_round_trip();
+	test_filtered_read();
+	test_query_selection();
+	test_parallel_query();
+	test_attribute_index();
+	test_regex_query();
+	test_vector_accessor_query();
+	test_prepared_query();
 	test_network_generators();
 	printf("All native network tests passed.\n");
 	return 0;